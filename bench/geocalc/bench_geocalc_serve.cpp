@@ -0,0 +1,138 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_geocalc_serve.cpp
+/// \brief      Нагрузочный клиент сервера geocalc (--serve): пропускная способность и задержки запросов
+/// \details    Несколько соединений (по потоку на соединение) посылают пакеты записей geo2rad и ждут ответа. Если путь
+///             сокета не задан, сервер запускается в этом же процессе (CServer, пул потоков библиотеки по умолчанию).
+///             Для сравнения - те же пакеты, решенные GEOtoRAD_Batch без сервера в одном потоке.
+///             Результат - записи и запросы в секунду, задержки запроса (медиана, 99%, максимум).
+///             Запуск: bench_geocalc_serve [соединений] [записей в пакете] [запросов на соединение] [путь сокета]
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// SPML includes:
+#include <geodesy_batch.h>
+
+// GEOCALC includes:
+#include <serve.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+
+static double Seconds( TClock::time_point t0 )
+{
+    return std::chrono::duration<double>( TClock::now() - t0 ).count();
+}
+
+int main( int argc, char *argv[] )
+{
+    const unsigned connections = ( argc > 1 ) ? static_cast<unsigned>( std::atoi( argv[1] ) ) : 4;
+    const std::size_t batch = ( argc > 2 ) ? std::strtoul( argv[2], nullptr, 10 ) : 1024;
+    const std::size_t requests = ( argc > 3 ) ? std::strtoul( argv[3], nullptr, 10 ) : 2000;
+    const std::string path = ( argc > 4 ) ? argv[4] : "/tmp/bench_geocalc_serve.sock";
+
+    std::unique_ptr<GeoCalc::CServer> server;
+    if( argc <= 4 ) {
+        server.reset( new GeoCalc::CServer( path ) );
+        std::string error;
+        if( !server->Start( error ) ) {
+            std::fprintf( stderr, "%s\n", error.c_str() );
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Пакет записей geo2rad
+    std::mt19937 gen( 17 );
+    std::uniform_real_distribution<double> lat( -80.0, 80.0 );
+    std::uniform_real_distribution<double> lon( -180.0, 180.0 );
+    std::vector<double> lat1( batch ), lon1( batch ), lat2( batch ), lon2( batch );
+    for( std::size_t i = 0; i < batch; i++ ) {
+        lat1[i] = lat( gen );
+        lon1[i] = lon( gen );
+        lat2[i] = lat( gen );
+        lon2[i] = lon( gen );
+    }
+    const double *in[4] = { lat1.data(), lon1.data(), lat2.data(), lon2.data() };
+    GeoCalc::TColumnarHeader task;
+    task.Operation = "geo2rad";
+    task.Ellipsoid = SPML::Geodesy::Ellipsoids::WGS84();
+    task.RangeUnit = SPML::Units::RU_Kilometer;
+    task.AngleUnit = SPML::Units::AU_Degree;
+
+    std::printf( "geo2rad, %u connections, %zu records per request, %zu requests per connection (%s server)\n",
+        connections, batch, requests, server ? "in-process" : "external" );
+
+    // Без сервера: те же пакеты в одном потоке
+    std::vector<double> d( batch ), az( batch ), azEnd( batch );
+    TClock::time_point t0 = TClock::now();
+    for( std::size_t r = 0; r < requests; r++ ) {
+        SPML::Geodesy::GEOtoRAD_Batch( task.Ellipsoid, task.RangeUnit, task.AngleUnit, in[0], in[1], in[2], in[3],
+            batch, d.data(), az.data(), azEnd.data(), SPML::Execution::Policy( SPML::SIMD::TSimdLevel::SL_Auto, 1 ) );
+    }
+    const double direct = Seconds( t0 );
+    std::printf( "%-28s %14.0f records/s\n", "direct GEOtoRAD_Batch", batch * requests / direct );
+
+    // Клиенты сервера
+    std::vector<std::vector<double>> latencies( connections );
+    std::vector<std::size_t> failures( connections, 0 );
+    std::vector<std::thread> clients;
+    t0 = TClock::now();
+    for( unsigned c = 0; c < connections; c++ ) {
+        clients.emplace_back( [&, c]() {
+            GeoCalc::CServeClient client;
+            std::string error;
+            if( !client.Connect( path, error ) ) {
+                std::fprintf( stderr, "%s\n", error.c_str() );
+                failures[c] = requests;
+                return;
+            }
+            std::vector<double> cd( batch ), caz( batch ), cazEnd( batch );
+            double *out[3] = { cd.data(), caz.data(), cazEnd.data() };
+            latencies[c].reserve( requests );
+            for( std::size_t r = 0; r < requests; r++ ) {
+                const TClock::time_point start = TClock::now();
+                if( !client.Solve( task, in, batch, out, error ) ) {
+                    failures[c]++;
+                    continue;
+                }
+                latencies[c].push_back( Seconds( start ) );
+            }
+            // Проверка: ответ совпадает с решением без сервера
+            if( !std::equal( cd.begin(), cd.end(), d.begin() ) ) {
+                failures[c]++;
+            }
+        } );
+    }
+    for( std::thread &client : clients ) {
+        client.join();
+    }
+    const double served = Seconds( t0 );
+
+    std::vector<double> all;
+    std::size_t failed = 0;
+    for( unsigned c = 0; c < connections; c++ ) {
+        all.insert( all.end(), latencies[c].begin(), latencies[c].end() );
+        failed += failures[c];
+    }
+    std::sort( all.begin(), all.end() );
+    const auto percentile = [&all]( double p ) {
+        return all.empty() ? 0.0 : 1.0e6 * all[static_cast<std::size_t>( p * ( all.size() - 1 ) )];
+    };
+    std::printf( "%-28s %14.0f records/s %10.0f requests/s\n", "served", batch * all.size() / served,
+        all.size() / served );
+    std::printf( "latency, us: p50 %.1f, p99 %.1f, max %.1f; failures: %zu\n", percentile( 0.5 ), percentile( 0.99 ),
+        percentile( 1.0 ), failed );
+    return ( failed == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
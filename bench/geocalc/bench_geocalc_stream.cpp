@@ -0,0 +1,226 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_geocalc_stream.cpp
+/// \brief      Замер производительности потокового режима geocalc: чтение записей, решение, печать результатов
+/// \details    Записи geo2rad (по строке на запись) готовятся в памяти. Сравниваются: прежний путь (strtod,
+///             GEOtoRAD, печать каждого числа через std::ostringstream и сложение строк) и CStreamProcessor
+///             (std::from_chars, GEOtoRAD_Batch, std::to_chars в общий буфер), CStreamProcessor с двоичным столбцовым
+///             вводом и выводом (columnar.h), а также отдельно чтение и печать. Обработка файла: RunStream и
+///             RunMapped (mapped.h) с разным числом потоков.
+///             Результат - число записей в секунду.
+///             Запуск: bench_geocalc_stream [число записей] [число знаков после запятой]
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// SPML includes:
+#include <execution.h>
+#include <geodesy.h>
+
+// GEOCALC includes:
+#include <mapped.h>
+#include <stream.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+
+static double Seconds( TClock::time_point t0 )
+{
+    return std::chrono::duration<double>( TClock::now() - t0 ).count();
+}
+
+static void PrintRow( const char *variant, std::size_t records, double seconds, double base )
+{
+    std::printf( "%-36s %14.0f %10.2f\n", variant, static_cast<double>( records ) / seconds, base / seconds );
+}
+
+// Прежняя печать числа (to_string_with_precision до перехода на std::to_chars)
+static std::string ToStringStream( double value, int precision )
+{
+    std::ostringstream out;
+    out.precision( precision );
+    out << std::fixed << value;
+    return out.str();
+}
+
+int main( int argc, char *argv[] )
+{
+    const std::size_t n = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 1000000;
+    const int precision = ( argc > 2 ) ? std::atoi( argv[2] ) : 6;
+
+    // Текст записей: по строке "LatStart LonStart LatEnd LonEnd"
+    std::mt19937 gen( 17 );
+    std::uniform_real_distribution<double> lat( -80.0, 80.0 );
+    std::uniform_real_distribution<double> lon( -180.0, 180.0 );
+    std::string text;
+    std::vector<std::size_t> lineStart;
+    char line[128];
+    for( std::size_t i = 0; i < n; i++ ) {
+        lineStart.push_back( text.size() );
+        text.append( line, std::snprintf( line, sizeof( line ), "%.6f %.6f %.6f %.6f\n", lat( gen ), lon( gen ),
+            lat( gen ), lon( gen ) ) );
+    }
+    lineStart.push_back( text.size() );
+
+    GeoCalc::TStreamSettings settings{ GeoCalc::FindStreamOperation( "geo2rad" ),
+        SPML::Geodesy::Ellipsoids::WGS84(), SPML::Units::RU_Kilometer, SPML::Units::AU_Degree, precision };
+    std::printf( "geo2rad, %zu records, %d digits after dot\n", n, precision );
+    std::printf( "%-36s %14s %10s\n", "variant", "records/s", "speedup" );
+
+    // Прежний путь: strtod, скалярная функция, std::ostringstream на каждое число
+    std::size_t outputSize = 0;
+    TClock::time_point t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        const char *p = text.data() + lineStart[i];
+        char *next = nullptr;
+        double v[4];
+        for( int k = 0; k < 4; k++ ) {
+            v[k] = std::strtod( p, &next );
+            p = next;
+        }
+        double d, az, azEnd;
+        SPML::Geodesy::GEOtoRAD( settings.Ellipsoid, settings.RangeUnit, settings.AngleUnit, v[0], v[1], v[2], v[3],
+            d, az, azEnd );
+        const std::string result = ToStringStream( d, precision ) + " " + ToStringStream( az, precision ) + " " +
+            ToStringStream( azEnd, precision ) + "\n";
+        outputSize += result.size();
+    }
+    const double base = Seconds( t0 );
+    PrintRow( "strtod + GEOtoRAD + ostringstream", n, base, base );
+
+    // CStreamProcessor: from_chars, GEOtoRAD_Batch, to_chars
+    GeoCalc::CStreamProcessor processor( settings );
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        processor.Line( text.data() + lineStart[i], text.data() + lineStart[i + 1] - 1 );
+        if( processor.Output().Size() >= ( 1 << 20 ) ) {
+            outputSize += processor.Output().Size();
+            processor.Output().Clear();
+        }
+    }
+    processor.Flush();
+    outputSize += processor.Output().Size();
+    PrintRow( "CStreamProcessor (parse+solve+print)", n, Seconds( t0 ), base );
+
+    // Двоичный столбцовый ввод и вывод (columnar.h): без чтения и печати текста
+    std::vector<double> lat1( n ), lon1( n ), lat2( n ), lon2( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        const char *p = text.data() + lineStart[i];
+        const char *end = text.data() + lineStart[i + 1];
+        p = GeoCalc::ParseNumber( p, end, lat1[i] ) + 1;
+        p = GeoCalc::ParseNumber( p, end, lon1[i] ) + 1;
+        p = GeoCalc::ParseNumber( p, end, lat2[i] ) + 1;
+        GeoCalc::ParseNumber( p, end, lon2[i] );
+    }
+    const double *columns[4] = { lat1.data(), lon1.data(), lat2.data(), lon2.data() };
+    GeoCalc::TStreamSettings binarySettings = settings;
+    binarySettings.InputFormat = GeoCalc::SF_Binary;
+    binarySettings.OutputFormat = GeoCalc::SF_Binary;
+    GeoCalc::CStreamProcessor binary( binarySettings );
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i += GeoCalc::CStreamProcessor::BlockSize ) {
+        const double *block[4] = { columns[0] + i, columns[1] + i, columns[2] + i, columns[3] + i };
+        binary.Columns( block, std::min( GeoCalc::CStreamProcessor::BlockSize, n - i ) );
+        if( binary.Output().Size() >= ( 1 << 20 ) ) {
+            outputSize += binary.Output().Size();
+            binary.Output().Clear();
+        }
+    }
+    binary.Flush();
+    outputSize += binary.Output().Size();
+    PrintRow( "CStreamProcessor (binary columns)", n, Seconds( t0 ), base );
+
+    // Только чтение
+    double sum = 0.0;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        const char *p = text.data() + lineStart[i];
+        char *next = nullptr;
+        for( int k = 0; k < 4; k++ ) {
+            sum += std::strtod( p, &next );
+            p = next;
+        }
+    }
+    const double parseBase = Seconds( t0 );
+    PrintRow( "parse: strtod", n, parseBase, parseBase );
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        const char *p = text.data() + lineStart[i];
+        const char *end = text.data() + lineStart[i + 1];
+        for( int k = 0; k < 4; k++ ) {
+            double value = 0.0;
+            p = GeoCalc::ParseNumber( p, end, value ) + 1;
+            sum += value;
+        }
+    }
+    PrintRow( "parse: from_chars", n, Seconds( t0 ), parseBase );
+
+    // Только печать трех чисел записи
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        const double value = 1000.0 * static_cast<double>( i ) / static_cast<double>( n );
+        const std::string result = ToStringStream( value, precision ) + " " + ToStringStream( value, precision ) +
+            " " + ToStringStream( value, precision ) + "\n";
+        outputSize += result.size();
+    }
+    const double printBase = Seconds( t0 );
+    PrintRow( "print: ostringstream", n, printBase, printBase );
+    GeoCalc::CTextBuffer buffer;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        const double value = 1000.0 * static_cast<double>( i ) / static_cast<double>( n );
+        buffer.Append( value, precision );
+        buffer.Append( ' ' );
+        buffer.Append( value, precision );
+        buffer.Append( ' ' );
+        buffer.Append( value, precision );
+        buffer.Append( '\n' );
+        if( buffer.Size() >= ( 1 << 20 ) ) {
+            outputSize += buffer.Size();
+            buffer.Clear();
+        }
+    }
+    PrintRow( "print: to_chars", n, Seconds( t0 ), printBase );
+
+    // Обработка файла: потоковый ввод-вывод и файлы, отображенные в память
+    const std::string input = "bench_geocalc_stream_input.txt";
+    const std::string output = "bench_geocalc_stream_output.txt";
+    std::FILE *file = std::fopen( input.c_str(), "wb" );
+    if( file != nullptr ) {
+        std::fwrite( text.data(), 1, text.size(), file );
+        std::fclose( file );
+        file = std::fopen( input.c_str(), "rb" );
+        std::FILE *out = std::fopen( output.c_str(), "wb" );
+        t0 = TClock::now();
+        GeoCalc::RunStream( file, out, settings );
+        std::fclose( file );
+        std::fclose( out );
+        const double fileBase = Seconds( t0 );
+        PrintRow( "file: RunStream", n, fileBase, fileBase );
+        const unsigned cores = std::max( 1u, std::thread::hardware_concurrency() );
+        for( unsigned threads = 1; threads <= cores; threads *= 2 ) {
+            SPML::Execution::SetPoolThreads( threads );
+            t0 = TClock::now();
+            GeoCalc::RunMapped( input, output, settings );
+            const std::string variant = "file: RunMapped, threads " + std::to_string( threads );
+            PrintRow( variant.c_str(), n, Seconds( t0 ), fileBase );
+        }
+        std::remove( input.c_str() );
+        std::remove( output.c_str() );
+    }
+
+    std::printf( "(check: %zu bytes, %.3f)\n", outputSize, sum );
+    return 0;
+}
@@ -0,0 +1,1175 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_spml.cpp
+/// \brief      Набор замеров всех открытых функций geodesy.h и convert.h с выводом в JSON
+/// \details    Каждая функция замеряется на воспроизводимом синтетическом наборе данных (генератор mt19937 с заданным
+///             начальным числом) для обоих сочетаний единиц измерения (м/рад и км/град) и, если функция принимает
+///             эллипсоид, на эллипсоиде WGS84 и сфере Sphere6371. Функции с единицами измерения, заданными при
+///             компиляции, и перегрузки со структурами замеряются отдельно (поле variant). Функции, не зависящие от
+///             единиц измерения, замеряются один раз.
+///             \n Замер: число вызовов подбирается так, чтобы прогон длился не меньше min-time, затем прогон
+///             повторяется repeats раз; ns_per_call - наименьшее время вызова, ns_per_call_median - медиана.
+///             \n JSON выводится в stdout (или в файл --output), таблица хода замера - в stderr.
+///             Запуск: bench_spml [--points N] [--seed S] [--min-time СЕКУНД] [--repeats R] [--filter ПОДСТРОКА]
+///                                [--output ФАЙЛ]
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// SPML includes:
+#include <convert.h>
+#include <geodesy.h>
+#include <simd.h>
+#include <spml.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+
+namespace Geo = SPML::Geodesy;
+namespace Units = SPML::Units;
+namespace Convert = SPML::Convert;
+
+static volatile double Sink; // Приемник контрольных сумм (результаты не выбрасываются оптимизатором)
+
+// Синтетический набор данных в заданных единицах измерения (размер - степень двойки)
+struct TData
+{
+    std::size_t Mask;                                       // Размер - 1
+    std::vector<double> Lat1, Lon1, H1, Lat2, Lon2, H2;     // Пары точек в одном районе
+    std::vector<double> D, Az;                              // Дальность и азимут прямой задачи
+    std::vector<double> AerA, AerE, AerR;                   // AER отметки относительно Lat1, Lon1, H1
+    std::vector<double> E, N, U;                            // ENU вектор
+    std::vector<double> X1, Y1, Z1, X2, Y2, Z2;             // ECEF точек пар
+    std::vector<double> Angle;                              // Углы вне [0, 360) и [-90, 90]
+    std::vector<int> GkX, GkY;                              // Координаты Гаусса-Крюгера точек Lat1, Lon1 (СК-42)
+    std::vector<int> Time;                                  // Время Unix, [с]
+
+    TData( std::size_t size, unsigned seed, const Geo::CEllipsoid &el, Units::TRangeUnit ru, Units::TAngleUnit au )
+    {
+        const double toAngle = ( au == Units::AU_Degree ) ? 1.0 : SPML::Convert::DgToRdD;
+        const double toRange = ( ru == Units::RU_Meter ) ? 1.0 : 0.001;
+        std::mt19937 gen( seed );
+        std::uniform_real_distribution<double> lat( 30.0, 70.0 ), lon( 20.0, 80.0 ), h( 0.0, 1.0e4 );
+        std::uniform_real_distribution<double> d( 1.0e3, 1.0e6 ), az( 0.0, 360.0 ), elev( -5.0, 85.0 );
+        std::uniform_real_distribution<double> enu( -2.0e5, 2.0e5 ), angle( -1000.0, 1000.0 );
+        std::uniform_int_distribution<int> time( 0, 2000000000 );
+        Mask = size - 1;
+        for( std::size_t i = 0; i < size; i++ ) {
+            Lat1.push_back( lat( gen ) * toAngle );
+            Lon1.push_back( lon( gen ) * toAngle );
+            H1.push_back( h( gen ) * toRange );
+            Lat2.push_back( lat( gen ) * toAngle );
+            Lon2.push_back( lon( gen ) * toAngle );
+            H2.push_back( h( gen ) * toRange );
+            D.push_back( d( gen ) * toRange );
+            Az.push_back( az( gen ) * toAngle );
+            AerA.push_back( az( gen ) * toAngle );
+            AerE.push_back( elev( gen ) * toAngle );
+            AerR.push_back( 0.5 * d( gen ) * toRange );
+            E.push_back( enu( gen ) * toRange );
+            N.push_back( enu( gen ) * toRange );
+            U.push_back( 0.1 * enu( gen ) * toRange );
+            Angle.push_back( angle( gen ) * toAngle );
+            Time.push_back( time( gen ) );
+            double x, y, z;
+            Geo::GEOtoECEF( el, ru, au, Lat1[i], Lon1[i], H1[i], x, y, z );
+            X1.push_back( x );
+            Y1.push_back( y );
+            Z1.push_back( z );
+            Geo::GEOtoECEF( el, ru, au, Lat2[i], Lon2[i], H2[i], x, y, z );
+            X2.push_back( x );
+            Y2.push_back( y );
+            Z2.push_back( z );
+            int zone, gx, gy;
+            Geo::SK42toGaussKruger( ru, au, Lat1[i], Lon1[i], zone, gx, gy );
+            GkX.push_back( gx );
+            GkY.push_back( gy );
+        }
+    }
+};
+
+// Замеряемый случай: run( n ) - n вызовов функции на точках набора по кругу, возвращает контрольную сумму
+struct TCase
+{
+    std::string Header;     // Заголовочный файл функции
+    std::string Function;   // Имя функции
+    std::string Variant;    // runtime - единицы во время выполнения, template - при компиляции, struct - структуры
+    std::string Model;      // ellipsoid, sphere или none (функция без эллипсоида)
+    std::string Ellipsoid;  // Имя эллипсоида
+    std::string RangeUnit;  // m, km или пусто (не зависит от единиц)
+    std::string AngleUnit;  // rad, deg или пусто
+    std::function<double( std::size_t )> Run;
+};
+
+// Список случаев с текущими моделью и единицами измерения
+struct TRegistry
+{
+    std::vector<TCase> Cases;
+    std::string Model, Ellipsoid, RangeUnit, AngleUnit;
+
+    void Add( const char *header, const char *function, const char *variant, std::function<double( std::size_t )> run )
+    {
+        Cases.push_back( { header, function, variant, Model, Ellipsoid, RangeUnit, AngleUnit, std::move( run ) } );
+    }
+};
+
+static const char *RangeName( Units::TRangeUnit ru )
+{
+    return ( ru == Units::RU_Meter ) ? "m" : "km";
+}
+
+static const char *AngleName( Units::TAngleUnit au )
+{
+    return ( au == Units::AU_Radian ) ? "rad" : "deg";
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Функции с эллипсоидом: единицы измерения во время выполнения и перегрузки со структурами
+static void AddEllipsoidCases( TRegistry &reg, const TData &d, const Geo::CEllipsoid &el, Units::TRangeUnit ru,
+    Units::TAngleUnit au )
+{
+    const char *h = "geodesy.h";
+    reg.Add( h, "Ellipsoids::Get", "runtime", [&el]( std::size_t n ) {
+        const Geo::TEllipsoidId id = ( el.Invf() == 0.0 ) ? Geo::EL_Sphere6371 : Geo::EL_WGS84;
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            s += Geo::Ellipsoids::Get( id ).A();
+        }
+        return s;
+    } );
+    reg.Add( h, "CEllipsoid::CEllipsoid", "runtime", [&el]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const Geo::CEllipsoid e( "bench", el.A() + ( k & 1 ), el.B(), el.Invf(), el.Invf() != 0.0 );
+            s += e.EccentricitySecondSquared();
+        }
+        return s;
+    } );
+    reg.Add( h, "GEOtoRAD", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, r, a, ae;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::GEOtoRAD( el, ru, au, d.Lat1[i], d.Lon1[i], d.Lat2[i], d.Lon2[i], r, a, ae );
+            s += r + a + ae;
+        }
+        return s;
+    } );
+    reg.Add( h, "GEOtoRAD(GM_Karney)", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, r, a, ae;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::GEOtoRAD( el, Geo::GM_Karney, ru, au, d.Lat1[i], d.Lon1[i], d.Lat2[i], d.Lon2[i], r, a, ae );
+            s += r + a + ae;
+        }
+        return s;
+    } );
+    reg.Add( h, "GEOtoRAD", "struct", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::RAD r = Geo::GEOtoRAD( el, ru, au, Geo::Geographic( d.Lat1[i], d.Lon1[i] ),
+                Geo::Geographic( d.Lat2[i], d.Lon2[i] ) );
+            s += r.R + r.Az + r.AzEnd;
+        }
+        return s;
+    } );
+    reg.Add( h, "RADtoGEO", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, b, l, ae;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::RADtoGEO( el, ru, au, d.Lat1[i], d.Lon1[i], d.D[i], d.Az[i], b, l, ae );
+            s += b + l + ae;
+        }
+        return s;
+    } );
+    reg.Add( h, "RADtoGEO(GM_Karney)", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, b, l, ae;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::RADtoGEO( el, Geo::GM_Karney, ru, au, d.Lat1[i], d.Lon1[i], d.D[i], d.Az[i], b, l, ae );
+            s += b + l + ae;
+        }
+        return s;
+    } );
+    reg.Add( h, "RADtoGEO", "struct", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, ae;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::Geographic g = Geo::RADtoGEO( el, ru, au, Geo::Geographic( d.Lat1[i], d.Lon1[i] ),
+                Geo::RAD( d.D[i], d.Az[i], 0.0 ), ae );
+            s += g.Lat + g.Lon + ae;
+        }
+        return s;
+    } );
+    reg.Add( h, "GEOtoECEF", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, x, y, z;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::GEOtoECEF( el, ru, au, d.Lat1[i], d.Lon1[i], d.H1[i], x, y, z );
+            s += x + y + z;
+        }
+        return s;
+    } );
+    reg.Add( h, "GEOtoECEF", "struct", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::XYZ p = Geo::GEOtoECEF( el, ru, au, Geo::Geodetic( d.Lat1[i], d.Lon1[i], d.H1[i] ) );
+            s += p.X + p.Y + p.Z;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoGEO", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, b, l, hh;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEFtoGEO( el, ru, au, d.X1[i], d.Y1[i], d.Z1[i], b, l, hh );
+            s += b + l + hh;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoGEO", "struct", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::XYZ p( d.X1[i], d.Y1[i], d.Z1[i] );
+            const Geo::Geodetic g = Geo::ECEFtoGEO( el, ru, au, p );
+            s += g.Lat + g.Lon + g.Height;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEF_offset", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, x, y, z;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEF_offset( el, ru, au, d.Lat1[i], d.Lon1[i], d.H1[i], d.Lat2[i], d.Lon2[i], d.H2[i], x, y, z );
+            s += x + y + z;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEF_offset", "struct", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::XYZ p = Geo::ECEF_offset( el, ru, au, Geo::Geodetic( d.Lat1[i], d.Lon1[i], d.H1[i] ),
+                Geo::Geodetic( d.Lat2[i], d.Lon2[i], d.H2[i] ) );
+            s += p.X + p.Y + p.Z;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoENU", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, e, nn, u;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEFtoENU( el, ru, au, d.X2[i], d.Y2[i], d.Z2[i], d.Lat1[i], d.Lon1[i], d.H1[i], e, nn, u );
+            s += e + nn + u;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoENU", "struct", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::ENU p = Geo::ECEFtoENU( el, ru, au, Geo::XYZ( d.X2[i], d.Y2[i], d.Z2[i] ),
+                Geo::Geodetic( d.Lat1[i], d.Lon1[i], d.H1[i] ) );
+            s += p.E + p.N + p.U;
+        }
+        return s;
+    } );
+    reg.Add( h, "ENUtoECEF", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, x, y, z;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ENUtoECEF( el, ru, au, d.E[i], d.N[i], d.U[i], d.Lat1[i], d.Lon1[i], d.H1[i], x, y, z );
+            s += x + y + z;
+        }
+        return s;
+    } );
+    reg.Add( h, "ENUtoECEF", "struct", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::XYZ p = Geo::ENUtoECEF( el, ru, au, Geo::ENU( d.E[i], d.N[i], d.U[i] ),
+                Geo::Geodetic( d.Lat1[i], d.Lon1[i], d.H1[i] ) );
+            s += p.X + p.Y + p.Z;
+        }
+        return s;
+    } );
+    reg.Add( h, "GEOtoENU", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, e, nn, u;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::GEOtoENU( el, ru, au, d.Lat2[i], d.Lon2[i], d.H2[i], d.Lat1[i], d.Lon1[i], d.H1[i], e, nn, u );
+            s += e + nn + u;
+        }
+        return s;
+    } );
+    reg.Add( h, "GEOtoENU", "struct", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::ENU p = Geo::GEOtoENU( el, ru, au, Geo::Geodetic( d.Lat2[i], d.Lon2[i], d.H2[i] ),
+                Geo::Geodetic( d.Lat1[i], d.Lon1[i], d.H1[i] ) );
+            s += p.E + p.N + p.U;
+        }
+        return s;
+    } );
+    reg.Add( h, "ENUtoGEO", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, b, l, hh;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ENUtoGEO( el, ru, au, d.E[i], d.N[i], d.U[i], d.Lat1[i], d.Lon1[i], d.H1[i], b, l, hh );
+            s += b + l + hh;
+        }
+        return s;
+    } );
+    reg.Add( h, "ENUtoGEO", "struct", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::Geodetic g = Geo::ENUtoGEO( el, ru, au, Geo::ENU( d.E[i], d.N[i], d.U[i] ),
+                Geo::Geodetic( d.Lat1[i], d.Lon1[i], d.H1[i] ) );
+            s += g.Lat + g.Lon + g.Height;
+        }
+        return s;
+    } );
+    reg.Add( h, "GEOtoAER", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, a, e, r;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::GEOtoAER( el, ru, au, d.Lat1[i], d.Lon1[i], d.H1[i], d.Lat2[i], d.Lon2[i], d.H2[i], a, e, r );
+            s += a + e + r;
+        }
+        return s;
+    } );
+    reg.Add( h, "GEOtoAER", "struct", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::AER p = Geo::GEOtoAER( el, ru, au, Geo::Geodetic( d.Lat1[i], d.Lon1[i], d.H1[i] ),
+                Geo::Geodetic( d.Lat2[i], d.Lon2[i], d.H2[i] ) );
+            s += p.A + p.E + p.R;
+        }
+        return s;
+    } );
+    reg.Add( h, "AERtoGEO", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, b, l, hh;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::AERtoGEO( el, ru, au, d.AerA[i], d.AerE[i], d.AerR[i], d.Lat1[i], d.Lon1[i], d.H1[i], b, l, hh );
+            s += b + l + hh;
+        }
+        return s;
+    } );
+    reg.Add( h, "AERtoGEO", "struct", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::Geodetic g = Geo::AERtoGEO( el, ru, au, Geo::AER( d.AerA[i], d.AerE[i], d.AerR[i] ),
+                Geo::Geodetic( d.Lat1[i], d.Lon1[i], d.H1[i] ) );
+            s += g.Lat + g.Lon + g.Height;
+        }
+        return s;
+    } );
+    reg.Add( h, "AERtoECEF", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, x, y, z;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::AERtoECEF( el, ru, au, d.AerA[i], d.AerE[i], d.AerR[i], d.Lat1[i], d.Lon1[i], d.H1[i], x, y, z );
+            s += x + y + z;
+        }
+        return s;
+    } );
+    reg.Add( h, "AERtoECEF", "struct", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::XYZ p = Geo::AERtoECEF( el, ru, au, Geo::AER( d.AerA[i], d.AerE[i], d.AerR[i] ),
+                Geo::Geodetic( d.Lat1[i], d.Lon1[i], d.H1[i] ) );
+            s += p.X + p.Y + p.Z;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoAER", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, a, e, r;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEFtoAER( el, ru, au, d.X2[i], d.Y2[i], d.Z2[i], d.Lat1[i], d.Lon1[i], d.H1[i], a, e, r );
+            s += a + e + r;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoAER", "struct", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::AER p = Geo::ECEFtoAER( el, ru, au, Geo::XYZ( d.X2[i], d.Y2[i], d.Z2[i] ),
+                Geo::Geodetic( d.Lat1[i], d.Lon1[i], d.H1[i] ) );
+            s += p.A + p.E + p.R;
+        }
+        return s;
+    } );
+    reg.Add( h, "ENUtoUVW", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0, u, v, w;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ENUtoUVW( el, ru, au, d.E[i], d.N[i], d.U[i], d.Lat1[i], d.Lon1[i], u, v, w );
+            s += u + v + w;
+        }
+        return s;
+    } );
+    reg.Add( h, "ENUtoUVW", "struct", [&d, el, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::UVW p = Geo::ENUtoUVW( el, ru, au, Geo::ENU( d.E[i], d.N[i], d.U[i] ),
+                Geo::Geographic( d.Lat1[i], d.Lon1[i] ) );
+            s += p.U + p.V + p.W;
+        }
+        return s;
+    } );
+    // Молоденский: из эллипсоида модели в эллипсоид Красовского со сдвигом SK42toWGS84 (обратным)
+    reg.Add( h, "GEOtoGeoMolodenskyAbridged", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        const Geo::CEllipsoid &el1 = Geo::Ellipsoids::Krassowsky1940();
+        double s = 0.0, b, l, hh;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::GEOtoGeoMolodenskyAbridged( el, ru, au, d.Lat1[i], d.Lon1[i], d.H1[i], -23.92, 141.27, 80.90, el1,
+                b, l, hh );
+            s += b + l + hh;
+        }
+        return s;
+    } );
+    reg.Add( h, "GEOtoGeoMolodenskyStandard", "runtime", [&d, el, ru, au]( std::size_t n ) {
+        const Geo::CEllipsoid &el1 = Geo::Ellipsoids::Krassowsky1940();
+        double s = 0.0, b, l, hh;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::GEOtoGeoMolodenskyStandard( el, ru, au, d.Lat1[i], d.Lon1[i], d.H1[i], -23.57, 140.95, 79.8, 0.0,
+                -0.35, -0.79, -0.22e-6, el1, b, l, hh );
+            s += b + l + hh;
+        }
+        return s;
+    } );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Функции с эллипсоидом и единицами измерения, заданными при компиляции
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+static void AddEllipsoidTemplateCases( TRegistry &reg, const TData &d, const Geo::CEllipsoid &el )
+{
+    const char *h = "geodesy.h";
+    reg.Add( h, "GEOtoRAD", "template", [&d, el]( std::size_t n ) {
+        double s = 0.0, r, a, ae;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::GEOtoRAD<RU, AU>( el, d.Lat1[i], d.Lon1[i], d.Lat2[i], d.Lon2[i], r, a, ae );
+            s += r + a + ae;
+        }
+        return s;
+    } );
+    reg.Add( h, "RADtoGEO", "template", [&d, el]( std::size_t n ) {
+        double s = 0.0, b, l, ae;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::RADtoGEO<RU, AU>( el, d.Lat1[i], d.Lon1[i], d.D[i], d.Az[i], b, l, ae );
+            s += b + l + ae;
+        }
+        return s;
+    } );
+    reg.Add( h, "GEOtoECEF", "template", [&d, el]( std::size_t n ) {
+        double s = 0.0, x, y, z;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::GEOtoECEF<RU, AU>( el, d.Lat1[i], d.Lon1[i], d.H1[i], x, y, z );
+            s += x + y + z;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoGEO", "template", [&d, el]( std::size_t n ) {
+        double s = 0.0, b, l, hh;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEFtoGEO<RU, AU>( el, d.X1[i], d.Y1[i], d.Z1[i], b, l, hh );
+            s += b + l + hh;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEF_offset", "template", [&d, el]( std::size_t n ) {
+        double s = 0.0, x, y, z;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEF_offset<RU, AU>( el, d.Lat1[i], d.Lon1[i], d.H1[i], d.Lat2[i], d.Lon2[i], d.H2[i], x, y, z );
+            s += x + y + z;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoENU", "template", [&d, el]( std::size_t n ) {
+        double s = 0.0, e, nn, u;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEFtoENU<RU, AU>( el, d.X2[i], d.Y2[i], d.Z2[i], d.Lat1[i], d.Lon1[i], d.H1[i], e, nn, u );
+            s += e + nn + u;
+        }
+        return s;
+    } );
+    reg.Add( h, "ENUtoECEF", "template", [&d, el]( std::size_t n ) {
+        double s = 0.0, x, y, z;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ENUtoECEF<RU, AU>( el, d.E[i], d.N[i], d.U[i], d.Lat1[i], d.Lon1[i], d.H1[i], x, y, z );
+            s += x + y + z;
+        }
+        return s;
+    } );
+    reg.Add( h, "GEOtoENU", "template", [&d, el]( std::size_t n ) {
+        double s = 0.0, e, nn, u;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::GEOtoENU<RU, AU>( el, d.Lat2[i], d.Lon2[i], d.H2[i], d.Lat1[i], d.Lon1[i], d.H1[i], e, nn, u );
+            s += e + nn + u;
+        }
+        return s;
+    } );
+    reg.Add( h, "ENUtoGEO", "template", [&d, el]( std::size_t n ) {
+        double s = 0.0, b, l, hh;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ENUtoGEO<RU, AU>( el, d.E[i], d.N[i], d.U[i], d.Lat1[i], d.Lon1[i], d.H1[i], b, l, hh );
+            s += b + l + hh;
+        }
+        return s;
+    } );
+    reg.Add( h, "GEOtoAER", "template", [&d, el]( std::size_t n ) {
+        double s = 0.0, a, e, r;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::GEOtoAER<RU, AU>( el, d.Lat1[i], d.Lon1[i], d.H1[i], d.Lat2[i], d.Lon2[i], d.H2[i], a, e, r );
+            s += a + e + r;
+        }
+        return s;
+    } );
+    reg.Add( h, "AERtoGEO", "template", [&d, el]( std::size_t n ) {
+        double s = 0.0, b, l, hh;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::AERtoGEO<RU, AU>( el, d.AerA[i], d.AerE[i], d.AerR[i], d.Lat1[i], d.Lon1[i], d.H1[i], b, l, hh );
+            s += b + l + hh;
+        }
+        return s;
+    } );
+    reg.Add( h, "AERtoECEF", "template", [&d, el]( std::size_t n ) {
+        double s = 0.0, x, y, z;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::AERtoECEF<RU, AU>( el, d.AerA[i], d.AerE[i], d.AerR[i], d.Lat1[i], d.Lon1[i], d.H1[i], x, y, z );
+            s += x + y + z;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoAER", "template", [&d, el]( std::size_t n ) {
+        double s = 0.0, a, e, r;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEFtoAER<RU, AU>( el, d.X2[i], d.Y2[i], d.Z2[i], d.Lat1[i], d.Lon1[i], d.H1[i], a, e, r );
+            s += a + e + r;
+        }
+        return s;
+    } );
+    reg.Add( h, "ENUtoUVW", "template", [&d, el]( std::size_t n ) {
+        double s = 0.0, u, v, w;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ENUtoUVW<RU, AU>( el, d.E[i], d.N[i], d.U[i], d.Lat1[i], d.Lon1[i], u, v, w );
+            s += u + v + w;
+        }
+        return s;
+    } );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Функции без эллипсоида, зависящие от единиц измерения
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+static void AddUnitCases( TRegistry &reg, const TData &d )
+{
+    const char *h = "geodesy.h";
+    const Units::TRangeUnit ru = RU;
+    const Units::TAngleUnit au = AU;
+    reg.Add( h, "ECEFtoENUV", "runtime", [&d, ru, au]( std::size_t n ) {
+        double s = 0.0, e, nn, u;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEFtoENUV( ru, au, d.X2[i] - d.X1[i], d.Y2[i] - d.Y1[i], d.Z2[i] - d.Z1[i], d.Lat1[i], d.Lon1[i],
+                e, nn, u );
+            s += e + nn + u;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoENUV", "template", [&d]( std::size_t n ) {
+        double s = 0.0, e, nn, u;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEFtoENUV<RU, AU>( d.X2[i] - d.X1[i], d.Y2[i] - d.Y1[i], d.Z2[i] - d.Z1[i], d.Lat1[i], d.Lon1[i],
+                e, nn, u );
+            s += e + nn + u;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoENUV", "struct", [&d, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::ENU p = Geo::ECEFtoENUV( ru, au, Geo::XYZ( d.X2[i] - d.X1[i], d.Y2[i] - d.Y1[i],
+                d.Z2[i] - d.Z1[i] ), Geo::Geographic( d.Lat1[i], d.Lon1[i] ) );
+            s += p.E + p.N + p.U;
+        }
+        return s;
+    } );
+    reg.Add( h, "ENUtoAER", "runtime", [&d, ru, au]( std::size_t n ) {
+        double s = 0.0, a, e, r;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ENUtoAER( ru, au, d.E[i], d.N[i], d.U[i], a, e, r );
+            s += a + e + r;
+        }
+        return s;
+    } );
+    reg.Add( h, "ENUtoAER", "template", [&d]( std::size_t n ) {
+        double s = 0.0, a, e, r;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ENUtoAER<RU, AU>( d.E[i], d.N[i], d.U[i], a, e, r );
+            s += a + e + r;
+        }
+        return s;
+    } );
+    reg.Add( h, "ENUtoAER", "struct", [&d, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::AER p = Geo::ENUtoAER( ru, au, Geo::ENU( d.E[i], d.N[i], d.U[i] ) );
+            s += p.A + p.E + p.R;
+        }
+        return s;
+    } );
+    reg.Add( h, "AERtoENU", "runtime", [&d, ru, au]( std::size_t n ) {
+        double s = 0.0, e, nn, u;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::AERtoENU( ru, au, d.AerA[i], d.AerE[i], d.AerR[i], e, nn, u );
+            s += e + nn + u;
+        }
+        return s;
+    } );
+    reg.Add( h, "AERtoENU", "template", [&d]( std::size_t n ) {
+        double s = 0.0, e, nn, u;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::AERtoENU<RU, AU>( d.AerA[i], d.AerE[i], d.AerR[i], e, nn, u );
+            s += e + nn + u;
+        }
+        return s;
+    } );
+    reg.Add( h, "AERtoENU", "struct", [&d, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::ENU p = Geo::AERtoENU( ru, au, Geo::AER( d.AerA[i], d.AerE[i], d.AerR[i] ) );
+            s += p.E + p.N + p.U;
+        }
+        return s;
+    } );
+    reg.Add( h, "SK42toGaussKruger", "runtime", [&d, ru, au]( std::size_t n ) {
+        double s = 0.0;
+        int zone, x, y;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::SK42toGaussKruger( ru, au, d.Lat1[i], d.Lon1[i], zone, x, y );
+            s += zone + x + y;
+        }
+        return s;
+    } );
+    reg.Add( h, "GaussKrugerToSK42", "runtime", [&d, ru, au]( std::size_t n ) {
+        double s = 0.0, b, l;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::GaussKrugerToSK42( ru, au, d.GkX[i], d.GkY[i], b, l );
+            s += b + l;
+        }
+        return s;
+    } );
+
+    const char *c = "convert.h";
+    reg.Add( c, "AngleTo360(double)", "runtime", [&d, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            s += Convert::AngleTo360( d.Angle[k & d.Mask], au );
+        }
+        return s;
+    } );
+    reg.Add( c, "AngleTo360(float)", "runtime", [&d, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            s += Convert::AngleTo360( static_cast<float>( d.Angle[k & d.Mask] ), au );
+        }
+        return s;
+    } );
+    reg.Add( c, "EpsToMP90(double)", "runtime", [&d, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            s += Convert::EpsToMP90( d.Angle[k & d.Mask], au );
+        }
+        return s;
+    } );
+    reg.Add( c, "EpsToMP90(float)", "runtime", [&d, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            s += Convert::EpsToMP90( static_cast<float>( d.Angle[k & d.Mask] ), au );
+        }
+        return s;
+    } );
+    reg.Add( c, "AbsAzToRelAz", "runtime", [&d, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            s += Convert::AbsAzToRelAz( d.Angle[i], d.Az[i], au );
+        }
+        return s;
+    } );
+    reg.Add( c, "RelAzToAbsAz", "runtime", [&d, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            s += Convert::RelAzToAbsAz( d.Angle[i], d.Az[i], au );
+        }
+        return s;
+    } );
+    reg.Add( c, "CheckDeltaAngle", "runtime", [&d, au]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            s += Convert::CheckDeltaAngle( d.Az[i] - d.AerA[i], au );
+        }
+        return s;
+    } );
+    reg.Add( c, "AngleToRad", "template", [&d]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            s += Convert::AngleToRad<AU>( d.Angle[k & d.Mask] );
+        }
+        return s;
+    } );
+    reg.Add( c, "AngleFromRad", "template", [&d]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            s += Convert::AngleFromRad<AU>( d.Angle[k & d.Mask] );
+        }
+        return s;
+    } );
+    reg.Add( c, "RangeToMeter", "template", [&d]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            s += Convert::RangeToMeter<RU>( d.D[k & d.Mask] );
+        }
+        return s;
+    } );
+    reg.Add( c, "RangeFromMeter", "template", [&d]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            s += Convert::RangeFromMeter<RU>( d.D[k & d.Mask] );
+        }
+        return s;
+    } );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Функции, не зависящие от эллипсоида и единиц измерения
+static void AddPlainCases( TRegistry &reg, const TData &d )
+{
+    const char *h = "geodesy.h";
+    reg.Add( h, "XYZtoDistance", "runtime", [&d]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            s += Geo::XYZtoDistance( d.X1[i], d.Y1[i], d.Z1[i], d.X2[i], d.Y2[i], d.Z2[i] );
+        }
+        return s;
+    } );
+    reg.Add( h, "XYZtoDistance", "struct", [&d]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            s += Geo::XYZtoDistance( Geo::XYZ( d.X1[i], d.Y1[i], d.Z1[i] ), Geo::XYZ( d.X2[i], d.Y2[i], d.Z2[i] ) );
+        }
+        return s;
+    } );
+    reg.Add( h, "CosAngleBetweenVectors", "runtime", [&d]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            s += Geo::CosAngleBetweenVectors( d.X1[i], d.Y1[i], d.Z1[i], d.X2[i], d.Y2[i], d.Z2[i] );
+        }
+        return s;
+    } );
+    reg.Add( h, "CosAngleBetweenVectors", "struct", [&d]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            s += Geo::CosAngleBetweenVectors( Geo::XYZ( d.X1[i], d.Y1[i], d.Z1[i] ),
+                Geo::XYZ( d.X2[i], d.Y2[i], d.Z2[i] ) );
+        }
+        return s;
+    } );
+    reg.Add( h, "AngleBetweenVectors", "runtime", [&d]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            s += Geo::AngleBetweenVectors( d.X1[i], d.Y1[i], d.Z1[i], d.X2[i], d.Y2[i], d.Z2[i] );
+        }
+        return s;
+    } );
+    reg.Add( h, "AngleBetweenVectors", "struct", [&d]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            s += Geo::AngleBetweenVectors( Geo::XYZ( d.X1[i], d.Y1[i], d.Z1[i] ),
+                Geo::XYZ( d.X2[i], d.Y2[i], d.Z2[i] ) );
+        }
+        return s;
+    } );
+    reg.Add( h, "VectorFromTwoPoints", "runtime", [&d]( std::size_t n ) {
+        double s = 0.0, x, y, z;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::VectorFromTwoPoints( d.X1[i], d.Y1[i], d.Z1[i], d.X2[i], d.Y2[i], d.Z2[i], x, y, z );
+            s += x + y + z;
+        }
+        return s;
+    } );
+    reg.Add( h, "VectorFromTwoPoints", "struct", [&d]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            const Geo::XYZ p = Geo::VectorFromTwoPoints( Geo::XYZ( d.X1[i], d.Y1[i], d.Z1[i] ),
+                Geo::XYZ( d.X2[i], d.Y2[i], d.Z2[i] ) );
+            s += p.X + p.Y + p.Z;
+        }
+        return s;
+    } );
+    reg.Add( h, "GetShiftECEF_3", "runtime", []( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const bool back = ( k & 1 ) != 0;
+            s += Geo::GetShiftECEF_3( back ? Geo::GD_WGS84 : Geo::GD_SK42, back ? Geo::GD_SK42 : Geo::GD_WGS84 ).dX();
+        }
+        return s;
+    } );
+    reg.Add( h, "GetShiftECEF_7", "runtime", []( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const bool back = ( k & 1 ) != 0;
+            s += Geo::GetShiftECEF_7( back ? Geo::GD_WGS84 : Geo::GD_SK42, back ? Geo::GD_SK42 : Geo::GD_WGS84 ).dX();
+        }
+        return s;
+    } );
+    reg.Add( h, "IsShiftECEF_7Defined", "runtime", []( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            s += Geo::IsShiftECEF_7Defined( static_cast<Geo::TGeodeticDatum>( k % Geo::GD_Count ),
+                static_cast<Geo::TGeodeticDatum>( ( k / Geo::GD_Count ) % Geo::GD_Count ) ) ? 1.0 : 0.0;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoECEF_3params", "runtime", [&d]( std::size_t n ) {
+        double s = 0.0, x, y, z;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEFtoECEF_3params( d.X1[i], d.Y1[i], d.Z1[i], 23.92, -141.27, -80.90, x, y, z );
+            s += x + y + z;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoECEF_3params(datum)", "runtime", [&d]( std::size_t n ) {
+        double s = 0.0, x, y, z;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEFtoECEF_3params( Geo::GD_SK42, d.X1[i], d.Y1[i], d.Z1[i], Geo::GD_WGS84, x, y, z );
+            s += x + y + z;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoECEF_3params(datum)", "struct", [&d]( std::size_t n ) {
+        double s = 0.0;
+        Geo::XYZ p;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEFtoECEF_3params( Geo::GD_SK42, Geo::XYZ( d.X1[i], d.Y1[i], d.Z1[i] ), Geo::GD_WGS84, p );
+            s += p.X + p.Y + p.Z;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoECEF_7params", "runtime", [&d]( std::size_t n ) {
+        double s = 0.0, x, y, z;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEFtoECEF_7params( d.X1[i], d.Y1[i], d.Z1[i], 23.57, -140.95, -79.8, 0.0, -0.35, -0.79, -0.22e-6,
+                x, y, z );
+            s += x + y + z;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoECEF_7params(datum)", "runtime", [&d]( std::size_t n ) {
+        double s = 0.0, x, y, z;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEFtoECEF_7params( Geo::GD_SK42, d.X1[i], d.Y1[i], d.Z1[i], Geo::GD_WGS84, x, y, z );
+            s += x + y + z;
+        }
+        return s;
+    } );
+    reg.Add( h, "ECEFtoECEF_7params(datum)", "struct", [&d]( std::size_t n ) {
+        double s = 0.0;
+        Geo::XYZ p;
+        for( std::size_t k = 0; k < n; k++ ) {
+            const std::size_t i = k & d.Mask;
+            Geo::ECEFtoECEF_7params( Geo::GD_SK42, Geo::XYZ( d.X1[i], d.Y1[i], d.Z1[i] ), Geo::GD_WGS84, p );
+            s += p.X + p.Y + p.Z;
+        }
+        return s;
+    } );
+
+    const char *c = "convert.h";
+    reg.Add( c, "dBtoTimesByP", "runtime", [&d]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            s += Convert::dBtoTimesByP( 0.01 * d.Angle[k & d.Mask] );
+        }
+        return s;
+    } );
+    reg.Add( c, "dBtoTimesByU", "runtime", [&d]( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            s += Convert::dBtoTimesByU( 0.01 * d.Angle[k & d.Mask] );
+        }
+        return s;
+    } );
+    reg.Add( c, "UnixTimeToHourMinSec", "runtime", [&d]( std::size_t n ) {
+        double s = 0.0;
+        int hour, min, sec, day, mon, year;
+        for( std::size_t k = 0; k < n; k++ ) {
+            Convert::UnixTimeToHourMinSec( d.Time[k & d.Mask], hour, min, sec, day, mon, year );
+            s += hour + min + sec + day + mon + year;
+        }
+        return s;
+    } );
+    reg.Add( c, "CurrentDateTimeToString", "runtime", []( std::size_t n ) {
+        double s = 0.0;
+        for( std::size_t k = 0; k < n; k++ ) {
+            s += static_cast<double>( Convert::CurrentDateTimeToString().size() );
+        }
+        return s;
+    } );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Результат замера случая
+struct TResult
+{
+    double NsBest;      // Наименьшее время вызова, [нс]
+    double NsMedian;    // Медиана времени вызова, [нс]
+    std::size_t Calls;  // Число вызовов в одном прогоне
+    double Checksum;    // Контрольная сумма первых points вызовов (не зависит от подбора числа вызовов)
+};
+
+static TResult Measure( const TCase &c, std::size_t points, double minTime, int repeats )
+{
+    // Прогрев и подбор числа вызовов: прогон не короче minTime
+    std::size_t calls = points;
+    const double checksum = c.Run( calls );
+    for( ;; ) {
+        const TClock::time_point t0 = TClock::now();
+        Sink = c.Run( calls );
+        const double seconds = std::chrono::duration<double>( TClock::now() - t0 ).count();
+        if( ( seconds >= minTime ) || ( calls >= ( std::size_t( 1 ) << 40 ) ) ) {
+            break;
+        }
+        const double scale = ( seconds > 0.0 ) ? 1.2 * minTime / seconds : 10.0;
+        calls = static_cast<std::size_t>( calls * std::min( std::max( scale, 2.0 ), 100.0 ) );
+    }
+    std::vector<double> ns;
+    for( int r = 0; r < repeats; r++ ) {
+        const TClock::time_point t0 = TClock::now();
+        Sink = c.Run( calls );
+        ns.push_back( std::chrono::duration<double, std::nano>( TClock::now() - t0 ).count() / calls );
+    }
+    std::sort( ns.begin(), ns.end() );
+    return { ns.front(), ns[ns.size() / 2], calls, checksum };
+}
+
+// Число JSON (null для бесконечностей и NaN)
+static std::string JsonNumber( double value, const char *format )
+{
+    if( !std::isfinite( value ) ) {
+        return "null";
+    }
+    char buffer[64];
+    std::snprintf( buffer, sizeof( buffer ), format, value );
+    return buffer;
+}
+
+// Строка JSON с экранированием
+static std::string JsonString( const std::string &s )
+{
+    std::string result = "\"";
+    for( char ch : s ) {
+        if( ( ch == '"' ) || ( ch == '\\' ) ) {
+            result += '\\';
+            result += ch;
+        } else if( static_cast<unsigned char>( ch ) < 0x20 ) {
+            char buffer[8];
+            std::snprintf( buffer, sizeof( buffer ), "\\u%04x", static_cast<unsigned>( ch ) );
+            result += buffer;
+        } else {
+            result += ch;
+        }
+    }
+    return result + "\"";
+}
+
+static void Usage()
+{
+    std::fprintf( stderr, "usage: bench_spml [--points N] [--seed S] [--min-time SECONDS] [--repeats R] "
+        "[--filter SUBSTRING] [--output FILE]\n" );
+}
+
+int main( int argc, char *argv[] )
+{
+    std::size_t points = 4096;
+    unsigned seed = 20261016;
+    double minTime = 0.01;
+    int repeats = 5;
+    std::string filter, output;
+    for( int i = 1; i < argc; i++ ) {
+        const std::string arg = argv[i];
+        if( i + 1 >= argc ) {
+            Usage();
+            return EXIT_FAILURE;
+        }
+        const char *value = argv[++i];
+        if( arg == "--points" ) {
+            points = std::strtoul( value, nullptr, 10 );
+        } else if( arg == "--seed" ) {
+            seed = static_cast<unsigned>( std::strtoul( value, nullptr, 10 ) );
+        } else if( arg == "--min-time" ) {
+            minTime = std::strtod( value, nullptr );
+        } else if( arg == "--repeats" ) {
+            repeats = std::atoi( value );
+        } else if( arg == "--filter" ) {
+            filter = value;
+        } else if( arg == "--output" ) {
+            output = value;
+        } else {
+            Usage();
+            return EXIT_FAILURE;
+        }
+    }
+    if( ( points == 0 ) || ( ( points & ( points - 1 ) ) != 0 ) || ( repeats < 1 ) || !( minTime > 0.0 ) ) {
+        std::fprintf( stderr, "--points must be a power of two, --repeats and --min-time positive\n" );
+        return EXIT_FAILURE;
+    }
+
+    // Наборы данных: по одному на модель и единицы измерения (для функций без эллипсоида - наборы WGS84)
+    struct TModel
+    {
+        const char *Name;
+        const Geo::CEllipsoid &Ellipsoid;
+    };
+    const TModel models[] = { { "ellipsoid", Geo::Ellipsoids::WGS84() }, { "sphere", Geo::Ellipsoids::Sphere6371() } };
+    std::vector<std::unique_ptr<TData>> data;
+    TRegistry reg;
+    for( const TModel &m : models ) {
+        reg.Model = m.Name;
+        reg.Ellipsoid = m.Ellipsoid.Name();
+        for( int u = 0; u < 2; u++ ) {
+            const Units::TRangeUnit ru = ( u == 0 ) ? Units::RU_Meter : Units::RU_Kilometer;
+            const Units::TAngleUnit au = ( u == 0 ) ? Units::AU_Radian : Units::AU_Degree;
+            data.emplace_back( new TData( points, seed, m.Ellipsoid, ru, au ) );
+            reg.RangeUnit = RangeName( ru );
+            reg.AngleUnit = AngleName( au );
+            AddEllipsoidCases( reg, *data.back(), m.Ellipsoid, ru, au );
+            if( u == 0 ) {
+                AddEllipsoidTemplateCases<Units::RU_Meter, Units::AU_Radian>( reg, *data.back(), m.Ellipsoid );
+            } else {
+                AddEllipsoidTemplateCases<Units::RU_Kilometer, Units::AU_Degree>( reg, *data.back(), m.Ellipsoid );
+            }
+        }
+    }
+    reg.Model = "none";
+    reg.Ellipsoid.clear();
+    reg.RangeUnit = RangeName( Units::RU_Meter );
+    reg.AngleUnit = AngleName( Units::AU_Radian );
+    AddUnitCases<Units::RU_Meter, Units::AU_Radian>( reg, *data[0] );
+    reg.RangeUnit = RangeName( Units::RU_Kilometer );
+    reg.AngleUnit = AngleName( Units::AU_Degree );
+    AddUnitCases<Units::RU_Kilometer, Units::AU_Degree>( reg, *data[1] );
+    reg.RangeUnit.clear();
+    reg.AngleUnit.clear();
+    AddPlainCases( reg, *data[0] );
+
+    std::FILE *out = stdout;
+    if( !output.empty() ) {
+        out = std::fopen( output.c_str(), "w" );
+        if( out == nullptr ) {
+            std::fprintf( stderr, "can't open %s\n", output.c_str() );
+            return EXIT_FAILURE;
+        }
+    }
+    std::fprintf( out, "{\n  \"benchmark\": \"bench_spml\",\n  \"spml_version\": %s,\n  \"date\": %s,\n",
+        JsonString( SPML::GetVersion() ).c_str(), JsonString( Convert::CurrentDateTimeToString() ).c_str() );
+#if defined( __VERSION__ )
+    std::fprintf( out, "  \"compiler\": %s,\n", JsonString( __VERSION__ ).c_str() );
+#endif
+    std::fprintf( out, "  \"simd\": %s,\n  \"points\": %zu,\n  \"seed\": %u,\n  \"min_time_s\": %g,\n"
+        "  \"repeats\": %d,\n  \"results\": [",
+        JsonString( SPML::SIMD::Name( SPML::SIMD::MaxSupportedLevel() ) ).c_str(), points, seed, minTime, repeats );
+
+    std::size_t written = 0;
+    for( const TCase &c : reg.Cases ) {
+        const std::string id = c.Header + " " + c.Function + " " + c.Variant + " " + c.Model + " " + c.RangeUnit +
+            " " + c.AngleUnit;
+        if( !filter.empty() && ( id.find( filter ) == std::string::npos ) ) {
+            continue;
+        }
+        const TResult r = Measure( c, points, minTime, repeats );
+        std::fprintf( stderr, "%-10s %-30s %-8s %-9s %-3s %-3s %10.2f ns %14.0f calls/s\n", c.Header.c_str(),
+            c.Function.c_str(), c.Variant.c_str(), c.Model.c_str(), c.RangeUnit.c_str(), c.AngleUnit.c_str(),
+            r.NsBest, 1.0e9 / r.NsBest );
+        std::fprintf( out, "%s\n    { \"header\": %s, \"function\": %s, \"variant\": %s, \"model\": %s, "
+            "\"ellipsoid\": %s, \"range_unit\": %s, \"angle_unit\": %s, \"ns_per_call\": %.4f, "
+            "\"ns_per_call_median\": %.4f, \"calls_per_s\": %.1f, \"calls\": %zu, \"checksum\": %s }",
+            ( written == 0 ) ? "" : ",", JsonString( c.Header ).c_str(), JsonString( c.Function ).c_str(),
+            JsonString( c.Variant ).c_str(), JsonString( c.Model ).c_str(),
+            c.Ellipsoid.empty() ? "null" : JsonString( c.Ellipsoid ).c_str(),
+            c.RangeUnit.empty() ? "null" : JsonString( c.RangeUnit ).c_str(),
+            c.AngleUnit.empty() ? "null" : JsonString( c.AngleUnit ).c_str(), r.NsBest, r.NsMedian, 1.0e9 / r.NsBest,
+            r.Calls, JsonNumber( r.Checksum, "%.17g" ).c_str() );
+        written++;
+    }
+    std::fprintf( out, "\n  ]\n}\n" );
+    if( out != stdout ) {
+        std::fclose( out );
+    }
+    return EXIT_SUCCESS;
+}
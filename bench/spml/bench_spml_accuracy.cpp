@@ -0,0 +1,528 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_spml_accuracy.cpp
+/// \brief      Замер точности и скорости вычислителей SPML относительно эталона повышенной точности (long double)
+/// \details    Вычислители одной задачи запускаются на общем наборе данных, результаты сравниваются с эталоном,
+///             посчитанным в long double, и для каждого вычислителя выводится строка: наибольшая и
+///             среднеквадратическая ошибка в метрах и угловых секундах, число отказов (не конечный результат) и
+///             скорость (нс на точку, точек в секунду).
+///             \n Задачи и эталоны:
+///             \n geodesic_inverse, geodesic_direct - геодезические задачи на WGS84. Эталон - прямая задача по
+///             точным интегралам на вспомогательной сфере (Karney C.F.F. Algorithms for geodesics. J. Geodesy, 2013,
+///             формулы 7-8), вычисленным квадратурой Гаусса-Лежандра в long double; конечные точки эталона - входы
+///             обратной задачи. Вычислители на сфере сравниваются с тем же эталоном на эллипсоиде (ошибка модели).
+///             Ошибка: м - дальности (обратная) или положения конечной точки (прямая), угл. с - азимутов.
+///             \n ecef_to_geo, geo_to_ecef - перевод между геодезическими и ECEF координатами WGS84 при высотах от
+///             -10 км до 40000 км. Эталон - итерации до сходимости в long double.
+///             \n datum_sk42_wgs84 - перевод геодезических координат СК-42 в WGS84 (EPSG:5044). Эталон - 7 параметров
+///             Бурса-Вольфа в форме ГОСТ 32453-2017 в long double. Сокращенное преобразование Молоденского
+///             использует только сдвиги (ошибка модели).
+///             \n Ошибка положения в метрах - по радиусам кривизны эталонной точки, в угловых секундах - наибольшая
+///             из ошибок широты и долготы, умноженной на cos( широты ).
+///             \n На платформах, где long double совпадает с double, эталон не точнее вычислителей.
+///             Запуск: bench_spml_accuracy [--points N] [--seed S] [--min-time СЕКУНД] [--format csv|json]
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+// SPML includes:
+#include <geodesy.h>
+#include <geodesy_batch.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+typedef long double TReal;
+
+namespace Geo = SPML::Geodesy;
+
+static const TReal Pi = 3.141592653589793238462643383279502884L;
+static const TReal DegToRad = Pi / 180.0L;
+static const TReal RadToArcsec = 180.0L * 3600.0L / Pi;
+static const double NoValue = std::numeric_limits<double>::quiet_NaN(); // Ошибка не определена для задачи
+
+//----------------------------------------------------------------------------------------------------------------------
+// Эталон: эллипсоид в long double
+struct TRefEllipsoid
+{
+    TReal A, F, B, E2, Ep2;
+
+    explicit TRefEllipsoid( const Geo::CEllipsoid &el )
+    {
+        A = el.A();
+        F = ( el.Invf() == 0.0 ) ? 0.0L : 1.0L / static_cast<TReal>( el.Invf() );
+        B = A * ( 1.0L - F );
+        E2 = F * ( 2.0L - F );
+        Ep2 = E2 / ( ( 1.0L - F ) * ( 1.0L - F ) );
+    }
+
+    // Радиус кривизны меридиана
+    TReal M( TReal lat ) const
+    {
+        const TReal w = 1.0L - E2 * std::sin( lat ) * std::sin( lat );
+        return A * ( 1.0L - E2 ) / ( w * std::sqrt( w ) );
+    }
+
+    // Радиус кривизны первого вертикала
+    TReal N( TReal lat ) const
+    {
+        return A / std::sqrt( 1.0L - E2 * std::sin( lat ) * std::sin( lat ) );
+    }
+};
+
+// Интеграл f( t ) от t0 до t1: составная формула Гаусса-Лежандра по 8 узлов на отрезках не длиннее 1/16 рад
+template <class F>
+static TReal Integrate( F f, TReal t0, TReal t1 )
+{
+    static const TReal x[4] = { 0.1834346424956498049394761423601840L, 0.5255324099163289858177390491892463L,
+        0.7966664774136267395915539364758304L, 0.9602898564975362316835608685694730L };
+    static const TReal w[4] = { 0.3626837833783619829651504492771957L, 0.3137066458778872873379622019866013L,
+        0.2223810344533744705443559944262409L, 0.1012285362903762591525313543099622L };
+    const int parts = std::max( 1, static_cast<int>( std::ceil( std::fabs( t1 - t0 ) * 16.0L ) ) );
+    const TReal h = ( t1 - t0 ) / parts;
+    TReal sum = 0.0L;
+    for( int p = 0; p < parts; p++ ) {
+        const TReal mid = t0 + ( p + 0.5L ) * h;
+        for( int k = 0; k < 4; k++ ) {
+            sum += w[k] * ( f( mid - 0.5L * h * x[k] ) + f( mid + 0.5L * h * x[k] ) );
+        }
+    }
+    return 0.5L * h * sum;
+}
+
+// Эталонная прямая геодезическая задача (углы в радианах)
+static void RefDirect( const TRefEllipsoid &el, TReal lat1, TReal lon1, TReal az1, TReal s, TReal &lat2, TReal &lon2,
+    TReal &az2 )
+{
+    const TReal beta1 = std::atan2( ( 1.0L - el.F ) * std::sin( lat1 ), std::cos( lat1 ) );
+    const TReal sinAlpha0 = std::sin( az1 ) * std::cos( beta1 );
+    const TReal cosAlpha0 = std::hypot( std::cos( az1 ), std::sin( az1 ) * std::sin( beta1 ) );
+    const TReal sigma1 = std::atan2( std::sin( beta1 ), std::cos( az1 ) * std::cos( beta1 ) );
+    const TReal k2 = el.Ep2 * cosAlpha0 * cosAlpha0;
+    const auto ds = [k2]( TReal t ) { return std::sqrt( 1.0L + k2 * std::sin( t ) * std::sin( t ) ); };
+
+    // s / b = I( sigma2 ) - I( sigma1 ), I - интеграл ds: решение методом Ньютона
+    TReal sigma2 = sigma1 + s / el.B;
+    for( int i = 0; i < 20; i++ ) {
+        const TReal step = ( Integrate( ds, sigma1, sigma2 ) - s / el.B ) / ds( sigma2 );
+        sigma2 -= step;
+        if( std::fabs( step ) < 1.0e-19L ) {
+            break;
+        }
+    }
+    const TReal sinBeta2 = cosAlpha0 * std::sin( sigma2 );
+    const TReal cosBeta2 = std::hypot( sinAlpha0, cosAlpha0 * std::cos( sigma2 ) );
+    lat2 = std::atan2( sinBeta2, ( 1.0L - el.F ) * cosBeta2 );
+    az2 = std::atan2( sinAlpha0, cosAlpha0 * std::cos( sigma2 ) );
+
+    const TReal omega1 = std::atan2( sinAlpha0 * std::sin( sigma1 ), std::cos( sigma1 ) );
+    const TReal omega2 = std::atan2( sinAlpha0 * std::sin( sigma2 ), std::cos( sigma2 ) );
+    const TReal f = el.F;
+    const auto dl = [k2, f]( TReal t ) {
+        return ( 2.0L - f ) / ( 1.0L + ( 1.0L - f ) * std::sqrt( 1.0L + k2 * std::sin( t ) * std::sin( t ) ) );
+    };
+    const TReal lambda12 = std::remainder( omega2 - omega1, 2.0L * Pi ) -
+        f * sinAlpha0 * Integrate( dl, sigma1, sigma2 );
+    lon2 = std::remainder( lon1 + lambda12, 2.0L * Pi );
+}
+
+// Эталонный перевод геодезических координат в ECEF
+static void RefGEOtoECEF( const TRefEllipsoid &el, TReal lat, TReal lon, TReal h, TReal &x, TReal &y, TReal &z )
+{
+    const TReal n = el.N( lat );
+    x = ( n + h ) * std::cos( lat ) * std::cos( lon );
+    y = ( n + h ) * std::cos( lat ) * std::sin( lon );
+    z = ( n * ( 1.0L - el.E2 ) + h ) * std::sin( lat );
+}
+
+// Эталонный перевод ECEF в геодезические координаты: итерации широты до сходимости
+static void RefECEFtoGEO( const TRefEllipsoid &el, TReal x, TReal y, TReal z, TReal &lat, TReal &lon, TReal &h )
+{
+    const TReal p = std::hypot( x, y );
+    lon = std::atan2( y, x );
+    lat = std::atan2( z, p * ( 1.0L - el.E2 ) );
+    for( int i = 0; i < 200; i++ ) {
+        const TReal n = el.N( lat );
+        h = p * std::cos( lat ) + z * std::sin( lat ) - el.A * el.A / n;
+        const TReal next = std::atan2( z, p * ( 1.0L - el.E2 * n / ( n + h ) ) );
+        const bool done = std::fabs( next - lat ) < 1.0e-19L;
+        lat = next;
+        if( done ) {
+            break;
+        }
+    }
+    h = p * std::cos( lat ) + z * std::sin( lat ) - el.A * el.A / el.N( lat );
+}
+
+// Эталонное преобразование Бурса-Вольфа (ГОСТ 32453-2017, повороты в радианах)
+static void RefHelmert( const Geo::CShiftECEF_7 &t, TReal xs, TReal ys, TReal zs, TReal &xt, TReal &yt, TReal &zt )
+{
+    const TReal m = 1.0L + static_cast<TReal>( t.S() );
+    const TReal rx = t.rX(), ry = t.rY(), rz = t.rZ();
+    xt = m * ( xs + rz * ys - ry * zs ) + t.dX();
+    yt = m * ( -rz * xs + ys + rx * zs ) + t.dY();
+    zt = m * ( ry * xs - rx * ys + zs ) + t.dZ();
+}
+
+// Разность углов в (-pi, pi]
+static TReal AngleDiff( TReal a, TReal b )
+{
+    return std::remainder( a - b, 2.0L * Pi );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Накопитель ошибок
+struct TErrors
+{
+    double MaxM = 0.0, SumM2 = 0.0, MaxArcsec = 0.0, SumArcsec2 = 0.0;
+    std::size_t Count = 0, Failures = 0;
+    bool HasArcsec = false;
+
+    void Add( TReal m, TReal arcsec )
+    {
+        if( !std::isfinite( m ) || ( HasArcsec && !std::isfinite( arcsec ) ) ) {
+            Failures++;
+            return;
+        }
+        Count++;
+        MaxM = std::max( MaxM, static_cast<double>( std::fabs( m ) ) );
+        SumM2 += static_cast<double>( m * m );
+        if( HasArcsec ) {
+            MaxArcsec = std::max( MaxArcsec, static_cast<double>( std::fabs( arcsec ) ) );
+            SumArcsec2 += static_cast<double>( arcsec * arcsec );
+        }
+    }
+
+    double RmsM() const { return ( Count > 0 ) ? std::sqrt( SumM2 / Count ) : NoValue; }
+    double RmsArcsec() const { return ( HasArcsec && ( Count > 0 ) ) ? std::sqrt( SumArcsec2 / Count ) : NoValue; }
+};
+
+// Ошибка положения: метры по радиусам кривизны эталонной точки и угловые секунды
+static void AddPosition( TErrors &errors, const TRefEllipsoid &el, TReal latRef, TReal lonRef, TReal hRef, double lat,
+    double lon, double h, bool withHeight )
+{
+    const TReal dLat = static_cast<TReal>( lat ) * DegToRad - latRef;
+    const TReal dLon = AngleDiff( static_cast<TReal>( lon ) * DegToRad, lonRef ) * std::cos( latRef );
+    const TReal north = dLat * ( el.M( latRef ) + hRef );
+    const TReal east = dLon * ( el.N( latRef ) + hRef );
+    const TReal up = withHeight ? static_cast<TReal>( h ) - hRef : 0.0L;
+    errors.Add( std::sqrt( north * north + east * east + up * up ),
+        std::max( std::fabs( dLat ), std::fabs( dLon ) ) * RadToArcsec );
+}
+
+// Вычислитель: run() решает задачу для всего набора, check() накапливает ошибки результатов
+struct TEngine
+{
+    std::string Problem;    // Задача
+    std::string Engine;     // Вычислитель
+    std::string Model;      // Модель Земли вычислителя
+    std::function<void()> Run;
+    std::function<TErrors()> Check;
+};
+
+// Строка таблицы результатов
+struct TRow
+{
+    const TEngine *Engine;
+    TErrors Errors;
+    std::size_t Points;
+    double NsPerPoint;
+};
+
+// Время на точку: наименьшее из трех прогонов не короче minTime, [нс]
+static double Time( const TEngine &engine, std::size_t points, double minTime )
+{
+    double best = 0.0;
+    for( int r = 0; r < 3; r++ ) {
+        std::size_t runs = 0;
+        const TClock::time_point t0 = TClock::now();
+        double seconds = 0.0;
+        do {
+            engine.Run();
+            runs++;
+            seconds = std::chrono::duration<double>( TClock::now() - t0 ).count();
+        } while( seconds < minTime );
+        const double ns = 1.0e9 * seconds / ( runs * points );
+        best = ( r == 0 ) ? ns : std::min( best, ns );
+    }
+    return best;
+}
+
+static std::string Number( double value, const char *missing )
+{
+    if( !std::isfinite( value ) ) {
+        return missing;
+    }
+    char buffer[64];
+    std::snprintf( buffer, sizeof( buffer ), "%.6g", value );
+    return buffer;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int main( int argc, char *argv[] )
+{
+    std::size_t n = 20000;
+    unsigned seed = 20261016;
+    double minTime = 0.05;
+    std::string format = "csv";
+    for( int i = 1; i + 1 < argc; i += 2 ) {
+        const std::string arg = argv[i];
+        if( arg == "--points" ) {
+            n = std::strtoul( argv[i + 1], nullptr, 10 );
+        } else if( arg == "--seed" ) {
+            seed = static_cast<unsigned>( std::strtoul( argv[i + 1], nullptr, 10 ) );
+        } else if( arg == "--min-time" ) {
+            minTime = std::strtod( argv[i + 1], nullptr );
+        } else if( arg == "--format" ) {
+            format = argv[i + 1];
+        }
+    }
+    if( ( n == 0 ) || ( ( argc % 2 ) == 0 ) || ( ( format != "csv" ) && ( format != "json" ) ) ) {
+        std::fprintf( stderr, "usage: bench_spml_accuracy [--points N] [--seed S] [--min-time SECONDS] "
+            "[--format csv|json]\n" );
+        return EXIT_FAILURE;
+    }
+
+    const Geo::CEllipsoid &wgs84 = Geo::Ellipsoids::WGS84();
+    const Geo::CEllipsoid &sphere = Geo::Ellipsoids::Sphere6371();
+    const Geo::CEllipsoid &krassowsky = Geo::Ellipsoids::Krassowsky1940();
+    const TRefEllipsoid refWgs84( wgs84 ), refKrassowsky( krassowsky );
+    const SPML::Units::TRangeUnit ru = SPML::Units::RU_Meter;
+    const SPML::Units::TAngleUnit au = SPML::Units::AU_Degree;
+    std::mt19937 gen( seed );
+    std::uniform_real_distribution<double> uniform( 0.0, 1.0 );
+
+    // Геодезические задачи: начальная точка, азимут, дальность от 10 м до 15000 км (равномерно по логарифму)
+    std::vector<double> lat1( n ), lon1( n ), az1( n ), s( n ), lat2( n ), lon2( n );
+    std::vector<TReal> refLat2( n ), refLon2( n ), refAz2( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        lat1[i] = std::asin( 2.0 * uniform( gen ) - 1.0 ) * 180.0 / SPML::Consts::PI_D * 0.99;
+        lon1[i] = 360.0 * uniform( gen ) - 180.0;
+        az1[i] = 360.0 * uniform( gen );
+        s[i] = 10.0 * std::pow( 1.5e6, uniform( gen ) );
+        RefDirect( refWgs84, lat1[i] * DegToRad, lon1[i] * DegToRad, az1[i] * DegToRad, s[i], refLat2[i], refLon2[i],
+            refAz2[i] );
+        lat2[i] = static_cast<double>( refLat2[i] / DegToRad );
+        lon2[i] = static_cast<double>( refLon2[i] / DegToRad );
+    }
+
+    // Геодезические и ECEF координаты: высоты от -10 км до 40000 км (равномерно по логарифму высоты + 10 км)
+    std::vector<double> lat( n ), lon( n ), h( n ), x( n ), y( n ), z( n );
+    std::vector<TReal> refX( n ), refY( n ), refZ( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        lat[i] = std::asin( 2.0 * uniform( gen ) - 1.0 ) * 180.0 / SPML::Consts::PI_D;
+        lon[i] = 360.0 * uniform( gen ) - 180.0;
+        h[i] = std::pow( 4.001e7, uniform( gen ) ) - 1.0e4;
+        RefGEOtoECEF( refWgs84, lat[i] * DegToRad, lon[i] * DegToRad, h[i], refX[i], refY[i], refZ[i] );
+        x[i] = static_cast<double>( refX[i] );
+        y[i] = static_cast<double>( refY[i] );
+        z[i] = static_cast<double>( refZ[i] );
+    }
+
+    // СК-42 в WGS84: точки на территории действия СК-42, высоты до 5 км
+    const Geo::CShiftECEF_7 shift = Geo::GetShiftECEF_7( Geo::GD_SK42, Geo::GD_WGS84 );
+    std::vector<double> latSk( n ), lonSk( n ), hSk( n );
+    std::vector<TReal> refLatW( n ), refLonW( n ), refHW( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        latSk[i] = 35.0 + 40.0 * uniform( gen );
+        lonSk[i] = 20.0 + 160.0 * uniform( gen );
+        hSk[i] = 5000.0 * uniform( gen );
+        TReal xs, ys, zs, xt, yt, zt;
+        RefGEOtoECEF( refKrassowsky, latSk[i] * DegToRad, lonSk[i] * DegToRad, hSk[i], xs, ys, zs );
+        RefHelmert( shift, xs, ys, zs, xt, yt, zt );
+        RefECEFtoGEO( refWgs84, xt, yt, zt, refLatW[i], refLonW[i], refHW[i] );
+    }
+
+    std::vector<double> out1( n ), out2( n ), out3( n );
+    std::vector<TEngine> engines;
+
+    // Обратная задача: ошибки дальности и азимутов
+    const auto checkInverse = [&]() {
+        TErrors e;
+        e.HasArcsec = true;
+        for( std::size_t i = 0; i < n; i++ ) {
+            const TReal dAz = std::max( std::fabs( AngleDiff( out2[i] * DegToRad, az1[i] * DegToRad ) ),
+                std::fabs( AngleDiff( out3[i] * DegToRad, refAz2[i] ) ) );
+            e.Add( static_cast<TReal>( out1[i] ) - s[i], dAz * RadToArcsec );
+        }
+        return e;
+    };
+    const auto inverse = [&]( const char *name, const char *model, std::function<void()> run ) {
+        engines.push_back( { "geodesic_inverse", name, model, std::move( run ), checkInverse } );
+    };
+    inverse( "GEOtoRAD(GM_Vincenty)", "wgs84", [&]() {
+        for( std::size_t i = 0; i < n; i++ ) {
+            Geo::GEOtoRAD( wgs84, Geo::GM_Vincenty, ru, au, lat1[i], lon1[i], lat2[i], lon2[i], out1[i], out2[i],
+                out3[i] );
+        }
+    } );
+    inverse( "GEOtoRAD(GM_Karney)", "wgs84", [&]() {
+        for( std::size_t i = 0; i < n; i++ ) {
+            Geo::GEOtoRAD( wgs84, Geo::GM_Karney, ru, au, lat1[i], lon1[i], lat2[i], lon2[i], out1[i], out2[i],
+                out3[i] );
+        }
+    } );
+    inverse( "GEOtoRAD_Batch(GM_Vincenty)", "wgs84", [&]() {
+        Geo::GEOtoRAD_Batch( wgs84, ru, au, lat1.data(), lon1.data(), lat2.data(), lon2.data(), n, out1.data(),
+            out2.data(), out3.data() );
+    } );
+    inverse( "GEOtoRAD", "sphere6371", [&]() {
+        for( std::size_t i = 0; i < n; i++ ) {
+            Geo::GEOtoRAD( sphere, ru, au, lat1[i], lon1[i], lat2[i], lon2[i], out1[i], out2[i], out3[i] );
+        }
+    } );
+
+    // Прямая задача: ошибки положения конечной точки и азимута в ней
+    const auto checkDirect = [&]() {
+        TErrors e;
+        e.HasArcsec = true;
+        for( std::size_t i = 0; i < n; i++ ) {
+            TErrors position;
+            position.HasArcsec = true;
+            AddPosition( position, refWgs84, refLat2[i], refLon2[i], 0.0L, out1[i], out2[i], 0.0, false );
+            const TReal dAz = std::fabs( AngleDiff( out3[i] * DegToRad, refAz2[i] ) ) * RadToArcsec;
+            e.Add( ( position.Count > 0 ) ? position.MaxM : NoValue, dAz );
+        }
+        return e;
+    };
+    const auto direct = [&]( const char *name, const char *model, std::function<void()> run ) {
+        engines.push_back( { "geodesic_direct", name, model, std::move( run ), checkDirect } );
+    };
+    direct( "RADtoGEO(GM_Vincenty)", "wgs84", [&]() {
+        for( std::size_t i = 0; i < n; i++ ) {
+            Geo::RADtoGEO( wgs84, Geo::GM_Vincenty, ru, au, lat1[i], lon1[i], s[i], az1[i], out1[i], out2[i],
+                out3[i] );
+        }
+    } );
+    direct( "RADtoGEO(GM_Karney)", "wgs84", [&]() {
+        for( std::size_t i = 0; i < n; i++ ) {
+            Geo::RADtoGEO( wgs84, Geo::GM_Karney, ru, au, lat1[i], lon1[i], s[i], az1[i], out1[i], out2[i],
+                out3[i] );
+        }
+    } );
+    direct( "RADtoGEO", "sphere6371", [&]() {
+        for( std::size_t i = 0; i < n; i++ ) {
+            Geo::RADtoGEO( sphere, ru, au, lat1[i], lon1[i], s[i], az1[i], out1[i], out2[i], out3[i] );
+        }
+    } );
+
+    // ECEF в геодезические: ошибки положения с высотой
+    const auto checkECEFtoGEO = [&]() {
+        TErrors e;
+        e.HasArcsec = true;
+        for( std::size_t i = 0; i < n; i++ ) {
+            AddPosition( e, refWgs84, lat[i] * DegToRad, lon[i] * DegToRad, h[i], out1[i], out2[i], out3[i], true );
+        }
+        return e;
+    };
+    engines.push_back( { "ecef_to_geo", "ECEFtoGEO", "wgs84", [&]() {
+        for( std::size_t i = 0; i < n; i++ ) {
+            Geo::ECEFtoGEO( wgs84, ru, au, x[i], y[i], z[i], out1[i], out2[i], out3[i] );
+        }
+    }, checkECEFtoGEO } );
+    engines.push_back( { "ecef_to_geo", "ECEFtoGEO_Batch", "wgs84", [&]() {
+        Geo::ECEFtoGEO_Batch( wgs84, ru, au, x.data(), y.data(), z.data(), n, out1.data(), out2.data(), out3.data() );
+    }, checkECEFtoGEO } );
+
+    // Геодезические в ECEF: ошибка положения в метрах
+    const auto checkGEOtoECEF = [&]() {
+        TErrors e;
+        for( std::size_t i = 0; i < n; i++ ) {
+            const TReal dx = out1[i] - refX[i], dy = out2[i] - refY[i], dz = out3[i] - refZ[i];
+            e.Add( std::sqrt( dx * dx + dy * dy + dz * dz ), 0.0L );
+        }
+        return e;
+    };
+    engines.push_back( { "geo_to_ecef", "GEOtoECEF", "wgs84", [&]() {
+        for( std::size_t i = 0; i < n; i++ ) {
+            Geo::GEOtoECEF( wgs84, ru, au, lat[i], lon[i], h[i], out1[i], out2[i], out3[i] );
+        }
+    }, checkGEOtoECEF } );
+    engines.push_back( { "geo_to_ecef", "GEOtoECEF_Batch", "wgs84", [&]() {
+        Geo::GEOtoECEF_Batch( wgs84, ru, au, lat.data(), lon.data(), h.data(), n, out1.data(), out2.data(),
+            out3.data() );
+    }, checkGEOtoECEF } );
+
+    // СК-42 в WGS84
+    const auto checkDatum = [&]() {
+        TErrors e;
+        e.HasArcsec = true;
+        for( std::size_t i = 0; i < n; i++ ) {
+            AddPosition( e, refWgs84, refLatW[i], refLonW[i], refHW[i], out1[i], out2[i], out3[i], true );
+        }
+        return e;
+    };
+    const double arcsec = 3600.0 * 180.0 / SPML::Consts::PI_D; // Угловых секунд в радиане
+    engines.push_back( { "datum_sk42_wgs84", "GEOtoECEF+ECEFtoECEF_7params+ECEFtoGEO", "krassowsky1940>wgs84", [&]() {
+        for( std::size_t i = 0; i < n; i++ ) {
+            double xs, ys, zs, xt, yt, zt;
+            Geo::GEOtoECEF( krassowsky, ru, au, latSk[i], lonSk[i], hSk[i], xs, ys, zs );
+            Geo::ECEFtoECEF_7params( Geo::GD_SK42, xs, ys, zs, Geo::GD_WGS84, xt, yt, zt );
+            Geo::ECEFtoGEO( wgs84, ru, au, xt, yt, zt, out1[i], out2[i], out3[i] );
+        }
+    }, checkDatum } );
+    engines.push_back( { "datum_sk42_wgs84", "GEOtoGeoMolodenskyStandard", "krassowsky1940>wgs84", [&]() {
+        for( std::size_t i = 0; i < n; i++ ) {
+            Geo::GEOtoGeoMolodenskyStandard( krassowsky, ru, au, latSk[i], lonSk[i], hSk[i], shift.dX(), shift.dY(),
+                shift.dZ(), shift.rX() * arcsec, shift.rY() * arcsec, shift.rZ() * arcsec, shift.S(), wgs84, out1[i],
+                out2[i], out3[i] );
+        }
+    }, checkDatum } );
+    engines.push_back( { "datum_sk42_wgs84", "GEOtoGeoMolodenskyAbridged", "krassowsky1940>wgs84", [&]() {
+        for( std::size_t i = 0; i < n; i++ ) {
+            Geo::GEOtoGeoMolodenskyAbridged( krassowsky, ru, au, latSk[i], lonSk[i], hSk[i], shift.dX(), shift.dY(),
+                shift.dZ(), wgs84, out1[i], out2[i], out3[i] );
+        }
+    }, checkDatum } );
+
+    // Замеры: ошибки по результатам первого прогона, затем время
+    std::vector<TRow> rows;
+    for( const TEngine &engine : engines ) {
+        engine.Run();
+        const TErrors errors = engine.Check();
+        rows.push_back( { &engine, errors, n, Time( engine, n, minTime ) } );
+        std::fprintf( stderr, "%-18s %-40s max %12s m %12s arcsec, %10.1f ns/point\n", engine.Problem.c_str(),
+            engine.Engine.c_str(), Number( errors.MaxM, "-" ).c_str(),
+            Number( errors.HasArcsec ? errors.MaxArcsec : NoValue, "-" ).c_str(), rows.back().NsPerPoint );
+    }
+
+    if( format == "csv" ) {
+        std::printf( "problem,engine,model,points,max_error_m,rms_error_m,max_error_arcsec,rms_error_arcsec,failures,"
+            "ns_per_point,points_per_s\n" );
+        for( const TRow &r : rows ) {
+            std::printf( "%s,%s,%s,%zu,%s,%s,%s,%s,%zu,%s,%s\n", r.Engine->Problem.c_str(), r.Engine->Engine.c_str(),
+                r.Engine->Model.c_str(), r.Points, Number( r.Errors.MaxM, "" ).c_str(),
+                Number( r.Errors.RmsM(), "" ).c_str(),
+                Number( r.Errors.HasArcsec ? r.Errors.MaxArcsec : NoValue, "" ).c_str(),
+                Number( r.Errors.RmsArcsec(), "" ).c_str(), r.Errors.Failures, Number( r.NsPerPoint, "" ).c_str(),
+                Number( 1.0e9 / r.NsPerPoint, "" ).c_str() );
+        }
+    } else {
+        std::printf( "{\n  \"benchmark\": \"bench_spml_accuracy\",\n  \"reference\": \"long double (%d-bit mantissa)\","
+            "\n  \"points\": %zu,\n  \"seed\": %u,\n  \"results\": [", std::numeric_limits<TReal>::digits, n, seed );
+        for( std::size_t k = 0; k < rows.size(); k++ ) {
+            const TRow &r = rows[k];
+            std::printf( "%s\n    { \"problem\": \"%s\", \"engine\": \"%s\", \"model\": \"%s\", \"points\": %zu, "
+                "\"max_error_m\": %s, \"rms_error_m\": %s, \"max_error_arcsec\": %s, \"rms_error_arcsec\": %s, "
+                "\"failures\": %zu, \"ns_per_point\": %s, \"points_per_s\": %s }", ( k == 0 ) ? "" : ",",
+                r.Engine->Problem.c_str(), r.Engine->Engine.c_str(), r.Engine->Model.c_str(), r.Points,
+                Number( r.Errors.MaxM, "null" ).c_str(), Number( r.Errors.RmsM(), "null" ).c_str(),
+                Number( r.Errors.HasArcsec ? r.Errors.MaxArcsec : NoValue, "null" ).c_str(),
+                Number( r.Errors.RmsArcsec(), "null" ).c_str(), r.Errors.Failures,
+                Number( r.NsPerPoint, "null" ).c_str(), Number( 1.0e9 / r.NsPerPoint, "null" ).c_str() );
+        }
+        std::printf( "\n  ]\n}\n" );
+    }
+    return EXIT_SUCCESS;
+}
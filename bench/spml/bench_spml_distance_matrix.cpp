@@ -0,0 +1,143 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_spml_distance_matrix.cpp
+/// \brief      Замер производительности матрицы расстояний (GEOtoRAD_Matrix) в зависимости от числа потоков
+/// \details    Позиции РЛС (строки) и цели (столбцы) в одном районе. Сравниваются: цикл GEOtoRAD, построчный
+///             GEOtoRAD_Batch, GEOtoRAD_Matrix на 1, 2, 4, ... потоках (до числа ядер), матрица набора самого на
+///             себя с учетом симметрии и без, разреженный вывод с порогом дальности.
+///             Запуск: bench_spml_distance_matrix [число строк] [число столбцов]
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+// SPML includes:
+#include <geodesy.h>
+#include <geodesy_batch.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+
+// Время на одну пару точек, [нс]
+static double NsPerPair( TClock::time_point t0, TClock::time_point t1, std::size_t pairs )
+{
+    return std::chrono::duration<double, std::nano>( t1 - t0 ).count() / static_cast<double>( pairs );
+}
+
+static void PrintRow( const char *variant, unsigned int threads, double ns, double nsBase )
+{
+    std::printf( "%-28s %8u %12.2f %10.2f\n", variant, threads, ns, nsBase / ns );
+}
+
+// Случайные точки района 40 x 60 градусов
+static void RegionPoints( std::size_t n, unsigned int seed, std::vector<double> &lat, std::vector<double> &lon )
+{
+    std::mt19937 gen( seed );
+    std::uniform_real_distribution<double> uLat( 30.0, 70.0 );
+    std::uniform_real_distribution<double> uLon( 20.0, 80.0 );
+    lat.resize( n );
+    lon.resize( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        lat[i] = uLat( gen );
+        lon[i] = uLon( gen );
+    }
+}
+
+int main( int argc, char *argv[] )
+{
+    const std::size_t rows = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 1000;
+    const std::size_t cols = ( argc > 2 ) ? std::strtoul( argv[2], nullptr, 10 ) : 10000;
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Units::TRangeUnit ru = SPML::Units::RU_Kilometer;
+    const SPML::Units::TAngleUnit au = SPML::Units::AU_Degree;
+    const unsigned int cores = std::max( 1u, std::thread::hardware_concurrency() );
+
+    std::vector<double> latRow, lonRow, latCol, lonCol;
+    RegionPoints( rows, 1, latRow, lonRow );
+    RegionPoints( cols, 2, latCol, lonCol );
+    std::vector<double> d( rows * cols ), az( rows * cols );
+
+    std::printf( "%zu x %zu matrix, WGS84, %u hardware threads\n", rows, cols, cores );
+    std::printf( "%-28s %8s %12s %10s\n", "variant", "threads", "ns/pair", "speedup" );
+
+    // Цикл скалярной функции и построчный пакет - на части строк
+    const std::size_t rowsPart = std::min<std::size_t>( rows, 50 );
+    TClock::time_point t0 = TClock::now();
+    for( std::size_t i = 0; i < rowsPart; i++ ) {
+        for( std::size_t j = 0; j < cols; j++ ) {
+            SPML::Geodesy::GEOtoRAD( el, ru, au, latRow[i], lonRow[i], latCol[j], lonCol[j], d[i * cols + j],
+                az[i * cols + j] );
+        }
+    }
+    TClock::time_point t1 = TClock::now();
+    const double nsScalar = NsPerPair( t0, t1, rowsPart * cols );
+    PrintRow( "GEOtoRAD loop", 1, nsScalar, nsScalar );
+
+    std::vector<double> latRep( cols ), lonRep( cols );
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < rowsPart; i++ ) {
+        std::fill( latRep.begin(), latRep.end(), latRow[i] );
+        std::fill( lonRep.begin(), lonRep.end(), lonRow[i] );
+        SPML::Geodesy::GEOtoRAD_Batch( el, ru, au, latRep.data(), lonRep.data(), latCol.data(), lonCol.data(), cols,
+            d.data() + i * cols, az.data() + i * cols );
+    }
+    t1 = TClock::now();
+    PrintRow( "GEOtoRAD_Batch per row", 1, NsPerPair( t0, t1, rowsPart * cols ), nsScalar );
+
+    // Масштабирование по числу потоков
+    std::vector<unsigned int> threadCounts;
+    for( unsigned int t = 1; t < cores; t *= 2 ) {
+        threadCounts.push_back( t );
+    }
+    threadCounts.push_back( cores );
+    for( unsigned int threads : threadCounts ) {
+        t0 = TClock::now();
+        SPML::Geodesy::GEOtoRAD_Matrix( el, ru, au, latRow.data(), lonRow.data(), rows, latCol.data(), lonCol.data(),
+            cols, d.data(), az.data(), nullptr, SPML::SIMD::SL_Auto, threads );
+        t1 = TClock::now();
+        PrintRow( "GEOtoRAD_Matrix", threads, NsPerPair( t0, t1, rows * cols ), nsScalar );
+    }
+
+    // Набор сам на себя: симметрия (одни и те же массивы) против копии массивов
+    const std::size_t n = static_cast<std::size_t>( std::sqrt( static_cast<double>( rows * cols ) ) );
+    std::vector<double> latSelf, lonSelf;
+    RegionPoints( n, 3, latSelf, lonSelf );
+    const std::vector<double> latCopy = latSelf, lonCopy = lonSelf;
+    std::vector<double> dSelf( n * n ), azSelf( n * n );
+    std::printf( "\nself %zu x %zu\n", n, n );
+    for( unsigned int threads : threadCounts ) {
+        t0 = TClock::now();
+        SPML::Geodesy::GEOtoRAD_Matrix( el, ru, au, latSelf.data(), lonSelf.data(), n, latCopy.data(), lonCopy.data(),
+            n, dSelf.data(), azSelf.data(), nullptr, SPML::SIMD::SL_Auto, threads );
+        t1 = TClock::now();
+        const double nsFull = NsPerPair( t0, t1, n * n );
+        PrintRow( "full", threads, nsFull, nsScalar );
+        t0 = TClock::now();
+        SPML::Geodesy::GEOtoRAD_Matrix( el, ru, au, latSelf.data(), lonSelf.data(), n, latSelf.data(), lonSelf.data(),
+            n, dSelf.data(), azSelf.data(), nullptr, SPML::SIMD::SL_Auto, threads );
+        t1 = TClock::now();
+        PrintRow( "symmetric", threads, NsPerPair( t0, t1, n * n ), nsScalar );
+    }
+
+    // Разреженный вывод: пары в пределах 500 км
+    std::vector<SPML::Geodesy::RADMatrixEntry> entries;
+    std::printf( "\nsparse, d <= 500 km\n" );
+    for( unsigned int threads : threadCounts ) {
+        t0 = TClock::now();
+        SPML::Geodesy::GEOtoRAD_MatrixSparse( el, ru, au, latRow.data(), lonRow.data(), rows, latCol.data(),
+            lonCol.data(), cols, 500.0, entries, SPML::SIMD::SL_Auto, threads );
+        t1 = TClock::now();
+        PrintRow( "GEOtoRAD_MatrixSparse", threads, NsPerPair( t0, t1, rows * cols ), nsScalar );
+    }
+    std::printf( "%zu of %zu pairs within 500 km\n", entries.size(), rows * cols );
+    return 0;
+}
@@ -0,0 +1,177 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_spml_ellipsoid.cpp
+/// \brief      Замер выигрыша от расчета производных параметров эллипсоида при его создании
+/// \details    Сравнивается расчет производных параметров на каждом вызове (как было ранее в ECEFtoGEO, GEOtoRAD,
+///             ECEF_offset) с чтением рассчитанных при создании эллипсоида значений, а также приводится время
+///             полного вызова функций. Также сравнивается создание эллипсоида на каждом вызове (как было ранее
+///             в Ellipsoids::WGS84()) с обращением к реестру. Запуск: bench_spml_ellipsoid [число вызовов]
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// SPML includes:
+#include <geodesy.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+
+// Время на один вызов, [нс]
+static double NsPerCall( TClock::time_point t0, TClock::time_point t1, std::size_t n )
+{
+    return std::chrono::duration<double, std::nano>( t1 - t0 ).count() / static_cast<double>( n );
+}
+
+// Расчет производных параметров на каждом вызове (как было ранее)
+static void DerivePerCall( const SPML::Geodesy::CEllipsoid &el, SPML::Geodesy::OlsonCoefficients &olson, double &es2,
+    double &e2pow )
+{
+    double a = el.A();
+    double b = el.B();
+    double es = 1.0 - ( ( b * b ) / ( a * a ) );
+    olson.a1 = a * es;
+    olson.a2 = olson.a1 * olson.a1;
+    olson.a3 = olson.a1 * es / 2.0;
+    olson.a4 = 2.5 * olson.a2;
+    olson.a5 = olson.a1 + olson.a3;
+    olson.a6 = 1.0 - es;
+    es2 = ( a * a - b * b ) / ( b * b );
+    e2pow = std::pow( std::sqrt( ( a * a ) - ( b * b ) ) / a, 2 );
+}
+
+int main( int argc, char *argv[] )
+{
+    const std::size_t n = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 1000000;
+
+    // Набор эллипсоидов, чтобы компилятор не вынес расчет из цикла
+    const std::vector<SPML::Geodesy::CEllipsoid> ellipsoids = {
+        SPML::Geodesy::Ellipsoids::WGS84(),
+        SPML::Geodesy::Ellipsoids::PZ90(),
+        SPML::Geodesy::Ellipsoids::Krassowsky1940(),
+        SPML::Geodesy::Ellipsoids::GRS80()
+    };
+    volatile double sink = 0.0;
+
+    // 1. Только производные параметры
+    double acc = 0.0;
+    TClock::time_point t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        SPML::Geodesy::OlsonCoefficients olson;
+        double es2, e2pow;
+        DerivePerCall( ellipsoids[i & 3], olson, es2, e2pow );
+        acc += olson.a1 + olson.a2 + olson.a3 + olson.a4 + olson.a5 + olson.a6 + es2 + e2pow;
+    }
+    const double nsDerive = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+
+    acc = 0.0;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        const SPML::Geodesy::CEllipsoid &el = ellipsoids[i & 3];
+        const SPML::Geodesy::OlsonCoefficients &olson = el.Olson();
+        acc += olson.a1 + olson.a2 + olson.a3 + olson.a4 + olson.a5 + olson.a6 + el.EccentricitySecondSquared() +
+            el.EccentricityFirstSquared();
+    }
+    const double nsCached = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+
+    std::printf( "Derived ellipsoid constants, %zu calls\n", n );
+    std::printf( "%-28s %12s\n", "variant", "ns/call" );
+    std::printf( "%-28s %12.2f\n", "derive per call (old)", nsDerive );
+    std::printf( "%-28s %12.2f\n", "read from CEllipsoid (new)", nsCached );
+    std::printf( "%-28s %12.2f\n", "saved per call", nsDerive - nsCached );
+
+    // 2. Полные вызовы функций, использующих производные параметры
+    const SPML::Units::TRangeUnit ru = SPML::Units::RU_Meter;
+    const SPML::Units::TAngleUnit au = SPML::Units::AU_Degree;
+    acc = 0.0;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        double lat, lon, h;
+        SPML::Geodesy::ECEFtoGEO( ellipsoids[i & 3], ru, au, 2846000.0 + static_cast<double>( i & 1023 ), 2198000.0,
+            5249000.0, lat, lon, h );
+        acc += lat + lon + h;
+    }
+    const double nsECEFtoGEO = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+
+    acc = 0.0;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        double dx, dy, dz;
+        SPML::Geodesy::ECEF_offset( ellipsoids[i & 3], ru, au, 55.0, 37.0, 0.0,
+            55.1 + 1.0e-4 * static_cast<double>( i & 1023 ), 37.2, 100.0, dx, dy, dz );
+        acc += dx + dy + dz;
+    }
+    const double nsOffset = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+
+    acc = 0.0;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        double d, az;
+        SPML::Geodesy::GEOtoRAD( ellipsoids[i & 3], ru, au, 55.0, 37.0, 55.5 + 1.0e-4 * static_cast<double>( i & 1023 ),
+            38.0, d, az );
+        acc += d + az;
+    }
+    const double nsGEOtoRAD = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+
+    // 3. Получение эллипсоида: создание на каждом вызове (как было ранее) и обращение к реестру
+    static const char *keys[4] = { "wgs84", "pz90", "krasovsky1940", "grs80" };
+    acc = 0.0;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        const SPML::Geodesy::CEllipsoid el(
+            SPML::Geodesy::EllipsoidParams( static_cast<SPML::Geodesy::TEllipsoidId>( i & 3 ) ) );
+        acc += el.Olson().a1;
+    }
+    const double nsConstruct = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+
+    acc = 0.0;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        acc += SPML::Geodesy::Ellipsoids::Get( static_cast<SPML::Geodesy::TEllipsoidId>( i & 3 ) ).Olson().a1;
+    }
+    const double nsGet = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+
+    acc = 0.0;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        acc += SPML::Geodesy::FindEllipsoid( keys[i & 3] )->olson.a1;
+    }
+    const double nsFindName = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+
+    acc = 0.0;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        acc += SPML::Geodesy::FindEllipsoid( ( i & 1 ) ? 7030 : 7024 )->olson.a1;
+    }
+    const double nsFindEpsg = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+    (void)sink;
+
+    std::printf( "\nFull calls (cached constants)\n" );
+    std::printf( "%-28s %12s %12s\n", "function", "ns/call", "saved, %" );
+    std::printf( "%-28s %12.2f %12.1f\n", "ECEFtoGEO", nsECEFtoGEO, 100.0 * ( nsDerive - nsCached ) / nsECEFtoGEO );
+    std::printf( "%-28s %12.2f %12.1f\n", "ECEF_offset", nsOffset, 100.0 * ( nsDerive - nsCached ) / nsOffset );
+    std::printf( "%-28s %12.2f %12.1f\n", "GEOtoRAD", nsGEOtoRAD, 100.0 * ( nsDerive - nsCached ) / nsGEOtoRAD );
+
+    std::printf( "\nEllipsoid access\n" );
+    std::printf( "%-28s %12s\n", "variant", "ns/call" );
+    std::printf( "%-28s %12.2f\n", "construct CEllipsoid (old)", nsConstruct );
+    std::printf( "%-28s %12.2f\n", "Ellipsoids::Get( id )", nsGet );
+    std::printf( "%-28s %12.2f\n", "FindEllipsoid( name )", nsFindName );
+    std::printf( "%-28s %12.2f\n", "FindEllipsoid( epsg )", nsFindEpsg );
+    return 0;
+}
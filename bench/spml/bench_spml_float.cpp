@@ -0,0 +1,171 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_spml_float.cpp
+/// \brief      Замер пропускной способности пакетных функций местной системы координат в double и float
+/// \details    Для ENUtoAER_Batch, AERtoENU_Batch, ECEFtoENUV_Batch и ENUtoUVW_Batch на каждом уровне векторизации
+///             выводится время на точку в double и float, их отношение и наибольшая относительная ошибка float
+///             относительно double для тех же входных значений (по дальности или длине смещения).
+///             Запуск: bench_spml_float [размер массива] [повторы]. Массив по умолчанию помещается в кэш L2
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// SPML includes:
+#include <geodesy_batch.h>
+#include <simd.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+
+namespace Geo = SPML::Geodesy;
+
+static const double Lat0 = 55.75;   // Опорная точка для ECEFtoENUV и ENUtoUVW, [град]
+static const double Lon0 = 37.62;
+
+enum TFunction
+{
+    F_ENUtoAER = 0,
+    F_AERtoENU,
+    F_ECEFtoENUV,
+    F_ENUtoUVW
+};
+
+static const char *FunctionNames[] = { "ENUtoAER", "AERtoENU", "ECEFtoENUV", "ENUtoUVW" };
+
+// Время на одну точку, [нс]
+static double NsPerItem( TClock::time_point t0, TClock::time_point t1, std::size_t n, int repeats )
+{
+    return std::chrono::duration<double, std::nano>( t1 - t0 ).count() / ( static_cast<double>( n ) * repeats );
+}
+
+// Вызов пакетной функции (метры и градусы)
+template<class T>
+static void Run( TFunction func, const std::vector<T> *in, std::vector<T> *out, SPML::SIMD::TSimdLevel level )
+{
+    const std::size_t n = in[0].size();
+    switch( func ) {
+        case( F_ENUtoAER ):
+            Geo::ENUtoAER_Batch( SPML::Units::RU_Meter, SPML::Units::AU_Degree, in[0].data(), in[1].data(),
+                in[2].data(), n, out[0].data(), out[1].data(), out[2].data(), level );
+            break;
+        case( F_AERtoENU ):
+            Geo::AERtoENU_Batch( SPML::Units::RU_Meter, SPML::Units::AU_Degree, in[0].data(), in[1].data(),
+                in[2].data(), n, out[0].data(), out[1].data(), out[2].data(), level );
+            break;
+        case( F_ECEFtoENUV ):
+            Geo::ECEFtoENUV_Batch( SPML::Units::RU_Meter, SPML::Units::AU_Degree, in[0].data(), in[1].data(),
+                in[2].data(), n, Lat0, Lon0, out[0].data(), out[1].data(), out[2].data(), level );
+            break;
+        case( F_ENUtoUVW ):
+            Geo::ENUtoUVW_Batch( SPML::Units::RU_Meter, SPML::Units::AU_Degree, in[0].data(), in[1].data(),
+                in[2].data(), n, Lat0, Lon0, out[0].data(), out[1].data(), out[2].data(), level );
+            break;
+    }
+}
+
+// Замер времени на точку, [нс]
+template<class T>
+static double Measure( TFunction func, const std::vector<T> *in, std::vector<T> *out, SPML::SIMD::TSimdLevel level,
+    int repeats, double &sink )
+{
+    const TClock::time_point t0 = TClock::now();
+    for( int r = 0; r < repeats; r++ ) {
+        Run( func, in, out, level );
+        sink += static_cast<double>( out[0][r % out[0].size()] );
+    }
+    return NsPerItem( t0, TClock::now(), in[0].size(), repeats );
+}
+
+// Наибольшая относительная ошибка float относительно double
+static double MaxError( TFunction func, const std::vector<double> *outD, const std::vector<float> *outF )
+{
+    double maxErr = 0.0;
+    for( std::size_t i = 0; i < outD[0].size(); i++ ) {
+        double scale, err;
+        if( func == F_ENUtoAER ) {
+            // Дальность и углы: угловая ошибка переводится в смещение на дальности
+            scale = outD[2][i];
+            double dAz = std::abs( outF[0][i] - outD[0][i] );
+            dAz = std::min( dAz, 360.0 - dAz ) * std::cos( outD[1][i] * SPML::Convert::DgToRdD );
+            const double dElev = std::abs( outF[1][i] - outD[1][i] );
+            err = std::max( std::abs( outF[2][i] - outD[2][i] ),
+                std::max( dAz, dElev ) * SPML::Convert::DgToRdD * scale );
+        } else {
+            scale = std::sqrt( outD[0][i] * outD[0][i] + outD[1][i] * outD[1][i] + outD[2][i] * outD[2][i] );
+            err = 0.0;
+            for( int k = 0; k < 3; k++ ) {
+                err = std::max( err, std::abs( outF[k][i] - outD[k][i] ) );
+            }
+        }
+        if( scale > 1.0 ) {
+            maxErr = std::max( maxErr, err / scale );
+        }
+    }
+    return maxErr;
+}
+
+int main( int argc, char *argv[] )
+{
+    const std::size_t n = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 8192;
+    const int repeats = ( argc > 2 ) ? std::atoi( argv[2] ) : 2000;
+
+    std::vector<SPML::SIMD::TSimdLevel> levels;
+    for( int lv = SPML::SIMD::SL_Scalar; lv <= SPML::SIMD::SL_AVX512; lv++ ) {
+        if( SPML::SIMD::IsSupported( static_cast<SPML::SIMD::TSimdLevel>( lv ) ) ) {
+            levels.push_back( static_cast<SPML::SIMD::TSimdLevel>( lv ) );
+        }
+    }
+
+    // Входы float и те же значения в double: смещения до 500 км, отметки AER до 500 км
+    std::mt19937 gen( 1 );
+    std::uniform_real_distribution<double> offset( -5.0e5, 5.0e5 );
+    std::uniform_real_distribution<double> azimuth( 0.0, 360.0 );
+    std::uniform_real_distribution<double> elevation( -5.0, 85.0 );
+    std::uniform_real_distribution<double> range( 1.0e3, 5.0e5 );
+    std::vector<float> enuF[3], aerF[3], outF[3];
+    std::vector<double> enuD[3], aerD[3], outD[3];
+    for( int k = 0; k < 3; k++ ) {
+        enuF[k].resize( n );
+        aerF[k].resize( n );
+        outF[k].resize( n );
+        outD[k].resize( n );
+    }
+    for( std::size_t i = 0; i < n; i++ ) {
+        for( int k = 0; k < 3; k++ ) {
+            enuF[k][i] = static_cast<float>( offset( gen ) );
+        }
+        aerF[0][i] = static_cast<float>( azimuth( gen ) );
+        aerF[1][i] = static_cast<float>( elevation( gen ) );
+        aerF[2][i] = static_cast<float>( range( gen ) );
+    }
+    for( int k = 0; k < 3; k++ ) {
+        enuD[k].assign( enuF[k].begin(), enuF[k].end() );
+        aerD[k].assign( aerF[k].begin(), aerF[k].end() );
+    }
+
+    std::printf( "Local frame batch, %zu points x %d, ns/point, error - max relative float vs double\n", n, repeats );
+    std::printf( "%-11s %-8s %10s %10s %8s %10s\n", "function", "level", "double", "float", "speedup", "error" );
+
+    double sink = 0.0; // Результат используется, чтобы замеры не были удалены компилятором
+    for( int f = F_ENUtoAER; f <= F_ENUtoUVW; f++ ) {
+        const TFunction func = static_cast<TFunction>( f );
+        const std::vector<float> *inF = ( func == F_AERtoENU ) ? aerF : enuF;
+        const std::vector<double> *inD = ( func == F_AERtoENU ) ? aerD : enuD;
+        for( SPML::SIMD::TSimdLevel level : levels ) {
+            const double nsD = Measure( func, inD, outD, level, repeats, sink );
+            const double nsF = Measure( func, inF, outF, level, repeats, sink );
+            std::printf( "%-11s %-8s %10.2f %10.2f %7.2fx %10.2e\n", FunctionNames[f],
+                SPML::SIMD::Name( level ).c_str(), nsD, nsF, nsD / nsF, MaxError( func, outD, outF ) );
+        }
+    }
+    return ( sink == 0.12345 ) ? 1 : 0;
+}
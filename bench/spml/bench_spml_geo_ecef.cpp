@@ -0,0 +1,116 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_spml_geo_ecef.cpp
+/// \brief      Замер пропускной способности пакетного пересчета географических координат в ECEF (GEOtoECEF_Batch)
+/// \details    Для массивов, не помещающихся в кэш, скорость сравнивается с копированием тех же объемов памяти
+///             (3 массива на чтение, 3 на запись - 48 байт на точку). Запуск: bench_spml_geo_ecef [число точек] [повторы]
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// SPML includes:
+#include <geodesy.h>
+#include <geodesy_batch.h>
+#include <simd.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+typedef SPML::SIMD::AlignedVector<double> TArray;
+
+static const double bytesPerPoint = 6.0 * sizeof( double );
+
+// Время на одну точку, [нс]
+static double NsPerItem( TClock::time_point t0, TClock::time_point t1, std::size_t n, int repeats )
+{
+    return std::chrono::duration<double, std::nano>( t1 - t0 ).count() / ( static_cast<double>( n ) * repeats );
+}
+
+static void PrintRow( const std::string &variant, double ns, double nsCopy )
+{
+    const double gbs = bytesPerPoint / ns; // байт/нс = ГБ/с
+    std::printf( "%-28s %10.2f %10.2f %10.0f%%\n", variant.c_str(), ns, gbs, 100.0 * nsCopy / ns );
+}
+
+int main( int argc, char *argv[] )
+{
+    const std::size_t n = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 4000000;
+    const int repeats = ( argc > 2 ) ? std::atoi( argv[2] ) : 5;
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Units::TRangeUnit ru = SPML::Units::RU_Meter;
+    const SPML::Units::TAngleUnit au = SPML::Units::AU_Degree;
+
+    std::mt19937 gen( 1 );
+    std::uniform_real_distribution<double> lat( -90.0, 90.0 );
+    std::uniform_real_distribution<double> lon( -180.0, 180.0 );
+    std::uniform_real_distribution<double> h( -100.0, 3000.0 );
+    TArray b( n ), l( n ), hh( n ), x( n + 1 ), y( n + 1 ), z( n + 1 );
+    for( std::size_t i = 0; i < n; i++ ) {
+        b[i] = lat( gen );
+        l[i] = lon( gen );
+        hh[i] = h( gen );
+    }
+
+    // Опорное значение: копирование тех же объемов памяти
+    TClock::time_point t0 = TClock::now();
+    for( int r = 0; r < repeats; r++ ) {
+        std::copy( b.begin(), b.end(), x.begin() );
+        std::copy( l.begin(), l.end(), y.begin() );
+        std::copy( hh.begin(), hh.end(), z.begin() );
+    }
+    const double nsCopy = NsPerItem( t0, TClock::now(), n, repeats );
+
+    std::printf( "GEOtoECEF, %zu points x %d, %.0f MB per pass\n", n, repeats, n * bytesPerPoint / 1.0e6 );
+    std::printf( "%-28s %10s %10s %11s\n", "variant", "ns/point", "GB/s", "of copy" );
+    PrintRow( "copy 3 -> 3 arrays", nsCopy, nsCopy );
+
+    t0 = TClock::now();
+    for( int r = 0; r < repeats; r++ ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::GEOtoECEF( el, ru, au, b[i], l[i], hh[i], x[i], y[i], z[i] );
+        }
+    }
+    PrintRow( "GEOtoECEF loop", NsPerItem( t0, TClock::now(), n, repeats ), nsCopy );
+
+    for( int lv = SPML::SIMD::SL_Scalar; lv <= SPML::SIMD::SL_AVX512; lv++ ) {
+        SPML::SIMD::TSimdLevel level = static_cast<SPML::SIMD::TSimdLevel>( lv );
+        if( !SPML::SIMD::IsSupported( level ) ) {
+            continue;
+        }
+        // Невыровненные выходные массивы - обычная запись через кэш
+        t0 = TClock::now();
+        for( int r = 0; r < repeats; r++ ) {
+            SPML::Geodesy::GEOtoECEF_Batch( el, ru, au, b.data(), l.data(), hh.data(), n,
+                x.data() + 1, y.data() + 1, z.data() + 1, level );
+        }
+        PrintRow( "batch " + SPML::SIMD::Name( level ) + ", unaligned", NsPerItem( t0, TClock::now(), n, repeats ), nsCopy );
+
+        // Выровненные выходные массивы - потоковая запись
+        t0 = TClock::now();
+        for( int r = 0; r < repeats; r++ ) {
+            SPML::Geodesy::GEOtoECEF_Batch( el, ru, au, b.data(), l.data(), hh.data(), n,
+                x.data(), y.data(), z.data(), level );
+        }
+        PrintRow( "batch " + SPML::SIMD::Name( level ) + ", aligned", NsPerItem( t0, TClock::now(), n, repeats ), nsCopy );
+    }
+
+    // Многопоточный вариант: предел - пропускная способность памяти
+    const unsigned int threads = std::max( 1u, std::thread::hardware_concurrency() );
+    t0 = TClock::now();
+    for( int r = 0; r < repeats; r++ ) {
+        SPML::Geodesy::GEOtoECEF_Batch( el, ru, au, b.data(), l.data(), hh.data(), n, x.data(), y.data(), z.data(),
+            SPML::SIMD::SL_Auto, threads );
+    }
+    PrintRow( "batch auto, aligned, " + std::to_string( threads ) + " thr", NsPerItem( t0, TClock::now(), n, repeats ),
+        nsCopy );
+    return 0;
+}
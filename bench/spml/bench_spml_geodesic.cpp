@@ -0,0 +1,187 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_spml_geodesic.cpp
+/// \brief      Сравнение метода Карни (CGeodesic) с формулами Винсента по времени и его распределению
+/// \details    Обратная задача на случайных парах точек по всему земному шару и на почти антиподальных парах,
+///             прямая задача на случайных дальностях и азимутах, сгущение маршрута (RADtoGEO в цикле против
+///             CGeodesicLine). Время каждого вызова замеряется отдельно:
+///             кроме среднего выводятся медиана, 99-й и 99.9-й процентили (хвост задержек).
+///             Запуск: bench_spml_geodesic [число пар]
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+// SPML includes:
+#include <geodesic.h>
+#include <geodesic_line.h>
+#include <geodesy.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+
+struct TPairs
+{
+    std::vector<double> lat1, lon1, lat2, lon2;
+};
+
+// Случайные пары по всему земному шару
+static TPairs GlobalPairs( std::size_t n )
+{
+    std::mt19937 gen( 1 );
+    std::uniform_real_distribution<double> lat( -90.0, 90.0 );
+    std::uniform_real_distribution<double> lon( -180.0, 180.0 );
+    TPairs p;
+    for( std::size_t i = 0; i < n; i++ ) {
+        p.lat1.push_back( lat( gen ) );
+        p.lon1.push_back( lon( gen ) );
+        p.lat2.push_back( lat( gen ) );
+        p.lon2.push_back( lon( gen ) );
+    }
+    return p;
+}
+
+// Почти антиподальные пары: конечная точка в пределах 1 град от антипода начальной
+static TPairs AntipodalPairs( std::size_t n )
+{
+    std::mt19937 gen( 2 );
+    std::uniform_real_distribution<double> lat( -60.0, 60.0 );
+    std::uniform_real_distribution<double> dev( -1.0, 1.0 );
+    TPairs p;
+    for( std::size_t i = 0; i < n; i++ ) {
+        const double lat1 = lat( gen );
+        p.lat1.push_back( lat1 );
+        p.lon1.push_back( 0.0 );
+        p.lat2.push_back( -lat1 + dev( gen ) );
+        p.lon2.push_back( 180.0 + dev( gen ) );
+    }
+    return p;
+}
+
+// Среднее, медиана, 99-й и 99.9-й процентили времени вызова, [нс] (максимум определяется вытеснением потока ОС)
+static void PrintRow( const char *variant, std::vector<double> &ns )
+{
+    double sum = 0.0;
+    for( double t : ns ) {
+        sum += t;
+    }
+    std::sort( ns.begin(), ns.end() );
+    std::printf( "%-34s %10.1f %10.1f %10.1f %10.1f\n", variant, sum / static_cast<double>( ns.size() ),
+        ns[ns.size() / 2], ns[( ns.size() * 99 ) / 100], ns[( ns.size() * 999 ) / 1000] );
+}
+
+// Замер каждого вызова func( i )
+static std::vector<double> TimeCalls( std::size_t n, const std::function<void( std::size_t )> &func )
+{
+    std::vector<double> ns( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        const TClock::time_point t0 = TClock::now();
+        func( i );
+        ns[i] = std::chrono::duration<double, std::nano>( TClock::now() - t0 ).count();
+    }
+    return ns;
+}
+
+int main( int argc, char *argv[] )
+{
+    const std::size_t n = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 200000;
+    const SPML::Units::TRangeUnit ru = SPML::Units::TRangeUnit::RU_Meter;
+    const SPML::Units::TAngleUnit au = SPML::Units::TAngleUnit::AU_Degree;
+    const SPML::Geodesy::CEllipsoid &el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Geodesy::CGeodesic geodesic( el, ru, au );
+    volatile double sink = 0.0;
+
+    std::printf( "%zu pairs, WGS84, ns per call\n", n );
+    std::printf( "%-34s %10s %10s %10s %10s\n", "variant", "mean", "p50", "p99", "p99.9" );
+
+    const TPairs sets[] = { GlobalPairs( n ), AntipodalPairs( n ) };
+    const char *names[] = { "global", "near-antipodal" };
+    std::vector<double> dist( n ), azim( n );
+    for( int k = 0; k < 2; k++ ) {
+        const TPairs &p = sets[k];
+        std::vector<double> dV( n ), dK( n );
+        int maxIter = 0;
+        double sumIter = 0.0;
+
+        std::vector<double> ns = TimeCalls( n, [&]( std::size_t i ) {
+            double az;
+            SPML::Geodesy::GEOtoRAD( el, ru, au, p.lat1[i], p.lon1[i], p.lat2[i], p.lon2[i], dV[i], az );
+            sink = sink + az;
+        } );
+        std::printf( "%s:\n", names[k] );
+        PrintRow( "  inverse, Vincenty", ns );
+
+        ns = TimeCalls( n, [&]( std::size_t i ) {
+            const int iterations = geodesic.Inverse( p.lat1[i], p.lon1[i], p.lat2[i], p.lon2[i], dK[i], azim[i] );
+            maxIter = std::max( maxIter, iterations );
+            sumIter += iterations;
+        } );
+        PrintRow( "  inverse, Karney", ns );
+
+        // Расхождение дальностей: формулы Винсента без сходимости дают неверный результат
+        std::size_t bad = 0;
+        for( std::size_t i = 0; i < n; i++ ) {
+            if( !( std::fabs( dV[i] - dK[i] ) < 1.0e-3 ) ) {
+                bad++;
+            }
+        }
+        std::printf( "  Karney iterations: mean %.2f, max %d; Vincenty off by > 1 mm: %zu (%.2f%%)\n",
+            sumIter / static_cast<double>( n ), maxIter, bad, 100.0 * static_cast<double>( bad ) / n );
+        if( k == 0 ) {
+            dist = dK;
+        }
+    }
+
+    // Прямая задача по дальностям и азимутам глобального набора
+    const TPairs &p = sets[0];
+    std::vector<double> ns = TimeCalls( n, [&]( std::size_t i ) {
+        double lat, lon, azEnd;
+        SPML::Geodesy::RADtoGEO( el, ru, au, p.lat1[i], p.lon1[i], dist[i], azim[i], lat, lon, azEnd );
+        sink = sink + lat;
+    } );
+    std::printf( "global, direct:\n" );
+    PrintRow( "  direct, Vincenty", ns );
+    ns = TimeCalls( n, [&]( std::size_t i ) {
+        double lat, lon, azEnd;
+        geodesic.Direct( p.lat1[i], p.lon1[i], dist[i], azim[i], lat, lon, azEnd );
+        sink = sink + lat;
+    } );
+    PrintRow( "  direct, Karney", ns );
+
+    // Сгущение маршрута: 1000 точек на линию, время на одну точку
+    const std::size_t lines = std::max<std::size_t>( n / 1000, 1 );
+    const std::size_t waypoints = 1000;
+    std::vector<double> lat( waypoints ), lon( waypoints );
+    ns = TimeCalls( lines, [&]( std::size_t i ) {
+        const double step = dist[i] / static_cast<double>( waypoints - 1 );
+        for( std::size_t j = 0; j < waypoints; j++ ) {
+            SPML::Geodesy::RADtoGEO( el, ru, au, p.lat1[i], p.lon1[i], step * static_cast<double>( j ), azim[i],
+                lat[j], lon[j] );
+        }
+        sink = sink + lat[waypoints / 2];
+    } );
+    for( double &t : ns ) {
+        t /= static_cast<double>( waypoints );
+    }
+    std::printf( "densify, %zu waypoints per line:\n", waypoints );
+    PrintRow( "  RADtoGEO loop", ns );
+    ns = TimeCalls( lines, [&]( std::size_t i ) {
+        const SPML::Geodesy::CGeodesicLine line( el, ru, au, p.lat1[i], p.lon1[i], azim[i], dist[i] );
+        line.Waypoints( waypoints, lat.data(), lon.data() );
+        sink = sink + lat[waypoints / 2];
+    } );
+    for( double &t : ns ) {
+        t /= static_cast<double>( waypoints );
+    }
+    PrintRow( "  CGeodesicLine::Waypoints", ns );
+    return 0;
+}
@@ -0,0 +1,196 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_spml_geodesy_batch.cpp
+/// \brief      Замер производительности пакетных геодезических функций библиотеки spml
+/// \details    Сравнивается цикл вызовов скалярной функции с пакетной функцией на каждом доступном уровне векторизации.
+///             Запуск: bench_spml_geodesy_batch [число точек] [число повторов]
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// SPML includes:
+#include <geodesy.h>
+#include <geodesy_batch.h>
+#include <simd.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+
+// Время на одну точку, [нс]
+static double NsPerItem( TClock::time_point t0, TClock::time_point t1, std::size_t n, int repeats )
+{
+    return std::chrono::duration<double, std::nano>( t1 - t0 ).count() / ( static_cast<double>( n ) * repeats );
+}
+
+static void PrintHeader( const char *title, std::size_t n, int repeats )
+{
+    std::printf( "\n%s, %zu points x %d\n", title, n, repeats );
+    std::printf( "%-16s %6s %12s %10s\n", "variant", "width", "ns/point", "speedup" );
+}
+
+static void PrintRow( const std::string &variant, int width, double ns, double nsScalar )
+{
+    std::printf( "%-16s %6d %12.2f %10.2f\n", variant.c_str(), width, ns, nsScalar / ns );
+}
+
+// Обратная задача: случайные пары точек в пределах 500 км (типичная зона обзора)
+static void BenchGEOtoRAD( std::size_t n, int repeats )
+{
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Units::TRangeUnit ru = SPML::Units::RU_Kilometer;
+    const SPML::Units::TAngleUnit au = SPML::Units::AU_Degree;
+
+    std::mt19937 gen( 1 );
+    std::uniform_real_distribution<double> lat( -80.0, 80.0 );
+    std::uniform_real_distribution<double> lon( -180.0, 180.0 );
+    std::uniform_real_distribution<double> delta( -4.5, 4.5 );
+    std::vector<double> latStart( n ), lonStart( n ), latEnd( n ), lonEnd( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        latStart[i] = lat( gen );
+        lonStart[i] = lon( gen );
+        latEnd[i] = latStart[i] + delta( gen );
+        lonEnd[i] = lonStart[i] + delta( gen );
+    }
+    std::vector<double> d( n ), az( n ), azEnd( n );
+
+    TClock::time_point t0 = TClock::now();
+    for( int r = 0; r < repeats; r++ ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::GEOtoRAD( el, ru, au, latStart[i], lonStart[i], latEnd[i], lonEnd[i], d[i], az[i], azEnd[i] );
+        }
+    }
+    const double nsScalar = NsPerItem( t0, TClock::now(), n, repeats );
+    PrintHeader( "GEOtoRAD", n, repeats );
+    PrintRow( "GEOtoRAD loop", 1, nsScalar, nsScalar );
+
+    for( int l = SPML::SIMD::SL_Scalar; l <= SPML::SIMD::SL_AVX512; l++ ) {
+        SPML::SIMD::TSimdLevel level = static_cast<SPML::SIMD::TSimdLevel>( l );
+        if( !SPML::SIMD::IsSupported( level ) ) {
+            continue;
+        }
+        t0 = TClock::now();
+        for( int r = 0; r < repeats; r++ ) {
+            SPML::Geodesy::GEOtoRAD_Batch( el, ru, au, latStart.data(), lonStart.data(), latEnd.data(), lonEnd.data(), n,
+                d.data(), az.data(), azEnd.data(), level );
+        }
+        PrintRow( "batch " + SPML::SIMD::Name( level ), SPML::SIMD::Width( level ),
+            NsPerItem( t0, TClock::now(), n, repeats ), nsScalar );
+    }
+}
+
+// Прямая задача из одной точки: кольца дальности через 0.1 градуса азимута
+static void BenchRADtoGEOFan( std::size_t n, int repeats )
+{
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Units::TRangeUnit ru = SPML::Units::RU_Kilometer;
+    const SPML::Units::TAngleUnit au = SPML::Units::AU_Degree;
+    const double latStart = 55.75;
+    const double lonStart = 37.62;
+
+    std::vector<double> d( n ), az( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        az[i] = 0.1 * static_cast<double>( i % 3600 );
+        d[i] = 10.0 * static_cast<double>( 1 + i / 3600 % 50 );
+    }
+    std::vector<double> latEnd( n ), lonEnd( n ), azEnd( n );
+
+    TClock::time_point t0 = TClock::now();
+    for( int r = 0; r < repeats; r++ ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::RADtoGEO( el, ru, au, latStart, lonStart, d[i], az[i], latEnd[i], lonEnd[i], azEnd[i] );
+        }
+    }
+    const double nsScalar = NsPerItem( t0, TClock::now(), n, repeats );
+    PrintHeader( "RADtoGEO (one origin)", n, repeats );
+    PrintRow( "RADtoGEO loop", 1, nsScalar, nsScalar );
+
+    for( int l = SPML::SIMD::SL_Scalar; l <= SPML::SIMD::SL_AVX512; l++ ) {
+        SPML::SIMD::TSimdLevel level = static_cast<SPML::SIMD::TSimdLevel>( l );
+        if( !SPML::SIMD::IsSupported( level ) ) {
+            continue;
+        }
+        t0 = TClock::now();
+        for( int r = 0; r < repeats; r++ ) {
+            SPML::Geodesy::RADtoGEO_Fan( el, ru, au, latStart, lonStart, d.data(), az.data(), n,
+                latEnd.data(), lonEnd.data(), azEnd.data(), level );
+        }
+        PrintRow( "fan " + SPML::SIMD::Name( level ), SPML::SIMD::Width( level ),
+            NsPerItem( t0, TClock::now(), n, repeats ), nsScalar );
+    }
+    t0 = TClock::now();
+    for( int r = 0; r < repeats; r++ ) {
+        SPML::Geodesy::RADtoGEO_Fan( el, ru, au, latStart, lonStart, d.data(), az.data(), n,
+            latEnd.data(), lonEnd.data(), azEnd.data(), SPML::SIMD::SL_Auto, 0 );
+    }
+    PrintRow( "fan auto, " + std::to_string( std::thread::hardware_concurrency() ) + " thr",
+        SPML::SIMD::Width( SPML::SIMD::SL_Auto ), NsPerItem( t0, TClock::now(), n, repeats ), nsScalar );
+}
+
+// Пересчет ECEF в географические координаты: трек-файл, точки от поверхности до 20 км
+static void BenchECEFtoGEO( std::size_t n, int repeats )
+{
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Units::TRangeUnit ru = SPML::Units::RU_Meter;
+    const SPML::Units::TAngleUnit au = SPML::Units::AU_Degree;
+
+    std::mt19937 gen( 1 );
+    std::uniform_real_distribution<double> lat( -90.0, 90.0 );
+    std::uniform_real_distribution<double> lon( -180.0, 180.0 );
+    std::uniform_real_distribution<double> h( 0.0, 20000.0 );
+    std::vector<double> x( n ), y( n ), z( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        SPML::Geodesy::GEOtoECEF( el, ru, au, lat( gen ), lon( gen ), h( gen ), x[i], y[i], z[i] );
+    }
+    std::vector<double> latOut( n ), lonOut( n ), hOut( n );
+
+    TClock::time_point t0 = TClock::now();
+    for( int r = 0; r < repeats; r++ ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::ECEFtoGEO( el, ru, au, x[i], y[i], z[i], latOut[i], lonOut[i], hOut[i] );
+        }
+    }
+    const double nsScalar = NsPerItem( t0, TClock::now(), n, repeats );
+    PrintHeader( "ECEFtoGEO", n, repeats );
+    PrintRow( "ECEFtoGEO loop", 1, nsScalar, nsScalar );
+
+    for( int l = SPML::SIMD::SL_Scalar; l <= SPML::SIMD::SL_AVX512; l++ ) {
+        SPML::SIMD::TSimdLevel level = static_cast<SPML::SIMD::TSimdLevel>( l );
+        if( !SPML::SIMD::IsSupported( level ) ) {
+            continue;
+        }
+        t0 = TClock::now();
+        for( int r = 0; r < repeats; r++ ) {
+            SPML::Geodesy::ECEFtoGEO_Batch( el, ru, au, x.data(), y.data(), z.data(), n, latOut.data(), lonOut.data(), hOut.data(),
+                level );
+        }
+        PrintRow( "batch " + SPML::SIMD::Name( level ), SPML::SIMD::Width( level ),
+            NsPerItem( t0, TClock::now(), n, repeats ), nsScalar );
+    }
+    t0 = TClock::now();
+    for( int r = 0; r < repeats; r++ ) {
+        SPML::Geodesy::ECEFtoGEO_Batch( el, ru, au, x.data(), y.data(), z.data(), n, latOut.data(), lonOut.data(), hOut.data(),
+            SPML::SIMD::SL_Auto, 0 );
+    }
+    PrintRow( "batch auto, " + std::to_string( std::thread::hardware_concurrency() ) + " thr",
+        SPML::SIMD::Width( SPML::SIMD::SL_Auto ), NsPerItem( t0, TClock::now(), n, repeats ), nsScalar );
+}
+
+int main( int argc, char *argv[] )
+{
+    const std::size_t n = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 100000;
+    const int repeats = ( argc > 2 ) ? std::atoi( argv[2] ) : 5;
+
+    BenchGEOtoRAD( n, repeats );
+    BenchRADtoGEOFan( n, repeats );
+    BenchECEFtoGEO( n, repeats );
+    return 0;
+}
@@ -0,0 +1,107 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_spml_geofence.cpp
+/// \brief      Замер производительности проверки "расстояние не больше R" (GEOWithinRange) в сравнении с GEOtoRAD
+/// \details    Пары точек района 40 x 60 градусов, несколько порогов дальности. Для каждого порога: цикл GEOtoRAD
+///             со сравнением, цикл GEOWithinRange, GEOtoRAD_Batch со сравнением, GEOWithinRange_Batch и доля пар,
+///             решенных по границам.
+///             Запуск: bench_spml_geofence [число пар]
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+// SPML includes:
+#include <geodesy.h>
+#include <geodesy_batch.h>
+#include <geofence.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+
+// Время на одну пару точек, [нс]
+static double NsPerPair( TClock::time_point t0, TClock::time_point t1, std::size_t pairs )
+{
+    return std::chrono::duration<double, std::nano>( t1 - t0 ).count() / static_cast<double>( pairs );
+}
+
+static void PrintRow( const char *variant, double ns, double nsBase, std::size_t inside, double resolved )
+{
+    std::printf( "%-24s %10.2f %10.2f %10zu %10.3f\n", variant, ns, nsBase / ns, inside, resolved );
+}
+
+int main( int argc, char *argv[] )
+{
+    const std::size_t n = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 1000000;
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Units::TRangeUnit ru = SPML::Units::RU_Kilometer;
+    const SPML::Units::TAngleUnit au = SPML::Units::AU_Degree;
+
+    std::mt19937 gen( 1 );
+    std::uniform_real_distribution<double> uLat( 30.0, 70.0 );
+    std::uniform_real_distribution<double> uLon( 20.0, 80.0 );
+    std::vector<double> lat1( n ), lon1( n ), lat2( n ), lon2( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        lat1[i] = uLat( gen );
+        lon1[i] = uLon( gen );
+        lat2[i] = uLat( gen );
+        lon2[i] = uLon( gen );
+    }
+    std::vector<double> d( n ), az( n );
+    std::unique_ptr<bool[]> within( new bool[n] );
+
+    std::printf( "%zu pairs, WGS84\n", n );
+    for( double range : { 100.0, 1000.0, 3000.0 } ) {
+        std::printf( "\nrange %.0f km\n%-24s %10s %10s %10s %10s\n", range, "variant", "ns/pair", "speedup", "inside",
+            "bounds" );
+        std::size_t inside = 0;
+        TClock::time_point t0 = TClock::now();
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::GEOtoRAD( el, ru, au, lat1[i], lon1[i], lat2[i], lon2[i], d[i], az[i] );
+            inside += ( d[i] <= range ) ? 1 : 0;
+        }
+        TClock::time_point t1 = TClock::now();
+        const double nsScalar = NsPerPair( t0, t1, n );
+        PrintRow( "GEOtoRAD loop", nsScalar, nsScalar, inside, 0.0 );
+
+        SPML::Geodesy::ResetWithinRangeStats();
+        inside = 0;
+        t0 = TClock::now();
+        for( std::size_t i = 0; i < n; i++ ) {
+            inside += SPML::Geodesy::GEOWithinRange( el, ru, au, lat1[i], lon1[i], lat2[i], lon2[i], range ) ? 1 : 0;
+        }
+        t1 = TClock::now();
+        PrintRow( "GEOWithinRange loop", NsPerPair( t0, t1, n ), nsScalar, inside,
+            SPML::Geodesy::GetWithinRangeStats().ResolvedFraction() );
+
+        inside = 0;
+        t0 = TClock::now();
+        SPML::Geodesy::GEOtoRAD_Batch( el, ru, au, lat1.data(), lon1.data(), lat2.data(), lon2.data(), n, d.data(),
+            az.data() );
+        for( std::size_t i = 0; i < n; i++ ) {
+            inside += ( d[i] <= range ) ? 1 : 0;
+        }
+        t1 = TClock::now();
+        PrintRow( "GEOtoRAD_Batch", NsPerPair( t0, t1, n ), nsScalar, inside, 0.0 );
+
+        SPML::Geodesy::ResetWithinRangeStats();
+        inside = 0;
+        t0 = TClock::now();
+        SPML::Geodesy::GEOWithinRange_Batch( el, ru, au, lat1.data(), lon1.data(), lat2.data(), lon2.data(), n, range,
+            within.get() );
+        for( std::size_t i = 0; i < n; i++ ) {
+            inside += within[i] ? 1 : 0;
+        }
+        t1 = TClock::now();
+        PrintRow( "GEOWithinRange_Batch", NsPerPair( t0, t1, n ), nsScalar, inside,
+            SPML::Geodesy::GetWithinRangeStats().ResolvedFraction() );
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_spml_local_frame.cpp
+/// \brief      Замер выигрыша от местной системы координат CLocalFrame по сравнению со свободными функциями
+/// \details    Для одной опорной точки обрабатывается массив точек: свободные функции пересчитывают опорную точку
+///             и матрицу поворота на каждом вызове, CLocalFrame - один раз. Запуск: bench_spml_local_frame [число точек]
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// SPML includes:
+#include <geodesy.h>
+#include <local_frame.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+
+// Время на одну точку, [нс]
+static double NsPerPoint( TClock::time_point t0, TClock::time_point t1, std::size_t n )
+{
+    return std::chrono::duration<double, std::nano>( t1 - t0 ).count() / static_cast<double>( n );
+}
+
+static double Sum( const std::vector<double> &v )
+{
+    double s = 0.0;
+    for( double x : v ) {
+        s += x;
+    }
+    return s;
+}
+
+int main( int argc, char *argv[] )
+{
+    const std::size_t n = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 1000000;
+    const SPML::Units::TRangeUnit ru = SPML::Units::TRangeUnit::RU_Kilometer;
+    const SPML::Units::TAngleUnit au = SPML::Units::TAngleUnit::AU_Degree;
+    const SPML::Geodesy::CEllipsoid &el = SPML::Geodesy::Ellipsoids::WGS84();
+    const double lat0 = 55.75, lon0 = 37.62, h0 = 0.15;
+    volatile double sink = 0.0;
+
+    std::vector<double> lat( n ), lon( n ), h( n ), x( n ), y( n ), z( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        lat[i] = lat0 - 2.0 + 4.0 * static_cast<double>( i % 1009 ) / 1009.0;
+        lon[i] = lon0 - 3.0 + 6.0 * static_cast<double>( i % 997 ) / 997.0;
+        h[i] = 0.001 * static_cast<double>( i % 10007 );
+        SPML::Geodesy::GEOtoECEF( el, ru, au, lat[i], lon[i], h[i], x[i], y[i], z[i] );
+    }
+    std::vector<double> o1( n ), o2( n ), o3( n );
+
+    // Конструирование (вычисление опорной точки и матрицы поворота) входит в замер
+    TClock::time_point t0;
+    double ns[3][3];
+
+    // 1. ECEF -> ENU
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        SPML::Geodesy::ECEFtoENU( el, ru, au, x[i], y[i], z[i], lat0, lon0, h0, o1[i], o2[i], o3[i] );
+    }
+    ns[0][0] = NsPerPoint( t0, TClock::now(), n );
+    sink = Sum( o1 );
+
+    t0 = TClock::now();
+    {
+        const SPML::Geodesy::CLocalFrame frame( el, ru, au, lat0, lon0, h0 );
+        for( std::size_t i = 0; i < n; i++ ) {
+            frame.ECEFtoENU( x[i], y[i], z[i], o1[i], o2[i], o3[i] );
+        }
+    }
+    ns[0][1] = NsPerPoint( t0, TClock::now(), n );
+    sink = Sum( o1 );
+
+    t0 = TClock::now();
+    {
+        const SPML::Geodesy::CLocalFrame frame( el, ru, au, lat0, lon0, h0 );
+        frame.ECEFtoENU( x.data(), y.data(), z.data(), n, o1.data(), o2.data(), o3.data() );
+    }
+    ns[0][2] = NsPerPoint( t0, TClock::now(), n );
+    sink = Sum( o1 );
+
+    // 2. ECEF -> AER
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        SPML::Geodesy::ECEFtoAER( el, ru, au, x[i], y[i], z[i], lat0, lon0, h0, o1[i], o2[i], o3[i] );
+    }
+    ns[1][0] = NsPerPoint( t0, TClock::now(), n );
+    sink = Sum( o1 );
+
+    t0 = TClock::now();
+    {
+        const SPML::Geodesy::CLocalFrame frame( el, ru, au, lat0, lon0, h0 );
+        for( std::size_t i = 0; i < n; i++ ) {
+            frame.ECEFtoAER( x[i], y[i], z[i], o1[i], o2[i], o3[i] );
+        }
+    }
+    ns[1][1] = NsPerPoint( t0, TClock::now(), n );
+    sink = Sum( o1 );
+
+    t0 = TClock::now();
+    {
+        const SPML::Geodesy::CLocalFrame frame( el, ru, au, lat0, lon0, h0 );
+        frame.ECEFtoAER( x.data(), y.data(), z.data(), n, o1.data(), o2.data(), o3.data() );
+    }
+    ns[1][2] = NsPerPoint( t0, TClock::now(), n );
+    sink = Sum( o1 );
+
+    // 3. GEO -> ENU
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        SPML::Geodesy::GEOtoENU( el, ru, au, lat[i], lon[i], h[i], lat0, lon0, h0, o1[i], o2[i], o3[i] );
+    }
+    ns[2][0] = NsPerPoint( t0, TClock::now(), n );
+    sink = Sum( o1 );
+
+    t0 = TClock::now();
+    {
+        const SPML::Geodesy::CLocalFrame frame( el, ru, au, lat0, lon0, h0 );
+        for( std::size_t i = 0; i < n; i++ ) {
+            frame.GEOtoENU( lat[i], lon[i], h[i], o1[i], o2[i], o3[i] );
+        }
+    }
+    ns[2][1] = NsPerPoint( t0, TClock::now(), n );
+    sink = Sum( o1 );
+
+    t0 = TClock::now();
+    {
+        const SPML::Geodesy::CLocalFrame frame( el, ru, au, lat0, lon0, h0 );
+        frame.GEOtoENU( lat.data(), lon.data(), h.data(), n, o1.data(), o2.data(), o3.data() );
+    }
+    ns[2][2] = NsPerPoint( t0, TClock::now(), n );
+    sink = Sum( o1 );
+    (void)sink;
+
+    const char *names[3] = { "ECEF -> ENU", "ECEF -> AER", "GEO -> ENU" };
+    std::printf( "Local frame (km, deg), %zu points per anchor\n", n );
+    std::printf( "%-16s %16s %16s %16s %10s\n", "transform", "functions, ns", "frame, ns", "frame batch, ns",
+        "speedup" );
+    for( int k = 0; k < 3; k++ ) {
+        std::printf( "%-16s %16.2f %16.2f %16.2f %9.1fx\n", names[k], ns[k][0], ns[k][1], ns[k][2],
+            ns[k][0] / ns[k][2] );
+    }
+    return 0;
+}
@@ -0,0 +1,164 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_spml_scaling.cpp
+/// \brief      Замер масштабируемости пакетных функций по числу потоков пула (см. execution.h)
+/// \details    Сильная масштабируемость: GEOtoRAD_Batch на пакете постоянного размера при 1, 2, 4, ... потоках (до
+///             числа ядер) с политиками EM_Parallel и EM_ParallelSimd; время, ускорение и эффективность относительно
+///             одного потока. Слабая масштабируемость: размер пакета пропорционален числу потоков, эффективность -
+///             отношение времени на одном потоке к времени на N потоках. Накладные расходы малых пакетов: пул
+///             потоков библиотеки в сравнении с созданием std::thread на каждый вызов.
+///             Запуск: bench_spml_scaling [размер пакета] [размер пакета на поток] [закрепить потоки 0/1]
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+// SPML includes:
+#include <execution.h>
+#include <geodesy_batch.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+
+// Наборы пар точек в одном районе
+struct TPairs
+{
+    std::vector<double> lat1, lon1, lat2, lon2, d, az;
+
+    explicit TPairs( std::size_t n )
+    {
+        std::mt19937 gen( 15 );
+        std::uniform_real_distribution<double> lat( 30.0, 70.0 );
+        std::uniform_real_distribution<double> lon( 20.0, 80.0 );
+        lat1.resize( n );
+        lon1.resize( n );
+        lat2.resize( n );
+        lon2.resize( n );
+        d.resize( n );
+        az.resize( n );
+        for( std::size_t i = 0; i < n; i++ ) {
+            lat1[i] = lat( gen );
+            lon1[i] = lon( gen );
+            lat2[i] = lat( gen );
+            lon2[i] = lon( gen );
+        }
+    }
+};
+
+// Время пакета GEOtoRAD_Batch (наименьшее из repeats запусков), [мс]
+static double BatchMs( TPairs &pairs, std::size_t n, const SPML::Execution::Policy &policy, int repeats )
+{
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    double best = 0.0;
+    for( int r = 0; r < repeats; r++ ) {
+        const TClock::time_point t0 = TClock::now();
+        SPML::Geodesy::GEOtoRAD_Batch( el, SPML::Units::RU_Kilometer, SPML::Units::AU_Degree, pairs.lat1.data(),
+            pairs.lon1.data(), pairs.lat2.data(), pairs.lon2.data(), n, pairs.d.data(), pairs.az.data(), nullptr,
+            policy );
+        const double ms = std::chrono::duration<double, std::milli>( TClock::now() - t0 ).count();
+        best = ( r == 0 ) ? ms : std::min( best, ms );
+    }
+    return best;
+}
+
+static const char *ModeName( SPML::Execution::TMode mode )
+{
+    return ( mode == SPML::Execution::EM_Parallel ) ? "parallel" : "parallel+simd";
+}
+
+int main( int argc, char *argv[] )
+{
+    const std::size_t strongN = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 2000000;
+    const std::size_t weakN = ( argc > 2 ) ? std::strtoul( argv[2], nullptr, 10 ) : 500000;
+    const bool pin = ( argc > 3 ) && ( std::atoi( argv[3] ) != 0 );
+    const unsigned int cores = std::max( 1u, std::thread::hardware_concurrency() );
+    std::vector<unsigned int> threadCounts;
+    for( unsigned int t = 1; t < cores; t *= 2 ) {
+        threadCounts.push_back( t );
+    }
+    threadCounts.push_back( cores );
+
+    SPML::Execution::SetPoolThreads( cores, pin );
+    std::printf( "GEOtoRAD_Batch, WGS84, %u hardware threads, pool %u threads%s\n", cores,
+        SPML::Execution::PoolThreads(), SPML::Execution::PoolPinned() ? " (pinned)" : "" );
+    const SPML::Execution::TMode modes[] = { SPML::Execution::EM_Parallel, SPML::Execution::EM_ParallelSimd };
+
+    // Сильная масштабируемость
+    TPairs strong( strongN );
+    std::printf( "\nstrong scaling, %zu pairs\n", strongN );
+    std::printf( "%-16s %8s %12s %10s %12s\n", "policy", "threads", "ms", "speedup", "efficiency" );
+    for( SPML::Execution::TMode mode : modes ) {
+        double base = 0.0;
+        for( unsigned int threads : threadCounts ) {
+            const double ms = BatchMs( strong, strongN, SPML::Execution::Policy( mode, threads ), 3 );
+            base = ( threads == 1 ) ? ms : base;
+            std::printf( "%-16s %8u %12.2f %10.2f %11.0f%%\n", ModeName( mode ), threads, ms, base / ms,
+                100.0 * base / ms / threads );
+        }
+    }
+
+    // Слабая масштабируемость
+    TPairs weak( weakN * cores );
+    std::printf( "\nweak scaling, %zu pairs per thread\n", weakN );
+    std::printf( "%-16s %8s %12s %12s\n", "policy", "threads", "ms", "efficiency" );
+    for( SPML::Execution::TMode mode : modes ) {
+        double base = 0.0;
+        for( unsigned int threads : threadCounts ) {
+            const double ms = BatchMs( weak, weakN * threads, SPML::Execution::Policy( mode, threads ), 3 );
+            base = ( threads == 1 ) ? ms : base;
+            std::printf( "%-16s %8u %12.2f %11.0f%%\n", ModeName( mode ), threads, ms, 100.0 * base / ms );
+        }
+    }
+
+    // Малые пакеты: пул против создания потоков на каждый вызов
+    const std::size_t smallN = 256;
+    const int calls = 2000;
+    TPairs small( smallN );
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    std::printf( "\nsmall batches, %zu pairs x %d calls, %u threads\n", smallN, calls, cores );
+    std::printf( "%-24s %12s\n", "variant", "us/call" );
+    TClock::time_point t0 = TClock::now();
+    for( int c = 0; c < calls; c++ ) {
+        SPML::Geodesy::GEOtoRAD_Batch( el, SPML::Units::RU_Kilometer, SPML::Units::AU_Degree, small.lat1.data(),
+            small.lon1.data(), small.lat2.data(), small.lon2.data(), smallN, small.d.data(), small.az.data(), nullptr,
+            SPML::Execution::Policy( SPML::Execution::EM_ParallelSimd, 1 ) );
+    }
+    std::printf( "%-24s %12.2f\n", "single thread",
+        std::chrono::duration<double, std::micro>( TClock::now() - t0 ).count() / calls );
+    t0 = TClock::now();
+    for( int c = 0; c < calls; c++ ) {
+        SPML::Geodesy::GEOtoRAD_Batch( el, SPML::Units::RU_Kilometer, SPML::Units::AU_Degree, small.lat1.data(),
+            small.lon1.data(), small.lat2.data(), small.lon2.data(), smallN, small.d.data(), small.az.data(), nullptr,
+            SPML::Execution::Policy( SPML::Execution::EM_ParallelSimd, cores ) );
+    }
+    std::printf( "%-24s %12.2f\n", "library pool",
+        std::chrono::duration<double, std::micro>( TClock::now() - t0 ).count() / calls );
+    t0 = TClock::now();
+    for( int c = 0; c < calls; c++ ) {
+        const std::size_t part = ( smallN + cores - 1 ) / cores;
+        std::vector<std::thread> threads;
+        for( std::size_t begin = 0; begin < smallN; begin += part ) {
+            const std::size_t count = std::min( part, smallN - begin );
+            threads.emplace_back( [&, begin, count]() {
+                SPML::Geodesy::GEOtoRAD_Batch( el, SPML::Units::RU_Kilometer, SPML::Units::AU_Degree,
+                    small.lat1.data() + begin, small.lon1.data() + begin, small.lat2.data() + begin,
+                    small.lon2.data() + begin, count, small.d.data() + begin, small.az.data() + begin, nullptr,
+                    SPML::Execution::Policy( SPML::Execution::EM_ParallelSimd, 1 ) );
+            } );
+        }
+        for( std::thread &thread : threads ) {
+            thread.join();
+        }
+    }
+    std::printf( "%-24s %12.2f\n", "std::thread per call",
+        std::chrono::duration<double, std::micro>( TClock::now() - t0 ).count() / calls );
+    return 0;
+}
@@ -0,0 +1,173 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_spml_shm_ring.cpp
+/// \brief      Замер конвейера отметок радиолокатора через кольцевые буферы в разделяемой памяти (см. shm_ring.h)
+/// \details    Синтетический источник отметок (обзор антенны пачками отметок с меткой времени) пишет в буфер
+///             отметок, потребитель в своем потоке переводит их DrainAERtoGEO в буфер результатов, читатель
+///             результатов считает задержку от записи отметки до чтения ее координат. Буферы открываются каждым
+///             участником по имени, как из разных процессов. Для сравнения - те же отметки, переведенные
+///             AERtoGEO в цикле и одним вызовом AERtoGEO_Batch.
+///             Результат - отметки в секунду и задержки (медиана, 99%, максимум).
+///             Запуск: bench_spml_shm_ring [число отметок] [отметок в пачке] [емкость буферов]
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// SPML includes:
+#include <geodesy_batch.h>
+#include <shm_ring.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+
+static const char *PlotsName = "/bench_spml_plots";      // Буфер отметок
+static const char *ResultsName = "/bench_spml_results";  // Буфер результатов
+
+static double Seconds( TClock::time_point t0 )
+{
+    return std::chrono::duration<double>( TClock::now() - t0 ).count();
+}
+
+int main( int argc, char *argv[] )
+{
+    const std::size_t n = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 4000000;
+    const std::size_t burst = ( argc > 2 ) ? std::strtoul( argv[2], nullptr, 10 ) : 256;
+    const std::size_t capacity = ( argc > 3 ) ? std::strtoul( argv[3], nullptr, 10 ) : 65536;
+
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Units::TRangeUnit ru = SPML::Units::RU_Kilometer;
+    const SPML::Units::TAngleUnit au = SPML::Units::AU_Degree;
+    const double lat0 = 55.75, lon0 = 37.62, h0 = 0.15;
+
+    // Отметки одного оборота антенны: азимут растет по пачкам, угол места и дальность случайны
+    const std::size_t turn = 1 << 16;
+    std::mt19937 gen( 21 );
+    std::uniform_real_distribution<double> elevation( 0.0, 30.0 ), range( 5.0, 450.0 );
+    std::vector<double> az( turn ), elev( turn ), r( turn );
+    for( std::size_t i = 0; i < turn; i++ ) {
+        az[i] = 360.0 * static_cast<double>( i / burst * burst ) / turn;
+        elev[i] = elevation( gen );
+        r[i] = range( gen );
+    }
+
+    std::printf( "AERtoGEO, %zu plots, %zu plots per burst, ring capacity %zu\n", n, burst, capacity );
+
+    // Без буферов: скалярная функция и пакетная функция на одном обороте
+    std::vector<double> lat( turn ), lon( turn ), h( turn );
+    TClock::time_point t0 = TClock::now();
+    for( std::size_t i = 0; i < turn; i++ ) {
+        SPML::Geodesy::AERtoGEO( el, ru, au, az[i], elev[i], r[i], lat0, lon0, h0, lat[i], lon[i], h[i] );
+    }
+    std::printf( "%-28s %14.0f plots/s\n", "AERtoGEO", turn / Seconds( t0 ) );
+    const int repeats = 20;
+    t0 = TClock::now();
+    for( int k = 0; k < repeats; k++ ) {
+        SPML::Geodesy::AERtoGEO_Batch( el, ru, au, az.data(), elev.data(), r.data(), turn, lat0, lon0, h0,
+            lat.data(), lon.data(), h.data() );
+    }
+    std::printf( "%-28s %14.0f plots/s\n", "AERtoGEO_Batch", repeats * turn / Seconds( t0 ) );
+
+    // Буферы создает читатель результатов, источник и потребитель открывают их по имени
+    SPML::Ring::CShmRing::Remove( PlotsName );
+    SPML::Ring::CShmRing::Remove( ResultsName );
+    std::string error;
+    SPML::Ring::CShmRing plotsOwner, results;
+    if( !plotsOwner.Create( PlotsName, 4, capacity, error ) || !results.Create( ResultsName, 4, capacity, error ) ) {
+        std::fprintf( stderr, "%s\n", error.c_str() );
+        return EXIT_FAILURE;
+    }
+
+    std::atomic<bool> produced{ false };
+    t0 = TClock::now();
+    std::thread producer( [&]() {
+        SPML::Ring::CShmRing plots;
+        std::string e;
+        if( !plots.Open( PlotsName, e ) ) {
+            std::fprintf( stderr, "%s\n", e.c_str() );
+            produced = true;
+            return;
+        }
+        std::size_t next = 0;
+        while( next < n ) {
+            const SPML::Ring::TSpan span = plots.Reserve( std::min( burst, n - next ) );
+            if( span.Count == 0 ) {
+                std::this_thread::yield();
+                continue;
+            }
+            const double stamp = Seconds( t0 );
+            for( std::size_t i = 0; i < span.Count; i++ ) {
+                const std::size_t k = ( next + i ) % turn;
+                plots.Column( 0 )[span.Offset + i] = az[k];
+                plots.Column( 1 )[span.Offset + i] = elev[k];
+                plots.Column( 2 )[span.Offset + i] = r[k];
+                plots.Column( 3 )[span.Offset + i] = stamp;
+            }
+            plots.Commit( span.Count );
+            next += span.Count;
+        }
+        produced = true;
+    } );
+    std::thread consumer( [&]() {
+        SPML::Ring::CShmRing plots, geo;
+        std::string e;
+        if( !plots.Open( PlotsName, e ) || !geo.Open( ResultsName, e ) ) {
+            std::fprintf( stderr, "%s\n", e.c_str() );
+            return;
+        }
+        std::size_t done = 0;
+        while( done < n ) {
+            const std::size_t moved = SPML::Ring::DrainAERtoGEO( plots, geo, el, ru, au, lat0, lon0, h0 );
+            done += moved;
+            if( moved == 0 ) {
+                if( produced && ( plots.Peek().Count == 0 ) && ( done < n ) ) {
+                    break;  // Источник завершился с ошибкой
+                }
+                std::this_thread::yield();
+            }
+        }
+    } );
+
+    // Читатель результатов: задержка каждой отметки
+    std::vector<double> latencies;
+    latencies.reserve( n );
+    std::size_t received = 0;
+    double check = 0.0;
+    const TClock::time_point deadline = TClock::now() + std::chrono::seconds( 120 );
+    while( ( received < n ) && ( TClock::now() < deadline ) ) {
+        const SPML::Ring::TSpan span = results.Peek();
+        if( span.Count == 0 ) {
+            std::this_thread::yield();
+            continue;
+        }
+        const double now = Seconds( t0 );
+        for( std::size_t i = 0; i < span.Count; i++ ) {
+            latencies.push_back( now - results.Column( 3 )[span.Offset + i] );
+            check += results.Column( 2 )[span.Offset + i];
+        }
+        results.Release( span.Count );
+        received += span.Count;
+    }
+    const double elapsed = Seconds( t0 );
+    producer.join();
+    consumer.join();
+
+    std::sort( latencies.begin(), latencies.end() );
+    const auto percentile = [&latencies]( double p ) {
+        return latencies.empty() ? 0.0 : 1.0e6 * latencies[static_cast<std::size_t>( p * ( latencies.size() - 1 ) )];
+    };
+    std::printf( "%-28s %14.0f plots/s\n", "ring -> DrainAERtoGEO -> ring", received / elapsed );
+    std::printf( "latency, us: p50 %.1f, p99 %.1f, max %.1f; received %zu of %zu (check %.3f)\n", percentile( 0.5 ),
+        percentile( 0.99 ), percentile( 1.0 ), received, n, check / std::max<std::size_t>( received, 1 ) );
+    return ( received == n ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
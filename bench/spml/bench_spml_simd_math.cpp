@@ -0,0 +1,117 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_spml_simd_math.cpp
+/// \brief      Замер пропускной способности пакетных элементарных функций (simd_math.h) в сравнении с libm
+/// \details    Запуск: bench_spml_simd_math [размер массива] [повторы]. Массив по умолчанию помещается в кэш L2,
+///             чтобы замерялись вычисления, а не память
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// SPML includes:
+#include <simd.h>
+#include <simd_math.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+
+// Время на одно значение, [нс]
+static double NsPerItem( TClock::time_point t0, TClock::time_point t1, std::size_t n, int repeats )
+{
+    return std::chrono::duration<double, std::nano>( t1 - t0 ).count() / ( static_cast<double>( n ) * repeats );
+}
+
+struct TFunction
+{
+    SPML::SIMD::TMathFunction func;
+    const char *name;
+    double lo, hi;          // Диапазон аргументов
+    double ( *ref )( double, double );
+};
+
+int main( int argc, char *argv[] )
+{
+    const std::size_t n = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 8192;
+    const int repeats = ( argc > 2 ) ? std::atoi( argv[2] ) : 2000;
+
+    const std::vector<TFunction> functions = {
+        { SPML::SIMD::MF_Sin, "sin", -10.0, 10.0, []( double x, double ) { return std::sin( x ); } },
+        { SPML::SIMD::MF_Cos, "cos", -10.0, 10.0, []( double x, double ) { return std::cos( x ); } },
+        { SPML::SIMD::MF_SinCos, "sincos", -10.0, 10.0, []( double x, double ) { return std::sin( x ) + std::cos( x ); } },
+        { SPML::SIMD::MF_Tan, "tan", -1.5, 1.5, []( double x, double ) { return std::tan( x ); } },
+        { SPML::SIMD::MF_Atan, "atan", -10.0, 10.0, []( double x, double ) { return std::atan( x ); } },
+        { SPML::SIMD::MF_Atan2, "atan2", -10.0, 10.0, []( double y, double x ) { return std::atan2( y, x ); } },
+        { SPML::SIMD::MF_Asin, "asin", -1.0, 1.0, []( double x, double ) { return std::asin( x ); } },
+        { SPML::SIMD::MF_Acos, "acos", -1.0, 1.0, []( double x, double ) { return std::acos( x ); } }
+    };
+
+    std::vector<SPML::SIMD::TSimdLevel> levels;
+    for( int lv = SPML::SIMD::SL_Scalar; lv <= SPML::SIMD::SL_AVX512; lv++ ) {
+        if( SPML::SIMD::IsSupported( static_cast<SPML::SIMD::TSimdLevel>( lv ) ) ) {
+            levels.push_back( static_cast<SPML::SIMD::TSimdLevel>( lv ) );
+        }
+    }
+
+    std::printf( "SIMD math, %zu values x %d%s, ns/value\n", n, repeats,
+        SPML::SIMD::IsLibmMath() ? " (SPML_LIBM_MATH: libm at all levels)" : "" );
+    std::printf( "%-8s %10s", "function", "libm loop" );
+    for( SPML::SIMD::TSimdLevel level : levels ) {
+        std::printf( " %10s", SPML::SIMD::Name( level ).c_str() );
+    }
+    std::printf( " %10s\n", "speedup" );
+
+    std::mt19937 gen( 1 );
+    std::vector<double> x( n ), y( n ), out( n ), out2( n );
+    double sink = 0.0; // Результат используется, чтобы цикл libm не был удален компилятором
+    for( const TFunction &f : functions ) {
+        std::uniform_real_distribution<double> dist( f.lo, f.hi );
+        for( std::size_t i = 0; i < n; i++ ) {
+            x[i] = dist( gen );
+            y[i] = dist( gen );
+        }
+
+        TClock::time_point t0 = TClock::now();
+        for( int r = 0; r < repeats; r++ ) {
+            for( std::size_t i = 0; i < n; i++ ) {
+                out[i] = f.ref( x[i], y[i] );
+            }
+            sink += out[r % n];
+        }
+        const double nsLibm = NsPerItem( t0, TClock::now(), n, repeats );
+        std::printf( "%-8s %10.2f", f.name, nsLibm );
+
+        double nsBest = nsLibm;
+        for( SPML::SIMD::TSimdLevel level : levels ) {
+            t0 = TClock::now();
+            for( int r = 0; r < repeats; r++ ) {
+                switch( f.func ) {
+                    case( SPML::SIMD::MF_SinCos ):
+                        SPML::SIMD::SinCos( x.data(), n, out.data(), out2.data(), level );
+                        break;
+                    case( SPML::SIMD::MF_Atan2 ):
+                        SPML::SIMD::Atan2( x.data(), y.data(), n, out.data(), level );
+                        break;
+                    default:
+                        SPML::SIMD::Evaluate( f.func, x.data(), n, out.data(), level );
+                        break;
+                }
+                sink += out[r % n];
+            }
+            const double ns = NsPerItem( t0, TClock::now(), n, repeats );
+            nsBest = std::min( nsBest, ns );
+            std::printf( " %10.2f", ns );
+        }
+        std::printf( " %9.1fx\n", nsLibm / nsBest );
+    }
+    return ( sink == 0.12345 ) ? 1 : 0;
+}
@@ -0,0 +1,126 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_spml_spatial_index.cpp
+/// \brief      Замер производительности поиска ближайших точек (CSpatialIndex) в сравнении с полным перебором
+/// \details    Опорные точки по всему земному шару. Замеряются: построение индекса, одиночные и пакетные запросы k
+///             ближайших, полный перебор циклом GEOtoRAD и через GEOtoRAD_Matrix (на части запросов).
+///             Запуск: bench_spml_spatial_index [число точек] [число запросов] [k]
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+// SPML includes:
+#include <geodesy.h>
+#include <geodesy_batch.h>
+#include <spatial_index.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+
+// Время на один запрос, [мкс]
+static double UsPerQuery( TClock::time_point t0, TClock::time_point t1, std::size_t queries )
+{
+    return std::chrono::duration<double, std::micro>( t1 - t0 ).count() / static_cast<double>( queries );
+}
+
+static void PrintRow( const char *variant, unsigned int threads, double us, double usBase )
+{
+    std::printf( "%-28s %8u %14.3f %10.1f\n", variant, threads, us, usBase / us );
+}
+
+// Случайные точки по всему земному шару
+static void GlobalPoints( std::size_t n, unsigned int seed, std::vector<double> &lat, std::vector<double> &lon )
+{
+    std::mt19937 gen( seed );
+    std::uniform_real_distribution<double> uLat( -89.0, 89.0 );
+    std::uniform_real_distribution<double> uLon( -180.0, 180.0 );
+    lat.resize( n );
+    lon.resize( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        lat[i] = uLat( gen );
+        lon[i] = uLon( gen );
+    }
+}
+
+int main( int argc, char *argv[] )
+{
+    const std::size_t n = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 2000000;
+    const std::size_t queries = ( argc > 2 ) ? std::strtoul( argv[2], nullptr, 10 ) : 10000;
+    const std::size_t k = ( argc > 3 ) ? std::strtoul( argv[3], nullptr, 10 ) : 8;
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Units::TRangeUnit ru = SPML::Units::RU_Kilometer;
+    const SPML::Units::TAngleUnit au = SPML::Units::AU_Degree;
+    const unsigned int cores = std::max( 1u, std::thread::hardware_concurrency() );
+
+    std::vector<double> lat, lon, latQ, lonQ;
+    GlobalPoints( n, 1, lat, lon );
+    GlobalPoints( queries, 2, latQ, lonQ );
+
+    std::printf( "%zu points, %zu queries, k = %zu, WGS84, %u hardware threads\n", n, queries, k, cores );
+    TClock::time_point t0 = TClock::now();
+    const SPML::Geodesy::CSpatialIndex index( el, ru, au, lat.data(), lon.data(), n );
+    TClock::time_point t1 = TClock::now();
+    std::printf( "build: %.1f ms (%.1f ns/point)\n\n", std::chrono::duration<double, std::milli>( t1 - t0 ).count(),
+        std::chrono::duration<double, std::nano>( t1 - t0 ).count() / static_cast<double>( n ) );
+    std::printf( "%-28s %8s %14s %10s\n", "variant", "threads", "us/query", "speedup" );
+
+    // Полный перебор - на части запросов
+    const std::size_t queriesPart = std::min<std::size_t>( queries, 5 );
+    std::vector<double> d( n ), az( n );
+    std::vector<std::pair<double, std::size_t>> all( n );
+    t0 = TClock::now();
+    for( std::size_t q = 0; q < queriesPart; q++ ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::GEOtoRAD( el, ru, au, latQ[q], lonQ[q], lat[i], lon[i], d[i], az[i] );
+            all[i] = std::make_pair( d[i], i );
+        }
+        std::partial_sort( all.begin(), all.begin() + std::min( k, n ), all.end() );
+    }
+    t1 = TClock::now();
+    const double usBrute = UsPerQuery( t0, t1, queriesPart );
+    PrintRow( "brute GEOtoRAD loop", 1, usBrute, usBrute );
+
+    t0 = TClock::now();
+    for( std::size_t q = 0; q < queriesPart; q++ ) {
+        SPML::Geodesy::GEOtoRAD_Matrix( el, ru, au, &latQ[q], &lonQ[q], 1, lat.data(), lon.data(), n, d.data(),
+            az.data() );
+        for( std::size_t i = 0; i < n; i++ ) {
+            all[i] = std::make_pair( d[i], i );
+        }
+        std::partial_sort( all.begin(), all.begin() + std::min( k, n ), all.end() );
+    }
+    t1 = TClock::now();
+    PrintRow( "brute GEOtoRAD_Matrix", 1, UsPerQuery( t0, t1, queriesPart ), usBrute );
+
+    // Запросы к индексу
+    std::vector<std::size_t> found( queries * k );
+    std::vector<double> dk( queries * k );
+    t0 = TClock::now();
+    for( std::size_t q = 0; q < queries; q++ ) {
+        index.Nearest( latQ[q], lonQ[q], k, found.data() + q * k, dk.data() + q * k );
+    }
+    t1 = TClock::now();
+    PrintRow( "CSpatialIndex::Nearest", 1, UsPerQuery( t0, t1, queries ), usBrute );
+
+    std::vector<unsigned int> threadCounts;
+    for( unsigned int t = 1; t < cores; t *= 2 ) {
+        threadCounts.push_back( t );
+    }
+    threadCounts.push_back( cores );
+    for( unsigned int threads : threadCounts ) {
+        t0 = TClock::now();
+        index.Nearest( latQ.data(), lonQ.data(), queries, k, found.data(), dk.data(), nullptr, threads );
+        t1 = TClock::now();
+        PrintRow( "CSpatialIndex::Nearest batch", threads, UsPerQuery( t0, t1, queries ), usBrute );
+    }
+    return 0;
+}
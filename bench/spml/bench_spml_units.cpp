@@ -0,0 +1,186 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       bench_spml_units.cpp
+/// \brief      Замер выигрыша от специализации функций перевода координат по единицам измерения
+/// \details    Сравнивается прежняя реализация с ветвлениями по единицам измерения на каждом вызове (копия ECEFtoENUV),
+///             функции с единицами измерения, заданными во время выполнения (выбор специализации на вызове),
+///             и прямой вызов специализаций. Запуск: bench_spml_units [число вызовов]
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+// System includes:
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// SPML includes:
+#include <geodesy.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+typedef std::chrono::steady_clock TClock;
+
+// Время на один вызов, [нс]
+static double NsPerCall( TClock::time_point t0, TClock::time_point t1, std::size_t n )
+{
+    return std::chrono::duration<double, std::nano>( t1 - t0 ).count() / static_cast<double>( n );
+}
+
+// Прежняя реализация ECEFtoENUV: перевод единиц через switch на каждом вызове
+// (noinline - как и функции библиотеки, вызывается из другой единицы трансляции)
+__attribute__( ( noinline ) ) static void ECEFtoENUV_Switch( const SPML::Units::TRangeUnit &rangeUnit,
+    const SPML::Units::TAngleUnit &angleUnit, double dX, double dY, double dZ, double lat, double lon,
+    double &xEast, double &yNorth, double &zUp )
+{
+    double _lat = lat;
+    double _lon = lon;
+    double _dX = dX;
+    double _dY = dY;
+    double _dZ = dZ;
+    switch( angleUnit ) {
+        case( SPML::Units::TAngleUnit::AU_Radian ): break;
+        case( SPML::Units::TAngleUnit::AU_Degree ):
+        {
+            _lat *= SPML::Convert::DgToRdD;
+            _lon *= SPML::Convert::DgToRdD;
+            break;
+        }
+        default:
+            break;
+    }
+    switch( rangeUnit ) {
+        case( SPML::Units::TRangeUnit::RU_Meter ): break;
+        case( SPML::Units::TRangeUnit::RU_Kilometer ):
+        {
+            _dX *= 1000.0;
+            _dY *= 1000.0;
+            _dZ *= 1000.0;
+            break;
+        }
+        default:
+            break;
+    }
+    double cosPhi = std::cos( _lat );
+    double sinPhi = std::sin( _lat );
+    double cosLambda = std::cos( _lon );
+    double sinLambda = std::sin( _lon );
+    double t = ( cosLambda * _dX ) + ( sinLambda * _dY );
+    xEast = ( -sinLambda * _dX ) + ( cosLambda * _dY );
+    zUp = ( cosPhi * t ) + ( sinPhi * _dZ );
+    yNorth = ( -sinPhi * t ) + ( cosPhi * _dZ );
+    switch( rangeUnit ) {
+        case( SPML::Units::TRangeUnit::RU_Meter ): break;
+        case( SPML::Units::TRangeUnit::RU_Kilometer ):
+        {
+            xEast *= 0.001;
+            yNorth *= 0.001;
+            zUp *= 0.001;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+int main( int argc, char *argv[] )
+{
+    const std::size_t n = ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 2000000;
+
+    // Единицы задаются через volatile, чтобы компилятор не знал их значение при сборке
+    volatile int ruValue = SPML::Units::RU_Kilometer;
+    volatile int auValue = SPML::Units::AU_Degree;
+    const SPML::Units::TRangeUnit ru = static_cast<SPML::Units::TRangeUnit>( ruValue );
+    const SPML::Units::TAngleUnit au = static_cast<SPML::Units::TAngleUnit>( auValue );
+    const SPML::Units::TRangeUnit RU = SPML::Units::RU_Kilometer;
+    const SPML::Units::TAngleUnit AU = SPML::Units::AU_Degree;
+    const SPML::Geodesy::CEllipsoid wgs84 = SPML::Geodesy::Ellipsoids::WGS84();
+    volatile double lonValue = 37.62; // Аналогично для входных данных (исключает подстановку констант)
+    const double lon = lonValue;
+    volatile double sink = 0.0;
+
+    // 1. ECEFtoENUV
+    double acc = 0.0;
+    TClock::time_point t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        double e, nn, u;
+        ECEFtoENUV_Switch( ru, au, 1.5, -2.0, 0.5, 55.75 + 1.0e-4 * static_cast<double>( i & 1023 ), lon, e, nn, u );
+        acc += e + nn + u;
+    }
+    const double nsEnuvSwitch = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+
+    acc = 0.0;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        double e, nn, u;
+        SPML::Geodesy::ECEFtoENUV( ru, au, 1.5, -2.0, 0.5, 55.75 + 1.0e-4 * static_cast<double>( i & 1023 ), lon,
+            e, nn, u );
+        acc += e + nn + u;
+    }
+    const double nsEnuvRuntime = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+
+    acc = 0.0;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        double e, nn, u;
+        SPML::Geodesy::ECEFtoENUV<RU, AU>( 1.5, -2.0, 0.5, 55.75 + 1.0e-4 * static_cast<double>( i & 1023 ), lon,
+            e, nn, u );
+        acc += e + nn + u;
+    }
+    const double nsEnuvTemplate = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+
+    // 2. ENUtoAER
+    acc = 0.0;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        double a, e, r;
+        SPML::Geodesy::ENUtoAER( ru, au, 1.5 + 1.0e-3 * static_cast<double>( i & 1023 ), -2.0, 0.5, a, e, r );
+        acc += a + e + r;
+    }
+    const double nsAerRuntime = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+
+    acc = 0.0;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        double a, e, r;
+        SPML::Geodesy::ENUtoAER<RU, AU>( 1.5 + 1.0e-3 * static_cast<double>( i & 1023 ), -2.0, 0.5, a, e, r );
+        acc += a + e + r;
+    }
+    const double nsAerTemplate = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+
+    // 3. GEOtoECEF
+    acc = 0.0;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        double x, y, z;
+        SPML::Geodesy::GEOtoECEF( wgs84, ru, au,
+            55.75 + 1.0e-4 * static_cast<double>( i & 1023 ), lon, 0.15, x, y, z );
+        acc += x + y + z;
+    }
+    const double nsEcefRuntime = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+
+    acc = 0.0;
+    t0 = TClock::now();
+    for( std::size_t i = 0; i < n; i++ ) {
+        double x, y, z;
+        SPML::Geodesy::GEOtoECEF<RU, AU>( wgs84,
+            55.75 + 1.0e-4 * static_cast<double>( i & 1023 ), lon, 0.15, x, y, z );
+        acc += x + y + z;
+    }
+    const double nsEcefTemplate = NsPerCall( t0, TClock::now(), n );
+    sink = acc;
+    (void)sink;
+
+    std::printf( "Units specialization (km, deg), %zu calls\n", n );
+    std::printf( "%-24s %14s %14s %14s\n", "function", "switch, ns", "runtime, ns", "template, ns" );
+    std::printf( "%-24s %14.2f %14.2f %14.2f\n", "ECEFtoENUV", nsEnuvSwitch, nsEnuvRuntime, nsEnuvTemplate );
+    std::printf( "%-24s %14s %14.2f %14.2f\n", "ENUtoAER", "-", nsAerRuntime, nsAerTemplate );
+    std::printf( "%-24s %14s %14.2f %14.2f\n", "GEOtoECEF", "-", nsEcefRuntime, nsEcefTemplate );
+    return 0;
+}
@@ -0,0 +1,184 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       columnar.h
+/// \brief      Двоичный столбцовый формат записей и результатов geocalc
+/// \details    Файл состоит из заголовка (96 байт) и блоков. Блок содержит до BlockSize записей: сначала все числа
+///             первого столбца блока, затем второго и т.д. (float64), поэтому пакетные функции получают столбцы без
+///             разбора текста. Все блоки, кроме последнего, полные. Все числа - little-endian.
+///             \n Заголовок (смещение в байтах: поле):
+///             \n  0: char[8]  Magic     - "GEOCOLv1"
+///             \n  8: uint32   Version   - версия формата (1)
+///             \n 12: uint32   BlockSize - число записей в блоке (от 1 до MaxBlockSize)
+///             \n 16: char[16] Operation - задача потокового режима ("geo2rad" и т.д.), дополняется нулями
+///             \n 32: uint8    Ellipsoid - эллипсоид реестра (SPML::Geodesy::TEllipsoidId), 255 - эллипсоид не из
+///                                    реестра (задан только A и Invf, имя не сохраняется)
+///             \n 33: uint8[15] Reserved - 0
+///             \n 48: uint8    Kind      - содержимое: 0 - записи (входы задачи), 1 - результаты
+///             \n 49: uint8    Columns   - число столбцов
+///             \n 50: uint8    RangeUnit - единицы дальности (SPML::Units::TRangeUnit)
+///             \n 51: uint8    AngleUnit - единицы углов (SPML::Units::TAngleUnit)
+///             \n 52: uint8    From      - исходный датум задачи bw (SPML::Geodesy::TGeodeticDatum)
+///             \n 53: uint8    To        - конечный датум задачи bw
+///             \n 54: uint16   Reserved  - 0
+///             \n 56: uint64   Count     - число записей (UINT64_MAX - не известно, блоки до конца файла)
+///             \n 64: float64  A         - большая полуось эллипсоида, [м] (конечное, больше 0)
+///             \n 72: float64  Invf      - обратное сжатие эллипсоида (конечное, не меньше 0; 0 - сфера)
+///             \n 80: uint8[16]          - 0
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup geocalc
+/// \{
+///
+
+#ifndef GEOCALC_COLUMNAR_H
+#define GEOCALC_COLUMNAR_H
+
+// System includes:
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// SPML includes:
+#include <geodesy.h>
+#include <units.h>
+
+namespace GeoCalc /// Геодезический калькулятор
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Содержимое столбцового файла
+///
+enum TColumnarKind : int
+{
+    CK_Records = 0,     ///< Записи (входы задачи)
+    CK_Results = 1      ///< Результаты
+};
+
+///
+/// \brief Заголовок столбцового файла
+///
+struct TColumnarHeader
+{
+    static const std::size_t Size = 96;                 ///< Размер заголовка в файле, [байт]
+    static const std::uint64_t UnknownCount = UINT64_MAX; ///< Число записей не известно (вывод в канал)
+    static const std::uint32_t MaxBlockSize = 1 << 20;  ///< Наибольшее число записей в блоке (память чтения блока)
+
+    std::uint32_t BlockSize = 4096;                     ///< Число записей в блоке
+    std::string Operation;                              ///< Задача потокового режима
+    TColumnarKind Kind = CK_Records;                    ///< Содержимое
+    std::size_t Columns = 0;                            ///< Число столбцов
+    SPML::Units::TRangeUnit RangeUnit = SPML::Units::RU_Kilometer; ///< Единицы дальности
+    SPML::Units::TAngleUnit AngleUnit = SPML::Units::AU_Degree;     ///< Единицы углов
+    std::uint64_t Count = UnknownCount;                 ///< Число записей
+    SPML::Geodesy::TGeodeticDatum From = SPML::Geodesy::GD_WGS84;   ///< Исходный датум задачи bw
+    SPML::Geodesy::TGeodeticDatum To = SPML::Geodesy::GD_WGS84;     ///< Конечный датум задачи bw
+    SPML::Geodesy::CEllipsoid Ellipsoid;                ///< Эллипсоид (реестра или по A и Invf)
+};
+
+///
+/// \brief Чтение заголовка столбцового файла
+/// \param[in]  file   - файл, читается с текущей позиции
+/// \param[out] header - заголовок
+/// \param[out] error  - описание ошибки
+/// \return true, если заголовок прочитан и верен
+///
+bool ReadColumnarHeader( std::FILE *file, TColumnarHeader &header, std::string &error );
+
+///
+/// \brief Разбор заголовка столбцового файла из памяти (например, из файла, отображенного в память)
+/// \param[in]  bytes  - TColumnarHeader::Size байт заголовка
+/// \param[out] header - заголовок
+/// \param[out] error  - описание ошибки
+/// \return true, если заголовок верен
+///
+bool DecodeColumnarHeader( const char *bytes, TColumnarHeader &header, std::string &error );
+
+///
+/// \brief Запись заголовка столбцового файла в буфер
+/// \param[in]  header - заголовок
+/// \param[out] bytes  - TColumnarHeader::Size байт заголовка
+///
+void EncodeColumnarHeader( const TColumnarHeader &header, char *bytes );
+
+///
+/// \brief Чтение блока столбцового файла
+/// \param[in]  file    - файл, читается с текущей позиции
+/// \param[in]  header  - заголовок файла
+/// \param[in]  read    - число записей, прочитанных из предыдущих блоков
+/// \param[out] columns - header.Columns массивов не менее чем по header.BlockSize чисел
+/// \param[out] count   - число записей в блоке (0 - конец файла)
+/// \param[out] error   - описание ошибки
+/// \return false, если файл обрывается внутри записи или записей меньше header.Count
+///
+bool ReadColumnarBlock( std::FILE *file, const TColumnarHeader &header, std::uint64_t read, double *const *columns,
+    std::size_t &count, std::string &error );
+
+///
+/// \brief Запись столбца блока в буфер (little-endian)
+/// \param[in]  column - числа столбца
+/// \param[in]  count  - число записей в блоке
+/// \param[out] bytes  - буфер размером не менее 8 * count байт
+///
+void EncodeColumn( const double *column, std::size_t count, char *bytes );
+
+///
+/// \brief Чтение столбца блока из буфера (little-endian)
+/// \param[in]  bytes  - 8 * count байт столбца
+/// \param[in]  count  - число записей
+/// \param[out] column - числа столбца
+///
+void DecodeColumn( const char *bytes, std::size_t count, double *column );
+
+///
+/// \brief Смещение числа записи от начала файла с известным числом записей
+/// \details Все блоки, кроме последнего, содержат blockSize записей, поэтому место любого числа вычисляется без
+/// чтения файла: файл можно читать и записывать по частям независимо (в том числе из разных потоков). Размер файла -
+/// TColumnarHeader::Size + 8 * columns * count байт
+/// \param[in] blockSize - число записей в блоке
+/// \param[in] columns   - число столбцов
+/// \param[in] count     - число записей в файле
+/// \param[in] record    - номер записи (меньше count)
+/// \param[in] column    - номер столбца
+/// \return Смещение, [байт]
+///
+std::uint64_t ColumnarOffset( std::uint32_t blockSize, std::size_t columns, std::uint64_t count, std::uint64_t record,
+    std::size_t column );
+
+///
+/// \brief Чтение записей файла с известным числом записей из памяти
+/// \param[in]  bytes   - файл (начиная с заголовка)
+/// \param[in]  header  - заголовок файла (header.Count известно)
+/// \param[in]  first   - номер первой читаемой записи
+/// \param[in]  count   - число читаемых записей (first + count не больше header.Count)
+/// \param[out] columns - header.Columns массивов не менее чем по count чисел
+///
+void DecodeRecords( const char *bytes, const TColumnarHeader &header, std::uint64_t first, std::size_t count,
+    double *const *columns );
+
+///
+/// \brief Запись записей на их места в файле с известным числом записей в памяти
+/// \param[in]  columns - header.Columns массивов по count чисел
+/// \param[in]  header  - заголовок файла (header.Count известно)
+/// \param[in]  first   - номер первой записываемой записи
+/// \param[in]  count   - число записываемых записей (first + count не больше header.Count)
+/// \param[out] bytes   - файл (начиная с заголовка) размером не менее ColumnarOffset конца файла
+///
+void EncodeRecords( const double *const *columns, const TColumnarHeader &header, std::uint64_t first,
+    std::size_t count, char *bytes );
+
+///
+/// \brief Запись числа записей в заголовок уже записанного файла
+/// \details Используется, если при записи заголовка число записей не было известно. Файл должен допускать
+/// перемещение позиции (для каналов число записей остается неизвестным)
+/// \param[in] file   - файл
+/// \param[in] start  - позиция начала заголовка в файле
+/// \param[in] count  - число записей
+/// \return true, если число записей записано
+///
+bool PatchColumnarCount( std::FILE *file, long start, std::uint64_t count );
+
+} // end namespace GeoCalc
+#endif // GEOCALC_COLUMNAR_H
+/// \}
@@ -0,0 +1,49 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       mapped.h
+/// \brief      Параллельная потоковая обработка файлов, отображенных в память
+/// \details    Файл ввода отображается в память (mmap) и делится на части по границам записей: текст - по строкам,
+///             двоичный столбцовый формат - по номерам записей. Части обрабатываются потоками пула библиотеки
+///             (SPML::Execution::ParallelTasks), у каждой части свой CStreamProcessor, без копирования ввода в
+///             буферы пользователя.
+///             \n Двоичный вывод: число записей известно заранее (для текста - по предварительному подсчету строк),
+///             файл вывода создается нужного размера и отображается в память, потоки записывают результаты сразу на
+///             их места (ColumnarOffset) - порядок записей сохраняется без блокировок.
+///             \n Текстовый вывод: длина текста результатов заранее не известна, поэтому части обрабатываются
+///             группами: результаты частей группы печатаются в память потоков, затем по их длинам вычисляются
+///             смещения, файл вывода увеличивается, и потоки копируют текст на свои места в отображении.
+///             \n Только для POSIX-систем (mmap).
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup geocalc
+/// \{
+///
+
+#ifndef GEOCALC_MAPPED_H
+#define GEOCALC_MAPPED_H
+
+// System includes:
+#include <string>
+
+// GEOCALC includes:
+#include <stream.h>
+
+namespace GeoCalc /// Геодезический калькулятор
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Параллельная потоковая обработка файла ввода с выводом в файл
+/// \details Результат совпадает с RunStream для тех же файлов (сообщения об ошибках ввода выводятся в stderr по мере
+/// обработки частей, поэтому могут идти не по порядку строк). Части выполняются пулом потоков библиотеки как он
+/// есть: число потоков задается до вызова (SPML::Execution::SetPoolThreads)
+/// \param[in] input    - имя файла ввода (обычный файл, не канал)
+/// \param[in] output   - имя файла вывода (создается или перезаписывается, не должен совпадать с файлом ввода)
+/// \param[in] settings - настройки потокового режима
+/// \return EXIT_SUCCESS, если все записи обработаны без ошибок, иначе EXIT_FAILURE (в том числе, если файл вывода
+/// совпадает с файлом ввода или на диске нет места для вывода: место выделяется до записи в отображение)
+///
+int RunMapped( const std::string &input, const std::string &output, const TStreamSettings &settings );
+
+} // end namespace GeoCalc
+#endif // GEOCALC_MAPPED_H
+/// \}
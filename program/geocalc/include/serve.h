@@ -0,0 +1,173 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       serve.h
+/// \brief      Сервер геодезического калькулятора на локальном сокете (Unix domain socket) и его клиент
+/// \details    Сервер не запускается на каждый запрос: задачи потокового режима (stream.h) решаются пакетами записей,
+///             присланными по соединению. Клиент посылает запросы, сервер отвечает на каждый в порядке запросов.
+///             \n Запрос - столбцовый файл (columnar.h) с известным числом записей (не более MaxServeRecords):
+///             заголовок задает задачу, эллипсоид, единицы измерения и датумы (Kind = CK_Records), блоки - записи.
+///             \n Ответ: uint32 Status (0 - решено, 1 - ошибка), uint32 Length (little-endian), затем при Status = 0 -
+///             столбцовый файл результатов (Kind = CK_Results, то же число записей), при ошибке - Length байт текста
+///             ошибки, после чего сервер закрывает соединение.
+///             \n Прием соединений и обмен данными ведет один поток событий (poll) без блокировки на соединении:
+///             полностью принятые запросы ставятся в ограниченную очередь, поток решения забирает их из очереди и
+///             решает блоками пакетными функциями SPML на пуле потоков библиотеки (execution.h), ответы отправляет
+///             поток событий. Пока очередь заполнена, новые запросы не читаются. Соединение, по которому за время
+///             ожидания не пришло и не ушло ни одного байта (кроме времени решения его запроса), закрывается.
+///             \n Только для POSIX-систем.
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup geocalc
+/// \{
+///
+
+#ifndef GEOCALC_SERVE_H
+#define GEOCALC_SERVE_H
+
+// System includes:
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// GEOCALC includes:
+#include <columnar.h>
+
+namespace GeoCalc /// Геодезический калькулятор
+{
+//----------------------------------------------------------------------------------------------------------------------
+static const std::uint64_t MaxServeRecords = 1 << 20;  ///< Наибольшее число записей в запросе к серверу
+static const unsigned ServeIdleTimeout = 60000;         ///< Время ожидания данных соединения по умолчанию, [мс]
+
+struct TServeConnection; // Соединение сервера (serve.cpp)
+
+///
+/// \brief Сервер на локальном сокете
+///
+class CServer
+{
+public:
+    ///
+    /// \brief Параметрический конструктор
+    /// \details Число потоков пула библиотеки, решающих запросы, сервер не меняет: пул настраивается до Start
+    /// (SPML::Execution::SetPoolThreads), от его размера зависит длина очереди запросов
+    /// \param[in] path        - путь сокета
+    /// \param[in] idleTimeout - время ожидания данных соединения, [мс]
+    ///
+    explicit CServer( const std::string &path, unsigned idleTimeout = ServeIdleTimeout );
+
+    CServer( const CServer & ) = delete;
+    CServer &operator=( const CServer & ) = delete;
+
+    ///
+    /// \brief Деструктор: остановка сервера и удаление файла сокета
+    ///
+    ~CServer();
+
+    ///
+    /// \brief Создание сокета и запуск потоков событий и решения
+    /// \details Оставшийся от остановленного сервера файл сокета заменяется, сокет работающего сервера - нет
+    /// \param[out] error - описание ошибки
+    /// \return true, если сервер запущен
+    ///
+    bool Start( std::string &error );
+
+    ///
+    /// \brief Остановка приема соединений и обмена по соединениям (можно вызывать из любого потока, в том числе
+    /// до Start): поток событий пробуждается через канал пробуждения, соединения закрываются в Wait
+    ///
+    void Stop();
+
+    ///
+    /// \brief Ожидание завершения потоков после Stop и закрытие соединений
+    ///
+    void Wait();
+
+private:
+    std::string path;                   // Путь сокета
+    unsigned idleTimeout;               // Время ожидания данных соединения, [мс]
+    int listener = -1;                  // Сокет приема соединений
+    int wakeRead = -1;                  // Канал пробуждения потока событий (self-pipe): чтение
+    int wakeWrite = -1;                 // Канал пробуждения потока событий: запись
+    std::atomic<bool> stopping{ false }; // Признак остановки
+    std::thread events;                 // Поток событий: прием соединений, чтение запросов, отправка ответов
+    std::thread solver;                 // Поток решения запросов
+    std::vector<std::unique_ptr<TServeConnection>> connections; // Соединения (только поток событий и Wait)
+    std::size_t queueCapacity = 0;      // Наибольшее число запросов в очереди и решении
+    std::mutex queueMutex;              // Защита queue, solved, pending
+    std::condition_variable queueChanged; // Новые запросы в очереди или остановка
+    std::vector<TServeConnection *> queue;  // Принятые запросы, ждущие решения
+    std::vector<TServeConnection *> solved; // Решенные запросы, ждущие отправки
+    std::size_t pending = 0;            // Число запросов в очереди и решении
+
+    // Пробуждение потока событий
+    void Wake();
+
+    // Поток событий
+    void Events();
+
+    // Поток решения
+    void Solver();
+};
+
+///
+/// \brief Работа сервера до сигнала SIGINT или SIGTERM
+/// \details Пул потоков библиотеки настраивается один раз до запуска сервера
+/// \param[in] path    - путь сокета
+/// \param[in] threads - число потоков пула библиотеки, решающих запросы (0 - по числу ядер процессора)
+/// \return EXIT_SUCCESS после остановки по сигналу, EXIT_FAILURE, если сервер не запущен
+///
+int RunServe( const std::string &path, unsigned threads );
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Клиент сервера на локальном сокете
+/// \details Одно соединение, запросы выполняются по одному. Для одновременных запросов из нескольких потоков нужны
+/// отдельные клиенты
+///
+class CServeClient
+{
+public:
+    CServeClient() = default;
+    CServeClient( const CServeClient & ) = delete;
+    CServeClient &operator=( const CServeClient & ) = delete;
+
+    ///
+    /// \brief Деструктор: закрытие соединения
+    ///
+    ~CServeClient();
+
+    ///
+    /// \brief Соединение с сервером
+    /// \param[in]  path  - путь сокета
+    /// \param[out] error - описание ошибки
+    /// \return true, если соединение установлено
+    ///
+    bool Connect( const std::string &path, std::string &error );
+
+    ///
+    /// \brief Решение пакета записей на сервере
+    /// \param[in]  task  - задача: Operation, Ellipsoid, RangeUnit, AngleUnit, From, To (остальные поля заполняются)
+    /// \param[in]  in    - столбцы записей (число чисел в записи задачи массивов по count чисел)
+    /// \param[in]  count - число записей (не более MaxServeRecords)
+    /// \param[out] out   - столбцы результатов (число чисел в результате задачи массивов по count чисел)
+    /// \param[out] error - описание ошибки (после ошибки сервера соединение закрыто)
+    /// \return true, если пакет решен
+    ///
+    bool Solve( const TColumnarHeader &task, const double *const *in, std::size_t count, double *const *out,
+        std::string &error );
+
+private:
+    int fd = -1;                // Соединение
+    std::vector<char> request;  // Буфер запроса
+    std::vector<char> response; // Буфер ответа
+};
+
+} // end namespace GeoCalc
+#endif // GEOCALC_SERVE_H
+/// \}
@@ -0,0 +1,368 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       stream.h
+/// \brief      Потоковый режим геодезического калькулятора: одна задача на много записей
+/// \details    Задача, эллипсоид и единицы измерения задаются один раз, записи читаются по одной на строку (числа
+///             через пробелы, табуляции, запятые или точки с запятой), на каждую запись выводится строка результата.
+///             Записи накапливаются блоками и решаются пакетными функциями SPML (geodesy_batch.h), где они есть,
+///             ввод и вывод буферизованы, поэтому время определяется вычислениями, а не запуском процесса.
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup geocalc
+/// \{
+///
+
+#ifndef GEOCALC_STREAM_H
+#define GEOCALC_STREAM_H
+
+// System includes:
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+// SPML includes:
+#include <geodesy.h>
+#include <units.h>
+
+// GEOCALC includes:
+#include <columnar.h>
+
+namespace GeoCalc /// Геодезический калькулятор
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Буфер текста результатов
+/// \details Числа печатаются std::to_chars прямо в буфер (без std::ostringstream и временных строк), память буфера
+/// переиспользуется после Clear
+///
+class CTextBuffer
+{
+public:
+    ///
+    /// \brief Печать числа с фиксированным числом цифр после запятой (как std::fixed с precision)
+    /// \param[in] value     - число
+    /// \param[in] precision - число цифр после запятой (меньше 0 - кратчайшая запись, читаемая без потери точности)
+    ///
+    void Append( double value, int precision );
+
+    ///
+    /// \brief Добавление символа
+    /// \param[in] c - символ
+    ///
+    void Append( char c )
+    {
+        Reserve( 1 );
+        text[size++] = c;
+    }
+
+    ///
+    /// \brief Добавление строки
+    /// \param[in] begin  - начало строки
+    /// \param[in] length - длина строки
+    ///
+    void Append( const char *begin, std::size_t length );
+
+    ///
+    /// \brief Начало текста
+    ///
+    const char *Data() const
+    {
+        return text.data();
+    }
+
+    ///
+    /// \brief Длина текста
+    ///
+    std::size_t Size() const
+    {
+        return size;
+    }
+
+    ///
+    /// \brief Добавление места под length байт в конце текста (для двоичного вывода)
+    /// \param[in] length - число байт
+    /// \return Начало добавленного места
+    ///
+    char *Extend( std::size_t length )
+    {
+        Reserve( length );
+        size += length;
+        return text.data() + size - length;
+    }
+
+    ///
+    /// \brief Очистка текста (память сохраняется)
+    ///
+    void Clear()
+    {
+        size = 0;
+    }
+
+private:
+    std::vector<char> text;     // Память буфера
+    std::size_t size = 0;       // Длина текста
+
+    // Увеличение памяти, чтобы после текста осталось не менее length символов
+    void Reserve( std::size_t length )
+    {
+        if( text.size() - size < length ) {
+            text.resize( std::max( 2 * text.size(), size + length ) );
+        }
+    }
+};
+
+///
+/// \brief Чтение числа из строки
+/// \details std::from_chars (без учета локали, без завершающего нуля), допускается знак '+' перед цифрой или точкой
+/// ("+-5", "+nan", "+inf" не читаются)
+/// \param[in]  begin - начало числа
+/// \param[in]  end   - конец строки
+/// \param[out] value - число
+/// \return Указатель на символ после числа или nullptr, если число не прочитано
+///
+const char *ParseNumber( const char *begin, const char *end, double &value );
+
+///
+/// \brief Строка содержит запись: не пустая (без учета разделителей) и не начинается с '#'
+/// \param[in] begin - начало строки
+/// \param[in] end   - конец строки (без символа '\n')
+/// \return true, если строка - запись
+///
+bool IsRecordLine( const char *begin, const char *end );
+
+//----------------------------------------------------------------------------------------------------------------------
+struct TStreamSettings;
+
+///
+/// \brief Задача потокового режима
+///
+struct TStreamOperation
+{
+    static const std::size_t MaxInputs = 6;     ///< Наибольшее число чисел в записи
+    static const std::size_t MaxOutputs = 3;    ///< Наибольшее число чисел в результате
+
+    ///
+    /// \brief Решение блока записей
+    /// \param[in]  settings - настройки потокового режима
+    /// \param[in]  count    - число записей
+    /// \param[in]  in       - столбцы входных чисел (inputs массивов по count чисел)
+    /// \param[out] out      - столбцы результатов (outputs массивов по count чисел)
+    ///
+    typedef void ( *TSolve )( const TStreamSettings &settings, std::size_t count, const double *const *in,
+        double *const *out );
+
+    const char *Name;       ///< Имя задачи (совпадает с ключом разового решения, например "geo2rad")
+    std::size_t Inputs;     ///< Число чисел в записи
+    std::size_t Outputs;    ///< Число чисел в результате
+    TSolve Solve;           ///< Решение блока записей
+};
+
+///
+/// \brief Поиск задачи потокового режима по имени
+/// \param[in] name - имя задачи
+/// \return Указатель на задачу или nullptr, если задача не поддерживается в потоковом режиме
+///
+const TStreamOperation *FindStreamOperation( const std::string &name );
+
+///
+/// \brief Имена задач потокового режима через запятую (для справки)
+///
+std::string StreamOperationNames();
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Формат ввода и вывода потокового режима
+///
+enum TStreamFormat : int
+{
+    SF_Text = 0,    ///< Текст: запись на строку
+    SF_Binary = 1   ///< Двоичный столбцовый формат (см. columnar.h)
+};
+
+///
+/// \brief Настройки потокового режима
+///
+struct TStreamSettings
+{
+    const TStreamOperation *Operation;          ///< Решаемая задача
+    SPML::Geodesy::CEllipsoid Ellipsoid;        ///< Земной эллипсоид
+    SPML::Units::TRangeUnit RangeUnit;          ///< Единицы измерения дальности
+    SPML::Units::TAngleUnit AngleUnit;          ///< Единицы измерения углов
+    int Precision;                              ///< Число цифр после запятой в результатах
+    TStreamFormat InputFormat = SF_Text;        ///< Формат ввода
+    TStreamFormat OutputFormat = SF_Text;       ///< Формат вывода
+    bool Convert = false;                       ///< Перевод формата без решения задачи
+    TColumnarKind Kind = CK_Records;            ///< Содержимое при переводе формата: записи или результаты задачи
+    SPML::Geodesy::TGeodeticDatum From = SPML::Geodesy::GD_WGS84;   ///< Исходный датум задачи bw
+    SPML::Geodesy::TGeodeticDatum To = SPML::Geodesy::GD_WGS84;     ///< Конечный датум задачи bw
+};
+
+///
+/// \brief Проверка настроек потокового режима
+/// \details Задача задана, эллипсоид верен (большая полуось больше 0, обратное сжатие 0 или больше 1), для задачи bw
+/// заданы параметры перевода между датумами (кроме перевода формата)
+/// \param[in] settings - настройки потокового режима
+/// \return true, если с настройками можно решать задачу
+///
+bool CheckStreamSettings( const TStreamSettings &settings );
+
+///
+/// \brief Обработчик записей потокового режима
+/// \details Строки передаются по одной (Line) или столбцами (Columns), записи накапливаются в блок и решаются при
+/// заполнении блока или вызове Flush, результаты дописываются в Output в порядке ввода: строками или блоками
+/// двоичного столбцового формата (без заголовка). Пустые строки и строки, начинающиеся с '#', пропускаются
+/// (результат не выводится). Результат строки с неверным числом чисел - "nan", сообщение с номером строки - в stderr.
+/// При переводе формата (Convert) результат - сами записи
+///
+class CStreamProcessor
+{
+public:
+    static const std::size_t BlockSize = 4096;  ///< Число записей в блоке
+
+    ///
+    /// \brief Приемник результатов блока
+    /// \param[in] results - Outputs() столбцов результатов
+    /// \param[in] first   - номер первой записи блока среди записей обработчика (с 0)
+    /// \param[in] count   - число записей блока
+    ///
+    typedef std::function<void( const double *const *results, std::size_t first, std::size_t count )> TResultSink;
+
+    ///
+    /// \brief Параметрический конструктор
+    /// \param[in] settings - настройки потокового режима
+    ///
+    explicit CStreamProcessor( const TStreamSettings &settings );
+
+    ///
+    /// \brief Обработка одной строки ввода
+    /// \param[in] begin - начало строки
+    /// \param[in] end   - конец строки (без символа '\n')
+    ///
+    void Line( const char *begin, const char *end );
+
+    ///
+    /// \brief Обработка записей, заданных столбцами
+    /// \param[in] columns - Inputs() массивов по count чисел
+    /// \param[in] count   - число записей
+    ///
+    void Columns( const double *const *columns, std::size_t count );
+
+    ///
+    /// \brief Решение накопленных записей и вывод их результатов в Output
+    ///
+    void Flush();
+
+    ///
+    /// \brief Передача результатов блоков приемнику вместо Output
+    /// \details Например, для записи результатов по месту в файл, отображенный в память
+    /// \param[in] resultSink - приемник результатов
+    ///
+    void SetResultSink( TResultSink resultSink )
+    {
+        sink = std::move( resultSink );
+    }
+
+    ///
+    /// \brief Учет строк, прочитанных до первой переданной строки
+    /// \details При обработке части файла номера строк в сообщениях об ошибках остаются номерами строк файла
+    /// \param[in] count - число строк
+    ///
+    void AddLines( std::size_t count )
+    {
+        lines += count;
+    }
+
+    ///
+    /// \brief Накопленный текст результатов (вызывающий выводит и очищает его)
+    ///
+    CTextBuffer &Output()
+    {
+        return output;
+    }
+
+    ///
+    /// \brief Число чисел в записи
+    ///
+    std::size_t Inputs() const
+    {
+        return inputs;
+    }
+
+    ///
+    /// \brief Число чисел в результате
+    ///
+    std::size_t Outputs() const
+    {
+        return outputs;
+    }
+
+    ///
+    /// \brief Число обработанных записей (без пропущенных строк)
+    ///
+    std::size_t Records() const
+    {
+        return records;
+    }
+
+    ///
+    /// \brief Число строк с неверным вводом
+    ///
+    std::size_t Errors() const
+    {
+        return errors;
+    }
+
+private:
+    TStreamSettings settings;                                       // Настройки
+    std::size_t inputs;                                             // Число чисел в записи
+    std::size_t outputs;                                            // Число чисел в результате
+    std::vector<double> in[TStreamOperation::MaxInputs];            // Столбцы входных чисел блока
+    std::vector<double> out[TStreamOperation::MaxOutputs];          // Столбцы результатов блока
+    std::vector<char> valid;                                        // Признаки верного ввода записей блока
+    std::size_t count = 0;                                          // Число записей в блоке
+    std::size_t lines = 0;                                          // Число строк ввода
+    std::size_t records = 0;                                        // Число записей
+    std::size_t errors = 0;                                         // Число строк с неверным вводом
+    CTextBuffer output;                                             // Текст результатов
+    TResultSink sink;                                               // Приемник результатов вместо output
+};
+
+///
+/// \brief Проверка соответствия заголовка двоичного ввода задаче
+/// \param[in] header   - заголовок файла ввода
+/// \param[in] settings - настройки потокового режима
+/// \param[in] inputs   - число чисел в записи обработчика (CStreamProcessor::Inputs)
+/// \return true, если задача, содержимое и число столбцов файла совпадают с ожидаемыми
+///
+bool MatchColumnarInput( const TColumnarHeader &header, const TStreamSettings &settings, std::size_t inputs );
+
+///
+/// \brief Заголовок двоичного вывода
+/// \param[in] settings - настройки потокового режима (единицы и эллипсоид - как у решаемых записей)
+/// \param[in] outputs  - число чисел в результате обработчика (CStreamProcessor::Outputs)
+/// \param[in] count    - число записей (TColumnarHeader::UnknownCount - не известно)
+/// \return Заголовок
+///
+TColumnarHeader OutputColumnarHeader( const TStreamSettings &settings, std::size_t outputs,
+    std::uint64_t count = TColumnarHeader::UnknownCount );
+
+///
+/// \brief Потоковая обработка: чтение записей из in до конца файла, вывод результатов в out
+/// \details Ввод читается блоками по 1 МБ, вывод накапливается и записывается блоками того же размера. Для
+/// двоичного ввода задача в заголовке должна совпадать с settings.Operation, единицы измерения и эллипсоид берутся
+/// из заголовка. Двоичный вывод начинается с заголовка, число записей в нем записывается по окончании, если файл
+/// вывода допускает перемещение позиции
+/// \param[in] in       - файл ввода (например, stdin)
+/// \param[in] out      - файл вывода (например, stdout)
+/// \param[in] settings - настройки потокового режима
+/// \return EXIT_SUCCESS, если все строки обработаны без ошибок и вывод записан, иначе EXIT_FAILURE (ошибка записи
+/// вывода, например при заполнении диска, сообщается в stderr)
+///
+int RunStream( std::FILE *in, std::FILE *out, const TStreamSettings &settings );
+
+} // end namespace GeoCalc
+#endif // GEOCALC_STREAM_H
+/// \}
@@ -0,0 +1,291 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       columnar.cpp
+/// \brief      Двоичный столбцовый формат записей и результатов geocalc
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup geocalc
+/// \{
+///
+
+#include <columnar.h>
+
+// System includes:
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace GeoCalc /// Геодезический калькулятор
+{
+//----------------------------------------------------------------------------------------------------------------------
+static const char columnarMagic[8] = { 'G', 'E', 'O', 'C', 'O', 'L', 'v', '1' };
+static const std::uint32_t columnarVersion = 1;
+static const std::size_t countOffset = 56; // Смещение числа записей в заголовке
+static const unsigned char customEllipsoid = 0xFF; // Эллипсоид не из реестра
+
+// Порядок байт little-endian независимо от порядка байт процессора
+static void PutU64( char *bytes, std::uint64_t value, std::size_t size = 8 )
+{
+    for( std::size_t i = 0; i < size; i++ ) {
+        bytes[i] = static_cast<char>( ( value >> ( 8 * i ) ) & 0xFF );
+    }
+}
+
+static std::uint64_t GetU64( const char *bytes, std::size_t size = 8 )
+{
+    std::uint64_t value = 0;
+    for( std::size_t i = 0; i < size; i++ ) {
+        value |= static_cast<std::uint64_t>( static_cast<unsigned char>( bytes[i] ) ) << ( 8 * i );
+    }
+    return value;
+}
+
+static void PutF64( char *bytes, double value )
+{
+    std::uint64_t bits;
+    std::memcpy( &bits, &value, sizeof( bits ) );
+    PutU64( bytes, bits );
+}
+
+static double GetF64( const char *bytes )
+{
+    const std::uint64_t bits = GetU64( bytes );
+    double value;
+    std::memcpy( &value, &bits, sizeof( value ) );
+    return value;
+}
+
+// Строка поля фиксированной длины (дополняется нулями, может не иметь завершающего нуля)
+static void PutString( char *bytes, const std::string &value, std::size_t size )
+{
+    std::memset( bytes, 0, size );
+    std::memcpy( bytes, value.data(), std::min( value.size(), size ) );
+}
+
+static std::string GetString( const char *bytes, std::size_t size )
+{
+    return std::string( bytes, std::find( bytes, bytes + size, '\0' ) );
+}
+
+// Идентификатор эллипсоида реестра с тем же именем и параметрами или customEllipsoid
+static unsigned char EllipsoidId( const SPML::Geodesy::CEllipsoid &ellipsoid )
+{
+    for( int id = 0; id < SPML::Geodesy::EL_Count; id++ ) {
+        const SPML::Geodesy::TEllipsoidParams &params =
+            SPML::Geodesy::EllipsoidParams( static_cast<SPML::Geodesy::TEllipsoidId>( id ) );
+        if( ( params.name == ellipsoid.Name() ) && ( params.a == ellipsoid.A() ) &&
+            ( params.invf == ellipsoid.Invf() ) ) {
+            return static_cast<unsigned char>( id );
+        }
+    }
+    return customEllipsoid;
+}
+
+static bool IsLittleEndian()
+{
+    const std::uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy( &first, &probe, 1 );
+    return first == 1;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void EncodeColumnarHeader( const TColumnarHeader &header, char *bytes )
+{
+    std::memset( bytes, 0, TColumnarHeader::Size );
+    std::memcpy( bytes, columnarMagic, sizeof( columnarMagic ) );
+    PutU64( bytes + 8, columnarVersion, 4 );
+    PutU64( bytes + 12, header.BlockSize, 4 );
+    PutString( bytes + 16, header.Operation, 16 );
+    bytes[32] = static_cast<char>( EllipsoidId( header.Ellipsoid ) );
+    bytes[48] = static_cast<char>( header.Kind );
+    bytes[49] = static_cast<char>( header.Columns );
+    bytes[50] = static_cast<char>( header.RangeUnit );
+    bytes[51] = static_cast<char>( header.AngleUnit );
+    bytes[52] = static_cast<char>( header.From );
+    bytes[53] = static_cast<char>( header.To );
+    PutU64( bytes + countOffset, header.Count );
+    PutF64( bytes + 64, header.Ellipsoid.A() );
+    PutF64( bytes + 72, header.Ellipsoid.Invf() );
+}
+
+bool ReadColumnarHeader( std::FILE *file, TColumnarHeader &header, std::string &error )
+{
+    char bytes[TColumnarHeader::Size];
+    if( std::fread( bytes, 1, sizeof( bytes ), file ) != sizeof( bytes ) ) {
+        error = "файл короче заголовка/file is shorter than header";
+        return false;
+    }
+    return DecodeColumnarHeader( bytes, header, error );
+}
+
+bool DecodeColumnarHeader( const char *bytes, TColumnarHeader &header, std::string &error )
+{
+    if( std::memcmp( bytes, columnarMagic, sizeof( columnarMagic ) ) != 0 ) {
+        error = "не столбцовый файл geocalc/not a geocalc columnar file";
+        return false;
+    }
+    if( GetU64( bytes + 8, 4 ) != columnarVersion ) {
+        error = "неподдерживаемая версия формата/unsupported format version";
+        return false;
+    }
+    header.BlockSize = static_cast<std::uint32_t>( GetU64( bytes + 12, 4 ) );
+    header.Operation = GetString( bytes + 16, 16 );
+    const unsigned char kind = static_cast<unsigned char>( bytes[48] );
+    header.Columns = static_cast<unsigned char>( bytes[49] );
+    const unsigned char rangeUnit = static_cast<unsigned char>( bytes[50] );
+    const unsigned char angleUnit = static_cast<unsigned char>( bytes[51] );
+    const unsigned char from = static_cast<unsigned char>( bytes[52] );
+    const unsigned char to = static_cast<unsigned char>( bytes[53] );
+    header.Count = GetU64( bytes + countOffset );
+    if( ( header.BlockSize == 0 ) || ( header.BlockSize > TColumnarHeader::MaxBlockSize ) || ( header.Columns == 0 ) ||
+        ( kind > CK_Results ) || ( rangeUnit > SPML::Units::RU_Kilometer ) || ( angleUnit > SPML::Units::AU_Degree ) ||
+        ( from >= SPML::Geodesy::GD_Count ) || ( to >= SPML::Geodesy::GD_Count ) ) {
+        error = "неверный заголовок/wrong header";
+        return false;
+    }
+    header.Kind = static_cast<TColumnarKind>( kind );
+    header.RangeUnit = static_cast<SPML::Units::TRangeUnit>( rangeUnit );
+    header.AngleUnit = static_cast<SPML::Units::TAngleUnit>( angleUnit );
+    header.From = static_cast<SPML::Geodesy::TGeodeticDatum>( from );
+    header.To = static_cast<SPML::Geodesy::TGeodeticDatum>( to );
+
+    // Эллипсоид реестра должен совпадать с параметрами заголовка, иначе файл записан с другим реестром
+    const unsigned char ellipsoid = static_cast<unsigned char>( bytes[32] );
+    const double a = GetF64( bytes + 64 );
+    const double invf = GetF64( bytes + 72 );
+    if( ellipsoid == customEllipsoid ) {
+        // Параметры эллипсоида не из реестра - из файла или сокета: неверные дали бы nan во всех результатах
+        if( !std::isfinite( a ) || ( a <= 0.0 ) || !std::isfinite( invf ) || ( invf < 0.0 ) ) {
+            error = "неверный заголовок/wrong header";
+            return false;
+        }
+        header.Ellipsoid = SPML::Geodesy::CEllipsoid( "", a, 0.0, invf, true );
+        return true;
+    }
+    const SPML::Geodesy::CEllipsoid *registered = ( ellipsoid < SPML::Geodesy::EL_Count ) ?
+        &SPML::Geodesy::Ellipsoids::Get( static_cast<SPML::Geodesy::TEllipsoidId>( ellipsoid ) ) : nullptr;
+    if( ( registered == nullptr ) || ( registered->A() != a ) || ( registered->Invf() != invf ) ) {
+        error = "неверный заголовок/wrong header";
+        return false;
+    }
+    header.Ellipsoid = *registered;
+    return true;
+}
+
+bool ReadColumnarBlock( std::FILE *file, const TColumnarHeader &header, std::uint64_t read, double *const *columns,
+    std::size_t &count, std::string &error )
+{
+    // Полный блок, последний блок файла с известным числом записей - меньше
+    std::size_t expected = header.BlockSize;
+    if( ( header.Count != TColumnarHeader::UnknownCount ) && ( header.Count - read < expected ) ) {
+        expected = static_cast<std::size_t>( header.Count - read );
+    }
+    count = 0;
+    if( expected == 0 ) {
+        return true;
+    }
+
+    // Числа записей последнего блока файла без числа записей: по числу байт до конца файла
+    static thread_local std::vector<char> bytes;
+    const std::size_t recordSize = 8 * header.Columns;
+    bytes.resize( expected * recordSize );
+    const std::size_t size = std::fread( bytes.data(), 1, bytes.size(), file );
+    if( ( size % recordSize != 0 ) ||
+        ( ( header.Count != TColumnarHeader::UnknownCount ) && ( size != bytes.size() ) ) ) {
+        error = "файл обрывается внутри блока/file ends inside a block";
+        return false;
+    }
+    count = size / recordSize;
+    for( std::size_t c = 0; c < header.Columns; c++ ) {
+        DecodeColumn( bytes.data() + c * count * 8, count, columns[c] );
+    }
+    return true;
+}
+
+void DecodeColumn( const char *bytes, std::size_t count, double *column )
+{
+    if( IsLittleEndian() ) {
+        std::memcpy( column, bytes, count * 8 );
+    } else {
+        for( std::size_t i = 0; i < count; i++ ) {
+            column[i] = GetF64( bytes + i * 8 );
+        }
+    }
+}
+
+void EncodeColumn( const double *column, std::size_t count, char *bytes )
+{
+    if( IsLittleEndian() ) {
+        std::memcpy( bytes, column, count * 8 );
+    } else {
+        for( std::size_t i = 0; i < count; i++ ) {
+            PutF64( bytes + i * 8, column[i] );
+        }
+    }
+}
+
+std::uint64_t ColumnarOffset( std::uint32_t blockSize, std::size_t columns, std::uint64_t count, std::uint64_t record,
+    std::size_t column )
+{
+    const std::uint64_t block = record / blockSize;
+    const std::uint64_t first = block * blockSize; // Первая запись блока
+    const std::uint64_t inBlock = std::min<std::uint64_t>( blockSize, count - first );
+    return TColumnarHeader::Size + 8 * ( first * columns + column * inBlock + ( record - first ) );
+}
+
+// Вызов func( done, record, n ) для частей [record, record + n) записей [first, first + count), числа столбцов
+// которых идут в файле подряд (до конца блока); done - число записей до части
+template<typename TFunc>
+static void ForEachRun( std::uint32_t blockSize, std::uint64_t first, std::size_t count, TFunc func )
+{
+    for( std::size_t done = 0; done < count; ) {
+        const std::uint64_t record = first + done;
+        const std::uint64_t blockEnd = ( record / blockSize + 1 ) * blockSize;
+        const std::size_t n = static_cast<std::size_t>( std::min<std::uint64_t>( count - done, blockEnd - record ) );
+        func( done, record, n );
+        done += n;
+    }
+}
+
+void DecodeRecords( const char *bytes, const TColumnarHeader &header, std::uint64_t first, std::size_t count,
+    double *const *columns )
+{
+    ForEachRun( header.BlockSize, first, count, [&]( std::size_t done, std::uint64_t record, std::size_t n ) {
+        for( std::size_t i = 0; i < header.Columns; i++ ) {
+            DecodeColumn( bytes + ColumnarOffset( header.BlockSize, header.Columns, header.Count, record, i ), n,
+                columns[i] + done );
+        }
+    } );
+}
+
+void EncodeRecords( const double *const *columns, const TColumnarHeader &header, std::uint64_t first,
+    std::size_t count, char *bytes )
+{
+    ForEachRun( header.BlockSize, first, count, [&]( std::size_t done, std::uint64_t record, std::size_t n ) {
+        for( std::size_t i = 0; i < header.Columns; i++ ) {
+            EncodeColumn( columns[i] + done, n,
+                bytes + ColumnarOffset( header.BlockSize, header.Columns, header.Count, record, i ) );
+        }
+    } );
+}
+
+bool PatchColumnarCount( std::FILE *file, long start, std::uint64_t count )
+{
+    if( start < 0 ) {
+        return false;
+    }
+    char bytes[8];
+    PutU64( bytes, count );
+    std::fflush( file );
+    const long end = std::ftell( file );
+    if( ( end < 0 ) || ( std::fseek( file, start + static_cast<long>( countOffset ), SEEK_SET ) != 0 ) ) {
+        return false;
+    }
+    const bool written = std::fwrite( bytes, 1, sizeof( bytes ), file ) == sizeof( bytes );
+    std::fseek( file, end, SEEK_SET );
+    return written;
+}
+
+} // end namespace GeoCalc
+/// \}
@@ -15,11 +15,18 @@
 #include <iomanip>
 #include <vector>
 #include <algorithm>
+#include <type_traits>
+#include <utility>
 #include <boost/program_options.hpp>
 
 // SPML includes:
 #include <spml.h>
 
+// GEOCALC includes:
+#include <mapped.h>
+#include <serve.h>
+#include <stream.h>
+
 //----------------------------------------------------------------------------------------------------------------------
 ///
 /// \brief Возвращает строку, содержащую информацию о версии
@@ -37,10 +44,13 @@ static std::string GetVersion()
 template <typename T>
 std::string to_string_with_precision( const T a_value, const int n = 6 )
 {
-    std::ostringstream out;
-    out.precision(n);
-    out << std::fixed << a_value;
-    return out.str();
+    if constexpr( std::is_integral<T>::value ) { // Целые печатаются без знаков после запятой (как std::fixed)
+        return std::to_string( a_value );
+    } else {
+        GeoCalc::CTextBuffer text;
+        text.Append( static_cast<double>( a_value ), n );
+        return std::string( text.Data(), text.Size() );
+    }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -52,7 +62,7 @@ struct CCoordCalcSettings
     int Precision;                          ///< Число цифр после запятой при печати в консоль результата
     SPML::Units::TAngleUnit AngleUnit;    ///< Единицы измерения углов
     SPML::Units::TRangeUnit RangeUnit;    ///< Единицы измерения дальностей
-    int EllipsoidNumber;                    ///< Эллипсоид на котором решаем геодезические задачи
+    SPML::Geodesy::TEllipsoidId EllipsoidNumber; ///< Эллипсоид на котором решаем геодезические задачи
     std::vector<double> Input;              ///< Входной массив
     std::string From;
     std::string To;
@@ -65,39 +75,73 @@ struct CCoordCalcSettings
         Precision = 6;
         AngleUnit = SPML::Units::TAngleUnit::AU_Degree;
         RangeUnit = SPML::Units::TRangeUnit::RU_Kilometer;
-        EllipsoidNumber = 0;
+        EllipsoidNumber = SPML::Geodesy::TEllipsoidId::EL_WGS84;
         Input.clear();
         From.clear();
         To.clear();
     }
 };
 
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Печать статистики итераций формул Винсента (см. vincenty_stats.h)
+/// \param[in] out - поток вывода
+///
+static void PrintVincentyStats( std::ostream &out )
+{
+    if( !SPML::Geodesy::VincentyStatsEnabled() ) {
+        out << "Статистика итераций Винсента не собирается (сборка без SPML_VINCENTY_STATS)/Vincenty iteration "
+            "statistics are not collected (built without SPML_VINCENTY_STATS)" << std::endl;
+        return;
+    }
+    const SPML::Geodesy::TVincentyStats stats = SPML::Geodesy::GetVincentyStats();
+    const std::pair<const char *, const SPML::Geodesy::TVincentyLoopStats *> loops[] = {
+        { "inverse (GEOtoRAD)", &stats.Inverse }, { "direct (RADtoGEO)", &stats.Direct } };
+    for( const auto &loop : loops ) {
+        const SPML::Geodesy::TVincentyLoopStats &s = *loop.second;
+        out << "Vincenty " << loop.first << ": calls " << s.Calls << ", not converged " << s.NotConverged <<
+            ", coincident points " << s.Coincident << std::endl;
+        for( unsigned bin = 0; bin < SPML::Geodesy::VincentyHistogramBins; bin++ ) {
+            if( s.Histogram[bin] == 0 ) {
+                continue;
+            }
+            const unsigned low = SPML::Geodesy::VincentyHistogramBinLow( bin );
+            out << "  iterations " << low;
+            if( bin + 1 == SPML::Geodesy::VincentyHistogramBins ) {
+                out << "+";
+            } else if( SPML::Geodesy::VincentyHistogramBinLow( bin + 1 ) > low + 1 ) {
+                out << "-" << SPML::Geodesy::VincentyHistogramBinLow( bin + 1 ) - 1;
+            }
+            out << ": " << s.Histogram[bin] << std::endl;
+        }
+    }
+}
+
+///
+/// \brief Печать статистики итераций формул Винсента в stderr при выходе из main (параметр --vincenty-stats)
+///
+struct CVincentyStatsPrinter
+{
+    bool Enabled = false; ///< Печатать статистику
+
+    ~CVincentyStatsPrinter()
+    {
+        if( Enabled ) {
+            PrintVincentyStats( std::cerr );
+        }
+    }
+};
+
 //----------------------------------------------------------------------------------------------------------------------
 
 int DetermineGeodeticDatum( std::string str, SPML::Geodesy::TGeodeticDatum &gd )
 {
-    if( str == "wgs84" ) {
-        gd = SPML::Geodesy::TGeodeticDatum::GD_WGS84;
-    } else if( str == "pz90" ) {
-        gd = SPML::Geodesy::TGeodeticDatum::GD_PZ90;
-    } else if( str == "pz9002" ) {
-        gd = SPML::Geodesy::TGeodeticDatum::GD_PZ9002;
-    } else if( str == "pz9011" ) {
-        gd = SPML::Geodesy::TGeodeticDatum::GD_PZ9011;
-    } else if( str == "sk95" ) {
-        gd = SPML::Geodesy::TGeodeticDatum::GD_SK95;
-    } else if( str == "sk42" ) {
-        gd = SPML::Geodesy::TGeodeticDatum::GD_SK42;
-    } else if( str == "gsk2011" ) {
-        gd = SPML::Geodesy::TGeodeticDatum::GD_GSK2011;
-    } else if( str == "itrf2008" ) {
-        gd = SPML::Geodesy::TGeodeticDatum::GD_ITRF2008;
-    } else if( str == "agd66" ) {
-        gd = SPML::Geodesy::TGeodeticDatum::GD_AGD66;
-    } else {
+    const SPML::Geodesy::TDatumParams *datum = SPML::Geodesy::FindDatum( str );
+    if( datum == nullptr ) {
         std::cout << "Неверный ввод, смотри --help/Wrong input, read --help" << std::endl;
         return EXIT_FAILURE;
     }
+    gd = datum->datum;
     return EXIT_SUCCESS;
 }
 
@@ -111,7 +155,7 @@ int DetermineGeodeticDatum( std::string str, SPML::Geodesy::TGeodeticDatum &gd )
 int main( int argc, char *argv[] )
 {
     CCoordCalcSettings settings; // Параметры приложения
-    auto ellipsoids = SPML::Geodesy::Ellipsoids::GetPredefinedEllipsoids(); // Используемые эллипсоиды
+    const auto &ellipsoids = SPML::Geodesy::Ellipsoids::GetPredefinedEllipsoids(); // Используемые эллипсоиды
     //------------------------------------------------------------------------------------------------------------------
     // Зададим параметры запуска приложения
     namespace po = boost::program_options;
@@ -133,10 +177,35 @@ int main( int argc, char *argv[] )
     ( "me", "Вход в метрах/Input in meters" )
     // Единицы выхода дальности/углов
     // На каком эллипсоиде считать
-    ( "el", po::value<std::string>()->default_value( "wgs84" ), "Доступные эллипсоиды/Avaliable ellipsoids: wgs84, grs80, pz90, krasovsky1940, sphere6371, sphere6378" )
+    ( "el", po::value<std::string>()->default_value( "wgs84" ), "Доступные эллипсоиды/Avaliable ellipsoids: wgs84, grs80, pz90, krasovsky1940, sphere6371, sphere6378, "
+        "spherekrasovsky1940, agd66, gsk2011" )
     ( "els", "Показать список доступных эллипсоидов и их параметры" )
     // Проверка
     ( "check", "Проверка решением обратной задачи/Check by solving inverse task" )    
+    // Потоковый режим
+    ( "stream", po::value<std::string>(), ( "Потоковый режим: решать задачу для записей из stdin или --input, по одной "
+        "записи на строку, результаты - по строке в stdout или --output/Stream mode: solve the task for records from "
+        "stdin or --input, one record per line, one result line per record to stdout or --output. Tasks: " +
+        GeoCalc::StreamOperationNames() ).c_str() )
+    ( "input", po::value<std::string>(), "Файл записей для --stream/Records file for --stream" )
+    ( "output", po::value<std::string>(), "Файл результатов для --stream/Results file for --stream" )
+    ( "binary-in", "Ввод --stream в двоичном столбцовом формате (единицы и эллипсоид - из файла)/"
+        "--stream input in binary columnar format (units and ellipsoid are taken from the file)" )
+    ( "binary-out", "Вывод --stream в двоичном столбцовом формате/--stream output in binary columnar format" )
+    ( "convert", po::value<std::string>()->implicit_value( "records" ), "Перевод --stream между текстом и двоичным "
+        "форматом без решения: records - записи задачи, results - результаты (--pr -1 - без потери точности)/"
+        "Convert --stream between text and binary format without solving: records or results (--pr -1 - lossless)" )
+    ( "mmap", "Обработка --stream из файла --input в файл --output частями в нескольких потоках через отображение "
+        "файлов в память/Process --stream from --input file to --output file in chunks on several threads via "
+        "memory-mapped files" )
+    ( "threads", po::value<unsigned>()->default_value( 0 ), "Число потоков --mmap и --serve (0 - по числу ядер)/"
+        "Number of --mmap and --serve threads (0 - number of cores)" )
+    ( "serve", po::value<std::string>(), "Сервер: решать пакеты записей задач --stream, присланные на локальный сокет "
+        "PATH (протокол - см. serve.h), до SIGINT/SIGTERM/Server: solve batches of --stream task records sent to the "
+        "Unix domain socket PATH (protocol: see serve.h) until SIGINT/SIGTERM" )
+    ( "vincenty-stats", "Напечатать в stderr при выходе статистику итераций формул Винсента (гистограмма числа "
+        "итераций, выходы без сходимости и для совпадающих точек)/Print Vincenty iteration statistics to stderr on exit "
+        "(iteration count histogram, non-convergence and coincident-point exits)" )
     // Задачи:
     //------------------------------------------------------------------------------------------------------------------
     ( "geo2rad", po::value<std::vector<double>>( &settings.Input )->multitoken(),
@@ -213,6 +282,8 @@ int main( int argc, char *argv[] )
     if( vm.count( "pr" ) ) {
         settings.Precision = vm["pr"].as<int>();
     }
+    CVincentyStatsPrinter vincentyStats; // Печать статистики при любом выходе из main
+    vincentyStats.Enabled = vm.count( "vincenty-stats" ) != 0;
     //------------------------------------------------------------------------------------------------------------------
     // Единицы углов
     if( vm.count( "deg" ) ) {
@@ -251,24 +322,12 @@ int main( int argc, char *argv[] )
     // Эллипсоид
     if( vm.count( "el" ) ) {
         std::string elName = vm["el"].as<std::string>();
-        if( elName == "wgs84" ) {
-            settings.EllipsoidNumber = 0;
-        } else if( elName == "grs80" ) {
-            settings.EllipsoidNumber = 1;
-        } else if( elName == "pz90" ) {
-            settings.EllipsoidNumber = 2;
-        } else if( elName == "krasovsky1940" ) {
-            settings.EllipsoidNumber = 3;
-        } else if( elName == "sphere6371" ) {
-            settings.EllipsoidNumber = 4;
-        } else if( elName == "sphere6378" ) {
-            settings.EllipsoidNumber = 5;
-        } else if( elName == "spherekrasovsky1940" ) {
-            settings.EllipsoidNumber = 6;
-        } else {
+        const SPML::Geodesy::TEllipsoidParams *el = SPML::Geodesy::FindEllipsoid( elName );
+        if( el == nullptr ) {
             std::cout << "Неверный ввод, смотри --help/Wrong input, read --help" << std::endl;
             return EXIT_FAILURE;
         }
+        settings.EllipsoidNumber = el->id;
     }
     if( vm.count( "els" ) ) {
         std::string ellipsoidsString;
@@ -284,6 +343,57 @@ int main( int argc, char *argv[] )
         return EXIT_SUCCESS;
     }
     //------------------------------------------------------------------------------------------------------------------
+    // Сервер
+    if( vm.count( "serve" ) ) {
+        return GeoCalc::RunServe( vm["serve"].as<std::string>(), vm["threads"].as<unsigned>() );
+    }
+    //------------------------------------------------------------------------------------------------------------------
+    // Потоковый режим
+    if( vm.count( "stream" ) ) {
+        GeoCalc::TStreamSettings streamSettings{ GeoCalc::FindStreamOperation( vm["stream"].as<std::string>() ),
+            ellipsoids.at( settings.EllipsoidNumber ), settings.RangeUnit, settings.AngleUnit, settings.Precision };
+        streamSettings.InputFormat = vm.count( "binary-in" ) ? GeoCalc::SF_Binary : GeoCalc::SF_Text;
+        streamSettings.OutputFormat = vm.count( "binary-out" ) ? GeoCalc::SF_Binary : GeoCalc::SF_Text;
+        streamSettings.Convert = vm.count( "convert" ) != 0;
+        const std::string kind = vm.count( "convert" ) ? vm["convert"].as<std::string>() : "records";
+        streamSettings.Kind = ( kind == "results" ) ? GeoCalc::CK_Results : GeoCalc::CK_Records;
+        if( ( streamSettings.Operation == nullptr ) || ( ( kind != "records" ) && ( kind != "results" ) ) ||
+            ( vm.count( "mmap" ) && ( !vm.count( "input" ) || !vm.count( "output" ) ) ) ) {
+            std::cout << "Неверный ввод, смотри --help/Wrong input, read --help" << std::endl;
+            return EXIT_FAILURE;
+        }
+        // Датумы задачи bw (для двоичного ввода настройки берутся из файла и проверяются при его чтении)
+        if( ( vm.count( "from" ) && ( DetermineGeodeticDatum( vm["from"].as<std::string>(),
+            streamSettings.From ) != EXIT_SUCCESS ) ) || ( vm.count( "to" ) &&
+            ( DetermineGeodeticDatum( vm["to"].as<std::string>(), streamSettings.To ) != EXIT_SUCCESS ) ) ||
+            ( ( streamSettings.InputFormat == GeoCalc::SF_Text ) &&
+            !GeoCalc::CheckStreamSettings( streamSettings ) ) ) {
+            std::cout << "Неверный ввод, смотри --help/Wrong input, read --help" << std::endl;
+            return EXIT_FAILURE;
+        }
+        if( vm.count( "mmap" ) ) {
+            // Пул потоков библиотеки настраивается один раз до обработки
+            SPML::Execution::SetPoolThreads( vm["threads"].as<unsigned>() );
+            return GeoCalc::RunMapped( vm["input"].as<std::string>(), vm["output"].as<std::string>(),
+                streamSettings );
+        }
+        std::FILE *in = vm.count( "input" ) ? std::fopen( vm["input"].as<std::string>().c_str(), "rb" ) : stdin;
+        std::FILE *out = vm.count( "output" ) ? std::fopen( vm["output"].as<std::string>().c_str(), "wb" ) : stdout;
+        if( ( in == nullptr ) || ( out == nullptr ) ) {
+            std::cout << "Не удалось открыть файл/Can't open file" << std::endl;
+            return EXIT_FAILURE;
+        }
+        int result = GeoCalc::RunStream( in, out, streamSettings );
+        if( in != stdin ) {
+            std::fclose( in );
+        }
+        if( ( out != stdout ) && ( std::fclose( out ) != 0 ) && ( result == EXIT_SUCCESS ) ) {
+            std::cerr << "Ошибка записи вывода/Output write error" << std::endl;
+            result = EXIT_FAILURE;
+        }
+        return result;
+    }
+    //------------------------------------------------------------------------------------------------------------------
     // Задачи:
     //------------------------------------------------------------------------------------------------------------------
     if( vm.count( "geo2rad" ) ) {
@@ -0,0 +1,387 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       mapped.cpp
+/// \brief      Параллельная потоковая обработка файлов, отображенных в память
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup geocalc
+/// \{
+///
+
+#include <mapped.h>
+
+// System includes:
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// SPML includes:
+#include <execution.h>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GeoCalc /// Геодезический калькулятор
+{
+#if defined( __unix__ ) || defined( __APPLE__ )
+//----------------------------------------------------------------------------------------------------------------------
+static const std::size_t textChunkSize = 8 << 20; // Размер части текстового ввода, [байт]
+static const std::uint64_t binaryChunkRecords = 16 * CStreamProcessor::BlockSize; // Записей в части двоичного ввода
+static const std::size_t roundChunks = 4; // Частей на поток в группе текстового вывода
+
+// Дескриптор открытого файла
+class CDescriptor
+{
+public:
+    explicit CDescriptor( int fd ) : fd( fd )
+    {
+    }
+
+    CDescriptor( const CDescriptor & ) = delete;
+    CDescriptor &operator=( const CDescriptor & ) = delete;
+
+    ~CDescriptor()
+    {
+        if( fd >= 0 ) {
+            close( fd );
+        }
+    }
+
+    int Get() const
+    {
+        return fd;
+    }
+
+private:
+    int fd;
+};
+
+// Отображение части файла в память
+class CMapping
+{
+public:
+    CMapping() = default;
+    CMapping( const CMapping & ) = delete;
+    CMapping &operator=( const CMapping & ) = delete;
+
+    ~CMapping()
+    {
+        Reset();
+    }
+
+    // Отображение size байт файла fd с позиции offset (запись - с сохранением в файл)
+    bool Map( int fd, std::uint64_t offset, std::size_t size, bool writable )
+    {
+        Reset();
+        if( size == 0 ) {
+            return true;
+        }
+        const std::uint64_t page = static_cast<std::uint64_t>( sysconf( _SC_PAGESIZE ) );
+        shift = static_cast<std::size_t>( offset % page ); // Начало отображения - на границе страницы
+        length = size + shift;
+        void *address = mmap( nullptr, length, writable ? ( PROT_READ | PROT_WRITE ) : PROT_READ,
+            writable ? MAP_SHARED : MAP_PRIVATE, fd, static_cast<off_t>( offset - shift ) );
+        if( address == MAP_FAILED ) {
+            return false;
+        }
+        base = static_cast<char *>( address );
+        madvise( base, length, MADV_SEQUENTIAL );
+        return true;
+    }
+
+    char *Data() const
+    {
+        return base + shift;
+    }
+
+    void Reset()
+    {
+        if( base != nullptr ) {
+            munmap( base, length );
+            base = nullptr;
+        }
+        shift = 0;
+    }
+
+private:
+    char *base = nullptr;       // Начало отображения
+    std::size_t length = 0;     // Длина отображения
+    std::size_t shift = 0;      // Смещение запрошенной позиции от начала отображения
+};
+
+// Выделение места на диске под size байт файла (размер файла становится не меньше size). Без выделения запись в
+// отображение разреженного файла при заполнении диска завершается сигналом SIGBUS, а не ошибкой
+static int ReserveFile( int fd, std::uint64_t size )
+{
+    if( size == 0 ) {
+        return 0;
+    }
+#if defined( __APPLE__ )
+    fstore_t store = { F_ALLOCATEALL, F_PEOFPOSMODE, 0, static_cast<off_t>( size ), 0 };
+    if( fcntl( fd, F_PREALLOCATE, &store ) != 0 ) {
+        return errno;
+    }
+    return ( ftruncate( fd, static_cast<off_t>( size ) ) == 0 ) ? 0 : errno;
+#else
+    return posix_fallocate( fd, 0, static_cast<off_t>( size ) );
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Часть ввода: строки текста [Begin, End) или записи двоичного файла [FirstRecord, FirstRecord + Records)
+struct TChunk
+{
+    const char *Begin = nullptr;    // Начало текста
+    const char *End = nullptr;      // Конец текста
+    std::size_t FirstLine = 0;      // Число строк файла до части
+    std::size_t Lines = 0;          // Число строк части
+    std::uint64_t FirstRecord = 0;  // Число записей файла до части
+    std::uint64_t Records = 0;      // Число записей части
+};
+
+// Вызов func( begin, end ) для строк текста (без '\n'), последняя строка может не иметь '\n'
+template<typename TFunc>
+static void ForEachLine( const char *begin, const char *end, TFunc func )
+{
+    while( begin != end ) {
+        const char *newline = static_cast<const char *>( std::memchr( begin, '\n', end - begin ) );
+        func( begin, ( newline != nullptr ) ? newline : end );
+        begin = ( newline != nullptr ) ? newline + 1 : end;
+    }
+}
+
+// Деление текста на части по границам строк с подсчетом строк и записей частей
+static std::vector<TChunk> SplitText( const char *data, std::size_t size, const SPML::Execution::Policy &policy )
+{
+    std::vector<TChunk> chunks;
+    const char *end = data + size;
+    for( const char *begin = data; begin != end; ) {
+        const char *cut = begin + std::min<std::size_t>( textChunkSize, end - begin );
+        const char *newline = static_cast<const char *>( std::memchr( cut - 1, '\n', end - cut + 1 ) );
+        TChunk chunk;
+        chunk.Begin = begin;
+        chunk.End = ( newline != nullptr ) ? newline + 1 : end;
+        chunks.push_back( chunk );
+        begin = chunk.End;
+    }
+    SPML::Execution::ParallelTasks( chunks.size(), policy, [&chunks]( std::size_t task ) {
+        TChunk &chunk = chunks[task];
+        ForEachLine( chunk.Begin, chunk.End, [&chunk]( const char *begin, const char *end ) {
+            chunk.Lines++;
+            chunk.Records += IsRecordLine( begin, end ) ? 1 : 0;
+        } );
+    } );
+    for( std::size_t i = 1; i < chunks.size(); i++ ) {
+        chunks[i].FirstLine = chunks[i - 1].FirstLine + chunks[i - 1].Lines;
+        chunks[i].FirstRecord = chunks[i - 1].FirstRecord + chunks[i - 1].Records;
+    }
+    return chunks;
+}
+
+// Деление записей двоичного файла на части
+static std::vector<TChunk> SplitRecords( std::uint64_t count )
+{
+    std::vector<TChunk> chunks;
+    for( std::uint64_t first = 0; first < count; first += binaryChunkRecords ) {
+        TChunk chunk;
+        chunk.FirstRecord = first;
+        chunk.Records = std::min( binaryChunkRecords, count - first );
+        chunks.push_back( chunk );
+    }
+    return chunks;
+}
+
+// Передача записей части двоичного файла data обработчику
+static void FeedColumns( const char *data, const TColumnarHeader &header, const TChunk &chunk,
+    CStreamProcessor &processor )
+{
+    std::vector<double> storage( header.Columns * CStreamProcessor::BlockSize );
+    double *columns[TStreamOperation::MaxInputs] = {};
+    for( std::size_t i = 0; i < header.Columns; i++ ) {
+        columns[i] = storage.data() + i * CStreamProcessor::BlockSize;
+    }
+    for( std::uint64_t done = 0; done < chunk.Records; done += CStreamProcessor::BlockSize ) {
+        const std::size_t n = static_cast<std::size_t>( std::min<std::uint64_t>( CStreamProcessor::BlockSize,
+            chunk.Records - done ) );
+        DecodeRecords( data, header, chunk.FirstRecord + done, n, columns );
+        processor.Columns( columns, n );
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int RunMapped( const std::string &input, const std::string &output, const TStreamSettings &settings )
+{
+    // Части выполняются пулом потоков библиотеки (execution.h), пул один на все группы частей
+    const SPML::Execution::Policy policy( SPML::Execution::EM_Parallel );
+    CDescriptor in( open( input.c_str(), O_RDONLY ) );
+    struct stat status;
+    if( ( in.Get() < 0 ) || ( fstat( in.Get(), &status ) != 0 ) || !S_ISREG( status.st_mode ) ) {
+        std::fprintf( stderr, "Не удалось открыть файл/Can't open file: %s\n", input.c_str() );
+        return EXIT_FAILURE;
+    }
+    const std::size_t size = static_cast<std::size_t>( status.st_size );
+    CMapping inMapping;
+    if( !inMapping.Map( in.Get(), 0, size, false ) ) {
+        std::fprintf( stderr, "Не удалось отобразить файл в память/Can't map file: %s\n", input.c_str() );
+        return EXIT_FAILURE;
+    }
+    const char *data = inMapping.Data();
+
+    // Части ввода и число записей
+    TStreamSettings current = settings;
+    TColumnarHeader inHeader;
+    std::vector<TChunk> chunks;
+    if( settings.InputFormat == SF_Binary ) {
+        std::string error;
+        if( size < TColumnarHeader::Size ) {
+            error = "файл короче заголовка/file is shorter than header";
+        } else if( DecodeColumnarHeader( data, inHeader, error ) ) {
+            const std::uint64_t recordSize = 8 * inHeader.Columns;
+            const std::uint64_t dataSize = size - TColumnarHeader::Size;
+            if( inHeader.Count == TColumnarHeader::UnknownCount ) {
+                inHeader.Count = dataSize / recordSize;
+            }
+            // Делением, а не умножением: Count * recordSize может переполниться для неверного Count
+            if( ( dataSize % recordSize != 0 ) || ( inHeader.Count != dataSize / recordSize ) ) {
+                error = "файл обрывается внутри блока/file ends inside a block";
+            }
+        }
+        if( !error.empty() ) {
+            std::fprintf( stderr, "%s\n", error.c_str() );
+            return EXIT_FAILURE;
+        }
+        current.RangeUnit = inHeader.RangeUnit;
+        current.AngleUnit = inHeader.AngleUnit;
+        current.Ellipsoid = inHeader.Ellipsoid;
+        current.From = inHeader.From;
+        current.To = inHeader.To;
+        chunks = SplitRecords( inHeader.Count );
+    } else {
+        chunks = SplitText( data, size, policy );
+    }
+    const CStreamProcessor probe( current );
+    if( ( settings.InputFormat == SF_Binary ) &&
+        ( !MatchColumnarInput( inHeader, current, probe.Inputs() ) || !CheckStreamSettings( current ) ) ) {
+        std::fprintf( stderr, "Содержимое файла не соответствует задаче/File contents do not match the task\n" );
+        return EXIT_FAILURE;
+    }
+    const std::uint64_t records = chunks.empty() ? 0 : ( chunks.back().FirstRecord + chunks.back().Records );
+
+    // Обработка части: ввод - из отображения файла ввода, вывод - приемнику или в Output обработчика
+    std::atomic<std::size_t> errors( 0 );
+    const auto process = [&]( const TChunk &chunk, CStreamProcessor &processor ) {
+        if( settings.InputFormat == SF_Binary ) {
+            FeedColumns( data, inHeader, chunk, processor );
+        } else {
+            processor.AddLines( chunk.FirstLine );
+            ForEachLine( chunk.Begin, chunk.End, [&processor]( const char *begin, const char *end ) {
+                processor.Line( begin, end );
+            } );
+        }
+        processor.Flush();
+        errors += processor.Errors();
+    };
+
+    // Файл вывода усекается только после проверки, что это не файл ввода (иначе ввод в отображении теряется)
+    CDescriptor out( open( output.c_str(), O_RDWR | O_CREAT, 0666 ) );
+    struct stat outStatus;
+    if( ( out.Get() < 0 ) || ( fstat( out.Get(), &outStatus ) != 0 ) ) {
+        std::fprintf( stderr, "Не удалось открыть файл/Can't open file: %s\n", output.c_str() );
+        return EXIT_FAILURE;
+    }
+    if( ( outStatus.st_dev == status.st_dev ) && ( outStatus.st_ino == status.st_ino ) ) {
+        std::fprintf( stderr, "Файл вывода совпадает с файлом ввода/Output file is the input file: %s\n",
+            output.c_str() );
+        return EXIT_FAILURE;
+    }
+    if( ftruncate( out.Get(), 0 ) != 0 ) {
+        std::fprintf( stderr, "Не удалось открыть файл/Can't open file: %s\n", output.c_str() );
+        return EXIT_FAILURE;
+    }
+    const auto reserve = [&]( std::uint64_t outSize ) {
+        const int error = ReserveFile( out.Get(), outSize );
+        if( error != 0 ) {
+            std::fprintf( stderr, "Не удалось выделить место для файла/Can't allocate file space: %s: %s\n",
+                output.c_str(), std::strerror( error ) );
+        }
+        return error == 0;
+    };
+    CMapping outMapping;
+    if( settings.OutputFormat == SF_Binary ) {
+        // Размер вывода известен: каждый поток пишет результаты своих записей на их места
+        const TColumnarHeader outHeader = OutputColumnarHeader( current, probe.Outputs(), records );
+        const std::uint64_t outSize = TColumnarHeader::Size + 8 * probe.Outputs() * records;
+        if( !reserve( outSize ) ) {
+            return EXIT_FAILURE;
+        }
+        if( !outMapping.Map( out.Get(), 0, static_cast<std::size_t>( outSize ), true ) ) {
+            std::fprintf( stderr, "Не удалось отобразить файл в память/Can't map file: %s\n", output.c_str() );
+            return EXIT_FAILURE;
+        }
+        char *outData = outMapping.Data();
+        EncodeColumnarHeader( outHeader, outData );
+        SPML::Execution::ParallelTasks( chunks.size(), policy, [&]( std::size_t task ) {
+            CStreamProcessor processor( current );
+            const std::uint64_t first = chunks[task].FirstRecord;
+            processor.SetResultSink( [&, first]( const double *const *results, std::size_t record, std::size_t n ) {
+                EncodeRecords( results, outHeader, first + record, n, outData );
+            } );
+            process( chunks[task], processor );
+        } );
+    } else {
+        // Длина текста известна после печати: группа частей печатается в память, затем копируется на свои места
+        const std::size_t round = roundChunks * SPML::Execution::PoolThreads();
+        std::vector<CTextBuffer> texts( round );
+        std::vector<std::uint64_t> offsets( round + 1 );
+        std::uint64_t written = 0;
+        for( std::size_t start = 0; start < chunks.size(); start += round ) {
+            const std::size_t n = std::min( round, chunks.size() - start );
+            SPML::Execution::ParallelTasks( n, policy, [&]( std::size_t task ) {
+                CStreamProcessor processor( current );
+                process( chunks[start + task], processor );
+                texts[task] = std::move( processor.Output() );
+            } );
+            for( std::size_t i = 0; i < n; i++ ) {
+                offsets[i + 1] = offsets[i] + texts[i].Size();
+            }
+            if( !reserve( written + offsets[n] ) ) {
+                return EXIT_FAILURE;
+            }
+            if( !outMapping.Map( out.Get(), written, static_cast<std::size_t>( offsets[n] ), true ) ) {
+                std::fprintf( stderr, "Не удалось отобразить файл в память/Can't map file: %s\n", output.c_str() );
+                return EXIT_FAILURE;
+            }
+            char *outData = outMapping.Data();
+            SPML::Execution::ParallelTasks( n, policy, [&]( std::size_t task ) {
+                if( texts[task].Size() != 0 ) {
+                    std::memcpy( outData + offsets[task], texts[task].Data(), texts[task].Size() );
+                }
+            } );
+            outMapping.Reset();
+            written += offsets[n];
+        }
+    }
+    return ( errors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#else
+//----------------------------------------------------------------------------------------------------------------------
+int RunMapped( const std::string &input, const std::string &output, const TStreamSettings &settings )
+{
+    ( void )input;
+    ( void )output;
+    ( void )settings;
+    std::fprintf( stderr, "Отображение файлов в память не поддерживается/Memory-mapped files are not supported\n" );
+    return EXIT_FAILURE;
+}
+#endif
+
+} // end namespace GeoCalc
+/// \}
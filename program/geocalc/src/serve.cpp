@@ -0,0 +1,701 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       serve.cpp
+/// \brief      Сервер геодезического калькулятора на локальном сокете (Unix domain socket) и его клиент
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup geocalc
+/// \{
+///
+
+#include <serve.h>
+
+// System includes:
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// SPML includes:
+#include <execution.h>
+
+// GEOCALC includes:
+#include <stream.h>
+
+namespace GeoCalc /// Геодезический калькулятор
+{
+#if defined( __unix__ ) || defined( __APPLE__ )
+//----------------------------------------------------------------------------------------------------------------------
+static const std::size_t statusSize = 8; // Размер начала ответа (Status, Length), [байт]
+
+// Начало ответа
+static void EncodeStatus( std::uint32_t status, std::uint32_t length, char *bytes )
+{
+    for( std::size_t i = 0; i < 4; i++ ) {
+        bytes[i] = static_cast<char>( ( status >> ( 8 * i ) ) & 0xFF );
+        bytes[4 + i] = static_cast<char>( ( length >> ( 8 * i ) ) & 0xFF );
+    }
+}
+
+static void DecodeStatus( const char *bytes, std::uint32_t &status, std::uint32_t &length )
+{
+    status = 0;
+    length = 0;
+    for( std::size_t i = 0; i < 4; i++ ) {
+        status |= static_cast<std::uint32_t>( static_cast<unsigned char>( bytes[i] ) ) << ( 8 * i );
+        length |= static_cast<std::uint32_t>( static_cast<unsigned char>( bytes[4 + i] ) ) << ( 8 * i );
+    }
+}
+
+#if defined( MSG_NOSIGNAL )
+static const int sendFlags = MSG_NOSIGNAL; // Разрыв соединения - ошибка send, а не сигнал SIGPIPE
+#else
+static const int sendFlags = 0;
+#endif
+
+// Чтение size байт (false - ошибка или конец соединения)
+static bool ReceiveAll( int fd, char *bytes, std::size_t size )
+{
+    while( size > 0 ) {
+        const ssize_t received = recv( fd, bytes, size, 0 );
+        if( received <= 0 ) {
+            if( ( received < 0 ) && ( errno == EINTR ) ) {
+                continue;
+            }
+            return false;
+        }
+        bytes += received;
+        size -= static_cast<std::size_t>( received );
+    }
+    return true;
+}
+
+// Запись size байт
+static bool SendAll( int fd, const char *bytes, std::size_t size )
+{
+    while( size > 0 ) {
+        const ssize_t sent = send( fd, bytes, size, sendFlags );
+        if( sent < 0 ) {
+            if( errno == EINTR ) {
+                continue;
+            }
+            return false;
+        }
+        bytes += sent;
+        size -= static_cast<std::size_t>( sent );
+    }
+    return true;
+}
+
+// Адрес сокета
+static bool SocketAddress( const std::string &path, sockaddr_un &address, std::string &error )
+{
+    std::memset( &address, 0, sizeof( address ) );
+    address.sun_family = AF_UNIX;
+    if( path.empty() || ( path.size() >= sizeof( address.sun_path ) ) ) {
+        error = "неверный путь сокета/wrong socket path: " + path;
+        return false;
+    }
+    std::memcpy( address.sun_path, path.data(), path.size() );
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+typedef std::chrono::steady_clock TClock;
+
+// Состояние соединения
+enum TServeConnectionState
+{
+    CS_Reading = 0, // Прием запроса
+    CS_Solving,     // Запрос в очереди или решается (соединение не читается)
+    CS_Writing      // Отправка ответа
+};
+
+// Соединение сервера
+struct TServeConnection
+{
+    int Socket = -1;                        // Сокет соединения
+    TServeConnectionState State = CS_Reading;    // Состояние
+    TClock::time_point Last;                // Время последнего приема или отправки данных
+    std::size_t Done = 0;                   // Принято байт запроса или отправлено байт ответа
+    bool CloseAfterReply = false;           // Закрыть после отправки ответа (ответ с ошибкой)
+    bool Closed = false;                    // Соединение закрыто
+    TColumnarHeader Header;                 // Заголовок запроса
+    TColumnarHeader ResultHeader;           // Заголовок результатов
+    TStreamSettings Settings{ nullptr, SPML::Geodesy::CEllipsoid(), SPML::Units::RU_Kilometer,
+        SPML::Units::AU_Degree, -1 };       // Задача запроса
+    std::vector<char> Request;              // Запрос (заголовок и записи)
+    std::vector<char> Response;             // Ответ (начало ответа и заголовок результатов или текст ошибки)
+};
+
+// Неблокирующий режим дескриптора
+static bool SetNonBlocking( int fd )
+{
+    const int flags = fcntl( fd, F_GETFL, 0 );
+    return ( flags >= 0 ) && ( fcntl( fd, F_SETFL, flags | O_NONBLOCK ) == 0 );
+}
+
+// Закрытие дескриптора, если он открыт
+static void CloseDescriptor( int &fd )
+{
+    if( fd >= 0 ) {
+        close( fd );
+        fd = -1;
+    }
+}
+
+// Ответ с ошибкой: соединение закрывается после отправки
+static void ReplyError( TServeConnection &connection, const std::string &error )
+{
+    connection.Response.resize( statusSize + error.size() );
+    EncodeStatus( 1, static_cast<std::uint32_t>( error.size() ), connection.Response.data() );
+    std::memcpy( connection.Response.data() + statusSize, error.data(), error.size() );
+    connection.CloseAfterReply = true;
+    connection.State = CS_Writing;
+    connection.Done = 0;
+}
+
+// Проверка заголовка принятого запроса, подготовка записей и ответа (false - ответ с ошибкой)
+static bool AcceptHeader( TServeConnection &connection )
+{
+    TColumnarHeader &header = connection.Header;
+    std::string error;
+    if( !DecodeColumnarHeader( connection.Request.data(), header, error ) ) {
+        ReplyError( connection, error );
+        return false;
+    }
+    TStreamSettings &settings = connection.Settings;
+    settings.Operation = FindStreamOperation( header.Operation );
+    settings.Ellipsoid = header.Ellipsoid;
+    settings.RangeUnit = header.RangeUnit;
+    settings.AngleUnit = header.AngleUnit;
+    settings.From = header.From;
+    settings.To = header.To;
+    if( ( header.Count == TColumnarHeader::UnknownCount ) || ( header.Count > MaxServeRecords ) ) {
+        ReplyError( connection, "неверное число записей/wrong number of records" );
+        return false;
+    }
+    if( ( settings.Operation == nullptr ) || ( header.Kind != CK_Records ) ||
+        ( header.Columns != settings.Operation->Inputs ) || !CheckStreamSettings( settings ) ) {
+        ReplyError( connection, "запрос не соответствует задаче/request does not match the task" );
+        return false;
+    }
+
+    // Записи запроса - в буфер вместе с заголовком (DecodeRecords читает файл от начала заголовка), результаты -
+    // на их места в ответе
+    const std::size_t count = static_cast<std::size_t>( header.Count );
+    const std::size_t outputs = settings.Operation->Outputs;
+    connection.Request.resize( TColumnarHeader::Size + 8 * settings.Operation->Inputs * count );
+    connection.ResultHeader = OutputColumnarHeader( settings, outputs, header.Count );
+    connection.Response.resize( statusSize + TColumnarHeader::Size + 8 * outputs * count );
+    EncodeStatus( 0, 0, connection.Response.data() );
+    EncodeColumnarHeader( connection.ResultHeader, connection.Response.data() + statusSize );
+    return true;
+}
+
+// Чтение доступной части запроса (false - соединение закрыто клиентом или ошибка)
+static bool ReadRequest( TServeConnection &connection )
+{
+    while( connection.Done < connection.Request.size() ) {
+        const ssize_t received = recv( connection.Socket, connection.Request.data() + connection.Done,
+            connection.Request.size() - connection.Done, 0 );
+        if( received <= 0 ) {
+            if( ( received < 0 ) && ( errno == EINTR ) ) {
+                continue;
+            }
+            return ( received < 0 ) && ( ( errno == EAGAIN ) || ( errno == EWOULDBLOCK ) );
+        }
+        connection.Done += static_cast<std::size_t>( received );
+        connection.Last = TClock::now();
+        if( ( connection.Done == TColumnarHeader::Size ) && ( connection.Request.size() == TColumnarHeader::Size ) &&
+            !AcceptHeader( connection ) ) {
+            return true; // Ответ с ошибкой
+        }
+    }
+    connection.State = CS_Solving;
+    return true;
+}
+
+// Отправка доступной части ответа (false - соединение закрыто клиентом или ошибка)
+static bool WriteResponse( TServeConnection &connection )
+{
+    while( connection.Done < connection.Response.size() ) {
+        const ssize_t sent = send( connection.Socket, connection.Response.data() + connection.Done,
+            connection.Response.size() - connection.Done, sendFlags );
+        if( sent < 0 ) {
+            if( errno == EINTR ) {
+                continue;
+            }
+            return ( errno == EAGAIN ) || ( errno == EWOULDBLOCK );
+        }
+        connection.Done += static_cast<std::size_t>( sent );
+        connection.Last = TClock::now();
+    }
+    if( connection.CloseAfterReply ) {
+        return false;
+    }
+    connection.State = CS_Reading;
+    connection.Done = 0;
+    connection.Request.resize( TColumnarHeader::Size );
+    return true;
+}
+
+// Решение блока записей запроса, начиная с записи first
+static void SolveBlock( TServeConnection &connection, std::size_t first )
+{
+    // Столбцы блока - свои у каждого потока пула
+    static thread_local std::vector<double> storage;
+    const TStreamOperation &operation = *connection.Settings.Operation;
+    const std::size_t block = CStreamProcessor::BlockSize;
+    const std::size_t n = std::min<std::size_t>( block, static_cast<std::size_t>( connection.Header.Count ) - first );
+    storage.resize( ( operation.Inputs + operation.Outputs ) * block );
+    const double *inColumns[TStreamOperation::MaxInputs] = {};
+    double *in[TStreamOperation::MaxInputs] = {};
+    double *out[TStreamOperation::MaxOutputs] = {};
+    for( std::size_t i = 0; i < operation.Inputs; i++ ) {
+        in[i] = storage.data() + i * block;
+        inColumns[i] = in[i];
+    }
+    for( std::size_t i = 0; i < operation.Outputs; i++ ) {
+        out[i] = storage.data() + ( operation.Inputs + i ) * block;
+    }
+    DecodeRecords( connection.Request.data(), connection.Header, first, n, in );
+    operation.Solve( connection.Settings, n, inColumns, out );
+    EncodeRecords( out, connection.ResultHeader, first, n, connection.Response.data() + statusSize );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+CServer::CServer( const std::string &path, unsigned idleTimeout ) :
+    path( path ), idleTimeout( idleTimeout )
+{
+}
+
+CServer::~CServer()
+{
+    Stop();
+    Wait();
+    if( listener >= 0 ) {
+        close( listener );
+        unlink( path.c_str() );
+    }
+    CloseDescriptor( wakeRead );
+    CloseDescriptor( wakeWrite );
+}
+
+bool CServer::Start( std::string &error )
+{
+    sockaddr_un address;
+    if( !SocketAddress( path, address, error ) ) {
+        return false;
+    }
+    int wake[2];
+    if( pipe( wake ) != 0 ) {
+        error = std::string( "не удалось создать канал/can't create pipe: " ) + std::strerror( errno );
+        return false;
+    }
+    wakeRead = wake[0];
+    wakeWrite = wake[1];
+    listener = socket( AF_UNIX, SOCK_STREAM, 0 );
+    if( ( listener < 0 ) || !SetNonBlocking( listener ) || !SetNonBlocking( wakeRead ) ||
+        !SetNonBlocking( wakeWrite ) ) {
+        error = std::string( "не удалось создать сокет/can't create socket: " ) + std::strerror( errno );
+        CloseDescriptor( listener );
+        return false;
+    }
+    int bound = bind( listener, reinterpret_cast<const sockaddr *>( &address ), sizeof( address ) );
+    if( ( bound != 0 ) && ( errno == EADDRINUSE ) ) {
+        // Файл сокета остался от остановленного сервера, если к нему нельзя подключиться
+        const int probe = socket( AF_UNIX, SOCK_STREAM, 0 );
+        const bool alive = ( probe >= 0 ) &&
+            ( connect( probe, reinterpret_cast<const sockaddr *>( &address ), sizeof( address ) ) == 0 );
+        if( probe >= 0 ) {
+            close( probe );
+        }
+        if( !alive ) {
+            unlink( path.c_str() );
+            bound = bind( listener, reinterpret_cast<const sockaddr *>( &address ), sizeof( address ) );
+        } else {
+            errno = EADDRINUSE;
+        }
+    }
+    if( ( bound != 0 ) || ( listen( listener, SOMAXCONN ) != 0 ) ) {
+        error = "не удалось открыть сокет/can't open socket " + path + ": " + std::strerror( errno );
+        CloseDescriptor( listener );
+        return false;
+    }
+
+    // Запросы решаются пулом потоков библиотеки, очередь - по два запроса на поток пула
+    queueCapacity = 2 * SPML::Execution::PoolThreads();
+    events = std::thread( &CServer::Events, this );
+    solver = std::thread( &CServer::Solver, this );
+    return true;
+}
+
+void CServer::Wake()
+{
+    if( wakeWrite >= 0 ) {
+        const char byte = 0;
+        // Переполненный канал уже будит поток событий
+        while( ( write( wakeWrite, &byte, 1 ) < 0 ) && ( errno == EINTR ) ) {
+        }
+    }
+}
+
+void CServer::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock( queueMutex );
+        stopping = true;
+    }
+    queueChanged.notify_all();
+    Wake();
+}
+
+void CServer::Wait()
+{
+    if( events.joinable() ) {
+        events.join();
+    }
+    if( solver.joinable() ) {
+        solver.join();
+    }
+    for( std::unique_ptr<TServeConnection> &connection : connections ) {
+        CloseDescriptor( connection->Socket );
+    }
+    connections.clear();
+    queue.clear();
+    solved.clear();
+    pending = 0;
+}
+
+void CServer::Events()
+{
+    std::vector<pollfd> polled;
+    std::vector<TServeConnection *> replies;
+    char drain[64];
+    while( !stopping ) {
+        // Решенные запросы - на отправку, новые запросы читаются только при свободном месте в очереди
+        bool full;
+        {
+            std::lock_guard<std::mutex> lock( queueMutex );
+            replies.swap( solved );
+            full = ( pending >= queueCapacity );
+        }
+        TClock::time_point now = TClock::now();
+        for( TServeConnection *connection : replies ) {
+            connection->State = CS_Writing;
+            connection->Done = 0;
+            connection->Last = now;
+        }
+        replies.clear();
+
+        // Ожидание: канал пробуждения, сокет приема, соединения; время - до ближайшего истечения ожидания
+        polled.resize( 2 + connections.size() );
+        polled[0] = { wakeRead, POLLIN, 0 };
+        polled[1] = { listener, POLLIN, 0 };
+        int timeout = -1;
+        for( std::size_t i = 0; i < connections.size(); i++ ) {
+            TServeConnection &connection = *connections[i];
+            short wanted = 0;
+            if( connection.State == CS_Writing ) {
+                wanted = POLLOUT;
+            } else if( connection.State == CS_Reading ) {
+                if( full ) {
+                    connection.Last = now; // Ожидание сервера не считается простоем клиента
+                } else {
+                    wanted = POLLIN;
+                }
+            }
+            polled[2 + i] = { connection.Socket, wanted, 0 };
+            if( wanted != 0 ) {
+                const long long left = std::chrono::duration_cast<std::chrono::milliseconds>( connection.Last +
+                    std::chrono::milliseconds( idleTimeout ) - now ).count();
+                const int wait = static_cast<int>( std::max<long long>( left, 0 ) );
+                timeout = ( timeout < 0 ) ? wait : std::min( timeout, wait );
+            }
+        }
+        if( poll( polled.data(), static_cast<nfds_t>( polled.size() ), timeout ) < 0 ) {
+            continue; // EINTR; остановка проверяется в условии цикла
+        }
+        if( polled[0].revents != 0 ) {
+            while( read( wakeRead, drain, sizeof( drain ) ) > 0 ) {
+            }
+        }
+
+        // Обмен по готовым соединениям (ответ на решенный запрос - сразу же), закрытие простаивающих
+        now = TClock::now();
+        for( std::size_t i = 0; i < connections.size(); i++ ) {
+            TServeConnection &connection = *connections[i];
+            const short ready = polled[2 + i].revents;
+            if( ( ready != 0 ) && ( connection.State != CS_Solving ) ) {
+                const bool open = ( connection.State == CS_Reading ) ? ReadRequest( connection ) :
+                    WriteResponse( connection );
+                connection.Closed = !open;
+                if( open && ( connection.State == CS_Solving ) ) {
+                    {
+                        std::lock_guard<std::mutex> lock( queueMutex );
+                        queue.push_back( &connection );
+                        pending++;
+                    }
+                    queueChanged.notify_one();
+                }
+            } else if( ( polled[2 + i].events != 0 ) &&
+                ( now - connection.Last >= std::chrono::milliseconds( idleTimeout ) ) ) {
+                connection.Closed = true;
+            }
+        }
+        connections.erase( std::remove_if( connections.begin(), connections.end(),
+            []( const std::unique_ptr<TServeConnection> &connection ) {
+                if( connection->Closed ) {
+                    close( connection->Socket );
+                }
+                return connection->Closed;
+            } ), connections.end() );
+
+        // Новые соединения
+        if( polled[1].revents != 0 ) {
+            while( true ) {
+                const int socket = accept( listener, nullptr, nullptr );
+                if( socket < 0 ) {
+                    // Очередь соединений пуста или временная ошибка (например, нехватка дескрипторов)
+                    break;
+                }
+#if defined( SO_NOSIGPIPE )
+                const int noSignal = 1;
+                setsockopt( socket, SOL_SOCKET, SO_NOSIGPIPE, &noSignal, sizeof( noSignal ) );
+#endif
+                if( !SetNonBlocking( socket ) ) {
+                    close( socket );
+                    continue;
+                }
+                connections.emplace_back( new TServeConnection );
+                connections.back()->Socket = socket;
+                connections.back()->Last = now;
+                connections.back()->Request.resize( TColumnarHeader::Size );
+            }
+        }
+    }
+}
+
+void CServer::Solver()
+{
+    const SPML::Execution::Policy policy( SPML::Execution::EM_Parallel );
+    std::vector<TServeConnection *> requests;
+    std::vector<std::pair<TServeConnection *, std::size_t>> blocks;
+    while( true ) {
+        {
+            std::unique_lock<std::mutex> lock( queueMutex );
+            queueChanged.wait( lock, [this]() { return stopping || !queue.empty(); } );
+            if( stopping ) {
+                return;
+            }
+            requests.swap( queue );
+        }
+
+        // Блоки всех взятых запросов - задачи пула: малые запросы решаются одновременно, большие - по частям
+        blocks.clear();
+        for( TServeConnection *connection : requests ) {
+            for( std::size_t first = 0; first < connection->Header.Count; first += CStreamProcessor::BlockSize ) {
+                blocks.emplace_back( connection, first );
+            }
+        }
+        SPML::Execution::ParallelTasks( blocks.size(), policy, [&blocks]( std::size_t task ) {
+            SolveBlock( *blocks[task].first, blocks[task].second );
+        } );
+        {
+            std::lock_guard<std::mutex> lock( queueMutex );
+            solved.insert( solved.end(), requests.begin(), requests.end() );
+            pending -= requests.size();
+        }
+        requests.clear();
+        Wake();
+    }
+}
+
+int RunServe( const std::string &path, unsigned threads )
+{
+    // Сигналы остановки принимает только основной поток (потоки сервера и пула библиотеки наследуют маску)
+    sigset_t signals;
+    sigemptyset( &signals );
+    sigaddset( &signals, SIGINT );
+    sigaddset( &signals, SIGTERM );
+    pthread_sigmask( SIG_BLOCK, &signals, nullptr );
+
+    // Пул пересоздается после блокировки сигналов, чтобы его потоки тоже унаследовали маску
+    SPML::Execution::SetPoolThreads( threads );
+    CServer server( path );
+    std::string error;
+    if( !server.Start( error ) ) {
+        std::fprintf( stderr, "%s\n", error.c_str() );
+        return EXIT_FAILURE;
+    }
+    std::fprintf( stderr, "Сервер запущен/Server started: %s\n", path.c_str() );
+    int signal = 0;
+    sigwait( &signals, &signal );
+    server.Stop();
+    server.Wait();
+    return EXIT_SUCCESS;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+CServeClient::~CServeClient()
+{
+    if( fd >= 0 ) {
+        close( fd );
+    }
+}
+
+bool CServeClient::Connect( const std::string &path, std::string &error )
+{
+    sockaddr_un address;
+    if( !SocketAddress( path, address, error ) ) {
+        return false;
+    }
+    if( fd >= 0 ) {
+        close( fd );
+    }
+    fd = socket( AF_UNIX, SOCK_STREAM, 0 );
+    if( ( fd < 0 ) || ( connect( fd, reinterpret_cast<const sockaddr *>( &address ), sizeof( address ) ) != 0 ) ) {
+        error = "не удалось подключиться/can't connect to " + path + ": " + std::strerror( errno );
+        if( fd >= 0 ) {
+            close( fd );
+            fd = -1;
+        }
+        return false;
+    }
+    return true;
+}
+
+bool CServeClient::Solve( const TColumnarHeader &task, const double *const *in, std::size_t count,
+    double *const *out, std::string &error )
+{
+    const TStreamOperation *operation = FindStreamOperation( task.Operation );
+    if( ( operation == nullptr ) || ( count > MaxServeRecords ) ) {
+        error = "неверный запрос/wrong request";
+        return false;
+    }
+    if( fd < 0 ) {
+        error = "нет соединения/not connected";
+        return false;
+    }
+
+    // Запрос - один блок
+    TColumnarHeader header = task;
+    header.BlockSize = static_cast<std::uint32_t>( std::max<std::size_t>( count, 1 ) );
+    header.Kind = CK_Records;
+    header.Columns = operation->Inputs;
+    header.Count = count;
+    request.resize( TColumnarHeader::Size + 8 * header.Columns * count );
+    EncodeColumnarHeader( header, request.data() );
+    EncodeRecords( in, header, 0, count, request.data() );
+    char status[statusSize];
+    if( !SendAll( fd, request.data(), request.size() ) || !ReceiveAll( fd, status, sizeof( status ) ) ) {
+        error = "соединение прервано/connection lost";
+        return false;
+    }
+
+    std::uint32_t code, length;
+    DecodeStatus( status, code, length );
+    if( code != 0 ) {
+        response.resize( length );
+        error = ReceiveAll( fd, response.data(), length ) ? std::string( response.data(), length ) :
+            "соединение прервано/connection lost";
+        close( fd );
+        fd = -1;
+        return false;
+    }
+    response.resize( TColumnarHeader::Size );
+    TColumnarHeader result;
+    if( !ReceiveAll( fd, response.data(), TColumnarHeader::Size ) ||
+        !DecodeColumnarHeader( response.data(), result, error ) || ( result.Count != count ) ||
+        ( result.Columns != operation->Outputs ) ) {
+        error = "неверный ответ/wrong response";
+        close( fd );
+        fd = -1;
+        return false;
+    }
+    response.resize( TColumnarHeader::Size + 8 * result.Columns * count );
+    if( !ReceiveAll( fd, response.data() + TColumnarHeader::Size, response.size() - TColumnarHeader::Size ) ) {
+        error = "соединение прервано/connection lost";
+        return false;
+    }
+    DecodeRecords( response.data(), result, 0, count, out );
+    return true;
+}
+
+#else
+//----------------------------------------------------------------------------------------------------------------------
+CServer::CServer( const std::string &path, unsigned idleTimeout ) :
+    path( path ), idleTimeout( idleTimeout )
+{
+}
+
+struct TServeConnection
+{
+};
+
+CServer::~CServer()
+{
+}
+
+bool CServer::Start( std::string &error )
+{
+    error = "локальные сокеты не поддерживаются/Unix domain sockets are not supported";
+    return false;
+}
+
+void CServer::Stop()
+{
+}
+
+void CServer::Wait()
+{
+}
+
+int RunServe( const std::string &path, unsigned threads )
+{
+    ( void )threads;
+    CServer server( path );
+    std::string error;
+    server.Start( error );
+    std::fprintf( stderr, "%s\n", error.c_str() );
+    return EXIT_FAILURE;
+}
+
+CServeClient::~CServeClient()
+{
+}
+
+bool CServeClient::Connect( const std::string &path, std::string &error )
+{
+    ( void )path;
+    error = "локальные сокеты не поддерживаются/Unix domain sockets are not supported";
+    return false;
+}
+
+bool CServeClient::Solve( const TColumnarHeader &task, const double *const *in, std::size_t count,
+    double *const *out, std::string &error )
+{
+    ( void )task;
+    ( void )in;
+    ( void )count;
+    ( void )out;
+    error = "локальные сокеты не поддерживаются/Unix domain sockets are not supported";
+    return false;
+}
+#endif
+
+} // end namespace GeoCalc
+/// \}
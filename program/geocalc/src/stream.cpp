@@ -0,0 +1,471 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       stream.cpp
+/// \brief      Потоковый режим геодезического калькулятора: одна задача на много записей
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup geocalc
+/// \{
+///
+
+#include <stream.h>
+
+// System includes:
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+// SPML includes:
+#include <geodesy_batch.h>
+
+namespace GeoCalc /// Геодезический калькулятор
+{
+//----------------------------------------------------------------------------------------------------------------------
+// Пакетные функции вызываются в вызывающем потоке с наилучшей векторизацией
+static const SPML::Execution::Policy streamPolicy( SPML::SIMD::TSimdLevel::SL_Auto, 1 );
+
+static const TStreamOperation streamOperations[] = {
+    { "geo2rad", 4, 3, []( const TStreamSettings &s, std::size_t n, const double *const *in, double *const *out ) {
+        SPML::Geodesy::GEOtoRAD_Batch( s.Ellipsoid, s.RangeUnit, s.AngleUnit, in[0], in[1], in[2], in[3], n, out[0],
+            out[1], out[2], streamPolicy );
+    } },
+    { "rad2geo", 4, 3, []( const TStreamSettings &s, std::size_t n, const double *const *in, double *const *out ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::RADtoGEO( s.Ellipsoid, s.RangeUnit, s.AngleUnit, in[0][i], in[1][i], in[2][i], in[3][i],
+                out[0][i], out[1][i], out[2][i] );
+        }
+    } },
+    { "geo2ecef", 3, 3, []( const TStreamSettings &s, std::size_t n, const double *const *in, double *const *out ) {
+        SPML::Geodesy::GEOtoECEF_Batch( s.Ellipsoid, s.RangeUnit, s.AngleUnit, in[0], in[1], in[2], n, out[0], out[1],
+            out[2], streamPolicy );
+    } },
+    { "ecef2geo", 3, 3, []( const TStreamSettings &s, std::size_t n, const double *const *in, double *const *out ) {
+        SPML::Geodesy::ECEFtoGEO_Batch( s.Ellipsoid, s.RangeUnit, s.AngleUnit, in[0], in[1], in[2], n, out[0], out[1],
+            out[2], streamPolicy );
+    } },
+    { "ecef2enu", 6, 3, []( const TStreamSettings &s, std::size_t n, const double *const *in, double *const *out ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::ECEFtoENU( s.Ellipsoid, s.RangeUnit, s.AngleUnit, in[0][i], in[1][i], in[2][i], in[3][i],
+                in[4][i], in[5][i], out[0][i], out[1][i], out[2][i] );
+        }
+    } },
+    { "enu2ecef", 6, 3, []( const TStreamSettings &s, std::size_t n, const double *const *in, double *const *out ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::ENUtoECEF( s.Ellipsoid, s.RangeUnit, s.AngleUnit, in[0][i], in[1][i], in[2][i], in[3][i],
+                in[4][i], in[5][i], out[0][i], out[1][i], out[2][i] );
+        }
+    } },
+    { "enu2aer", 3, 3, []( const TStreamSettings &s, std::size_t n, const double *const *in, double *const *out ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::ENUtoAER( s.RangeUnit, s.AngleUnit, in[0][i], in[1][i], in[2][i], out[0][i], out[1][i],
+                out[2][i] );
+        }
+    } },
+    { "aer2enu", 3, 3, []( const TStreamSettings &s, std::size_t n, const double *const *in, double *const *out ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::AERtoENU( s.RangeUnit, s.AngleUnit, in[0][i], in[1][i], in[2][i], out[0][i], out[1][i],
+                out[2][i] );
+        }
+    } },
+    { "geo2enu", 6, 3, []( const TStreamSettings &s, std::size_t n, const double *const *in, double *const *out ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::GEOtoENU( s.Ellipsoid, s.RangeUnit, s.AngleUnit, in[0][i], in[1][i], in[2][i], in[3][i],
+                in[4][i], in[5][i], out[0][i], out[1][i], out[2][i] );
+        }
+    } },
+    { "enu2geo", 6, 3, []( const TStreamSettings &s, std::size_t n, const double *const *in, double *const *out ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::ENUtoGEO( s.Ellipsoid, s.RangeUnit, s.AngleUnit, in[0][i], in[1][i], in[2][i], in[3][i],
+                in[4][i], in[5][i], out[0][i], out[1][i], out[2][i] );
+        }
+    } },
+    { "geo2aer", 6, 3, []( const TStreamSettings &s, std::size_t n, const double *const *in, double *const *out ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::GEOtoAER( s.Ellipsoid, s.RangeUnit, s.AngleUnit, in[0][i], in[1][i], in[2][i], in[3][i],
+                in[4][i], in[5][i], out[0][i], out[1][i], out[2][i] );
+        }
+    } },
+    { "aer2geo", 6, 3, []( const TStreamSettings &s, std::size_t n, const double *const *in, double *const *out ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::AERtoGEO( s.Ellipsoid, s.RangeUnit, s.AngleUnit, in[0][i], in[1][i], in[2][i], in[3][i],
+                in[4][i], in[5][i], out[0][i], out[1][i], out[2][i] );
+        }
+    } },
+    { "ecef2aer", 6, 3, []( const TStreamSettings &s, std::size_t n, const double *const *in, double *const *out ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::ECEFtoAER( s.Ellipsoid, s.RangeUnit, s.AngleUnit, in[0][i], in[1][i], in[2][i], in[3][i],
+                in[4][i], in[5][i], out[0][i], out[1][i], out[2][i] );
+        }
+    } },
+    { "bw", 3, 3, []( const TStreamSettings &s, std::size_t n, const double *const *in, double *const *out ) {
+        // Только метры (как --bw), параметры перевода выбираются один раз на блок
+        const SPML::Geodesy::CShiftECEF_7 shift = SPML::Geodesy::GetShiftECEF_7( s.From, s.To );
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::ECEFtoECEF_7params( in[0][i], in[1][i], in[2][i], shift.dX(), shift.dY(), shift.dZ(),
+                shift.rX(), shift.rY(), shift.rZ(), shift.S(), out[0][i], out[1][i], out[2][i] );
+        }
+    } },
+    { "aer2ecef", 6, 3, []( const TStreamSettings &s, std::size_t n, const double *const *in, double *const *out ) {
+        for( std::size_t i = 0; i < n; i++ ) {
+            SPML::Geodesy::AERtoECEF( s.Ellipsoid, s.RangeUnit, s.AngleUnit, in[0][i], in[1][i], in[2][i], in[3][i],
+                in[4][i], in[5][i], out[0][i], out[1][i], out[2][i] );
+        }
+    } },
+};
+
+const TStreamOperation *FindStreamOperation( const std::string &name )
+{
+    for( const TStreamOperation &operation : streamOperations ) {
+        if( name == operation.Name ) {
+            return &operation;
+        }
+    }
+    return nullptr;
+}
+
+std::string StreamOperationNames()
+{
+    std::string names;
+    for( const TStreamOperation &operation : streamOperations ) {
+        names += names.empty() ? "" : ", ";
+        names += operation.Name;
+    }
+    return names;
+}
+
+bool CheckStreamSettings( const TStreamSettings &settings )
+{
+    const double a = settings.Ellipsoid.A();
+    const double invf = settings.Ellipsoid.Invf();
+    return ( settings.Operation != nullptr ) && std::isfinite( a ) && ( a > 0.0 ) &&
+        ( ( invf == 0.0 ) || ( std::isfinite( invf ) && ( invf > 1.0 ) ) ) &&
+        ( settings.Convert || ( std::strcmp( settings.Operation->Name, "bw" ) != 0 ) ||
+        SPML::Geodesy::IsShiftECEF_7Defined( settings.From, settings.To ) );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void CTextBuffer::Append( double value, int precision )
+{
+    // Длина числа заранее неизвестна (до 309 цифр целой части): печать с запасом, при нехватке места - повтор
+    std::size_t length = 32 + static_cast<std::size_t>( std::max( precision, 0 ) );
+    while( true ) {
+        Reserve( length );
+        const std::to_chars_result printed = ( precision < 0 ) ?
+            std::to_chars( text.data() + size, text.data() + text.size(), value ) :
+            std::to_chars( text.data() + size, text.data() + text.size(), value, std::chars_format::fixed, precision );
+        if( printed.ec == std::errc() ) {
+            size = static_cast<std::size_t>( printed.ptr - text.data() );
+            return;
+        }
+        length = text.size() - size + 512;
+    }
+}
+
+void CTextBuffer::Append( const char *begin, std::size_t length )
+{
+    Reserve( length );
+    std::memcpy( text.data() + size, begin, length );
+    size += length;
+}
+
+const char *ParseNumber( const char *begin, const char *end, double &value )
+{
+    if( ( begin != end ) && ( *begin == '+' ) ) {
+        begin++;
+        // После '+' только цифры или точка: "+-5", "+nan", "+inf" - неверный ввод
+        if( ( begin == end ) || ( ( ( *begin < '0' ) || ( *begin > '9' ) ) && ( *begin != '.' ) ) ) {
+            return nullptr;
+        }
+    }
+    const std::from_chars_result parsed = std::from_chars( begin, end, value );
+    return ( parsed.ec == std::errc() ) ? parsed.ptr : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Разделитель чисел в записи
+static bool IsSeparator( char c )
+{
+    return ( c == ' ' ) || ( c == '\t' ) || ( c == ',' ) || ( c == ';' ) || ( c == '\r' );
+}
+
+bool IsRecordLine( const char *begin, const char *end )
+{
+    while( ( begin != end ) && IsSeparator( *begin ) ) {
+        begin++;
+    }
+    return ( begin != end ) && ( *begin != '#' );
+}
+
+CStreamProcessor::CStreamProcessor( const TStreamSettings &settings ) : settings( settings )
+{
+    inputs = settings.Operation->Inputs;
+    outputs = settings.Operation->Outputs;
+    if( settings.Convert ) {
+        inputs = ( settings.Kind == CK_Records ) ? settings.Operation->Inputs : settings.Operation->Outputs;
+        outputs = inputs;
+    }
+    for( std::size_t i = 0; i < inputs; i++ ) {
+        in[i].resize( BlockSize );
+    }
+    for( std::size_t i = 0; !settings.Convert && ( i < outputs ); i++ ) {
+        out[i].resize( BlockSize );
+    }
+    valid.resize( BlockSize );
+}
+
+void CStreamProcessor::Line( const char *begin, const char *end )
+{
+    lines++;
+    if( !IsRecordLine( begin, end ) ) {
+        return;
+    }
+    while( IsSeparator( *begin ) ) {
+        begin++;
+    }
+
+    std::size_t fields = 0;
+    bool ok = true;
+    while( begin != end ) {
+        double value;
+        const char *next = ( fields < inputs ) ? ParseNumber( begin, end, value ) : nullptr;
+        if( ( next == nullptr ) || ( ( next != end ) && !IsSeparator( *next ) ) ) {
+            ok = false;
+            break;
+        }
+        in[fields++][count] = value;
+        begin = next;
+        while( ( begin != end ) && IsSeparator( *begin ) ) {
+            begin++;
+        }
+    }
+    ok = ok && ( fields == inputs );
+    if( !ok ) {
+        std::fprintf( stderr, "Строка %zu: неверный ввод, ожидается чисел: %zu/Line %zu: wrong input, expected "
+            "%zu numbers\n", lines, inputs, lines, inputs );
+        for( std::size_t i = 0; i < inputs; i++ ) {
+            in[i][count] = 0.0;
+        }
+        errors++;
+    }
+    valid[count] = ok ? 1 : 0;
+    records++;
+    if( ++count == BlockSize ) {
+        Flush();
+    }
+}
+
+void CStreamProcessor::Columns( const double *const *columns, std::size_t n )
+{
+    std::size_t done = 0;
+    while( done < n ) {
+        const std::size_t part = std::min( n - done, BlockSize - count );
+        for( std::size_t i = 0; i < inputs; i++ ) {
+            std::copy( columns[i] + done, columns[i] + done + part, in[i].begin() + count );
+        }
+        std::fill( valid.begin() + count, valid.begin() + count + part, 1 );
+        records += part;
+        count += part;
+        done += part;
+        if( count == BlockSize ) {
+            Flush();
+        }
+    }
+}
+
+void CStreamProcessor::Flush()
+{
+    if( count == 0 ) {
+        return;
+    }
+    std::vector<double> *results = in; // При переводе формата результат - сами записи
+    if( !settings.Convert ) {
+        const double *inColumns[TStreamOperation::MaxInputs] = {};
+        double *outColumns[TStreamOperation::MaxOutputs] = {};
+        for( std::size_t i = 0; i < inputs; i++ ) {
+            inColumns[i] = in[i].data();
+        }
+        for( std::size_t i = 0; i < outputs; i++ ) {
+            outColumns[i] = out[i].data();
+        }
+        settings.Operation->Solve( settings, count, inColumns, outColumns );
+        results = out;
+    }
+    for( std::size_t r = 0; r < count; r++ ) {
+        if( !valid[r] ) {
+            for( std::size_t i = 0; i < outputs; i++ ) {
+                results[i][r] = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+    }
+
+    if( sink ) {
+        const double *columns[TStreamOperation::MaxInputs] = {}; // При переводе формата столбцов - как у записей
+        for( std::size_t i = 0; i < outputs; i++ ) {
+            columns[i] = results[i].data();
+        }
+        sink( columns, records - count, count );
+    } else if( settings.OutputFormat == SF_Binary ) {
+        for( std::size_t i = 0; i < outputs; i++ ) {
+            EncodeColumn( results[i].data(), count, output.Extend( count * sizeof( double ) ) );
+        }
+    } else {
+        for( std::size_t r = 0; r < count; r++ ) {
+            for( std::size_t i = 0; i < outputs; i++ ) {
+                if( i != 0 ) {
+                    output.Append( ' ' );
+                }
+                output.Append( results[i][r], settings.Precision );
+            }
+            output.Append( '\n' );
+        }
+    }
+    count = 0;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+bool MatchColumnarInput( const TColumnarHeader &header, const TStreamSettings &settings, std::size_t inputs )
+{
+    const TColumnarKind kind = settings.Convert ? settings.Kind : CK_Records;
+    return ( header.Operation == settings.Operation->Name ) && ( header.Kind == kind ) && ( header.Columns == inputs );
+}
+
+TColumnarHeader OutputColumnarHeader( const TStreamSettings &settings, std::size_t outputs, std::uint64_t count )
+{
+    TColumnarHeader header;
+    header.BlockSize = CStreamProcessor::BlockSize;
+    header.Operation = settings.Operation->Name;
+    header.Kind = settings.Convert ? settings.Kind : CK_Results;
+    header.Columns = outputs;
+    header.RangeUnit = settings.RangeUnit;
+    header.AngleUnit = settings.AngleUnit;
+    header.Count = count;
+    header.Ellipsoid = settings.Ellipsoid;
+    header.From = settings.From;
+    header.To = settings.To;
+    return header;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+static const std::size_t streamBufferSize = 1 << 20; // Размер блоков ввода и вывода, [байт]
+
+// Вывод накопленных результатов, если их больше блока вывода (или всех при all); false - ошибка записи
+static bool WriteOutput( CStreamProcessor &processor, std::FILE *out, bool all = false )
+{
+    if( all || ( processor.Output().Size() >= streamBufferSize ) ) {
+        const std::size_t size = processor.Output().Size();
+        const bool written = std::fwrite( processor.Output().Data(), 1, size, out ) == size;
+        processor.Output().Clear();
+        return written;
+    }
+    return true;
+}
+
+// Текстовый ввод: строки из блоков файла
+static bool ReadText( std::FILE *in, std::FILE *out, CStreamProcessor &processor )
+{
+    std::vector<char> buffer( streamBufferSize );
+    std::size_t kept = 0; // Начало незавершенной строки, перенесенное в начало буфера
+    while( true ) {
+        if( kept == buffer.size() ) { // Строка длиннее буфера
+            buffer.resize( buffer.size() * 2 );
+        }
+        const std::size_t read = std::fread( buffer.data() + kept, 1, buffer.size() - kept, in );
+        const char *begin = buffer.data();
+        const char *end = buffer.data() + kept + read;
+        if( read == 0 ) {
+            if( begin != end ) { // Последняя строка без '\n'
+                processor.Line( begin, end );
+            }
+            return true;
+        }
+        while( true ) {
+            const char *newline = static_cast<const char *>( std::memchr( begin, '\n', end - begin ) );
+            if( newline == nullptr ) {
+                break;
+            }
+            processor.Line( begin, newline );
+            begin = newline + 1;
+        }
+        kept = static_cast<std::size_t>( end - begin );
+        std::memmove( buffer.data(), begin, kept );
+        if( !WriteOutput( processor, out ) ) {
+            return false; // Сообщение - в RunStream
+        }
+    }
+}
+
+// Двоичный ввод: столбцы блоков файла
+static bool ReadBinary( std::FILE *in, std::FILE *out, const TColumnarHeader &header, CStreamProcessor &processor )
+{
+    std::vector<double> storage( header.Columns * header.BlockSize );
+    double *columns[TStreamOperation::MaxInputs] = {};
+    for( std::size_t i = 0; i < header.Columns; i++ ) {
+        columns[i] = storage.data() + i * header.BlockSize;
+    }
+    std::uint64_t read = 0;
+    while( true ) {
+        std::size_t count = 0;
+        std::string error;
+        if( !ReadColumnarBlock( in, header, read, columns, count, error ) ) {
+            std::fprintf( stderr, "%s\n", error.c_str() );
+            return false;
+        }
+        if( count == 0 ) {
+            return true;
+        }
+        processor.Columns( columns, count );
+        read += count;
+        if( !WriteOutput( processor, out ) ) {
+            return false; // Сообщение - в RunStream
+        }
+    }
+}
+
+int RunStream( std::FILE *in, std::FILE *out, const TStreamSettings &settings )
+{
+    TStreamSettings current = settings;
+    TColumnarHeader inHeader;
+    if( settings.InputFormat == SF_Binary ) {
+        std::string error;
+        if( !ReadColumnarHeader( in, inHeader, error ) ) {
+            std::fprintf( stderr, "%s\n", error.c_str() );
+            return EXIT_FAILURE;
+        }
+        current.RangeUnit = inHeader.RangeUnit;
+        current.AngleUnit = inHeader.AngleUnit;
+        current.Ellipsoid = inHeader.Ellipsoid;
+        current.From = inHeader.From;
+        current.To = inHeader.To;
+    }
+    CStreamProcessor processor( current );
+    if( ( settings.InputFormat == SF_Binary ) &&
+        ( !MatchColumnarInput( inHeader, current, processor.Inputs() ) || !CheckStreamSettings( current ) ) ) {
+        std::fprintf( stderr, "Содержимое файла не соответствует задаче/File contents do not match the task\n" );
+        return EXIT_FAILURE;
+    }
+
+    const long outStart = std::ftell( out );
+    if( settings.OutputFormat == SF_Binary ) {
+        EncodeColumnarHeader( OutputColumnarHeader( current, processor.Outputs() ),
+            processor.Output().Extend( TColumnarHeader::Size ) );
+    }
+
+    // Ошибка записи запоминается в файле вывода (ferror), в том числе при записи буфера в fflush
+    const bool read = ( settings.InputFormat == SF_Binary ) ? ReadBinary( in, out, inHeader, processor ) :
+        ReadText( in, out, processor );
+    processor.Flush();
+    if( !std::ferror( out ) && WriteOutput( processor, out, true ) && ( settings.OutputFormat == SF_Binary ) ) {
+        PatchColumnarCount( out, outStart, processor.Records() );
+    }
+    const bool written = ( std::fflush( out ) == 0 ) && !std::ferror( out );
+    if( !written ) {
+        std::fprintf( stderr, "Ошибка записи вывода/Output write error: %s\n", std::strerror( errno ) );
+    }
+    return ( read && written && ( processor.Errors() == 0 ) ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // end namespace GeoCalc
+/// \}
@@ -73,6 +73,62 @@ const double KmToMsD_full = 1.0 / MsToKmD_full; ///< Перевод дально
 //const double SecToKmD_full = Consts::C_D * 1.0e-3; ///< Перевод задержки [с] в дальность [км] путем умножения на данную константу (по формуле R = C * Tau / 2 )
 //const double KmToSecD_full = 1.0 / SecToKmD_full; ///< Перевод дальности к[м] в задержку [с] путем умножения на данную константу (по формуле Tau = 2 * R / C )
 
+//----------------------------------------------------------------------------------------------------------------------
+// Перевод единиц, заданных при компиляции (для функций, специализированных по единицам измерения). Перевод из
+// радиан в радианы и из метров в метры не выполняет никаких операций. Варианты float вычисляют в float
+
+///
+/// \brief Перевод угла в радианы
+/// \tparam AU - единицы измерения угла
+/// \param[in] angle - угол в единицах AU
+/// \return Угол в [рад]
+///
+template <Units::TAngleUnit AU> inline double AngleToRad( double angle );
+template <> inline double AngleToRad<Units::TAngleUnit::AU_Radian>( double angle ) { return angle; }
+template <> inline double AngleToRad<Units::TAngleUnit::AU_Degree>( double angle ) { return angle * DgToRdD; }
+template <Units::TAngleUnit AU> inline float AngleToRad( float angle );
+template <> inline float AngleToRad<Units::TAngleUnit::AU_Radian>( float angle ) { return angle; }
+template <> inline float AngleToRad<Units::TAngleUnit::AU_Degree>( float angle ) { return angle * DgToRdF; }
+
+///
+/// \brief Перевод угла из радиан
+/// \tparam AU - единицы измерения угла
+/// \param[in] angle - угол в [рад]
+/// \return Угол в единицах AU
+///
+template <Units::TAngleUnit AU> inline double AngleFromRad( double angle );
+template <> inline double AngleFromRad<Units::TAngleUnit::AU_Radian>( double angle ) { return angle; }
+template <> inline double AngleFromRad<Units::TAngleUnit::AU_Degree>( double angle ) { return angle * RdToDgD; }
+template <Units::TAngleUnit AU> inline float AngleFromRad( float angle );
+template <> inline float AngleFromRad<Units::TAngleUnit::AU_Radian>( float angle ) { return angle; }
+template <> inline float AngleFromRad<Units::TAngleUnit::AU_Degree>( float angle ) { return angle * RdToDgF; }
+
+///
+/// \brief Перевод дальности в метры
+/// \tparam RU - единицы измерения дальности
+/// \param[in] range - дальность в единицах RU
+/// \return Дальность в [м]
+///
+template <Units::TRangeUnit RU> inline double RangeToMeter( double range );
+template <> inline double RangeToMeter<Units::TRangeUnit::RU_Meter>( double range ) { return range; }
+template <> inline double RangeToMeter<Units::TRangeUnit::RU_Kilometer>( double range ) { return range * 1000.0; }
+template <Units::TRangeUnit RU> inline float RangeToMeter( float range );
+template <> inline float RangeToMeter<Units::TRangeUnit::RU_Meter>( float range ) { return range; }
+template <> inline float RangeToMeter<Units::TRangeUnit::RU_Kilometer>( float range ) { return range * 1000.0f; }
+
+///
+/// \brief Перевод дальности из метров
+/// \tparam RU - единицы измерения дальности
+/// \param[in] range - дальность в [м]
+/// \return Дальность в единицах RU
+///
+template <Units::TRangeUnit RU> inline double RangeFromMeter( double range );
+template <> inline double RangeFromMeter<Units::TRangeUnit::RU_Meter>( double range ) { return range; }
+template <> inline double RangeFromMeter<Units::TRangeUnit::RU_Kilometer>( double range ) { return range * 0.001; }
+template <Units::TRangeUnit RU> inline float RangeFromMeter( float range );
+template <> inline float RangeFromMeter<Units::TRangeUnit::RU_Meter>( float range ) { return range; }
+template <> inline float RangeFromMeter<Units::TRangeUnit::RU_Kilometer>( float range ) { return range * 0.001f; }
+
 //----------------------------------------------------------------------------------------------------------------------
 ///
 /// \brief Приведение угла в [0,360) градусов или [0,2PI) радиан
@@ -0,0 +1,131 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       execution.h
+/// \brief      Политика выполнения пакетных функций и пул потоков библиотеки
+/// \details    Все пакетные функции (geodesy_batch.h, geofence.h, CSpatialIndex) принимают политику выполнения:
+///             последовательно, параллельно или параллельно с векторизацией. Параллельные части выполняются пулом
+///             потоков библиотеки, создаваемым при первом параллельном вызове (потоки не создаются на каждый вызов).
+///             Вызывающий поток выполняет части наравне с потоками пула. Вызов из части, выполняемой пулом, и
+///             вызов, пока пул занят другим потоком, выполняются последовательно в вызывающем потоке.
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_EXECUTION_H
+#define SPML_EXECUTION_H
+
+// System includes:
+#include <cstddef>
+#include <functional>
+
+// SPML includes:
+#include <simd.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Execution /// Политика выполнения пакетных функций
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Способ выполнения пакетной функции
+///
+enum TMode : int
+{
+    EM_Sequential = 0,  ///< В вызывающем потоке, без векторизации (SIMD::SL_Scalar)
+    EM_Parallel,        ///< Пулом потоков, без векторизации
+    EM_ParallelSimd     ///< Пулом потоков, с векторизацией заданного уровня (при Threads = 1 - в вызывающем потоке)
+};
+
+///
+/// \brief Политика выполнения пакетной функции
+///
+struct Policy
+{
+    TMode Mode;             ///< Способ выполнения
+    unsigned int Threads;   ///< Наибольшее число потоков (0 - все потоки пула), для EM_Sequential не используется
+    std::size_t Chunk;      ///< Размер части пакета (0 - пакет делится поровну между потоками)
+    SIMD::TSimdLevel Simd;  ///< Уровень векторизации для EM_ParallelSimd
+
+    ///
+    /// \brief Параметрический конструктор
+    /// \details Малый размер части (Chunk) выравнивает нагрузку потоков, если время обработки элементов различается
+    /// (части раздаются потокам по мере освобождения), но увеличивает накладные расходы на раздачу
+    /// \param[in] mode    - способ выполнения
+    /// \param[in] threads - наибольшее число потоков (0 - все потоки пула)
+    /// \param[in] chunk   - размер части пакета (0 - поровну между потоками), округляется вверх до ширины вектора
+    /// \param[in] simd    - уровень векторизации для EM_ParallelSimd
+    ///
+    explicit Policy( TMode mode = EM_ParallelSimd, unsigned int threads = 0, std::size_t chunk = 0,
+        SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto ) :
+        Mode( mode ), Threads( threads ), Chunk( chunk ), Simd( simd )
+    {}
+
+    ///
+    /// \brief Политика по параметрам simd и threads пакетных функций без политики
+    /// \param[in] simd    - уровень векторизации
+    /// \param[in] threads - число потоков (0 - все потоки пула)
+    ///
+    Policy( SIMD::TSimdLevel simd, unsigned int threads ) :
+        Mode( EM_ParallelSimd ), Threads( threads ), Chunk( 0 ), Simd( simd )
+    {}
+
+    ///
+    /// \brief Уровень векторизации ядер
+    /// \return SIMD::SL_Scalar для EM_Sequential и EM_Parallel, иначе Simd
+    ///
+    SIMD::TSimdLevel Level() const
+    {
+        return ( Mode == EM_ParallelSimd ) ? Simd : SIMD::TSimdLevel::SL_Scalar;
+    }
+
+    ///
+    /// \brief Наибольшее число потоков
+    /// \return 1 для EM_Sequential, иначе Threads (0 - все потоки пула)
+    ///
+    unsigned int MaxThreads() const
+    {
+        return ( Mode == EM_Sequential ) ? 1 : Threads;
+    }
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Настройка пула потоков
+/// \details Потоки прежнего пула завершаются, создаются новые. Нельзя вызывать одновременно с пакетными функциями
+/// \param[in] threads - число потоков, выполняющих части пакета, включая вызывающий (0 - по числу ядер процессора)
+/// \param[in] pin     - закрепить потоки пула за ядрами процессора (поток i - за ядром i, вызывающий поток не
+///                      закрепляется; только Linux, на других системах не используется)
+///
+void SetPoolThreads( unsigned int threads, bool pin = false );
+
+///
+/// \brief Выполнение задач task( 0 ) ... task( tasks - 1 ) пулом потоков библиотеки с ожиданием их завершения
+/// \details Для работы, не сводящейся к пакетным функциям (например, обработка частей файла): задачи раздаются
+/// потокам по порядку номеров по мере освобождения потоков и завершаются в любом порядке. Правила пула - как у
+/// пакетных функций: вызывающий поток выполняет задачи наравне с потоками пула, вызов из задачи пула и вызов при
+/// занятом пуле выполняются последовательно в вызывающем потоке
+/// \param[in] tasks  - число задач
+/// \param[in] policy - политика выполнения (используется только наибольшее число потоков, MaxThreads)
+/// \param[in] task   - обработчик задачи
+/// \throw Первое исключение обработчика после завершения начатых задач (оставшиеся задачи не выполняются)
+///
+void ParallelTasks( std::size_t tasks, const Policy &policy, const std::function<void( std::size_t )> &task );
+
+///
+/// \brief Число потоков пула
+/// \return Число потоков, выполняющих части пакета, включая вызывающий
+///
+unsigned int PoolThreads();
+
+///
+/// \brief Закрепление потоков пула за ядрами
+/// \return true, если потоки пула закреплены за ядрами процессора
+///
+bool PoolPinned();
+
+} // end namespace Execution
+} // end namespace SPML
+#endif // SPML_EXECUTION_H
+/// \}
@@ -0,0 +1,171 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       geodesic.h
+/// \brief      Геодезические задачи на эллипсоиде по методу Карни (альтернатива формулам Винсента)
+/// \details    Karney, C. F. F. (2013). "Algorithms for geodesics". Journal of Geodesy. 87 (1): 43–55.
+///             \n Ряды по третьему сжатию n и параметру eps до 6-го порядка (погрешность порядка 15 нм для WGS84),
+///             обратная задача - метод Ньютона по азимуту в начальной точке с начальным приближением из решения
+///             астроиды для почти антиподальных точек. Число итераций ограничено (обычно 2-4, не более
+///             CGeodesic::MaxIterations с резервным делением пополам), прямая задача решается без итераций.
+///             \n В отличие от формул Винсента решение существует и сходится для любых пар точек, включая
+///             антиподальные.
+///             \n Порт GeographicLib 2.3 (https://geographiclib.sourceforge.io, файлы Geodesic.hpp, Geodesic.cpp,
+///             Math.hpp, Math.cpp) на типы и единицы измерения SPML.
+///             \n Исходный код GeographicLib:
+///             \n Copyright (c) Charles Karney (2009-2023) <karney@alum.mit.edu> and licensed under the MIT/X11
+///             License. For more information, see https://geographiclib.sourceforge.io/
+///             \n Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+///             associated documentation files (the "Software"), to deal in the Software without restriction,
+///             including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+///             and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+///             subject to the following conditions:
+///             \n The above copyright notice and this permission notice shall be included in all copies or
+///             substantial portions of the Software.
+///             \n THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+///             NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+///             NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+///             OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+///             CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_GEODESIC_H
+#define SPML_GEODESIC_H
+
+// SPML includes:
+#include <geodesy.h>
+#include <units.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Решение геодезических задач на эллипсоиде по методу Карни
+/// \details Коэффициенты рядов, зависящие только от эллипсоида, вычисляются один раз при создании объекта.
+/// Единицы измерения задаются при создании и используются во всех методах (входы и выходы). Азимуты на выходе -
+/// в диапазоне [0, 360) град ( [0, 2PI) рад ), долгота конечной точки прямой задачи не нормируется
+/// (как в RADtoGEO). Объект неизменяем после создания и может использоваться из нескольких потоков
+///
+class CGeodesic
+{
+public:
+    static const int MaxNewtonIterations = 20;  ///< Итераций метода Ньютона обратной задачи
+    static const int MaxIterations = 83;        ///< Всего итераций обратной задачи (Ньютон + деление пополам)
+
+    ///
+    /// \brief Параметрический конструктор
+    /// \param[in] ellipsoid - земной эллипсоид
+    /// \param[in] rangeUnit - единицы измерения дальности
+    /// \param[in] angleUnit - единицы измерения углов
+    ///
+    CGeodesic( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit );
+
+    ///
+    /// \brief Земной эллипсоид
+    /// \return Возвращает эллипсоид, для которого вычислены коэффициенты
+    ///
+    const CEllipsoid &Ellipsoid() const
+    {
+        return ellipsoid;
+    }
+
+    ///
+    /// \brief Единицы измерения дальности
+    /// \return Возвращает единицы измерения дальности входов и выходов методов
+    ///
+    Units::TRangeUnit RangeUnit() const
+    {
+        return rangeUnit;
+    }
+
+    ///
+    /// \brief Единицы измерения углов
+    /// \return Возвращает единицы измерения углов входов и выходов методов
+    ///
+    Units::TAngleUnit AngleUnit() const
+    {
+        return angleUnit;
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    ///
+    /// \brief Обратная геодезическая задача
+    /// \details Для совпадающих точек азимуты равны 0 (как в GEOtoRAD)
+    /// \param[in]  latStart - широта начальной точки
+    /// \param[in]  lonStart - долгота начальной точки
+    /// \param[in]  latEnd   - широта конечной точки
+    /// \param[in]  lonEnd   - долгота конечной точки
+    /// \param[out] d        - расстояние между начальной и конечной точками по геодезической линии
+    /// \param[out] az       - азимут из начальной точки на конечную
+    /// \param[out] azEnd    - прямой азимут в конечной точке
+    /// \return Число выполненных итераций (0 - решение без итераций: меридиан, экватор, близкие точки)
+    ///
+    int Inverse( double latStart, double lonStart, double latEnd, double lonEnd, double &d, double &az,
+        double &azEnd = dummy_double ) const;
+
+    ///
+    /// \brief Прямая геодезическая задача
+    /// \param[in]  latStart - широта начальной точки
+    /// \param[in]  lonStart - долгота начальной точки
+    /// \param[in]  d        - расстояние между начальной и конечной точками по геодезической линии
+    /// \param[in]  az       - азимут из начальной точки на конечную
+    /// \param[out] latEnd   - широта конечной точки
+    /// \param[out] lonEnd   - долгота конечной точки
+    /// \param[out] azEnd    - прямой азимут в конечной точке
+    ///
+    void Direct( double latStart, double lonStart, double d, double az, double &latEnd, double &lonEnd,
+        double &azEnd = dummy_double ) const;
+
+private:
+    static const int nA3 = 6;   ///< Порядок ряда A3
+    static const int nC3 = 6;   ///< Порядок рядов C3
+
+    CEllipsoid ellipsoid;           ///< Земной эллипсоид
+    Units::TRangeUnit rangeUnit;    ///< Единицы измерения дальности
+    Units::TAngleUnit angleUnit;    ///< Единицы измерения углов
+
+    double a;       ///< Большая полуось [м]
+    double b;       ///< Малая полуось [м]
+    double f;       ///< Сжатие
+    double f1;      ///< 1 - f
+    double ep2;     ///< Квадрат второго эксцентриситета
+    double n;       ///< Третье сжатие f / ( 2 - f )
+    double etol2;   ///< Порог для решения близких точек без итераций
+    double A3x[nA3];            ///< Коэффициенты A3 по степеням eps (зависят от n)
+    double C3x[( nC3 * ( nC3 - 1 ) ) / 2]; ///< Коэффициенты C3 по степеням eps (зависят от n)
+
+    // Обратная задача в градусах и метрах, возвращает число итераций
+    int InverseDeg( double lat1, double lon1, double lat2, double lon2, double &s12, double &azi1, double &azi2 ) const;
+
+    // Прямая задача в градусах и метрах, lon12 - приращение долготы (без нормировки)
+    void DirectDeg( double lat1, double azi1, double s12, double &lat2, double &lon12, double &azi2 ) const;
+
+    // Ряд A3( eps )
+    double A3f( double eps ) const;
+
+    // Коэффициенты ряда C3( eps ), c[1..nC3-1]
+    void C3f( double eps, double c[] ) const;
+
+    // Длина дуги и приведенная длина по сферической дуге (вспомогательная сфера)
+    void Lengths( double eps, double sig12, double ssig1, double csig1, double dn1, double ssig2, double csig2,
+        double dn2, double *s12b, double *m12b, double *m0 ) const;
+
+    // Начальное приближение азимута обратной задачи, для близких точек - готовое решение (возвращает sig12 >= 0)
+    double InverseStart( double sbet1, double cbet1, double dn1, double sbet2, double cbet2, double dn2, double lam12,
+        double slam12, double clam12, double &salp1, double &calp1, double &salp2, double &calp2, double &dnm ) const;
+
+    // Невязка по долготе для азимута alp1 и ее производная
+    double Lambda12( double sbet1, double cbet1, double dn1, double sbet2, double cbet2, double dn2, double salp1,
+        double calp1, double slam120, double clam120, double &salp2, double &calp2, double &sig12, double &ssig1,
+        double &csig1, double &ssig2, double &csig2, double &eps, bool diffp, double &dlam12 ) const;
+};
+
+} // end namespace Geodesy
+} // end namespace SPML
+#endif // SPML_GEODESIC_H
+/// \}
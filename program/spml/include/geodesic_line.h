@@ -0,0 +1,189 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       geodesic_line.h
+/// \brief      Геодезическая линия с фиксированной начальной точкой и азимутом (расчет промежуточных точек)
+/// \details    При сгущении маршрута RADtoGEO вызывается многократно с одной начальной точкой и азимутом: величины
+///             формул Винсента, зависящие только от них (sigma1, sinAlpha, uSq, A, B), вычисляются один раз при
+///             создании объекта, на каждую точку остается только итерация по sigma.
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_GEODESIC_LINE_H
+#define SPML_GEODESIC_LINE_H
+
+// System includes:
+#include <cstddef>
+
+// SPML includes:
+#include <geodesy.h>
+#include <units.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Геодезическая линия, заданная начальной точкой и азимутом
+/// \details Единицы измерения задаются при создании и используются во всех методах (входы и выходы). Координаты
+/// точек совпадают с RADtoGEO для той же начальной точки и азимута с точностью до порядка операций с плавающей
+/// точкой (порядка 1e-15 рад). Долгота не нормируется (как в RADtoGEO), азимуты - в диапазоне [0, 360) град
+/// ( [0, 2PI) рад ). Объект неизменяем после создания и может использоваться из нескольких потоков
+///
+class CGeodesicLine
+{
+public:
+    ///
+    /// \brief Параметрический конструктор: линия из начальной точки по азимуту
+    /// \param[in] ellipsoid - земной эллипсоид
+    /// \param[in] rangeUnit - единицы измерения дальности
+    /// \param[in] angleUnit - единицы измерения углов
+    /// \param[in] latStart  - широта начальной точки
+    /// \param[in] lonStart  - долгота начальной точки
+    /// \param[in] az        - азимут в начальной точке
+    /// \param[in] d         - длина линии (используется методами по доле длины и Waypoints)
+    ///
+    CGeodesicLine( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+        double latStart, double lonStart, double az, double d = 0.0 );
+
+    ///
+    /// \brief Линия между двумя точками (через обратную геодезическую задачу)
+    /// \details Азимут в начальной точке и длина линии определяются выбранным методом обратной задачи, точки на
+    /// линии всегда вычисляются по формулам Винсента (прямая задача сходится и для почти антиподальных точек,
+    /// поэтому для них рекомендуется GM_Karney)
+    /// \param[in] ellipsoid - земной эллипсоид
+    /// \param[in] rangeUnit - единицы измерения дальности
+    /// \param[in] angleUnit - единицы измерения углов
+    /// \param[in] latStart  - широта начальной точки
+    /// \param[in] lonStart  - долгота начальной точки
+    /// \param[in] latEnd    - широта конечной точки
+    /// \param[in] lonEnd    - долгота конечной точки
+    /// \param[in] method    - метод решения обратной задачи
+    /// \return Геодезическая линия из начальной точки в конечную, длина линии - расстояние между точками
+    ///
+    static CGeodesicLine FromPoints( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+        const Units::TAngleUnit &angleUnit, double latStart, double lonStart, double latEnd, double lonEnd,
+        TGeodesicMethod method = GM_Vincenty );
+
+    ///
+    /// \brief Земной эллипсоид
+    /// \return Возвращает эллипсоид, на котором задана линия
+    ///
+    const CEllipsoid &Ellipsoid() const
+    {
+        return ellipsoid;
+    }
+
+    ///
+    /// \brief Единицы измерения дальности
+    /// \return Возвращает единицы измерения дальности входов и выходов методов
+    ///
+    Units::TRangeUnit RangeUnit() const
+    {
+        return rangeUnit;
+    }
+
+    ///
+    /// \brief Единицы измерения углов
+    /// \return Возвращает единицы измерения углов входов и выходов методов
+    ///
+    Units::TAngleUnit AngleUnit() const
+    {
+        return angleUnit;
+    }
+
+    ///
+    /// \brief Начальная точка линии
+    /// \return Возвращает широту и долготу начальной точки в единицах объекта
+    ///
+    Geographic Start() const;
+
+    ///
+    /// \brief Азимут в начальной точке
+    /// \return Возвращает азимут в начальной точке в единицах объекта
+    ///
+    double Azimuth() const;
+
+    ///
+    /// \brief Длина линии
+    /// \return Возвращает длину линии в единицах объекта (0, если не задана)
+    ///
+    double Distance() const;
+
+    //------------------------------------------------------------------------------------------------------------------
+    ///
+    /// \brief Точка на линии на заданном расстоянии от начальной
+    /// \param[in]  d     - расстояние от начальной точки (может быть отрицательным и больше длины линии)
+    /// \param[out] lat   - широта точки
+    /// \param[out] lon   - долгота точки
+    /// \param[out] azEnd - прямой азимут в точке
+    ///
+    void Position( double d, double &lat, double &lon, double &azEnd = dummy_double ) const;
+
+    ///
+    /// \brief Точка на линии на заданной доле длины линии
+    /// \param[in]  fraction - доля длины линии (0 - начальная точка, 1 - конечная)
+    /// \param[out] lat      - широта точки
+    /// \param[out] lon      - долгота точки
+    /// \param[out] azEnd    - прямой азимут в точке
+    ///
+    void PositionAtFraction( double fraction, double &lat, double &lon, double &azEnd = dummy_double ) const;
+
+    ///
+    /// \brief Пакетный расчет точек на линии по расстояниям от начальной
+    /// \param[in]  d     - массив расстояний от начальной точки
+    /// \param[in]  count - размер массивов
+    /// \param[out] lat   - массив широт
+    /// \param[out] lon   - массив долгот
+    /// \param[out] azEnd - массив прямых азимутов в точках (может быть nullptr)
+    ///
+    void Positions( const double *d, std::size_t count, double *lat, double *lon, double *azEnd = nullptr ) const;
+
+    ///
+    /// \brief Равномерно распределенные по длине линии точки, включая начальную и конечную
+    /// \details Точка i находится на расстоянии Distance() * i / ( count - 1 ), при count = 1 - начальная точка
+    /// \param[in]  count - число точек (размер массивов)
+    /// \param[out] lat   - массив широт
+    /// \param[out] lon   - массив долгот
+    /// \param[out] azEnd - массив прямых азимутов в точках (может быть nullptr)
+    ///
+    void Waypoints( std::size_t count, double *lat, double *lon, double *azEnd = nullptr ) const;
+
+private:
+    CEllipsoid ellipsoid;           ///< Земной эллипсоид
+    Units::TRangeUnit rangeUnit;    ///< Единицы измерения дальности
+    Units::TAngleUnit angleUnit;    ///< Единицы измерения углов
+    double rangeIn;                 ///< Множитель перевода входной дальности в [м]
+    double rangeOut;                ///< Множитель перевода [м] в выходную дальность
+    double angleIn;                 ///< Множитель перевода входных углов в [рад]
+    double angleOut;                ///< Множитель перевода [рад] в выходные углы
+
+    double lat1;                    ///< Широта начальной точки, [рад]
+    double lon1;                    ///< Долгота начальной точки, [рад]
+    double az1;                     ///< Азимут в начальной точке, [рад]
+    double s13;                     ///< Длина линии, [м]
+    bool isSphere;                  ///< Расчет на сфере (упрощенные формулы, как в RADtoGEO)
+
+    // Величины, зависящие только от начальной точки и азимута:
+    double sinAlpha1, cosAlpha1;    ///< Синус и косинус азимута в начальной точке
+    double sinU1, cosU1;            ///< Синус и косинус приведенной широты (на сфере - широты) начальной точки
+    double sin2Sigma1, cos2Sigma1;  ///< Синус и косинус 2 * sigma1 (eq. 1)
+    double sinAlpha;                ///< Синус азимута геодезической на экваторе (eq. 2)
+    double cosSqAlpha;              ///< Квадрат косинуса азимута на экваторе
+    double oneMinusF;               ///< 1 - f
+    double B;                       ///< Коэффициент B (eq. 4)
+    double bA;                      ///< b * A (eq. 3)
+    double fC;                      ///< ( 1 - C ) * f * sinAlpha (eq. 10, 11)
+    double C;                       ///< Коэффициент C (eq. 10)
+
+    // Точка на расстоянии s [м], результат в [рад], долгота - приращение относительно начальной точки
+    void Point( double s, double &lat, double &dLon, double &azEnd ) const;
+};
+
+} // end namespace Geodesy
+} // end namespace SPML
+#endif // SPML_GEODESIC_LINE_H
+/// \}
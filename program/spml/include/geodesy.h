@@ -20,6 +20,7 @@
 // SPML includes:
 #include <compare.h>
 #include <convert.h>
+#include <geodesy_registry.h>
 #include <units.h>
 
 namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
@@ -29,6 +30,8 @@ namespace Geodesy /// Геодезические функции и функци
 //----------------------------------------------------------------------------------------------------------------------
 ///
 /// \brief Земной эллипсоид
+/// \details Производные параметры (эксцентриситеты, 1 - f, b / a, коэффициенты Олсона) вычисляются один раз
+/// при создании эллипсоида
 ///
 class CEllipsoid
 {
@@ -84,7 +87,7 @@ public:
     ///
     double EccentricityFirst() const
     {
-        return ( std::sqrt( ( a * a ) - ( b * b ) ) / a );
+        return e1;
     }
 
     ///
@@ -93,7 +96,7 @@ public:
     ///
     double EccentricityFirstSquared() const
     {
-        return ( 1.0 - ( ( b * b ) / ( a * a ) ) );
+        return es1;
     }
 
     ///
@@ -102,7 +105,7 @@ public:
     ///
     double EccentricitySecond() const
     {
-        return ( std::sqrt( ( a * a ) - ( b * b ) ) / b );
+        return e2;
     }
 
     ///
@@ -111,7 +114,34 @@ public:
     ///
     double EccentricitySecondSquared() const
     {
-        return ( ( ( a * a ) / ( b * b ) ) - 1.0 );
+        return es2;
+    }
+
+    ///
+    /// \brief Величина 1 - f (отношение тангенсов приведенной и геодезической широт)
+    /// \return Возвращает 1 - f
+    ///
+    double OneMinusF() const
+    {
+        return oneMinusF;
+    }
+
+    ///
+    /// \brief Отношение полуосей b / a
+    /// \return Возвращает отношение малой полуоси к большой
+    ///
+    double AxisRatio() const
+    {
+        return axisRatio;
+    }
+
+    ///
+    /// \brief Коэффициенты алгоритма Олсона пересчета ECEF в географические координаты
+    /// \return Возвращает коэффициенты a1..a6
+    ///
+    const OlsonCoefficients &Olson() const
+    {
+        return olson;
     }
 
     ///
@@ -129,12 +159,32 @@ public:
     ///
     CEllipsoid( std::string ellipsoidName, double semiMajorAxis, double semiMinorAxis, double inverseFlattening, bool isInvfDef );
 
+    ///
+    /// \brief Конструктор эллипсоида по параметрам из реестра
+    /// \param[in] params - параметры эллипсоида (см. geodesy_registry.h)
+    ///
+    explicit CEllipsoid( const TEllipsoidParams &params );
+
 private: // Доступ к параметрам эллипсоида после его создания не предполагается, поэтому private
     std::string name;   ///< Название эллипсоида
     double a;           ///< Большая полуось (экваториальный радиус), [м]
     double b;           ///< Малая полуось (полярный радиус) , [м]
     double invf;        ///< Обратное сжатие invf = a / ( a - b )
     double f;           ///< Сжатие f = ( a - b ) / a
+
+    // Производные параметры (вычисляются при создании эллипсоида):
+    double e1;                  ///< Первый эксцентриситет
+    double es1;                 ///< Квадрат первого эксцентриситета
+    double e2;                  ///< Второй эксцентриситет
+    double es2;                 ///< Квадрат второго эксцентриситета
+    double oneMinusF;           ///< 1 - f
+    double axisRatio;           ///< b / a
+    OlsonCoefficients olson;    ///< Коэффициенты алгоритма Олсона
+
+    ///
+    /// \brief Расчет производных параметров по a, b, f
+    ///
+    void InitDerived();
 };
 
 namespace Ellipsoids /// Земные эллипсоиды
@@ -150,97 +200,107 @@ namespace Ellipsoids /// Земные эллипсоиды
 //  5) Сфера радиусом 6371000.0 [м], https://epsg.io/7035-ellipsoid
 //  6) Сфера радиусом 6378000.0 [м]
 //  7) Сфера радиусом большой полуоси эллипсоида Красовского 1940 (6378245.0 [м])
+//  8) Австралийский национальный сфероид, https://epsg.io/7003-ellipsoid
+//  9) Эллипсоид ГСК-2011, https://epsg.io/1025-ellipsoid
+//
+// Эллипсоиды создаются один раз при первом обращении по параметрам реестра (geodesy_registry.h), функции
+// возвращают ссылку на созданный эллипсоид
 //
 
+///
+/// \brief Предопределенный эллипсоид по идентификатору
+/// \param[in] id - идентификатор эллипсоида
+/// \return Ссылка на эллипсоид (без выделения памяти, кроме первого обращения)
+///
+const CEllipsoid &Get( TEllipsoidId id );
+
 ///
 /// \brief Эллипсоид WGS84 (EPSG:7030)
 /// \details Главная полуось 6378137.0, обратное сжатие 298.257223563
 ///
-static CEllipsoid WGS84()
+inline const CEllipsoid &WGS84()
 {
-    return CEllipsoid( "WGS84 (EPSG:7030)", 6378137.0, 0.0, 298.257223563, true );
+    return Get( TEllipsoidId::EL_WGS84 );
 }
 
 ///
 /// \brief Эллипсоид GRS80 (EPSG:7019)
 /// \details Главная полуось 6378137.0, обратное сжатие 298.257222101
 ///
-static CEllipsoid GRS80()
+inline const CEllipsoid &GRS80()
 {
-    return CEllipsoid( "GRS80 (EPSG:7019)", 6378137.0, 0.0, 298.257222101, true );
+    return Get( TEllipsoidId::EL_GRS80 );
 }
 
 ///
 /// \brief Эллипсоид ПЗ-90 (EPSG:7054)
 /// \details Главная полуось 6378136.0, обратное сжатие 298.257839303
 ///
-static CEllipsoid PZ90()
+inline const CEllipsoid &PZ90()
 {
-    return CEllipsoid( "PZ90 (EPSG:7054)", 6378136.0, 0.0, 298.257839303, true );
+    return Get( TEllipsoidId::EL_PZ90 );
 }
 
 ///
 /// \brief Эллипсоид Красовского 1940 (EPSG:7024)
 /// \details Главная полуось 6378245.0, обратное сжатие 298.3
 ///
-static CEllipsoid Krassowsky1940()
+inline const CEllipsoid &Krassowsky1940()
 {
-    return CEllipsoid( "Krasovsky1940 (EPSG:7024)", 6378245.0, 0.0, 298.3, true );
+    return Get( TEllipsoidId::EL_Krassowsky1940 );
 }
 
-
 ///
 /// \brief Сфера радиусом 6371000.0 [м] (EPSG:7035)
-/// \details Обратное сжатие - бесконечность
+/// \details Сжатие и обратное сжатие равны 0
 ///
-static CEllipsoid Sphere6371()
+inline const CEllipsoid &Sphere6371()
 {
-    return CEllipsoid( "Sphere 6371000.0 [м] (EPSG:7035)", 6371000.0, 6371000.0, 0.0, false );
+    return Get( TEllipsoidId::EL_Sphere6371 );
 }
 
 ///
 /// \brief Сфера радиусом 6378000.0 [м]
-/// \details Обратное сжатие - бесконечность
+/// \details Сжатие и обратное сжатие равны 0
 ///
-
-static CEllipsoid Sphere6378()
+inline const CEllipsoid &Sphere6378()
 {
-    return CEllipsoid( "Sphere 6378000.0 [м]", 6378000.0, 6378000.0, 0.0, false );
+    return Get( TEllipsoidId::EL_Sphere6378 );
 }
 
 ///
 /// \brief Сфера радиусом большой полуоси эллипсоида Красовского 1940 (EPSG:7024)
-/// \details Обратное сжатие - бесконечность
+/// \details Сжатие и обратное сжатие равны 0
 ///
-static CEllipsoid SphereKrassowsky1940()
+inline const CEllipsoid &SphereKrassowsky1940()
 {
-    return CEllipsoid( "SphereRadiusKrasovsky1940 (EPSG:7024)", 6378245.0, 6378245.0, 0.0, false );
+    return Get( TEllipsoidId::EL_SphereKrassowsky1940 );
 }
 
-static CEllipsoid ADG66()
+///
+/// \brief Австралийский национальный сфероид (AGD66) (EPSG:7003)
+/// \details Главная полуось 6378160.0, обратное сжатие 298.25
+///
+inline const CEllipsoid &ADG66()
 {
-    return CEllipsoid( "Australian Geodetic Datum 1966/84 (AGD) (EPSG:?)", 6378160.0, 0.0, 298.25, true );
+    return Get( TEllipsoidId::EL_AGD66 );
 }
 
 ///
-/// \brief Возвращает доступные предопределенные эллипсоидоы
-/// \return Вектор предопределенных эллипсоидов
+/// \brief Эллипсоид ГСК-2011 (EPSG:1025)
+/// \details Главная полуось 6378136.5, обратное сжатие 298.2564151
 ///
-[[maybe_unused]]
-static const __attribute__ ((unused)) std::vector<CEllipsoid> GetPredefinedEllipsoids()
+inline const CEllipsoid &GSK2011()
 {
-    return std::vector<CEllipsoid>{        
-        WGS84(),
-        GRS80(),
-        PZ90(),
-        Krassowsky1940(),
-        Sphere6371(),
-        Sphere6378(),
-        SphereKrassowsky1940(),
-        ADG66()
-    };
+    return Get( TEllipsoidId::EL_GSK2011 );
 }
 
+///
+/// \brief Возвращает доступные предопределенные эллипсоиды
+/// \return Вектор предопределенных эллипсоидов (порядок совпадает с TEllipsoidId), создается один раз
+///
+const std::vector<CEllipsoid> &GetPredefinedEllipsoids();
+
 } // end namespace Ellipsoids
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -451,6 +511,17 @@ static double dummy_double; // Заглушка для списка параме
 void GEOtoRAD( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     double latStart, double lonStart, double latEnd, double lonEnd, double &d, double &az, double &azEnd = dummy_double );
 
+///
+/// \brief Пересчет географических координат в радиолокационные (Обратная геодезическая задача)
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void GEOtoRAD( const CEllipsoid &ellipsoid,
+    double latStart, double lonStart, double latEnd, double lonEnd, double &d, double &az, double &azEnd = dummy_double );
+
 ///
 /// \brief Пересчет географических координат в радиолокационные (Обратная геодезическая задача)
 /// \details    Расчет на эллипсоиде по формулам Винсента:
@@ -491,6 +562,17 @@ RAD GEOtoRAD( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, c
 void RADtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     double latStart, double lonStart, double d, double az, double &latEnd, double &lonEnd, double &azEnd = dummy_double );
 
+///
+/// \brief Пересчет радиолокационных координат в географические (Прямая геодезическая задача)
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void RADtoGEO( const CEllipsoid &ellipsoid,
+    double latStart, double lonStart, double d, double az, double &latEnd, double &lonEnd, double &azEnd = dummy_double );
+
 ///
 /// \brief Пересчет радиолокационных координат в географические (Прямая геодезическая задача)
 /// \details    Расчет на эллипсоиде по формулам Винсента:
@@ -510,6 +592,39 @@ void RADtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
 Geographic RADtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     const Geographic &start, const RAD &rad, double &azEnd = dummy_double );
 
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Метод решения геодезических задач на эллипсоиде
+///
+enum TGeodesicMethod : int
+{
+    GM_Vincenty = 0,    ///< Формулы Винсента: быстрее, но до 100 (обратная) и 1000 (прямая) итераций, не сходятся
+                        ///< для почти антиподальных точек
+    GM_Karney           ///< Метод Карни (см. geodesic.h): ограниченное малое число итераций, сходится для любых точек
+};
+
+///
+/// \brief Пересчет географических координат в радиолокационные (Обратная геодезическая задача) с выбором метода
+/// \details GM_Vincenty - то же, что GEOtoRAD без параметра метода; GM_Karney - CGeodesic::Inverse (в т.ч. на сфере).
+///          Коэффициенты метода Карни кэшируются в потоке для последнего эллипсоида. Параметры совпадают
+///          с параметрами GEOtoRAD
+/// \param[in] method - метод решения на эллипсоиде
+///
+void GEOtoRAD( const CEllipsoid &ellipsoid, TGeodesicMethod method, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, double latStart, double lonStart, double latEnd, double lonEnd, double &d,
+    double &az, double &azEnd = dummy_double );
+
+///
+/// \brief Пересчет радиолокационных координат в географические (Прямая геодезическая задача) с выбором метода
+/// \details GM_Vincenty - то же, что RADtoGEO без параметра метода; GM_Karney - CGeodesic::Direct (в т.ч. на сфере).
+///          Коэффициенты метода Карни кэшируются в потоке для последнего эллипсоида. Параметры совпадают
+///          с параметрами RADtoGEO
+/// \param[in] method - метод решения на эллипсоиде
+///
+void RADtoGEO( const CEllipsoid &ellipsoid, TGeodesicMethod method, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, double latStart, double lonStart, double d, double az, double &latEnd,
+    double &lonEnd, double &azEnd = dummy_double );
+
 //----------------------------------------------------------------------------------------------------------------------
 ///
 /// \brief Пересчет широты, долготы, высоты в декартовые геоцентрические координаты
@@ -533,6 +648,16 @@ Geographic RADtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &range
 void GEOtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     double lat, double lon, double h, double &x, double &y, double &z );
 
+///
+/// \brief Пересчет широты, долготы, высоты в декартовые геоцентрические координаты
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void GEOtoECEF( const CEllipsoid &ellipsoid, double lat, double lon, double h, double &x, double &y, double &z );
+
 ///
 /// \brief Пересчет широты, долготы, высоты в декартовые геоцентрические координаты
 /// \details    EPSG:9602,
@@ -574,6 +699,17 @@ XYZ GEOtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
 void ECEFtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     double x, double y, double z, double &lat, double &lon, double &h );
 
+///
+/// \brief Пересчет декартовых геоцентрических координат в широту, долготу, высоту
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ECEFtoGEO( const CEllipsoid &ellipsoid,
+    double x, double y, double z, double &lat, double &lon, double &h );
+
 ///
 /// \brief Пересчет декартовых геоцентрических координат в широту, долготу, высоту
 /// \details    Декартовые геоцентрические координаты (ECEF):
@@ -635,6 +771,17 @@ double XYZtoDistance( const XYZ &point1, const XYZ &point2 );
 void ECEF_offset( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     double lat1, double lon1, double h1, double lat2, double lon2, double h2, double &dX, double &dY, double &dZ );
 
+///
+/// \brief ECEF смещение ( разница в декартовых ECEF координатах двух точек )
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ECEF_offset( const CEllipsoid &ellipsoid,
+    double lat1, double lon1, double h1, double lat2, double lon2, double h2, double &dX, double &dY, double &dZ );
+
 ///
 /// \brief ECEF смещение ( разница в декартовых ECEF координатах двух точек )
 /// \param[in] ellipsoid - земной эллипсоид
@@ -667,6 +814,17 @@ XYZ ECEF_offset( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit
 void ECEFtoENU( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     double x, double y, double z, double lat, double lon, double h, double &xEast, double &yNorth, double &zUp );
 
+///
+/// \brief Перевод ECEF координат точки в ENU относительно географических координат опорной точки (lat, lon)
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ECEFtoENU( const CEllipsoid &ellipsoid,
+    double x, double y, double z, double lat, double lon, double h, double &xEast, double &yNorth, double &zUp );
+
 ///
 /// \brief Перевод ECEF координат точки в ENU относительно  географических координат опорной точки point
 /// \details https://gssc.esa.int/navipedia/index.php/Transformations_between_ECEF_and_ENU_coordinates
@@ -697,6 +855,34 @@ ENU ECEFtoENU( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
 void ECEFtoENUV( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     double dX, double dY, double dZ, double lat, double lon, double &xEast, double &yNorth, double &zUp );
 
+///
+/// \brief Перевод ECEF координат точки в ENU относительно географических координат (lat, lon)
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ECEFtoENUV( double dX, double dY, double dZ, double lat, double lon, double &xEast, double &yNorth, double &zUp );
+
+///
+/// \brief Перевод ECEF координат точки в ENU относительно географических координат (lat, lon) (float)
+/// \details Вариант одинарной точности: вычисления в float, параметры совпадают с параметрами функции double.
+///          Отличие от варианта double для тех же входных значений не превышает 4e-7 относительно длины смещения
+///          (0.2 м на 500 км, см. также ECEFtoENUV_Batch в geodesy_batch.h)
+///
+void ECEFtoENUV( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    float dX, float dY, float dZ, float lat, float lon, float &xEast, float &yNorth, float &zUp );
+
+///
+/// \brief Перевод ECEF координат точки в ENU относительно географических координат (lat, lon) (float)
+/// \details Вариант одинарной точности с единицами измерения, заданными при компиляции
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ECEFtoENUV( float dX, float dY, float dZ, float lat, float lon, float &xEast, float &yNorth, float &zUp );
+
 ///
 /// \brief Перевод ECEF координат точки в ENU относительно географических координат point
 /// \param[in] rangeUnit - единицы измерения дальности
@@ -728,6 +914,17 @@ ENU ECEFtoENUV( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &ang
 void ENUtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     double e, double n, double u, double lat, double lon, double h, double &x, double &y, double &z );
 
+///
+/// \brief Перевод ENU координат точки в ECEF относительно географических координат опорной точки (lat, lon)
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ENUtoECEF( const CEllipsoid &ellipsoid,
+    double e, double n, double u, double lat, double lon, double h, double &x, double &y, double &z );
+
 ///
 /// \brief Перевод ENU координат точки в ECEF относительно географических координат точки point
 /// \details https://gssc.esa.int/navipedia/index.php/Transformations_between_ECEF_and_ENU_coordinates
@@ -756,6 +953,34 @@ XYZ ENUtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
 void ENUtoAER( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     double xEast, double yNorth, double zUp, double &az, double &elev, double &slantRange );
 
+///
+/// \brief Перевод ENU координат точки в AER координаты
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ENUtoAER( double xEast, double yNorth, double zUp, double &az, double &elev, double &slantRange );
+
+///
+/// \brief Перевод ENU координат точки в AER координаты (float)
+/// \details Вариант одинарной точности: вычисления в float, параметры совпадают с параметрами функции double.
+///          Для дальностей до 1000 км отличие от варианта double для тех же входных значений не превышает 3e-7
+///          относительно наклонной дальности и 1e-6 рад (0.2 угл. сек) по углам
+///
+void ENUtoAER( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    float xEast, float yNorth, float zUp, float &az, float &elev, float &slantRange );
+
+///
+/// \brief Перевод ENU координат точки в AER координаты (float)
+/// \details Вариант одинарной точности с единицами измерения, заданными при компиляции
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ENUtoAER( float xEast, float yNorth, float zUp, float &az, float &elev, float &slantRange );
+
 ///
 /// \brief Перевод ENU координат точки в AER координаты
 /// \param[in] rangeUnit  - единицы измерения дальности
@@ -780,6 +1005,34 @@ AER ENUtoAER( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angle
 void AERtoENU( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     double az, double elev, double slantRange, double &xEast, double &yNorth, double &zUp );
 
+///
+/// \brief Перевод AER координат точки в ENU координаты
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void AERtoENU( double az, double elev, double slantRange, double &xEast, double &yNorth, double &zUp );
+
+///
+/// \brief Перевод AER координат точки в ENU координаты (float)
+/// \details Вариант одинарной точности: вычисления в float, параметры совпадают с параметрами функции double.
+///          Отличие от варианта double для тех же входных значений не превышает 5e-7 относительно наклонной
+///          дальности (0.25 м на 500 км)
+///
+void AERtoENU( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    float az, float elev, float slantRange, float &xEast, float &yNorth, float &zUp );
+
+///
+/// \brief Перевод AER координат точки в ENU координаты (float)
+/// \details Вариант одинарной точности с единицами измерения, заданными при компиляции
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void AERtoENU( float az, float elev, float slantRange, float &xEast, float &yNorth, float &zUp );
+
 ///
 /// \brief Перевод ENU коордиат точки в AER координаты
 /// \param[in] rangeUnit  - единицы измерения дальности
@@ -808,6 +1061,17 @@ ENU AERtoENU( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angle
 void GEOtoENU( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     double lat, double lon, double h, double lat0, double lon0, double h0, double &xEast, double &yNorth, double &zUp );
 
+///
+/// \brief Перевод геодезических координат GEO точки point в координаты ENU относительно опорной точки
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void GEOtoENU( const CEllipsoid &ellipsoid,
+    double lat, double lon, double h, double lat0, double lon0, double h0, double &xEast, double &yNorth, double &zUp );
+
 ///
 /// \brief Перевод геодезических координат GEO точки point в координаты ENU относительно опорной точки
 /// \param[in] ellipsoid - земной эллипсоид
@@ -840,6 +1104,17 @@ ENU GEOtoENU( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, c
 void ENUtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     double xEast, double yNorth, double zUp, double lat0, double lon0, double h0, double &lat, double &lon, double &h );
 
+///
+/// \brief Перевод координат ENU в геодезические координаты GEO относительно опорной точки
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ENUtoGEO( const CEllipsoid &ellipsoid,
+    double xEast, double yNorth, double zUp, double lat0, double lon0, double h0, double &lat, double &lon, double &h );
+
 ///
 /// \brief Перевод координат ENU в геодезические координаты GEO относительно опорной точки
 /// \param[in] ellipsoid - земной эллипсоид
@@ -871,6 +1146,17 @@ Geodetic ENUtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUn
 void GEOtoAER( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     double lat1, double lon1, double h1, double lat2, double lon2, double h2, double &az, double &elev, double &slantRange );
 
+///
+/// \brief Вычисление AER координат между двумя геодезическими точками
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void GEOtoAER( const CEllipsoid &ellipsoid,
+    double lat1, double lon1, double h1, double lat2, double lon2, double h2, double &az, double &elev, double &slantRange );
+
 ///
 /// \brief Вычисление AER координат между двумя геодезическими точками
 /// \param[in]  ellipsoid  - земной эллипсоид
@@ -902,6 +1188,17 @@ AER GEOtoAER( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, c
 void AERtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
      double az, double elev, double slantRange, double lat0, double lon0, double h0, double &lat, double &lon, double &h );
 
+///
+/// \brief Перевод AER координат в геодезические относительно опорной точки
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void AERtoGEO( const CEllipsoid &ellipsoid,
+    double az, double elev, double slantRange, double lat0, double lon0, double h0, double &lat, double &lon, double &h );
+
 ///
 /// \brief Перевод AER координат в геодезические относительно опорной точки
 /// \param[in]  ellipsoid  - земной эллипсоид
@@ -933,6 +1230,17 @@ Geodetic AERtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUn
 void AERtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
      double az, double elev, double slantRange, double lat0, double lon0, double h0, double &x, double &y, double &z );
 
+///
+/// \brief Перевод AER координат относительно опорной точки в глобальные декартовые
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void AERtoECEF( const CEllipsoid &ellipsoid,
+    double az, double elev, double slantRange, double lat0, double lon0, double h0, double &x, double &y, double &z );
+
 ///
 /// \brief Перевод AER координат относительно опорной точки в глобальные декартовые
 /// \param[in]  ellipsoid  - земной эллипсоид
@@ -963,6 +1271,17 @@ XYZ AERtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
 void ECEFtoAER( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     double x, double y, double z, double lat0, double lon0, double h0, double &az, double &elev, double &slantRange );
 
+///
+/// \brief Перевод AER координат относительно опорной точки в глобальные декартовые
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ECEFtoAER( const CEllipsoid &ellipsoid,
+    double x, double y, double z, double lat0, double lon0, double h0, double &az, double &elev, double &slantRange );
+
 ///
 /// \brief Перевод AER координат относительно опорной точки в глобальные декартовые
 /// \param[in]  ellipsoid  - земной эллипсоид
@@ -992,6 +1311,36 @@ AER ECEFtoAER(const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, c
 void ENUtoUVW( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     double xEast, double yNorth, double zUp, double lat0, double lon0, double &u, double &v, double &w );
 
+///
+/// \brief Перевод ENU координат точки в UVW координаты
+/// \details Вариант с единицами измерения, заданными при компиляции (без ветвлений по единицам измерения).
+///          Параметры совпадают с параметрами функции с единицами измерения, заданными во время выполнения
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ENUtoUVW( const CEllipsoid &ellipsoid,
+    double xEast, double yNorth, double zUp, double lat0, double lon0, double &u, double &v, double &w );
+
+///
+/// \brief Перевод ENU координат точки в UVW координаты (float)
+/// \details Вариант одинарной точности: вычисления в float, параметры совпадают с параметрами функции double.
+///          Отличие от варианта double для тех же входных значений не превышает 4e-7 относительно длины смещения
+///          (0.2 м на 500 км)
+///
+void ENUtoUVW( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    float xEast, float yNorth, float zUp, float lat0, float lon0, float &u, float &v, float &w );
+
+///
+/// \brief Перевод ENU координат точки в UVW координаты (float)
+/// \details Вариант одинарной точности с единицами измерения, заданными при компиляции
+/// \tparam RU - единицы измерения дальности
+/// \tparam AU - единицы измерения углов
+///
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ENUtoUVW( const CEllipsoid &ellipsoid,
+    float xEast, float yNorth, float zUp, float lat0, float lon0, float &u, float &v, float &w );
+
 ///
 /// \brief Перевод ENU координат точки в UVW координаты
 /// \details https://gssc.esa.int/navipedia/index.php/Transformations_between_ECEF_and_ENU_coordinates
@@ -1221,23 +1570,6 @@ private:
     double s;
 };
 
-//----------------------------------------------------------------------------------------------------------------------
-///
-/// \brief Геодезический датум
-///
-enum TGeodeticDatum : int
-{
-    GD_WGS84 = 0,
-    GD_PZ90 = 1,
-    GD_PZ9002 = 2,
-    GD_PZ9011 = 3,
-    GD_SK95 = 4,
-    GD_SK42 = 5,
-    GD_GSK2011 = 6,
-    GD_ITRF2008 = 7,
-    GD_AGD66 = 8
-};
-
 //----------------------------------------------------------------------------------------------------------------------
 //                                             Параметры переводов
 //---------------------------------
@@ -1363,6 +1695,15 @@ CShiftECEF_3 GetShiftECEF_3( const TGeodeticDatum &from, const TGeodeticDatum &t
 ///
 CShiftECEF_7 GetShiftECEF_7( const TGeodeticDatum &from, const TGeodeticDatum &to );
 
+///
+/// \brief Заданы ли параметры перевода из СК 'from' в СК 'to' (GetShiftECEF_7)
+/// \details Для других пар СК GetShiftECEF_7 и ECEFtoECEF_7params по датумам не определены
+/// \param from - СК, из которой переводят
+/// \param to - СК, в которую переводят
+/// \return true, если параметры перевода заданы
+///
+bool IsShiftECEF_7Defined( const TGeodeticDatum &from, const TGeodeticDatum &to );
+
 //----------------------------------------------------------------------------------------------------------------------
 ///
 /// \brief 3-параметрическое преобразование декартовых геоцентрических координат (простой сдвиг)
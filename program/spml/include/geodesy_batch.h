@@ -0,0 +1,572 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       geodesy_batch.h
+/// \brief      Пакетные (batch) геодезические функции над массивами координат
+/// \details    Входные и выходные данные задаются отдельными непрерывными массивами для каждой координаты
+///             (структура массивов). Перевод единиц измерения и выбор реализации выполняются один раз на пакет,
+///             вычисления ведутся в векторных регистрах (SSE2/AVX2/AVX-512), см. simd.h
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_GEODESY_BATCH_H
+#define SPML_GEODESY_BATCH_H
+
+// System includes:
+#include <cstddef>
+#include <vector>
+
+// SPML includes:
+#include <execution.h>
+#include <geodesy.h>
+#include <simd.h>
+#include <units.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Пакетный пересчет географических координат в радиолокационные (Обратная геодезическая задача)
+/// \details    Векторный вариант GEOtoRAD: итерации Винсента (eq. 13-21) выполняются одновременно для нескольких
+///             пар точек, каждая пара исключается из итераций после сходимости (не более 100 итераций, как в GEOtoRAD).
+///             \n Отличие от GEOtoRAD (порядок операций с плавающей точкой, FMA) не превышает 1e-6 м по дальности и
+///             1e-9 рад (5.7e-8 град) по азимутам. Исключение - почти антиподальные пары, для которых итерации
+///             Винсента не сходятся и результат GEOtoRAD не определен.
+/// \param[in]  ellipsoid - земной эллипсоид
+/// \param[in]  rangeUnit - единицы измерения дальности
+/// \param[in]  angleUnit - единицы измерения углов
+/// \param[in]  latStart  - массив широт начальных точек
+/// \param[in]  lonStart  - массив долгот начальных точек
+/// \param[in]  latEnd    - массив широт конечных точек
+/// \param[in]  lonEnd    - массив долгот конечных точек
+/// \param[in]  count     - число пар точек (размер каждого массива)
+/// \param[out] d         - массив расстояний между начальными и конечными точками по ортодроме
+/// \param[out] az        - массив азимутов из начальных точек на конечные
+/// \param[out] azEnd     - массив азимутов в конечных точках (nullptr - не вычислять)
+/// \param[in]  simd      - уровень векторизации (по умолчанию наилучший доступный)
+///
+void GEOtoRAD_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *latStart, const double *lonStart, const double *latEnd, const double *lonEnd, std::size_t count,
+    double *d, double *az, double *azEnd = nullptr, SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto );
+
+///
+/// \brief Пакетная обратная геодезическая задача с политикой выполнения
+/// \details Параметры simd и threads заменены политикой выполнения (см. execution.h), остальные параметры
+/// совпадают с параметрами GEOtoRAD_Batch
+/// \param[in]  policy    - политика выполнения
+///
+void GEOtoRAD_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *latStart, const double *lonStart, const double *latEnd,
+    const double *lonEnd, std::size_t count, double *d, double *az, double *azEnd, const Execution::Policy &policy );
+
+///
+/// \brief Пакетный пересчет радиолокационных координат в географические из одной начальной точки
+/// (Прямая геодезическая задача, "веер")
+/// \details    Векторный вариант RADtoGEO для построения колец дальности и границ секторов: величины, зависящие
+///             от начальной точки (tanU1, sinU1, cosU1) и от эллипсоида, вычисляются один раз, итерации Винсента
+///             по sigma (eq. 5-7) выполняются одновременно для нескольких пар дальность-азимут.
+///             \n Отличие от RADtoGEO не превышает 1e-9 рад (5.7e-8 град) по широте, долготе и азимуту.
+///             \n При threads != 1 массив делится на равные части, обрабатываемые потоками пула (см. execution.h)
+///             (имеет смысл для пакетов от десятков тысяч точек).
+/// \param[in]  ellipsoid - земной эллипсоид
+/// \param[in]  rangeUnit - единицы измерения дальности
+/// \param[in]  angleUnit - единицы измерения углов
+/// \param[in]  latStart  - широта начальной точки
+/// \param[in]  lonStart  - долгота начальной точки
+/// \param[in]  d         - массив расстояний между начальной и конечными точками по ортодроме
+/// \param[in]  az        - массив азимутов из начальной точки на конечные
+/// \param[in]  count     - число пар дальность-азимут (размер каждого массива)
+/// \param[out] latEnd    - массив широт конечных точек
+/// \param[out] lonEnd    - массив долгот конечных точек
+/// \param[out] azEnd     - массив прямых азимутов в конечных точках (nullptr - не вычислять)
+/// \param[in]  simd      - уровень векторизации (по умолчанию наилучший доступный)
+/// \param[in]  threads   - число потоков пула (0 - все, по умолчанию 1)
+///
+void RADtoGEO_Fan( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double latStart, double lonStart, const double *d, const double *az, std::size_t count,
+    double *latEnd, double *lonEnd, double *azEnd = nullptr, SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto,
+    unsigned int threads = 1 );
+
+///
+/// \brief Пакетная прямая геодезическая задача из одной начальной точки с политикой выполнения
+/// \details Параметры simd и threads заменены политикой выполнения (см. execution.h), остальные параметры
+/// совпадают с параметрами RADtoGEO_Fan
+/// \param[in]  policy    - политика выполнения
+///
+void RADtoGEO_Fan( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double latStart, double lonStart, const double *d, const double *az, std::size_t count, double *latEnd,
+    double *lonEnd, double *azEnd, const Execution::Policy &policy );
+
+///
+/// \brief Пакетная обратная геодезическая задача с выбором метода
+/// \details    GM_Vincenty - векторный GEOtoRAD_Batch (simd - уровень векторизации), GM_Karney - CGeodesic::Inverse
+///             для каждой пары (коэффициенты рядов вычисляются один раз на пакет, simd не используется).
+///             \n При threads != 1 массив делится на равные части, обрабатываемые потоками пула (см. execution.h).
+///             Остальные параметры совпадают с параметрами GEOtoRAD_Batch
+/// \param[in]  method    - метод решения на эллипсоиде
+/// \param[in]  threads   - число потоков пула (0 - все, по умолчанию 1)
+///
+void GEOtoRAD_Batch( const CEllipsoid &ellipsoid, TGeodesicMethod method, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *latStart, const double *lonStart, const double *latEnd,
+    const double *lonEnd, std::size_t count, double *d, double *az, double *azEnd = nullptr,
+    SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto, unsigned int threads = 1 );
+
+///
+/// \brief Пакетная обратная геодезическая задача с выбором метода и политикой выполнения
+/// \details Параметры simd и threads заменены политикой выполнения (см. execution.h), остальные параметры
+/// совпадают с параметрами GEOtoRAD_Batch
+/// \param[in]  policy    - политика выполнения
+///
+void GEOtoRAD_Batch( const CEllipsoid &ellipsoid, TGeodesicMethod method, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *latStart, const double *lonStart, const double *latEnd,
+    const double *lonEnd, std::size_t count, double *d, double *az, double *azEnd, const Execution::Policy &policy );
+
+///
+/// \brief Пакетная прямая геодезическая задача из одной начальной точки ("веер") с выбором метода
+/// \details    GM_Vincenty - векторный RADtoGEO_Fan, GM_Karney - CGeodesic::Direct для каждой пары дальность-азимут
+///             (simd не используется). Остальные параметры совпадают с параметрами RADtoGEO_Fan
+/// \param[in]  method    - метод решения на эллипсоиде
+///
+void RADtoGEO_Fan( const CEllipsoid &ellipsoid, TGeodesicMethod method, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, double latStart, double lonStart, const double *d, const double *az,
+    std::size_t count, double *latEnd, double *lonEnd, double *azEnd = nullptr,
+    SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto, unsigned int threads = 1 );
+
+///
+/// \brief Пакетная прямая геодезическая задача из одной начальной точки с выбором метода и политикой выполнения
+/// \details Параметры simd и threads заменены политикой выполнения (см. execution.h), остальные параметры
+/// совпадают с параметрами RADtoGEO_Fan
+/// \param[in]  policy    - политика выполнения
+///
+void RADtoGEO_Fan( const CEllipsoid &ellipsoid, TGeodesicMethod method, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, double latStart, double lonStart, const double *d, const double *az,
+    std::size_t count, double *latEnd, double *lonEnd, double *azEnd, const Execution::Policy &policy );
+
+///
+/// \brief Элемент разреженной матрицы расстояний
+///
+struct RADMatrixEntry
+{
+    std::size_t Row;    /// Номер точки строки
+    std::size_t Col;    /// Номер точки столбца
+    RAD Rad;            /// Дальность и азимуты из точки строки на точку столбца
+
+    ///
+    /// \brief Конструктор по умолчанию
+    ///
+    RADMatrixEntry() : Row( 0 ), Col( 0 ), Rad()
+    {}
+
+    ///
+    /// \brief Параметрический конструктор
+    /// \param row - номер точки строки
+    /// \param col - номер точки столбца
+    /// \param rad - дальность и азимуты
+    ///
+    RADMatrixEntry( std::size_t row, std::size_t col, const RAD &rad ) : Row( row ), Col( col ), Rad( rad )
+    {}
+};
+
+///
+/// \brief Матрица расстояний и азимутов между всеми парами точек двух наборов (обратная геодезическая задача)
+/// \details    Элемент [i * cols + j] - решение GEOtoRAD из точки строки i в точку столбца j (формулы Винсента, та
+///             же точность, что у GEOtoRAD_Batch). Синусы и косинусы приведенных широт вычисляются один раз на
+///             точку, матрица считается блоками (по 32 строки на 512 столбцов), чтобы данные точек столбцов
+///             оставались в кэше, блоки распределяются между потоками.
+///             \n Если наборы совпадают (одни и те же массивы latRow/latCol и lonRow/lonCol, rows == cols),
+///             вычисляется только верхний треугольник: d[j][i] = d[i][j], азимуты нижнего треугольника - обратные
+///             азимуты верхнего (азимут в конечной точке +- 180 град), диагональ - нули.
+/// \param[in]  ellipsoid - земной эллипсоид
+/// \param[in]  rangeUnit - единицы измерения дальности
+/// \param[in]  angleUnit - единицы измерения углов
+/// \param[in]  latRow    - массив широт точек строк
+/// \param[in]  lonRow    - массив долгот точек строк
+/// \param[in]  rows      - число точек строк
+/// \param[in]  latCol    - массив широт точек столбцов
+/// \param[in]  lonCol    - массив долгот точек столбцов
+/// \param[in]  cols      - число точек столбцов
+/// \param[out] d         - матрица расстояний rows x cols (по строкам)
+/// \param[out] az        - матрица азимутов из точек строк на точки столбцов
+/// \param[out] azEnd     - матрица азимутов в точках столбцов (nullptr - не вычислять)
+/// \param[in]  simd      - уровень векторизации (по умолчанию наилучший доступный)
+/// \param[in]  threads   - число потоков пула (0 - все, по умолчанию 1)
+///
+void GEOtoRAD_Matrix( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *latRow, const double *lonRow, std::size_t rows, const double *latCol, const double *lonCol,
+    std::size_t cols, double *d, double *az, double *azEnd = nullptr, SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto,
+    unsigned int threads = 1 );
+
+///
+/// \brief Матрица расстояний и азимутов с политикой выполнения
+/// \details Параметры simd и threads заменены политикой выполнения (см. execution.h), остальные параметры
+/// совпадают с параметрами GEOtoRAD_Matrix
+/// \param[in]  policy    - политика выполнения
+///
+void GEOtoRAD_Matrix( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *latRow, const double *lonRow, std::size_t rows,
+    const double *latCol, const double *lonCol, std::size_t cols, double *d, double *az, double *azEnd,
+    const Execution::Policy &policy );
+
+///
+/// \brief Разреженная матрица расстояний: пары точек двух наборов на расстоянии не более заданного
+/// \details    Вычисления - как в GEOtoRAD_Matrix (блоками, без хранения полной матрицы). Элементы упорядочены по
+///             номеру строки, затем столбца. Для совпадающих наборов диагональ (точка сама с собой) не выводится.
+///             Остальные параметры совпадают с параметрами GEOtoRAD_Matrix
+/// \param[in]  maxRange  - наибольшее расстояние (в единицах rangeUnit)
+/// \param[out] entries   - найденные пары (предыдущее содержимое удаляется)
+///
+void GEOtoRAD_MatrixSparse( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *latRow, const double *lonRow, std::size_t rows,
+    const double *latCol, const double *lonCol, std::size_t cols, double maxRange, std::vector<RADMatrixEntry> &entries,
+    SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto, unsigned int threads = 1 );
+
+///
+/// \brief Разреженная матрица расстояний с политикой выполнения
+/// \details Параметры simd и threads заменены политикой выполнения (см. execution.h), остальные параметры
+/// совпадают с параметрами GEOtoRAD_MatrixSparse
+/// \param[in]  policy    - политика выполнения
+///
+void GEOtoRAD_MatrixSparse( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *latRow, const double *lonRow, std::size_t rows,
+    const double *latCol, const double *lonCol, std::size_t cols, double maxRange, std::vector<RADMatrixEntry> &entries,
+    const Execution::Policy &policy );
+
+///
+/// \brief Пакетный пересчет геоцентрических координат (ECEF) в географические
+/// \details    Векторный вариант ECEFtoGEO (алгоритм Олсона) без ветвлений: обе ветви начального приближения
+///             широты вычисляются для всех точек блока и выбираются по маске, что позволяет обрабатывать
+///             несколько точек за раз.
+///             \n Отличие от ECEFtoGEO не превышает 1e-11 рад (6e-5 м на поверхности) по широте и долготе
+///             и 1e-4 м по высоте для высот от -100 км до 40000 км.
+///             \n При threads != 1 массив делится на равные части, обрабатываемые потоками пула (см. execution.h).
+///             Выходные массивы могут совпадать с входными.
+/// \param[in]  ellipsoid - земной эллипсоид
+/// \param[in]  rangeUnit - единицы измерения дальности
+/// \param[in]  angleUnit - единицы измерения углов
+/// \param[in]  x         - массив координат X
+/// \param[in]  y         - массив координат Y
+/// \param[in]  z         - массив координат Z
+/// \param[in]  count     - число точек (размер каждого массива)
+/// \param[out] lat       - массив широт
+/// \param[out] lon       - массив долгот
+/// \param[out] h         - массив высот
+/// \param[in]  simd      - уровень векторизации (по умолчанию наилучший доступный)
+/// \param[in]  threads   - число потоков пула (0 - все, по умолчанию 1)
+///
+void ECEFtoGEO_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *x, const double *y, const double *z, std::size_t count, double *lat, double *lon, double *h,
+    SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto, unsigned int threads = 1 );
+
+///
+/// \brief Пакетный пересчет ECEF в географические координаты с политикой выполнения
+/// \details Параметры simd и threads заменены политикой выполнения (см. execution.h), остальные параметры
+/// совпадают с параметрами ECEFtoGEO_Batch
+/// \param[in]  policy    - политика выполнения
+///
+void ECEFtoGEO_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *x, const double *y, const double *z, std::size_t count,
+    double *lat, double *lon, double *h, const Execution::Policy &policy );
+
+///
+/// \brief Пакетный пересчет географических координат в геоцентрические (ECEF)
+/// \details    Векторный вариант GEOtoECEF для больших массивов точек: sin и cos широты и долготы вычисляются
+///             совместно (одно приведение аргумента на угол), радиус кривизны первого вертикала - через
+///             обратный квадратный корень с уточнением по Ньютону.
+///             \n Если выходные массивы выровнены на SIMD::Alignment (например, SIMD::AlignedVector) и содержат
+///             десятки тысяч точек, результаты пишутся в память в обход кэша; скорость при этом ограничена
+///             пропускной способностью памяти.
+///             \n Отличие от GEOtoECEF не превышает 1e-8 м. Выходные массивы могут совпадать с входными.
+/// \param[in]  ellipsoid - земной эллипсоид
+/// \param[in]  rangeUnit - единицы измерения дальности
+/// \param[in]  angleUnit - единицы измерения углов
+/// \param[in]  lat       - массив широт
+/// \param[in]  lon       - массив долгот
+/// \param[in]  h         - массив высот
+/// \param[in]  count     - число точек (размер каждого массива)
+/// \param[out] x         - массив координат X
+/// \param[out] y         - массив координат Y
+/// \param[out] z         - массив координат Z
+/// \param[in]  simd      - уровень векторизации (по умолчанию наилучший доступный)
+/// \param[in]  threads   - число потоков пула (0 - все, по умолчанию 1)
+///
+void GEOtoECEF_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *lat, const double *lon, const double *h, std::size_t count, double *x, double *y, double *z,
+    SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto, unsigned int threads = 1 );
+
+///
+/// \brief Пакетный пересчет географических координат в ECEF с политикой выполнения
+/// \details Параметры simd и threads заменены политикой выполнения (см. execution.h), остальные параметры
+/// совпадают с параметрами GEOtoECEF_Batch
+/// \param[in]  policy    - политика выполнения
+///
+void GEOtoECEF_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *lat, const double *lon, const double *h, std::size_t count,
+    double *x, double *y, double *z, const Execution::Policy &policy );
+
+///
+/// \brief Пакетный перевод AER координат (азимут, угол места, наклонная дальность) в геодезические относительно
+/// одной опорной точки
+/// \details    Векторный вариант AERtoGEO для потока отметок одного радиолокатора: ECEF опорной точки и поворот
+///             ENU -> ECEF вычисляются один раз на пакет, sin и cos углов - пакетно (SIMD::SinCos), геодезические
+///             координаты - ядром ECEFtoGEO_Batch.
+///             \n Отличие от AERtoGEO не превышает 1e-4 м по высоте и 1e-11 рад по широте и долготе (как у
+///             ECEFtoGEO_Batch) для наклонных дальностей до 40000 км.
+/// \param[in]  ellipsoid  - земной эллипсоид
+/// \param[in]  rangeUnit  - единицы измерения дальности
+/// \param[in]  angleUnit  - единицы измерения углов
+/// \param[in]  az         - массив азимутов
+/// \param[in]  elev       - массив углов места
+/// \param[in]  slantRange - массив наклонных дальностей
+/// \param[in]  count      - число точек (размер каждого массива)
+/// \param[in]  lat0       - широта опорной точки
+/// \param[in]  lon0       - долгота опорной точки
+/// \param[in]  h0         - высота опорной точки
+/// \param[out] lat        - массив широт
+/// \param[out] lon        - массив долгот
+/// \param[out] h          - массив высот
+/// \param[in]  simd       - уровень векторизации (по умолчанию наилучший доступный)
+/// \param[in]  threads    - число потоков пула (0 - все, по умолчанию 1)
+///
+void AERtoGEO_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *az, const double *elev, const double *slantRange,
+    std::size_t count, double lat0, double lon0, double h0, double *lat, double *lon, double *h,
+    SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto, unsigned int threads = 1 );
+
+///
+/// \brief Пакетный перевод AER координат в геодезические с политикой выполнения
+/// \details Параметры simd и threads заменены политикой выполнения (см. execution.h), остальные параметры
+/// совпадают с параметрами AERtoGEO_Batch
+/// \param[in]  policy     - политика выполнения
+///
+void AERtoGEO_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *az, const double *elev, const double *slantRange,
+    std::size_t count, double lat0, double lon0, double h0, double *lat, double *lon, double *h,
+    const Execution::Policy &policy );
+
+//----------------------------------------------------------------------------------------------------------------------
+// Местная система координат (ENU, AER) одной опорной точки: варианты double и float.
+// Тип float вдвое увеличивает число значений в векторном регистре (SSE - 4, AVX2 - 8, AVX-512 - 16) и вдвое
+// уменьшает объем данных. Погрешность float - несколько единиц младшего разряда (ULP) результата: до 4e-7
+// относительно наклонной дальности (0.2 м на 500 км) и до 1e-6 рад (0.2 угл. сек) по углам. Для местной геометрии
+// РЛС (дальности до нескольких сотен км) этого достаточно; абсолютные ECEF координаты (6.4e6 м, ULP float 0.5 м)
+// в float не представляются, поэтому варианты float есть только для функций ENU/AER и смещений по осям ECEF.
+// Дальность входов и выходов - в единицах rangeUnit (перевод в метры не нужен: преобразования линейны по дальности).
+
+///
+/// \brief Пакетный перевод ENU координат в AER
+/// \details    Векторный вариант ENUtoAER. Отличие от ENUtoAER не превышает 2e-15 рад по углам и 1e-15
+///             относительно наклонной дальности.
+///             \n При threads != 1 массив делится на равные части, обрабатываемые потоками пула (см. execution.h).
+///             Выходные массивы могут совпадать с входными.
+/// \param[in]  rangeUnit  - единицы измерения дальности
+/// \param[in]  angleUnit  - единицы измерения углов
+/// \param[in]  xEast      - массив ENU координат X (East)
+/// \param[in]  yNorth     - массив ENU координат Y (North)
+/// \param[in]  zUp        - массив ENU координат Z (Up)
+/// \param[in]  count      - число точек (размер каждого массива)
+/// \param[out] az         - массив азимутов
+/// \param[out] elev       - массив углов места
+/// \param[out] slantRange - массив наклонных дальностей
+/// \param[in]  simd       - уровень векторизации (по умолчанию наилучший доступный)
+/// \param[in]  threads    - число потоков пула (0 - все, по умолчанию 1)
+///
+void ENUtoAER_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *xEast, const double *yNorth, const double *zUp, std::size_t count,
+    double *az, double *elev, double *slantRange, SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto,
+    unsigned int threads = 1 );
+
+///
+/// \brief Пакетный перевод ENU координат в AER с политикой выполнения
+/// \details Параметры simd и threads заменены политикой выполнения (см. execution.h), остальные параметры
+/// совпадают с параметрами ENUtoAER_Batch
+/// \param[in]  policy     - политика выполнения
+///
+void ENUtoAER_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *xEast, const double *yNorth, const double *zUp, std::size_t count,
+    double *az, double *elev, double *slantRange, const Execution::Policy &policy );
+
+///
+/// \brief Пакетный перевод ENU координат в AER (float)
+/// \details    Вариант одинарной точности ENUtoAER_Batch, параметры совпадают. Для дальностей до 1000 км
+///             отличие от ENUtoAER (double) для тех же входных значений не превышает 3e-7 относительно
+///             наклонной дальности и 1e-6 рад (0.2 угл. сек) по углам.
+///
+void ENUtoAER_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *xEast, const float *yNorth, const float *zUp, std::size_t count,
+    float *az, float *elev, float *slantRange, SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto,
+    unsigned int threads = 1 );
+
+///
+/// \brief Пакетный перевод ENU координат в AER (float) с политикой выполнения
+/// \param[in]  policy     - политика выполнения
+///
+void ENUtoAER_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *xEast, const float *yNorth, const float *zUp, std::size_t count,
+    float *az, float *elev, float *slantRange, const Execution::Policy &policy );
+
+///
+/// \brief Пакетный перевод AER координат в ENU
+/// \details    Векторный вариант AERtoENU: sin и cos углов вычисляются совместно (одно приведение аргумента на
+///             угол). Отличие от AERtoENU не превышает 1e-15 относительно наклонной дальности.
+///             \n При threads != 1 массив делится на равные части, обрабатываемые потоками пула (см. execution.h).
+///             Выходные массивы могут совпадать с входными.
+/// \param[in]  rangeUnit  - единицы измерения дальности
+/// \param[in]  angleUnit  - единицы измерения углов
+/// \param[in]  az         - массив азимутов
+/// \param[in]  elev       - массив углов места
+/// \param[in]  slantRange - массив наклонных дальностей
+/// \param[in]  count      - число точек (размер каждого массива)
+/// \param[out] xEast      - массив ENU координат X (East)
+/// \param[out] yNorth     - массив ENU координат Y (North)
+/// \param[out] zUp        - массив ENU координат Z (Up)
+/// \param[in]  simd       - уровень векторизации (по умолчанию наилучший доступный)
+/// \param[in]  threads    - число потоков пула (0 - все, по умолчанию 1)
+///
+void AERtoENU_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *az, const double *elev, const double *slantRange, std::size_t count,
+    double *xEast, double *yNorth, double *zUp, SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto,
+    unsigned int threads = 1 );
+
+///
+/// \brief Пакетный перевод AER координат в ENU с политикой выполнения
+/// \details Параметры simd и threads заменены политикой выполнения (см. execution.h), остальные параметры
+/// совпадают с параметрами AERtoENU_Batch
+/// \param[in]  policy     - политика выполнения
+///
+void AERtoENU_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *az, const double *elev, const double *slantRange, std::size_t count,
+    double *xEast, double *yNorth, double *zUp, const Execution::Policy &policy );
+
+///
+/// \brief Пакетный перевод AER координат в ENU (float)
+/// \details    Вариант одинарной точности AERtoENU_Batch, параметры совпадают. Отличие от AERtoENU (double) для
+///             тех же входных значений не превышает 5e-7 относительно наклонной дальности (0.25 м на 500 км, в
+///             основном - округление угла в градусах до float: ULP 360 град - 3e-5 град, 0.1 угл. сек).
+///
+void AERtoENU_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *az, const float *elev, const float *slantRange, std::size_t count,
+    float *xEast, float *yNorth, float *zUp, SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto,
+    unsigned int threads = 1 );
+
+///
+/// \brief Пакетный перевод AER координат в ENU (float) с политикой выполнения
+/// \param[in]  policy     - политика выполнения
+///
+void AERtoENU_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *az, const float *elev, const float *slantRange, std::size_t count,
+    float *xEast, float *yNorth, float *zUp, const Execution::Policy &policy );
+
+///
+/// \brief Пакетный перевод смещений по осям ECEF в ENU относительно одной опорной точки
+/// \details    Векторный вариант ECEFtoENUV: поворот (sin и cos широты и долготы опорной точки) вычисляется один
+///             раз на пакет. Отличие от ECEFtoENUV не превышает 1e-15 относительно длины смещения.
+///             \n При threads != 1 массив делится на равные части, обрабатываемые потоками пула (см. execution.h).
+///             Выходные массивы могут совпадать с входными.
+/// \param[in]  rangeUnit - единицы измерения дальности
+/// \param[in]  angleUnit - единицы измерения углов
+/// \param[in]  dX        - массив смещений по оси X
+/// \param[in]  dY        - массив смещений по оси Y
+/// \param[in]  dZ        - массив смещений по оси Z
+/// \param[in]  count     - число точек (размер каждого массива)
+/// \param[in]  lat0      - широта опорной точки
+/// \param[in]  lon0      - долгота опорной точки
+/// \param[out] xEast     - массив ENU координат X (East)
+/// \param[out] yNorth    - массив ENU координат Y (North)
+/// \param[out] zUp       - массив ENU координат Z (Up)
+/// \param[in]  simd      - уровень векторизации (по умолчанию наилучший доступный)
+/// \param[in]  threads   - число потоков пула (0 - все, по умолчанию 1)
+///
+void ECEFtoENUV_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *dX, const double *dY, const double *dZ, std::size_t count, double lat0, double lon0,
+    double *xEast, double *yNorth, double *zUp, SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto,
+    unsigned int threads = 1 );
+
+///
+/// \brief Пакетный перевод смещений по осям ECEF в ENU с политикой выполнения
+/// \details Параметры simd и threads заменены политикой выполнения (см. execution.h), остальные параметры
+/// совпадают с параметрами ECEFtoENUV_Batch
+/// \param[in]  policy    - политика выполнения
+///
+void ECEFtoENUV_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *dX, const double *dY, const double *dZ, std::size_t count, double lat0, double lon0,
+    double *xEast, double *yNorth, double *zUp, const Execution::Policy &policy );
+
+///
+/// \brief Пакетный перевод смещений по осям ECEF в ENU (float)
+/// \details    Вариант одинарной точности ECEFtoENUV_Batch, параметры совпадают (опорная точка - в double).
+///             Отличие от ECEFtoENUV (double) для тех же входных значений не превышает 4e-7 относительно длины
+///             смещения (0.2 м на 500 км).
+///
+void ECEFtoENUV_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *dX, const float *dY, const float *dZ, std::size_t count, double lat0, double lon0,
+    float *xEast, float *yNorth, float *zUp, SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto,
+    unsigned int threads = 1 );
+
+///
+/// \brief Пакетный перевод смещений по осям ECEF в ENU (float) с политикой выполнения
+/// \param[in]  policy    - политика выполнения
+///
+void ECEFtoENUV_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *dX, const float *dY, const float *dZ, std::size_t count, double lat0, double lon0,
+    float *xEast, float *yNorth, float *zUp, const Execution::Policy &policy );
+
+///
+/// \brief Пакетный перевод ENU координат в UVW (смещения по осям ECEF) относительно одной опорной точки
+/// \details    Векторный вариант ENUtoUVW (обратный поворот к ECEFtoENUV_Batch). Отличие от ENUtoUVW не превышает
+///             1e-15 относительно длины смещения.
+///             \n При threads != 1 массив делится на равные части, обрабатываемые потоками пула (см. execution.h).
+///             Выходные массивы могут совпадать с входными.
+/// \param[in]  rangeUnit - единицы измерения дальности
+/// \param[in]  angleUnit - единицы измерения углов
+/// \param[in]  xEast     - массив ENU координат X (East)
+/// \param[in]  yNorth    - массив ENU координат Y (North)
+/// \param[in]  zUp       - массив ENU координат Z (Up)
+/// \param[in]  count     - число точек (размер каждого массива)
+/// \param[in]  lat0      - широта опорной точки
+/// \param[in]  lon0      - долгота опорной точки
+/// \param[out] u         - массив координат U
+/// \param[out] v         - массив координат V
+/// \param[out] w         - массив координат W
+/// \param[in]  simd      - уровень векторизации (по умолчанию наилучший доступный)
+/// \param[in]  threads   - число потоков пула (0 - все, по умолчанию 1)
+///
+void ENUtoUVW_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *xEast, const double *yNorth, const double *zUp, std::size_t count, double lat0, double lon0,
+    double *u, double *v, double *w, SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto, unsigned int threads = 1 );
+
+///
+/// \brief Пакетный перевод ENU координат в UVW с политикой выполнения
+/// \details Параметры simd и threads заменены политикой выполнения (см. execution.h), остальные параметры
+/// совпадают с параметрами ENUtoUVW_Batch
+/// \param[in]  policy    - политика выполнения
+///
+void ENUtoUVW_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *xEast, const double *yNorth, const double *zUp, std::size_t count, double lat0, double lon0,
+    double *u, double *v, double *w, const Execution::Policy &policy );
+
+///
+/// \brief Пакетный перевод ENU координат в UVW (float)
+/// \details    Вариант одинарной точности ENUtoUVW_Batch, параметры совпадают (опорная точка - в double).
+///             Отличие от ENUtoUVW (double) для тех же входных значений не превышает 4e-7 относительно длины
+///             смещения (0.2 м на 500 км).
+///
+void ENUtoUVW_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *xEast, const float *yNorth, const float *zUp, std::size_t count, double lat0, double lon0,
+    float *u, float *v, float *w, SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto, unsigned int threads = 1 );
+
+///
+/// \brief Пакетный перевод ENU координат в UVW (float) с политикой выполнения
+/// \param[in]  policy    - политика выполнения
+///
+void ENUtoUVW_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *xEast, const float *yNorth, const float *zUp, std::size_t count, double lat0, double lon0,
+    float *u, float *v, float *w, const Execution::Policy &policy );
+
+} // end namespace Geodesy
+} // end namespace SPML
+#endif // SPML_GEODESY_BATCH_H
+/// \}
@@ -0,0 +1,354 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       geodesy_registry.h
+/// \brief      Реестр земных эллипсоидов и геодезических датумов (параметры вычисляются при компиляции)
+/// \details    Записи реестра тривиально копируемые, имена хранятся в std::string_view. Поиск по имени и коду EPSG
+///             выполняется по хеш-таблицам, построенным при компиляции, за O(1) и без выделения памяти.
+///             Идентификатор эллипсоида TEllipsoidId занимает 1 байт и может храниться в каждой записи пакета
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_GEODESY_REGISTRY_H
+#define SPML_GEODESY_REGISTRY_H
+
+// System includes:
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Коэффициенты алгоритма Олсона пересчета ECEF в географические координаты
+/// \details Зависят только от эллипсоида: a1 = a * e^2, a2 = a1^2, a3 = a1 * e^2 / 2, a4 = 2.5 * a2, a5 = a1 + a3,
+/// a6 = 1 - e^2
+///
+struct OlsonCoefficients
+{
+    double a1;
+    double a2;
+    double a3;
+    double a4;
+    double a5;
+    double a6;
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Идентификатор предопределенного земного эллипсоида (индекс в реестре)
+///
+enum TEllipsoidId : std::uint8_t
+{
+    EL_WGS84 = 0,               ///< WGS84 (EPSG:7030)
+    EL_GRS80 = 1,               ///< GRS80 (EPSG:7019)
+    EL_PZ90 = 2,                ///< ПЗ-90 (EPSG:7054)
+    EL_Krassowsky1940 = 3,      ///< Красовского 1940 (EPSG:7024)
+    EL_Sphere6371 = 4,          ///< Сфера радиусом 6371000.0 [м] (EPSG:7035)
+    EL_Sphere6378 = 5,          ///< Сфера радиусом 6378000.0 [м]
+    EL_SphereKrassowsky1940 = 6,///< Сфера радиусом большой полуоси эллипсоида Красовского 1940
+    EL_AGD66 = 7,               ///< Австралийский национальный сфероид (AGD66) (EPSG:7003)
+    EL_GSK2011 = 8,             ///< ГСК-2011 (EPSG:1025)
+    EL_Count = 9                ///< Число эллипсоидов в реестре
+};
+
+///
+/// \brief Геодезический датум
+///
+enum TGeodeticDatum : int
+{
+    GD_WGS84 = 0,
+    GD_PZ90 = 1,
+    GD_PZ9002 = 2,
+    GD_PZ9011 = 3,
+    GD_SK95 = 4,
+    GD_SK42 = 5,
+    GD_GSK2011 = 6,
+    GD_ITRF2008 = 7,
+    GD_AGD66 = 8,
+    GD_Count = 9    ///< Число датумов в реестре
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Параметры земного эллипсоида в реестре
+/// \details Для сферы сжатие и обратное сжатие равны 0
+///
+struct TEllipsoidParams
+{
+    TEllipsoidId id;            ///< Идентификатор (индекс в реестре)
+    std::string_view key;       ///< Короткое имя для поиска (без учета регистра), например "wgs84"
+    std::string_view name;      ///< Полное название (совпадает с CEllipsoid::Name())
+    int epsg;                   ///< Код EPSG (0 - нет кода)
+    bool isSphere;              ///< Признак сферы (a == b)
+    double a;                   ///< Большая полуось, [м]
+    double b;                   ///< Малая полуось, [м]
+    double f;                   ///< Сжатие
+    double invf;                ///< Обратное сжатие
+    double es1;                 ///< Квадрат первого эксцентриситета
+    double es2;                 ///< Квадрат второго эксцентриситета
+    double oneMinusF;           ///< 1 - f
+    double axisRatio;           ///< b / a
+    OlsonCoefficients olson;    ///< Коэффициенты алгоритма Олсона
+};
+
+///
+/// \brief Параметры геодезического датума в реестре
+///
+struct TDatumParams
+{
+    TGeodeticDatum datum;       ///< Датум
+    std::string_view key;       ///< Короткое имя для поиска (без учета регистра), например "sk42"
+    std::string_view name;      ///< Полное название
+    int epsg;                   ///< Код EPSG датума
+    TEllipsoidId ellipsoid;     ///< Эллипсоид датума
+};
+
+static_assert( std::is_trivially_copyable<TEllipsoidParams>::value, "TEllipsoidParams must be trivially copyable" );
+static_assert( std::is_trivially_copyable<TDatumParams>::value, "TDatumParams must be trivially copyable" );
+static_assert( sizeof( TEllipsoidId ) == 1, "TEllipsoidId must fit into one byte" );
+
+namespace Registry /// Построение реестра при компиляции (внутреннее)
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Параметры эллипсоида, заданного большой полуосью и обратным сжатием
+///
+constexpr TEllipsoidParams MakeEllipsoid( TEllipsoidId id, std::string_view key, std::string_view name, int epsg,
+    double a, double invf )
+{
+    const double f = 1.0 / invf;
+    const double b = ( 1.0 - ( 1.0 / invf ) ) * a; // Как в CEllipsoid при заданном обратном сжатии
+    const double es1 = 1.0 - ( ( b * b ) / ( a * a ) );
+    const double a1 = a * es1;
+    const double a3 = a1 * es1 / 2.0;
+    return TEllipsoidParams{ id, key, name, epsg, false, a, b, f, invf, es1, ( ( a * a ) / ( b * b ) ) - 1.0, 1.0 - f,
+        b / a, OlsonCoefficients{ a1, a1 * a1, a3, 2.5 * ( a1 * a1 ), a1 + a3, 1.0 - es1 } };
+}
+
+///
+/// \brief Параметры сферы
+///
+constexpr TEllipsoidParams MakeSphere( TEllipsoidId id, std::string_view key, std::string_view name, int epsg,
+    double r )
+{
+    return TEllipsoidParams{ id, key, name, epsg, true, r, r, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0,
+        OlsonCoefficients{ 0.0, 0.0, 0.0, 0.0, 0.0, 1.0 } };
+}
+
+///
+/// \brief Перевод символа ASCII в нижний регистр
+///
+constexpr char ToLower( char c )
+{
+    return ( c >= 'A' && c <= 'Z' ) ? static_cast<char>( c - 'A' + 'a' ) : c;
+}
+
+///
+/// \brief Хеш FNV-1a строки без учета регистра
+///
+constexpr std::uint32_t Hash( std::string_view str )
+{
+    std::uint32_t h = 2166136261u;
+    for( char c : str ) {
+        h ^= static_cast<std::uint8_t>( ToLower( c ) );
+        h *= 16777619u;
+    }
+    return h;
+}
+
+///
+/// \brief Хеш кода EPSG
+///
+constexpr std::uint32_t Hash( int code )
+{
+    return static_cast<std::uint32_t>( code ) * 2654435761u;
+}
+
+///
+/// \brief Сравнение строк без учета регистра
+///
+constexpr bool EqualNoCase( std::string_view lhs, std::string_view rhs )
+{
+    if( lhs.size() != rhs.size() ) {
+        return false;
+    }
+    for( std::size_t i = 0; i < lhs.size(); i++ ) {
+        if( ToLower( lhs[i] ) != ToLower( rhs[i] ) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::size_t TableSize = 32; ///< Размер хеш-таблиц (степень 2, не менее удвоенного числа записей)
+
+///
+/// \brief Хеш-таблица с открытой адресацией: 0 - пустая ячейка, иначе индекс записи + 1
+///
+typedef std::array<std::uint8_t, TableSize> TTable;
+
+///
+/// \brief Построение хеш-таблицы по ключам записей
+/// \param[in] entries - записи реестра
+/// \param[in] keyOf   - функция получения ключа записи
+/// \return Хеш-таблица (записи с пустым ключом не добавляются)
+///
+template <class Entries, class KeyOf>
+constexpr TTable MakeTable( const Entries &entries, KeyOf keyOf )
+{
+    TTable table{};
+    for( std::size_t i = 0; i < entries.size(); i++ ) {
+        const auto key = keyOf( entries[i] );
+        if( key == decltype( key ){} ) {
+            continue;
+        }
+        std::size_t slot = Hash( key ) & ( TableSize - 1 );
+        while( table[slot] != 0 ) {
+            slot = ( slot + 1 ) & ( TableSize - 1 );
+        }
+        table[slot] = static_cast<std::uint8_t>( i + 1 );
+    }
+    return table;
+}
+
+///
+/// \brief Поиск записи в хеш-таблице
+/// \return Указатель на запись или nullptr, если запись не найдена
+///
+template <class Entries, class Key, class KeyOf, class Equal>
+constexpr const typename Entries::value_type *Find( const Entries &entries, const TTable &table, Key key, KeyOf keyOf,
+    Equal equal )
+{
+    std::size_t slot = Hash( key ) & ( TableSize - 1 );
+    while( table[slot] != 0 ) {
+        const typename Entries::value_type &entry = entries[table[slot] - 1];
+        if( equal( keyOf( entry ), key ) ) {
+            return &entry;
+        }
+        slot = ( slot + 1 ) & ( TableSize - 1 );
+    }
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Предопределенные эллипсоиды (порядок совпадает с TEllipsoidId)
+///
+inline constexpr std::array<TEllipsoidParams, EL_Count> Ellipsoids = { {
+    MakeEllipsoid( EL_WGS84, "wgs84", "WGS84 (EPSG:7030)", 7030, 6378137.0, 298.257223563 ),
+    MakeEllipsoid( EL_GRS80, "grs80", "GRS80 (EPSG:7019)", 7019, 6378137.0, 298.257222101 ),
+    MakeEllipsoid( EL_PZ90, "pz90", "PZ90 (EPSG:7054)", 7054, 6378136.0, 298.257839303 ),
+    MakeEllipsoid( EL_Krassowsky1940, "krasovsky1940", "Krasovsky1940 (EPSG:7024)", 7024, 6378245.0, 298.3 ),
+    MakeSphere( EL_Sphere6371, "sphere6371", "Sphere 6371000.0 [м] (EPSG:7035)", 7035, 6371000.0 ),
+    MakeSphere( EL_Sphere6378, "sphere6378", "Sphere 6378000.0 [м]", 0, 6378000.0 ),
+    MakeSphere( EL_SphereKrassowsky1940, "spherekrasovsky1940", "SphereRadiusKrasovsky1940 (EPSG:7024)", 0,
+        6378245.0 ),
+    MakeEllipsoid( EL_AGD66, "agd66", "Australian Geodetic Datum 1966/84 (AGD) (EPSG:7003)", 7003, 6378160.0,
+        298.25 ),
+    MakeEllipsoid( EL_GSK2011, "gsk2011", "GSK-2011 (EPSG:1025)", 1025, 6378136.5, 298.2564151 )
+} };
+
+///
+/// \brief Геодезические датумы (порядок совпадает с TGeodeticDatum)
+///
+inline constexpr std::array<TDatumParams, GD_Count> Datums = { {
+    { GD_WGS84, "wgs84", "World Geodetic System 1984 (EPSG:6326)", 6326, EL_WGS84 },
+    { GD_PZ90, "pz90", "Parametry Zemli 1990 (EPSG:6740)", 6740, EL_PZ90 },
+    { GD_PZ9002, "pz9002", "Parametry Zemli 1990.02 (EPSG:1157)", 1157, EL_PZ90 },
+    { GD_PZ9011, "pz9011", "Parametry Zemli 1990.11 (EPSG:1158)", 1158, EL_PZ90 },
+    { GD_SK95, "sk95", "Pulkovo 1995 (EPSG:6200)", 6200, EL_Krassowsky1940 },
+    { GD_SK42, "sk42", "Pulkovo 1942 (EPSG:6284)", 6284, EL_Krassowsky1940 },
+    { GD_GSK2011, "gsk2011", "Geodezicheskaya Sistema Koordinat 2011 (EPSG:1159)", 1159, EL_GSK2011 },
+    { GD_ITRF2008, "itrf2008", "International Terrestrial Reference Frame 2008 (EPSG:1061)", 1061, EL_GRS80 },
+    { GD_AGD66, "agd66", "Australian Geodetic Datum 1966 (EPSG:6202)", 6202, EL_AGD66 }
+} };
+
+constexpr std::string_view EllipsoidKey( const TEllipsoidParams &p ) { return p.key; }
+constexpr int EllipsoidEpsg( const TEllipsoidParams &p ) { return p.epsg; }
+constexpr std::string_view DatumKey( const TDatumParams &p ) { return p.key; }
+constexpr int DatumEpsg( const TDatumParams &p ) { return p.epsg; }
+constexpr bool EqualKey( std::string_view lhs, std::string_view rhs ) { return EqualNoCase( lhs, rhs ); }
+constexpr bool EqualCode( int lhs, int rhs ) { return lhs == rhs; }
+
+inline constexpr TTable EllipsoidByKey = MakeTable( Ellipsoids, EllipsoidKey );
+inline constexpr TTable EllipsoidByEpsg = MakeTable( Ellipsoids, EllipsoidEpsg );
+inline constexpr TTable DatumByKey = MakeTable( Datums, DatumKey );
+inline constexpr TTable DatumByEpsg = MakeTable( Datums, DatumEpsg );
+
+} // end namespace Registry
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Параметры предопределенного эллипсоида
+/// \param[in] id - идентификатор эллипсоида
+/// \return Параметры эллипсоида
+///
+constexpr const TEllipsoidParams &EllipsoidParams( TEllipsoidId id )
+{
+    return Registry::Ellipsoids[id];
+}
+
+///
+/// \brief Поиск эллипсоида по короткому имени (без учета регистра)
+/// \param[in] key - короткое имя, например "wgs84", "krasovsky1940"
+/// \return Указатель на параметры эллипсоида или nullptr, если эллипсоид не найден
+///
+constexpr const TEllipsoidParams *FindEllipsoid( std::string_view key )
+{
+    return Registry::Find( Registry::Ellipsoids, Registry::EllipsoidByKey, key, Registry::EllipsoidKey,
+        Registry::EqualKey );
+}
+
+///
+/// \brief Поиск эллипсоида по коду EPSG
+/// \param[in] epsg - код EPSG эллипсоида, например 7030
+/// \return Указатель на параметры эллипсоида или nullptr, если эллипсоид не найден
+///
+constexpr const TEllipsoidParams *FindEllipsoid( int epsg )
+{
+    return Registry::Find( Registry::Ellipsoids, Registry::EllipsoidByEpsg, epsg, Registry::EllipsoidEpsg,
+        Registry::EqualCode );
+}
+
+///
+/// \brief Параметры геодезического датума
+/// \param[in] datum - датум
+/// \return Параметры датума
+///
+constexpr const TDatumParams &DatumParams( TGeodeticDatum datum )
+{
+    return Registry::Datums[datum];
+}
+
+///
+/// \brief Поиск датума по короткому имени (без учета регистра)
+/// \param[in] key - короткое имя, например "sk42", "pz9011"
+/// \return Указатель на параметры датума или nullptr, если датум не найден
+///
+constexpr const TDatumParams *FindDatum( std::string_view key )
+{
+    return Registry::Find( Registry::Datums, Registry::DatumByKey, key, Registry::DatumKey, Registry::EqualKey );
+}
+
+///
+/// \brief Поиск датума по коду EPSG
+/// \param[in] epsg - код EPSG датума, например 6284
+/// \return Указатель на параметры датума или nullptr, если датум не найден
+///
+constexpr const TDatumParams *FindDatum( int epsg )
+{
+    return Registry::Find( Registry::Datums, Registry::DatumByEpsg, epsg, Registry::DatumEpsg, Registry::EqualCode );
+}
+
+} // end namespace Geodesy
+} // end namespace SPML
+#endif // SPML_GEODESY_REGISTRY_H
+/// \}
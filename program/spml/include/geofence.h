@@ -0,0 +1,139 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       geofence.h
+/// \brief      Проверка расстояния между точками "не больше R" без полного решения обратной геодезической задачи
+/// \details    Для большинства пар ответ дают границы расстояния по геодезической линии, вычисляемые без итераций:
+///             снизу - хорда (XYZtoDistance между точками на поверхности) и b * sigma0, сверху - a * sigma0, где
+///             sigma0 - угловое расстояние на вспомогательной сфере приведенных широт (на сфере границы совпадают).
+///             Итерации Винсента (или метод Карни) выполняются только для пар, у которых R лежит между границами.
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_GEOFENCE_H
+#define SPML_GEOFENCE_H
+
+// System includes:
+#include <cstddef>
+#include <cstdint>
+
+// SPML includes:
+#include <execution.h>
+#include <geodesy.h>
+#include <simd.h>
+#include <units.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Границы расстояния по геодезической линии между двумя точками (без итераций)
+/// \details Метрика эллипсоида в координатах (приведенная широта, долгота) заключена между метриками сфер радиусов
+/// b и a, поэтому b * sigma0 <= d <= a * sigma0; хорда не длиннее любой линии на поверхности, поэтому хорда <= d.
+/// Границы верны для точного расстояния, погрешность формул Винсента (менее 1 мм) в них не учитывается
+/// \param[in]  ellipsoid - земной эллипсоид
+/// \param[in]  rangeUnit - единицы измерения дальности
+/// \param[in]  angleUnit - единицы измерения углов
+/// \param[in]  latStart  - широта начальной точки
+/// \param[in]  lonStart  - долгота начальной точки
+/// \param[in]  latEnd    - широта конечной точки
+/// \param[in]  lonEnd    - долгота конечной точки
+/// \param[out] dMin      - нижняя граница расстояния
+/// \param[out] dMax      - верхняя граница расстояния
+///
+void GEOtoRADBounds( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double latStart, double lonStart, double latEnd, double lonEnd, double &dMin, double &dMax );
+
+///
+/// \brief Проверка, что расстояние по геодезической линии между точками не больше заданного
+/// \details Результат совпадает с d <= range, где d - результат GEOtoRAD выбранным методом. Ответ дают границы
+/// GEOtoRADBounds, если range отстоит от них более чем на 1 мм (погрешность обратной задачи), иначе решается
+/// обратная задача. Исключение - пары, для которых формулы Винсента не сходятся: для них ответ по границам верен
+/// для точного расстояния. Число вызовов и число ответов по границам учитываются в GetWithinRangeStats
+/// \param[in] ellipsoid - земной эллипсоид
+/// \param[in] rangeUnit - единицы измерения дальности
+/// \param[in] angleUnit - единицы измерения углов
+/// \param[in] latStart  - широта начальной точки
+/// \param[in] lonStart  - долгота начальной точки
+/// \param[in] latEnd    - широта конечной точки
+/// \param[in] lonEnd    - долгота конечной точки
+/// \param[in] range     - наибольшее расстояние
+/// \param[in] method    - метод обратной задачи для пар, не решенных по границам
+/// \return true, если расстояние между точками не больше range
+///
+bool GEOWithinRange( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double latStart, double lonStart, double latEnd, double lonEnd, double range,
+    TGeodesicMethod method = GM_Vincenty );
+
+///
+/// \brief Пакетная проверка, что расстояния между парами точек не больше заданного
+/// \details Границы проверяются для всех пар без обратных тригонометрических функций: синусы и косинусы - векторные
+/// (SIMD::SinCos), range переводится в пороги квадратов хорд один раз на пакет. Пары, не решенные по границам,
+/// собираются в отдельные массивы и обрабатываются GEOtoRAD_Batch (результат для них совпадает с d <= range по
+/// GEOtoRAD_Batch). При threads != 1 массив делится на равные части, обрабатываемые потоками пула (см. execution.h)
+/// \param[in]  ellipsoid - земной эллипсоид
+/// \param[in]  rangeUnit - единицы измерения дальности
+/// \param[in]  angleUnit - единицы измерения углов
+/// \param[in]  latStart  - массив широт начальных точек
+/// \param[in]  lonStart  - массив долгот начальных точек
+/// \param[in]  latEnd    - массив широт конечных точек
+/// \param[in]  lonEnd    - массив долгот конечных точек
+/// \param[in]  count     - число пар точек (размер каждого массива)
+/// \param[in]  range     - наибольшее расстояние
+/// \param[out] within    - массив результатов (true - расстояние не больше range)
+/// \param[in]  simd      - уровень векторизации обратной задачи (по умолчанию наилучший доступный)
+/// \param[in]  threads   - число потоков пула (0 - все, по умолчанию 1)
+///
+void GEOWithinRange_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *latStart, const double *lonStart, const double *latEnd,
+    const double *lonEnd, std::size_t count, double range, bool *within,
+    SIMD::TSimdLevel simd = SIMD::TSimdLevel::SL_Auto, unsigned int threads = 1 );
+
+///
+/// \brief Пакетная проверка расстояний с политикой выполнения
+/// \details Параметры simd и threads заменены политикой выполнения (см. execution.h), остальные параметры
+/// совпадают с параметрами GEOWithinRange_Batch
+/// \param[in]  policy    - политика выполнения
+///
+void GEOWithinRange_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *latStart, const double *lonStart, const double *latEnd,
+    const double *lonEnd, std::size_t count, double range, bool *within, const Execution::Policy &policy );
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Счетчики проверок GEOWithinRange (общие для всех потоков)
+///
+struct WithinRangeStats
+{
+    std::uint64_t Calls;            ///< Число проверенных пар
+    std::uint64_t ResolvedByBounds; ///< Число пар, решенных по границам без обратной задачи
+
+    ///
+    /// \brief Доля пар, решенных по границам
+    /// \return Возвращает ResolvedByBounds / Calls (0, если проверок не было)
+    ///
+    double ResolvedFraction() const
+    {
+        return ( Calls == 0 ) ? 0.0 : static_cast<double>( ResolvedByBounds ) / static_cast<double>( Calls );
+    }
+};
+
+///
+/// \brief Текущие значения счетчиков проверок
+/// \return Счетчики с момента запуска или последнего ResetWithinRangeStats
+///
+WithinRangeStats GetWithinRangeStats();
+
+///
+/// \brief Обнуление счетчиков проверок
+///
+void ResetWithinRangeStats();
+
+} // end namespace Geodesy
+} // end namespace SPML
+#endif // SPML_GEOFENCE_H
+/// \}
@@ -0,0 +1,379 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       local_frame.h
+/// \brief      Местная топоцентрическая система координат (ENU) с фиксированной опорной точкой
+/// \details    Для неподвижной опорной точки (позиции РЛС) ECEF координаты опорной точки и матрица поворота
+///             ECEF -> ENU вычисляются один раз при создании объекта, а не на каждом вызове ECEFtoENU, GEOtoENU,
+///             ECEFtoAER, AERtoECEF и т.д.
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_LOCAL_FRAME_H
+#define SPML_LOCAL_FRAME_H
+
+// System includes:
+#include <cstddef>
+
+// SPML includes:
+#include <geodesy.h>
+#include <units.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Местная топоцентрическая система координат ENU (East-North-Up) с опорной точкой на эллипсоиде
+/// \details Единицы измерения задаются при создании и используются во всех методах (входы и выходы). Результаты
+/// совпадают с одноименными свободными функциями с точностью до порядка операций с плавающей точкой.
+/// Пакетные методы принимают отдельные непрерывные массивы для каждой координаты (структура массивов),
+/// выходные массивы могут совпадать с входными
+///
+class CLocalFrame
+{
+public:
+    ///
+    /// \brief Параметрический конструктор
+    /// \param[in] ellipsoid - земной эллипсоид
+    /// \param[in] rangeUnit - единицы измерения дальности
+    /// \param[in] angleUnit - единицы измерения углов
+    /// \param[in] lat0      - широта опорной точки
+    /// \param[in] lon0      - долгота опорной точки
+    /// \param[in] h0        - высота опорной точки
+    ///
+    CLocalFrame( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+        double lat0, double lon0, double h0 );
+
+    ///
+    /// \brief Земной эллипсоид
+    /// \return Возвращает эллипсоид, на котором задана опорная точка
+    ///
+    const CEllipsoid &Ellipsoid() const
+    {
+        return ellipsoid;
+    }
+
+    ///
+    /// \brief Единицы измерения дальности
+    /// \return Возвращает единицы измерения дальности входов и выходов методов
+    ///
+    Units::TRangeUnit RangeUnit() const
+    {
+        return rangeUnit;
+    }
+
+    ///
+    /// \brief Единицы измерения углов
+    /// \return Возвращает единицы измерения углов входов и выходов методов
+    ///
+    Units::TAngleUnit AngleUnit() const
+    {
+        return angleUnit;
+    }
+
+    ///
+    /// \brief Геодезические координаты опорной точки
+    /// \return Возвращает широту, долготу и высоту опорной точки в единицах объекта
+    ///
+    Geodetic Anchor() const;
+
+    ///
+    /// \brief ECEF координаты опорной точки
+    /// \return Возвращает ECEF координаты опорной точки в единицах объекта
+    ///
+    XYZ AnchorECEF() const;
+
+    //------------------------------------------------------------------------------------------------------------------
+    ///
+    /// \brief Перевод ECEF координат точки в ENU
+    /// \param[in]  x      - ECEF координата X
+    /// \param[in]  y      - ECEF координата Y
+    /// \param[in]  z      - ECEF координата Z
+    /// \param[out] xEast  - ENU координата X (East)
+    /// \param[out] yNorth - ENU координата Y (North)
+    /// \param[out] zUp    - ENU координата Z (Up)
+    ///
+    void ECEFtoENU( double x, double y, double z, double &xEast, double &yNorth, double &zUp ) const;
+
+    ///
+    /// \brief Перевод ENU координат точки в ECEF
+    /// \param[in]  xEast  - ENU координата X (East)
+    /// \param[in]  yNorth - ENU координата Y (North)
+    /// \param[in]  zUp    - ENU координата Z (Up)
+    /// \param[out] x      - ECEF координата X
+    /// \param[out] y      - ECEF координата Y
+    /// \param[out] z      - ECEF координата Z
+    ///
+    void ENUtoECEF( double xEast, double yNorth, double zUp, double &x, double &y, double &z ) const;
+
+    ///
+    /// \brief Перевод ENU координат точки в AER
+    /// \param[in]  xEast      - ENU координата X (East)
+    /// \param[in]  yNorth     - ENU координата Y (North)
+    /// \param[in]  zUp        - ENU координата Z (Up)
+    /// \param[out] az         - азимут
+    /// \param[out] elev       - угол места
+    /// \param[out] slantRange - наклонная дальность
+    ///
+    void ENUtoAER( double xEast, double yNorth, double zUp, double &az, double &elev, double &slantRange ) const;
+
+    ///
+    /// \brief Перевод AER координат точки в ENU
+    /// \param[in]  az         - азимут
+    /// \param[in]  elev       - угол места
+    /// \param[in]  slantRange - наклонная дальность
+    /// \param[out] xEast      - ENU координата X (East)
+    /// \param[out] yNorth     - ENU координата Y (North)
+    /// \param[out] zUp        - ENU координата Z (Up)
+    ///
+    void AERtoENU( double az, double elev, double slantRange, double &xEast, double &yNorth, double &zUp ) const;
+
+    ///
+    /// \brief Перевод ECEF координат точки в AER
+    /// \param[in]  x          - ECEF координата X
+    /// \param[in]  y          - ECEF координата Y
+    /// \param[in]  z          - ECEF координата Z
+    /// \param[out] az         - азимут
+    /// \param[out] elev       - угол места
+    /// \param[out] slantRange - наклонная дальность
+    ///
+    void ECEFtoAER( double x, double y, double z, double &az, double &elev, double &slantRange ) const;
+
+    ///
+    /// \brief Перевод AER координат точки в ECEF
+    /// \param[in]  az         - азимут
+    /// \param[in]  elev       - угол места
+    /// \param[in]  slantRange - наклонная дальность
+    /// \param[out] x          - ECEF координата X
+    /// \param[out] y          - ECEF координата Y
+    /// \param[out] z          - ECEF координата Z
+    ///
+    void AERtoECEF( double az, double elev, double slantRange, double &x, double &y, double &z ) const;
+
+    ///
+    /// \brief Перевод геодезических координат точки в ENU
+    /// \param[in]  lat    - широта точки
+    /// \param[in]  lon    - долгота точки
+    /// \param[in]  h      - высота точки
+    /// \param[out] xEast  - ENU координата X (East)
+    /// \param[out] yNorth - ENU координата Y (North)
+    /// \param[out] zUp    - ENU координата Z (Up)
+    ///
+    void GEOtoENU( double lat, double lon, double h, double &xEast, double &yNorth, double &zUp ) const;
+
+    ///
+    /// \brief Перевод ENU координат точки в геодезические
+    /// \param[in]  xEast  - ENU координата X (East)
+    /// \param[in]  yNorth - ENU координата Y (North)
+    /// \param[in]  zUp    - ENU координата Z (Up)
+    /// \param[out] lat    - широта точки
+    /// \param[out] lon    - долгота точки
+    /// \param[out] h      - высота точки
+    ///
+    void ENUtoGEO( double xEast, double yNorth, double zUp, double &lat, double &lon, double &h ) const;
+
+    ///
+    /// \brief Перевод геодезических координат точки в AER
+    /// \param[in]  lat        - широта точки
+    /// \param[in]  lon        - долгота точки
+    /// \param[in]  h          - высота точки
+    /// \param[out] az         - азимут
+    /// \param[out] elev       - угол места
+    /// \param[out] slantRange - наклонная дальность
+    ///
+    void GEOtoAER( double lat, double lon, double h, double &az, double &elev, double &slantRange ) const;
+
+    ///
+    /// \brief Перевод AER координат точки в геодезические
+    /// \param[in]  az         - азимут
+    /// \param[in]  elev       - угол места
+    /// \param[in]  slantRange - наклонная дальность
+    /// \param[out] lat        - широта точки
+    /// \param[out] lon        - долгота точки
+    /// \param[out] h          - высота точки
+    ///
+    void AERtoGEO( double az, double elev, double slantRange, double &lat, double &lon, double &h ) const;
+
+    //------------------------------------------------------------------------------------------------------------------
+    ///
+    /// \brief Пакетный перевод ECEF координат в ENU
+    /// \param[in]  x      - массив ECEF координат X
+    /// \param[in]  y      - массив ECEF координат Y
+    /// \param[in]  z      - массив ECEF координат Z
+    /// \param[in]  count  - число точек (размер каждого массива)
+    /// \param[out] xEast  - массив ENU координат X (East)
+    /// \param[out] yNorth - массив ENU координат Y (North)
+    /// \param[out] zUp    - массив ENU координат Z (Up)
+    ///
+    void ECEFtoENU( const double *x, const double *y, const double *z, std::size_t count,
+        double *xEast, double *yNorth, double *zUp ) const;
+
+    ///
+    /// \brief Пакетный перевод ENU координат в ECEF
+    /// \param[in]  xEast  - массив ENU координат X (East)
+    /// \param[in]  yNorth - массив ENU координат Y (North)
+    /// \param[in]  zUp    - массив ENU координат Z (Up)
+    /// \param[in]  count  - число точек (размер каждого массива)
+    /// \param[out] x      - массив ECEF координат X
+    /// \param[out] y      - массив ECEF координат Y
+    /// \param[out] z      - массив ECEF координат Z
+    ///
+    void ENUtoECEF( const double *xEast, const double *yNorth, const double *zUp, std::size_t count,
+        double *x, double *y, double *z ) const;
+
+    ///
+    /// \brief Пакетный перевод ENU координат в AER
+    /// \param[in]  xEast      - массив ENU координат X (East)
+    /// \param[in]  yNorth     - массив ENU координат Y (North)
+    /// \param[in]  zUp        - массив ENU координат Z (Up)
+    /// \param[in]  count      - число точек (размер каждого массива)
+    /// \param[out] az         - массив азимутов
+    /// \param[out] elev       - массив углов места
+    /// \param[out] slantRange - массив наклонных дальностей
+    ///
+    void ENUtoAER( const double *xEast, const double *yNorth, const double *zUp, std::size_t count,
+        double *az, double *elev, double *slantRange ) const;
+
+    ///
+    /// \brief Пакетный перевод AER координат в ENU
+    /// \param[in]  az         - массив азимутов
+    /// \param[in]  elev       - массив углов места
+    /// \param[in]  slantRange - массив наклонных дальностей
+    /// \param[in]  count      - число точек (размер каждого массива)
+    /// \param[out] xEast      - массив ENU координат X (East)
+    /// \param[out] yNorth     - массив ENU координат Y (North)
+    /// \param[out] zUp        - массив ENU координат Z (Up)
+    ///
+    void AERtoENU( const double *az, const double *elev, const double *slantRange, std::size_t count,
+        double *xEast, double *yNorth, double *zUp ) const;
+
+    ///
+    /// \brief Пакетный перевод ENU координат в AER (float)
+    /// \details Вычисления в float векторными ядрами ENUtoAER_Batch (погрешность - см. geodesy_batch.h).
+    /// Параметры совпадают с параметрами варианта double
+    ///
+    void ENUtoAER( const float *xEast, const float *yNorth, const float *zUp, std::size_t count,
+        float *az, float *elev, float *slantRange ) const;
+
+    ///
+    /// \brief Пакетный перевод AER координат в ENU (float)
+    /// \details Вычисления в float векторными ядрами AERtoENU_Batch (погрешность - см. geodesy_batch.h).
+    /// Параметры совпадают с параметрами варианта double
+    ///
+    void AERtoENU( const float *az, const float *elev, const float *slantRange, std::size_t count,
+        float *xEast, float *yNorth, float *zUp ) const;
+
+    ///
+    /// \brief Пакетный перевод ECEF координат в AER
+    /// \param[in]  x          - массив ECEF координат X
+    /// \param[in]  y          - массив ECEF координат Y
+    /// \param[in]  z          - массив ECEF координат Z
+    /// \param[in]  count      - число точек (размер каждого массива)
+    /// \param[out] az         - массив азимутов
+    /// \param[out] elev       - массив углов места
+    /// \param[out] slantRange - массив наклонных дальностей
+    ///
+    void ECEFtoAER( const double *x, const double *y, const double *z, std::size_t count,
+        double *az, double *elev, double *slantRange ) const;
+
+    ///
+    /// \brief Пакетный перевод AER координат в ECEF
+    /// \param[in]  az         - массив азимутов
+    /// \param[in]  elev       - массив углов места
+    /// \param[in]  slantRange - массив наклонных дальностей
+    /// \param[in]  count      - число точек (размер каждого массива)
+    /// \param[out] x          - массив ECEF координат X
+    /// \param[out] y          - массив ECEF координат Y
+    /// \param[out] z          - массив ECEF координат Z
+    ///
+    void AERtoECEF( const double *az, const double *elev, const double *slantRange, std::size_t count,
+        double *x, double *y, double *z ) const;
+
+    ///
+    /// \brief Пакетный перевод геодезических координат в ENU
+    /// \param[in]  lat    - массив широт
+    /// \param[in]  lon    - массив долгот
+    /// \param[in]  h      - массив высот
+    /// \param[in]  count  - число точек (размер каждого массива)
+    /// \param[out] xEast  - массив ENU координат X (East)
+    /// \param[out] yNorth - массив ENU координат Y (North)
+    /// \param[out] zUp    - массив ENU координат Z (Up)
+    ///
+    void GEOtoENU( const double *lat, const double *lon, const double *h, std::size_t count,
+        double *xEast, double *yNorth, double *zUp ) const;
+
+    ///
+    /// \brief Пакетный перевод ENU координат в геодезические
+    /// \param[in]  xEast  - массив ENU координат X (East)
+    /// \param[in]  yNorth - массив ENU координат Y (North)
+    /// \param[in]  zUp    - массив ENU координат Z (Up)
+    /// \param[in]  count  - число точек (размер каждого массива)
+    /// \param[out] lat    - массив широт
+    /// \param[out] lon    - массив долгот
+    /// \param[out] h      - массив высот
+    ///
+    void ENUtoGEO( const double *xEast, const double *yNorth, const double *zUp, std::size_t count,
+        double *lat, double *lon, double *h ) const;
+
+    ///
+    /// \brief Пакетный перевод геодезических координат в AER
+    /// \param[in]  lat        - массив широт
+    /// \param[in]  lon        - массив долгот
+    /// \param[in]  h          - массив высот
+    /// \param[in]  count      - число точек (размер каждого массива)
+    /// \param[out] az         - массив азимутов
+    /// \param[out] elev       - массив углов места
+    /// \param[out] slantRange - массив наклонных дальностей
+    ///
+    void GEOtoAER( const double *lat, const double *lon, const double *h, std::size_t count,
+        double *az, double *elev, double *slantRange ) const;
+
+    ///
+    /// \brief Пакетный перевод AER координат в геодезические
+    /// \param[in]  az         - массив азимутов
+    /// \param[in]  elev       - массив углов места
+    /// \param[in]  slantRange - массив наклонных дальностей
+    /// \param[in]  count      - число точек (размер каждого массива)
+    /// \param[out] lat        - массив широт
+    /// \param[out] lon        - массив долгот
+    /// \param[out] h          - массив высот
+    ///
+    void AERtoGEO( const double *az, const double *elev, const double *slantRange, std::size_t count,
+        double *lat, double *lon, double *h ) const;
+
+private:
+    CEllipsoid ellipsoid;           ///< Земной эллипсоид
+    Units::TRangeUnit rangeUnit;    ///< Единицы измерения дальности
+    Units::TAngleUnit angleUnit;    ///< Единицы измерения углов
+    double rangeIn;                 ///< Множитель перевода входной дальности в [м]
+    double rangeOut;                ///< Множитель перевода [м] в выходную дальность
+    double angleIn;                 ///< Множитель перевода входных углов в [рад]
+    double angleOut;                ///< Множитель перевода [рад] в выходные углы
+
+    double lat0;                    ///< Широта опорной точки, [рад]
+    double lon0;                    ///< Долгота опорной точки, [рад]
+    double h0;                      ///< Высота опорной точки, [м]
+    double x0;                      ///< ECEF координата X опорной точки, [м]
+    double y0;                      ///< ECEF координата Y опорной точки, [м]
+    double z0;                      ///< ECEF координата Z опорной точки, [м]
+
+    // Матрица поворота ECEF -> ENU (строки - орты East, North, Up в ECEF):
+    double eX, eY;                  ///< East  = ( -sin( lon0 ), cos( lon0 ), 0 )
+    double nX, nY, nZ;              ///< North = ( -sin( lat0 ) * cos( lon0 ), -sin( lat0 ) * sin( lon0 ), cos( lat0 ) )
+    double uX, uY, uZ;              ///< Up    = ( cos( lat0 ) * cos( lon0 ), cos( lat0 ) * sin( lon0 ), sin( lat0 ) )
+
+    // Вычисления в [м] и [рад]:
+    void ToENU( double x, double y, double z, double &xEast, double &yNorth, double &zUp ) const;
+    void FromENU( double xEast, double yNorth, double zUp, double &x, double &y, double &z ) const;
+    static void ToAER( double xEast, double yNorth, double zUp, double &az, double &elev, double &slantRange );
+    static void FromAER( double az, double elev, double slantRange, double &xEast, double &yNorth, double &zUp );
+};
+
+} // end namespace Geodesy
+} // end namespace SPML
+#endif // SPML_LOCAL_FRAME_H
+/// \}
@@ -0,0 +1,226 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       shm_ring.h
+/// \brief      Кольцевой буфер записей в разделяемой памяти POSIX (один писатель, один читатель, без блокировок)
+/// \details    Буфер для обмена отметками между процессами на одной машине (например, вторичная обработка
+///             радиолокатора и потребитель геодезических координат) без сокетов и копирования: записи лежат
+///             по столбцам (Fields столбцов по Capacity чисел double), поэтому непрерывный участок буфера - это
+///             массивы, которые передаются пакетным функциям (geodesy_batch.h) напрямую.
+///             \n Писатель продвигает счетчик записанных записей Head, читатель - счетчик прочитанных Tail
+///             (атомарные 64-битные счетчики в разных строках кэша, порядок памяти release/acquire). Каждая сторона
+///             хранит последнее прочитанное значение счетчика другой стороны и перечитывает его только при нехватке
+///             записей или места, поэтому обмен строками кэша между ядрами - не чаще раза на пакет.
+///             \n Только для POSIX-систем (shm_open, mmap).
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_SHM_RING_H
+#define SPML_SHM_RING_H
+
+// System includes:
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+// SPML includes:
+#include <execution.h>
+#include <geodesy.h>
+#include <units.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Ring /// Кольцевые буферы в разделяемой памяти
+{
+//----------------------------------------------------------------------------------------------------------------------
+static const unsigned MaxFields = 64;                   ///< Наибольшее число чисел в записи буфера
+static const std::size_t MaxCapacity = std::size_t( 1 ) << 30; ///< Наибольшая емкость буфера в записях
+
+struct TRingHeader; // Заголовок буфера в разделяемой памяти (shm_ring.cpp)
+
+///
+/// \brief Непрерывный участок буфера
+/// \details Числа поля f записей участка: Column( f ) + Offset ... Column( f ) + Offset + Count - 1
+///
+struct TSpan
+{
+    std::size_t Offset = 0; ///< Номер первой записи участка в столбцах буфера
+    std::size_t Count = 0;  ///< Число записей участка
+};
+
+///
+/// \brief Кольцевой буфер записей в разделяемой памяти POSIX с одним писателем и одним читателем
+/// \details Буфер создается одним процессом (Create) и открывается другими (Open) по имени объекта разделяемой
+/// памяти. Писать в буфер может только один объект CShmRing (в одном потоке), читать - только один (в одном потоке,
+/// возможно, другого процесса). Создавший буфер объект удаляет имя объекта разделяемой памяти при закрытии, открывшие
+/// буфер процессы продолжают работать с ним до своего закрытия.
+/// \n Запись: Reserve - непрерывный свободный участок, заполнение столбцов участка, Commit - публикация записей.
+/// Чтение: Peek - непрерывный участок записанных записей, обработка, Release - освобождение места.
+/// Push и Pop - то же с копированием из массивов пользователя и в них
+///
+class CShmRing
+{
+public:
+    CShmRing() = default;
+    CShmRing( const CShmRing & ) = delete;
+    CShmRing &operator=( const CShmRing & ) = delete;
+
+    ///
+    /// \brief Деструктор: закрытие буфера
+    ///
+    ~CShmRing();
+
+    ///
+    /// \brief Создание буфера
+    /// \details Существующий объект разделяемой памяти с тем же именем не заменяется (см. Remove)
+    /// \param[in]  name     - имя объекта разделяемой памяти ("/имя", без других символов '/')
+    /// \param[in]  fields   - число чисел в записи (от 1 до MaxFields)
+    /// \param[in]  capacity - емкость в записях (степень двойки, не более MaxCapacity)
+    /// \param[out] error    - описание ошибки
+    /// \return true, если буфер создан
+    ///
+    bool Create( const std::string &name, unsigned fields, std::size_t capacity, std::string &error );
+
+    ///
+    /// \brief Открытие буфера, созданного другим объектом (в т.ч. в другом процессе)
+    /// \param[in]  name  - имя объекта разделяемой памяти
+    /// \param[out] error - описание ошибки
+    /// \return true, если буфер открыт
+    ///
+    bool Open( const std::string &name, std::string &error );
+
+    ///
+    /// \brief Закрытие буфера (создавший буфер объект также удаляет имя объекта разделяемой памяти)
+    ///
+    void Close();
+
+    ///
+    /// \brief Удаление имени объекта разделяемой памяти (например, оставшегося после аварийного завершения)
+    /// \param[in] name - имя объекта разделяемой памяти
+    ///
+    static void Remove( const std::string &name );
+
+    ///
+    /// \brief Признак открытого буфера
+    /// \return true, если буфер создан или открыт
+    ///
+    bool IsOpen() const { return data != nullptr; }
+
+    ///
+    /// \brief Число чисел в записи
+    /// \return Число столбцов буфера
+    ///
+    unsigned Fields() const { return fields; }
+
+    ///
+    /// \brief Емкость буфера
+    /// \return Число записей, которые помещаются в буфер
+    ///
+    std::size_t Capacity() const { return capacity; }
+
+    ///
+    /// \brief Столбец буфера
+    /// \param[in] field - номер поля записи (меньше Fields)
+    /// \return Указатель на Capacity чисел поля
+    ///
+    double *Column( unsigned field ) { return data + field * capacity; }
+
+    ///
+    /// \brief Столбец буфера
+    /// \param[in] field - номер поля записи (меньше Fields)
+    /// \return Указатель на Capacity чисел поля
+    ///
+    const double *Column( unsigned field ) const { return data + field * capacity; }
+
+    ///
+    /// \brief Писатель: непрерывный свободный участок буфера
+    /// \param[in] count - наибольшее нужное число записей
+    /// \return Участок (Count меньше count, если места не хватает или участок доходит до конца столбцов)
+    ///
+    TSpan Reserve( std::size_t count = std::numeric_limits<std::size_t>::max() );
+
+    ///
+    /// \brief Писатель: публикация записей, заполненных в начале последнего участка Reserve
+    /// \param[in] count - число записей (не больше Count участка)
+    ///
+    void Commit( std::size_t count );
+
+    ///
+    /// \brief Писатель: запись с копированием
+    /// \param[in] in    - столбцы записей (Fields массивов по count чисел)
+    /// \param[in] count - число записей
+    /// \return Число записанных записей (меньше count, если буфер заполнен)
+    ///
+    std::size_t Push( const double *const *in, std::size_t count );
+
+    ///
+    /// \brief Читатель: непрерывный участок записанных записей
+    /// \param[in] count - наибольшее нужное число записей
+    /// \return Участок (Count меньше count, если записей меньше или участок доходит до конца столбцов)
+    ///
+    TSpan Peek( std::size_t count = std::numeric_limits<std::size_t>::max() );
+
+    ///
+    /// \brief Читатель: освобождение прочитанных записей в начале последнего участка Peek
+    /// \param[in] count - число записей (не больше Count участка)
+    ///
+    void Release( std::size_t count );
+
+    ///
+    /// \brief Читатель: чтение с копированием
+    /// \param[out] out   - столбцы записей (Fields массивов по count чисел)
+    /// \param[in]  count - наибольшее число записей
+    /// \return Число прочитанных записей
+    ///
+    std::size_t Pop( double *const *out, std::size_t count );
+
+private:
+    std::string name;               // Имя объекта разделяемой памяти
+    bool owner = false;             // Буфер создан этим объектом
+    void *base = nullptr;           // Отображение объекта разделяемой памяти
+    std::size_t size = 0;           // Размер отображения
+    TRingHeader *header = nullptr;  // Заголовок буфера
+    double *data = nullptr;         // Столбцы записей
+    unsigned fields = 0;            // Число чисел в записи
+    std::size_t capacity = 0;       // Емкость в записях
+    std::uint64_t head = 0;         // Писатель: число записанных записей
+    std::uint64_t tailCache = 0;    // Писатель: последнее прочитанное число освобожденных записей
+    std::uint64_t tail = 0;         // Читатель: число освобожденных записей
+    std::uint64_t headCache = 0;    // Читатель: последнее прочитанное число записанных записей
+
+    // Отображение открытого объекта разделяемой памяти и проверка заголовка
+    bool Map( int fd, std::size_t bytes, std::string &error );
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Шаг потребителя отметок радиолокатора: перевод отметок AER из одного буфера в геодезические координаты
+/// в другом буфере
+/// \details Записи plots: азимут, угол места, наклонная дальность, далее - любые поля (время, номер трассы и т.д.),
+/// которые копируются в results без изменений. Записи results: широта, долгота, высота и те же поля. Отметки
+/// переводятся пакетами AERtoGEO_Batch прямо из столбцов plots в столбцы results (без промежуточных копий), пока в
+/// plots есть записи, в results есть место и не переведено maxCount отметок.
+/// \param[in] plots     - буфер отметок (читатель, не менее 3 полей)
+/// \param[in] results   - буфер результатов (писатель, столько же полей, сколько у plots)
+/// \param[in] ellipsoid - земной эллипсоид
+/// \param[in] rangeUnit - единицы измерения дальности
+/// \param[in] angleUnit - единицы измерения углов
+/// \param[in] lat0      - широта радиолокатора
+/// \param[in] lon0      - долгота радиолокатора
+/// \param[in] h0        - высота радиолокатора
+/// \param[in] policy    - политика выполнения пакетов
+/// \param[in] maxCount  - наибольшее число отметок за шаг
+/// \return Число переведенных отметок (0 - нет отметок или места для результатов)
+///
+std::size_t DrainAERtoGEO( CShmRing &plots, CShmRing &results, const Geodesy::CEllipsoid &ellipsoid,
+    const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit, double lat0, double lon0, double h0,
+    const Execution::Policy &policy = Execution::Policy( Execution::EM_ParallelSimd, 1 ),
+    std::size_t maxCount = std::numeric_limits<std::size_t>::max() );
+
+} // end namespace Ring
+} // end namespace SPML
+#endif // SPML_SHM_RING_H
+/// \}
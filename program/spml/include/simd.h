@@ -0,0 +1,130 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       simd.h
+/// \brief      Уровни векторизации (SIMD) пакетных функций библиотеки СБПМ
+/// \details    Пакетные (batch) функции имеют несколько реализаций под разные наборы инструкций процессора,
+///             выбор реализации выполняется во время работы по возможностям процессора
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_SIMD_H
+#define SPML_SIMD_H
+
+// System includes:
+#include <cstddef>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace SIMD /// Уровни векторизации пакетных функций
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Уровень векторизации (набор инструкций)
+///
+enum TSimdLevel : int
+{
+    SL_Auto = -1,   ///< Наилучший доступный на данном процессоре
+    SL_Scalar = 0,  ///< Без векторизации (1 значение double за раз)
+    SL_SSE2 = 1,    ///< SSE2 (2 значения double за раз)
+    SL_AVX2 = 2,    ///< AVX2 + FMA (4 значения double за раз)
+    SL_AVX512 = 3   ///< AVX-512F (8 значений double за раз)
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Проверка доступности уровня векторизации
+/// \details Уровень доступен, если реализация под него собрана в библиотеке и поддерживается процессором
+/// \param[in] level - уровень векторизации
+/// \return true - если уровень доступен, иначе false
+///
+bool IsSupported( TSimdLevel level );
+
+///
+/// \brief Наилучший доступный уровень векторизации
+/// \return Наилучший уровень векторизации, доступный на данном процессоре
+///
+TSimdLevel MaxSupportedLevel();
+
+///
+/// \brief Приведение запрошенного уровня векторизации к доступному
+/// \param[in] level - запрошенный уровень (SL_Auto - наилучший доступный)
+/// \return Запрошенный уровень, если он доступен, иначе наилучший доступный уровень не выше запрошенного
+///
+TSimdLevel Resolve( TSimdLevel level );
+
+///
+/// \brief Число обрабатываемых за раз значений double (ширина вектора) для уровня векторизации
+/// \param[in] level - уровень векторизации
+/// \return Ширина вектора
+///
+int Width( TSimdLevel level );
+
+///
+/// \brief Название уровня векторизации
+/// \param[in] level - уровень векторизации
+/// \return Строка с названием уровня
+///
+std::string Name( TSimdLevel level );
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Выравнивание массивов для пакетных функций, [байт] (размер вектора AVX-512 и строки кэша)
+///
+const std::size_t Alignment = 64;
+
+///
+/// \brief Распределитель памяти с выравниванием Alignment для std::vector
+/// \details Пакетные функции, пишущие большие массивы, при выровненных выходных массивах используют потоковую
+///          запись в обход кэша
+///
+template <class T>
+struct AlignedAllocator
+{
+    typedef T value_type;
+
+    AlignedAllocator() = default;
+
+    template <class U>
+    AlignedAllocator( const AlignedAllocator<U> & )
+    {
+    }
+
+    T *allocate( std::size_t n )
+    {
+        return static_cast<T *>( ::operator new( n * sizeof( T ), std::align_val_t( Alignment ) ) );
+    }
+
+    void deallocate( T *p, std::size_t )
+    {
+        ::operator delete( p, std::align_val_t( Alignment ) );
+    }
+};
+
+template <class T, class U>
+bool operator==( const AlignedAllocator<T> &, const AlignedAllocator<U> & )
+{
+    return true;
+}
+
+template <class T, class U>
+bool operator!=( const AlignedAllocator<T> &, const AlignedAllocator<U> & )
+{
+    return false;
+}
+
+///
+/// \brief Массив с выравниванием Alignment
+///
+template <class T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+} // end namespace SIMD
+} // end namespace SPML
+#endif // SPML_SIMD_H
+/// \}
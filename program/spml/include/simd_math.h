@@ -0,0 +1,98 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       simd_math.h
+/// \brief      Пакетные элементарные функции (sin, cos, tan, atan, atan2, asin, acos) над массивами
+/// \details    Те же векторные реализации, что используются ядрами пакетных геодезических функций.
+///             Максимальная погрешность относительно правильно округленного результата (ULP - единица младшего
+///             разряда) для уровней векторизации SSE2 и выше:
+///             | функция | ULP | область                                       |
+///             |---------|-----|-----------------------------------------------|
+///             | Sin     | 2   | |x| <= 1e8 (за пределами - libm)              |
+///             | Cos     | 2   | |x| <= 1e8 (за пределами - libm)              |
+///             | SinCos  | 2   | |x| <= 1e8 (за пределами - libm)              |
+///             | Tan     | 4   | |x| <= 1e8 (за пределами - libm)              |
+///             | Atan    | 2   | все x                                         |
+///             | Atan2   | 2   | все x, y; особые случаи как у std::atan2      |
+///             | Asin    | 2   | [-1, 1]                                       |
+///             | Acos    | 2   | [-1, 1]                                       |
+///             Вблизи нулей sin и cos (x = k * PI/2) результат мал, и относительная погрешность растет (для Tan -
+///             и вблизи полюсов): там абсолютная погрешность Sin, Cos и SinCos не превышает 1e-30 * |x| (точность
+///             приведения аргумента).
+///             \n Уровень SL_Scalar и сборка с опцией SPML_LIBM_MATH используют libm (std::sin и т.д.):
+///             результаты побитово совпадают со скалярными функциями библиотеки.
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_SIMD_MATH_H
+#define SPML_SIMD_MATH_H
+
+// System includes:
+#include <cstddef>
+
+// SPML includes:
+#include <simd.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace SIMD /// Уровни векторизации пакетных функций
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Элементарная функция для пакетного вычисления
+///
+enum TMathFunction : int
+{
+    MF_Sin = 0,     ///< sin( x )
+    MF_Cos,         ///< cos( x )
+    MF_SinCos,      ///< sin( x ) и cos( x ) одновременно
+    MF_Tan,         ///< tan( x )
+    MF_Atan,        ///< atan( x )
+    MF_Atan2,       ///< atan2( y, x )
+    MF_Asin,        ///< asin( x )
+    MF_Acos         ///< acos( x )
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Признак сборки с элементарными функциями через libm (опция SPML_LIBM_MATH)
+/// \return true - векторные реализации отключены, все уровни векторизации используют libm
+///
+bool IsLibmMath();
+
+///
+/// \brief Пакетное вычисление элементарной функции одного аргумента
+/// \param[in]  func  - функция (кроме MF_SinCos и MF_Atan2)
+/// \param[in]  x     - массив аргументов [рад]
+/// \param[in]  count - размер массивов
+/// \param[out] out   - массив результатов (может совпадать с x)
+/// \param[in]  level - уровень векторизации (по умолчанию наилучший доступный)
+///
+void Evaluate( TMathFunction func, const double *x, std::size_t count, double *out, TSimdLevel level = SL_Auto );
+
+///
+/// \brief Пакетное вычисление синуса и косинуса с общим приведением аргумента
+/// \param[in]  x     - массив аргументов [рад]
+/// \param[in]  count - размер массивов
+/// \param[out] s     - массив синусов
+/// \param[out] c     - массив косинусов
+/// \param[in]  level - уровень векторизации (по умолчанию наилучший доступный)
+///
+void SinCos( const double *x, std::size_t count, double *s, double *c, TSimdLevel level = SL_Auto );
+
+///
+/// \brief Пакетное вычисление арктангенса y / x с учетом квадранта
+/// \param[in]  y     - массив числителей
+/// \param[in]  x     - массив знаменателей
+/// \param[in]  count - размер массивов
+/// \param[out] out   - массив результатов [рад] в диапазоне [-PI, PI]
+/// \param[in]  level - уровень векторизации (по умолчанию наилучший доступный)
+///
+void Atan2( const double *y, const double *x, std::size_t count, double *out, TSimdLevel level = SL_Auto );
+
+} // end namespace SIMD
+} // end namespace SPML
+#endif // SPML_SIMD_MATH_H
+/// \}
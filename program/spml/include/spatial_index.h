@@ -0,0 +1,190 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       spatial_index.h
+/// \brief      Пространственный индекс точек на поверхности эллипсоида (k-d дерево в ECEF)
+/// \details    Точки переводятся в ECEF (GEOtoECEF_Batch) и укладываются в сбалансированное k-d дерево без
+///             указателей: узел - медиана своего диапазона массива, поддеревья - половины диапазона, листья - не
+///             более CSpatialIndex::LeafSize точек, просматриваемых подряд. Отсечение ведется по длине хорды, которая
+///             не превышает длины геодезической линии, поэтому уточнение найденных кандидатов обратной
+///             геодезической задачей дает точный ответ.
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_SPATIAL_INDEX_H
+#define SPML_SPATIAL_INDEX_H
+
+// System includes:
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// SPML includes:
+#include <execution.h>
+#include <geodesy.h>
+#include <units.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Пространственный индекс точек для поиска ближайших соседей по геодезическому расстоянию
+/// \details Единицы измерения задаются при создании и используются во всех методах (входы и выходы). Высоты не
+/// учитываются: точки и запросы считаются лежащими на поверхности эллипсоида.
+/// \n Поиск k ближайших: k ближайших по хорде уточняются обратной задачей, затем все точки с хордой не больше
+/// k-го найденного геодезического расстояния S_k также уточняются (хорда <= геодезической, поэтому точка ближе
+/// S_k по геодезической не может быть дальше S_k по хорде). Результат совпадает с полным перебором с той же
+/// обратной задачей. Объект неизменяем после создания и может использоваться из нескольких потоков
+///
+class CSpatialIndex
+{
+public:
+    static const std::size_t LeafSize = 16; ///< Наибольшее число точек листа дерева
+    static const std::size_t NoIndex = static_cast<std::size_t>( -1 ); ///< Номер точки для отсутствующего соседа
+
+    ///
+    /// \brief Параметрический конструктор: построение индекса по набору точек
+    /// \param[in] ellipsoid - земной эллипсоид
+    /// \param[in] rangeUnit - единицы измерения дальности
+    /// \param[in] angleUnit - единицы измерения углов
+    /// \param[in] lat       - массив широт точек
+    /// \param[in] lon       - массив долгот точек
+    /// \param[in] count     - число точек (размер массивов)
+    /// \param[in] method    - метод обратной геодезической задачи для уточнения расстояний
+    ///
+    CSpatialIndex( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+        const double *lat, const double *lon, std::size_t count, TGeodesicMethod method = GM_Vincenty );
+
+    ///
+    /// \brief Земной эллипсоид
+    /// \return Возвращает эллипсоид, на котором заданы точки
+    ///
+    const CEllipsoid &Ellipsoid() const
+    {
+        return ellipsoid;
+    }
+
+    ///
+    /// \brief Единицы измерения дальности
+    /// \return Возвращает единицы измерения дальности входов и выходов методов
+    ///
+    Units::TRangeUnit RangeUnit() const
+    {
+        return rangeUnit;
+    }
+
+    ///
+    /// \brief Единицы измерения углов
+    /// \return Возвращает единицы измерения углов входов и выходов методов
+    ///
+    Units::TAngleUnit AngleUnit() const
+    {
+        return angleUnit;
+    }
+
+    ///
+    /// \brief Число точек индекса
+    /// \return Возвращает число точек, по которым построен индекс
+    ///
+    std::size_t Size() const
+    {
+        return order.size();
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    ///
+    /// \brief Поиск k ближайших точек
+    /// \details Результаты упорядочены по возрастанию расстояния, при равных расстояниях - по номеру точки.
+    /// Если k > Size(), лишние элементы массивов заполняются номером NoIndex и расстоянием NaN
+    /// \param[in]  lat   - широта точки запроса
+    /// \param[in]  lon   - долгота точки запроса
+    /// \param[in]  k     - число соседей (размер выходных массивов)
+    /// \param[out] index - номера найденных точек во входных массивах конструктора
+    /// \param[out] d     - расстояния по геодезической линии до найденных точек
+    /// \param[out] az    - азимуты из точки запроса на найденные точки (может быть nullptr)
+    /// \return Число найденных точек min( k, Size() )
+    ///
+    std::size_t Nearest( double lat, double lon, std::size_t k, std::size_t *index, double *d,
+        double *az = nullptr ) const;
+
+    ///
+    /// \brief Пакетный поиск k ближайших точек для массива точек запроса
+    /// \details Результаты запроса i - элементы [i * k, ( i + 1 ) * k) выходных массивов (см. Nearest)
+    /// \param[in]  lat     - массив широт точек запроса
+    /// \param[in]  lon     - массив долгот точек запроса
+    /// \param[in]  count   - число точек запроса
+    /// \param[in]  k       - число соседей
+    /// \param[out] index   - номера найденных точек, count * k
+    /// \param[out] d       - расстояния до найденных точек, count * k
+    /// \param[out] az      - азимуты на найденные точки, count * k (может быть nullptr)
+    /// \param[in]  threads - число потоков пула (0 - все, по умолчанию 1)
+    ///
+    void Nearest( const double *lat, const double *lon, std::size_t count, std::size_t k, std::size_t *index,
+        double *d, double *az = nullptr, unsigned int threads = 1 ) const;
+
+    ///
+    /// \brief Пакетный поиск k ближайших точек с политикой выполнения
+    /// \details Параметр threads заменен политикой выполнения (см. execution.h), уровень векторизации не
+    /// используется. Если размер части в политике не задан, запросы раздаются потокам частями по 64 (время запросов
+    /// различается). Остальные параметры совпадают с параметрами пакетного Nearest
+    /// \param[in]  policy  - политика выполнения
+    ///
+    void Nearest( const double *lat, const double *lon, std::size_t count, std::size_t k, std::size_t *index,
+        double *d, double *az, const Execution::Policy &policy ) const;
+
+    ///
+    /// \brief Поиск всех точек в пределах заданного расстояния
+    /// \details Кандидаты отбираются по хорде (хорда не больше расстояния), для каждого кандидата - GEOWithinRange
+    /// выбранным методом (обратная задача решается, только если границы расстояния не разделяют range)
+    /// \param[in]  lat   - широта точки запроса
+    /// \param[in]  lon   - долгота точки запроса
+    /// \param[in]  range - наибольшее расстояние
+    /// \param[out] index - номера найденных точек во входных массивах конструктора по возрастанию (предыдущее
+    /// содержимое удаляется)
+    /// \return Число найденных точек
+    ///
+    std::size_t Within( double lat, double lon, double range, std::vector<std::size_t> &index ) const;
+
+private:
+    CEllipsoid ellipsoid;           ///< Земной эллипсоид
+    Units::TRangeUnit rangeUnit;    ///< Единицы измерения дальности
+    Units::TAngleUnit angleUnit;    ///< Единицы измерения углов
+    TGeodesicMethod method;         ///< Метод обратной задачи
+    double angleIn;                 ///< Множитель перевода входных углов в [рад]
+    double angleOut;                ///< Множитель перевода [рад] в выходные углы
+    double rangeOut;                ///< Множитель перевода [м] в выходную дальность
+
+    // Точки в порядке дерева. Координаты ECEF используются при обходе, остальное - только при уточнении
+    std::vector<double> xyz;        ///< Координаты ECEF [м], по три на точку
+    std::vector<double> latRad;     ///< Широты [рад]
+    std::vector<double> lonRad;     ///< Долготы [рад]
+    std::vector<std::size_t> order; ///< Номера точек во входных массивах
+    std::vector<std::uint8_t> axis; ///< Ось разбиения узла (0 - X, 1 - Y, 2 - Z), для листьев не используется
+
+    // Кандидат: квадрат хорды и позиция в порядке дерева
+    typedef std::pair<double, std::size_t> TCandidate;
+
+    // Построение поддерева диапазона [begin, end) перестановкой perm
+    void Build( std::size_t begin, std::size_t end, std::vector<std::size_t> &perm, const std::vector<double> &p );
+
+    // Квадрат хорды от точки запроса до точки дерева
+    double Chord2( const double q[3], std::size_t i ) const;
+
+    // k ближайших по хорде (куча с наибольшим элементом в начале)
+    void SearchNearest( std::size_t begin, std::size_t end, const double q[3], std::size_t k,
+        std::vector<TCandidate> &heap ) const;
+
+    // Все точки с квадратом хорды в пределах [lo2, hi2]
+    void SearchRange( std::size_t begin, std::size_t end, const double q[3], double lo2, double hi2,
+        std::vector<TCandidate> &found ) const;
+};
+
+} // end namespace Geodesy
+} // end namespace SPML
+#endif // SPML_SPATIAL_INDEX_H
+/// \}
@@ -21,8 +21,19 @@
 #include <compare.h>
 #include <consts.h>
 #include <convert.h>
+#include <execution.h>
+#include <geodesic.h>
+#include <geodesic_line.h>
+#include <geofence.h>
 #include <geodesy.h>
+#include <geodesy_batch.h>
+#include <local_frame.h>
+#include <shm_ring.h>
+#include <simd.h>
+#include <simd_math.h>
+#include <spatial_index.h>
 #include <units.h>
+#include <vincenty_stats.h>
 
 namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
 {
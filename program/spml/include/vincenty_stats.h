@@ -0,0 +1,107 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       vincenty_stats.h
+/// \brief      Статистика сходимости итераций формул Винсента (обратная и прямая геодезические задачи)
+/// \details    GEOtoRAD прекращает итерации по lambda после 100 повторений, RADtoGEO по sigma - после 1001, не сообщая
+///             об этом вызывающему. Статистика показывает, сколько решений пошло по медленному пути: гистограмма числа
+///             итераций, число выходов по пределу итераций (без сходимости) и число ранних выходов для совпадающих
+///             точек. Учитываются решения на эллипсоиде методом Винсента скалярных функций (geodesy.h) и пакетных
+///             ядер (geodesy_batch.h и использующие их geofence.h, spatial_index.h; в пакетах - по каждой точке).
+///             \n Каждый поток увеличивает свои счетчики без блокировок и без обмена строками кэша с другими
+///             потоками; GetVincentyStats суммирует счетчики всех потоков, включая завершившиеся.
+///             \n Статистика собирается, если библиотека собрана с опцией SPML_VINCENTY_STATS (по умолчанию
+///             включена). Без нее код сбора полностью исключается при компиляции, функции этого файла остаются и
+///             возвращают нулевую статистику.
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_VINCENTY_STATS_H
+#define SPML_VINCENTY_STATS_H
+
+// System includes:
+#include <cstdint>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+//----------------------------------------------------------------------------------------------------------------------
+static const unsigned VincentyHistogramBins = 24; ///< Число интервалов гистограммы числа итераций
+
+///
+/// \brief Номер интервала гистограммы для числа итераций
+/// \details Интервалы 0...15 - ровно 0...15 итераций, далее по степеням двойки: 16 - [16, 32), 17 - [32, 64), ...,
+/// 22 - [1024, 2048), 23 - 2048 и более
+/// \param[in] iterations - число итераций
+/// \return Номер интервала (меньше VincentyHistogramBins)
+///
+inline unsigned VincentyHistogramBin( unsigned iterations )
+{
+    if( iterations < 16 ) {
+        return iterations;
+    }
+    unsigned bin = 13; // 16...31 -> 16: три сдвига до 1
+    while( ( iterations >>= 1 ) > 1 ) {
+        bin++;
+    }
+    return ( bin < VincentyHistogramBins - 1 ) ? bin : VincentyHistogramBins - 1;
+}
+
+///
+/// \brief Наименьшее число итераций интервала гистограммы
+/// \param[in] bin - номер интервала (меньше VincentyHistogramBins)
+/// \return Наименьшее число итераций, попадающее в интервал
+///
+inline unsigned VincentyHistogramBinLow( unsigned bin )
+{
+    return ( bin < 16 ) ? bin : ( 1u << ( bin - 12 ) );
+}
+
+///
+/// \brief Статистика итераций одной геодезической задачи
+///
+struct TVincentyLoopStats
+{
+    std::uint64_t Calls = 0;        ///< Число решений на эллипсоиде методом Винсента
+    std::uint64_t NotConverged = 0; ///< Число выходов по пределу числа итераций (без сходимости)
+    std::uint64_t Coincident = 0;   ///< Число ранних выходов для совпадающих точек (только обратная задача)
+    std::uint64_t Histogram[VincentyHistogramBins] = {}; ///< Число решений по числу итераций (VincentyHistogramBin)
+};
+
+///
+/// \brief Статистика итераций формул Винсента
+///
+struct TVincentyStats
+{
+    TVincentyLoopStats Inverse; ///< Обратная задача (GEOtoRAD, итерации по lambda, не более 100)
+    TVincentyLoopStats Direct;  ///< Прямая задача (RADtoGEO, итерации по sigma, не более 1001)
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Признак сборки библиотеки со сбором статистики (опция SPML_VINCENTY_STATS)
+/// \return true, если статистика собирается
+///
+bool VincentyStatsEnabled();
+
+///
+/// \brief Статистика итераций с последнего ResetVincentyStats (или с начала работы программы)
+/// \details Сумма по всем потокам. Решения, выполняемые в других потоках во время вызова, могут быть учтены частично
+/// \return Статистика (нулевая, если сбор статистики исключен при сборке)
+///
+TVincentyStats GetVincentyStats();
+
+///
+/// \brief Начало нового отсчета статистики
+/// \details Счетчики потоков не обнуляются (их пишут только сами потоки): запоминаются текущие суммы, которые далее
+/// вычитаются в GetVincentyStats, поэтому вызов безопасен во время решений в других потоках
+///
+void ResetVincentyStats();
+
+} // end namespace Geodesy
+} // end namespace SPML
+#endif // SPML_VINCENTY_STATS_H
+/// \}
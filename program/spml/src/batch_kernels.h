@@ -0,0 +1,203 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       batch_kernels.h
+/// \brief      Таблицы ядер пакетных функций для разных уровней векторизации (внутренний заголовок)
+/// \details    Каждая таблица заполняется в отдельной единице трансляции, собранной с ключами под свой набор
+///             инструкций (batch_kernels_*.cpp). Если набор инструкций не поддерживается компилятором,
+///             функция получения таблицы возвращает nullptr.
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_BATCH_KERNELS_H
+#define SPML_BATCH_KERNELS_H
+
+// System includes:
+#include <cstddef>
+
+// SPML includes:
+#include <geodesy_registry.h>
+#include <simd.h>
+#include <simd_math.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Batch /// Ядра пакетных функций (внутреннее)
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Параметры эллипсоида, используемые ядрами
+///
+struct TKernelEllipsoid
+{
+    double a;           ///< Большая полуось, [м]
+    double b;           ///< Малая полуось, [м]
+    double f;           ///< Сжатие
+    double ep2;         ///< Квадрат второго эксцентриситета ( a * a - b * b ) / ( b * b )
+    double es;          ///< Квадрат первого эксцентриситета ( a * a - b * b ) / ( a * a )
+    Geodesy::OlsonCoefficients olson; ///< Коэффициенты алгоритма Олсона
+    bool isSphere;      ///< Признак сферы (a == b), используются упрощенные формулы
+};
+
+///
+/// \brief Множители перевода единиц измерения (применяются один раз на пакет)
+///
+struct TKernelUnits
+{
+    double angleIn;     ///< Входные углы -> радианы
+    double angleOut;    ///< Радианы -> выходные углы
+    double rangeIn;     ///< Входная дальность -> метры
+    double rangeOut;    ///< Метры -> выходная дальность
+};
+
+///
+/// \brief Величины, зависящие только от начальной точки (вычисляются один раз на пакет)
+///
+struct TKernelOrigin
+{
+    double lat;         ///< Широта, [рад]
+    double lon;         ///< Долгота, [рад]
+    double sinLat;      ///< sin( lat )
+    double cosLat;      ///< cos( lat )
+    double tanU1;       ///< Тангенс приведенной широты ( 1 - f ) * tan( lat )
+    double sinU1;       ///< Синус приведенной широты
+    double cosU1;       ///< Косинус приведенной широты
+};
+
+///
+/// \brief Поворот осей местной системы ENU опорной точки относительно осей ECEF (вычисляется один раз на пакет)
+///
+struct TKernelFrame
+{
+    double sinLat;      ///< sin( lat0 )
+    double cosLat;      ///< cos( lat0 )
+    double sinLon;      ///< sin( lon0 )
+    double cosLon;      ///< cos( lon0 )
+};
+
+///
+/// \brief Ядро пакетного решения обратной геодезической задачи (формулы Винсента)
+/// \details azEnd может быть nullptr
+///
+typedef void ( *TGEOtoRADKernel )( const TKernelEllipsoid &el, const TKernelUnits &units,
+    const double *latStart, const double *lonStart, const double *latEnd, const double *lonEnd, std::size_t count,
+    double *d, double *az, double *azEnd );
+
+///
+/// \brief Ядро обратной геодезической задачи от одной точки до массива точек (строка матрицы расстояний)
+/// \details rowSin, rowCos, colSin, colCos - синусы и косинусы приведенных широт (на сфере - широт),
+///          rowLon, colLon - долготы [рад]. azEnd может быть nullptr
+///
+typedef void ( *TGEOtoRADRowKernel )( const TKernelEllipsoid &el, const TKernelUnits &units, double rowSin,
+    double rowCos, double rowLon, const double *colSin, const double *colCos, const double *colLon, std::size_t count,
+    double *d, double *az, double *azEnd );
+
+///
+/// \brief Ядро пакетного решения прямой геодезической задачи из одной начальной точки (формулы Винсента)
+/// \details azEnd может быть nullptr
+///
+typedef void ( *TRADtoGEOFanKernel )( const TKernelEllipsoid &el, const TKernelUnits &units, const TKernelOrigin &origin,
+    const double *d, const double *az, std::size_t count, double *latEnd, double *lonEnd, double *azEnd );
+
+///
+/// \brief Ядро пакетного пересчета ECEF в географические координаты (алгоритм Олсона)
+///
+typedef void ( *TECEFtoGEOKernel )( const TKernelEllipsoid &el, const TKernelUnits &units,
+    const double *x, const double *y, const double *z, std::size_t count, double *lat, double *lon, double *h );
+
+///
+/// \brief Ядро пакетного пересчета географических координат в ECEF
+///
+typedef void ( *TGEOtoECEFKernel )( const TKernelEllipsoid &el, const TKernelUnits &units,
+    const double *lat, const double *lon, const double *h, std::size_t count, double *x, double *y, double *z );
+
+///
+/// \brief Ядро пакетного вычисления элементарной функции
+/// \details b - второй аргумент (только MF_Atan2), out2 - второй результат (только MF_SinCos)
+///
+typedef void ( *TMathKernel )( SIMD::TMathFunction func, const double *a, const double *b, std::size_t count,
+    double *out1, double *out2 );
+
+///
+/// \brief Ядро пакетного перевода координат в местной системе (ENU <-> AER) для значений типа T
+/// \details Из units используются только множители углов: дальность входа и выхода в одних единицах
+///
+template <class T>
+using TLocalKernel = void ( * )( const TKernelUnits &units, const T *in1, const T *in2, const T *in3,
+    std::size_t count, T *out1, T *out2, T *out3 );
+
+///
+/// \brief Ядро пакетного поворота векторов между осями ECEF и ENU опорной точки для значений типа T
+///
+template <class T>
+using TFrameKernel = void ( * )( const TKernelFrame &frame, const T *in1, const T *in2, const T *in3,
+    std::size_t count, T *out1, T *out2, T *out3 );
+
+///
+/// \brief Ядра местной системы координат для значений типа T (double или float)
+///
+template <class T>
+struct TLocalKernels
+{
+    int width;                  ///< Число значений T, обрабатываемых за раз
+    TLocalKernel<T> ENUtoAER;   ///< ENU -> AER
+    TLocalKernel<T> AERtoENU;   ///< AER -> ENU
+    TFrameKernel<T> ECEFtoENUV; ///< Смещение по осям ECEF -> ENU
+    TFrameKernel<T> ENUtoUVW;   ///< ENU -> смещение по осям ECEF (UVW)
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Таблица ядер одного уровня векторизации
+///
+struct TKernelTable
+{
+    SIMD::TSimdLevel level;          ///< Уровень векторизации
+    int width;                       ///< Число значений double, обрабатываемых за раз
+    TGEOtoRADKernel GEOtoRAD;        ///< Обратная геодезическая задача
+    TGEOtoRADRowKernel GEOtoRADRow;  ///< Обратная геодезическая задача для строки матрицы расстояний
+    TRADtoGEOFanKernel RADtoGEOFan;  ///< Прямая геодезическая задача из одной начальной точки
+    TECEFtoGEOKernel ECEFtoGEO;      ///< Пересчет ECEF в географические координаты
+    TGEOtoECEFKernel GEOtoECEF;      ///< Пересчет географических координат в ECEF
+    TMathKernel Math;                ///< Элементарные функции
+    TLocalKernels<double> Local;     ///< Местная система координат, double
+    TLocalKernels<float> LocalFloat; ///< Местная система координат, float (вдвое больше значений за раз)
+};
+
+///
+/// \brief Таблица ядер без векторизации
+/// \return Указатель на таблицу (всегда не nullptr)
+///
+const TKernelTable *KernelsScalar();
+
+///
+/// \brief Таблица ядер SSE2
+/// \return Указатель на таблицу или nullptr, если библиотека собрана без поддержки SSE2
+///
+const TKernelTable *KernelsSSE2();
+
+///
+/// \brief Таблица ядер AVX2
+/// \return Указатель на таблицу или nullptr, если библиотека собрана без поддержки AVX2
+///
+const TKernelTable *KernelsAVX2();
+
+///
+/// \brief Таблица ядер AVX-512
+/// \return Указатель на таблицу или nullptr, если библиотека собрана без поддержки AVX-512
+///
+const TKernelTable *KernelsAVX512();
+
+///
+/// \brief Таблица ядер для заданного уровня векторизации
+/// \param[in] level - уровень векторизации (SL_Auto - наилучший доступный)
+/// \return Указатель на таблицу наилучшего доступного уровня, не выше запрошенного
+///
+const TKernelTable *Kernels( SIMD::TSimdLevel level );
+
+} // end namespace Batch
+} // end namespace SPML
+#endif // SPML_BATCH_KERNELS_H
+/// \}
@@ -0,0 +1,33 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       batch_kernels_avx2.cpp
+/// \brief      Ядра пакетных функций: AVX2 (4 значения double или 8 float за раз), собирается с ключами -mavx2 -mfma
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#include <batch_kernels_impl.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Batch /// Ядра пакетных функций (внутреннее)
+{
+//----------------------------------------------------------------------------------------------------------------------
+#if defined( __AVX2__ )
+const TKernelTable *KernelsAVX2()
+{
+    static const TKernelTable table = MakeKernelTable<SIMD::VecAVX2, SIMD::VecF8>( SIMD::SL_AVX2 );
+    return &table;
+}
+#else
+const TKernelTable *KernelsAVX2()
+{
+    return nullptr;
+}
+#endif
+
+} // end namespace Batch
+} // end namespace SPML
+/// \}
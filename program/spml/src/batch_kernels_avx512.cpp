@@ -0,0 +1,34 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       batch_kernels_avx512.cpp
+/// \brief      Ядра пакетных функций: AVX-512F (8 значений double или 16 float за раз)
+/// \details    Собирается с ключами -mavx512f -mavx512dq -mfma
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#include <batch_kernels_impl.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Batch /// Ядра пакетных функций (внутреннее)
+{
+//----------------------------------------------------------------------------------------------------------------------
+#if defined( __AVX512F__ )
+const TKernelTable *KernelsAVX512()
+{
+    static const TKernelTable table = MakeKernelTable<SIMD::VecAVX512, SIMD::VecF16>( SIMD::SL_AVX512 );
+    return &table;
+}
+#else
+const TKernelTable *KernelsAVX512()
+{
+    return nullptr;
+}
+#endif
+
+} // end namespace Batch
+} // end namespace SPML
+/// \}
@@ -0,0 +1,843 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       batch_kernels_impl.h
+/// \brief      Шаблоны ядер пакетных функций (внутренний заголовок)
+/// \details    Подключается только в batch_kernels_*.cpp. Ядра записаны один раз для произвольного векторного
+///             типа из simd_vec.h, каждая единица трансляции инстанцирует их со своим типом.
+///             Функции имеют внутреннее связывание (анонимное пространство имен), чтобы копии, собранные
+///             под разные наборы инструкций, не смешивались при компоновке.
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_BATCH_KERNELS_IMPL_H
+#define SPML_BATCH_KERNELS_IMPL_H
+
+// System includes:
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+// SPML includes:
+#include <compare.h>
+#include <consts.h>
+#include <batch_kernels.h>
+#include <simd_math_impl.h>
+#include <simd_vec.h>
+#include <vincenty_stats_impl.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Batch /// Ядра пакетных функций (внутреннее)
+{
+namespace
+{
+using namespace SIMD;
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Приведение угла в радианах из диапазона [-PI, PI] к диапазону [0, 2PI)
+/// \details Повторяет Convert::AngleTo360( angle, AU_Radian )
+///
+template <class V>
+inline V AngleTo360Rad( V angle )
+{
+    return Select( Lt( angle, V::Set1( 0.0 ) ), angle + Consts::PI_2_D, angle );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Запись статистики итераций формул Винсента по полосам вектора (см. vincenty_stats.h)
+/// \param[in] inverse      - обратная (true) или прямая (false) задача
+/// \param[in] iterations   - число итераций каждой полосы
+/// \param[in] notConverged - полосы без сходимости
+/// \param[in] coincident   - полосы совпадающих точек
+/// \param[in] lanes        - число первых полос с точками пакета (остальные дополняют неполный блок)
+///
+template <class V>
+inline void RecordVincentyLanes( bool inverse, const V &iterations, const typename V::Mask &notConverged,
+    const typename V::Mask &coincident, int lanes )
+{
+    const V one = V::Set1( 1.0 );
+    const V zero = V::Set1( 0.0 );
+    alignas( 64 ) double count[V::Width], failed[V::Width], same[V::Width];
+    Store( count, iterations );
+    Store( failed, Select( notConverged, one, zero ) );
+    Store( same, Select( coincident, one, zero ) );
+    for( int i = 0; i < lanes; i++ ) {
+        const Geodesy::TVincentyOutcome outcome = ( same[i] != 0.0 ) ? Geodesy::VO_Coincident :
+            ( ( failed[i] != 0.0 ) ? Geodesy::VO_NotConverged : Geodesy::VO_Converged );
+        if( inverse ) {
+            Geodesy::RecordVincentyInverse( static_cast<unsigned>( count[i] ), outcome );
+        } else {
+            Geodesy::RecordVincentyDirect( static_cast<unsigned>( count[i] ), outcome );
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Обратная геодезическая задача по синусам и косинусам широт (вычисления в [рад] и [м])
+/// \details Повторяет Geodesy::GEOtoRAD: для эллипсоида - итерации Винсента (eq. 13-21) не более 100 раз,
+///          каждая полоса (lane) вектора исключается из обновления после сходимости.
+///          s1, c1, s2, c2 - синусы и косинусы приведенных широт (на сфере - широт), L - разность долгот,
+///          lanes - число первых полос с точками пакета для статистики итераций
+///
+template <class V>
+inline void GEOtoRADTrig( const TKernelEllipsoid &el, const V &s1, const V &c1, const V &s2, const V &c2, const V &L,
+    V &vd, V &vaz, V &vazEnd, int lanes = V::Width )
+{
+    typedef typename V::Mask M;
+
+    if( el.isSphere ) { // При расчете на сфере используем упрощенные формулы
+        const V &sinLat1 = s1, &cosLat1 = c1, &sinLat2 = s2, &cosLat2 = c2;
+        V sinDLon, cosDLon;
+        SinCos( L, sinDLon, cosDLon );
+
+        vaz = AngleTo360Rad( Atan2( cosLat2 * sinDLon, cosLat1 * sinLat2 - sinLat1 * cosLat2 * cosDLon ) );
+        vazEnd = AngleTo360Rad( Atan2( cosLat1 * sinDLon, cosLat1 * sinLat2 * cosDLon - sinLat1 * cosLat2 ) );
+        vd = Acos( sinLat1 * sinLat2 + cosLat1 * cosLat2 * cosDLon ) * el.a;
+    } else { // Для эллипсоида используем формулы Винсента
+        const double f = el.f;
+        const V &sinU1 = s1, &cosU1 = c1, &sinU2 = s2, &cosU2 = c2;
+
+        // eq. 13
+        const V zero = V::Set1( 0.0 );
+        V lambda = L;
+        V sinLambda = zero;
+        V cosLambda = zero;
+        V sinSigma = zero;
+        V cosSigma = zero;
+        V sigma = zero;
+        V cosSqAlpha = zero;
+        V cos2SigmaM = zero;
+
+        M active = MaskTrue( L );
+        M coincident = MaskFalse( L );
+        V iterations = zero;
+        for( int iter = 0; ( iter < 100 ) && Any( active ); iter++ ) {
+            if( Geodesy::CollectVincentyStats ) {
+                iterations = iterations + Select( active, V::Set1( 1.0 ), zero );
+            }
+            V sL, cL;
+            SinCos( lambda, sL, cL );
+
+            // eq. 14
+            const V t1 = cosU2 * sL;
+            const V t2 = cosU1 * sinU2 - sinU1 * cosU2 * cL;
+            const V sS = Sqrt( t1 * t1 + t2 * t2 );
+            const M zeroSigma = And( active, Le( Abs( sS ), V::Set1( Compare::EPS_D ) ) ); // co-incident points
+            coincident = Or( coincident, zeroSigma );
+            active = AndNot( active, zeroSigma );
+
+            // eq. 15
+            const V cS = sinU1 * sinU2 + cosU1 * cosU2 * cL;
+
+            // eq. 16
+            const V sg = Atan2( sS, cS );
+
+            // eq. 17
+            const V sA = cosU1 * cosU2 * sL / sS;
+            const V cSqA = 1.0 - sA * sA;
+
+            // eq. 18
+            V c2SM = cS - 2.0 * sinU1 * sinU2 / cSqA;
+            c2SM = Select( IsNan( c2SM ), zero, c2SM ); // equatorial line: cosSqAlpha = 0
+
+            // eq. 10
+            const V c = ( f / 16.0 ) * cSqA * ( 4.0 + f * ( 4.0 - 3.0 * cSqA ) );
+
+            // eq. 11 (modified)
+            const V lambdaNew = L + ( 1.0 - c ) * f * sA *
+                ( sg + c * sS * ( c2SM + c * cS * ( -1.0 + 2.0 * c2SM * c2SM ) ) );
+
+            // Обновляем только не сошедшиеся полосы
+            sinLambda = Select( active, sL, sinLambda );
+            cosLambda = Select( active, cL, cosLambda );
+            sinSigma = Select( active, sS, sinSigma );
+            cosSigma = Select( active, cS, cosSigma );
+            sigma = Select( active, sg, sigma );
+            cosSqAlpha = Select( active, cSqA, cosSqAlpha );
+            cos2SigmaM = Select( active, c2SM, cos2SigmaM );
+            const M improving = Gt( Abs( ( lambdaNew - lambda ) / lambdaNew ), V::Set1( 1.0e-15 ) );
+            lambda = Select( active, lambdaNew, lambda );
+            active = And( active, improving );
+        }
+        if( Geodesy::CollectVincentyStats ) {
+            RecordVincentyLanes( true, iterations, active, coincident, lanes );
+        }
+
+        const V uSq = cosSqAlpha * ( el.a * el.a - el.b * el.b ) / ( el.b * el.b );
+
+        // eq. 3
+        const V A = 1.0 + uSq / 16384.0 * ( 4096.0 + uSq * ( -768.0 + uSq * ( 320.0 - 175.0 * uSq ) ) );
+
+        // eq. 4
+        const V B = uSq / 1024.0 * ( 256.0 + uSq * ( -128.0 + uSq * ( 74.0 - 47.0 * uSq ) ) );
+
+        // eq. 6
+        const V deltaSigma = B * sinSigma *
+            ( cos2SigmaM + ( B / 4.0 ) * ( cosSigma * ( -1.0 + 2.0 * cos2SigmaM * cos2SigmaM ) -
+            ( B / 6.0 ) * cos2SigmaM * ( -3.0 + 4.0 * sinSigma * sinSigma ) * ( -3.0 + 4.0 * cos2SigmaM * cos2SigmaM ) ) );
+
+        // eq. 19
+        vd = Select( coincident, zero, el.b * A * ( sigma - deltaSigma ) );
+
+        // eq. 20
+        vaz = Select( coincident, zero,
+            AngleTo360Rad( Atan2( cosU2 * sinLambda, cosU1 * sinU2 - sinU1 * cosU2 * cosLambda ) ) );
+
+        // eq. 21
+        vazEnd = Select( coincident, zero,
+            AngleTo360Rad( Atan2( cosU1 * sinLambda, cosU1 * sinU2 * cosLambda - sinU1 * cosU2 ) ) );
+    }
+}
+
+///
+/// \brief Обратная геодезическая задача для одного блока из V::Width точек
+///
+template <class V>
+inline void GEOtoRADBlock( const TKernelEllipsoid &el, const TKernelUnits &units,
+    const double *latStart, const double *lonStart, const double *latEnd, const double *lonEnd,
+    double *d, double *az, double *azEnd, int lanes = V::Width )
+{
+    const V lat1 = V::Load( latStart ) * units.angleIn;
+    const V lon1 = V::Load( lonStart ) * units.angleIn;
+    const V lat2 = V::Load( latEnd ) * units.angleIn;
+    const V lon2 = V::Load( lonEnd ) * units.angleIn;
+
+    V s1, c1, s2, c2;
+    if( el.isSphere ) {
+        SinCos( lat1, s1, c1 );
+        SinCos( lat2, s2, c2 );
+    } else { // Приведенные широты
+        const double f = el.f;
+        const V U1 = Atan( ( 1.0 - f ) * Tan( lat1 ) );
+        const V U2 = Atan( ( 1.0 - f ) * Tan( lat2 ) );
+        SinCos( U1, s1, c1 );
+        SinCos( U2, s2, c2 );
+    }
+
+    V vd, vaz, vazEnd;
+    GEOtoRADTrig<V>( el, s1, c1, s2, c2, lon2 - lon1, vd, vaz, vazEnd, lanes );
+
+    Store( d, vd * units.rangeOut );
+    Store( az, vaz * units.angleOut );
+    if( azEnd != nullptr ) {
+        Store( azEnd, vazEnd * units.angleOut );
+    }
+}
+
+///
+/// \brief Обратная геодезическая задача для массива точек
+/// \details Неполный последний блок дополняется нулями во временных массивах
+///
+template <class V>
+void GEOtoRADKernel( const TKernelEllipsoid &el, const TKernelUnits &units,
+    const double *latStart, const double *lonStart, const double *latEnd, const double *lonEnd, std::size_t count,
+    double *d, double *az, double *azEnd )
+{
+    const std::size_t W = static_cast<std::size_t>( V::Width );
+    std::size_t i = 0;
+    for( ; i + W <= count; i += W ) {
+        GEOtoRADBlock<V>( el, units, latStart + i, lonStart + i, latEnd + i, lonEnd + i,
+            d + i, az + i, ( azEnd != nullptr ) ? ( azEnd + i ) : nullptr );
+    }
+    if( i < count ) {
+        const std::size_t n = count - i;
+        double in[4][V::Width] = {};
+        double out[3][V::Width];
+        std::copy( latStart + i, latStart + count, in[0] );
+        std::copy( lonStart + i, lonStart + count, in[1] );
+        std::copy( latEnd + i, latEnd + count, in[2] );
+        std::copy( lonEnd + i, lonEnd + count, in[3] );
+        GEOtoRADBlock<V>( el, units, in[0], in[1], in[2], in[3], out[0], out[1], out[2], static_cast<int>( n ) );
+        std::copy( out[0], out[0] + n, d + i );
+        std::copy( out[1], out[1] + n, az + i );
+        if( azEnd != nullptr ) {
+            std::copy( out[2], out[2] + n, azEnd + i );
+        }
+    }
+}
+
+///
+/// \brief Обратная геодезическая задача от одной точки строки матрицы до массива точек столбцов
+/// \details Синусы и косинусы широт точек вычислены заранее (один раз на точку), неполный последний блок дополняется
+///          нулями во временных массивах
+///
+template <class V>
+void GEOtoRADRowKernel( const TKernelEllipsoid &el, const TKernelUnits &units, double rowSin, double rowCos,
+    double rowLon, const double *colSin, const double *colCos, const double *colLon, std::size_t count,
+    double *d, double *az, double *azEnd )
+{
+    const std::size_t W = static_cast<std::size_t>( V::Width );
+    const V s1 = V::Set1( rowSin );
+    const V c1 = V::Set1( rowCos );
+    const V lon1 = V::Set1( rowLon );
+    V vd, vaz, vazEnd;
+    std::size_t i = 0;
+    for( ; i + W <= count; i += W ) {
+        GEOtoRADTrig<V>( el, s1, c1, V::Load( colSin + i ), V::Load( colCos + i ), V::Load( colLon + i ) - lon1,
+            vd, vaz, vazEnd );
+        Store( d + i, vd * units.rangeOut );
+        Store( az + i, vaz * units.angleOut );
+        if( azEnd != nullptr ) {
+            Store( azEnd + i, vazEnd * units.angleOut );
+        }
+    }
+    if( i < count ) {
+        const std::size_t n = count - i;
+        double in[3][V::Width] = {};
+        double out[3][V::Width];
+        std::copy( colSin + i, colSin + count, in[0] );
+        std::copy( colCos + i, colCos + count, in[1] );
+        std::copy( colLon + i, colLon + count, in[2] );
+        GEOtoRADTrig<V>( el, s1, c1, V::Load( in[0] ), V::Load( in[1] ), V::Load( in[2] ) - lon1, vd, vaz, vazEnd,
+            static_cast<int>( n ) );
+        Store( out[0], vd * units.rangeOut );
+        Store( out[1], vaz * units.angleOut );
+        Store( out[2], vazEnd * units.angleOut );
+        std::copy( out[0], out[0] + n, d + i );
+        std::copy( out[1], out[1] + n, az + i );
+        if( azEnd != nullptr ) {
+            std::copy( out[2], out[2] + n, azEnd + i );
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Прямая геодезическая задача для одного блока из V::Width пар дальность-азимут из одной начальной точки
+/// \details Повторяет Geodesy::RADtoGEO: для эллипсоида - итерации Винсента по sigma (eq. 5-7) не более 1001 раза,
+///          каждая полоса вектора исключается из обновления после сходимости
+///
+template <class V>
+inline void RADtoGEOFanBlock( const TKernelEllipsoid &el, const TKernelUnits &units, const TKernelOrigin &origin,
+    const double *d, const double *az, double *latEnd, double *lonEnd, double *azEnd, int lanes = V::Width )
+{
+    typedef typename V::Mask M;
+
+    const V s = V::Load( d ) * units.rangeIn;       // [м]
+    const V alpha1 = V::Load( az ) * units.angleIn; // [рад]
+
+    V vlat, vlon, vazEnd;
+    if( el.isSphere ) { // При расчете на сфере используем упрощенные формулы
+        const V dn = s / el.a; // Нормирование
+        V sinD, cosD, sinAz, cosAz;
+        SinCos( dn, sinD, cosD );
+        SinCos( alpha1, sinAz, cosAz );
+
+        vlat = Asin( origin.sinLat * cosD + origin.cosLat * sinD * cosAz );
+        vlon = origin.lon + Atan2( sinD * sinAz, origin.cosLat * cosD - origin.sinLat * sinD * cosAz );
+        vazEnd = AngleTo360Rad( Atan2( origin.cosLat * sinAz, origin.cosLat * cosD * cosAz - origin.sinLat * sinD ) );
+    } else { // Для эллипсоида используем формулы Винсента
+        const double f = el.f;
+        V sinAlpha1, cosAlpha1;
+        SinCos( alpha1, sinAlpha1, cosAlpha1 );
+
+        // eq. 1
+        const V sigma1 = Atan2( V::Set1( origin.tanU1 ), cosAlpha1 );
+
+        // eq. 2
+        const V sinAlpha = origin.cosU1 * sinAlpha1;
+        const V cosSqAlpha = 1.0 - sinAlpha * sinAlpha;
+        const V uSq = cosSqAlpha * el.ep2;
+
+        // eq. 3
+        const V A = 1.0 + ( uSq / 16384.0 ) * ( 4096.0 + uSq * ( -768.0 + uSq * ( 320.0 - 175.0 * uSq ) ) );
+
+        // eq. 4
+        const V B = ( uSq / 1024.0 ) * ( 256.0 + uSq * ( -128.0 + uSq * ( 74.0 - 47.0 * uSq ) ) );
+
+        // iterate until there is a negligible change in sigma
+        const V sOverbA = s / ( el.b * A );
+        V sigma = sOverbA;
+        M active = MaskTrue( sigma );
+        V iterations = V::Set1( 0.0 );
+        for( int iter = 0; ( iter <= 1000 ) && Any( active ); iter++ ) {
+            if( Geodesy::CollectVincentyStats ) {
+                iterations = iterations + Select( active, V::Set1( 1.0 ), V::Set1( 0.0 ) );
+            }
+            // eq. 5
+            const V c2SM = Cos( 2.0 * sigma1 + sigma );
+            V sS, cS;
+            SinCos( sigma, sS, cS );
+
+            // eq. 6
+            const V deltaSigma = B * sS * ( c2SM +
+                ( B / 4.0 ) * ( cS * ( -1.0 + 2.0 * c2SM * c2SM ) -
+                ( B / 6.0 ) * c2SM * ( -3.0 + 4.0 * sS * sS ) * ( -3.0 + 4.0 * c2SM * c2SM ) ) );
+
+            // eq. 7
+            const V sigmaNew = sOverbA + deltaSigma;
+            const V change = Abs( sigmaNew - sigma );
+            sigma = Select( active, sigmaNew, sigma );
+            active = AndNot( active, Or( Lt( change, V::Set1( 1.0e-15 ) ), IsNan( change ) ) );
+        }
+        if( Geodesy::CollectVincentyStats ) {
+            RecordVincentyLanes( false, iterations, active, MaskFalse( sigma ), lanes );
+        }
+        const V cos2SigmaM = Cos( 2.0 * sigma1 + sigma );
+        V sinSigma, cosSigma;
+        SinCos( sigma, sinSigma, cosSigma );
+
+        const V tmp = origin.sinU1 * sinSigma - origin.cosU1 * cosSigma * cosAlpha1;
+
+        // eq. 8
+        vlat = Atan2( origin.sinU1 * cosSigma + origin.cosU1 * sinSigma * cosAlpha1,
+            ( 1.0 - f ) * Sqrt( sinAlpha * sinAlpha + tmp * tmp ) );
+
+        // eq. 9
+        const V lambda = Atan2( sinSigma * sinAlpha1, origin.cosU1 * cosSigma - origin.sinU1 * sinSigma * cosAlpha1 );
+
+        // eq. 10
+        const V c = ( f / 16.0 ) * cosSqAlpha * ( 4.0 + f * ( 4.0 - 3.0 * cosSqAlpha ) );
+
+        // eq. 11
+        const V L = lambda - ( 1.0 - c ) * f * sinAlpha * ( sigma + c * sinSigma *
+            ( cos2SigmaM + c * cosSigma * ( -1.0 + 2.0 * cos2SigmaM * cos2SigmaM ) ) );
+        vlon = origin.lon + L;
+
+        // eq. 12
+        vazEnd = AngleTo360Rad( Atan2( sinAlpha, -tmp ) );
+    }
+
+    Store( latEnd, vlat * units.angleOut );
+    Store( lonEnd, vlon * units.angleOut );
+    if( azEnd != nullptr ) {
+        Store( azEnd, vazEnd * units.angleOut );
+    }
+}
+
+///
+/// \brief Прямая геодезическая задача из одной начальной точки для массива пар дальность-азимут
+/// \details Неполный последний блок дополняется нулями во временных массивах
+///
+template <class V>
+void RADtoGEOFanKernel( const TKernelEllipsoid &el, const TKernelUnits &units, const TKernelOrigin &origin,
+    const double *d, const double *az, std::size_t count, double *latEnd, double *lonEnd, double *azEnd )
+{
+    const std::size_t W = static_cast<std::size_t>( V::Width );
+    std::size_t i = 0;
+    for( ; i + W <= count; i += W ) {
+        RADtoGEOFanBlock<V>( el, units, origin, d + i, az + i, latEnd + i, lonEnd + i,
+            ( azEnd != nullptr ) ? ( azEnd + i ) : nullptr );
+    }
+    if( i < count ) {
+        const std::size_t n = count - i;
+        double in[2][V::Width] = {};
+        double out[3][V::Width];
+        std::copy( d + i, d + count, in[0] );
+        std::copy( az + i, az + count, in[1] );
+        RADtoGEOFanBlock<V>( el, units, origin, in[0], in[1], out[0], out[1], out[2], static_cast<int>( n ) );
+        std::copy( out[0], out[0] + n, latEnd + i );
+        std::copy( out[1], out[1] + n, lonEnd + i );
+        if( azEnd != nullptr ) {
+            std::copy( out[2], out[2] + n, azEnd + i );
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Пересчет ECEF в географические координаты для одного блока из V::Width точек
+/// \details Повторяет Geodesy::ECEFtoGEO (Olson, 1996) без ветвлений: обе ветви начального приближения широты
+///          (через sin при c2 > 0.3 и через cos иначе) вычисляются во всех полосах и выбираются по маске.
+///          Вместо asin/acos широта начального приближения вычисляется одним atan2( s, c ) - на выбранной ветви
+///          sin и cos согласованы, и значение совпадает с asin( s ) / acos( c ) с точностью до округления
+///
+template <class V>
+inline void ECEFtoGEOBlock( const TKernelEllipsoid &el, const TKernelUnits &units,
+    const double *px, const double *py, const double *pz, double *lat, double *lon, double *h )
+{
+    typedef typename V::Mask M;
+
+    const Geodesy::OlsonCoefficients &olson = el.olson;
+    const V x = V::Load( px ) * units.rangeIn; // [м]
+    const V y = V::Load( py ) * units.rangeIn;
+    const V z = V::Load( pz ) * units.rangeIn;
+
+    const V zp = Abs( z );
+    const V w2 = x * x + y * y;
+    const V w = Sqrt( w2 );
+    const V z2 = z * z;
+    const V r2 = w2 + z2;
+    const V r = Sqrt( r2 );
+    const V vlon = Atan2( y, x );
+    const V s2 = z2 / r2;
+    const V c2 = w2 / r2;
+    V u = olson.a2 / r;
+    V v = olson.a3 - olson.a4 / r;
+
+    // Ветвь 1 ( c2 > 0.3 ): известен sin
+    const V s1 = ( zp / r ) * ( 1.0 + c2 * ( olson.a1 + u + s2 * v ) / r );
+    const V ss1 = s1 * s1;
+    const V cc1 = Max( 1.0 - ss1, V::Set1( 0.0 ) ); // Вне своей ветви может быть < 0
+    // Ветвь 2: известен cos
+    const V c0 = ( w / r ) * ( 1.0 - s2 * ( olson.a5 - u - c2 * v ) / r );
+    const V ss0 = Max( 1.0 - c0 * c0, V::Set1( 0.0 ) );
+
+    const M branch1 = Gt( c2, V::Set1( 0.3 ) );
+    const V ss = Select( branch1, ss1, ss0 );
+    const V s = Select( branch1, s1, Sqrt( ss0 ) );
+    const V c = Select( branch1, Sqrt( cc1 ), c0 );
+    V vlat = Atan2( s, c );
+
+    const V g = 1.0 - el.es * ss;
+    const V rg = el.a / Sqrt( g );
+    const V rf = olson.a6 * rg;
+    u = w - rg * c;
+    v = zp - rf * s;
+    const V f = c * u + s * v;
+    const V m = c * v - s * u;
+    const V p = m / ( rf / g + f );
+    vlat = vlat + p;
+    const V vh = f + m * p / 2.0;
+    vlat = Select( Lt( z, V::Set1( 0.0 ) ), -vlat, vlat );
+
+    Store( lat, vlat * units.angleOut );
+    Store( lon, vlon * units.angleOut );
+    Store( h, vh * units.rangeOut );
+}
+
+///
+/// \brief Пересчет ECEF в географические координаты для массива точек
+/// \details Неполный последний блок дополняется во временных массивах точкой на экваторе (без деления на 0)
+///
+template <class V>
+void ECEFtoGEOKernel( const TKernelEllipsoid &el, const TKernelUnits &units,
+    const double *x, const double *y, const double *z, std::size_t count, double *lat, double *lon, double *h )
+{
+    const std::size_t W = static_cast<std::size_t>( V::Width );
+    std::size_t i = 0;
+    for( ; i + W <= count; i += W ) {
+        ECEFtoGEOBlock<V>( el, units, x + i, y + i, z + i, lat + i, lon + i, h + i );
+    }
+    if( i < count ) {
+        const std::size_t n = count - i;
+        double in[3][V::Width] = {};
+        double out[3][V::Width];
+        std::fill( in[0], in[0] + V::Width, el.a / units.rangeIn );
+        std::copy( x + i, x + count, in[0] );
+        std::copy( y + i, y + count, in[1] );
+        std::copy( z + i, z + count, in[2] );
+        ECEFtoGEOBlock<V>( el, units, in[0], in[1], in[2], out[0], out[1], out[2] );
+        std::copy( out[0], out[0] + n, lat + i );
+        std::copy( out[1], out[1] + n, lon + i );
+        std::copy( out[2], out[2] + n, h + i );
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Пересчет географических координат в ECEF для одного блока из V::Width точек
+/// \details Повторяет Geodesy::GEOtoECEF: sin и cos каждого угла вычисляются совместно (SinCos),
+///          радиус кривизны первого вертикала - через RSqrt без деления
+/// \tparam STREAM - потоковая запись результатов (выходные массивы выровнены на размер вектора)
+///
+template <class V, bool STREAM>
+inline void GEOtoECEFBlock( const TKernelEllipsoid &el, const TKernelUnits &units,
+    const double *lat, const double *lon, const double *h, double *x, double *y, double *z )
+{
+    const V vlat = V::Load( lat ) * units.angleIn; // [рад]
+    const V vlon = V::Load( lon ) * units.angleIn;
+    const V vh = V::Load( h ) * units.rangeIn;     // [м]
+
+    V sinLat, cosLat, sinLon, cosLon;
+    SinCos( vlat, sinLat, cosLat );
+    SinCos( vlon, sinLon, cosLon );
+
+    const V v = el.a * RSqrt( 1.0 - el.es * ( sinLat * sinLat ) );
+    const V vx = ( v + vh ) * cosLat * cosLon * units.rangeOut;
+    const V vy = ( v + vh ) * cosLat * sinLon * units.rangeOut;
+    const V vz = ( v * ( 1.0 - el.es ) + vh ) * sinLat * units.rangeOut;
+    if( STREAM ) {
+        StoreStream( x, vx );
+        StoreStream( y, vy );
+        StoreStream( z, vz );
+    } else {
+        Store( x, vx );
+        Store( y, vy );
+        Store( z, vz );
+    }
+}
+
+///
+/// \brief Пересчет географических координат в ECEF для массива точек
+/// \details Если выходные массивы выровнены на размер вектора и велики (не помещаются в кэш), результаты
+///          пишутся потоковой записью в обход кэша. Неполный последний блок - через временные массивы
+///
+template <class V>
+void GEOtoECEFKernel( const TKernelEllipsoid &el, const TKernelUnits &units,
+    const double *lat, const double *lon, const double *h, std::size_t count, double *x, double *y, double *z )
+{
+    const std::size_t W = static_cast<std::size_t>( V::Width );
+    const std::size_t streamCount = 32768; // 768 КБ результатов - больше кэша L2
+    const auto aligned = [W]( const double *p ) {
+        return ( reinterpret_cast<std::uintptr_t>( p ) % ( W * sizeof( double ) ) ) == 0;
+    };
+    std::size_t i = 0;
+    if( ( W > 1 ) && ( count >= streamCount ) && aligned( x ) && aligned( y ) && aligned( z ) ) {
+        for( ; i + W <= count; i += W ) {
+            GEOtoECEFBlock<V, true>( el, units, lat + i, lon + i, h + i, x + i, y + i, z + i );
+        }
+        StreamFence();
+    } else {
+        for( ; i + W <= count; i += W ) {
+            GEOtoECEFBlock<V, false>( el, units, lat + i, lon + i, h + i, x + i, y + i, z + i );
+        }
+    }
+    if( i < count ) {
+        const std::size_t n = count - i;
+        double in[3][V::Width] = {};
+        double out[3][V::Width];
+        std::copy( lat + i, lat + count, in[0] );
+        std::copy( lon + i, lon + count, in[1] );
+        std::copy( h + i, h + count, in[2] );
+        GEOtoECEFBlock<V, false>( el, units, in[0], in[1], in[2], out[0], out[1], out[2] );
+        std::copy( out[0], out[0] + n, x + i );
+        std::copy( out[1], out[1] + n, y + i );
+        std::copy( out[2], out[2] + n, z + i );
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Элементарная функция для одного блока из V::Width значений
+///
+template <class V>
+inline void MathBlock( SIMD::TMathFunction func, const double *a, const double *b, double *out1, double *out2 )
+{
+    const V x = V::Load( a );
+    switch( func ) {
+        case( SIMD::MF_Sin ): Store( out1, Sin( x ) ); break;
+        case( SIMD::MF_Cos ): Store( out1, Cos( x ) ); break;
+        case( SIMD::MF_SinCos ):
+        {
+            V s, c;
+            SinCos( x, s, c );
+            Store( out1, s );
+            Store( out2, c );
+            break;
+        }
+        case( SIMD::MF_Tan ): Store( out1, Tan( x ) ); break;
+        case( SIMD::MF_Atan ): Store( out1, Atan( x ) ); break;
+        case( SIMD::MF_Atan2 ): Store( out1, Atan2( x, V::Load( b ) ) ); break;
+        case( SIMD::MF_Asin ): Store( out1, Asin( x ) ); break;
+        case( SIMD::MF_Acos ): Store( out1, Acos( x ) ); break;
+        default:
+            assert( false );
+    }
+}
+
+///
+/// \brief Элементарная функция для массива значений
+/// \details Второй аргумент b используется только для MF_Atan2, второй результат out2 - только для MF_SinCos.
+///          Неполный последний блок дополняется значением 0.5 (допустимо для всех функций)
+///
+template <class V>
+void MathKernel( SIMD::TMathFunction func, const double *a, const double *b, std::size_t count,
+    double *out1, double *out2 )
+{
+    const std::size_t W = static_cast<std::size_t>( V::Width );
+    const bool binary = ( func == SIMD::MF_Atan2 );
+    const bool pair = ( func == SIMD::MF_SinCos );
+    std::size_t i = 0;
+    for( ; i + W <= count; i += W ) {
+        MathBlock<V>( func, a + i, binary ? ( b + i ) : nullptr, out1 + i, pair ? ( out2 + i ) : nullptr );
+    }
+    if( i < count ) {
+        const std::size_t n = count - i;
+        double in[2][V::Width];
+        double out[2][V::Width];
+        std::fill( in[0], in[0] + V::Width, 0.5 );
+        std::fill( in[1], in[1] + V::Width, 0.5 );
+        std::copy( a + i, a + count, in[0] );
+        if( binary ) {
+            std::copy( b + i, b + count, in[1] );
+        }
+        MathBlock<V>( func, in[0], in[1], out[0], out[1] );
+        std::copy( out[0], out[0] + n, out1 + i );
+        if( pair ) {
+            std::copy( out[1], out[1] + n, out2 + i );
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Применение ядра блока (три входа, три выхода) к массиву значений
+/// \details Неполный последний блок дополняется нулями во временных массивах (допустимо для всех ядер местной
+///          системы координат: atan2( 0, 0 ) = 0)
+///
+template <class V, class B>
+inline void LocalLoop( const typename V::Scalar *in1, const typename V::Scalar *in2, const typename V::Scalar *in3,
+    std::size_t count, typename V::Scalar *out1, typename V::Scalar *out2, typename V::Scalar *out3, B block )
+{
+    typedef typename V::Scalar T;
+    const std::size_t W = static_cast<std::size_t>( V::Width );
+    std::size_t i = 0;
+    for( ; i + W <= count; i += W ) {
+        block( in1 + i, in2 + i, in3 + i, out1 + i, out2 + i, out3 + i );
+    }
+    if( i < count ) {
+        const std::size_t n = count - i;
+        T in[3][V::Width] = {};
+        T out[3][V::Width];
+        std::copy( in1 + i, in1 + count, in[0] );
+        std::copy( in2 + i, in2 + count, in[1] );
+        std::copy( in3 + i, in3 + count, in[2] );
+        block( in[0], in[1], in[2], out[0], out[1], out[2] );
+        std::copy( out[0], out[0] + n, out1 + i );
+        std::copy( out[1], out[1] + n, out2 + i );
+        std::copy( out[2], out[2] + n, out3 + i );
+    }
+}
+
+///
+/// \brief Перевод ENU в AER для массива точек
+/// \details Повторяет Geodesy::ENUtoAER: hypot заменен на Sqrt суммы квадратов (переполнение невозможно для
+///          дальностей до 1e150 в double и 1e18 в float). Дальность не переводится в метры: наклонная дальность
+///          пропорциональна входу, углы от масштаба не зависят
+///
+template <class V>
+void ENUtoAERKernel( const TKernelUnits &units, const typename V::Scalar *xEast, const typename V::Scalar *yNorth,
+    const typename V::Scalar *zUp, std::size_t count, typename V::Scalar *az, typename V::Scalar *elev,
+    typename V::Scalar *slantRange )
+{
+    typedef typename V::Scalar T;
+    LocalLoop<V>( xEast, yNorth, zUp, count, az, elev, slantRange, [&units]( const T *pe, const T *pn, const T *pu,
+        T *pa, T *pel, T *pr ) {
+        const V e = V::Load( pe );
+        const V n = V::Load( pn );
+        const V u = V::Load( pu );
+        const V r = Sqrt( e * e + n * n );
+        Store( pr, Sqrt( r * r + u * u ) );
+        Store( pel, Atan2( u, r ) * units.angleOut );
+        Store( pa, AngleTo360Rad( Atan2( e, n ) ) * units.angleOut );
+    } );
+}
+
+///
+/// \brief Перевод AER в ENU для массива точек
+/// \details Повторяет Geodesy::AERtoENU, sin и cos каждого угла вычисляются совместно (SinCos). Дальность, как в
+///          ENUtoAERKernel, не переводится в метры
+///
+template <class V>
+void AERtoENUKernel( const TKernelUnits &units, const typename V::Scalar *az, const typename V::Scalar *elev,
+    const typename V::Scalar *slantRange, std::size_t count, typename V::Scalar *xEast, typename V::Scalar *yNorth,
+    typename V::Scalar *zUp )
+{
+    typedef typename V::Scalar T;
+    LocalLoop<V>( az, elev, slantRange, count, xEast, yNorth, zUp, [&units]( const T *pa, const T *pel, const T *pr,
+        T *pe, T *pn, T *pu ) {
+        V sinAz, cosAz, sinEl, cosEl;
+        SinCos( V::Load( pa ) * units.angleIn, sinAz, cosAz );
+        SinCos( V::Load( pel ) * units.angleIn, sinEl, cosEl );
+        const V sr = V::Load( pr );
+        const V r = sr * cosEl;
+        Store( pu, sr * sinEl );
+        Store( pe, r * sinAz );
+        Store( pn, r * cosAz );
+    } );
+}
+
+///
+/// \brief Перевод смещений по осям ECEF в ENU опорной точки для массива точек
+/// \details Повторяет Geodesy::ECEFtoENUV. Поворот линеен: единицы дальности входа и выхода совпадают, перевод
+///          в метры не нужен
+///
+template <class V>
+void ECEFtoENUVKernel( const TKernelFrame &frame, const typename V::Scalar *dX,
+    const typename V::Scalar *dY, const typename V::Scalar *dZ, std::size_t count, typename V::Scalar *xEast,
+    typename V::Scalar *yNorth, typename V::Scalar *zUp )
+{
+    typedef typename V::Scalar T;
+    const V sinLat = V::Set1( static_cast<T>( frame.sinLat ) );
+    const V cosLat = V::Set1( static_cast<T>( frame.cosLat ) );
+    const V sinLon = V::Set1( static_cast<T>( frame.sinLon ) );
+    const V cosLon = V::Set1( static_cast<T>( frame.cosLon ) );
+    LocalLoop<V>( dX, dY, dZ, count, xEast, yNorth, zUp, [&]( const T *px, const T *py, const T *pz,
+        T *pe, T *pn, T *pu ) {
+        const V x = V::Load( px );
+        const V y = V::Load( py );
+        const V z = V::Load( pz );
+        const V t = cosLon * x + sinLon * y;
+        Store( pe, cosLon * y - sinLon * x );
+        Store( pu, cosLat * t + sinLat * z );
+        Store( pn, cosLat * z - sinLat * t );
+    } );
+}
+
+///
+/// \brief Перевод ENU опорной точки в смещения по осям ECEF (UVW) для массива точек
+/// \details Повторяет Geodesy::ENUtoUVW, единицы дальности входа и выхода совпадают (как в ECEFtoENUVKernel)
+///
+template <class V>
+void ENUtoUVWKernel( const TKernelFrame &frame, const typename V::Scalar *xEast,
+    const typename V::Scalar *yNorth, const typename V::Scalar *zUp, std::size_t count, typename V::Scalar *u,
+    typename V::Scalar *v, typename V::Scalar *w )
+{
+    typedef typename V::Scalar T;
+    const V sinLat = V::Set1( static_cast<T>( frame.sinLat ) );
+    const V cosLat = V::Set1( static_cast<T>( frame.cosLat ) );
+    const V sinLon = V::Set1( static_cast<T>( frame.sinLon ) );
+    const V cosLon = V::Set1( static_cast<T>( frame.cosLon ) );
+    LocalLoop<V>( xEast, yNorth, zUp, count, u, v, w, [&]( const T *pe, const T *pn, const T *pu,
+        T *pU, T *pV, T *pW ) {
+        const V e = V::Load( pe );
+        const V n = V::Load( pn );
+        const V up = V::Load( pu );
+        const V t = cosLat * up - sinLat * n;
+        Store( pW, sinLat * up + cosLat * n );
+        Store( pU, cosLon * t - sinLon * e );
+        Store( pV, sinLon * t + cosLon * e );
+    } );
+}
+
+///
+/// \brief Заполнение ядер местной системы координат для векторного типа V
+///
+template <class V>
+TLocalKernels<typename V::Scalar> MakeLocalKernels()
+{
+    TLocalKernels<typename V::Scalar> local;
+    local.width = V::Width;
+    local.ENUtoAER = &ENUtoAERKernel<V>;
+    local.AERtoENU = &AERtoENUKernel<V>;
+    local.ECEFtoENUV = &ECEFtoENUVKernel<V>;
+    local.ENUtoUVW = &ENUtoUVWKernel<V>;
+    return local;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Заполнение таблицы ядер для векторного типа V
+/// \tparam V  - векторный тип значений double
+/// \tparam VF - векторный тип значений float того же набора инструкций
+///
+template <class V, class VF>
+TKernelTable MakeKernelTable( SIMD::TSimdLevel level )
+{
+    TKernelTable table;
+    table.level = level;
+    table.width = V::Width;
+    table.GEOtoRAD = &GEOtoRADKernel<V>;
+    table.GEOtoRADRow = &GEOtoRADRowKernel<V>;
+    table.RADtoGEOFan = &RADtoGEOFanKernel<V>;
+    table.ECEFtoGEO = &ECEFtoGEOKernel<V>;
+    table.GEOtoECEF = &GEOtoECEFKernel<V>;
+    table.Math = &MathKernel<V>;
+    table.Local = MakeLocalKernels<V>();
+    table.LocalFloat = MakeLocalKernels<VF>();
+    return table;
+}
+
+} // end anonymous namespace
+} // end namespace Batch
+} // end namespace SPML
+#endif // SPML_BATCH_KERNELS_IMPL_H
+/// \}
@@ -0,0 +1,26 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       batch_kernels_scalar.cpp
+/// \brief      Ядра пакетных функций: без векторизации
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#include <batch_kernels_impl.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Batch /// Ядра пакетных функций (внутреннее)
+{
+//----------------------------------------------------------------------------------------------------------------------
+const TKernelTable *KernelsScalar()
+{
+    static const TKernelTable table = MakeKernelTable<SIMD::VecD1, SIMD::VecF1>( SIMD::SL_Scalar );
+    return &table;
+}
+
+} // end namespace Batch
+} // end namespace SPML
+/// \}
@@ -0,0 +1,33 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       batch_kernels_sse2.cpp
+/// \brief      Ядра пакетных функций: SSE2 (2 значения double или 4 float за раз)
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#include <batch_kernels_impl.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Batch /// Ядра пакетных функций (внутреннее)
+{
+//----------------------------------------------------------------------------------------------------------------------
+#if defined( __SSE2__ )
+const TKernelTable *KernelsSSE2()
+{
+    static const TKernelTable table = MakeKernelTable<SIMD::VecSSE2, SIMD::VecF4>( SIMD::SL_SSE2 );
+    return &table;
+}
+#else
+const TKernelTable *KernelsSSE2()
+{
+    return nullptr;
+}
+#endif
+
+} // end namespace Batch
+} // end namespace SPML
+/// \}
@@ -124,8 +124,8 @@ double AngleTo360( double angle, const Units::TAngleUnit &au )
 
             // new 2
             double n = std::floor( _angle / Consts::PI_2_D );
-            if( ( _angle >= Consts::PI_2_F ) || ( _angle < 0.0 ) ) {
-                _angle -= ( Consts::PI_2_F * n );
+            if( ( _angle >= Consts::PI_2_D ) || ( _angle < 0.0 ) ) {
+                _angle -= ( Consts::PI_2_D * n );
             }
             break;
         }
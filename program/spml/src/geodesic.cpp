@@ -0,0 +1,838 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       geodesic.cpp
+/// \brief      Геодезические задачи на эллипсоиде по методу Карни
+/// \details    Karney, C. F. F. (2013). "Algorithms for geodesics". Journal of Geodesy. 87 (1): 43–55.
+///             Обозначения следуют статье: bet - приведенная широта, alp - азимут, sig - дуга на вспомогательной
+///             сфере, omg - долгота на вспомогательной сфере, lam - долгота на эллипсоиде; префиксы s и c - синус
+///             и косинус. Углы в градусах приводятся к малому диапазону точно (remquo), до перевода в радианы
+///             \n Порт GeographicLib 2.3 (https://geographiclib.sourceforge.io, файлы Geodesic.hpp, Geodesic.cpp,
+///             Math.hpp, Math.cpp) на типы и единицы измерения SPML.
+///             \n Исходный код GeographicLib:
+///             \n Copyright (c) Charles Karney (2009-2023) <karney@alum.mit.edu> and licensed under the MIT/X11
+///             License. For more information, see https://geographiclib.sourceforge.io/
+///             \n Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+///             associated documentation files (the "Software"), to deal in the Software without restriction,
+///             including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+///             and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+///             subject to the following conditions:
+///             \n The above copyright notice and this permission notice shall be included in all copies or
+///             substantial portions of the Software.
+///             \n THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+///             NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+///             NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+///             OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+///             CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#include <geodesic.h>
+
+// System includes:
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+namespace
+{
+//----------------------------------------------------------------------------------------------------------------------
+const int nA1 = 6;  // Порядок ряда A1
+const int nC1 = 6;  // Порядок рядов C1
+const int nC1p = 6; // Порядок рядов C1'
+const int nA2 = 6;  // Порядок ряда A2
+const int nC2 = 6;  // Порядок рядов C2
+const int nC = 7;   // Размер массивов коэффициентов ( порядок + 1, элемент 0 не используется )
+
+const double degree = Consts::PI_D / 180.0;
+const double tiny = std::sqrt( DBL_MIN );
+const double tol0 = DBL_EPSILON;
+const double tol1 = 200.0 * tol0;
+const double tol2 = std::sqrt( tol0 );
+const double tolb = tol0;
+const double xthresh = 1000.0 * tol2;
+
+inline double Sq( double x )
+{
+    return x * x;
+}
+
+// Схема Горнера, p[0] - коэффициент при старшей степени N
+inline double PolyVal( int N, const double *p, double x )
+{
+    double y = ( N < 0 ) ? 0.0 : *p++;
+    while( --N >= 0 ) {
+        y = y * x + *p++;
+    }
+    return y;
+}
+
+// Нормировка пары ( синус, косинус )
+inline void Norm2( double &s, double &c )
+{
+    const double r = std::hypot( s, c );
+    s /= r;
+    c /= r;
+}
+
+// Сумма с точным остатком: u + v = s + t
+inline double SumX( double u, double v, double &t )
+{
+    const double s = u + v;
+    double up = s - v;
+    double vpp = s - up;
+    up -= u;
+    vpp -= v;
+    t = ( s != 0.0 ) ? 0.0 - ( up + vpp ) : s;
+    return s;
+}
+
+// Приведение угла к ( -180, 180 ] град
+inline double AngNormalize( double x )
+{
+    const double y = std::remainder( x, 360.0 );
+    return ( std::fabs( y ) == 180.0 ) ? std::copysign( 180.0, x ) : y;
+}
+
+// Разность углов y - x, приведенная к [-180, 180] град, с точным остатком e
+inline double AngDiff( double x, double y, double &e )
+{
+    double t;
+    double d = SumX( std::remainder( -x, 360.0 ), std::remainder( y, 360.0 ), t );
+    d = SumX( std::remainder( d, 360.0 ), t, t );
+    if( d == 0.0 || std::fabs( d ) == 180.0 ) {
+        d = std::copysign( d, ( t == 0.0 ) ? ( y - x ) : -t );
+    }
+    e = t;
+    return d;
+}
+
+// Округление малых углов до 1/16 ULP от 1/16 (исключает потерю точности при вычитании близких углов)
+inline double AngRound( double x )
+{
+    const double z = 1.0 / 16.0;
+    double y = std::fabs( x );
+    const double w = z - y;
+    y = ( w > 0.0 ) ? z - w : y;
+    return std::copysign( y, x );
+}
+
+// Синус и косинус угла в градусах с точным приведением к [-45, 45] град
+inline void SinCosD( double x, double &sinx, double &cosx )
+{
+    int q = 0;
+    double r = std::remquo( x, 90.0, &q );
+    r *= degree;
+    const double s = std::sin( r );
+    const double c = std::cos( r );
+    switch( static_cast<unsigned int>( q ) & 3u ) {
+        case( 0u ): sinx = s; cosx = c; break;
+        case( 1u ): sinx = c; cosx = -s; break;
+        case( 2u ): sinx = -s; cosx = -c; break;
+        default: sinx = -c; cosx = s; break;
+    }
+    cosx += 0.0; // -0 -> +0
+    if( sinx == 0.0 ) {
+        sinx = std::copysign( sinx, x );
+    }
+}
+
+// Арктангенс y / x в градусах с учетом квадранта, точный для углов, кратных 45 град
+inline double Atan2D( double y, double x )
+{
+    int q = 0;
+    if( std::fabs( y ) > std::fabs( x ) ) {
+        std::swap( x, y );
+        q = 2;
+    }
+    if( std::signbit( x ) ) {
+        x = -x;
+        ++q;
+    }
+    double ang = std::atan2( y, x ) / degree;
+    switch( q ) {
+        case( 1 ): ang = std::copysign( 180.0, y ) - ang; break;
+        case( 2 ): ang = 90.0 - ang; break;
+        case( 3 ): ang = -90.0 + ang; break;
+        default: break;
+    }
+    return ang;
+}
+
+// Сумма ряда sum( c[l] * sin( 2 * l * x ), l = 1..n ) по схеме Кленшоу
+inline double SinCosSeries( double sinx, double cosx, const double c[], int n )
+{
+    c += ( n + 1 );
+    const double ar = 2.0 * ( cosx - sinx ) * ( cosx + sinx ); // 2 * cos( 2 * x )
+    double y0 = ( n & 1 ) ? *--c : 0.0;
+    double y1 = 0.0;
+    n /= 2;
+    while( n-- ) {
+        y1 = ar * y0 - y1 + *--c;
+        y0 = ar * y1 - y0 + *--c;
+    }
+    return 2.0 * sinx * cosx * y0; // sin( 2 * x ) * y0
+}
+
+// Решение уравнения астроиды (начальное приближение для почти антиподальных точек)
+double Astroid( double x, double y )
+{
+    const double p = Sq( x );
+    const double q = Sq( y );
+    double r = ( p + q - 1.0 ) / 6.0;
+    if( q == 0.0 && r <= 0.0 ) {
+        return 0.0;
+    }
+    const double S = p * q / 4.0;
+    const double r2 = Sq( r );
+    const double r3 = r * r2;
+    const double disc = S * ( S + 2.0 * r3 );
+    double u = r;
+    if( disc >= 0.0 ) {
+        double T3 = S + r3;
+        T3 += ( T3 < 0.0 ) ? -std::sqrt( disc ) : std::sqrt( disc );
+        const double T = std::cbrt( T3 );
+        u += T + ( ( T != 0.0 ) ? r2 / T : 0.0 );
+    } else {
+        const double ang = std::atan2( std::sqrt( -disc ), -( S + r3 ) );
+        u += 2.0 * r * std::cos( ang / 3.0 );
+    }
+    const double v = std::sqrt( Sq( u ) + q );
+    const double uv = ( u < 0.0 ) ? q / ( v - u ) : u + v;
+    const double w = ( uv - q ) / ( 2.0 * v );
+    return uv / ( std::sqrt( uv + Sq( w ) ) + w );
+}
+
+// A1 - 1
+double A1m1f( double eps )
+{
+    static const double coeff[] = { 1, 4, 64, 0, 256 };
+    const int m = nA1 / 2;
+    const double t = PolyVal( m, coeff, Sq( eps ) ) / coeff[m + 1];
+    return ( t + eps ) / ( 1.0 - eps );
+}
+
+// Коэффициенты C1[l], l = 1..nC1
+void C1f( double eps, double c[] )
+{
+    static const double coeff[] = {
+        -1, 6, -16, 32,
+        -9, 64, -128, 2048,
+        9, -16, 768,
+        3, -5, 512,
+        -7, 1280,
+        -7, 2048
+    };
+    const double eps2 = Sq( eps );
+    double d = eps;
+    int o = 0;
+    for( int l = 1; l <= nC1; ++l ) {
+        const int m = ( nC1 - l ) / 2;
+        c[l] = d * PolyVal( m, coeff + o, eps2 ) / coeff[o + m + 1];
+        o += m + 2;
+        d *= eps;
+    }
+}
+
+// Коэффициенты C1'[l], l = 1..nC1p (обращение ряда C1)
+void C1pf( double eps, double c[] )
+{
+    static const double coeff[] = {
+        205, -432, 768, 1536,
+        4005, -4736, 3840, 12288,
+        -225, 116, 384,
+        -7173, 2695, 7680,
+        3467, 7680,
+        38081, 61440
+    };
+    const double eps2 = Sq( eps );
+    double d = eps;
+    int o = 0;
+    for( int l = 1; l <= nC1p; ++l ) {
+        const int m = ( nC1p - l ) / 2;
+        c[l] = d * PolyVal( m, coeff + o, eps2 ) / coeff[o + m + 1];
+        o += m + 2;
+        d *= eps;
+    }
+}
+
+// A2 - 1
+double A2m1f( double eps )
+{
+    static const double coeff[] = { -11, -28, -192, 0, 256 };
+    const int m = nA2 / 2;
+    const double t = PolyVal( m, coeff, Sq( eps ) ) / coeff[m + 1];
+    return ( t - eps ) / ( 1.0 + eps );
+}
+
+// Коэффициенты C2[l], l = 1..nC2
+void C2f( double eps, double c[] )
+{
+    static const double coeff[] = {
+        1, 2, 16, 32,
+        35, 64, 384, 2048,
+        15, 80, 768,
+        7, 35, 512,
+        63, 1280,
+        77, 2048
+    };
+    const double eps2 = Sq( eps );
+    double d = eps;
+    int o = 0;
+    for( int l = 1; l <= nC2; ++l ) {
+        const int m = ( nC2 - l ) / 2;
+        c[l] = d * PolyVal( m, coeff + o, eps2 ) / coeff[o + m + 1];
+        o += m + 2;
+        d *= eps;
+    }
+}
+
+// eps = ( sqrt( 1 + k2 ) - 1 ) / ( sqrt( 1 + k2 ) + 1 ) без потери точности
+inline double EpsFromK2( double k2 )
+{
+    return k2 / ( 2.0 * ( 1.0 + std::sqrt( 1.0 + k2 ) ) + k2 );
+}
+
+} // end anonymous namespace
+
+//----------------------------------------------------------------------------------------------------------------------
+const int CGeodesic::MaxNewtonIterations;
+const int CGeodesic::MaxIterations;
+
+CGeodesic::CGeodesic( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit ) :
+    ellipsoid( ellipsoid ), rangeUnit( rangeUnit ), angleUnit( angleUnit )
+{
+    a = ellipsoid.A();
+    f = ellipsoid.F();
+    f1 = 1.0 - f;
+    b = a * f1;
+    const double e2 = f * ( 2.0 - f );
+    ep2 = e2 / Sq( f1 );
+    n = f / ( 2.0 - f );
+    etol2 = 0.1 * tol2 / std::sqrt( std::max( 0.001, std::fabs( f ) ) * std::min( 1.0, 1.0 - f / 2.0 ) / 2.0 );
+
+    // A3: коэффициенты при eps^5..eps^0, полиномы по n
+    static const double coeffA3[] = {
+        -3, 128,
+        -2, -3, 64,
+        -1, -3, -1, 16,
+        3, -1, -2, 8,
+        1, -1, 2,
+        1, 1
+    };
+    int o = 0;
+    int k = 0;
+    for( int j = nA3 - 1; j >= 0; --j ) {
+        const int m = std::min( nA3 - j - 1, j );
+        A3x[k++] = PolyVal( m, coeffA3 + o, n ) / coeffA3[o + m + 1];
+        o += m + 2;
+    }
+
+    // C3[l]: коэффициенты при eps^5..eps^l, полиномы по n
+    static const double coeffC3[] = {
+        3, 128,
+        2, 5, 128,
+        -1, 3, 3, 64,
+        -1, 0, 1, 8,
+        -1, 1, 4,
+        5, 256,
+        1, 3, 128,
+        -3, -2, 3, 64,
+        1, -3, 2, 32,
+        7, 512,
+        -10, 9, 384,
+        5, -9, 5, 192,
+        7, 512,
+        -14, 7, 512,
+        21, 2560
+    };
+    o = 0;
+    k = 0;
+    for( int l = 1; l < nC3; ++l ) {
+        for( int j = nC3 - 1; j >= l; --j ) {
+            const int m = std::min( nC3 - j - 1, j );
+            C3x[k++] = PolyVal( m, coeffC3 + o, n ) / coeffC3[o + m + 1];
+            o += m + 2;
+        }
+    }
+}
+
+double CGeodesic::A3f( double eps ) const
+{
+    return PolyVal( nA3 - 1, A3x, eps );
+}
+
+void CGeodesic::C3f( double eps, double c[] ) const
+{
+    double mult = 1.0;
+    int o = 0;
+    for( int l = 1; l < nC3; ++l ) {
+        const int m = nC3 - l - 1;
+        mult *= eps;
+        c[l] = mult * PolyVal( m, C3x + o, eps );
+        o += m + 1;
+    }
+}
+
+void CGeodesic::Lengths( double eps, double sig12, double ssig1, double csig1, double dn1, double ssig2, double csig2,
+    double dn2, double *s12b, double *m12b, double *m0 ) const
+{
+    double Ca[nC], Cb[nC];
+    double A1 = A1m1f( eps );
+    C1f( eps, Ca );
+    double m0x = 0.0;
+    double A2 = 0.0;
+    const bool redlp = ( m12b != nullptr ) || ( m0 != nullptr );
+    if( redlp ) {
+        A2 = A2m1f( eps );
+        C2f( eps, Cb );
+        m0x = A1 - A2;
+        A2 = 1.0 + A2;
+    }
+    A1 = 1.0 + A1;
+
+    double J12 = 0.0;
+    if( s12b != nullptr ) {
+        const double B1 = SinCosSeries( ssig2, csig2, Ca, nC1 ) - SinCosSeries( ssig1, csig1, Ca, nC1 );
+        *s12b = A1 * ( sig12 + B1 );
+        if( redlp ) {
+            const double B2 = SinCosSeries( ssig2, csig2, Cb, nC2 ) - SinCosSeries( ssig1, csig1, Cb, nC2 );
+            J12 = m0x * sig12 + ( A1 * B1 - A2 * B2 );
+        }
+    } else if( redlp ) {
+        for( int l = 1; l <= nC2; ++l ) {
+            Cb[l] = A1 * Ca[l] - A2 * Cb[l];
+        }
+        J12 = m0x * sig12 + ( SinCosSeries( ssig2, csig2, Cb, nC2 ) - SinCosSeries( ssig1, csig1, Cb, nC2 ) );
+    }
+    if( m0 != nullptr ) {
+        *m0 = m0x;
+    }
+    if( m12b != nullptr ) {
+        *m12b = dn2 * ( csig1 * ssig2 ) - dn1 * ( ssig1 * csig2 ) - csig1 * csig2 * J12;
+    }
+}
+
+double CGeodesic::InverseStart( double sbet1, double cbet1, double dn1, double sbet2, double cbet2, double dn2,
+    double lam12, double slam12, double clam12, double &salp1, double &calp1, double &salp2, double &calp2,
+    double &dnm ) const
+{
+    double sig12 = -1.0; // Признак "решение не найдено"
+    const double sbet12 = sbet2 * cbet1 - cbet2 * sbet1;
+    const double cbet12 = cbet2 * cbet1 + sbet2 * sbet1;
+    const double sbet12a = sbet2 * cbet1 + cbet2 * sbet1;
+    const bool shortline = ( cbet12 >= 0.0 ) && ( sbet12 < 0.5 ) && ( cbet2 * lam12 < 0.5 );
+    double somg12, comg12;
+    if( shortline ) {
+        double sbetm2 = Sq( sbet1 + sbet2 );
+        sbetm2 /= sbetm2 + Sq( cbet1 + cbet2 );
+        dnm = std::sqrt( 1.0 + ep2 * sbetm2 );
+        const double omg12 = lam12 / ( f1 * dnm );
+        somg12 = std::sin( omg12 );
+        comg12 = std::cos( omg12 );
+    } else {
+        somg12 = slam12;
+        comg12 = clam12;
+    }
+
+    salp1 = cbet2 * somg12;
+    calp1 = ( comg12 >= 0.0 ) ?
+        sbet12 + cbet2 * sbet1 * Sq( somg12 ) / ( 1.0 + comg12 ) :
+        sbet12a - cbet2 * sbet1 * Sq( somg12 ) / ( 1.0 - comg12 );
+
+    const double ssig12 = std::hypot( salp1, calp1 );
+    const double csig12 = sbet1 * sbet2 + cbet1 * cbet2 * comg12;
+
+    if( shortline && ssig12 < etol2 ) { // Близкие точки - решение на сфере радиуса b * dnm
+        salp2 = cbet1 * somg12;
+        calp2 = sbet12 - cbet1 * sbet2 * ( ( comg12 >= 0.0 ) ? Sq( somg12 ) / ( 1.0 + comg12 ) : 1.0 - comg12 );
+        Norm2( salp2, calp2 );
+        sig12 = std::atan2( ssig12, csig12 );
+    } else if( std::fabs( n ) > 0.1 || csig12 >= 0.0 || ssig12 >= 6.0 * std::fabs( n ) * Consts::PI_D * Sq( cbet1 ) ) {
+        // Достаточно сферического приближения
+    } else {
+        // Почти антиподальные точки: масштабирование к координатам x, y, в которых антипод - начало координат
+        double x, y, lamscale, betscale;
+        const double lam12x = std::atan2( -slam12, -clam12 );
+        if( f >= 0.0 ) { // Сплюснутый эллипсоид
+            const double k2 = Sq( sbet1 ) * ep2;
+            const double eps = EpsFromK2( k2 );
+            lamscale = f * cbet1 * A3f( eps ) * Consts::PI_D;
+            betscale = lamscale * cbet1;
+            x = lam12x / lamscale;
+            y = sbet12a / betscale;
+        } else { // Вытянутый эллипсоид
+            const double cbet12a = cbet2 * cbet1 - sbet2 * sbet1;
+            const double bet12a = std::atan2( sbet12a, cbet12a );
+            double m12b, m0;
+            Lengths( n, Consts::PI_D + bet12a, sbet1, -cbet1, dn1, sbet2, cbet2, dn2, nullptr, &m12b, &m0 );
+            x = -1.0 + m12b / ( cbet1 * cbet2 * m0 * Consts::PI_D );
+            betscale = ( x < -0.01 ) ? sbet12a / x : -f * Sq( cbet1 ) * Consts::PI_D;
+            lamscale = betscale / cbet1;
+            y = lam12x / lamscale;
+        }
+
+        if( y > -tol1 && x > -1.0 - xthresh ) {
+            if( f >= 0.0 ) {
+                salp1 = std::min( 1.0, -x );
+                calp1 = -std::sqrt( 1.0 - Sq( salp1 ) );
+            } else {
+                calp1 = std::max( ( x > -tol1 ) ? 0.0 : -1.0, x );
+                salp1 = std::sqrt( 1.0 - Sq( calp1 ) );
+            }
+        } else {
+            const double k = Astroid( x, y );
+            const double omg12a = lamscale * ( ( f >= 0.0 ) ? -x * k / ( 1.0 + k ) : -y * ( 1.0 + k ) / k );
+            somg12 = std::sin( omg12a );
+            comg12 = -std::cos( omg12a );
+            salp1 = cbet2 * somg12;
+            calp1 = sbet12a - cbet2 * sbet1 * Sq( somg12 ) / ( 1.0 - comg12 );
+        }
+    }
+    if( !( salp1 <= 0.0 ) ) {
+        Norm2( salp1, calp1 );
+    } else {
+        salp1 = 1.0;
+        calp1 = 0.0;
+    }
+    return sig12;
+}
+
+double CGeodesic::Lambda12( double sbet1, double cbet1, double dn1, double sbet2, double cbet2, double dn2,
+    double salp1, double calp1, double slam120, double clam120, double &salp2, double &calp2, double &sig12,
+    double &ssig1, double &csig1, double &ssig2, double &csig2, double &eps, bool diffp, double &dlam12 ) const
+{
+    if( sbet1 == 0.0 && calp1 == 0.0 ) {
+        calp1 = -tiny; // Отрыв от экватора в направлении на юг
+    }
+    const double salp0 = salp1 * cbet1; // Азимут на экваторе
+    const double calp0 = std::hypot( calp1, salp1 * sbet1 );
+
+    ssig1 = sbet1;
+    const double somg1 = salp0 * sbet1;
+    csig1 = calp1 * cbet1;
+    const double comg1 = csig1;
+    Norm2( ssig1, csig1 );
+
+    salp2 = ( cbet2 != cbet1 ) ? salp0 / cbet2 : salp1;
+    calp2 = ( cbet2 != cbet1 || std::fabs( sbet2 ) != -sbet1 ) ?
+        std::sqrt( Sq( calp1 * cbet1 ) + ( ( cbet1 < -sbet1 ) ?
+            ( cbet2 - cbet1 ) * ( cbet1 + cbet2 ) : ( sbet1 - sbet2 ) * ( sbet1 + sbet2 ) ) ) / cbet2 :
+        std::fabs( calp1 );
+
+    ssig2 = sbet2;
+    const double somg2 = salp0 * sbet2;
+    csig2 = calp2 * cbet2;
+    const double comg2 = csig2;
+    Norm2( ssig2, csig2 );
+
+    sig12 = std::atan2( std::max( 0.0, csig1 * ssig2 - ssig1 * csig2 ), csig1 * csig2 + ssig1 * ssig2 );
+    const double somg12 = std::max( 0.0, comg1 * somg2 - somg1 * comg2 );
+    const double comg12 = comg1 * comg2 + somg1 * somg2;
+    // eta = omg12 - lam120
+    const double eta = std::atan2( somg12 * clam120 - comg12 * slam120, comg12 * clam120 + somg12 * slam120 );
+
+    const double k2 = Sq( calp0 ) * ep2;
+    eps = EpsFromK2( k2 );
+    double Ca[nC];
+    C3f( eps, Ca );
+    const double B312 = SinCosSeries( ssig2, csig2, Ca, nC3 - 1 ) - SinCosSeries( ssig1, csig1, Ca, nC3 - 1 );
+    const double domg12 = -f * A3f( eps ) * salp0 * ( sig12 + B312 );
+    const double lam12 = eta + domg12;
+
+    if( diffp ) {
+        if( calp2 == 0.0 ) {
+            dlam12 = -2.0 * f1 * dn1 / sbet1;
+        } else {
+            Lengths( eps, sig12, ssig1, csig1, dn1, ssig2, csig2, dn2, nullptr, &dlam12, nullptr );
+            dlam12 *= f1 / ( calp2 * cbet2 );
+        }
+    }
+    return lam12;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int CGeodesic::InverseDeg( double lat1, double lon1, double lat2, double lon2, double &s12, double &azi1,
+    double &azi2 ) const
+{
+    int numit = 0;
+
+    // Разность долгот со знаком lonsign, lon12 >= 0; lon12s = 180 - lon12 (точно)
+    double lon12s;
+    double lon12 = AngDiff( lon1, lon2, lon12s );
+    double lonsign = std::signbit( lon12 ) ? -1.0 : 1.0;
+    lon12 = lonsign * AngRound( lon12 );
+    lon12s = AngRound( ( 180.0 - lon12 ) - lonsign * lon12s );
+    const double lam12 = lon12 * degree;
+    double slam12, clam12;
+    if( lon12 > 90.0 ) {
+        SinCosD( lon12s, slam12, clam12 );
+        clam12 = -clam12;
+    } else {
+        SinCosD( lon12, slam12, clam12 );
+    }
+
+    // Перестановка точек, чтобы |lat1| >= |lat2|, и смена знака, чтобы lat1 <= 0
+    lat1 = AngRound( ( std::fabs( lat1 ) > 90.0 ) ? std::numeric_limits<double>::quiet_NaN() : lat1 );
+    lat2 = AngRound( ( std::fabs( lat2 ) > 90.0 ) ? std::numeric_limits<double>::quiet_NaN() : lat2 );
+    const double swapp = ( std::fabs( lat1 ) < std::fabs( lat2 ) || std::isnan( lat2 ) ) ? -1.0 : 1.0;
+    if( swapp < 0.0 ) {
+        lonsign *= -1.0;
+        std::swap( lat1, lat2 );
+    }
+    const double latsign = std::signbit( lat1 ) ? 1.0 : -1.0;
+    lat1 *= latsign;
+    lat2 *= latsign;
+
+    // Приведенные широты
+    double sbet1, cbet1, sbet2, cbet2;
+    SinCosD( lat1, sbet1, cbet1 );
+    sbet1 *= f1;
+    Norm2( sbet1, cbet1 );
+    cbet1 = std::max( tiny, cbet1 );
+    SinCosD( lat2, sbet2, cbet2 );
+    sbet2 *= f1;
+    Norm2( sbet2, cbet2 );
+    cbet2 = std::max( tiny, cbet2 );
+    // Точное равенство |bet1| = |bet2| при |lat1| = |lat2|
+    if( cbet1 < -sbet1 ) {
+        if( cbet2 == cbet1 ) {
+            sbet2 = std::copysign( sbet1, sbet2 );
+        }
+    } else {
+        if( std::fabs( sbet2 ) == -sbet1 ) {
+            cbet2 = cbet1;
+        }
+    }
+    const double dn1 = std::sqrt( 1.0 + ep2 * Sq( sbet1 ) );
+    const double dn2 = std::sqrt( 1.0 + ep2 * Sq( sbet2 ) );
+
+    double salp1 = 0.0, calp1 = 0.0, salp2 = 0.0, calp2 = 0.0;
+    double sig12 = 0.0, s12x = 0.0, m12x = 0.0;
+
+    bool meridian = ( lat1 == -90.0 ) || ( slam12 == 0.0 );
+    if( meridian ) { // Точки на одном меридиане (или начальная точка - полюс)
+        calp1 = clam12;
+        salp1 = slam12;
+        calp2 = 1.0;
+        salp2 = 0.0;
+        const double ssig1 = sbet1;
+        const double csig1 = calp1 * cbet1;
+        const double ssig2 = sbet2;
+        const double csig2 = calp2 * cbet2;
+        sig12 = std::atan2( std::max( 0.0, csig1 * ssig2 - ssig1 * csig2 ), csig1 * csig2 + ssig1 * ssig2 );
+        Lengths( n, sig12, ssig1, csig1, dn1, ssig2, csig2, dn2, &s12x, &m12x, nullptr );
+        // Меридиан - кратчайший путь, если нет сопряженной точки (m12 >= 0) или дуга меньше 1 рад
+        if( sig12 < 1.0 || m12x >= 0.0 ) {
+            if( sig12 < 3.0 * tiny || ( sig12 < tol0 && ( s12x < 0.0 || m12x < 0.0 ) ) ) {
+                sig12 = m12x = s12x = 0.0;
+            }
+            s12x *= b;
+        } else {
+            meridian = false;
+        }
+    }
+
+    if( !meridian && sbet1 == 0.0 && ( f <= 0.0 || lon12s >= f * 180.0 ) ) { // Геодезическая по экватору
+        calp1 = calp2 = 0.0;
+        salp1 = salp2 = 1.0;
+        s12x = a * lam12;
+    } else if( !meridian ) {
+        double dnm = 1.0;
+        sig12 = InverseStart( sbet1, cbet1, dn1, sbet2, cbet2, dn2, lam12, slam12, clam12,
+            salp1, calp1, salp2, calp2, dnm );
+        if( sig12 >= 0.0 ) { // Близкие точки - решение получено в InverseStart
+            s12x = sig12 * b * dnm;
+        } else {
+            // Метод Ньютона по alp1, при неудаче - деление пополам отрезка [alp1a, alp1b], содержащего решение
+            double ssig1 = 0.0, csig1 = 0.0, ssig2 = 0.0, csig2 = 0.0, eps = 0.0;
+            double salp1a = tiny, calp1a = 1.0, salp1b = tiny, calp1b = -1.0;
+            bool tripn = false;
+            bool tripb = false;
+            for( ;; ++numit ) {
+                double dv = 0.0;
+                const double v = Lambda12( sbet1, cbet1, dn1, sbet2, cbet2, dn2, salp1, calp1, slam12, clam12,
+                    salp2, calp2, sig12, ssig1, csig1, ssig2, csig2, eps, numit < MaxNewtonIterations, dv );
+                if( tripb || !( std::fabs( v ) >= ( tripn ? 8.0 : 1.0 ) * tol0 ) || numit == MaxIterations ) {
+                    break;
+                }
+                // Сужение отрезка, содержащего решение
+                if( v > 0.0 && ( numit > MaxNewtonIterations || calp1 / salp1 > calp1b / salp1b ) ) {
+                    salp1b = salp1;
+                    calp1b = calp1;
+                } else if( v < 0.0 && ( numit > MaxNewtonIterations || calp1 / salp1 < calp1a / salp1a ) ) {
+                    salp1a = salp1;
+                    calp1a = calp1;
+                }
+                if( numit < MaxNewtonIterations && dv > 0.0 ) {
+                    const double dalp1 = -v / dv;
+                    if( std::fabs( dalp1 ) < Consts::PI_D ) {
+                        const double sdalp1 = std::sin( dalp1 );
+                        const double cdalp1 = std::cos( dalp1 );
+                        const double nsalp1 = salp1 * cdalp1 + calp1 * sdalp1;
+                        if( nsalp1 > 0.0 ) {
+                            calp1 = calp1 * cdalp1 - salp1 * sdalp1;
+                            salp1 = nsalp1;
+                            Norm2( salp1, calp1 );
+                            tripn = std::fabs( v ) <= 16.0 * tol0;
+                            continue;
+                        }
+                    }
+                }
+                // Шаг Ньютона вышел за отрезок или не сходится - деление пополам
+                salp1 = ( salp1a + salp1b ) / 2.0;
+                calp1 = ( calp1a + calp1b ) / 2.0;
+                Norm2( salp1, calp1 );
+                tripn = false;
+                tripb = ( std::fabs( salp1a - salp1 ) + ( calp1a - calp1 ) < tolb ||
+                    std::fabs( salp1 - salp1b ) + ( calp1 - calp1b ) < tolb );
+            }
+            Lengths( eps, sig12, ssig1, csig1, dn1, ssig2, csig2, dn2, &s12x, nullptr, nullptr );
+            s12x *= b;
+        }
+    }
+    s12 = 0.0 + s12x; // -0 -> +0
+
+    // Обратные перестановки
+    if( swapp < 0.0 ) {
+        std::swap( salp1, salp2 );
+        std::swap( calp1, calp2 );
+    }
+    salp1 *= swapp * lonsign;
+    calp1 *= swapp * latsign;
+    salp2 *= swapp * lonsign;
+    calp2 *= swapp * latsign;
+    azi1 = Atan2D( salp1, calp1 );
+    azi2 = Atan2D( salp2, calp2 );
+    return numit;
+}
+
+void CGeodesic::DirectDeg( double lat1, double azi1, double s12, double &lat2, double &lon12, double &azi2 ) const
+{
+    // Величины, зависящие от начальной точки и азимута
+    double salp1, calp1;
+    SinCosD( AngRound( AngNormalize( azi1 ) ), salp1, calp1 );
+    double sbet1, cbet1;
+    SinCosD( AngRound( ( std::fabs( lat1 ) > 90.0 ) ? std::numeric_limits<double>::quiet_NaN() : lat1 ), sbet1, cbet1 );
+    sbet1 *= f1;
+    Norm2( sbet1, cbet1 );
+    cbet1 = std::max( tiny, cbet1 );
+
+    const double salp0 = salp1 * cbet1; // Азимут на экваторе
+    const double calp0 = std::hypot( calp1, salp1 * sbet1 );
+    double ssig1 = sbet1;
+    const double somg1 = salp0 * sbet1;
+    double csig1 = ( sbet1 != 0.0 || calp1 != 0.0 ) ? cbet1 * calp1 : 1.0;
+    const double comg1 = csig1;
+    Norm2( ssig1, csig1 );
+
+    const double k2 = Sq( calp0 ) * ep2;
+    const double eps = EpsFromK2( k2 );
+
+    double C1a[nC], C1pa[nC], C3a[nC];
+    const double A1m1 = A1m1f( eps );
+    C1f( eps, C1a );
+    C1pf( eps, C1pa );
+    C3f( eps, C3a );
+    const double B11 = SinCosSeries( ssig1, csig1, C1a, nC1 );
+    const double sB11 = std::sin( B11 );
+    const double cB11 = std::cos( B11 );
+    const double stau1 = ssig1 * cB11 + csig1 * sB11;
+    const double ctau1 = csig1 * cB11 - ssig1 * sB11;
+    const double A3c = -f * salp0 * A3f( eps );
+    const double B31 = SinCosSeries( ssig1, csig1, C3a, nC3 - 1 );
+
+    // Дуга на вспомогательной сфере по расстоянию: обращение ряда C1 (без итераций)
+    const double tau12 = s12 / ( b * ( 1.0 + A1m1 ) );
+    const double stau12 = std::sin( tau12 );
+    const double ctau12 = std::cos( tau12 );
+    double B12 = -SinCosSeries( stau1 * ctau12 + ctau1 * stau12, ctau1 * ctau12 - stau1 * stau12, C1pa, nC1p );
+    double sig12 = tau12 - ( B12 - B11 );
+    double ssig12 = std::sin( sig12 );
+    double csig12 = std::cos( sig12 );
+    if( std::fabs( f ) > 0.01 ) { // Для сильно сжатых эллипсоидов - один шаг Ньютона
+        const double ssig2 = ssig1 * csig12 + csig1 * ssig12;
+        const double csig2 = csig1 * csig12 - ssig1 * ssig12;
+        B12 = SinCosSeries( ssig2, csig2, C1a, nC1 );
+        const double serr = ( 1.0 + A1m1 ) * ( sig12 + ( B12 - B11 ) ) - s12 / b;
+        sig12 = sig12 - serr / std::sqrt( 1.0 + k2 * Sq( ssig2 ) );
+        ssig12 = std::sin( sig12 );
+        csig12 = std::cos( sig12 );
+    }
+
+    const double ssig2 = ssig1 * csig12 + csig1 * ssig12;
+    double csig2 = csig1 * csig12 - ssig1 * ssig12;
+    const double sbet2 = calp0 * ssig2;
+    double cbet2 = std::hypot( salp0, calp0 * csig2 );
+    if( cbet2 == 0.0 ) { // Конечная точка - полюс
+        cbet2 = csig2 = tiny;
+    }
+    const double salp2 = salp0;
+    const double calp2 = calp0 * csig2;
+
+    // Долгота без нормировки (с учетом числа оборотов вокруг оси)
+    const double E = std::copysign( 1.0, salp0 );
+    const double somg2 = salp0 * ssig2;
+    const double comg2 = csig2;
+    const double omg12 = E * ( sig12 - ( std::atan2( ssig2, csig2 ) - std::atan2( ssig1, csig1 ) ) +
+        ( std::atan2( E * somg2, comg2 ) - std::atan2( E * somg1, comg1 ) ) );
+    const double lam12 = omg12 + A3c * ( sig12 + ( SinCosSeries( ssig2, csig2, C3a, nC3 - 1 ) - B31 ) );
+    lon12 = lam12 / degree;
+    lat2 = Atan2D( sbet2, f1 * cbet2 );
+    azi2 = Atan2D( salp2, calp2 );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+int CGeodesic::Inverse( double latStart, double lonStart, double latEnd, double lonEnd, double &d, double &az,
+    double &azEnd ) const
+{
+    const double toDeg = ( angleUnit == Units::TAngleUnit::AU_Degree ) ? 1.0 : Convert::RdToDgD;
+    double s12, azi1, azi2;
+    const int iterations = InverseDeg( latStart * toDeg, lonStart * toDeg, latEnd * toDeg, lonEnd * toDeg,
+        s12, azi1, azi2 );
+    if( s12 == 0.0 ) { // Совпадающие точки
+        azi1 = 0.0;
+        azi2 = 0.0;
+    }
+    d = ( rangeUnit == Units::TRangeUnit::RU_Meter ) ? s12 : Convert::RangeFromMeter<Units::RU_Kilometer>( s12 );
+    if( angleUnit == Units::TAngleUnit::AU_Degree ) {
+        az = Convert::AngleTo360( azi1, Units::AU_Degree );
+        azEnd = Convert::AngleTo360( azi2, Units::AU_Degree );
+    } else {
+        az = Convert::AngleTo360( azi1 * Convert::DgToRdD, Units::AU_Radian );
+        azEnd = Convert::AngleTo360( azi2 * Convert::DgToRdD, Units::AU_Radian );
+    }
+    return iterations;
+}
+
+void CGeodesic::Direct( double latStart, double lonStart, double d, double az, double &latEnd, double &lonEnd,
+    double &azEnd ) const
+{
+    const double toDeg = ( angleUnit == Units::TAngleUnit::AU_Degree ) ? 1.0 : Convert::RdToDgD;
+    const double s12 = ( rangeUnit == Units::TRangeUnit::RU_Meter ) ? d :
+        Convert::RangeToMeter<Units::RU_Kilometer>( d );
+    double lat2, lon12, azi2;
+    DirectDeg( latStart * toDeg, az * toDeg, s12, lat2, lon12, azi2 );
+    if( angleUnit == Units::TAngleUnit::AU_Degree ) {
+        latEnd = lat2;
+        lonEnd = lonStart + lon12;
+        azEnd = Convert::AngleTo360( azi2, Units::AU_Degree );
+    } else {
+        latEnd = lat2 * Convert::DgToRdD;
+        lonEnd = lonStart + lon12 * Convert::DgToRdD;
+        azEnd = Convert::AngleTo360( azi2 * Convert::DgToRdD, Units::AU_Radian );
+    }
+}
+
+} // end namespace Geodesy
+} // end namespace SPML
+/// \}
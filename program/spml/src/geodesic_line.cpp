@@ -0,0 +1,260 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       geodesic_line.cpp
+/// \brief      Геодезическая линия с фиксированной начальной точкой и азимутом (расчет промежуточных точек)
+/// \details    Формулы Винсента прямой задачи (номера уравнений - как в RADtoGEO), cos( 2 * sigma1 + sigma )
+///             вычисляется через сумму углов по заранее вычисленным sin и cos( 2 * sigma1 )
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#include <geodesic_line.h>
+
+// System includes:
+#include <cassert>
+#include <cmath>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+//----------------------------------------------------------------------------------------------------------------------
+CGeodesicLine::CGeodesicLine( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, double latStart, double lonStart, double az, double d ) :
+    ellipsoid( ellipsoid ), rangeUnit( rangeUnit ), angleUnit( angleUnit )
+{
+    switch( angleUnit ) {
+        case( Units::TAngleUnit::AU_Radian ):
+        {
+            angleIn = 1.0;
+            angleOut = 1.0;
+            break;
+        }
+        case( Units::TAngleUnit::AU_Degree ):
+        {
+            angleIn = Convert::DgToRdD;
+            angleOut = Convert::RdToDgD;
+            break;
+        }
+        default:
+            assert( false );
+    }
+    switch( rangeUnit ) {
+        case( Units::TRangeUnit::RU_Meter ):
+        {
+            rangeIn = 1.0;
+            rangeOut = 1.0;
+            break;
+        }
+        case( Units::TRangeUnit::RU_Kilometer ):
+        {
+            rangeIn = 1000.0;
+            rangeOut = 0.001;
+            break;
+        }
+        default:
+            assert( false );
+    }
+
+    lat1 = latStart * angleIn;
+    lon1 = lonStart * angleIn;
+    az1 = az * angleIn;
+    s13 = d * rangeIn;
+
+    double a = ellipsoid.A();
+    double b = ellipsoid.B();
+    double f = ellipsoid.F();
+    oneMinusF = ellipsoid.OneMinusF();
+    double es2 = ellipsoid.EccentricitySecondSquared();
+
+    cosAlpha1 = std::cos( az1 );
+    sinAlpha1 = std::sin( az1 );
+    isSphere = Compare::AreEqualAbs( a, b );
+    if( isSphere ) {
+        // На сфере: sinU1, cosU1 - синус и косинус широты, bA - радиус
+        sinU1 = std::sin( lat1 );
+        cosU1 = std::cos( lat1 );
+        bA = a;
+        sin2Sigma1 = 0.0;
+        cos2Sigma1 = 1.0;
+        sinAlpha = 0.0;
+        cosSqAlpha = 1.0;
+        B = 0.0;
+        C = 0.0;
+        fC = 0.0;
+        return;
+    }
+
+    double tanU1 = oneMinusF * std::tan( lat1 );
+    cosU1 = 1.0 / std::sqrt( ( 1.0 + tanU1 * tanU1 ) );
+    sinU1 = tanU1 * cosU1;
+
+    // eq. 1
+    double sigma1 = std::atan2( tanU1, cosAlpha1 );
+    sin2Sigma1 = std::sin( 2.0 * sigma1 );
+    cos2Sigma1 = std::cos( 2.0 * sigma1 );
+
+    // eq. 2
+    sinAlpha = cosU1 * sinAlpha1;
+    cosSqAlpha = 1 - sinAlpha * sinAlpha;
+    double uSq = cosSqAlpha * es2;
+
+    // eq. 3
+    double A = 1.0 + ( uSq / 16384.0 ) * ( 4096.0 + uSq * ( -768.0 + uSq * ( 320.0 - 175.0 * uSq ) ) );
+    bA = b * A;
+
+    // eq. 4
+    B = ( uSq / 1024.0 ) * ( 256.0 + uSq * ( -128.0 + uSq * ( 74.0 - 47.0 * uSq ) ) );
+
+    // eq. 10
+    C = ( f / 16.0 ) * cosSqAlpha * ( 4.0 + f * ( 4.0 - 3.0 * cosSqAlpha ) );
+    fC = ( 1.0 - C ) * f * sinAlpha;
+}
+
+CGeodesicLine CGeodesicLine::FromPoints( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, double latStart, double lonStart, double latEnd, double lonEnd,
+    TGeodesicMethod method )
+{
+    double d, az;
+    GEOtoRAD( ellipsoid, method, rangeUnit, angleUnit, latStart, lonStart, latEnd, lonEnd, d, az );
+    return CGeodesicLine( ellipsoid, rangeUnit, angleUnit, latStart, lonStart, az, d );
+}
+
+Geographic CGeodesicLine::Start() const
+{
+    return Geographic( lat1 * angleOut, lon1 * angleOut );
+}
+
+double CGeodesicLine::Azimuth() const
+{
+    return az1 * angleOut;
+}
+
+double CGeodesicLine::Distance() const
+{
+    return s13 * rangeOut;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void CGeodesicLine::Point( double s, double &lat, double &dLon, double &azEnd ) const
+{
+    if( isSphere ) {
+        double delta = s / bA; // Нормирование
+        double sinDelta = std::sin( delta );
+        double cosDelta = std::cos( delta );
+        lat = std::asin( sinU1 * cosDelta + cosU1 * sinDelta * cosAlpha1 );
+        dLon = std::atan2( sinDelta * sinAlpha1, cosU1 * cosDelta - sinU1 * sinDelta * cosAlpha1 );
+        azEnd = Convert::AngleTo360( std::atan2( cosU1 * sinAlpha1, cosU1 * cosDelta * cosAlpha1 - sinU1 * sinDelta ),
+            Units::TAngleUnit::AU_Radian );
+        return;
+    }
+
+    // iterate until there is a negligible change in sigma
+    double sOverbA = s / bA;
+    double sigma = sOverbA;
+    double prevSigma = sOverbA;
+    double cos2SigmaM = 0.0;
+    double sinSigma = 0.0;
+    double cosSigma = 0.0;
+    double deltaSigma = 0.0;
+
+    int iterations = 0;
+
+    while( true ) {
+        // eq. 5
+        sinSigma = std::sin( sigma );
+        cosSigma = std::cos( sigma );
+        cos2SigmaM = cos2Sigma1 * cosSigma - sin2Sigma1 * sinSigma;
+
+        // eq. 6
+        deltaSigma = B * sinSigma * ( cos2SigmaM +
+            ( B / 4.0 ) * ( cosSigma * ( -1.0 + 2.0 * cos2SigmaM * cos2SigmaM ) -
+            ( B / 6.0 ) * cos2SigmaM * ( -3.0 + 4.0 * sinSigma * sinSigma ) * ( -3.0 + 4.0 * cos2SigmaM * cos2SigmaM ) ) );
+
+        // eq. 7
+        sigma = sOverbA + deltaSigma;
+
+        // break after converging to tolerance
+        if( std::abs( sigma - prevSigma ) < 1.0e-15 || std::isnan( std::abs( sigma - prevSigma ) ) ) {
+            break;
+        }
+        prevSigma = sigma;
+
+        iterations++;
+        if( iterations > 1000 ) {
+            break;
+        }
+    }
+    sinSigma = std::sin( sigma );
+    cosSigma = std::cos( sigma );
+    cos2SigmaM = cos2Sigma1 * cosSigma - sin2Sigma1 * sinSigma;
+
+    double tmp = sinU1 * sinSigma - cosU1 * cosSigma * cosAlpha1;
+
+    // eq. 8
+    lat = std::atan2( sinU1 * cosSigma + cosU1 * sinSigma * cosAlpha1,
+        oneMinusF * std::sqrt( ( sinAlpha * sinAlpha + tmp * tmp ) ) );
+
+    // eq. 9
+    double lambda = std::atan2( ( sinSigma * sinAlpha1 ), ( cosU1 * cosSigma - sinU1 * sinSigma * cosAlpha1 ) );
+
+    // eq. 11
+    dLon = lambda - fC * ( sigma + C * sinSigma *
+        ( cos2SigmaM + C * cosSigma * ( -1.0 + 2.0 * cos2SigmaM * cos2SigmaM ) ) );
+
+    // eq. 12
+    azEnd = Convert::AngleTo360( std::atan2( sinAlpha, -tmp ), Units::TAngleUnit::AU_Radian );
+}
+
+void CGeodesicLine::Position( double d, double &lat, double &lon, double &azEnd ) const
+{
+    double dLon;
+    Point( d * rangeIn, lat, dLon, azEnd );
+    lat *= angleOut;
+    lon = ( lon1 + dLon ) * angleOut;
+    azEnd *= angleOut;
+}
+
+void CGeodesicLine::PositionAtFraction( double fraction, double &lat, double &lon, double &azEnd ) const
+{
+    double dLon;
+    Point( fraction * s13, lat, dLon, azEnd );
+    lat *= angleOut;
+    lon = ( lon1 + dLon ) * angleOut;
+    azEnd *= angleOut;
+}
+
+void CGeodesicLine::Positions( const double *d, std::size_t count, double *lat, double *lon, double *azEnd ) const
+{
+    for( std::size_t i = 0; i < count; i++ ) {
+        double latI, dLon, azI;
+        Point( d[i] * rangeIn, latI, dLon, azI );
+        lat[i] = latI * angleOut;
+        lon[i] = ( lon1 + dLon ) * angleOut;
+        if( azEnd != nullptr ) {
+            azEnd[i] = azI * angleOut;
+        }
+    }
+}
+
+void CGeodesicLine::Waypoints( std::size_t count, double *lat, double *lon, double *azEnd ) const
+{
+    const double step = ( count > 1 ) ? s13 / static_cast<double>( count - 1 ) : 0.0;
+    for( std::size_t i = 0; i < count; i++ ) {
+        // Последняя точка - ровно на длине линии
+        const double s = ( i + 1 == count && count > 1 ) ? s13 : step * static_cast<double>( i );
+        double latI, dLon, azI;
+        Point( s, latI, dLon, azI );
+        lat[i] = latI * angleOut;
+        lon[i] = ( lon1 + dLon ) * angleOut;
+        if( azEnd != nullptr ) {
+            azEnd[i] = azI * angleOut;
+        }
+    }
+}
+
+} // end namespace Geodesy
+} // end namespace SPML
+/// \}
@@ -9,12 +9,54 @@
 ///
 
 #include <geodesy.h>
+#include <geodesic.h>
+#include <vincenty_stats_impl.h>
+
+// System includes:
+#include <memory>
 
 namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
 {
 namespace Geodesy /// Геодезические функции и функции перевода координат
 {
 
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Вызов специализации функции по единицам измерения, заданным во время выполнения
+/// \details Функтор получает единицы измерения в виде std::integral_constant, т.е. как параметры шаблона
+///
+template <Units::TRangeUnit RU, class Func>
+static void DispatchAngleUnit( const Units::TAngleUnit &angleUnit, Func &&func )
+{
+    switch( angleUnit ) {
+        case( Units::TAngleUnit::AU_Radian ):
+            func( std::integral_constant<Units::TRangeUnit, RU>(),
+                std::integral_constant<Units::TAngleUnit, Units::TAngleUnit::AU_Radian>() );
+            break;
+        case( Units::TAngleUnit::AU_Degree ):
+            func( std::integral_constant<Units::TRangeUnit, RU>(),
+                std::integral_constant<Units::TAngleUnit, Units::TAngleUnit::AU_Degree>() );
+            break;
+        default:
+            assert( false );
+    }
+}
+
+template <class Func>
+static void DispatchUnits( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit, Func &&func )
+{
+    switch( rangeUnit ) {
+        case( Units::TRangeUnit::RU_Meter ):
+            DispatchAngleUnit<Units::TRangeUnit::RU_Meter>( angleUnit, func );
+            break;
+        case( Units::TRangeUnit::RU_Kilometer ):
+            DispatchAngleUnit<Units::TRangeUnit::RU_Kilometer>( angleUnit, func );
+            break;
+        default:
+            assert( false );
+    }
+}
+
 //----------------------------------------------------------------------------------------------------------------------
 CEllipsoid::CEllipsoid()
 {
@@ -22,6 +64,7 @@ CEllipsoid::CEllipsoid()
     b = 0.0;
     f = 0.0;
     invf = 0.0;
+    InitDerived();
 }
 
 CEllipsoid::CEllipsoid( std::string ellipsoidName, double semiMajorAxis, double semiMinorAxis, double inverseFlattening, bool isInvfDef )
@@ -39,8 +82,56 @@ CEllipsoid::CEllipsoid( std::string ellipsoidName, double semiMajorAxis, double
         b = semiMinorAxis;
         f = 1.0 / inverseFlattening;
     }
+    InitDerived();
+}
+
+CEllipsoid::CEllipsoid( const TEllipsoidParams &params ) :
+    CEllipsoid( std::string( params.name ), params.a, params.b, params.invf, true ) // Для сферы invf = 0 -> f = 0
+{
+}
+
+void CEllipsoid::InitDerived()
+{
+    e1 = std::sqrt( ( a * a ) - ( b * b ) ) / a;
+    es1 = 1.0 - ( ( b * b ) / ( a * a ) );
+    e2 = std::sqrt( ( a * a ) - ( b * b ) ) / b;
+    es2 = ( ( a * a ) / ( b * b ) ) - 1.0;
+    oneMinusF = 1.0 - f;
+    axisRatio = b / a;
+
+    // Olson, D. K. (1996)
+    olson.a1 = a * es1;
+    olson.a2 = olson.a1 * olson.a1;
+    olson.a3 = olson.a1 * es1 / 2.0;
+    olson.a4 = 2.5 * olson.a2;
+    olson.a5 = olson.a1 + olson.a3;
+    olson.a6 = 1.0 - es1;
+}
+
+namespace Ellipsoids /// Земные эллипсоиды
+{
+//----------------------------------------------------------------------------------------------------------------------
+const std::vector<CEllipsoid> &GetPredefinedEllipsoids()
+{
+    static const std::vector<CEllipsoid> ellipsoids = []() {
+        std::vector<CEllipsoid> result;
+        result.reserve( TEllipsoidId::EL_Count );
+        for( const TEllipsoidParams &params : Registry::Ellipsoids ) {
+            result.emplace_back( params );
+        }
+        return result;
+    }();
+    return ellipsoids;
 }
 
+const CEllipsoid &Get( TEllipsoidId id )
+{
+    assert( id < TEllipsoidId::EL_Count );
+    return GetPredefinedEllipsoids()[id];
+}
+
+} // end namespace Ellipsoids
+
 //CEllipsoid::CEllipsoid( std::string ellipsoidName, double semiMajorAxis, double semiMinorAxis, double inverseFlattening )
 //{
 //    name = ellipsoidName;
@@ -58,13 +149,16 @@ CEllipsoid::CEllipsoid( std::string ellipsoidName, double semiMajorAxis, double
 //    }
 //}
 //----------------------------------------------------------------------------------------------------------------------
-void GEOtoRAD( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void GEOtoRAD( const CEllipsoid &ellipsoid,
     double latStart, double lonStart, double latEnd, double lonEnd, double &d, double &az, double &azEnd )
 {
     // Параметры эллипсоида:
     double a = ellipsoid.A();
     double b = ellipsoid.B();
     double f = ellipsoid.F();
+    double oneMinusF = ellipsoid.OneMinusF();
+    double es2 = ellipsoid.EccentricitySecondSquared(); // ( a * a - b * b ) / ( b * b )
 
     // По умолчанию Радианы:
     double _latStart = latStart;
@@ -73,19 +167,10 @@ void GEOtoRAD( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     double _lonEnd = lonEnd;
 
     // При необходимости переведем входные данные в Радианы:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            _latStart *= Convert::DgToRdD;
-            _lonStart *= Convert::DgToRdD;
-            _latEnd *= Convert::DgToRdD;
-            _lonEnd *= Convert::DgToRdD;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _latStart = Convert::AngleToRad<AU>( _latStart );
+    _lonStart = Convert::AngleToRad<AU>( _lonStart );
+    _latEnd = Convert::AngleToRad<AU>( _latEnd );
+    _lonEnd = Convert::AngleToRad<AU>( _lonEnd );
     // Далее в математике используются углы в радианах и дальность в метрах, перевод в нужные единицы у конце
 
     if( Compare::AreEqualAbs( a, b ) ) { // При расчете на сфере используем упрощенные формулы
@@ -111,8 +196,8 @@ void GEOtoRAD( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     } else { // Для эллипсоида используем формулы Винсента
         double L = _lonEnd - _lonStart;
 
-        double U1 = std::atan( ( 1.0 - f ) * std::tan( _latStart ) );
-        double U2 = std::atan( ( 1.0 - f ) * std::tan( _latEnd ) );
+        double U1 = std::atan( oneMinusF * std::tan( _latStart ) );
+        double U2 = std::atan( oneMinusF * std::tan( _latEnd ) );
 
         double sinU1 = std::sin( U1 );
         double cosU1 = std::cos( U1 );
@@ -142,6 +227,9 @@ void GEOtoRAD( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
             sinSigma = std::sqrt( ( ( cosU2 * sinLambda ) * ( cosU2 * sinLambda ) +
                 ( cosU1 * sinU2 - sinU1 * cosU2 * cosLambda ) * ( cosU1 * sinU2 - sinU1 * cosU2 * cosLambda ) ) );
             if( Compare::IsZeroAbs( sinSigma ) ) { // co-incident points
+                if( CollectVincentyStats ) {
+                    RecordVincentyInverse( 101 - iterLimit, VO_Coincident );
+                }
                 d = 0.0;
                 az = 0.0;
                 azEnd = 0.0;
@@ -175,8 +263,12 @@ void GEOtoRAD( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
                 ( sigma + c * sinSigma * ( cos2SigmaM + c * cosSigma * ( -1.0 + 2.0 * cos2SigmaM * cos2SigmaM ) ) );
 
         } while( std::abs( ( lambda - lambda_new ) / lambda ) > 1.0e-15 && --iterLimit > 0 ); // see how much improvement we got
+        if( CollectVincentyStats ) { // Итераций выполнено 101 - iterLimit, без сходимости (iterLimit = 0) - 100
+            RecordVincentyInverse( ( iterLimit > 0 ) ? 101 - iterLimit : 100,
+                ( iterLimit > 0 ) ? VO_Converged : VO_NotConverged );
+        }
 
-        double uSq = cosSqAlpha * ( a * a - b * b ) / ( b * b );
+        double uSq = cosSqAlpha * es2;
 
         // eq. 3
         double A = 1 + uSq / 16384.0 * ( 4096.0 + uSq * ( -768.0 + uSq * ( 320.0 - 175.0 * uSq ) ) );
@@ -202,30 +294,21 @@ void GEOtoRAD( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     // az, azEnd, d сейчас в радианах и метрах соответственно
 
     // Проверим, нужен ли перевод:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            az *= Convert::RdToDgD;
-            azEnd *= Convert::RdToDgD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            d *= 0.001;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    az = Convert::AngleFromRad<AU>( az );
+    azEnd = Convert::AngleFromRad<AU>( azEnd );
+    d = Convert::RangeFromMeter<RU>( d );
     return;
 }
 
+void GEOtoRAD( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double latStart, double lonStart, double latEnd, double lonEnd, double &d, double &az, double &azEnd )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        GEOtoRAD<decltype( ru )::value, decltype( au )::value>( ellipsoid, latStart, lonStart, latEnd, lonEnd, d, az,
+            azEnd );
+    } );
+}
+
 RAD GEOtoRAD(const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     const Geographic &start, const Geographic &end )
 {
@@ -235,13 +318,16 @@ RAD GEOtoRAD(const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, co
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void RADtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void RADtoGEO( const CEllipsoid &ellipsoid,
     double latStart, double lonStart, double d, double az, double &latEnd, double &lonEnd, double &azEnd )
 {
     // Параметры эллипсоида:
     double a = ellipsoid.A();
     double b = ellipsoid.B();
     double f = ellipsoid.F();
+    double oneMinusF = ellipsoid.OneMinusF();
+    double es2 = ellipsoid.EccentricitySecondSquared(); // ( a * a - b * b ) / ( b * b )
 
     // по умолчанию Метры-Радианы:
     double _latStart = latStart;    // [рад]
@@ -250,28 +336,10 @@ void RADtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     double _az = az;                // [рад]
 
     // При необходимости переведем в Радианы-Метры:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            _latStart *= Convert::DgToRdD;
-            _lonStart *= Convert::DgToRdD;
-            _az *= Convert::DgToRdD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            _d *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _latStart = Convert::AngleToRad<AU>( _latStart );
+    _lonStart = Convert::AngleToRad<AU>( _lonStart );
+    _az = Convert::AngleToRad<AU>( _az );
+    _d = Convert::RangeToMeter<RU>( _d );
     // Далее в математике используются углы в радианах и дальность в метрах, перевод в нужные единицы у конце
 
     if( Compare::AreEqualAbs(a, b) ) { // При расчете на сфере используем упрощенные формулы
@@ -297,7 +365,7 @@ void RADtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
         double cosAlpha1 = std::cos( _az );
         double sinAlpha1 = std::sin( _az );
         double s = _d; // distance [m]
-        double tanU1 = ( 1.0 - f ) * std::tan( _latStart );
+        double tanU1 = oneMinusF * std::tan( _latStart );
         double cosU1 = 1.0 / std::sqrt( ( 1.0 + tanU1 * tanU1 ) );
         double sinU1 = tanU1 * cosU1;
 
@@ -307,7 +375,7 @@ void RADtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
         // eq. 2
         double sinAlpha = cosU1 * sinAlpha1;
         double cosSqAlpha = 1 - sinAlpha * sinAlpha;
-        double uSq = cosSqAlpha * ( a * a - b * b ) / ( b * b );
+        double uSq = cosSqAlpha * es2;
 
         // eq. 3
         double A = 1.0 + ( uSq / 16384.0 ) * ( 4096.0 + uSq * ( -768.0 + uSq * ( 320.0 - 175.0 * uSq ) ) );
@@ -351,6 +419,10 @@ void RADtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
                 break;
             }
         }
+        if( CollectVincentyStats ) { // Итераций выполнено iterations + 1, без сходимости - 1001
+            RecordVincentyDirect( std::min( iterations + 1, 1001 ), ( iterations > 1000 ) ? VO_NotConverged :
+                VO_Converged );
+        }
         cos2SigmaM = std::cos( 2.0 * sigma1 + sigma );
         sinSigma = std::sin( sigma );
         cosSigma = std::cos( sigma );
@@ -359,7 +431,7 @@ void RADtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
 
         // eq. 8
         latEnd = std::atan2( sinU1 * cosSigma + cosU1 * sinSigma * cosAlpha1,
-            ( 1.0 - f ) * std::sqrt( ( sinAlpha * sinAlpha + tmp * tmp) ) ); // [рад]
+            oneMinusF * std::sqrt( ( sinAlpha * sinAlpha + tmp * tmp) ) ); // [рад]
 
         // eq. 9
         double lambda = std::atan2( ( sinSigma * sinAlpha1 ), ( cosU1 * cosSigma - sinU1 * sinSigma * cosAlpha1 ) );
@@ -382,21 +454,21 @@ void RADtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     // latEnd, lonEnd, azEnd сейчас в радианах
 
     // Проверим, нужен ли перевод:    
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            latEnd *= Convert::RdToDgD;
-            lonEnd *= Convert::RdToDgD;
-            azEnd *= Convert::RdToDgD;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    latEnd = Convert::AngleFromRad<AU>( latEnd );
+    lonEnd = Convert::AngleFromRad<AU>( lonEnd );
+    azEnd = Convert::AngleFromRad<AU>( azEnd );
     return;
 }
 
+void RADtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double latStart, double lonStart, double d, double az, double &latEnd, double &lonEnd, double &azEnd )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        RADtoGEO<decltype( ru )::value, decltype( au )::value>( ellipsoid, latStart, lonStart, d, az, latEnd, lonEnd,
+            azEnd );
+    } );
+}
+
 Geographic RADtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
     const Geographic &start, const RAD &rad, double &azEnd )
 {
@@ -406,8 +478,53 @@ Geographic RADtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &range
     return Geographic( latEnd, lonEnd );
 }
 //----------------------------------------------------------------------------------------------------------------------
-void GEOtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
-    double lat, double lon, double h, double &x, double &y, double &z )
+// Решатель Карни для эллипсоида и единиц измерения: в каждом потоке хранится последний использованный
+static const CGeodesic &CachedGeodesic( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit )
+{
+    thread_local std::unique_ptr<CGeodesic> geodesic;
+    if( !geodesic || geodesic->Ellipsoid().A() != ellipsoid.A() || geodesic->Ellipsoid().B() != ellipsoid.B() ||
+        geodesic->RangeUnit() != rangeUnit || geodesic->AngleUnit() != angleUnit ) {
+        geodesic.reset( new CGeodesic( ellipsoid, rangeUnit, angleUnit ) );
+    }
+    return *geodesic;
+}
+
+void GEOtoRAD( const CEllipsoid &ellipsoid, TGeodesicMethod method, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, double latStart, double lonStart, double latEnd, double lonEnd, double &d,
+    double &az, double &azEnd )
+{
+    switch( method ) {
+        case( TGeodesicMethod::GM_Vincenty ):
+            GEOtoRAD( ellipsoid, rangeUnit, angleUnit, latStart, lonStart, latEnd, lonEnd, d, az, azEnd );
+            break;
+        case( TGeodesicMethod::GM_Karney ):
+            CachedGeodesic( ellipsoid, rangeUnit, angleUnit ).Inverse( latStart, lonStart, latEnd, lonEnd, d, az, azEnd );
+            break;
+        default:
+            assert( false );
+    }
+}
+
+void RADtoGEO( const CEllipsoid &ellipsoid, TGeodesicMethod method, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, double latStart, double lonStart, double d, double az, double &latEnd,
+    double &lonEnd, double &azEnd )
+{
+    switch( method ) {
+        case( TGeodesicMethod::GM_Vincenty ):
+            RADtoGEO( ellipsoid, rangeUnit, angleUnit, latStart, lonStart, d, az, latEnd, lonEnd, azEnd );
+            break;
+        case( TGeodesicMethod::GM_Karney ):
+            CachedGeodesic( ellipsoid, rangeUnit, angleUnit ).Direct( latStart, lonStart, d, az, latEnd, lonEnd, azEnd );
+            break;
+        default:
+            assert( false );
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void GEOtoECEF( const CEllipsoid &ellipsoid, double lat, double lon, double h, double &x, double &y, double &z )
 {
     // Параметры эллипсоида:
     double a = ellipsoid.A();
@@ -419,27 +536,9 @@ void GEOtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     double _h = h;     // [м]
 
     // При необходимости переведем в Радианы-Метры:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            _lat *= Convert::DgToRdD;
-            _lon *= Convert::DgToRdD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            _h *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _lat = Convert::AngleToRad<AU>( _lat );
+    _lon = Convert::AngleToRad<AU>( _lon );
+    _h = Convert::RangeToMeter<RU>( _h );
     // Далее в математике используются углы в радианах и дальность в метрах, перевод в нужные единицы у конце
     assert( !Compare::IsZeroAbs( a * a ) );
 //    double es = 1.0 - ( ( b * b ) / ( a * a ) ); // e^2
@@ -456,23 +555,22 @@ void GEOtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
 
     x = ( v + _h ) * cosLat * cosLon; // [м]
     y = ( v + _h ) * cosLat * sinLon; // [м]
-    z = ( v * ( 1.0 - es ) + _h ) * std::sin( _lat );    // [м]
+    z = ( v * ( 1.0 - es ) + _h ) * sinLat;    // [м]
 
     // x, y, x сейчас в метрах
 
     // Проверим, нужен ли перевод:
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer ):
-        {
-            x /= 1000.0;
-            y /= 1000.0;
-            z /= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    x = Convert::RangeFromMeter<RU>( x );
+    y = Convert::RangeFromMeter<RU>( y );
+    z = Convert::RangeFromMeter<RU>( z );
+}
+
+void GEOtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double lat, double lon, double h, double &x, double &y, double &z )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        GEOtoECEF<decltype( ru )::value, decltype( au )::value>( ellipsoid, lat, lon, h, x, y, z );
+    } );
 }
 
 XYZ GEOtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
@@ -613,7 +711,8 @@ void ECEFtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
 }
 */
 
-void ECEFtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ECEFtoGEO( const CEllipsoid &ellipsoid,
     double x, double y, double z, double &lat, double &lon, double &h )
 {
     // Olson, D. K. (1996). Converting Earth-Centered, Earth-Fixed Coordinates to Geodetic Coordinates. IEEE Transactions on Aerospace and Electronic Systems, 32(1), 473–476. https://doi.org/10.1109/7.481290
@@ -621,40 +720,22 @@ void ECEFtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     // Параметры эллипсоида:
     double _a = ellipsoid.A();
     double _es = ellipsoid.EccentricityFirstSquared();   // Eccentricity squared : (a^2 - b^2)/a^2
-    const double _a1 = _a * _es;
-    const double _a2 = _a1 * _a1;
-    const double _a3 = _a1 * _es / 2.0;
-    const double _a4 = 2.5 * _a2;
-    const double _a5 = _a1 + _a3;
-    const double _a6 = 1.0 - _es;
-
-    // wgs-84
-//    double _a = 6378137.0;
-//    double _es = 6.6943799901377997e-3;
-//    double _a1 = 4.2697672707157535e+4;
-//    double _a2 = 1.8230912546075455e+9;
-//    double _a3 = 1.4291722289812413e+2;
-//    double _a4 = 4.5577281365188637e+9;
-//    double _a5 = 4.2840589930055659e+4;
-//    double _a6 = 9.9330562000986220e-1;
+    const OlsonCoefficients &olson = ellipsoid.Olson(); // Рассчитаны при создании эллипсоида
+    const double _a1 = olson.a1;
+    const double _a2 = olson.a2;
+    const double _a3 = olson.a3;
+    const double _a4 = olson.a4;
+    const double _a5 = olson.a5;
+    const double _a6 = olson.a6;
 
     double _x = x;
     double _y = y;
     double _z = z;
 
     // При необходимости переведем в Метры:
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            _x *= 1000.0;
-            _y *= 1000.0;
-            _z *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _x = Convert::RangeToMeter<RU>( _x );
+    _y = Convert::RangeToMeter<RU>( _y );
+    _z = Convert::RangeToMeter<RU>( _z );
     // Далее в математике используются углы в радианах и дальность в метрах, перевод в нужные единицы у конце
 
     double _lon = 0;
@@ -709,27 +790,17 @@ void ECEFtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     h = _h;
 
     // Проверим, нужен ли перевод:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            lat *= Convert::RdToDgD;
-            lon *= Convert::RdToDgD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer ):
-        {
-            h /= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    lat = Convert::AngleFromRad<AU>( lat );
+    lon = Convert::AngleFromRad<AU>( lon );
+    h = Convert::RangeFromMeter<RU>( h );
+}
+
+void ECEFtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double x, double y, double z, double &lat, double &lon, double &h )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        ECEFtoGEO<decltype( ru )::value, decltype( au )::value>( ellipsoid, x, y, z, lat, lon, h );
+    } );
 }
 
 Geodetic ECEFtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
@@ -755,7 +826,8 @@ double XYZtoDistance( const XYZ &point1, const XYZ &point2 )
     return XYZtoDistance( point1.X, point1.Y, point1.Z, point2.X, point2.Y, point2.Z );
 }
 //----------------------------------------------------------------------------------------------------------------------
-void ECEF_offset( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ECEF_offset( const CEllipsoid &ellipsoid,
     double lat1, double lon1, double h1, double lat2, double lon2, double h2, double &dX, double &dY, double &dZ )
 {
     // Параметры эллипсоида:
@@ -772,73 +844,55 @@ void ECEF_offset( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUni
     double _h2 = h2;
 
     // При необходимости переведем в Радианы-Метры:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            _lat1 *= Convert::DgToRdD;
-            _lon1 *= Convert::DgToRdD;
-            _lat2 *= Convert::DgToRdD;
-            _lon2 *= Convert::DgToRdD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            _h1 *= 1000.0;
-            _h2 *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _lat1 = Convert::AngleToRad<AU>( _lat1 );
+    _lon1 = Convert::AngleToRad<AU>( _lon1 );
+    _lat2 = Convert::AngleToRad<AU>( _lat2 );
+    _lon2 = Convert::AngleToRad<AU>( _lon2 );
+    _h1 = Convert::RangeToMeter<RU>( _h1 );
+    _h2 = Convert::RangeToMeter<RU>( _h2 );
     // Далее в математике используются углы в радианах и дальность в метрах, перевод в нужные единицы у конце
 
-    double s1 = std::sin( lat1 );
-    double c1 = std::cos( lat1 );
+    double s1 = std::sin( _lat1 );
+    double c1 = std::cos( _lat1 );
 
-    double s2 = std::sin( lat2 );
-    double c2 = std::cos( lat2 );
+    double s2 = std::sin( _lat2 );
+    double c2 = std::cos( _lat2 );
 
-    double p1 = c1 * std::cos( lon1 );
-    double p2 = c2 * std::cos( lon2 );
+    double p1 = c1 * std::cos( _lon1 );
+    double p2 = c2 * std::cos( _lon2 );
 
-    double q1 = c1 * std::sin( lon1 );
-    double q2 = c2 * std::sin( lon2 );
+    double q1 = c1 * std::sin( _lon1 );
+    double q2 = c2 * std::sin( _lon2 );
 
     if( Compare::AreEqualAbs( a, b ) ) { // Сфера
-        dX = a * ( p2 - p1 ) + ( h2 * p2 - h1 * p1 );
-        dY = a * ( q2 - q1 ) + ( h2 * q2 - h1 * q1 );
-        dZ = a * ( s2 - s1 ) + ( h2 * s2 - h1 * s1 );
+        dX = a * ( p2 - p1 ) + ( _h2 * p2 - _h1 * p1 );
+        dY = a * ( q2 - q1 ) + ( _h2 * q2 - _h1 * q1 );
+        dZ = a * ( s2 - s1 ) + ( _h2 * s2 - _h1 * s1 );
     } else { // Эллипсоид
-        double e2 = std::pow( ellipsoid.EccentricityFirst(), 2 ); // Квадрат 1-го эксцентриситета эллипсоида
+        double e2 = ellipsoid.EccentricityFirstSquared(); // Квадрат 1-го эксцентриситета эллипсоида
 
         double w1 = 1.0 / std::sqrt( 1.0 - e2 * s1 * s1 );
         double w2 = 1.0 / std::sqrt( 1.0 - e2 * s2 * s2 );
 
-        dX = a * ( p2 * w2 - p1 * w1 ) + ( h2 * p2 - h1 * p1 );
-        dY = a * ( q2 * w2 - q1 * w1 ) + ( h2 * q2 - h1 * q1 );
-        dZ = ( 1.0 - e2 ) * a * ( s2 * w2 - s1 * w1 ) + ( h2 * s2 - h1 * s1 );
+        dX = a * ( p2 * w2 - p1 * w1 ) + ( _h2 * p2 - _h1 * p1 );
+        dY = a * ( q2 * w2 - q1 * w1 ) + ( _h2 * q2 - _h1 * q1 );
+        dZ = ( 1.0 - e2 ) * a * ( s2 * w2 - s1 * w1 ) + ( _h2 * s2 - _h1 * s1 );
     }
     // dX dY dZ сейчас в метрах
 
     // Проверим, нужен ли перевод:
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer ):
-        {
-            dX *= 0.001;
-            dY *= 0.001;
-            dZ *= 0.001;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    dX = Convert::RangeFromMeter<RU>( dX );
+    dY = Convert::RangeFromMeter<RU>( dY );
+    dZ = Convert::RangeFromMeter<RU>( dZ );
+}
+
+void ECEF_offset( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double lat1, double lon1, double h1, double lat2, double lon2, double h2, double &dX, double &dY, double &dZ )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        ECEF_offset<decltype( ru )::value, decltype( au )::value>( ellipsoid, lat1, lon1, h1, lat2, lon2, h2, dX, dY,
+            dZ );
+    } );
 }
 
 XYZ ECEF_offset( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
@@ -850,7 +904,8 @@ XYZ ECEF_offset( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit
     return XYZ( x, y, z );
 }
 //----------------------------------------------------------------------------------------------------------------------
-void ECEFtoENU( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ECEFtoENU( const CEllipsoid &ellipsoid,
     double x, double y, double z, double lat, double lon, double h, double &xEast, double &yNorth, double &zUp )
 {
     // по умолчанию Метры-Радианы:
@@ -863,33 +918,16 @@ void ECEFtoENU( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     double _xr, _yr, _zr; // Reference point
 
     // При необходимости переведем в Радианы-Метры:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            _lat *= Convert::DgToRdD;
-            _lon *= Convert::DgToRdD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            _h *= 1000.0;
-            _x *= 1000.0;
-            _y *= 1000.0;
-            _z *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _lat = Convert::AngleToRad<AU>( _lat );
+    _lon = Convert::AngleToRad<AU>( _lon );
+    _h = Convert::RangeToMeter<RU>( _h );
+    _x = Convert::RangeToMeter<RU>( _x );
+    _y = Convert::RangeToMeter<RU>( _y );
+    _z = Convert::RangeToMeter<RU>( _z );
     // Далее в математике используются углы в радианах и дальность в метрах, перевод в нужные единицы у конце
 
-    GEOtoECEF( ellipsoid, Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, _lat, _lon, _h, _xr, _yr, _zr ); // Получены ECEF координаты опорной точки
+    // Получены ECEF координаты опорной точки:
+    GEOtoECEF<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, _lat, _lon, _h, _xr, _yr, _zr );
 
     double cosPhi = std::cos( _lat );
     double sinPhi = std::sin( _lat );
@@ -907,18 +945,17 @@ void ECEFtoENU( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     // xEast yNorth zUp сейчас в метрах
 
     // Проверим, нужен ли перевод:
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer ):
-        {
-            xEast *= 0.001;
-            yNorth *= 0.001;
-            zUp *= 0.001;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    xEast = Convert::RangeFromMeter<RU>( xEast );
+    yNorth = Convert::RangeFromMeter<RU>( yNorth );
+    zUp = Convert::RangeFromMeter<RU>( zUp );
+}
+
+void ECEFtoENU( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double x, double y, double z, double lat, double lon, double h, double &xEast, double &yNorth, double &zUp )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        ECEFtoENU<decltype( ru )::value, decltype( au )::value>( ellipsoid, x, y, z, lat, lon, h, xEast, yNorth, zUp );
+    } );
 }
 
 ENU ECEFtoENU( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
@@ -929,48 +966,31 @@ ENU ECEFtoENU( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     return ENU( e, n, u );
 }
 //----------------------------------------------------------------------------------------------------------------------
-void ECEFtoENUV( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
-    double dX, double dY, double dZ, double lat, double lon, double &xEast, double &yNorth, double &zUp )
+template <Units::TRangeUnit RU, Units::TAngleUnit AU, class T>
+static void ECEFtoENUVImpl( T dX, T dY, T dZ, T lat, T lon, T &xEast, T &yNorth, T &zUp )
 {
+    static_assert( std::is_same<T, float>::value || std::is_same<T, double>::value, "wrong template class!" );
     // по умолчанию Метры-Радианы:
-    double _lat = lat;
-    double _lon = lon;
-    double _dX = dX;
-    double _dY = dY;
-    double _dZ = dZ;
+    T _lat = lat;
+    T _lon = lon;
+    T _dX = dX;
+    T _dY = dY;
+    T _dZ = dZ;
 
     // При необходимости переведем в Радианы-Метры:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            _lat *= Convert::DgToRdD;
-            _lon *= Convert::DgToRdD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            _dX *= 1000.0;
-            _dY *= 1000.0;
-            _dZ *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _lat = Convert::AngleToRad<AU>( _lat );
+    _lon = Convert::AngleToRad<AU>( _lon );
+    _dX = Convert::RangeToMeter<RU>( _dX );
+    _dY = Convert::RangeToMeter<RU>( _dY );
+    _dZ = Convert::RangeToMeter<RU>( _dZ );
     // Далее в математике используются углы в радианах и дальность в метрах, перевод в нужные единицы у конце
 
-    double cosPhi = std::cos( _lat );
-    double sinPhi = std::sin( _lat );
-    double cosLambda = std::cos( _lon );
-    double sinLambda = std::sin( _lon );
+    T cosPhi = std::cos( _lat );
+    T sinPhi = std::sin( _lat );
+    T cosLambda = std::cos( _lon );
+    T sinLambda = std::sin( _lon );
 
-    double t = ( cosLambda * _dX ) + ( sinLambda * _dY );
+    T t = ( cosLambda * _dX ) + ( sinLambda * _dY );
     xEast = ( -sinLambda * _dX ) + ( cosLambda * _dY );
 
     zUp    =  ( cosPhi * t ) + ( sinPhi * _dZ );
@@ -979,18 +999,37 @@ void ECEFtoENUV( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &an
     // xEast yNorth zUp сейчас в метрах
 
     // Проверим, нужен ли перевод:
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer ):
-        {
-            xEast *= 0.001;
-            yNorth *= 0.001;
-            zUp *= 0.001;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    xEast = Convert::RangeFromMeter<RU>( xEast );
+    yNorth = Convert::RangeFromMeter<RU>( yNorth );
+    zUp = Convert::RangeFromMeter<RU>( zUp );
+}
+
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ECEFtoENUV( double dX, double dY, double dZ, double lat, double lon, double &xEast, double &yNorth, double &zUp )
+{
+    ECEFtoENUVImpl<RU, AU>( dX, dY, dZ, lat, lon, xEast, yNorth, zUp );
+}
+
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ECEFtoENUV( float dX, float dY, float dZ, float lat, float lon, float &xEast, float &yNorth, float &zUp )
+{
+    ECEFtoENUVImpl<RU, AU>( dX, dY, dZ, lat, lon, xEast, yNorth, zUp );
+}
+
+void ECEFtoENUV( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double dX, double dY, double dZ, double lat, double lon, double &xEast, double &yNorth, double &zUp )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        ECEFtoENUV<decltype( ru )::value, decltype( au )::value>( dX, dY, dZ, lat, lon, xEast, yNorth, zUp );
+    } );
+}
+
+void ECEFtoENUV( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    float dX, float dY, float dZ, float lat, float lon, float &xEast, float &yNorth, float &zUp )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        ECEFtoENUV<decltype( ru )::value, decltype( au )::value>( dX, dY, dZ, lat, lon, xEast, yNorth, zUp );
+    } );
 }
 
 ENU ECEFtoENUV( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
@@ -1001,7 +1040,8 @@ ENU ECEFtoENUV( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &ang
     return ENU( e, n, u );
 }
 //----------------------------------------------------------------------------------------------------------------------
-void ENUtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ENUtoECEF( const CEllipsoid &ellipsoid,
     double e, double n, double u, double lat, double lon, double h, double &x, double &y, double &z )
 {
     // по умолчанию Метры-Радианы:
@@ -1014,33 +1054,15 @@ void ENUtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     double _xr, _yr, _zr; // Reference point
 
     // При необходимости переведем в Радианы-Метры:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            _lat *= Convert::DgToRdD;
-            _lon *= Convert::DgToRdD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            _h *= 1000.0;
-            _e *= 1000.0;
-            _n *= 1000.0;
-            _u *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _lat = Convert::AngleToRad<AU>( _lat );
+    _lon = Convert::AngleToRad<AU>( _lon );
+    _h = Convert::RangeToMeter<RU>( _h );
+    _e = Convert::RangeToMeter<RU>( _e );
+    _n = Convert::RangeToMeter<RU>( _n );
+    _u = Convert::RangeToMeter<RU>( _u );
     // Далее в математике используются углы в радианах и дальность в метрах, перевод в нужные единицы у конце
 
-    GEOtoECEF( ellipsoid, Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian,
+    GEOtoECEF<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid,
         _lat, _lon, _h, _xr, _yr, _zr ); // Получены ECEF координаты опорной точки
 
     double cosPhi = std::cos( _lat );
@@ -1053,18 +1075,17 @@ void ENUtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     z = cosPhi * _n + sinPhi * _u + _zr;
 
     // Проверим, нужен ли перевод:
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer ):
-        {
-            x *= 0.001;
-            y *= 0.001;
-            z *= 0.001;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    x = Convert::RangeFromMeter<RU>( x );
+    y = Convert::RangeFromMeter<RU>( y );
+    z = Convert::RangeFromMeter<RU>( z );
+}
+
+void ENUtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double e, double n, double u, double lat, double lon, double h, double &x, double &y, double &z )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        ENUtoECEF<decltype( ru )::value, decltype( au )::value>( ellipsoid, e, n, u, lat, lon, h, x, y, z );
+    } );
 }
 
 XYZ ENUtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
@@ -1076,31 +1097,23 @@ XYZ ENUtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void ENUtoAER( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
-    double xEast, double yNorth, double zUp, double &az, double &elev, double &slantRange )
+template <Units::TRangeUnit RU, Units::TAngleUnit AU, class T>
+static void ENUtoAERImpl( T xEast, T yNorth, T zUp, T &az, T &elev, T &slantRange )
 {
+    static_assert( std::is_same<T, float>::value || std::is_same<T, double>::value, "wrong template class!" );
     // по умолчанию Метры-Радианы:
-    double _xEast = xEast;
-    double _yNorth = yNorth;
-    double _zUp = zUp;
+    T _xEast = xEast;
+    T _yNorth = yNorth;
+    T _zUp = zUp;
 
     // Проверим, нужен ли перевод:
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer ):
-        {
-            _xEast *=  1000.0;
-            _yNorth *= 1000.0;
-            _zUp *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _xEast = Convert::RangeToMeter<RU>( _xEast );
+    _yNorth = Convert::RangeToMeter<RU>( _yNorth );
+    _zUp = Convert::RangeToMeter<RU>( _zUp );
     // Далее в математике используются углы в радианах и дальность в метрах, перевод в нужные единицы у конце
 
 //    r = std::sqrt( ( _xEast * _xEast ) + ( _yNorth * _yNorth ) ); // dangerous
-    double r = std::hypot( _xEast, _yNorth ); // C++11 style
+    T r = std::hypot( _xEast, _yNorth ); // C++11 style
 
 //    slantRange = sqrt( ( r * r ) + ( _zUp * _zUp ) ); // dangerous
     slantRange = std::hypot( r, _zUp ); // C++11 style
@@ -1108,24 +1121,37 @@ void ENUtoAER( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angl
     az = Convert::AngleTo360( std::atan2( _xEast, _yNorth ), Units::TAngleUnit::AU_Radian );
 
     // Проверим, нужен ли перевод:
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer ):
-        {
-            slantRange *= 0.001;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            az *= Convert::RdToDgD;
-            elev *= Convert::RdToDgD;
-        }
-    }
+    slantRange = Convert::RangeFromMeter<RU>( slantRange );
+    az = Convert::AngleFromRad<AU>( az );
+    elev = Convert::AngleFromRad<AU>( elev );
+}
+
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ENUtoAER( double xEast, double yNorth, double zUp, double &az, double &elev, double &slantRange )
+{
+    ENUtoAERImpl<RU, AU>( xEast, yNorth, zUp, az, elev, slantRange );
+}
+
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ENUtoAER( float xEast, float yNorth, float zUp, float &az, float &elev, float &slantRange )
+{
+    ENUtoAERImpl<RU, AU>( xEast, yNorth, zUp, az, elev, slantRange );
+}
+
+void ENUtoAER( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double xEast, double yNorth, double zUp, double &az, double &elev, double &slantRange )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        ENUtoAER<decltype( ru )::value, decltype( au )::value>( xEast, yNorth, zUp, az, elev, slantRange );
+    } );
+}
+
+void ENUtoAER( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    float xEast, float yNorth, float zUp, float &az, float &elev, float &slantRange )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        ENUtoAER<decltype( ru )::value, decltype( au )::value>( xEast, yNorth, zUp, az, elev, slantRange );
+    } );
 }
 
 AER ENUtoAER( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit, const ENU &point )
@@ -1135,55 +1161,57 @@ AER ENUtoAER( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angle
     return AER( a, e, r );
 }
 //----------------------------------------------------------------------------------------------------------------------
-void AERtoENU( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
-    double az, double elev, double slantRange, double &xEast, double &yNorth, double &zUp )
+template <Units::TRangeUnit RU, Units::TAngleUnit AU, class T>
+static void AERtoENUImpl( T az, T elev, T slantRange, T &xEast, T &yNorth, T &zUp )
 {
-    double _az = az;
-    double _elev = elev;
-    double _slantRange = slantRange;
+    static_assert( std::is_same<T, float>::value || std::is_same<T, double>::value, "wrong template class!" );
+    T _az = az;
+    T _elev = elev;
+    T _slantRange = slantRange;
 
     // При необходимости переведем в Радианы-Метры:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            _az *= Convert::DgToRdD;
-            _elev *= Convert::DgToRdD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            _slantRange *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _az = Convert::AngleToRad<AU>( _az );
+    _elev = Convert::AngleToRad<AU>( _elev );
+    _slantRange = Convert::RangeToMeter<RU>( _slantRange );
 
     zUp = _slantRange * std::sin( _elev );
-    double _r = _slantRange * std::cos( _elev );
+    T _r = _slantRange * std::cos( _elev );
     xEast = _r * std::sin( _az );
     yNorth = _r * std::cos( _az );
     // xEast yNorth zUp сейчас в метрах
 
     // Проверим, нужен ли перевод:
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer ):
-        {
-            xEast *= 0.001;
-            yNorth *= 0.001;
-            zUp *= 0.001;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    xEast = Convert::RangeFromMeter<RU>( xEast );
+    yNorth = Convert::RangeFromMeter<RU>( yNorth );
+    zUp = Convert::RangeFromMeter<RU>( zUp );
+}
+
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void AERtoENU( double az, double elev, double slantRange, double &xEast, double &yNorth, double &zUp )
+{
+    AERtoENUImpl<RU, AU>( az, elev, slantRange, xEast, yNorth, zUp );
+}
+
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void AERtoENU( float az, float elev, float slantRange, float &xEast, float &yNorth, float &zUp )
+{
+    AERtoENUImpl<RU, AU>( az, elev, slantRange, xEast, yNorth, zUp );
+}
+
+void AERtoENU( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double az, double elev, double slantRange, double &xEast, double &yNorth, double &zUp )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        AERtoENU<decltype( ru )::value, decltype( au )::value>( az, elev, slantRange, xEast, yNorth, zUp );
+    } );
+}
+
+void AERtoENU( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    float az, float elev, float slantRange, float &xEast, float &yNorth, float &zUp )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        AERtoENU<decltype( ru )::value, decltype( au )::value>( az, elev, slantRange, xEast, yNorth, zUp );
+    } );
 }
 
 ENU AERtoENU( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit, const AER &aer )
@@ -1194,7 +1222,8 @@ ENU AERtoENU( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angle
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void GEOtoENU( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void GEOtoENU( const CEllipsoid &ellipsoid,
     double lat, double lon, double h, double lat0, double lon0, double h0, double &xEast, double &yNorth, double &zUp )
 {
     // по умолчанию Метры-Радианы:
@@ -1206,54 +1235,37 @@ void GEOtoENU( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     double _h0 = h0;
 
     // При необходимости переведем в Радианы-Метры:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            _lat *= Convert::DgToRdD;
-            _lon *= Convert::DgToRdD;
-            _lat0 *= Convert::DgToRdD;
-            _lon0 *= Convert::DgToRdD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            _h *= 1000.0;
-            _h0 *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _lat = Convert::AngleToRad<AU>( _lat );
+    _lon = Convert::AngleToRad<AU>( _lon );
+    _lat0 = Convert::AngleToRad<AU>( _lat0 );
+    _lon0 = Convert::AngleToRad<AU>( _lon0 );
+    _h = Convert::RangeToMeter<RU>( _h );
+    _h0 = Convert::RangeToMeter<RU>( _h0 );
 
     double _x, _y, _z, _x0, _y0, _z0;
-    GEOtoECEF( ellipsoid, Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, _lat, _lon, _h, _x, _y, _z );
-    GEOtoECEF( ellipsoid, Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, _lat0, _lon0, _h0, _x0, _y0, _z0 );
+    GEOtoECEF<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, _lat, _lon, _h, _x, _y, _z );
+    GEOtoECEF<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, _lat0, _lon0, _h0, _x0, _y0, _z0 );
 
     double _dx = _x - _x0;
     double _dy = _y - _y0;
     double _dz = _z - _z0;
 
-    ECEFtoENUV( Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, _dx, _dy, _dz, _lat0, _lon0, xEast, yNorth, zUp );
+    ECEFtoENUV<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( _dx, _dy, _dz, _lat0, _lon0,
+        xEast, yNorth, zUp );
 
     // Проверим, нужен ли перевод:
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer ):
-        {
-            xEast *= 0.001;
-            yNorth *= 0.001;
-            zUp *= 0.001;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    xEast = Convert::RangeFromMeter<RU>( xEast );
+    yNorth = Convert::RangeFromMeter<RU>( yNorth );
+    zUp = Convert::RangeFromMeter<RU>( zUp );
+}
+
+void GEOtoENU( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double lat, double lon, double h, double lat0, double lon0, double h0, double &xEast, double &yNorth, double &zUp )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        GEOtoENU<decltype( ru )::value, decltype( au )::value>( ellipsoid, lat, lon, h, lat0, lon0, h0, xEast, yNorth,
+            zUp );
+    } );
 }
 
 ENU GEOtoENU( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
@@ -1265,7 +1277,8 @@ ENU GEOtoENU( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, c
     return ENU( e, n, u );
 }
 //----------------------------------------------------------------------------------------------------------------------
-void ENUtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ENUtoGEO( const CEllipsoid &ellipsoid,
     double xEast, double yNorth, double zUp, double lat0, double lon0, double h0, double &lat, double &lon, double &h )
 {
     // по умолчанию Метры-Радианы:
@@ -1277,58 +1290,31 @@ void ENUtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     double _h0 = h0;
 
     // При необходимости переведем в Радианы-Метры:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            _lat0 *= Convert::DgToRdD;
-            _lon0 *= Convert::DgToRdD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            _xEast *= 1000.0;
-            _yNorth *= 1000.0;
-            _zUp *= 1000.0;
-            _h0 *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _lat0 = Convert::AngleToRad<AU>( _lat0 );
+    _lon0 = Convert::AngleToRad<AU>( _lon0 );
+    _xEast = Convert::RangeToMeter<RU>( _xEast );
+    _yNorth = Convert::RangeToMeter<RU>( _yNorth );
+    _zUp = Convert::RangeToMeter<RU>( _zUp );
+    _h0 = Convert::RangeToMeter<RU>( _h0 );
 
     double _x, _y, _z;
-    ENUtoECEF( ellipsoid, Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, _xEast, _yNorth, _zUp,
+    ENUtoECEF<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, _xEast, _yNorth, _zUp,
         _lat0, _lon0, _h0, _x, _y, _z );
-    ECEFtoGEO( ellipsoid, Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, _x, _y, _z, lat, lon, h );
+    ECEFtoGEO<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, _x, _y, _z, lat, lon, h );
 
     // Проверим, нужен ли перевод:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            lat *= Convert::RdToDgD;
-            lon *= Convert::RdToDgD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            h *= 0.001;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    lat = Convert::AngleFromRad<AU>( lat );
+    lon = Convert::AngleFromRad<AU>( lon );
+    h = Convert::RangeFromMeter<RU>( h );
+}
+
+void ENUtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double xEast, double yNorth, double zUp, double lat0, double lon0, double h0, double &lat, double &lon, double &h )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        ENUtoGEO<decltype( ru )::value, decltype( au )::value>( ellipsoid, xEast, yNorth, zUp, lat0, lon0, h0, lat,
+            lon, h );
+    } );
 }
 
 Geodetic ENUtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
@@ -1340,7 +1326,8 @@ Geodetic ENUtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUn
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-void GEOtoAER( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void GEOtoAER( const CEllipsoid &ellipsoid,
     double lat1, double lon1, double h1, double lat2, double lon2, double h2, double &az, double &elev, double &slantRange )
 {
     // по умолчанию Метры-Радианы:
@@ -1352,59 +1339,32 @@ void GEOtoAER( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     double _h2 = h2;
 
     // При необходимости переведем в Радианы-Метры:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            _lat1 *= Convert::DgToRdD;
-            _lon1 *= Convert::DgToRdD;
-            _lat2 *= Convert::DgToRdD;
-            _lon2 *= Convert::DgToRdD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            _h1 *= 1000.0;
-            _h2 *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _lat1 = Convert::AngleToRad<AU>( _lat1 );
+    _lon1 = Convert::AngleToRad<AU>( _lon1 );
+    _lat2 = Convert::AngleToRad<AU>( _lat2 );
+    _lon2 = Convert::AngleToRad<AU>( _lon2 );
+    _h1 = Convert::RangeToMeter<RU>( _h1 );
+    _h2 = Convert::RangeToMeter<RU>( _h2 );
     // Далее в математике используются углы в радианах и дальность в метрах, перевод в нужные единицы у конце
 
     double _xEast, _yNorth, _zUp;
-    GEOtoENU( ellipsoid, Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, _lat1, _lon1, _h1, _lat2, _lon2, _h2,
+    GEOtoENU<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, _lat1, _lon1, _h1, _lat2, _lon2, _h2,
         _xEast, _yNorth, _zUp );
-    ENUtoAER( Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, _xEast, _yNorth, _zUp, az, elev, slantRange );
+    ENUtoAER<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( _xEast, _yNorth, _zUp, az, elev, slantRange );
 
     // Проверим, нужен ли перевод:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            az *= Convert::RdToDgD;
-            elev *= Convert::RdToDgD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            slantRange *= 0.001;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    az = Convert::AngleFromRad<AU>( az );
+    elev = Convert::AngleFromRad<AU>( elev );
+    slantRange = Convert::RangeFromMeter<RU>( slantRange );
+}
+
+void GEOtoAER( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double lat1, double lon1, double h1, double lat2, double lon2, double h2, double &az, double &elev, double &slantRange )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        GEOtoAER<decltype( ru )::value, decltype( au )::value>( ellipsoid, lat1, lon1, h1, lat2, lon2, h2, az, elev,
+            slantRange );
+    } );
 }
 
 AER GEOtoAER( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
@@ -1416,8 +1376,9 @@ AER GEOtoAER( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, c
     return AER( a, e, r );
 }
 //----------------------------------------------------------------------------------------------------------------------
-void AERtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
-     double az, double elev, double slantRange, double lat0, double lon0, double h0, double &lat, double &lon, double &h )
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void AERtoGEO( const CEllipsoid &ellipsoid,
+    double az, double elev, double slantRange, double lat0, double lon0, double h0, double &lat, double &lon, double &h )
 {
     // по умолчанию Метры-Радианы:
     double _az = az;
@@ -1428,59 +1389,32 @@ void AERtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     double _h0 = h0;
 
     // При необходимости переведем в Радианы-Метры:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            _az *= Convert::DgToRdD;
-            _elev *= Convert::DgToRdD;
-            _lat0 *= Convert::DgToRdD;
-            _lon0 *= Convert::DgToRdD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            _slantRange *= 1000.0;
-            _h0 *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _az = Convert::AngleToRad<AU>( _az );
+    _elev = Convert::AngleToRad<AU>( _elev );
+    _lat0 = Convert::AngleToRad<AU>( _lat0 );
+    _lon0 = Convert::AngleToRad<AU>( _lon0 );
+    _slantRange = Convert::RangeToMeter<RU>( _slantRange );
+    _h0 = Convert::RangeToMeter<RU>( _h0 );
     // Далее в математике используются углы в радианах и дальность в метрах, перевод в нужные единицы у конце
 
     double _x, _y, _z;
-    AERtoECEF( ellipsoid, Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, _az, _elev, _slantRange,
+    AERtoECEF<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, _az, _elev, _slantRange,
         _lat0, _lon0, _h0, _x, _y, _z );
-    ECEFtoGEO( ellipsoid, Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, _x, _y, _z, lat, lon, h );
+    ECEFtoGEO<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, _x, _y, _z, lat, lon, h );
 
     // Проверим, нужен ли перевод:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            lat *= Convert::RdToDgD;
-            lon *= Convert::RdToDgD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            h *= 0.001;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    lat = Convert::AngleFromRad<AU>( lat );
+    lon = Convert::AngleFromRad<AU>( lon );
+    h = Convert::RangeFromMeter<RU>( h );
+}
+
+void AERtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+     double az, double elev, double slantRange, double lat0, double lon0, double h0, double &lat, double &lon, double &h )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        AERtoGEO<decltype( ru )::value, decltype( au )::value>( ellipsoid, az, elev, slantRange, lat0, lon0, h0, lat,
+            lon, h );
+    } );
 }
 
 Geodetic AERtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
@@ -1491,8 +1425,9 @@ Geodetic AERtoGEO( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUn
     return Geodetic( lat, lon, h );
 }
 //----------------------------------------------------------------------------------------------------------------------
-void AERtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
-     double az, double elev, double slantRange, double lat0, double lon0, double h0, double &x, double &y, double &z )
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void AERtoECEF( const CEllipsoid &ellipsoid,
+    double az, double elev, double slantRange, double lat0, double lon0, double h0, double &x, double &y, double &z )
 {
     // по умолчанию Метры-Радианы:
     double _az = az;
@@ -1503,54 +1438,37 @@ void AERtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     double _h0 = h0;
 
     // При необходимости переведем в Радианы-Метры:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            _az *= Convert::DgToRdD;
-            _elev *= Convert::DgToRdD;
-            _lat0 *= Convert::DgToRdD;
-            _lon0 *= Convert::DgToRdD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            _slantRange *= 1000.0;
-            _h0 *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _az = Convert::AngleToRad<AU>( _az );
+    _elev = Convert::AngleToRad<AU>( _elev );
+    _lat0 = Convert::AngleToRad<AU>( _lat0 );
+    _lon0 = Convert::AngleToRad<AU>( _lon0 );
+    _slantRange = Convert::RangeToMeter<RU>( _slantRange );
+    _h0 = Convert::RangeToMeter<RU>( _h0 );
     // Далее в математике используются углы в радианах и дальность в метрах, перевод в нужные единицы у конце
 
     double _x0, _y0, _z0, _e, _n, _u, _dx, _dy, _dz;
-    GEOtoECEF( ellipsoid, Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, _lat0, _lon0, _h0, _x0, _y0, _z0 );
-    AERtoENU( Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, _az, _elev, _slantRange, _e, _n, _u );
-    ENUtoUVW( ellipsoid, Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, _e, _n, _u, _lat0, _lon0, _dx, _dy, _dz );
+    GEOtoECEF<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, _lat0, _lon0, _h0, _x0, _y0, _z0 );
+    AERtoENU<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( _az, _elev, _slantRange, _e, _n, _u );
+    ENUtoUVW<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, _e, _n, _u, _lat0, _lon0,
+        _dx, _dy, _dz );
     // Origin + offset from origin equals position in ECEF
     x = _x0 + _dx;
     y = _y0 + _dy;
     z = _z0 + _dz;
 
     // Проверим, нужен ли перевод:
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer ):
-        {
-            x *= 0.001;
-            y *= 0.001;
-            z *= 0.001;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    x = Convert::RangeFromMeter<RU>( x );
+    y = Convert::RangeFromMeter<RU>( y );
+    z = Convert::RangeFromMeter<RU>( z );
+}
+
+void AERtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+     double az, double elev, double slantRange, double lat0, double lon0, double h0, double &x, double &y, double &z )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        AERtoECEF<decltype( ru )::value, decltype( au )::value>( ellipsoid, az, elev, slantRange, lat0, lon0, h0, x, y,
+            z );
+    } );
 }
 
 XYZ AERtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
@@ -1561,7 +1479,8 @@ XYZ AERtoECEF( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     return XYZ( x, y, z );
 }
 //----------------------------------------------------------------------------------------------------------------------
-void ECEFtoAER( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ECEFtoAER( const CEllipsoid &ellipsoid,
     double x, double y, double z, double lat0, double lon0, double h0, double &az, double &elev, double &slantRange )
 {
     // по умолчанию Метры-Радианы:
@@ -1573,59 +1492,32 @@ void ECEFtoAER( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
     double _z = z;
 
     // При необходимости переведем в Радианы-Метры:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            _lat0 *= Convert::DgToRdD;
-            _lon0 *= Convert::DgToRdD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            _h0 *= 1000.0;
-            _x *= 1000.0;
-            _y *= 1000.0;
-            _z *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    _lat0 = Convert::AngleToRad<AU>( _lat0 );
+    _lon0 = Convert::AngleToRad<AU>( _lon0 );
+    _h0 = Convert::RangeToMeter<RU>( _h0 );
+    _x = Convert::RangeToMeter<RU>( _x );
+    _y = Convert::RangeToMeter<RU>( _y );
+    _z = Convert::RangeToMeter<RU>( _z );
     // Далее в математике используются углы в радианах и дальность в метрах, перевод в нужные единицы у конце
 
     double _e, _n, _u;
-    ECEFtoENU( ellipsoid, Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, _x, _y, _z, _lat0, _lon0, _h0,
+    ECEFtoENU<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, _x, _y, _z, _lat0, _lon0, _h0,
         _e, _n, _u );
-    ENUtoAER( Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, _e, _n, _u, az, elev, slantRange );
+    ENUtoAER<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( _e, _n, _u, az, elev, slantRange );
 
     // Проверим, нужен ли перевод:
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            az *= Convert::RdToDgD;
-            elev *= Convert::RdToDgD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            slantRange *= 0.001;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    az = Convert::AngleFromRad<AU>( az );
+    elev = Convert::AngleFromRad<AU>( elev );
+    slantRange = Convert::RangeFromMeter<RU>( slantRange );
+}
+
+void ECEFtoAER( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double x, double y, double z, double lat0, double lon0, double h0, double &az, double &elev, double &slantRange )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        ECEFtoAER<decltype( ru )::value, decltype( au )::value>( ellipsoid, x, y, z, lat0, lon0, h0, az, elev,
+            slantRange );
+    } );
 }
 
 AER ECEFtoAER(const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
@@ -1636,57 +1528,62 @@ AER ECEFtoAER(const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, c
     return AER( a, e, r );
 }
 //----------------------------------------------------------------------------------------------------------------------
-void ENUtoUVW( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
-    double xEast, double yNorth, double zUp, double lat0, double lon0, double &u, double &v, double &w )
+template <Units::TRangeUnit RU, Units::TAngleUnit AU, class T>
+static void ENUtoUVWImpl( const CEllipsoid &ellipsoid,
+    T xEast, T yNorth, T zUp, T lat0, T lon0, T &u, T &v, T &w )
 {
-    double _xEast = xEast;
-    double _yNorth = yNorth;
-    double _zUp = zUp;
-    double _lat0 = lat0;
-    double _lon0 = lon0;
-
-    switch( angleUnit ) {
-        case( Units::TAngleUnit::AU_Radian ): break; // Уже переведено
-        case( Units::TAngleUnit::AU_Degree ):
-        {
-            _lat0 *= Convert::DgToRdD;
-            _lon0 *= Convert::DgToRdD;
-            break;
-        }
-        default:
-            assert( false );
-    }
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer):
-        {
-            _xEast *= 1000.0;
-            _yNorth *= 1000.0;
-            _zUp *= 1000.0;
-            break;
-        }
-        default:
-            assert( false );
-    }
-
-    double t = std::cos( _lat0 ) * _zUp - std::sin( _lat0 ) * _yNorth;
+    static_assert( std::is_same<T, float>::value || std::is_same<T, double>::value, "wrong template class!" );
+    T _xEast = xEast;
+    T _yNorth = yNorth;
+    T _zUp = zUp;
+    T _lat0 = lat0;
+    T _lon0 = lon0;
+
+    _lat0 = Convert::AngleToRad<AU>( _lat0 );
+    _lon0 = Convert::AngleToRad<AU>( _lon0 );
+    _xEast = Convert::RangeToMeter<RU>( _xEast );
+    _yNorth = Convert::RangeToMeter<RU>( _yNorth );
+    _zUp = Convert::RangeToMeter<RU>( _zUp );
+
+    T t = std::cos( _lat0 ) * _zUp - std::sin( _lat0 ) * _yNorth;
     w = std::sin( _lat0 ) * _zUp + std::cos( _lat0 ) * _yNorth;
     u = std::cos( _lon0 ) * t - std::sin( _lon0 ) * _xEast;
     v = std::sin( _lon0 ) * t + std::cos( _lon0 ) * _xEast;
 
     // Проверим, нужен ли перевод:
-    switch( rangeUnit ) {
-        case( Units::TRangeUnit::RU_Meter ): break; // Уже переведено
-        case( Units::TRangeUnit::RU_Kilometer ):
-        {
-            w *= 0.001;
-            u *= 0.001;
-            v *= 0.001;
-            break;
-        }
-        default:
-            assert( false );
-    }
+    w = Convert::RangeFromMeter<RU>( w );
+    u = Convert::RangeFromMeter<RU>( u );
+    v = Convert::RangeFromMeter<RU>( v );
+}
+
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ENUtoUVW( const CEllipsoid &ellipsoid,
+    double xEast, double yNorth, double zUp, double lat0, double lon0, double &u, double &v, double &w )
+{
+    ENUtoUVWImpl<RU, AU>( ellipsoid, xEast, yNorth, zUp, lat0, lon0, u, v, w );
+}
+
+template <Units::TRangeUnit RU, Units::TAngleUnit AU>
+void ENUtoUVW( const CEllipsoid &ellipsoid,
+    float xEast, float yNorth, float zUp, float lat0, float lon0, float &u, float &v, float &w )
+{
+    ENUtoUVWImpl<RU, AU>( ellipsoid, xEast, yNorth, zUp, lat0, lon0, u, v, w );
+}
+
+void ENUtoUVW( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double xEast, double yNorth, double zUp, double lat0, double lon0, double &u, double &v, double &w )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        ENUtoUVW<decltype( ru )::value, decltype( au )::value>( ellipsoid, xEast, yNorth, zUp, lat0, lon0, u, v, w );
+    } );
+}
+
+void ENUtoUVW( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    float xEast, float yNorth, float zUp, float lat0, float lon0, float &u, float &v, float &w )
+{
+    DispatchUnits( rangeUnit, angleUnit, [&]( auto ru, auto au ) {
+        ENUtoUVW<decltype( ru )::value, decltype( au )::value>( ellipsoid, xEast, yNorth, zUp, lat0, lon0, u, v, w );
+    } );
 }
 
 UVW ENUtoUVW( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
@@ -1822,6 +1719,26 @@ CShiftECEF_7 GetShiftECEF_7( const TGeodeticDatum &from, const TGeodeticDatum &t
         assert( false );
     }
 }
+
+bool IsShiftECEF_7Defined( const TGeodeticDatum &from, const TGeodeticDatum &to )
+{
+    // Пары СК, для которых GetShiftECEF_7 возвращает параметры (в обе стороны)
+    static const TGeodeticDatum pairs[][2] = {
+        { TGeodeticDatum::GD_SK42, TGeodeticDatum::GD_PZ9011 },
+        { TGeodeticDatum::GD_SK42, TGeodeticDatum::GD_WGS84 },
+        { TGeodeticDatum::GD_SK95, TGeodeticDatum::GD_PZ9011 },
+        { TGeodeticDatum::GD_GSK2011, TGeodeticDatum::GD_PZ9011 },
+        { TGeodeticDatum::GD_PZ9002, TGeodeticDatum::GD_PZ9011 },
+        { TGeodeticDatum::GD_PZ90, TGeodeticDatum::GD_PZ9011 },
+        { TGeodeticDatum::GD_WGS84, TGeodeticDatum::GD_PZ9011 },
+        { TGeodeticDatum::GD_PZ9011, TGeodeticDatum::GD_ITRF2008 } };
+    for( const auto &pair : pairs ) {
+        if( ( ( from == pair[0] ) && ( to == pair[1] ) ) || ( ( from == pair[1] ) && ( to == pair[0] ) ) ) {
+            return true;
+        }
+    }
+    return false;
+}
 //----------------------------------------------------------------------------------------------------------------------
 void ECEFtoECEF_7params( double xs, double ys, double zs, double dx, double dy, double dz,
     double rx, double ry, double rz, double s, double &xt, double &yt, double &zt )
@@ -2176,6 +2093,51 @@ void GaussKrugerToSK42( const Units::TRangeUnit &rangeUnit, const Units::TAngleU
     }
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// Явное инстанцирование специализаций по единицам измерения
+#define SPML_GEODESY_INSTANTIATE( RU, AU ) \
+    template void GEOtoRAD<RU, AU>( const CEllipsoid &, double, double, double, double, \
+        double &, double &, double & ); \
+    template void RADtoGEO<RU, AU>( const CEllipsoid &, double, double, double, double, \
+        double &, double &, double & ); \
+    template void GEOtoECEF<RU, AU>( const CEllipsoid &, double, double, double, double &, double &, double & ); \
+    template void ECEFtoGEO<RU, AU>( const CEllipsoid &, double, double, double, double &, double &, double & ); \
+    template void ECEF_offset<RU, AU>( const CEllipsoid &, double, double, double, double, double, double, \
+        double &, double &, double & ); \
+    template void ECEFtoENU<RU, AU>( const CEllipsoid &, double, double, double, double, double, double, \
+        double &, double &, double & ); \
+    template void ECEFtoENUV<RU, AU>( double, double, double, double, double, double &, double &, double & ); \
+    template void ENUtoECEF<RU, AU>( const CEllipsoid &, double, double, double, double, double, double, \
+        double &, double &, double & ); \
+    template void ENUtoAER<RU, AU>( double, double, double, double &, double &, double & ); \
+    template void AERtoENU<RU, AU>( double, double, double, double &, double &, double & ); \
+    template void GEOtoENU<RU, AU>( const CEllipsoid &, double, double, double, double, double, double, \
+        double &, double &, double & ); \
+    template void ENUtoGEO<RU, AU>( const CEllipsoid &, double, double, double, double, double, double, \
+        double &, double &, double & ); \
+    template void GEOtoAER<RU, AU>( const CEllipsoid &, double, double, double, double, double, double, \
+        double &, double &, double & ); \
+    template void AERtoGEO<RU, AU>( const CEllipsoid &, double, double, double, double, double, double, \
+        double &, double &, double & ); \
+    template void AERtoECEF<RU, AU>( const CEllipsoid &, double, double, double, double, double, double, \
+        double &, double &, double & ); \
+    template void ECEFtoAER<RU, AU>( const CEllipsoid &, double, double, double, double, double, double, \
+        double &, double &, double & ); \
+    template void ENUtoUVW<RU, AU>( const CEllipsoid &, double, double, double, double, double, \
+        double &, double &, double & ); \
+    template void ECEFtoENUV<RU, AU>( float, float, float, float, float, float &, float &, float & ); \
+    template void ENUtoAER<RU, AU>( float, float, float, float &, float &, float & ); \
+    template void AERtoENU<RU, AU>( float, float, float, float &, float &, float & ); \
+    template void ENUtoUVW<RU, AU>( const CEllipsoid &, float, float, float, float, float, \
+        float &, float &, float & );
+
+SPML_GEODESY_INSTANTIATE( Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian )
+SPML_GEODESY_INSTANTIATE( Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Degree )
+SPML_GEODESY_INSTANTIATE( Units::TRangeUnit::RU_Kilometer, Units::TAngleUnit::AU_Radian )
+SPML_GEODESY_INSTANTIATE( Units::TRangeUnit::RU_Kilometer, Units::TAngleUnit::AU_Degree )
+
+#undef SPML_GEODESY_INSTANTIATE
+
 }
 }
 /// \}
@@ -0,0 +1,758 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       geodesy_batch.cpp
+/// \brief      Пакетные (batch) геодезические функции над массивами координат
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#include <geodesy_batch.h>
+#include <batch_kernels.h>
+#include <geodesic.h>
+#include <parallel.h>
+#include <simd_math.h>
+
+// System includes:
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+//----------------------------------------------------------------------------------------------------------------------
+// Параметры эллипсоида для ядер
+static Batch::TKernelEllipsoid KernelEllipsoid( const CEllipsoid &ellipsoid )
+{
+    Batch::TKernelEllipsoid el;
+    el.a = ellipsoid.A();
+    el.b = ellipsoid.B();
+    el.f = ellipsoid.F();
+    el.ep2 = ellipsoid.EccentricitySecondSquared();
+    el.es = ellipsoid.EccentricityFirstSquared();
+    el.olson = ellipsoid.Olson();
+    el.isSphere = Compare::AreEqualAbs( el.a, el.b );
+    return el;
+}
+
+// Множители перевода единиц измерения для ядер
+static Batch::TKernelUnits KernelUnits( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit )
+{
+    Batch::TKernelUnits units;
+    switch( angleUnit ) {
+        case( Units::TAngleUnit::AU_Radian ):
+        {
+            units.angleIn = 1.0;
+            units.angleOut = 1.0;
+            break;
+        }
+        case( Units::TAngleUnit::AU_Degree ):
+        {
+            units.angleIn = Convert::DgToRdD;
+            units.angleOut = Convert::RdToDgD;
+            break;
+        }
+        default:
+            assert( false );
+    }
+    switch( rangeUnit ) {
+        case( Units::TRangeUnit::RU_Meter ):
+        {
+            units.rangeIn = 1.0;
+            units.rangeOut = 1.0;
+            break;
+        }
+        case( Units::TRangeUnit::RU_Kilometer ):
+        {
+            units.rangeIn = 1000.0;
+            units.rangeOut = 0.001;
+            break;
+        }
+        default:
+            assert( false );
+    }
+    return units;
+}
+
+// Величины, зависящие только от начальной точки
+static Batch::TKernelOrigin KernelOrigin( const CEllipsoid &ellipsoid, const Batch::TKernelUnits &units,
+    double lat, double lon )
+{
+    Batch::TKernelOrigin origin;
+    origin.lat = lat * units.angleIn;
+    origin.lon = lon * units.angleIn;
+    origin.sinLat = std::sin( origin.lat );
+    origin.cosLat = std::cos( origin.lat );
+    origin.tanU1 = ellipsoid.OneMinusF() * std::tan( origin.lat );
+    origin.cosU1 = 1.0 / std::sqrt( ( 1.0 + origin.tanU1 * origin.tanU1 ) );
+    origin.sinU1 = origin.tanU1 * origin.cosU1;
+    return origin;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Размер блока матрицы расстояний: данные 512 точек столбцов (3 массива) занимают 12 КБ и остаются в кэше L1
+static const std::size_t MatrixTileRows = 32;
+static const std::size_t MatrixTileCols = 512;
+
+// Точки набора матрицы расстояний: синус и косинус приведенной широты (на сфере - широты), долгота [рад]
+struct TMatrixPoints
+{
+    std::vector<double> sin;
+    std::vector<double> cos;
+    std::vector<double> lon;
+};
+
+static TMatrixPoints MatrixPoints( const Batch::TKernelEllipsoid &el, const Batch::TKernelUnits &units,
+    const double *lat, const double *lon, std::size_t count )
+{
+    TMatrixPoints points;
+    points.sin.resize( count );
+    points.cos.resize( count );
+    points.lon.resize( count );
+    for( std::size_t i = 0; i < count; i++ ) {
+        const double phi = lat[i] * units.angleIn;
+        if( el.isSphere ) {
+            points.sin[i] = std::sin( phi );
+            points.cos[i] = std::cos( phi );
+        } else { // Как в KernelOrigin
+            const double tanU = ( 1.0 - el.f ) * std::tan( phi );
+            points.cos[i] = 1.0 / std::sqrt( ( 1.0 + tanU * tanU ) );
+            points.sin[i] = tanU * points.cos[i];
+        }
+        points.lon[i] = lon[i] * units.angleIn;
+    }
+    return points;
+}
+
+// Блок матрицы: строки [r0, r1), столбцы [c0, c1)
+struct TMatrixTile
+{
+    std::size_t r0, r1, c0, c1;
+};
+
+// Разбиение матрицы на блоки (по строкам блоков), для совпадающих наборов - только блоки верхнего треугольника
+static std::vector<TMatrixTile> MatrixTiles( std::size_t rows, std::size_t cols, bool self )
+{
+    std::vector<TMatrixTile> tiles;
+    for( std::size_t r0 = 0; r0 < rows; r0 += MatrixTileRows ) {
+        const std::size_t r1 = std::min( rows, r0 + MatrixTileRows );
+        // Для совпадающих наборов блок столбцов начинается с блока, содержащего первую строку
+        const std::size_t cStart = self ? ( r0 / MatrixTileCols ) * MatrixTileCols : 0;
+        for( std::size_t c0 = cStart; c0 < cols; c0 += MatrixTileCols ) {
+            tiles.push_back( TMatrixTile{ r0, r1, c0, std::min( cols, c0 + MatrixTileCols ) } );
+        }
+    }
+    return tiles;
+}
+
+// Обратный азимут (азимут в конечной точке +- 180 град) в единицах выхода, для совпадающих точек - 0
+static double ReverseAzimuth( double azEnd, double d, const Batch::TKernelUnits &units )
+{
+    if( d == 0.0 ) {
+        return 0.0;
+    }
+    const double full = Consts::PI_2_D * units.angleOut;
+    const double reverse = azEnd + 0.5 * full;
+    return ( reverse >= full ) ? ( reverse - full ) : reverse;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Ядра местной системы координат для типа значений T
+template <class T>
+static const Batch::TLocalKernels<T> &LocalKernels( const Batch::TKernelTable *kernels );
+
+template <>
+const Batch::TLocalKernels<double> &LocalKernels<double>( const Batch::TKernelTable *kernels )
+{
+    return kernels->Local;
+}
+
+template <>
+const Batch::TLocalKernels<float> &LocalKernels<float>( const Batch::TKernelTable *kernels )
+{
+    return kernels->LocalFloat;
+}
+
+// Пакетный перевод ENU <-> AER: kernel - ядро из таблицы ядер местной системы координат
+template <class T>
+static void LocalBatch( Batch::TLocalKernel<T> Batch::TLocalKernels<T>::*kernel, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const T *in1, const T *in2, const T *in3, std::size_t count,
+    T *out1, T *out2, T *out3, const Execution::Policy &policy )
+{
+    if( count == 0 ) {
+        return;
+    }
+    assert( ( in1 != nullptr ) && ( in2 != nullptr ) && ( in3 != nullptr ) );
+    assert( ( out1 != nullptr ) && ( out2 != nullptr ) && ( out3 != nullptr ) );
+
+    const Batch::TKernelUnits units = KernelUnits( rangeUnit, angleUnit );
+    const Batch::TLocalKernels<T> &local = LocalKernels<T>( Batch::Kernels( policy.Level() ) );
+    const Batch::TLocalKernel<T> func = local.*kernel;
+    Batch::ParallelFor( count, policy, local.width, [&]( std::size_t begin, std::size_t end ) {
+        func( units, in1 + begin, in2 + begin, in3 + begin, end - begin, out1 + begin, out2 + begin, out3 + begin );
+    } );
+}
+
+// Пакетный поворот векторов между осями ECEF и ENU опорной точки (lat0, lon0)
+template <class T>
+static void FrameBatch( Batch::TFrameKernel<T> Batch::TLocalKernels<T>::*kernel, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const T *in1, const T *in2, const T *in3, std::size_t count,
+    double lat0, double lon0,
+    T *out1, T *out2, T *out3, const Execution::Policy &policy )
+{
+    if( count == 0 ) {
+        return;
+    }
+    assert( ( in1 != nullptr ) && ( in2 != nullptr ) && ( in3 != nullptr ) );
+    assert( ( out1 != nullptr ) && ( out2 != nullptr ) && ( out3 != nullptr ) );
+
+    // Поворот - один раз на пакет, в double
+    const Batch::TKernelUnits units = KernelUnits( rangeUnit, angleUnit );
+    Batch::TKernelFrame frame;
+    frame.sinLat = std::sin( lat0 * units.angleIn );
+    frame.cosLat = std::cos( lat0 * units.angleIn );
+    frame.sinLon = std::sin( lon0 * units.angleIn );
+    frame.cosLon = std::cos( lon0 * units.angleIn );
+
+    const Batch::TLocalKernels<T> &local = LocalKernels<T>( Batch::Kernels( policy.Level() ) );
+    const Batch::TFrameKernel<T> func = local.*kernel;
+    Batch::ParallelFor( count, policy, local.width, [&]( std::size_t begin, std::size_t end ) {
+        func( frame, in1 + begin, in2 + begin, in3 + begin, end - begin, out1 + begin, out2 + begin, out3 + begin );
+    } );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void GEOtoRAD_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *latStart, const double *lonStart, const double *latEnd, const double *lonEnd, std::size_t count,
+    double *d, double *az, double *azEnd, SIMD::TSimdLevel simd )
+{
+    GEOtoRAD_Batch( ellipsoid, rangeUnit, angleUnit, latStart, lonStart, latEnd, lonEnd, count, d, az, azEnd,
+        Execution::Policy( simd, 1 ) );
+}
+
+void GEOtoRAD_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *latStart, const double *lonStart, const double *latEnd, const double *lonEnd, std::size_t count,
+    double *d, double *az, double *azEnd, const Execution::Policy &policy )
+{
+    if( count == 0 ) {
+        return;
+    }
+    assert( ( latStart != nullptr ) && ( lonStart != nullptr ) && ( latEnd != nullptr ) && ( lonEnd != nullptr ) );
+    assert( ( d != nullptr ) && ( az != nullptr ) );
+
+    const Batch::TKernelEllipsoid el = KernelEllipsoid( ellipsoid );
+    const Batch::TKernelUnits units = KernelUnits( rangeUnit, angleUnit );
+    const Batch::TKernelTable *kernels = Batch::Kernels( policy.Level() );
+    Batch::ParallelFor( count, policy, kernels->width, [&]( std::size_t begin, std::size_t end ) {
+        kernels->GEOtoRAD( el, units, latStart + begin, lonStart + begin, latEnd + begin, lonEnd + begin,
+            end - begin, d + begin, az + begin, ( azEnd != nullptr ) ? ( azEnd + begin ) : nullptr );
+    } );
+}
+
+void RADtoGEO_Fan( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double latStart, double lonStart, const double *d, const double *az, std::size_t count,
+    double *latEnd, double *lonEnd, double *azEnd, SIMD::TSimdLevel simd, unsigned int threads )
+{
+    RADtoGEO_Fan( ellipsoid, rangeUnit, angleUnit, latStart, lonStart, d, az, count, latEnd, lonEnd, azEnd,
+        Execution::Policy( simd, threads ) );
+}
+
+void RADtoGEO_Fan( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double latStart, double lonStart, const double *d, const double *az, std::size_t count,
+    double *latEnd, double *lonEnd, double *azEnd, const Execution::Policy &policy )
+{
+    if( count == 0 ) {
+        return;
+    }
+    assert( ( d != nullptr ) && ( az != nullptr ) && ( latEnd != nullptr ) && ( lonEnd != nullptr ) );
+
+    const Batch::TKernelEllipsoid el = KernelEllipsoid( ellipsoid );
+    const Batch::TKernelUnits units = KernelUnits( rangeUnit, angleUnit );
+    const Batch::TKernelOrigin origin = KernelOrigin( ellipsoid, units, latStart, lonStart );
+    const Batch::TKernelTable *kernels = Batch::Kernels( policy.Level() );
+    Batch::ParallelFor( count, policy, kernels->width, [&]( std::size_t begin, std::size_t end ) {
+        kernels->RADtoGEOFan( el, units, origin, d + begin, az + begin, end - begin, latEnd + begin, lonEnd + begin,
+            ( azEnd != nullptr ) ? ( azEnd + begin ) : nullptr );
+    } );
+}
+
+void GEOtoRAD_Batch( const CEllipsoid &ellipsoid, TGeodesicMethod method, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *latStart, const double *lonStart, const double *latEnd,
+    const double *lonEnd, std::size_t count, double *d, double *az, double *azEnd, SIMD::TSimdLevel simd,
+    unsigned int threads )
+{
+    GEOtoRAD_Batch( ellipsoid, method, rangeUnit, angleUnit, latStart, lonStart, latEnd, lonEnd, count, d, az, azEnd,
+        Execution::Policy( simd, threads ) );
+}
+
+void GEOtoRAD_Batch( const CEllipsoid &ellipsoid, TGeodesicMethod method, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *latStart, const double *lonStart, const double *latEnd,
+    const double *lonEnd, std::size_t count, double *d, double *az, double *azEnd, const Execution::Policy &policy )
+{
+    if( count == 0 ) {
+        return;
+    }
+    assert( ( latStart != nullptr ) && ( lonStart != nullptr ) && ( latEnd != nullptr ) && ( lonEnd != nullptr ) );
+    assert( ( d != nullptr ) && ( az != nullptr ) );
+
+    switch( method ) {
+        case( TGeodesicMethod::GM_Vincenty ):
+            GEOtoRAD_Batch( ellipsoid, rangeUnit, angleUnit, latStart, lonStart, latEnd, lonEnd, count, d, az, azEnd,
+                policy );
+            break;
+        case( TGeodesicMethod::GM_Karney ):
+        {
+            const CGeodesic geodesic( ellipsoid, rangeUnit, angleUnit );
+            Batch::ParallelFor( count, policy, 1, [&]( std::size_t begin, std::size_t end ) {
+                double dummy;
+                for( std::size_t i = begin; i < end; i++ ) {
+                    geodesic.Inverse( latStart[i], lonStart[i], latEnd[i], lonEnd[i], d[i], az[i],
+                        ( azEnd != nullptr ) ? azEnd[i] : dummy );
+                }
+            } );
+            break;
+        }
+        default:
+            assert( false );
+    }
+}
+
+void RADtoGEO_Fan( const CEllipsoid &ellipsoid, TGeodesicMethod method, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, double latStart, double lonStart, const double *d, const double *az,
+    std::size_t count, double *latEnd, double *lonEnd, double *azEnd, SIMD::TSimdLevel simd, unsigned int threads )
+{
+    RADtoGEO_Fan( ellipsoid, method, rangeUnit, angleUnit, latStart, lonStart, d, az, count, latEnd, lonEnd, azEnd,
+        Execution::Policy( simd, threads ) );
+}
+
+void RADtoGEO_Fan( const CEllipsoid &ellipsoid, TGeodesicMethod method, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, double latStart, double lonStart, const double *d, const double *az,
+    std::size_t count, double *latEnd, double *lonEnd, double *azEnd, const Execution::Policy &policy )
+{
+    switch( method ) {
+        case( TGeodesicMethod::GM_Vincenty ):
+            RADtoGEO_Fan( ellipsoid, rangeUnit, angleUnit, latStart, lonStart, d, az, count, latEnd, lonEnd, azEnd,
+                policy );
+            break;
+        case( TGeodesicMethod::GM_Karney ):
+        {
+            if( count == 0 ) {
+                return;
+            }
+            assert( ( d != nullptr ) && ( az != nullptr ) && ( latEnd != nullptr ) && ( lonEnd != nullptr ) );
+            const CGeodesic geodesic( ellipsoid, rangeUnit, angleUnit );
+            Batch::ParallelFor( count, policy, 1, [&]( std::size_t begin, std::size_t end ) {
+                double dummy;
+                for( std::size_t i = begin; i < end; i++ ) {
+                    geodesic.Direct( latStart, lonStart, d[i], az[i], latEnd[i], lonEnd[i],
+                        ( azEnd != nullptr ) ? azEnd[i] : dummy );
+                }
+            } );
+            break;
+        }
+        default:
+            assert( false );
+    }
+}
+
+void GEOtoRAD_Matrix( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *latRow, const double *lonRow, std::size_t rows, const double *latCol, const double *lonCol,
+    std::size_t cols, double *d, double *az, double *azEnd, SIMD::TSimdLevel simd, unsigned int threads )
+{
+    GEOtoRAD_Matrix( ellipsoid, rangeUnit, angleUnit, latRow, lonRow, rows, latCol, lonCol, cols, d, az, azEnd,
+        Execution::Policy( simd, threads ) );
+}
+
+void GEOtoRAD_Matrix( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *latRow, const double *lonRow, std::size_t rows, const double *latCol, const double *lonCol,
+    std::size_t cols, double *d, double *az, double *azEnd, const Execution::Policy &policy )
+{
+    if( ( rows == 0 ) || ( cols == 0 ) ) {
+        return;
+    }
+    assert( ( latRow != nullptr ) && ( lonRow != nullptr ) && ( latCol != nullptr ) && ( lonCol != nullptr ) );
+    assert( ( d != nullptr ) && ( az != nullptr ) );
+
+    const Batch::TKernelEllipsoid el = KernelEllipsoid( ellipsoid );
+    const Batch::TKernelUnits units = KernelUnits( rangeUnit, angleUnit );
+    const Batch::TKernelTable *kernels = Batch::Kernels( policy.Level() );
+    const bool self = ( latRow == latCol ) && ( lonRow == lonCol ) && ( rows == cols );
+    const TMatrixPoints rowPoints = MatrixPoints( el, units, latRow, lonRow, rows );
+    const TMatrixPoints colPointsOwn = self ? TMatrixPoints() : MatrixPoints( el, units, latCol, lonCol, cols );
+    const TMatrixPoints &colPoints = self ? rowPoints : colPointsOwn;
+    const std::vector<TMatrixTile> tiles = MatrixTiles( rows, cols, self );
+
+    Batch::ParallelFor( tiles.size(), policy, 1, [&]( std::size_t begin, std::size_t end ) {
+        std::vector<double> azEndRow( MatrixTileCols ); // Азимуты в конечных точках для нижнего треугольника
+        for( std::size_t t = begin; t < end; t++ ) {
+            const TMatrixTile &tile = tiles[t];
+            for( std::size_t r = tile.r0; r < tile.r1; r++ ) {
+                std::size_t c0 = tile.c0;
+                if( self && ( r >= tile.c0 ) && ( r < tile.c1 ) ) { // Диагональ
+                    const std::size_t k = r * cols + r;
+                    d[k] = 0.0;
+                    az[k] = 0.0;
+                    if( azEnd != nullptr ) {
+                        azEnd[k] = 0.0;
+                    }
+                    c0 = r + 1;
+                }
+                if( c0 >= tile.c1 ) {
+                    continue;
+                }
+                const std::size_t k0 = r * cols + c0;
+                double *azEndOut = ( azEnd != nullptr ) ? ( azEnd + k0 ) : ( self ? azEndRow.data() : nullptr );
+                kernels->GEOtoRADRow( el, units, rowPoints.sin[r], rowPoints.cos[r], rowPoints.lon[r],
+                    colPoints.sin.data() + c0, colPoints.cos.data() + c0, colPoints.lon.data() + c0, tile.c1 - c0,
+                    d + k0, az + k0, azEndOut );
+                if( self ) { // Нижний треугольник - обратные направления
+                    for( std::size_t c = c0; c < tile.c1; c++ ) {
+                        const std::size_t k = r * cols + c;
+                        const std::size_t kT = c * cols + r;
+                        d[kT] = d[k];
+                        az[kT] = ReverseAzimuth( azEndOut[c - c0], d[k], units );
+                        if( azEnd != nullptr ) {
+                            azEnd[kT] = ReverseAzimuth( az[k], d[k], units );
+                        }
+                    }
+                }
+            }
+        }
+    } );
+}
+
+void GEOtoRAD_MatrixSparse( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *latRow, const double *lonRow, std::size_t rows,
+    const double *latCol, const double *lonCol, std::size_t cols, double maxRange, std::vector<RADMatrixEntry> &entries,
+    SIMD::TSimdLevel simd, unsigned int threads )
+{
+    GEOtoRAD_MatrixSparse( ellipsoid, rangeUnit, angleUnit, latRow, lonRow, rows, latCol, lonCol, cols, maxRange,
+        entries, Execution::Policy( simd, threads ) );
+}
+
+void GEOtoRAD_MatrixSparse( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *latRow, const double *lonRow, std::size_t rows,
+    const double *latCol, const double *lonCol, std::size_t cols, double maxRange, std::vector<RADMatrixEntry> &entries,
+    const Execution::Policy &policy )
+{
+    entries.clear();
+    if( ( rows == 0 ) || ( cols == 0 ) ) {
+        return;
+    }
+    assert( ( latRow != nullptr ) && ( lonRow != nullptr ) && ( latCol != nullptr ) && ( lonCol != nullptr ) );
+
+    const Batch::TKernelEllipsoid el = KernelEllipsoid( ellipsoid );
+    const Batch::TKernelUnits units = KernelUnits( rangeUnit, angleUnit );
+    const Batch::TKernelTable *kernels = Batch::Kernels( policy.Level() );
+    const bool self = ( latRow == latCol ) && ( lonRow == lonCol ) && ( rows == cols );
+    const TMatrixPoints rowPoints = MatrixPoints( el, units, latRow, lonRow, rows );
+    const TMatrixPoints colPointsOwn = self ? TMatrixPoints() : MatrixPoints( el, units, latCol, lonCol, cols );
+    const TMatrixPoints &colPoints = self ? rowPoints : colPointsOwn;
+    const std::vector<TMatrixTile> tiles = MatrixTiles( rows, cols, self );
+
+    // Каждый блок заполняет свой список, списки объединяются после завершения потоков
+    std::vector<std::vector<RADMatrixEntry>> found( tiles.size() );
+    Batch::ParallelFor( tiles.size(), policy, 1, [&]( std::size_t begin, std::size_t end ) {
+        std::vector<double> dRow( MatrixTileCols ), azRow( MatrixTileCols ), azEndRow( MatrixTileCols );
+        for( std::size_t t = begin; t < end; t++ ) {
+            const TMatrixTile &tile = tiles[t];
+            for( std::size_t r = tile.r0; r < tile.r1; r++ ) {
+                const std::size_t c0 = self ? std::max( tile.c0, r + 1 ) : tile.c0;
+                if( c0 >= tile.c1 ) {
+                    continue;
+                }
+                kernels->GEOtoRADRow( el, units, rowPoints.sin[r], rowPoints.cos[r], rowPoints.lon[r],
+                    colPoints.sin.data() + c0, colPoints.cos.data() + c0, colPoints.lon.data() + c0, tile.c1 - c0,
+                    dRow.data(), azRow.data(), azEndRow.data() );
+                for( std::size_t c = c0; c < tile.c1; c++ ) {
+                    const std::size_t k = c - c0;
+                    if( !( dRow[k] <= maxRange ) ) {
+                        continue;
+                    }
+                    found[t].emplace_back( r, c, RAD( dRow[k], azRow[k], azEndRow[k] ) );
+                    if( self ) {
+                        found[t].emplace_back( c, r, RAD( dRow[k], ReverseAzimuth( azEndRow[k], dRow[k], units ),
+                            ReverseAzimuth( azRow[k], dRow[k], units ) ) );
+                    }
+                }
+            }
+        }
+    } );
+
+    std::size_t total = 0;
+    for( const std::vector<RADMatrixEntry> &list : found ) {
+        total += list.size();
+    }
+    entries.reserve( total );
+    for( const std::vector<RADMatrixEntry> &list : found ) {
+        entries.insert( entries.end(), list.begin(), list.end() );
+    }
+    std::sort( entries.begin(), entries.end(), []( const RADMatrixEntry &lhs, const RADMatrixEntry &rhs ) {
+        return ( lhs.Row < rhs.Row ) || ( ( lhs.Row == rhs.Row ) && ( lhs.Col < rhs.Col ) );
+    } );
+}
+
+void ECEFtoGEO_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *x, const double *y, const double *z, std::size_t count, double *lat, double *lon, double *h,
+    SIMD::TSimdLevel simd, unsigned int threads )
+{
+    ECEFtoGEO_Batch( ellipsoid, rangeUnit, angleUnit, x, y, z, count, lat, lon, h, Execution::Policy( simd, threads ) );
+}
+
+void ECEFtoGEO_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *x, const double *y, const double *z, std::size_t count, double *lat, double *lon, double *h,
+    const Execution::Policy &policy )
+{
+    if( count == 0 ) {
+        return;
+    }
+    assert( ( x != nullptr ) && ( y != nullptr ) && ( z != nullptr ) );
+    assert( ( lat != nullptr ) && ( lon != nullptr ) && ( h != nullptr ) );
+
+    const Batch::TKernelEllipsoid el = KernelEllipsoid( ellipsoid );
+    const Batch::TKernelUnits units = KernelUnits( rangeUnit, angleUnit );
+    const Batch::TKernelTable *kernels = Batch::Kernels( policy.Level() );
+    Batch::ParallelFor( count, policy, kernels->width, [&]( std::size_t begin, std::size_t end ) {
+        kernels->ECEFtoGEO( el, units, x + begin, y + begin, z + begin, end - begin, lat + begin, lon + begin,
+            h + begin );
+    } );
+}
+
+void GEOtoECEF_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *lat, const double *lon, const double *h, std::size_t count, double *x, double *y, double *z,
+    SIMD::TSimdLevel simd, unsigned int threads )
+{
+    GEOtoECEF_Batch( ellipsoid, rangeUnit, angleUnit, lat, lon, h, count, x, y, z, Execution::Policy( simd, threads ) );
+}
+
+void GEOtoECEF_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *lat, const double *lon, const double *h, std::size_t count, double *x, double *y, double *z,
+    const Execution::Policy &policy )
+{
+    if( count == 0 ) {
+        return;
+    }
+    assert( ( lat != nullptr ) && ( lon != nullptr ) && ( h != nullptr ) );
+    assert( ( x != nullptr ) && ( y != nullptr ) && ( z != nullptr ) );
+
+    const Batch::TKernelEllipsoid el = KernelEllipsoid( ellipsoid );
+    const Batch::TKernelUnits units = KernelUnits( rangeUnit, angleUnit );
+    const Batch::TKernelTable *kernels = Batch::Kernels( policy.Level() );
+    Batch::ParallelFor( count, policy, kernels->width, [&]( std::size_t begin, std::size_t end ) {
+        kernels->GEOtoECEF( el, units, lat + begin, lon + begin, h + begin, end - begin, x + begin, y + begin,
+            z + begin );
+    } );
+}
+
+void AERtoGEO_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *az, const double *elev, const double *slantRange,
+    std::size_t count, double lat0, double lon0, double h0, double *lat, double *lon, double *h,
+    SIMD::TSimdLevel simd, unsigned int threads )
+{
+    AERtoGEO_Batch( ellipsoid, rangeUnit, angleUnit, az, elev, slantRange, count, lat0, lon0, h0, lat, lon, h,
+        Execution::Policy( simd, threads ) );
+}
+
+void AERtoGEO_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *az, const double *elev, const double *slantRange,
+    std::size_t count, double lat0, double lon0, double h0, double *lat, double *lon, double *h,
+    const Execution::Policy &policy )
+{
+    if( count == 0 ) {
+        return;
+    }
+    assert( ( az != nullptr ) && ( elev != nullptr ) && ( slantRange != nullptr ) );
+    assert( ( lat != nullptr ) && ( lon != nullptr ) && ( h != nullptr ) );
+
+    const Batch::TKernelEllipsoid el = KernelEllipsoid( ellipsoid );
+    const Batch::TKernelUnits units = KernelUnits( rangeUnit, angleUnit );
+    const Batch::TKernelTable *kernels = Batch::Kernels( policy.Level() );
+
+    // Опорная точка: ECEF (в единицах дальности пакета) и поворот ENU -> ECEF - один раз на пакет
+    double x0, y0, z0;
+    GEOtoECEF( ellipsoid, rangeUnit, angleUnit, lat0, lon0, h0, x0, y0, z0 );
+    const double sinPhi = std::sin( lat0 * units.angleIn );
+    const double cosPhi = std::cos( lat0 * units.angleIn );
+    const double sinLambda = std::sin( lon0 * units.angleIn );
+    const double cosLambda = std::cos( lon0 * units.angleIn );
+
+    Batch::ParallelFor( count, policy, kernels->width, [&]( std::size_t begin, std::size_t end ) {
+        // Части по blockSize точек: углы, их sin и cos и ECEF - во временных массивах потока (в кэше)
+        const std::size_t blockSize = 512;
+        static thread_local std::vector<double> scratch;
+        scratch.resize( 9 * blockSize );
+        double *angle = scratch.data();
+        double *sinAz = angle + blockSize;
+        double *cosAz = sinAz + blockSize;
+        double *sinEl = cosAz + blockSize;
+        double *cosEl = sinEl + blockSize;
+        double *x = cosEl + blockSize;
+        double *y = x + blockSize;
+        double *z = y + blockSize;
+        for( std::size_t i = begin; i < end; i += blockSize ) {
+            const std::size_t n = std::min( blockSize, end - i );
+            for( std::size_t k = 0; k < n; k++ ) {
+                angle[k] = az[i + k] * units.angleIn;
+            }
+            SIMD::SinCos( angle, n, sinAz, cosAz, policy.Level() );
+            for( std::size_t k = 0; k < n; k++ ) {
+                angle[k] = elev[i + k] * units.angleIn;
+            }
+            SIMD::SinCos( angle, n, sinEl, cosEl, policy.Level() );
+            for( std::size_t k = 0; k < n; k++ ) {
+                const double u = slantRange[i + k] * sinEl[k];
+                const double r = slantRange[i + k] * cosEl[k];
+                const double e = r * sinAz[k];
+                const double nn = r * cosAz[k];
+                x[k] = -sinLambda * e - sinPhi * cosLambda * nn + cosPhi * cosLambda * u + x0;
+                y[k] = cosLambda * e - sinPhi * sinLambda * nn + cosPhi * sinLambda * u + y0;
+                z[k] = cosPhi * nn + sinPhi * u + z0;
+            }
+            kernels->ECEFtoGEO( el, units, x, y, z, n, lat + i, lon + i, h + i );
+        }
+    } );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void ENUtoAER_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *xEast, const double *yNorth, const double *zUp, std::size_t count,
+    double *az, double *elev, double *slantRange, SIMD::TSimdLevel simd, unsigned int threads )
+{
+    ENUtoAER_Batch( rangeUnit, angleUnit, xEast, yNorth, zUp, count, az, elev, slantRange,
+        Execution::Policy( simd, threads ) );
+}
+
+void ENUtoAER_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *xEast, const double *yNorth, const double *zUp, std::size_t count,
+    double *az, double *elev, double *slantRange, const Execution::Policy &policy )
+{
+    LocalBatch<double>( &Batch::TLocalKernels<double>::ENUtoAER,
+        rangeUnit, angleUnit, xEast, yNorth, zUp, count, az, elev, slantRange, policy );
+}
+
+void ENUtoAER_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *xEast, const float *yNorth, const float *zUp, std::size_t count,
+    float *az, float *elev, float *slantRange, SIMD::TSimdLevel simd, unsigned int threads )
+{
+    ENUtoAER_Batch( rangeUnit, angleUnit, xEast, yNorth, zUp, count, az, elev, slantRange,
+        Execution::Policy( simd, threads ) );
+}
+
+void ENUtoAER_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *xEast, const float *yNorth, const float *zUp, std::size_t count,
+    float *az, float *elev, float *slantRange, const Execution::Policy &policy )
+{
+    LocalBatch<float>( &Batch::TLocalKernels<float>::ENUtoAER,
+        rangeUnit, angleUnit, xEast, yNorth, zUp, count, az, elev, slantRange, policy );
+}
+
+void AERtoENU_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *az, const double *elev, const double *slantRange, std::size_t count,
+    double *xEast, double *yNorth, double *zUp, SIMD::TSimdLevel simd, unsigned int threads )
+{
+    AERtoENU_Batch( rangeUnit, angleUnit, az, elev, slantRange, count, xEast, yNorth, zUp,
+        Execution::Policy( simd, threads ) );
+}
+
+void AERtoENU_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *az, const double *elev, const double *slantRange, std::size_t count,
+    double *xEast, double *yNorth, double *zUp, const Execution::Policy &policy )
+{
+    LocalBatch<double>( &Batch::TLocalKernels<double>::AERtoENU,
+        rangeUnit, angleUnit, az, elev, slantRange, count, xEast, yNorth, zUp, policy );
+}
+
+void AERtoENU_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *az, const float *elev, const float *slantRange, std::size_t count,
+    float *xEast, float *yNorth, float *zUp, SIMD::TSimdLevel simd, unsigned int threads )
+{
+    AERtoENU_Batch( rangeUnit, angleUnit, az, elev, slantRange, count, xEast, yNorth, zUp,
+        Execution::Policy( simd, threads ) );
+}
+
+void AERtoENU_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *az, const float *elev, const float *slantRange, std::size_t count,
+    float *xEast, float *yNorth, float *zUp, const Execution::Policy &policy )
+{
+    LocalBatch<float>( &Batch::TLocalKernels<float>::AERtoENU,
+        rangeUnit, angleUnit, az, elev, slantRange, count, xEast, yNorth, zUp, policy );
+}
+
+void ECEFtoENUV_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *dX, const double *dY, const double *dZ, std::size_t count,
+    double lat0, double lon0,
+    double *xEast, double *yNorth, double *zUp, SIMD::TSimdLevel simd, unsigned int threads )
+{
+    ECEFtoENUV_Batch( rangeUnit, angleUnit, dX, dY, dZ, count, lat0, lon0, xEast, yNorth, zUp,
+        Execution::Policy( simd, threads ) );
+}
+
+void ECEFtoENUV_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *dX, const double *dY, const double *dZ, std::size_t count,
+    double lat0, double lon0,
+    double *xEast, double *yNorth, double *zUp, const Execution::Policy &policy )
+{
+    FrameBatch<double>( &Batch::TLocalKernels<double>::ECEFtoENUV,
+        rangeUnit, angleUnit, dX, dY, dZ, count, lat0, lon0, xEast, yNorth, zUp, policy );
+}
+
+void ECEFtoENUV_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *dX, const float *dY, const float *dZ, std::size_t count,
+    double lat0, double lon0,
+    float *xEast, float *yNorth, float *zUp, SIMD::TSimdLevel simd, unsigned int threads )
+{
+    ECEFtoENUV_Batch( rangeUnit, angleUnit, dX, dY, dZ, count, lat0, lon0, xEast, yNorth, zUp,
+        Execution::Policy( simd, threads ) );
+}
+
+void ECEFtoENUV_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *dX, const float *dY, const float *dZ, std::size_t count,
+    double lat0, double lon0,
+    float *xEast, float *yNorth, float *zUp, const Execution::Policy &policy )
+{
+    FrameBatch<float>( &Batch::TLocalKernels<float>::ECEFtoENUV,
+        rangeUnit, angleUnit, dX, dY, dZ, count, lat0, lon0, xEast, yNorth, zUp, policy );
+}
+
+void ENUtoUVW_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *xEast, const double *yNorth, const double *zUp, std::size_t count,
+    double lat0, double lon0,
+    double *u, double *v, double *w, SIMD::TSimdLevel simd, unsigned int threads )
+{
+    ENUtoUVW_Batch( rangeUnit, angleUnit, xEast, yNorth, zUp, count, lat0, lon0, u, v, w,
+        Execution::Policy( simd, threads ) );
+}
+
+void ENUtoUVW_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const double *xEast, const double *yNorth, const double *zUp, std::size_t count,
+    double lat0, double lon0,
+    double *u, double *v, double *w, const Execution::Policy &policy )
+{
+    FrameBatch<double>( &Batch::TLocalKernels<double>::ENUtoUVW,
+        rangeUnit, angleUnit, xEast, yNorth, zUp, count, lat0, lon0, u, v, w, policy );
+}
+
+void ENUtoUVW_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *xEast, const float *yNorth, const float *zUp, std::size_t count,
+    double lat0, double lon0,
+    float *u, float *v, float *w, SIMD::TSimdLevel simd, unsigned int threads )
+{
+    ENUtoUVW_Batch( rangeUnit, angleUnit, xEast, yNorth, zUp, count, lat0, lon0, u, v, w,
+        Execution::Policy( simd, threads ) );
+}
+
+void ENUtoUVW_Batch( const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    const float *xEast, const float *yNorth, const float *zUp, std::size_t count,
+    double lat0, double lon0,
+    float *u, float *v, float *w, const Execution::Policy &policy )
+{
+    FrameBatch<float>( &Batch::TLocalKernels<float>::ENUtoUVW,
+        rangeUnit, angleUnit, xEast, yNorth, zUp, count, lat0, lon0, u, v, w, policy );
+}
+
+} // end namespace Geodesy
+} // end namespace SPML
+/// \}
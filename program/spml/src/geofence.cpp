@@ -0,0 +1,287 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       geofence.cpp
+/// \brief      Проверка расстояния между точками "не больше R" без полного решения обратной геодезической задачи
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#include <geofence.h>
+#include <geodesy_batch.h>
+#include <parallel.h>
+#include <simd_math.h>
+
+// System includes:
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+//----------------------------------------------------------------------------------------------------------------------
+static const double BoundsTolerance = 1.0e-3; // Запас на погрешность обратной задачи, [м]
+static const std::size_t BoundsBlock = 256;   // Число пар в блоке пакетной проверки (синусы и косинусы на стеке)
+
+static std::atomic<std::uint64_t> withinCalls( 0 );     // Число проверенных пар
+static std::atomic<std::uint64_t> withinResolved( 0 );  // Число пар, решенных по границам
+
+// Множитель перевода входных углов в [рад]
+static double AngleToRadFactor( const Units::TAngleUnit &angleUnit )
+{
+    switch( angleUnit ) {
+        case( Units::TAngleUnit::AU_Radian ):
+            return 1.0;
+        case( Units::TAngleUnit::AU_Degree ):
+            return Convert::DgToRdD;
+        default:
+            assert( false );
+    }
+    return 1.0;
+}
+
+// Множитель перевода входной дальности в [м]
+static double RangeToMeterFactor( const Units::TRangeUnit &rangeUnit )
+{
+    switch( rangeUnit ) {
+        case( Units::TRangeUnit::RU_Meter ):
+            return 1.0;
+        case( Units::TRangeUnit::RU_Kilometer ):
+            return 1000.0;
+        default:
+            assert( false );
+    }
+    return 1.0;
+}
+
+// Границы расстояния, входы в [рад], выходы в [м]
+static void BoundsRad( const CEllipsoid &ellipsoid, double latStart, double lonStart, double latEnd, double lonEnd,
+    double &dMin, double &dMax )
+{
+    const double a = ellipsoid.A();
+    const double b = ellipsoid.B();
+
+    // Приведенные широты (на сфере совпадают с широтами)
+    double sinU1, cosU1, sinU2, cosU2;
+    if( Compare::AreEqualAbs( a, b ) ) {
+        sinU1 = std::sin( latStart );
+        cosU1 = std::cos( latStart );
+        sinU2 = std::sin( latEnd );
+        cosU2 = std::cos( latEnd );
+    } else {
+        const double oneMinusF = ellipsoid.OneMinusF();
+        const double tanU1 = oneMinusF * std::tan( latStart );
+        const double tanU2 = oneMinusF * std::tan( latEnd );
+        cosU1 = 1.0 / std::sqrt( 1.0 + tanU1 * tanU1 );
+        sinU1 = tanU1 * cosU1;
+        cosU2 = 1.0 / std::sqrt( 1.0 + tanU2 * tanU2 );
+        sinU2 = tanU2 * cosU2;
+    }
+    const double L = lonEnd - lonStart;
+    const double sinL = std::sin( L );
+    const double cosL = std::cos( L );
+
+    // Угловое расстояние на вспомогательной сфере (как eq. 14-16 Винсента при lambda = L)
+    const double t = cosU1 * sinU2 - sinU1 * cosU2 * cosL;
+    const double sinSigma = std::sqrt( ( cosU2 * sinL ) * ( cosU2 * sinL ) + t * t );
+    const double cosSigma = sinU1 * sinU2 + cosU1 * cosU2 * cosL;
+    const double sigma = std::atan2( sinSigma, cosSigma );
+
+    // Хорда между точками на поверхности: x = a * cosU * cosL, y = a * cosU * sinL, z = b * sinU
+    const double chord = XYZtoDistance( a * cosU1, 0.0, b * sinU1, a * cosU2 * cosL, a * cosU2 * sinL, b * sinU2 );
+
+    dMin = std::max( chord, b * sigma );
+    dMax = a * sigma;
+}
+
+// Ответ по границам (range, dMin, dMax в [м]); false - границы не разделяют range
+static bool ResolveByBounds( double dMin, double dMax, double range, bool &within )
+{
+    if( dMax + BoundsTolerance <= range ) {
+        within = true;
+        return true;
+    }
+    if( dMin - BoundsTolerance > range ) {
+        within = false;
+        return true;
+    }
+    return false;
+}
+
+// Пороги проверки по границам для пакета: те же границы, что в BoundsRad, но в виде квадратов хорд, чтобы не
+// вычислять угловое расстояние для каждой пары (sigma = 2 * asin( k / 2 ), k - хорда на единичной сфере)
+struct TBoundsThresholds
+{
+    double accept2; // a * sigma + запас <= range, если k^2 <= accept2
+    double reject2; // b * sigma - запас > range, если k^2 > reject2
+    double chord2;  // хорда - запас > range, если квадрат хорды > chord2
+};
+
+static TBoundsThresholds Thresholds( const CEllipsoid &ellipsoid, double range )
+{
+    const double pi = std::acos( -1.0 );
+    const double sigmaAccept = ( range - BoundsTolerance ) / ellipsoid.A();
+    const double sigmaReject = ( range + BoundsTolerance ) / ellipsoid.B();
+    TBoundsThresholds thr;
+    if( sigmaAccept < 0.0 ) {
+        thr.accept2 = -1.0;
+    } else if( sigmaAccept >= pi ) {
+        thr.accept2 = 4.0;
+    } else {
+        const double k = 2.0 * std::sin( sigmaAccept / 2.0 );
+        thr.accept2 = k * k;
+    }
+    if( sigmaReject >= pi ) {
+        thr.reject2 = 4.0;
+    } else {
+        const double k = 2.0 * std::sin( sigmaReject / 2.0 );
+        thr.reject2 = k * k;
+    }
+    thr.chord2 = ( range + BoundsTolerance ) * ( range + BoundsTolerance );
+    return thr;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void GEOtoRADBounds( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double latStart, double lonStart, double latEnd, double lonEnd, double &dMin, double &dMax )
+{
+    const double angleIn = AngleToRadFactor( angleUnit );
+    const double rangeOut = 1.0 / RangeToMeterFactor( rangeUnit );
+    BoundsRad( ellipsoid, latStart * angleIn, lonStart * angleIn, latEnd * angleIn, lonEnd * angleIn, dMin, dMax );
+    dMin *= rangeOut;
+    dMax *= rangeOut;
+}
+
+bool GEOWithinRange( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit,
+    double latStart, double lonStart, double latEnd, double lonEnd, double range, TGeodesicMethod method )
+{
+    const double angleIn = AngleToRadFactor( angleUnit );
+    double dMin, dMax;
+    BoundsRad( ellipsoid, latStart * angleIn, lonStart * angleIn, latEnd * angleIn, lonEnd * angleIn, dMin, dMax );
+    withinCalls.fetch_add( 1, std::memory_order_relaxed );
+    bool within;
+    if( ResolveByBounds( dMin, dMax, range * RangeToMeterFactor( rangeUnit ), within ) ) {
+        withinResolved.fetch_add( 1, std::memory_order_relaxed );
+        return within;
+    }
+    double d, az;
+    GEOtoRAD( ellipsoid, method, rangeUnit, angleUnit, latStart, lonStart, latEnd, lonEnd, d, az );
+    return d <= range;
+}
+
+void GEOWithinRange_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *latStart, const double *lonStart, const double *latEnd,
+    const double *lonEnd, std::size_t count, double range, bool *within, SIMD::TSimdLevel simd, unsigned int threads )
+{
+    GEOWithinRange_Batch( ellipsoid, rangeUnit, angleUnit, latStart, lonStart, latEnd, lonEnd, count, range, within,
+        Execution::Policy( simd, threads ) );
+}
+
+void GEOWithinRange_Batch( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *latStart, const double *lonStart, const double *latEnd,
+    const double *lonEnd, std::size_t count, double range, bool *within, const Execution::Policy &policy )
+{
+    if( count == 0 ) {
+        return;
+    }
+    assert( ( latStart != nullptr ) && ( lonStart != nullptr ) && ( latEnd != nullptr ) && ( lonEnd != nullptr ) );
+    assert( within != nullptr );
+
+    const double angleIn = AngleToRadFactor( angleUnit );
+    const TBoundsThresholds thr = Thresholds( ellipsoid, range * RangeToMeterFactor( rangeUnit ) );
+    const double a = ellipsoid.A();
+    const double b = ellipsoid.B();
+    const double oneMinusF = ellipsoid.OneMinusF();
+    const bool isSphere = Compare::AreEqualAbs( a, b );
+    const SIMD::TSimdLevel simd = policy.Level();
+    Batch::ParallelFor( count, policy, 1, [&]( std::size_t begin, std::size_t end ) {
+        // Пары, не решенные по границам, - в отдельные массивы для GEOtoRAD_Batch
+        std::vector<std::size_t> index;
+        std::vector<double> lat1, lon1, lat2, lon2;
+        double x[BoundsBlock], sin1[BoundsBlock], cos1[BoundsBlock], sin2[BoundsBlock], cos2[BoundsBlock],
+            sinL[BoundsBlock], cosL[BoundsBlock];
+        for( std::size_t block = begin; block < end; block += BoundsBlock ) {
+            const std::size_t n = std::min( BoundsBlock, end - block );
+            for( std::size_t j = 0; j < n; j++ ) {
+                x[j] = latStart[block + j] * angleIn;
+            }
+            SIMD::SinCos( x, n, sin1, cos1, simd );
+            for( std::size_t j = 0; j < n; j++ ) {
+                x[j] = latEnd[block + j] * angleIn;
+            }
+            SIMD::SinCos( x, n, sin2, cos2, simd );
+            for( std::size_t j = 0; j < n; j++ ) {
+                x[j] = ( lonEnd[block + j] - lonStart[block + j] ) * angleIn;
+            }
+            SIMD::SinCos( x, n, sinL, cosL, simd );
+
+            for( std::size_t j = 0; j < n; j++ ) {
+                // Приведенные широты: tanU = ( 1 - f ) * tanB
+                double sinU1 = sin1[j], cosU1 = cos1[j], sinU2 = sin2[j], cosU2 = cos2[j];
+                if( !isSphere ) {
+                    sinU1 *= oneMinusF;
+                    sinU2 *= oneMinusF;
+                    const double n1 = 1.0 / std::sqrt( sinU1 * sinU1 + cosU1 * cosU1 );
+                    const double n2 = 1.0 / std::sqrt( sinU2 * sinU2 + cosU2 * cosU2 );
+                    sinU1 *= n1;
+                    cosU1 *= n1;
+                    sinU2 *= n2;
+                    cosU2 *= n2;
+                }
+                const double dx = cosU1 - cosU2 * cosL[j];
+                const double dy = cosU2 * sinL[j];
+                const double dz = sinU1 - sinU2;
+                const double xy2 = dx * dx + dy * dy;
+                const double unit2 = xy2 + dz * dz;                     // Квадрат хорды на единичной сфере
+                const double chord2 = a * a * xy2 + b * b * dz * dz;    // Квадрат хорды на эллипсоиде
+                const std::size_t i = block + j;
+                if( unit2 <= thr.accept2 ) {
+                    within[i] = true;
+                } else if( ( unit2 > thr.reject2 ) || ( chord2 > thr.chord2 ) ) {
+                    within[i] = false;
+                } else {
+                    index.push_back( i );
+                    lat1.push_back( latStart[i] );
+                    lon1.push_back( lonStart[i] );
+                    lat2.push_back( latEnd[i] );
+                    lon2.push_back( lonEnd[i] );
+                }
+            }
+        }
+        const std::size_t rest = index.size();
+        if( rest > 0 ) {
+            std::vector<double> d( rest ), az( rest );
+            GEOtoRAD_Batch( ellipsoid, rangeUnit, angleUnit, lat1.data(), lon1.data(), lat2.data(), lon2.data(), rest,
+                d.data(), az.data(), nullptr, Execution::Policy( simd, 1 ) );
+            for( std::size_t j = 0; j < rest; j++ ) {
+                within[index[j]] = ( d[j] <= range );
+            }
+        }
+        withinCalls.fetch_add( end - begin, std::memory_order_relaxed );
+        withinResolved.fetch_add( end - begin - rest, std::memory_order_relaxed );
+    } );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+WithinRangeStats GetWithinRangeStats()
+{
+    WithinRangeStats stats;
+    stats.Calls = withinCalls.load( std::memory_order_relaxed );
+    stats.ResolvedByBounds = withinResolved.load( std::memory_order_relaxed );
+    return stats;
+}
+
+void ResetWithinRangeStats()
+{
+    withinCalls.store( 0, std::memory_order_relaxed );
+    withinResolved.store( 0, std::memory_order_relaxed );
+}
+
+} // end namespace Geodesy
+} // end namespace SPML
+/// \}
@@ -0,0 +1,353 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       local_frame.cpp
+/// \brief      Местная топоцентрическая система координат (ENU) с фиксированной опорной точкой
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#include <local_frame.h>
+#include <geodesy_batch.h>
+
+// System includes:
+#include <cassert>
+#include <cmath>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+//----------------------------------------------------------------------------------------------------------------------
+CLocalFrame::CLocalFrame( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, double lat0, double lon0, double h0 ) :
+    ellipsoid( ellipsoid ), rangeUnit( rangeUnit ), angleUnit( angleUnit )
+{
+    switch( angleUnit ) {
+        case( Units::TAngleUnit::AU_Radian ):
+        {
+            angleIn = 1.0;
+            angleOut = 1.0;
+            break;
+        }
+        case( Units::TAngleUnit::AU_Degree ):
+        {
+            angleIn = Convert::DgToRdD;
+            angleOut = Convert::RdToDgD;
+            break;
+        }
+        default:
+            assert( false );
+    }
+    switch( rangeUnit ) {
+        case( Units::TRangeUnit::RU_Meter ):
+        {
+            rangeIn = 1.0;
+            rangeOut = 1.0;
+            break;
+        }
+        case( Units::TRangeUnit::RU_Kilometer ):
+        {
+            rangeIn = 1000.0;
+            rangeOut = 0.001;
+            break;
+        }
+        default:
+            assert( false );
+    }
+
+    this->lat0 = lat0 * angleIn;
+    this->lon0 = lon0 * angleIn;
+    this->h0 = h0 * rangeIn;
+
+    // Величины, зависящие только от опорной точки, вычисляются один раз:
+    GEOtoECEF<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, this->lat0, this->lon0, this->h0,
+        x0, y0, z0 );
+
+    double cosPhi = std::cos( this->lat0 );
+    double sinPhi = std::sin( this->lat0 );
+    double cosLambda = std::cos( this->lon0 );
+    double sinLambda = std::sin( this->lon0 );
+
+    eX = -sinLambda;
+    eY = cosLambda;
+    nX = -sinPhi * cosLambda;
+    nY = -sinPhi * sinLambda;
+    nZ = cosPhi;
+    uX = cosPhi * cosLambda;
+    uY = cosPhi * sinLambda;
+    uZ = sinPhi;
+}
+
+Geodetic CLocalFrame::Anchor() const
+{
+    return Geodetic( lat0 * angleOut, lon0 * angleOut, h0 * rangeOut );
+}
+
+XYZ CLocalFrame::AnchorECEF() const
+{
+    return XYZ( x0 * rangeOut, y0 * rangeOut, z0 * rangeOut );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void CLocalFrame::ToENU( double x, double y, double z, double &xEast, double &yNorth, double &zUp ) const
+{
+    double dx = x - x0;
+    double dy = y - y0;
+    double dz = z - z0;
+
+    // Порядок операций как в ECEFtoENUV
+    double t = ( eY * dx ) + ( -eX * dy );
+    xEast = ( eX * dx ) + ( eY * dy );
+    yNorth = ( -uZ * t ) + ( nZ * dz );
+    zUp = ( nZ * t ) + ( uZ * dz );
+}
+
+void CLocalFrame::FromENU( double xEast, double yNorth, double zUp, double &x, double &y, double &z ) const
+{
+    // Порядок операций как в ENUtoECEF
+    x = eX * xEast + nX * yNorth + uX * zUp + x0;
+    y = eY * xEast + nY * yNorth + uY * zUp + y0;
+    z = nZ * yNorth + uZ * zUp + z0;
+}
+
+void CLocalFrame::ToAER( double xEast, double yNorth, double zUp, double &az, double &elev, double &slantRange )
+{
+    double r = std::hypot( xEast, yNorth );
+    slantRange = std::hypot( r, zUp );
+    elev = std::atan2( zUp, r );
+    az = Convert::AngleTo360( std::atan2( xEast, yNorth ), Units::TAngleUnit::AU_Radian );
+}
+
+void CLocalFrame::FromAER( double az, double elev, double slantRange, double &xEast, double &yNorth, double &zUp )
+{
+    zUp = slantRange * std::sin( elev );
+    double r = slantRange * std::cos( elev );
+    xEast = r * std::sin( az );
+    yNorth = r * std::cos( az );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void CLocalFrame::ECEFtoENU( double x, double y, double z, double &xEast, double &yNorth, double &zUp ) const
+{
+    ToENU( x * rangeIn, y * rangeIn, z * rangeIn, xEast, yNorth, zUp );
+    xEast *= rangeOut;
+    yNorth *= rangeOut;
+    zUp *= rangeOut;
+}
+
+void CLocalFrame::ENUtoECEF( double xEast, double yNorth, double zUp, double &x, double &y, double &z ) const
+{
+    FromENU( xEast * rangeIn, yNorth * rangeIn, zUp * rangeIn, x, y, z );
+    x *= rangeOut;
+    y *= rangeOut;
+    z *= rangeOut;
+}
+
+void CLocalFrame::ENUtoAER( double xEast, double yNorth, double zUp, double &az, double &elev,
+    double &slantRange ) const
+{
+    ToAER( xEast * rangeIn, yNorth * rangeIn, zUp * rangeIn, az, elev, slantRange );
+    az *= angleOut;
+    elev *= angleOut;
+    slantRange *= rangeOut;
+}
+
+void CLocalFrame::AERtoENU( double az, double elev, double slantRange, double &xEast, double &yNorth,
+    double &zUp ) const
+{
+    FromAER( az * angleIn, elev * angleIn, slantRange * rangeIn, xEast, yNorth, zUp );
+    xEast *= rangeOut;
+    yNorth *= rangeOut;
+    zUp *= rangeOut;
+}
+
+void CLocalFrame::ECEFtoAER( double x, double y, double z, double &az, double &elev, double &slantRange ) const
+{
+    double e, n, u;
+    ToENU( x * rangeIn, y * rangeIn, z * rangeIn, e, n, u );
+    ToAER( e, n, u, az, elev, slantRange );
+    az *= angleOut;
+    elev *= angleOut;
+    slantRange *= rangeOut;
+}
+
+void CLocalFrame::AERtoECEF( double az, double elev, double slantRange, double &x, double &y, double &z ) const
+{
+    double e, n, u;
+    FromAER( az * angleIn, elev * angleIn, slantRange * rangeIn, e, n, u );
+    FromENU( e, n, u, x, y, z );
+    x *= rangeOut;
+    y *= rangeOut;
+    z *= rangeOut;
+}
+
+void CLocalFrame::GEOtoENU( double lat, double lon, double h, double &xEast, double &yNorth, double &zUp ) const
+{
+    double x, y, z;
+    GEOtoECEF<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, lat * angleIn, lon * angleIn,
+        h * rangeIn, x, y, z );
+    ToENU( x, y, z, xEast, yNorth, zUp );
+    xEast *= rangeOut;
+    yNorth *= rangeOut;
+    zUp *= rangeOut;
+}
+
+void CLocalFrame::ENUtoGEO( double xEast, double yNorth, double zUp, double &lat, double &lon, double &h ) const
+{
+    double x, y, z;
+    FromENU( xEast * rangeIn, yNorth * rangeIn, zUp * rangeIn, x, y, z );
+    ECEFtoGEO<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, x, y, z, lat, lon, h );
+    lat *= angleOut;
+    lon *= angleOut;
+    h *= rangeOut;
+}
+
+void CLocalFrame::GEOtoAER( double lat, double lon, double h, double &az, double &elev, double &slantRange ) const
+{
+    double x, y, z, e, n, u;
+    GEOtoECEF<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, lat * angleIn, lon * angleIn,
+        h * rangeIn, x, y, z );
+    ToENU( x, y, z, e, n, u );
+    ToAER( e, n, u, az, elev, slantRange );
+    az *= angleOut;
+    elev *= angleOut;
+    slantRange *= rangeOut;
+}
+
+void CLocalFrame::AERtoGEO( double az, double elev, double slantRange, double &lat, double &lon, double &h ) const
+{
+    double x, y, z, e, n, u;
+    FromAER( az * angleIn, elev * angleIn, slantRange * rangeIn, e, n, u );
+    FromENU( e, n, u, x, y, z );
+    ECEFtoGEO<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, x, y, z, lat, lon, h );
+    lat *= angleOut;
+    lon *= angleOut;
+    h *= rangeOut;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Пакетные методы: перевод единиц - умножение на множитель, опорная точка и матрица поворота уже вычислены.
+// Линейные преобразования ECEF <-> ENU векторизуются компилятором
+void CLocalFrame::ECEFtoENU( const double *x, const double *y, const double *z, std::size_t count,
+    double *xEast, double *yNorth, double *zUp ) const
+{
+    for( std::size_t i = 0; i < count; i++ ) {
+        double e, n, u;
+        ToENU( x[i] * rangeIn, y[i] * rangeIn, z[i] * rangeIn, e, n, u );
+        xEast[i] = e * rangeOut;
+        yNorth[i] = n * rangeOut;
+        zUp[i] = u * rangeOut;
+    }
+}
+
+void CLocalFrame::ENUtoECEF( const double *xEast, const double *yNorth, const double *zUp, std::size_t count,
+    double *x, double *y, double *z ) const
+{
+    for( std::size_t i = 0; i < count; i++ ) {
+        double _x, _y, _z;
+        FromENU( xEast[i] * rangeIn, yNorth[i] * rangeIn, zUp[i] * rangeIn, _x, _y, _z );
+        x[i] = _x * rangeOut;
+        y[i] = _y * rangeOut;
+        z[i] = _z * rangeOut;
+    }
+}
+
+void CLocalFrame::ENUtoAER( const double *xEast, const double *yNorth, const double *zUp, std::size_t count,
+    double *az, double *elev, double *slantRange ) const
+{
+    for( std::size_t i = 0; i < count; i++ ) {
+        double a, e, r;
+        ToAER( xEast[i] * rangeIn, yNorth[i] * rangeIn, zUp[i] * rangeIn, a, e, r );
+        az[i] = a * angleOut;
+        elev[i] = e * angleOut;
+        slantRange[i] = r * rangeOut;
+    }
+}
+
+void CLocalFrame::AERtoENU( const double *az, const double *elev, const double *slantRange, std::size_t count,
+    double *xEast, double *yNorth, double *zUp ) const
+{
+    for( std::size_t i = 0; i < count; i++ ) {
+        double e, n, u;
+        FromAER( az[i] * angleIn, elev[i] * angleIn, slantRange[i] * rangeIn, e, n, u );
+        xEast[i] = e * rangeOut;
+        yNorth[i] = n * rangeOut;
+        zUp[i] = u * rangeOut;
+    }
+}
+
+void CLocalFrame::ENUtoAER( const float *xEast, const float *yNorth, const float *zUp, std::size_t count,
+    float *az, float *elev, float *slantRange ) const
+{
+    ENUtoAER_Batch( rangeUnit, angleUnit, xEast, yNorth, zUp, count, az, elev, slantRange );
+}
+
+void CLocalFrame::AERtoENU( const float *az, const float *elev, const float *slantRange, std::size_t count,
+    float *xEast, float *yNorth, float *zUp ) const
+{
+    AERtoENU_Batch( rangeUnit, angleUnit, az, elev, slantRange, count, xEast, yNorth, zUp );
+}
+
+void CLocalFrame::ECEFtoAER( const double *x, const double *y, const double *z, std::size_t count,
+    double *az, double *elev, double *slantRange ) const
+{
+    for( std::size_t i = 0; i < count; i++ ) {
+        double e, n, u, a, el, r;
+        ToENU( x[i] * rangeIn, y[i] * rangeIn, z[i] * rangeIn, e, n, u );
+        ToAER( e, n, u, a, el, r );
+        az[i] = a * angleOut;
+        elev[i] = el * angleOut;
+        slantRange[i] = r * rangeOut;
+    }
+}
+
+void CLocalFrame::AERtoECEF( const double *az, const double *elev, const double *slantRange, std::size_t count,
+    double *x, double *y, double *z ) const
+{
+    for( std::size_t i = 0; i < count; i++ ) {
+        double e, n, u, _x, _y, _z;
+        FromAER( az[i] * angleIn, elev[i] * angleIn, slantRange[i] * rangeIn, e, n, u );
+        FromENU( e, n, u, _x, _y, _z );
+        x[i] = _x * rangeOut;
+        y[i] = _y * rangeOut;
+        z[i] = _z * rangeOut;
+    }
+}
+
+void CLocalFrame::GEOtoENU( const double *lat, const double *lon, const double *h, std::size_t count,
+    double *xEast, double *yNorth, double *zUp ) const
+{
+    for( std::size_t i = 0; i < count; i++ ) {
+        GEOtoENU( lat[i], lon[i], h[i], xEast[i], yNorth[i], zUp[i] );
+    }
+}
+
+void CLocalFrame::ENUtoGEO( const double *xEast, const double *yNorth, const double *zUp, std::size_t count,
+    double *lat, double *lon, double *h ) const
+{
+    for( std::size_t i = 0; i < count; i++ ) {
+        ENUtoGEO( xEast[i], yNorth[i], zUp[i], lat[i], lon[i], h[i] );
+    }
+}
+
+void CLocalFrame::GEOtoAER( const double *lat, const double *lon, const double *h, std::size_t count,
+    double *az, double *elev, double *slantRange ) const
+{
+    for( std::size_t i = 0; i < count; i++ ) {
+        GEOtoAER( lat[i], lon[i], h[i], az[i], elev[i], slantRange[i] );
+    }
+}
+
+void CLocalFrame::AERtoGEO( const double *az, const double *elev, const double *slantRange, std::size_t count,
+    double *lat, double *lon, double *h ) const
+{
+    for( std::size_t i = 0; i < count; i++ ) {
+        AERtoGEO( az[i], elev[i], slantRange[i], lat[i], lon[i], h[i] );
+    }
+}
+
+} // end namespace Geodesy
+} // end namespace SPML
+/// \}
@@ -0,0 +1,65 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       parallel.h
+/// \brief      Разбиение пакета на части для обработки в нескольких потоках (внутренний заголовок)
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_PARALLEL_H
+#define SPML_PARALLEL_H
+
+// System includes:
+#include <algorithm>
+#include <cstddef>
+
+// SPML includes:
+#include <execution.h>
+#include <thread_pool.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Batch /// Ядра пакетных функций (внутреннее)
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Разбиение диапазона [0, count) на части по политике выполнения, границы частей кратны ширине вектора
+/// \details Части выполняются пулом потоков (см. CThreadPool), функция вызывается как func( begin, end ). Без
+/// разбиения (один поток или одна часть) функция вызывается один раз в текущем потоке, пул не используется
+/// \param[in] count  - размер диапазона
+/// \param[in] policy - политика выполнения (число потоков и размер части)
+/// \param[in] width  - кратность границ частей
+/// \param[in] func   - обработчик части
+///
+template <class F>
+void ParallelFor( std::size_t count, const Execution::Policy &policy, int width, F func )
+{
+    if( count == 0 ) {
+        return;
+    }
+    unsigned int threads = policy.MaxThreads();
+    if( threads == 1 ) {
+        func( 0, count );
+        return;
+    }
+    CThreadPool &pool = CThreadPool::Instance();
+    threads = ( threads == 0 ) ? pool.Threads() : std::min( threads, pool.Threads() );
+    const std::size_t W = static_cast<std::size_t>( width );
+    std::size_t chunk = ( policy.Chunk > 0 ) ? policy.Chunk : ( count + threads - 1 ) / threads;
+    chunk = ( ( chunk + W - 1 ) / W ) * W;
+    if( ( threads == 1 ) || ( chunk >= count ) ) {
+        func( 0, count );
+        return;
+    }
+    const std::size_t parts = ( count + chunk - 1 ) / chunk;
+    pool.Run( parts, threads, [&]( std::size_t part ) {
+        func( part * chunk, std::min( count, ( part + 1 ) * chunk ) );
+    } );
+}
+
+} // end namespace Batch
+} // end namespace SPML
+#endif // SPML_PARALLEL_H
+/// \}
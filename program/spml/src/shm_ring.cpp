@@ -0,0 +1,339 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       shm_ring.cpp
+/// \brief      Кольцевой буфер записей в разделяемой памяти POSIX (один писатель, один читатель, без блокировок)
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#include <shm_ring.h>
+#include <geodesy_batch.h>
+
+// System includes:
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Ring /// Кольцевые буферы в разделяемой памяти
+{
+//----------------------------------------------------------------------------------------------------------------------
+// Заголовок буфера: счетчики писателя и читателя - в разных строках кэша, столбцы записей - после заголовка
+struct TRingHeader
+{
+    std::atomic<std::uint64_t> Magic;   // Признак готового буфера (записывается создателем последним)
+    std::uint32_t Fields;               // Число чисел в записи
+    std::uint32_t Reserved;             // Не используется
+    std::uint64_t Capacity;             // Емкость в записях
+    alignas( 64 ) std::atomic<std::uint64_t> Head; // Число записанных записей
+    alignas( 64 ) std::atomic<std::uint64_t> Tail; // Число освобожденных записей
+};
+
+// Счетчики в разделяемой памяти разных процессов должны быть атомарными без блокировок
+static_assert( std::atomic<std::uint64_t>::is_always_lock_free, "lock-free 64-bit atomics are required" );
+
+static const std::uint64_t RingMagic = 0x31474E524C4D5053ull;  // "SPMLRNG1"
+static const std::size_t DataOffset = ( ( sizeof( TRingHeader ) + 63 ) / 64 ) * 64; // Начало столбцов
+
+//----------------------------------------------------------------------------------------------------------------------
+CShmRing::~CShmRing()
+{
+    Close();
+}
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+
+// Имя объекта разделяемой памяти: "/имя" без других символов '/'
+static bool IsValidName( const std::string &name )
+{
+    return ( name.size() > 1 ) && ( name[0] == '/' ) && ( name.find( '/', 1 ) == std::string::npos );
+}
+
+bool CShmRing::Create( const std::string &name, unsigned fields, std::size_t capacity, std::string &error )
+{
+    Close();
+    if( !IsValidName( name ) ) {
+        error = "неверное имя буфера/wrong ring name: " + name;
+        return false;
+    }
+    if( ( fields == 0 ) || ( fields > MaxFields ) || ( capacity == 0 ) || ( capacity > MaxCapacity ) ||
+        ( ( capacity & ( capacity - 1 ) ) != 0 ) ) {
+        error = "неверный размер буфера/wrong ring size";
+        return false;
+    }
+    const int fd = shm_open( name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600 );
+    if( fd < 0 ) {
+        error = "не удалось создать буфер/can't create ring " + name + ": " + std::strerror( errno );
+        return false;
+    }
+    const std::size_t bytes = DataOffset + fields * capacity * sizeof( double );
+    if( ftruncate( fd, static_cast<off_t>( bytes ) ) != 0 ) {
+        error = "не удалось создать буфер/can't create ring " + name + ": " + std::strerror( errno );
+        close( fd );
+        shm_unlink( name.c_str() );
+        return false;
+    }
+    void *mapping = mmap( nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    close( fd );
+    if( mapping == MAP_FAILED ) {
+        error = "не удалось отобразить буфер/can't map ring " + name + ": " + std::strerror( errno );
+        shm_unlink( name.c_str() );
+        return false;
+    }
+
+    // Новый объект заполнен нулями: Head = Tail = 0, готовность - после записи размеров
+    TRingHeader *h = new( mapping ) TRingHeader();
+    h->Fields = fields;
+    h->Capacity = capacity;
+    h->Magic.store( RingMagic, std::memory_order_release );
+
+    this->name = name;
+    owner = true;
+    base = mapping;
+    size = bytes;
+    header = h;
+    data = reinterpret_cast<double *>( static_cast<char *>( mapping ) + DataOffset );
+    this->fields = fields;
+    this->capacity = capacity;
+    head = tailCache = tail = headCache = 0;
+    return true;
+}
+
+bool CShmRing::Open( const std::string &name, std::string &error )
+{
+    Close();
+    if( !IsValidName( name ) ) {
+        error = "неверное имя буфера/wrong ring name: " + name;
+        return false;
+    }
+    const int fd = shm_open( name.c_str(), O_RDWR, 0 );
+    if( fd < 0 ) {
+        error = "не удалось открыть буфер/can't open ring " + name + ": " + std::strerror( errno );
+        return false;
+    }
+    struct stat st;
+    const bool result = ( fstat( fd, &st ) == 0 ) && Map( fd, static_cast<std::size_t>( st.st_size ), error );
+    close( fd );
+    if( result ) {
+        this->name = name;
+        owner = false;
+    } else if( error.empty() ) {
+        error = "не удалось открыть буфер/can't open ring " + name + ": " + std::strerror( errno );
+    }
+    return result;
+}
+
+bool CShmRing::Map( int fd, std::size_t bytes, std::string &error )
+{
+    error.clear();
+    if( bytes < DataOffset ) {
+        error = "буфер не готов/ring is not ready";
+        return false;
+    }
+    void *mapping = mmap( nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    if( mapping == MAP_FAILED ) {
+        return false;
+    }
+    TRingHeader *h = static_cast<TRingHeader *>( mapping );
+    const bool ready = h->Magic.load( std::memory_order_acquire ) == RingMagic;
+    const std::uint64_t c = h->Capacity;
+    if( !ready || ( h->Fields == 0 ) || ( h->Fields > MaxFields ) || ( c == 0 ) || ( c > MaxCapacity ) ||
+        ( ( c & ( c - 1 ) ) != 0 ) || ( bytes != DataOffset + h->Fields * c * sizeof( double ) ) ) {
+        error = ready ? "неверный заголовок буфера/wrong ring header" : "буфер не готов/ring is not ready";
+        munmap( mapping, bytes );
+        return false;
+    }
+    base = mapping;
+    size = bytes;
+    header = h;
+    data = reinterpret_cast<double *>( static_cast<char *>( mapping ) + DataOffset );
+    fields = h->Fields;
+    capacity = static_cast<std::size_t>( c );
+    head = headCache = h->Head.load( std::memory_order_acquire );
+    tail = tailCache = h->Tail.load( std::memory_order_acquire );
+    return true;
+}
+
+void CShmRing::Close()
+{
+    if( base != nullptr ) {
+        munmap( base, size );
+        if( owner ) {
+            shm_unlink( name.c_str() );
+        }
+    }
+    name.clear();
+    owner = false;
+    base = nullptr;
+    size = 0;
+    header = nullptr;
+    data = nullptr;
+    fields = 0;
+    capacity = 0;
+    head = tailCache = tail = headCache = 0;
+}
+
+void CShmRing::Remove( const std::string &name )
+{
+    if( IsValidName( name ) ) {
+        shm_unlink( name.c_str() );
+    }
+}
+
+#else
+
+bool CShmRing::Create( const std::string &, unsigned, std::size_t, std::string &error )
+{
+    error = "разделяемая память POSIX не поддерживается/POSIX shared memory is not supported";
+    return false;
+}
+
+bool CShmRing::Open( const std::string &, std::string &error )
+{
+    error = "разделяемая память POSIX не поддерживается/POSIX shared memory is not supported";
+    return false;
+}
+
+bool CShmRing::Map( int, std::size_t, std::string & )
+{
+    return false;
+}
+
+void CShmRing::Close()
+{
+}
+
+void CShmRing::Remove( const std::string & )
+{
+}
+
+#endif
+
+//----------------------------------------------------------------------------------------------------------------------
+TSpan CShmRing::Reserve( std::size_t count )
+{
+    assert( IsOpen() );
+    std::size_t free = capacity - static_cast<std::size_t>( head - tailCache );
+    if( free < count ) {
+        tailCache = header->Tail.load( std::memory_order_acquire );
+        free = capacity - static_cast<std::size_t>( head - tailCache );
+    }
+    TSpan span;
+    span.Offset = static_cast<std::size_t>( head ) & ( capacity - 1 );
+    span.Count = std::min( { count, free, capacity - span.Offset } );
+    return span;
+}
+
+void CShmRing::Commit( std::size_t count )
+{
+    assert( IsOpen() );
+    assert( count <= capacity - static_cast<std::size_t>( head - tailCache ) );
+    head += count;
+    header->Head.store( head, std::memory_order_release );
+}
+
+std::size_t CShmRing::Push( const double *const *in, std::size_t count )
+{
+    std::size_t done = 0;
+    while( done < count ) {
+        const TSpan span = Reserve( count - done );
+        if( span.Count == 0 ) {
+            break;
+        }
+        for( unsigned f = 0; f < fields; f++ ) {
+            std::memcpy( Column( f ) + span.Offset, in[f] + done, span.Count * sizeof( double ) );
+        }
+        Commit( span.Count );
+        done += span.Count;
+    }
+    return done;
+}
+
+TSpan CShmRing::Peek( std::size_t count )
+{
+    assert( IsOpen() );
+    std::size_t available = static_cast<std::size_t>( headCache - tail );
+    if( available < count ) {
+        headCache = header->Head.load( std::memory_order_acquire );
+        available = static_cast<std::size_t>( headCache - tail );
+    }
+    TSpan span;
+    span.Offset = static_cast<std::size_t>( tail ) & ( capacity - 1 );
+    span.Count = std::min( { count, available, capacity - span.Offset } );
+    return span;
+}
+
+void CShmRing::Release( std::size_t count )
+{
+    assert( IsOpen() );
+    assert( count <= static_cast<std::size_t>( headCache - tail ) );
+    tail += count;
+    header->Tail.store( tail, std::memory_order_release );
+}
+
+std::size_t CShmRing::Pop( double *const *out, std::size_t count )
+{
+    std::size_t done = 0;
+    while( done < count ) {
+        const TSpan span = Peek( count - done );
+        if( span.Count == 0 ) {
+            break;
+        }
+        for( unsigned f = 0; f < fields; f++ ) {
+            std::memcpy( out[f] + done, Column( f ) + span.Offset, span.Count * sizeof( double ) );
+        }
+        Release( span.Count );
+        done += span.Count;
+    }
+    return done;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::size_t DrainAERtoGEO( CShmRing &plots, CShmRing &results, const Geodesy::CEllipsoid &ellipsoid,
+    const Units::TRangeUnit &rangeUnit, const Units::TAngleUnit &angleUnit, double lat0, double lon0, double h0,
+    const Execution::Policy &policy, std::size_t maxCount )
+{
+    assert( plots.IsOpen() && results.IsOpen() );
+    assert( ( plots.Fields() >= 3 ) && ( results.Fields() == plots.Fields() ) );
+
+    std::size_t moved = 0;
+    while( moved < maxCount ) {
+        const TSpan in = plots.Peek( maxCount - moved );
+        if( in.Count == 0 ) {
+            break;
+        }
+        const TSpan out = results.Reserve( in.Count );
+        if( out.Count == 0 ) {
+            break;
+        }
+        const std::size_t n = out.Count;
+        Geodesy::AERtoGEO_Batch( ellipsoid, rangeUnit, angleUnit, plots.Column( 0 ) + in.Offset,
+            plots.Column( 1 ) + in.Offset, plots.Column( 2 ) + in.Offset, n, lat0, lon0, h0,
+            results.Column( 0 ) + out.Offset, results.Column( 1 ) + out.Offset, results.Column( 2 ) + out.Offset,
+            policy );
+        for( unsigned f = 3; f < plots.Fields(); f++ ) {
+            std::memcpy( results.Column( f ) + out.Offset, plots.Column( f ) + in.Offset, n * sizeof( double ) );
+        }
+        results.Commit( n );
+        plots.Release( n );
+        moved += n;
+    }
+    return moved;
+}
+
+} // end namespace Ring
+} // end namespace SPML
+/// \}
@@ -0,0 +1,127 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       simd.cpp
+/// \brief      Уровни векторизации (SIMD) пакетных функций библиотеки СБПМ
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#include <simd.h>
+#include <batch_kernels.h>
+
+// System includes:
+#include <cassert>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace SIMD /// Уровни векторизации пакетных функций
+{
+//----------------------------------------------------------------------------------------------------------------------
+bool IsSupported( TSimdLevel level )
+{
+    switch( level ) {
+        case( TSimdLevel::SL_Auto ):
+        case( TSimdLevel::SL_Scalar ):
+            return true;
+#if defined( __x86_64__ ) || defined( __i386__ )
+        case( TSimdLevel::SL_SSE2 ):
+            return ( Batch::KernelsSSE2() != nullptr ) && __builtin_cpu_supports( "sse2" );
+        case( TSimdLevel::SL_AVX2 ):
+            return ( Batch::KernelsAVX2() != nullptr ) && __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "fma" );
+        case( TSimdLevel::SL_AVX512 ):
+            return ( Batch::KernelsAVX512() != nullptr ) && __builtin_cpu_supports( "avx512f" ) &&
+                __builtin_cpu_supports( "avx512dq" ) && __builtin_cpu_supports( "fma" );
+#endif
+        default:
+            return false;
+    }
+}
+
+TSimdLevel MaxSupportedLevel()
+{
+    static const TSimdLevel maxLevel = []() {
+        for( int level = TSimdLevel::SL_AVX512; level > TSimdLevel::SL_Scalar; level-- ) {
+            if( IsSupported( static_cast<TSimdLevel>( level ) ) ) {
+                return static_cast<TSimdLevel>( level );
+            }
+        }
+        return TSimdLevel::SL_Scalar;
+    }();
+    return maxLevel;
+}
+
+TSimdLevel Resolve( TSimdLevel level )
+{
+    if( level == TSimdLevel::SL_Auto ) {
+        return MaxSupportedLevel();
+    }
+    for( int l = level; l > TSimdLevel::SL_Scalar; l-- ) {
+        if( IsSupported( static_cast<TSimdLevel>( l ) ) ) {
+            return static_cast<TSimdLevel>( l );
+        }
+    }
+    return TSimdLevel::SL_Scalar;
+}
+
+int Width( TSimdLevel level )
+{
+    switch( level ) {
+        case( TSimdLevel::SL_Auto ):
+            return Width( MaxSupportedLevel() );
+        case( TSimdLevel::SL_Scalar ):
+            return 1;
+        case( TSimdLevel::SL_SSE2 ):
+            return 2;
+        case( TSimdLevel::SL_AVX2 ):
+            return 4;
+        case( TSimdLevel::SL_AVX512 ):
+            return 8;
+        default:
+            assert( false );
+    }
+    return 1;
+}
+
+std::string Name( TSimdLevel level )
+{
+    switch( level ) {
+        case( TSimdLevel::SL_Auto ):
+            return "auto";
+        case( TSimdLevel::SL_Scalar ):
+            return "scalar";
+        case( TSimdLevel::SL_SSE2 ):
+            return "sse2";
+        case( TSimdLevel::SL_AVX2 ):
+            return "avx2";
+        case( TSimdLevel::SL_AVX512 ):
+            return "avx512";
+        default:
+            assert( false );
+    }
+    return "";
+}
+
+} // end namespace SIMD
+
+namespace Batch /// Ядра пакетных функций (внутреннее)
+{
+//----------------------------------------------------------------------------------------------------------------------
+const TKernelTable *Kernels( SIMD::TSimdLevel level )
+{
+    switch( SIMD::Resolve( level ) ) {
+        case( SIMD::TSimdLevel::SL_SSE2 ):
+            return KernelsSSE2();
+        case( SIMD::TSimdLevel::SL_AVX2 ):
+            return KernelsAVX2();
+        case( SIMD::TSimdLevel::SL_AVX512 ):
+            return KernelsAVX512();
+        default:
+            return KernelsScalar();
+    }
+}
+
+} // end namespace Batch
+} // end namespace SPML
+/// \}
@@ -0,0 +1,61 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       simd_math.cpp
+/// \brief      Пакетные элементарные функции (sin, cos, tan, atan, atan2, asin, acos) над массивами
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#include <simd_math.h>
+#include <batch_kernels.h>
+
+// System includes:
+#include <cassert>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace SIMD /// Уровни векторизации пакетных функций
+{
+//----------------------------------------------------------------------------------------------------------------------
+bool IsLibmMath()
+{
+#if defined( SPML_LIBM_MATH )
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Evaluate( TMathFunction func, const double *x, std::size_t count, double *out, TSimdLevel level )
+{
+    assert( ( func != MF_SinCos ) && ( func != MF_Atan2 ) );
+    if( count == 0 ) {
+        return;
+    }
+    assert( ( x != nullptr ) && ( out != nullptr ) );
+    Batch::Kernels( level )->Math( func, x, nullptr, count, out, nullptr );
+}
+
+void SinCos( const double *x, std::size_t count, double *s, double *c, TSimdLevel level )
+{
+    if( count == 0 ) {
+        return;
+    }
+    assert( ( x != nullptr ) && ( s != nullptr ) && ( c != nullptr ) );
+    Batch::Kernels( level )->Math( MF_SinCos, x, nullptr, count, s, c );
+}
+
+void Atan2( const double *y, const double *x, std::size_t count, double *out, TSimdLevel level )
+{
+    if( count == 0 ) {
+        return;
+    }
+    assert( ( y != nullptr ) && ( x != nullptr ) && ( out != nullptr ) );
+    Batch::Kernels( level )->Math( MF_Atan2, y, x, count, out, nullptr );
+}
+
+} // end namespace SIMD
+} // end namespace SPML
+/// \}
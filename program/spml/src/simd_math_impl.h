@@ -0,0 +1,318 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       simd_math_impl.h
+/// \brief      Векторные элементарные функции для ядер пакетных функций (внутренний заголовок)
+/// \details    Полиномиальные и рациональные аппроксимации Cephes (S. L. Moshier), записанные без ветвлений
+///             для произвольного векторного типа из simd_vec.h: интервалы приведения аргумента выбираются по маске.
+///             Погрешности приведены в simd_math.h.
+///             \n Для типов значений float определены SinCos, Atan и Atan2 (аппроксимации Cephes одинарной
+///             точности), остальные функции - только для double.
+///             \n Типы VecD1 и VecF1 (уровень SL_Scalar) всегда используют libm. При сборке с SPML_LIBM_MATH все
+///             типы используют libm поэлементно.
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_SIMD_MATH_IMPL_H
+#define SPML_SIMD_MATH_IMPL_H
+
+// System includes:
+#include <cmath>
+
+// SPML includes:
+#include <simd_vec.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace SIMD /// Уровни векторизации пакетных функций
+{
+namespace
+{
+#if defined( SPML_LIBM_MATH )
+//----------------------------------------------------------------------------------------------------------------------
+// Элементарные функции через libm поэлементно
+template <class V> inline V Sin( V x ) { return MapLanes( x, []( double t ) { return std::sin( t ); } ); }
+template <class V> inline V Cos( V x ) { return MapLanes( x, []( double t ) { return std::cos( t ); } ); }
+template <class V> inline void SinCos( V x, V &s, V &c ) { s = Sin( x ); c = Cos( x ); }
+template <class V> inline V Tan( V x ) { return MapLanes( x, []( double t ) { return std::tan( t ); } ); }
+template <class V> inline V Atan( V x ) { return MapLanes( x, []( double t ) { return std::atan( t ); } ); }
+template <class V> inline V Asin( V x ) { return MapLanes( x, []( double t ) { return std::asin( t ); } ); }
+template <class V> inline V Acos( V x ) { return MapLanes( x, []( double t ) { return std::acos( t ); } ); }
+template <class V> inline V Atan2( V y, V x ) { return MapLanes( y, x, []( double a, double b ) { return std::atan2( a, b ); } ); }
+#else
+//----------------------------------------------------------------------------------------------------------------------
+const double PIO4 = 7.85398163397448309616e-1;          // PI/4
+const double PIO2 = 1.57079632679489661923;             // PI/2
+const double PI = 3.14159265358979323846;               // PI
+const double MOREBITS = 6.123233995736765886130e-17;    // PI/2 - PIO2 (младшие разряды)
+
+///
+/// \brief Синус и косинус одного аргумента с общим приведением аргумента
+/// \details Аргумент приводится к [-PI/4, PI/4] вычитанием n * PI/2 (PI/2 - сумма трех констант, Коди-Уэйт),
+///          номер четверти определяет перестановку и знаки sin/cos. Для |x| > 1e8 - поэлементно через libm
+///
+template <class V>
+inline void SinCos( V x, V &s, V &c )
+{
+    typedef typename V::Mask M;
+
+    const double ROUND = 6755399441055744.0; // 1.5 * 2^52: ( t + ROUND ) - ROUND - округление до целого
+    const V n = ( x * 0.63661977236758134308 + ROUND ) - ROUND; // Ближайшее целое к x / ( PI/2 )
+    const V r = ( ( x - n * 1.57079625129699707031e0 ) - n * 7.54978941586159635336e-8 ) -
+        n * 5.39030285815811905290e-15;
+    const V z = r * r;
+    const V sr = r + r * z * ( ( ( ( ( 1.58962301576546568060e-10 * z - 2.50507477628578072866e-8 ) * z +
+        2.75573136213857245213e-6 ) * z - 1.98412698295895385996e-4 ) * z + 8.33333333332211858878e-3 ) * z -
+        1.66666666666666307295e-1 );
+    const V cr = ( 1.0 - 0.5 * z ) + z * z * ( ( ( ( ( -1.13585365213876817300e-11 * z + 2.08757008419747316778e-9 ) * z -
+        2.75573141792967388112e-7 ) * z + 2.48015872888517045348e-5 ) * z - 1.38888888888730564116e-3 ) * z +
+        4.16666666666665929218e-2 );
+
+    // Четверть q = n mod 4 (floor через округление: дробная часть n / 2 и n / 4 известна)
+    const V n2 = ( ( n * 0.5 - 0.25 ) + ROUND ) - ROUND;
+    const V n4 = ( ( n * 0.25 - 0.375 ) + ROUND ) - ROUND;
+    const M odd = Gt( n - 2.0 * n2, V::Set1( 0.5 ) );
+    const V q = n - 4.0 * n4;
+    const V s0 = Select( odd, cr, sr );
+    const V c0 = Select( odd, sr, cr );
+    s = Select( Gt( q, V::Set1( 1.5 ) ), -s0, s0 );
+    c = Select( And( Gt( q, V::Set1( 0.5 ) ), Lt( q, V::Set1( 2.5 ) ) ), -c0, c0 );
+
+    const M big = Gt( Abs( x ), V::Set1( 1.0e8 ) );
+    if( Any( big ) ) {
+        s = Select( big, MapLanes( x, []( double t ) { return std::sin( t ); } ), s );
+        c = Select( big, MapLanes( x, []( double t ) { return std::cos( t ); } ), c );
+    }
+}
+
+template <class V>
+inline V Sin( V x )
+{
+    V s, c;
+    SinCos( x, s, c );
+    return s;
+}
+
+template <class V>
+inline V Cos( V x )
+{
+    V s, c;
+    SinCos( x, s, c );
+    return c;
+}
+
+template <class V>
+inline V Tan( V x )
+{
+    V s, c;
+    SinCos( x, s, c );
+    return s / c;
+}
+
+///
+/// \brief Арктангенс
+/// \details Аргумент приводится к [-0.66, 0.66] выбором по маске из трех интервалов: |x| <= 0.66,
+///          0.66 < |x| <= tan( 3PI/8 ) - через ( |x| - 1 ) / ( |x| + 1 ) и PI/4, |x| > tan( 3PI/8 ) - через -1/|x| и PI/2
+///
+template <class V>
+inline V Atan( V x )
+{
+    typedef typename V::Mask M;
+
+    const double T3P8 = 2.41421356237309504880; // tan( 3PI/8 )
+    const V ax = Abs( x );
+    const M big = Gt( ax, V::Set1( T3P8 ) );
+    const M mid = AndNot( Gt( ax, V::Set1( 0.66 ) ), big );
+    const V zero = V::Set1( 0.0 );
+
+    const V xr = Select( big, -1.0 / ax, Select( mid, ( ax - 1.0 ) / ( ax + 1.0 ), ax ) );
+    const V y0 = Select( big, V::Set1( PIO2 ), Select( mid, V::Set1( PIO4 ), zero ) );
+    const V more = Select( big, V::Set1( MOREBITS ), Select( mid, V::Set1( 0.5 * MOREBITS ), zero ) );
+
+    const V z = xr * xr;
+    const V p = ( ( ( -8.750608600031904122785e-1 * z - 1.615753718733365076637e1 ) * z -
+        7.500855792314704667340e1 ) * z - 1.228866684490136173410e2 ) * z - 6.485021904942025371773e1;
+    const V q = ( ( ( ( z + 2.485846490142306297962e1 ) * z + 1.650270098316988542046e2 ) * z +
+        4.328810604912902668951e2 ) * z + 4.853903996359136964868e2 ) * z + 1.945506571482613964425e2;
+    const V r = y0 + ( ( xr * ( z * p / q ) + xr ) + more );
+    return Select( Lt( x, zero ), -r, r );
+}
+
+///
+/// \brief Арктангенс y / x с учетом квадранта
+/// \details Особые случаи (нули со знаком, x = 0) - как у std::atan2
+///
+template <class V>
+inline V Atan2( V y, V x )
+{
+    const V zero = V::Set1( 0.0 );
+    const V pi = CopySign( V::Set1( PI ), y );
+    const typename V::Mask xNeg = Lt( CopySign( V::Set1( 1.0 ), x ), zero ); // В т.ч. x = -0
+    const V r = Atan( y / x ) + Select( xNeg, pi, zero );
+    // y = 0 и x = 0: y / x не определено
+    return Select( And( Le( Abs( x ), zero ), Le( Abs( y ), zero ) ), Select( xNeg, pi, y ), r );
+}
+
+///
+/// \brief Арксинус для 0 <= a <= 0.625 (рациональная аппроксимация)
+///
+template <class V>
+inline V AsinSmall( V a )
+{
+    const V z = a * a;
+    const V p = ( ( ( ( 4.253011369004428248960e-3 * z - 6.019598008014123785661e-1 ) * z +
+        5.444622390564711410273e0 ) * z - 1.626247967210700244449e1 ) * z + 1.956261983317594739197e1 ) * z -
+        8.198089802484824371615e0;
+    const V q = ( ( ( ( z - 1.474091372988853791896e1 ) * z + 7.049610280856842141659e1 ) * z -
+        1.471791292232726029859e2 ) * z + 1.395105614657485689735e2 ) * z - 4.918853881490881290097e1;
+    return a * ( z * p / q ) + a;
+}
+
+///
+/// \brief Арксинус
+/// \details При |x| > 0.625: asin( |x| ) = PI/2 - 2 * asin( sqrt( ( 1 - |x| ) / 2 ) ) в форме Cephes
+///
+template <class V>
+inline V Asin( V x )
+{
+    const V a = Abs( x );
+    const V zz = 1.0 - a;
+    const V p = zz * ( ( ( ( 2.967721961301243206100e-3 * zz - 5.634242780008963776856e-1 ) * zz +
+        6.968710824104713396794e0 ) * zz - 2.556901049652824852289e1 ) * zz + 2.853665548261061424989e1 ) /
+        ( ( ( ( zz - 2.194779531642920639778e1 ) * zz + 1.470656354026814941758e2 ) * zz -
+        3.838770957603691357202e2 ) * zz + 3.424398657913078477438e2 );
+    const V sq = Sqrt( zz + zz );
+    const V big = ( ( PIO4 - sq ) - ( sq * p - MOREBITS ) ) + PIO4;
+    const V r = Select( Gt( a, V::Set1( 0.625 ) ), big, AsinSmall( a ) );
+    return CopySign( r, x );
+}
+
+///
+/// \brief Арккосинус
+/// \details |x| > 0.5: через asin( sqrt( ( 1 - |x| ) / 2 ) ), иначе PI/2 - asin( x )
+///
+template <class V>
+inline V Acos( V x )
+{
+    const V a = Abs( x );
+    const V t2 = 2.0 * AsinSmall( Sqrt( 0.5 * ( 1.0 - a ) ) );
+    const V tail = Select( Lt( x, V::Set1( 0.0 ) ), PI - t2, t2 );
+    const V mid = ( ( PIO4 - CopySign( AsinSmall( a ), x ) ) + MOREBITS ) + PIO4;
+    return Select( Gt( a, V::Set1( 0.5 ) ), tail, mid );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// Функции для типов значений float (VecF4, VecF8, VecF16): аппроксимации Cephes одинарной точности (sinf, cosf,
+// atanf). Погрешность - 2 ULP float (1.2e-7 относительно)
+
+///
+/// \brief Синус и косинус одного аргумента (float)
+/// \details Приведение к [-PI/4, PI/4] вычитанием n * PI/2 (PI/2 - сумма трех констант float), далее как в SinCos.
+///          Для |x| > 8192 - поэлементно через libm
+///
+template <class V>
+inline void SinCosFloat( V x, V &s, V &c )
+{
+    typedef typename V::Mask M;
+
+    const float ROUND = 12582912.0f; // 1.5 * 2^23: ( t + ROUND ) - ROUND - округление до целого
+    const V n = ( x * 0.63661977236758134308f + ROUND ) - ROUND; // Ближайшее целое к x / ( PI/2 )
+    const V r = ( ( x - n * 1.5703125f ) - n * 4.837512969970703125e-4f ) - n * 7.54978995489188216e-8f;
+    const V z = r * r;
+    const V sr = r + r * z * ( ( -1.9515295891e-4f * z + 8.3321608736e-3f ) * z - 1.6666654611e-1f );
+    const V cr = ( 1.0f - 0.5f * z ) + z * z * ( ( 2.443315711809948e-5f * z - 1.388731625493765e-3f ) * z +
+        4.166664568298827e-2f );
+
+    // Четверть q = n mod 4 - как в SinCos
+    const V n2 = ( ( n * 0.5f - 0.25f ) + ROUND ) - ROUND;
+    const V n4 = ( ( n * 0.25f - 0.375f ) + ROUND ) - ROUND;
+    const M odd = Gt( n - 2.0f * n2, V::Set1( 0.5f ) );
+    const V q = n - 4.0f * n4;
+    const V s0 = Select( odd, cr, sr );
+    const V c0 = Select( odd, sr, cr );
+    s = Select( Gt( q, V::Set1( 1.5f ) ), -s0, s0 );
+    c = Select( And( Gt( q, V::Set1( 0.5f ) ), Lt( q, V::Set1( 2.5f ) ) ), -c0, c0 );
+
+    const M big = Gt( Abs( x ), V::Set1( 8192.0f ) );
+    if( Any( big ) ) {
+        s = Select( big, MapLanes( x, []( float t ) { return std::sin( t ); } ), s );
+        c = Select( big, MapLanes( x, []( float t ) { return std::cos( t ); } ), c );
+    }
+}
+
+///
+/// \brief Арктангенс (float)
+/// \details Аргумент приводится к [-tan( PI/8 ), tan( PI/8 )] выбором по маске из трех интервалов, как в Atan
+///
+template <class V>
+inline V AtanFloat( V x )
+{
+    typedef typename V::Mask M;
+
+    const V ax = Abs( x );
+    const M big = Gt( ax, V::Set1( 2.414213562373095f ) );              // tan( 3PI/8 )
+    const M mid = AndNot( Gt( ax, V::Set1( 0.4142135623730950f ) ), big ); // tan( PI/8 )
+    const V zero = V::Set1( 0.0f );
+
+    const V xr = Select( big, -1.0f / ax, Select( mid, ( ax - 1.0f ) / ( ax + 1.0f ), ax ) );
+    const V y0 = Select( big, V::Set1( static_cast<float>( PIO2 ) ), Select( mid,
+        V::Set1( static_cast<float>( PIO4 ) ), zero ) );
+
+    const V z = xr * xr;
+    const V r = y0 + ( ( ( ( 8.05374449538e-2f * z - 1.38776856032e-1f ) * z + 1.99777106478e-1f ) * z -
+        3.33329491539e-1f ) * z * xr + xr );
+    return Select( Lt( x, zero ), -r, r );
+}
+
+///
+/// \brief Арктангенс y / x с учетом квадранта (float)
+/// \details Особые случаи - как в Atan2
+///
+template <class V>
+inline V Atan2Float( V y, V x )
+{
+    const V zero = V::Set1( 0.0f );
+    const V pi = CopySign( V::Set1( static_cast<float>( PI ) ), y );
+    const typename V::Mask xNeg = Lt( CopySign( V::Set1( 1.0f ), x ), zero );
+    const V r = AtanFloat( y / x ) + Select( xNeg, pi, zero );
+    return Select( And( Le( Abs( x ), zero ), Le( Abs( y ), zero ) ), Select( xNeg, pi, y ), r );
+}
+
+#if defined( __SSE2__ )
+inline void SinCos( VecF4 x, VecF4 &s, VecF4 &c ) { SinCosFloat( x, s, c ); }
+inline VecF4 Atan( VecF4 x ) { return AtanFloat( x ); }
+inline VecF4 Atan2( VecF4 y, VecF4 x ) { return Atan2Float( y, x ); }
+#endif
+#if defined( __AVX2__ )
+inline void SinCos( VecF8 x, VecF8 &s, VecF8 &c ) { SinCosFloat( x, s, c ); }
+inline VecF8 Atan( VecF8 x ) { return AtanFloat( x ); }
+inline VecF8 Atan2( VecF8 y, VecF8 x ) { return Atan2Float( y, x ); }
+#endif
+#if defined( __AVX512F__ )
+inline void SinCos( VecF16 x, VecF16 &s, VecF16 &c ) { SinCosFloat( x, s, c ); }
+inline VecF16 Atan( VecF16 x ) { return AtanFloat( x ); }
+inline VecF16 Atan2( VecF16 y, VecF16 x ) { return Atan2Float( y, x ); }
+#endif
+#endif // SPML_LIBM_MATH
+
+//----------------------------------------------------------------------------------------------------------------------
+// Уровень SL_Scalar - всегда libm
+inline VecD1 Sin( VecD1 x ) { return VecD1{ std::sin( x.v ) }; }
+inline VecD1 Cos( VecD1 x ) { return VecD1{ std::cos( x.v ) }; }
+inline void SinCos( VecD1 x, VecD1 &s, VecD1 &c ) { s.v = std::sin( x.v ); c.v = std::cos( x.v ); }
+inline VecD1 Tan( VecD1 x ) { return VecD1{ std::tan( x.v ) }; }
+inline VecD1 Atan( VecD1 x ) { return VecD1{ std::atan( x.v ) }; }
+inline VecD1 Asin( VecD1 x ) { return VecD1{ std::asin( x.v ) }; }
+inline VecD1 Acos( VecD1 x ) { return VecD1{ std::acos( x.v ) }; }
+inline VecD1 Atan2( VecD1 y, VecD1 x ) { return VecD1{ std::atan2( y.v, x.v ) }; }
+inline void SinCos( VecF1 x, VecF1 &s, VecF1 &c ) { s.v = std::sin( x.v ); c.v = std::cos( x.v ); }
+inline VecF1 Atan( VecF1 x ) { return VecF1{ std::atan( x.v ) }; }
+inline VecF1 Atan2( VecF1 y, VecF1 x ) { return VecF1{ std::atan2( y.v, x.v ) }; }
+
+} // end anonymous namespace
+} // end namespace SIMD
+} // end namespace SPML
+#endif // SPML_SIMD_MATH_IMPL_H
+/// \}
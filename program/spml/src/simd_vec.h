@@ -0,0 +1,522 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       simd_vec.h
+/// \brief      Внутренние векторные типы для пакетных функций (обертки над SSE2/AVX2/AVX-512)
+/// \details    Только для внутреннего использования в библиотеке. Типы, требующие набор инструкций,
+///             доступны лишь в единицах трансляции, собранных с соответствующими ключами компилятора.
+///             Каждый тип предоставляет одинаковый набор операций, что позволяет писать ядра вычислений
+///             один раз в виде шаблонов. Типы значений double (VecD1, VecSSE2, VecAVX2, VecAVX512) и float
+///             (VecF1, VecF4, VecF8, VecF16) одного набора инструкций занимают регистры одного размера:
+///             тип float обрабатывает вдвое больше значений за раз. V::Scalar - тип значения.
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_SIMD_VEC_H
+#define SPML_SIMD_VEC_H
+
+// System includes:
+#include <cmath>
+#include <cstddef>
+
+#if defined( __SSE2__ ) || defined( __AVX2__ ) || defined( __AVX512F__ )
+#include <immintrin.h>
+#endif
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace SIMD /// Уровни векторизации пакетных функций
+{
+// Внутреннее связывание: единицы трансляции с разными ключами (-mavx2, -mavx512f) получают собственные копии
+// функций, и компоновщик не подменит SSE2-версию на AVX-версию
+namespace
+{
+//----------------------------------------------------------------------------------------------------------------------
+// Поэлементное применение скалярной функции (через libm) для любого векторного типа
+template <class V, class F>
+inline V MapLanes( V x, F f )
+{
+    alignas( 64 ) typename V::Scalar t[V::Width];
+    Store( t, x );
+    for( int i = 0; i < V::Width; i++ ) {
+        t[i] = f( t[i] );
+    }
+    return V::Load( t );
+}
+
+template <class V, class F>
+inline V MapLanes( V y, V x, F f )
+{
+    alignas( 64 ) typename V::Scalar ty[V::Width];
+    alignas( 64 ) typename V::Scalar tx[V::Width];
+    Store( ty, y );
+    Store( tx, x );
+    for( int i = 0; i < V::Width; i++ ) {
+        ty[i] = f( ty[i], tx[i] );
+    }
+    return V::Load( ty );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Скалярный "вектор" из одного значения double
+///
+struct VecD1
+{
+    typedef double Scalar;
+    static constexpr int Width = 1;
+    static constexpr int RSqrtSteps = 0; ///< Число итераций Ньютона после RSqrtEstimate
+    typedef bool Mask;
+    double v;
+
+    static VecD1 Load( const double *p ) { return VecD1{ *p }; }
+    static VecD1 Set1( double x ) { return VecD1{ x }; }
+};
+
+inline void Store( double *p, VecD1 a ) { *p = a.v; }
+inline void StoreStream( double *p, VecD1 a ) { *p = a.v; }
+inline VecD1 RSqrtEstimate( VecD1 a ) { return VecD1{ 1.0 / std::sqrt( a.v ) }; }
+inline VecD1 operator+( VecD1 a, VecD1 b ) { return VecD1{ a.v + b.v }; }
+inline VecD1 operator-( VecD1 a, VecD1 b ) { return VecD1{ a.v - b.v }; }
+inline VecD1 operator*( VecD1 a, VecD1 b ) { return VecD1{ a.v * b.v }; }
+inline VecD1 operator/( VecD1 a, VecD1 b ) { return VecD1{ a.v / b.v }; }
+inline VecD1 operator-( VecD1 a ) { return VecD1{ -a.v }; }
+inline VecD1 Sqrt( VecD1 a ) { return VecD1{ std::sqrt( a.v ) }; }
+inline VecD1 Abs( VecD1 a ) { return VecD1{ std::abs( a.v ) }; }
+inline VecD1 CopySign( VecD1 a, VecD1 b ) { return VecD1{ std::copysign( a.v, b.v ) }; }
+inline VecD1 Min( VecD1 a, VecD1 b ) { return VecD1{ ( b.v < a.v ) ? b.v : a.v }; }
+inline VecD1 Max( VecD1 a, VecD1 b ) { return VecD1{ ( a.v < b.v ) ? b.v : a.v }; }
+inline bool Gt( VecD1 a, VecD1 b ) { return a.v > b.v; }
+inline bool Ge( VecD1 a, VecD1 b ) { return a.v >= b.v; }
+inline bool Lt( VecD1 a, VecD1 b ) { return a.v < b.v; }
+inline bool Le( VecD1 a, VecD1 b ) { return a.v <= b.v; }
+inline bool IsNan( VecD1 a ) { return std::isnan( a.v ); }
+inline bool And( bool a, bool b ) { return a && b; }
+inline bool Or( bool a, bool b ) { return a || b; }
+inline bool AndNot( bool a, bool b ) { return a && !b; }
+inline bool Any( bool m ) { return m; }
+inline bool All( bool m ) { return m; }
+inline bool MaskTrue( VecD1 ) { return true; }
+inline bool MaskFalse( VecD1 ) { return false; }
+inline VecD1 Select( bool m, VecD1 a, VecD1 b ) { return m ? a : b; }
+
+///
+/// \brief Скалярный "вектор" из одного значения float
+///
+struct VecF1
+{
+    typedef float Scalar;
+    static constexpr int Width = 1;
+    static constexpr int RSqrtSteps = 0; ///< Число итераций Ньютона после RSqrtEstimate
+    typedef bool Mask;
+    float v;
+
+    static VecF1 Load( const float *p ) { return VecF1{ *p }; }
+    static VecF1 Set1( float x ) { return VecF1{ x }; }
+};
+
+inline void Store( float *p, VecF1 a ) { *p = a.v; }
+inline void StoreStream( float *p, VecF1 a ) { *p = a.v; }
+inline VecF1 RSqrtEstimate( VecF1 a ) { return VecF1{ 1.0f / std::sqrt( a.v ) }; }
+inline VecF1 operator+( VecF1 a, VecF1 b ) { return VecF1{ a.v + b.v }; }
+inline VecF1 operator-( VecF1 a, VecF1 b ) { return VecF1{ a.v - b.v }; }
+inline VecF1 operator*( VecF1 a, VecF1 b ) { return VecF1{ a.v * b.v }; }
+inline VecF1 operator/( VecF1 a, VecF1 b ) { return VecF1{ a.v / b.v }; }
+inline VecF1 operator-( VecF1 a ) { return VecF1{ -a.v }; }
+inline VecF1 Sqrt( VecF1 a ) { return VecF1{ std::sqrt( a.v ) }; }
+inline VecF1 Abs( VecF1 a ) { return VecF1{ std::abs( a.v ) }; }
+inline VecF1 CopySign( VecF1 a, VecF1 b ) { return VecF1{ std::copysign( a.v, b.v ) }; }
+inline VecF1 Min( VecF1 a, VecF1 b ) { return VecF1{ ( b.v < a.v ) ? b.v : a.v }; }
+inline VecF1 Max( VecF1 a, VecF1 b ) { return VecF1{ ( a.v < b.v ) ? b.v : a.v }; }
+inline bool Gt( VecF1 a, VecF1 b ) { return a.v > b.v; }
+inline bool Ge( VecF1 a, VecF1 b ) { return a.v >= b.v; }
+inline bool Lt( VecF1 a, VecF1 b ) { return a.v < b.v; }
+inline bool Le( VecF1 a, VecF1 b ) { return a.v <= b.v; }
+inline bool IsNan( VecF1 a ) { return std::isnan( a.v ); }
+inline bool MaskTrue( VecF1 ) { return true; }
+inline bool MaskFalse( VecF1 ) { return false; }
+inline VecF1 Select( bool m, VecF1 a, VecF1 b ) { return m ? a : b; }
+
+#if defined( __SSE2__ )
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Маска сравнения SSE2
+///
+struct MaskSSE2
+{
+    __m128d m;
+};
+
+///
+/// \brief Вектор из двух значений double (SSE2)
+///
+struct VecSSE2
+{
+    typedef double Scalar;
+    static constexpr int Width = 2;
+    static constexpr int RSqrtSteps = 3; ///< Оценка 12 бит (float)
+    typedef MaskSSE2 Mask;
+    __m128d v;
+
+    static VecSSE2 Load( const double *p ) { return VecSSE2{ _mm_loadu_pd( p ) }; }
+    static VecSSE2 Set1( double x ) { return VecSSE2{ _mm_set1_pd( x ) }; }
+};
+
+inline void Store( double *p, VecSSE2 a ) { _mm_storeu_pd( p, a.v ); }
+inline void StoreStream( double *p, VecSSE2 a ) { _mm_stream_pd( p, a.v ); }
+inline VecSSE2 RSqrtEstimate( VecSSE2 a ) { return VecSSE2{ _mm_cvtps_pd( _mm_rsqrt_ps( _mm_cvtpd_ps( a.v ) ) ) }; }
+inline VecSSE2 operator+( VecSSE2 a, VecSSE2 b ) { return VecSSE2{ _mm_add_pd( a.v, b.v ) }; }
+inline VecSSE2 operator-( VecSSE2 a, VecSSE2 b ) { return VecSSE2{ _mm_sub_pd( a.v, b.v ) }; }
+inline VecSSE2 operator*( VecSSE2 a, VecSSE2 b ) { return VecSSE2{ _mm_mul_pd( a.v, b.v ) }; }
+inline VecSSE2 operator/( VecSSE2 a, VecSSE2 b ) { return VecSSE2{ _mm_div_pd( a.v, b.v ) }; }
+inline VecSSE2 operator-( VecSSE2 a ) { return VecSSE2{ _mm_xor_pd( a.v, _mm_set1_pd( -0.0 ) ) }; }
+inline VecSSE2 Sqrt( VecSSE2 a ) { return VecSSE2{ _mm_sqrt_pd( a.v ) }; }
+inline VecSSE2 Abs( VecSSE2 a ) { return VecSSE2{ _mm_andnot_pd( _mm_set1_pd( -0.0 ), a.v ) }; }
+inline VecSSE2 CopySign( VecSSE2 a, VecSSE2 b )
+{
+    const __m128d sign = _mm_set1_pd( -0.0 );
+    return VecSSE2{ _mm_or_pd( _mm_andnot_pd( sign, a.v ), _mm_and_pd( sign, b.v ) ) };
+}
+inline VecSSE2 Min( VecSSE2 a, VecSSE2 b ) { return VecSSE2{ _mm_min_pd( a.v, b.v ) }; }
+inline VecSSE2 Max( VecSSE2 a, VecSSE2 b ) { return VecSSE2{ _mm_max_pd( a.v, b.v ) }; }
+inline MaskSSE2 Gt( VecSSE2 a, VecSSE2 b ) { return MaskSSE2{ _mm_cmpgt_pd( a.v, b.v ) }; }
+inline MaskSSE2 Ge( VecSSE2 a, VecSSE2 b ) { return MaskSSE2{ _mm_cmpge_pd( a.v, b.v ) }; }
+inline MaskSSE2 Lt( VecSSE2 a, VecSSE2 b ) { return MaskSSE2{ _mm_cmplt_pd( a.v, b.v ) }; }
+inline MaskSSE2 Le( VecSSE2 a, VecSSE2 b ) { return MaskSSE2{ _mm_cmple_pd( a.v, b.v ) }; }
+inline MaskSSE2 IsNan( VecSSE2 a ) { return MaskSSE2{ _mm_cmpunord_pd( a.v, a.v ) }; }
+inline MaskSSE2 And( MaskSSE2 a, MaskSSE2 b ) { return MaskSSE2{ _mm_and_pd( a.m, b.m ) }; }
+inline MaskSSE2 Or( MaskSSE2 a, MaskSSE2 b ) { return MaskSSE2{ _mm_or_pd( a.m, b.m ) }; }
+inline MaskSSE2 AndNot( MaskSSE2 a, MaskSSE2 b ) { return MaskSSE2{ _mm_andnot_pd( b.m, a.m ) }; }
+inline bool Any( MaskSSE2 m ) { return _mm_movemask_pd( m.m ) != 0; }
+inline bool All( MaskSSE2 m ) { return _mm_movemask_pd( m.m ) == 0x3; }
+inline MaskSSE2 MaskTrue( VecSSE2 ) { return MaskSSE2{ _mm_castsi128_pd( _mm_set1_epi32( -1 ) ) }; }
+inline MaskSSE2 MaskFalse( VecSSE2 ) { return MaskSSE2{ _mm_setzero_pd() }; }
+inline VecSSE2 Select( MaskSSE2 m, VecSSE2 a, VecSSE2 b )
+{
+    return VecSSE2{ _mm_or_pd( _mm_and_pd( m.m, a.v ), _mm_andnot_pd( m.m, b.v ) ) };
+}
+
+///
+/// \brief Маска сравнения SSE для значений float
+///
+struct MaskF4
+{
+    __m128 m;
+};
+
+///
+/// \brief Вектор из четырех значений float (SSE)
+///
+struct VecF4
+{
+    typedef float Scalar;
+    static constexpr int Width = 4;
+    static constexpr int RSqrtSteps = 1; ///< Оценка 12 бит
+    typedef MaskF4 Mask;
+    __m128 v;
+
+    static VecF4 Load( const float *p ) { return VecF4{ _mm_loadu_ps( p ) }; }
+    static VecF4 Set1( float x ) { return VecF4{ _mm_set1_ps( x ) }; }
+};
+
+inline void Store( float *p, VecF4 a ) { _mm_storeu_ps( p, a.v ); }
+inline void StoreStream( float *p, VecF4 a ) { _mm_stream_ps( p, a.v ); }
+inline VecF4 RSqrtEstimate( VecF4 a ) { return VecF4{ _mm_rsqrt_ps( a.v ) }; }
+inline VecF4 operator+( VecF4 a, VecF4 b ) { return VecF4{ _mm_add_ps( a.v, b.v ) }; }
+inline VecF4 operator-( VecF4 a, VecF4 b ) { return VecF4{ _mm_sub_ps( a.v, b.v ) }; }
+inline VecF4 operator*( VecF4 a, VecF4 b ) { return VecF4{ _mm_mul_ps( a.v, b.v ) }; }
+inline VecF4 operator/( VecF4 a, VecF4 b ) { return VecF4{ _mm_div_ps( a.v, b.v ) }; }
+inline VecF4 operator-( VecF4 a ) { return VecF4{ _mm_xor_ps( a.v, _mm_set1_ps( -0.0f ) ) }; }
+inline VecF4 Sqrt( VecF4 a ) { return VecF4{ _mm_sqrt_ps( a.v ) }; }
+inline VecF4 Abs( VecF4 a ) { return VecF4{ _mm_andnot_ps( _mm_set1_ps( -0.0f ), a.v ) }; }
+inline VecF4 CopySign( VecF4 a, VecF4 b )
+{
+    const __m128 sign = _mm_set1_ps( -0.0f );
+    return VecF4{ _mm_or_ps( _mm_andnot_ps( sign, a.v ), _mm_and_ps( sign, b.v ) ) };
+}
+inline VecF4 Min( VecF4 a, VecF4 b ) { return VecF4{ _mm_min_ps( a.v, b.v ) }; }
+inline VecF4 Max( VecF4 a, VecF4 b ) { return VecF4{ _mm_max_ps( a.v, b.v ) }; }
+inline MaskF4 Gt( VecF4 a, VecF4 b ) { return MaskF4{ _mm_cmpgt_ps( a.v, b.v ) }; }
+inline MaskF4 Ge( VecF4 a, VecF4 b ) { return MaskF4{ _mm_cmpge_ps( a.v, b.v ) }; }
+inline MaskF4 Lt( VecF4 a, VecF4 b ) { return MaskF4{ _mm_cmplt_ps( a.v, b.v ) }; }
+inline MaskF4 Le( VecF4 a, VecF4 b ) { return MaskF4{ _mm_cmple_ps( a.v, b.v ) }; }
+inline MaskF4 IsNan( VecF4 a ) { return MaskF4{ _mm_cmpunord_ps( a.v, a.v ) }; }
+inline MaskF4 And( MaskF4 a, MaskF4 b ) { return MaskF4{ _mm_and_ps( a.m, b.m ) }; }
+inline MaskF4 Or( MaskF4 a, MaskF4 b ) { return MaskF4{ _mm_or_ps( a.m, b.m ) }; }
+inline MaskF4 AndNot( MaskF4 a, MaskF4 b ) { return MaskF4{ _mm_andnot_ps( b.m, a.m ) }; }
+inline bool Any( MaskF4 m ) { return _mm_movemask_ps( m.m ) != 0; }
+inline bool All( MaskF4 m ) { return _mm_movemask_ps( m.m ) == 0xF; }
+inline MaskF4 MaskTrue( VecF4 ) { return MaskF4{ _mm_castsi128_ps( _mm_set1_epi32( -1 ) ) }; }
+inline MaskF4 MaskFalse( VecF4 ) { return MaskF4{ _mm_setzero_ps() }; }
+inline VecF4 Select( MaskF4 m, VecF4 a, VecF4 b )
+{
+    return VecF4{ _mm_or_ps( _mm_and_ps( m.m, a.v ), _mm_andnot_ps( m.m, b.v ) ) };
+}
+#endif // __SSE2__
+
+#if defined( __AVX2__ )
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Маска сравнения AVX2
+///
+struct MaskAVX2
+{
+    __m256d m;
+};
+
+///
+/// \brief Вектор из четырех значений double (AVX2)
+///
+struct VecAVX2
+{
+    typedef double Scalar;
+    static constexpr int Width = 4;
+    static constexpr int RSqrtSteps = 3; ///< Оценка 12 бит (float)
+    typedef MaskAVX2 Mask;
+    __m256d v;
+
+    static VecAVX2 Load( const double *p ) { return VecAVX2{ _mm256_loadu_pd( p ) }; }
+    static VecAVX2 Set1( double x ) { return VecAVX2{ _mm256_set1_pd( x ) }; }
+};
+
+inline void Store( double *p, VecAVX2 a ) { _mm256_storeu_pd( p, a.v ); }
+inline void StoreStream( double *p, VecAVX2 a ) { _mm256_stream_pd( p, a.v ); }
+inline VecAVX2 RSqrtEstimate( VecAVX2 a ) { return VecAVX2{ _mm256_cvtps_pd( _mm_rsqrt_ps( _mm256_cvtpd_ps( a.v ) ) ) }; }
+inline VecAVX2 operator+( VecAVX2 a, VecAVX2 b ) { return VecAVX2{ _mm256_add_pd( a.v, b.v ) }; }
+inline VecAVX2 operator-( VecAVX2 a, VecAVX2 b ) { return VecAVX2{ _mm256_sub_pd( a.v, b.v ) }; }
+inline VecAVX2 operator*( VecAVX2 a, VecAVX2 b ) { return VecAVX2{ _mm256_mul_pd( a.v, b.v ) }; }
+inline VecAVX2 operator/( VecAVX2 a, VecAVX2 b ) { return VecAVX2{ _mm256_div_pd( a.v, b.v ) }; }
+inline VecAVX2 operator-( VecAVX2 a ) { return VecAVX2{ _mm256_xor_pd( a.v, _mm256_set1_pd( -0.0 ) ) }; }
+inline VecAVX2 Sqrt( VecAVX2 a ) { return VecAVX2{ _mm256_sqrt_pd( a.v ) }; }
+inline VecAVX2 Abs( VecAVX2 a ) { return VecAVX2{ _mm256_andnot_pd( _mm256_set1_pd( -0.0 ), a.v ) }; }
+inline VecAVX2 CopySign( VecAVX2 a, VecAVX2 b )
+{
+    const __m256d sign = _mm256_set1_pd( -0.0 );
+    return VecAVX2{ _mm256_or_pd( _mm256_andnot_pd( sign, a.v ), _mm256_and_pd( sign, b.v ) ) };
+}
+inline VecAVX2 Min( VecAVX2 a, VecAVX2 b ) { return VecAVX2{ _mm256_min_pd( a.v, b.v ) }; }
+inline VecAVX2 Max( VecAVX2 a, VecAVX2 b ) { return VecAVX2{ _mm256_max_pd( a.v, b.v ) }; }
+inline MaskAVX2 Gt( VecAVX2 a, VecAVX2 b ) { return MaskAVX2{ _mm256_cmp_pd( a.v, b.v, _CMP_GT_OQ ) }; }
+inline MaskAVX2 Ge( VecAVX2 a, VecAVX2 b ) { return MaskAVX2{ _mm256_cmp_pd( a.v, b.v, _CMP_GE_OQ ) }; }
+inline MaskAVX2 Lt( VecAVX2 a, VecAVX2 b ) { return MaskAVX2{ _mm256_cmp_pd( a.v, b.v, _CMP_LT_OQ ) }; }
+inline MaskAVX2 Le( VecAVX2 a, VecAVX2 b ) { return MaskAVX2{ _mm256_cmp_pd( a.v, b.v, _CMP_LE_OQ ) }; }
+inline MaskAVX2 IsNan( VecAVX2 a ) { return MaskAVX2{ _mm256_cmp_pd( a.v, a.v, _CMP_UNORD_Q ) }; }
+inline MaskAVX2 And( MaskAVX2 a, MaskAVX2 b ) { return MaskAVX2{ _mm256_and_pd( a.m, b.m ) }; }
+inline MaskAVX2 Or( MaskAVX2 a, MaskAVX2 b ) { return MaskAVX2{ _mm256_or_pd( a.m, b.m ) }; }
+inline MaskAVX2 AndNot( MaskAVX2 a, MaskAVX2 b ) { return MaskAVX2{ _mm256_andnot_pd( b.m, a.m ) }; }
+inline bool Any( MaskAVX2 m ) { return _mm256_movemask_pd( m.m ) != 0; }
+inline bool All( MaskAVX2 m ) { return _mm256_movemask_pd( m.m ) == 0xF; }
+inline MaskAVX2 MaskTrue( VecAVX2 ) { return MaskAVX2{ _mm256_castsi256_pd( _mm256_set1_epi32( -1 ) ) }; }
+inline MaskAVX2 MaskFalse( VecAVX2 ) { return MaskAVX2{ _mm256_setzero_pd() }; }
+inline VecAVX2 Select( MaskAVX2 m, VecAVX2 a, VecAVX2 b ) { return VecAVX2{ _mm256_blendv_pd( b.v, a.v, m.m ) }; }
+
+///
+/// \brief Маска сравнения AVX2 для значений float
+///
+struct MaskF8
+{
+    __m256 m;
+};
+
+///
+/// \brief Вектор из восьми значений float (AVX2)
+///
+struct VecF8
+{
+    typedef float Scalar;
+    static constexpr int Width = 8;
+    static constexpr int RSqrtSteps = 1; ///< Оценка 12 бит
+    typedef MaskF8 Mask;
+    __m256 v;
+
+    static VecF8 Load( const float *p ) { return VecF8{ _mm256_loadu_ps( p ) }; }
+    static VecF8 Set1( float x ) { return VecF8{ _mm256_set1_ps( x ) }; }
+};
+
+inline void Store( float *p, VecF8 a ) { _mm256_storeu_ps( p, a.v ); }
+inline void StoreStream( float *p, VecF8 a ) { _mm256_stream_ps( p, a.v ); }
+inline VecF8 RSqrtEstimate( VecF8 a ) { return VecF8{ _mm256_rsqrt_ps( a.v ) }; }
+inline VecF8 operator+( VecF8 a, VecF8 b ) { return VecF8{ _mm256_add_ps( a.v, b.v ) }; }
+inline VecF8 operator-( VecF8 a, VecF8 b ) { return VecF8{ _mm256_sub_ps( a.v, b.v ) }; }
+inline VecF8 operator*( VecF8 a, VecF8 b ) { return VecF8{ _mm256_mul_ps( a.v, b.v ) }; }
+inline VecF8 operator/( VecF8 a, VecF8 b ) { return VecF8{ _mm256_div_ps( a.v, b.v ) }; }
+inline VecF8 operator-( VecF8 a ) { return VecF8{ _mm256_xor_ps( a.v, _mm256_set1_ps( -0.0f ) ) }; }
+inline VecF8 Sqrt( VecF8 a ) { return VecF8{ _mm256_sqrt_ps( a.v ) }; }
+inline VecF8 Abs( VecF8 a ) { return VecF8{ _mm256_andnot_ps( _mm256_set1_ps( -0.0f ), a.v ) }; }
+inline VecF8 CopySign( VecF8 a, VecF8 b )
+{
+    const __m256 sign = _mm256_set1_ps( -0.0f );
+    return VecF8{ _mm256_or_ps( _mm256_andnot_ps( sign, a.v ), _mm256_and_ps( sign, b.v ) ) };
+}
+inline VecF8 Min( VecF8 a, VecF8 b ) { return VecF8{ _mm256_min_ps( a.v, b.v ) }; }
+inline VecF8 Max( VecF8 a, VecF8 b ) { return VecF8{ _mm256_max_ps( a.v, b.v ) }; }
+inline MaskF8 Gt( VecF8 a, VecF8 b ) { return MaskF8{ _mm256_cmp_ps( a.v, b.v, _CMP_GT_OQ ) }; }
+inline MaskF8 Ge( VecF8 a, VecF8 b ) { return MaskF8{ _mm256_cmp_ps( a.v, b.v, _CMP_GE_OQ ) }; }
+inline MaskF8 Lt( VecF8 a, VecF8 b ) { return MaskF8{ _mm256_cmp_ps( a.v, b.v, _CMP_LT_OQ ) }; }
+inline MaskF8 Le( VecF8 a, VecF8 b ) { return MaskF8{ _mm256_cmp_ps( a.v, b.v, _CMP_LE_OQ ) }; }
+inline MaskF8 IsNan( VecF8 a ) { return MaskF8{ _mm256_cmp_ps( a.v, a.v, _CMP_UNORD_Q ) }; }
+inline MaskF8 And( MaskF8 a, MaskF8 b ) { return MaskF8{ _mm256_and_ps( a.m, b.m ) }; }
+inline MaskF8 Or( MaskF8 a, MaskF8 b ) { return MaskF8{ _mm256_or_ps( a.m, b.m ) }; }
+inline MaskF8 AndNot( MaskF8 a, MaskF8 b ) { return MaskF8{ _mm256_andnot_ps( b.m, a.m ) }; }
+inline bool Any( MaskF8 m ) { return _mm256_movemask_ps( m.m ) != 0; }
+inline bool All( MaskF8 m ) { return _mm256_movemask_ps( m.m ) == 0xFF; }
+inline MaskF8 MaskTrue( VecF8 ) { return MaskF8{ _mm256_castsi256_ps( _mm256_set1_epi32( -1 ) ) }; }
+inline MaskF8 MaskFalse( VecF8 ) { return MaskF8{ _mm256_setzero_ps() }; }
+inline VecF8 Select( MaskF8 m, VecF8 a, VecF8 b ) { return VecF8{ _mm256_blendv_ps( b.v, a.v, m.m ) }; }
+#endif // __AVX2__
+
+#if defined( __AVX512F__ )
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Маска сравнения AVX-512
+///
+struct MaskAVX512
+{
+    __mmask8 m;
+};
+
+///
+/// \brief Вектор из восьми значений double (AVX-512F)
+///
+struct VecAVX512
+{
+    typedef double Scalar;
+    static constexpr int Width = 8;
+    static constexpr int RSqrtSteps = 2; ///< Оценка 14 бит
+    typedef MaskAVX512 Mask;
+    __m512d v;
+
+    static VecAVX512 Load( const double *p ) { return VecAVX512{ _mm512_loadu_pd( p ) }; }
+    static VecAVX512 Set1( double x ) { return VecAVX512{ _mm512_set1_pd( x ) }; }
+};
+
+inline void Store( double *p, VecAVX512 a ) { _mm512_storeu_pd( p, a.v ); }
+inline void StoreStream( double *p, VecAVX512 a ) { _mm512_stream_pd( p, a.v ); }
+inline VecAVX512 RSqrtEstimate( VecAVX512 a ) { return VecAVX512{ _mm512_rsqrt14_pd( a.v ) }; }
+inline VecAVX512 operator+( VecAVX512 a, VecAVX512 b ) { return VecAVX512{ _mm512_add_pd( a.v, b.v ) }; }
+inline VecAVX512 operator-( VecAVX512 a, VecAVX512 b ) { return VecAVX512{ _mm512_sub_pd( a.v, b.v ) }; }
+inline VecAVX512 operator*( VecAVX512 a, VecAVX512 b ) { return VecAVX512{ _mm512_mul_pd( a.v, b.v ) }; }
+inline VecAVX512 operator/( VecAVX512 a, VecAVX512 b ) { return VecAVX512{ _mm512_div_pd( a.v, b.v ) }; }
+inline VecAVX512 operator-( VecAVX512 a ) { return VecAVX512{ _mm512_sub_pd( _mm512_setzero_pd(), a.v ) }; }
+inline VecAVX512 Sqrt( VecAVX512 a ) { return VecAVX512{ _mm512_sqrt_pd( a.v ) }; }
+inline VecAVX512 Abs( VecAVX512 a ) { return VecAVX512{ _mm512_abs_pd( a.v ) }; }
+inline VecAVX512 CopySign( VecAVX512 a, VecAVX512 b )
+{
+    const __m512d sign = _mm512_set1_pd( -0.0 );
+    return VecAVX512{ _mm512_or_pd( _mm512_andnot_pd( sign, a.v ), _mm512_and_pd( sign, b.v ) ) };
+}
+inline VecAVX512 Min( VecAVX512 a, VecAVX512 b ) { return VecAVX512{ _mm512_min_pd( a.v, b.v ) }; }
+inline VecAVX512 Max( VecAVX512 a, VecAVX512 b ) { return VecAVX512{ _mm512_max_pd( a.v, b.v ) }; }
+inline MaskAVX512 Gt( VecAVX512 a, VecAVX512 b ) { return MaskAVX512{ _mm512_cmp_pd_mask( a.v, b.v, _CMP_GT_OQ ) }; }
+inline MaskAVX512 Ge( VecAVX512 a, VecAVX512 b ) { return MaskAVX512{ _mm512_cmp_pd_mask( a.v, b.v, _CMP_GE_OQ ) }; }
+inline MaskAVX512 Lt( VecAVX512 a, VecAVX512 b ) { return MaskAVX512{ _mm512_cmp_pd_mask( a.v, b.v, _CMP_LT_OQ ) }; }
+inline MaskAVX512 Le( VecAVX512 a, VecAVX512 b ) { return MaskAVX512{ _mm512_cmp_pd_mask( a.v, b.v, _CMP_LE_OQ ) }; }
+inline MaskAVX512 IsNan( VecAVX512 a ) { return MaskAVX512{ _mm512_cmp_pd_mask( a.v, a.v, _CMP_UNORD_Q ) }; }
+inline MaskAVX512 And( MaskAVX512 a, MaskAVX512 b ) { return MaskAVX512{ static_cast<__mmask8>( a.m & b.m ) }; }
+inline MaskAVX512 Or( MaskAVX512 a, MaskAVX512 b ) { return MaskAVX512{ static_cast<__mmask8>( a.m | b.m ) }; }
+inline MaskAVX512 AndNot( MaskAVX512 a, MaskAVX512 b ) { return MaskAVX512{ static_cast<__mmask8>( a.m & ~b.m ) }; }
+inline bool Any( MaskAVX512 m ) { return m.m != 0; }
+inline bool All( MaskAVX512 m ) { return m.m == 0xFF; }
+inline MaskAVX512 MaskTrue( VecAVX512 ) { return MaskAVX512{ 0xFF }; }
+inline MaskAVX512 MaskFalse( VecAVX512 ) { return MaskAVX512{ 0x00 }; }
+inline VecAVX512 Select( MaskAVX512 m, VecAVX512 a, VecAVX512 b ) { return VecAVX512{ _mm512_mask_blend_pd( m.m, b.v, a.v ) }; }
+
+///
+/// \brief Маска сравнения AVX-512 для значений float
+///
+struct MaskF16
+{
+    __mmask16 m;
+};
+
+///
+/// \brief Вектор из шестнадцати значений float (AVX-512F)
+///
+struct VecF16
+{
+    typedef float Scalar;
+    static constexpr int Width = 16;
+    static constexpr int RSqrtSteps = 1; ///< Оценка 14 бит
+    typedef MaskF16 Mask;
+    __m512 v;
+
+    static VecF16 Load( const float *p ) { return VecF16{ _mm512_loadu_ps( p ) }; }
+    static VecF16 Set1( float x ) { return VecF16{ _mm512_set1_ps( x ) }; }
+};
+
+inline void Store( float *p, VecF16 a ) { _mm512_storeu_ps( p, a.v ); }
+inline void StoreStream( float *p, VecF16 a ) { _mm512_stream_ps( p, a.v ); }
+inline VecF16 RSqrtEstimate( VecF16 a ) { return VecF16{ _mm512_rsqrt14_ps( a.v ) }; }
+inline VecF16 operator+( VecF16 a, VecF16 b ) { return VecF16{ _mm512_add_ps( a.v, b.v ) }; }
+inline VecF16 operator-( VecF16 a, VecF16 b ) { return VecF16{ _mm512_sub_ps( a.v, b.v ) }; }
+inline VecF16 operator*( VecF16 a, VecF16 b ) { return VecF16{ _mm512_mul_ps( a.v, b.v ) }; }
+inline VecF16 operator/( VecF16 a, VecF16 b ) { return VecF16{ _mm512_div_ps( a.v, b.v ) }; }
+inline VecF16 operator-( VecF16 a ) { return VecF16{ _mm512_sub_ps( _mm512_setzero_ps(), a.v ) }; }
+inline VecF16 Sqrt( VecF16 a ) { return VecF16{ _mm512_sqrt_ps( a.v ) }; }
+inline VecF16 Abs( VecF16 a ) { return VecF16{ _mm512_abs_ps( a.v ) }; }
+inline VecF16 CopySign( VecF16 a, VecF16 b )
+{
+    const __m512 sign = _mm512_set1_ps( -0.0f );
+    return VecF16{ _mm512_or_ps( _mm512_andnot_ps( sign, a.v ), _mm512_and_ps( sign, b.v ) ) };
+}
+inline VecF16 Min( VecF16 a, VecF16 b ) { return VecF16{ _mm512_min_ps( a.v, b.v ) }; }
+inline VecF16 Max( VecF16 a, VecF16 b ) { return VecF16{ _mm512_max_ps( a.v, b.v ) }; }
+inline MaskF16 Gt( VecF16 a, VecF16 b ) { return MaskF16{ _mm512_cmp_ps_mask( a.v, b.v, _CMP_GT_OQ ) }; }
+inline MaskF16 Ge( VecF16 a, VecF16 b ) { return MaskF16{ _mm512_cmp_ps_mask( a.v, b.v, _CMP_GE_OQ ) }; }
+inline MaskF16 Lt( VecF16 a, VecF16 b ) { return MaskF16{ _mm512_cmp_ps_mask( a.v, b.v, _CMP_LT_OQ ) }; }
+inline MaskF16 Le( VecF16 a, VecF16 b ) { return MaskF16{ _mm512_cmp_ps_mask( a.v, b.v, _CMP_LE_OQ ) }; }
+inline MaskF16 IsNan( VecF16 a ) { return MaskF16{ _mm512_cmp_ps_mask( a.v, a.v, _CMP_UNORD_Q ) }; }
+inline MaskF16 And( MaskF16 a, MaskF16 b ) { return MaskF16{ static_cast<__mmask16>( a.m & b.m ) }; }
+inline MaskF16 Or( MaskF16 a, MaskF16 b ) { return MaskF16{ static_cast<__mmask16>( a.m | b.m ) }; }
+inline MaskF16 AndNot( MaskF16 a, MaskF16 b ) { return MaskF16{ static_cast<__mmask16>( a.m & ~b.m ) }; }
+inline bool Any( MaskF16 m ) { return m.m != 0; }
+inline bool All( MaskF16 m ) { return m.m == 0xFFFF; }
+inline MaskF16 MaskTrue( VecF16 ) { return MaskF16{ 0xFFFF }; }
+inline MaskF16 MaskFalse( VecF16 ) { return MaskF16{ 0x0000 }; }
+inline VecF16 Select( MaskF16 m, VecF16 a, VecF16 b ) { return VecF16{ _mm512_mask_blend_ps( m.m, b.v, a.v ) }; }
+#endif // __AVX512F__
+
+//----------------------------------------------------------------------------------------------------------------------
+// Общие для всех векторных типов операции
+template <class V> inline V operator+( V a, double b ) { return a + V::Set1( b ); }
+template <class V> inline V operator+( double a, V b ) { return V::Set1( a ) + b; }
+template <class V> inline V operator-( V a, double b ) { return a - V::Set1( b ); }
+template <class V> inline V operator-( double a, V b ) { return V::Set1( a ) - b; }
+template <class V> inline V operator*( V a, double b ) { return a * V::Set1( b ); }
+template <class V> inline V operator*( double a, V b ) { return V::Set1( a ) * b; }
+template <class V> inline V operator/( V a, double b ) { return a / V::Set1( b ); }
+template <class V> inline V operator/( double a, V b ) { return V::Set1( a ) / b; }
+
+///
+/// \brief Завершение потоковой записи (StoreStream) перед чтением результатов другими потоками
+///
+inline void StreamFence()
+{
+#if defined( __SSE2__ )
+    _mm_sfence();
+#endif
+}
+
+///
+/// \brief Обратный квадратный корень 1 / sqrt( x ) для x > 0: аппаратная оценка и итерации Ньютона
+/// \details Число итераций V::RSqrtSteps доводит оценку до точности типа значения (относительная погрешность ~1e-16
+///          для double, ~1e-7 для float)
+///
+template <class V>
+inline V RSqrt( V x )
+{
+    const V hx = 0.5 * x;
+    V y = RSqrtEstimate( x );
+    for( int i = 0; i < V::RSqrtSteps; i++ ) {
+        y = y * ( 1.5 - hx * ( y * y ) );
+    }
+    return y;
+}
+
+} // end anonymous namespace
+} // end namespace SIMD
+} // end namespace SPML
+#endif // SPML_SIMD_VEC_H
+/// \}
@@ -0,0 +1,347 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       spatial_index.cpp
+/// \brief      Пространственный индекс точек на поверхности эллипсоида (k-d дерево в ECEF)
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#include <spatial_index.h>
+#include <geodesy_batch.h>
+#include <geofence.h>
+#include <parallel.h>
+
+// System includes:
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+//----------------------------------------------------------------------------------------------------------------------
+const std::size_t CSpatialIndex::LeafSize;
+const std::size_t CSpatialIndex::NoIndex;
+
+CSpatialIndex::CSpatialIndex( const CEllipsoid &ellipsoid, const Units::TRangeUnit &rangeUnit,
+    const Units::TAngleUnit &angleUnit, const double *lat, const double *lon, std::size_t count,
+    TGeodesicMethod method ) :
+    ellipsoid( ellipsoid ), rangeUnit( rangeUnit ), angleUnit( angleUnit ), method( method )
+{
+    switch( angleUnit ) {
+        case( Units::TAngleUnit::AU_Radian ):
+        {
+            angleIn = 1.0;
+            angleOut = 1.0;
+            break;
+        }
+        case( Units::TAngleUnit::AU_Degree ):
+        {
+            angleIn = Convert::DgToRdD;
+            angleOut = Convert::RdToDgD;
+            break;
+        }
+        default:
+            assert( false );
+    }
+    switch( rangeUnit ) {
+        case( Units::TRangeUnit::RU_Meter ):
+        {
+            rangeOut = 1.0;
+            break;
+        }
+        case( Units::TRangeUnit::RU_Kilometer ):
+        {
+            rangeOut = 0.001;
+            break;
+        }
+        default:
+            assert( false );
+    }
+    if( count == 0 ) {
+        return;
+    }
+    assert( ( lat != nullptr ) && ( lon != nullptr ) );
+
+    // ECEF координаты точек на поверхности [м]
+    const std::vector<double> h( count, 0.0 );
+    std::vector<double> px( count ), py( count ), pz( count );
+    GEOtoECEF_Batch( ellipsoid, Units::TRangeUnit::RU_Meter, angleUnit, lat, lon, h.data(), count,
+        px.data(), py.data(), pz.data() );
+    std::vector<double> p( 3 * count );
+    for( std::size_t i = 0; i < count; i++ ) {
+        p[3 * i] = px[i];
+        p[3 * i + 1] = py[i];
+        p[3 * i + 2] = pz[i];
+    }
+
+    std::vector<std::size_t> perm( count );
+    for( std::size_t i = 0; i < count; i++ ) {
+        perm[i] = i;
+    }
+    axis.assign( count, 0 );
+    Build( 0, count, perm, p );
+
+    // Точки в порядке дерева
+    xyz.resize( 3 * count );
+    latRad.resize( count );
+    lonRad.resize( count );
+    order = perm;
+    for( std::size_t i = 0; i < count; i++ ) {
+        const std::size_t j = perm[i];
+        xyz[3 * i] = p[3 * j];
+        xyz[3 * i + 1] = p[3 * j + 1];
+        xyz[3 * i + 2] = p[3 * j + 2];
+        latRad[i] = lat[j] * angleIn;
+        lonRad[i] = lon[j] * angleIn;
+    }
+}
+
+void CSpatialIndex::Build( std::size_t begin, std::size_t end, std::vector<std::size_t> &perm,
+    const std::vector<double> &p )
+{
+    if( end - begin <= LeafSize ) {
+        return;
+    }
+
+    // Ось разбиения - наибольший размер охватывающего параллелепипеда
+    double lo[3], hi[3];
+    for( int a = 0; a < 3; a++ ) {
+        lo[a] = hi[a] = p[3 * perm[begin] + a];
+    }
+    for( std::size_t i = begin + 1; i < end; i++ ) {
+        for( int a = 0; a < 3; a++ ) {
+            const double c = p[3 * perm[i] + a];
+            lo[a] = std::min( lo[a], c );
+            hi[a] = std::max( hi[a], c );
+        }
+    }
+    int a = 0;
+    for( int b = 1; b < 3; b++ ) {
+        if( hi[b] - lo[b] > hi[a] - lo[a] ) {
+            a = b;
+        }
+    }
+
+    // Медиана - узел, слева координаты не больше, справа - не меньше
+    const std::size_t mid = begin + ( end - begin ) / 2;
+    std::nth_element( perm.begin() + begin, perm.begin() + mid, perm.begin() + end,
+        [&]( std::size_t lhs, std::size_t rhs ) { return p[3 * lhs + a] < p[3 * rhs + a]; } );
+    axis[mid] = static_cast<std::uint8_t>( a );
+    Build( begin, mid, perm, p );
+    Build( mid + 1, end, perm, p );
+}
+
+double CSpatialIndex::Chord2( const double q[3], std::size_t i ) const
+{
+    const double dx = xyz[3 * i] - q[0];
+    const double dy = xyz[3 * i + 1] - q[1];
+    const double dz = xyz[3 * i + 2] - q[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+void CSpatialIndex::SearchNearest( std::size_t begin, std::size_t end, const double q[3], std::size_t k,
+    std::vector<TCandidate> &heap ) const
+{
+    auto consider = [&]( std::size_t i ) {
+        const double c2 = Chord2( q, i );
+        if( heap.size() < k ) {
+            heap.emplace_back( c2, i );
+            std::push_heap( heap.begin(), heap.end() );
+        } else if( c2 < heap.front().first ) {
+            std::pop_heap( heap.begin(), heap.end() );
+            heap.back() = TCandidate( c2, i );
+            std::push_heap( heap.begin(), heap.end() );
+        }
+    };
+
+    if( end - begin <= LeafSize ) {
+        for( std::size_t i = begin; i < end; i++ ) {
+            consider( i );
+        }
+        return;
+    }
+    const std::size_t mid = begin + ( end - begin ) / 2;
+    consider( mid );
+    const double diff = q[axis[mid]] - xyz[3 * mid + axis[mid]];
+    const bool left = ( diff < 0.0 );
+    if( left ) {
+        SearchNearest( begin, mid, q, k, heap );
+    } else {
+        SearchNearest( mid + 1, end, q, k, heap );
+    }
+    if( ( heap.size() < k ) || ( diff * diff < heap.front().first ) ) {
+        if( left ) {
+            SearchNearest( mid + 1, end, q, k, heap );
+        } else {
+            SearchNearest( begin, mid, q, k, heap );
+        }
+    }
+}
+
+void CSpatialIndex::SearchRange( std::size_t begin, std::size_t end, const double q[3], double lo2, double hi2,
+    std::vector<TCandidate> &found ) const
+{
+    if( end - begin <= LeafSize ) {
+        for( std::size_t i = begin; i < end; i++ ) {
+            const double c2 = Chord2( q, i );
+            if( ( c2 >= lo2 ) && ( c2 <= hi2 ) ) {
+                found.emplace_back( c2, i );
+            }
+        }
+        return;
+    }
+    const std::size_t mid = begin + ( end - begin ) / 2;
+    const double c2 = Chord2( q, mid );
+    if( ( c2 >= lo2 ) && ( c2 <= hi2 ) ) {
+        found.emplace_back( c2, mid );
+    }
+    const double diff = q[axis[mid]] - xyz[3 * mid + axis[mid]];
+    if( ( diff < 0.0 ) || ( diff * diff <= hi2 ) ) {
+        SearchRange( begin, mid, q, lo2, hi2, found );
+    }
+    if( ( diff >= 0.0 ) || ( diff * diff <= hi2 ) ) {
+        SearchRange( mid + 1, end, q, lo2, hi2, found );
+    }
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+std::size_t CSpatialIndex::Nearest( double lat, double lon, std::size_t k, std::size_t *index, double *d,
+    double *az ) const
+{
+    if( k == 0 ) {
+        return 0;
+    }
+    assert( ( index != nullptr ) && ( d != nullptr ) );
+
+    const std::size_t found = std::min( k, Size() );
+    for( std::size_t i = found; i < k; i++ ) {
+        index[i] = NoIndex;
+        d[i] = std::numeric_limits<double>::quiet_NaN();
+        if( az != nullptr ) {
+            az[i] = std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+    if( found == 0 ) {
+        return 0;
+    }
+
+    const double latQ = lat * angleIn;
+    const double lonQ = lon * angleIn;
+    double q[3];
+    GEOtoECEF<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, latQ, lonQ, 0.0, q[0], q[1], q[2] );
+
+    // Уточненный кандидат: расстояние [м], номер точки, азимут [рад]
+    struct TRefined
+    {
+        double s;
+        std::size_t index;
+        double az;
+    };
+    std::vector<TRefined> refined;
+    auto refine = [&]( std::size_t pos ) {
+        double s, a;
+        GEOtoRAD( ellipsoid, method, Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, latQ, lonQ,
+            latRad[pos], lonRad[pos], s, a );
+        refined.push_back( TRefined{ s, order[pos], a } );
+    };
+
+    // k ближайших по хорде
+    std::vector<TCandidate> heap;
+    heap.reserve( found );
+    SearchNearest( 0, Size(), q, found, heap );
+    refined.reserve( 2 * found );
+    double sMax = 0.0;
+    for( const TCandidate &c : heap ) {
+        refine( c.second );
+        sMax = std::max( sMax, refined.back().s );
+    }
+
+    // Точки с хордой от k-й найденной до S_k (запас - на погрешность обратной задачи)
+    const double chordK2 = heap.front().first;
+    const double hi = sMax * ( 1.0 + 1.0e-9 ) + 1.0e-6;
+    if( hi * hi >= chordK2 ) {
+        std::vector<std::size_t> inHeap( heap.size() );
+        for( std::size_t i = 0; i < heap.size(); i++ ) {
+            inHeap[i] = heap[i].second;
+        }
+        std::sort( inHeap.begin(), inHeap.end() );
+        std::vector<TCandidate> extra;
+        SearchRange( 0, Size(), q, chordK2, hi * hi, extra );
+        for( const TCandidate &c : extra ) {
+            if( !std::binary_search( inHeap.begin(), inHeap.end(), c.second ) ) {
+                refine( c.second );
+            }
+        }
+    }
+
+    std::partial_sort( refined.begin(), refined.begin() + found, refined.end(),
+        []( const TRefined &lhs, const TRefined &rhs ) {
+            return ( lhs.s < rhs.s ) || ( ( lhs.s == rhs.s ) && ( lhs.index < rhs.index ) );
+        } );
+    for( std::size_t i = 0; i < found; i++ ) {
+        index[i] = refined[i].index;
+        d[i] = refined[i].s * rangeOut;
+        if( az != nullptr ) {
+            az[i] = refined[i].az * angleOut;
+        }
+    }
+    return found;
+}
+
+void CSpatialIndex::Nearest( const double *lat, const double *lon, std::size_t count, std::size_t k,
+    std::size_t *index, double *d, double *az, unsigned int threads ) const
+{
+    Nearest( lat, lon, count, k, index, d, az, Execution::Policy( Execution::EM_Parallel, threads ) );
+}
+
+void CSpatialIndex::Nearest( const double *lat, const double *lon, std::size_t count, std::size_t k,
+    std::size_t *index, double *d, double *az, const Execution::Policy &policy ) const
+{
+    if( ( count == 0 ) || ( k == 0 ) ) {
+        return;
+    }
+    assert( ( lat != nullptr ) && ( lon != nullptr ) );
+    Execution::Policy parts = policy;
+    if( parts.Chunk == 0 ) {
+        parts.Chunk = 64;
+    }
+    Batch::ParallelFor( count, parts, 1, [&]( std::size_t begin, std::size_t end ) {
+        for( std::size_t i = begin; i < end; i++ ) {
+            Nearest( lat[i], lon[i], k, index + i * k, d + i * k, ( az != nullptr ) ? ( az + i * k ) : nullptr );
+        }
+    } );
+}
+
+std::size_t CSpatialIndex::Within( double lat, double lon, double range, std::vector<std::size_t> &index ) const
+{
+    index.clear();
+    if( Size() == 0 ) {
+        return 0;
+    }
+    const double latQ = lat * angleIn;
+    const double lonQ = lon * angleIn;
+    double q[3];
+    GEOtoECEF<Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian>( ellipsoid, latQ, lonQ, 0.0, q[0], q[1], q[2] );
+
+    // Хорда не больше расстояния (запас - на погрешность обратной задачи)
+    const double hi = ( range / rangeOut ) * ( 1.0 + 1.0e-9 ) + 1.0e-3;
+    std::vector<TCandidate> candidates;
+    SearchRange( 0, Size(), q, 0.0, hi * hi, candidates );
+    for( const TCandidate &c : candidates ) {
+        if( GEOWithinRange( ellipsoid, Units::TRangeUnit::RU_Meter, Units::TAngleUnit::AU_Radian, latQ, lonQ,
+            latRad[c.second], lonRad[c.second], range / rangeOut, method ) ) {
+            index.push_back( order[c.second] );
+        }
+    }
+    std::sort( index.begin(), index.end() );
+    return index.size();
+}
+
+} // end namespace Geodesy
+} // end namespace SPML
+/// \}
@@ -0,0 +1,206 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       thread_pool.cpp
+/// \brief      Пул потоков библиотеки для пакетных функций
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#include <thread_pool.h>
+#include <execution.h>
+
+// System includes:
+#include <algorithm>
+#if defined( __linux__ )
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Batch /// Ядра пакетных функций (внутреннее)
+{
+//----------------------------------------------------------------------------------------------------------------------
+static thread_local bool insideWorker = false; // Текущий поток - поток пула
+
+// Закрепление потока за ядром процессора
+static void PinThread( std::thread &thread, unsigned int cpu )
+{
+#if defined( __linux__ )
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    CPU_SET( cpu % CPU_SETSIZE, &set );
+    pthread_setaffinity_np( thread.native_handle(), sizeof( set ), &set );
+#else
+    ( void )thread;
+    ( void )cpu;
+#endif
+}
+
+CThreadPool &CThreadPool::Instance()
+{
+    static CThreadPool pool;
+    return pool;
+}
+
+CThreadPool::CThreadPool()
+{
+    Start( 0, false );
+}
+
+CThreadPool::~CThreadPool()
+{
+    Stop();
+}
+
+void CThreadPool::Configure( unsigned int threads, bool pin )
+{
+    std::lock_guard<std::mutex> running( runMutex );
+    Stop();
+    Start( threads, pin );
+}
+
+void CThreadPool::Start( unsigned int threads, bool pin )
+{
+    const unsigned int cores = std::max( 1u, std::thread::hardware_concurrency() );
+    if( threads == 0 ) {
+        threads = cores;
+    }
+    pinned = pin;
+    workers.reserve( threads - 1 );
+    for( unsigned int i = 1; i < threads; i++ ) {
+        workers.emplace_back( &CThreadPool::Worker, this );
+        if( pin ) {
+            PinThread( workers.back(), i % cores );
+        }
+    }
+}
+
+void CThreadPool::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stop = true;
+    }
+    wake.notify_all();
+    for( std::thread &worker : workers ) {
+        worker.join();
+    }
+    workers.clear();
+    stop = false;
+}
+
+void CThreadPool::Worker()
+{
+    insideWorker = true;
+    unsigned long seen = 0;
+    std::unique_lock<std::mutex> lock( mutex );
+    while( true ) {
+        wake.wait( lock, [&]() { return stop || ( ( job != nullptr ) && ( generation != seen ) ); } );
+        if( stop ) {
+            return;
+        }
+        seen = generation;
+        if( active >= job->helpers ) {
+            continue;
+        }
+        TJob *current = job;
+        active++;
+        lock.unlock();
+        Execute( *current );
+        lock.lock();
+        active--;
+        if( active == 0 ) {
+            finished.notify_all();
+        }
+    }
+}
+
+void CThreadPool::Execute( TJob &job )
+{
+    while( true ) {
+        const std::size_t part = job.next.fetch_add( 1 );
+        if( part >= job.parts ) {
+            break;
+        }
+        try {
+            ( *job.task )( part );
+        } catch( ... ) {
+            std::lock_guard<std::mutex> lock( job.errorMutex );
+            if( !job.error ) {
+                job.error = std::current_exception();
+            }
+            job.next = job.parts; // Остальные части не раздаются
+            break;
+        }
+    }
+}
+
+void CThreadPool::Run( std::size_t parts, unsigned int threads, const std::function<void( std::size_t )> &task )
+{
+    std::unique_lock<std::mutex> running( runMutex, std::defer_lock );
+    if( ( parts > 1 ) && ( threads != 1 ) && !workers.empty() && !insideWorker ) {
+        running.try_lock();
+    }
+    if( !running.owns_lock() ) { // Последовательно в вызывающем потоке
+        for( std::size_t part = 0; part < parts; part++ ) {
+            task( part );
+        }
+        return;
+    }
+
+    TJob current;
+    current.task = &task;
+    current.parts = parts;
+    current.helpers = static_cast<unsigned int>( workers.size() );
+    if( threads != 0 ) {
+        current.helpers = std::min( current.helpers, threads - 1 );
+    }
+    current.next = 0;
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        job = &current;
+        generation++;
+    }
+    wake.notify_all();
+    Execute( current );
+    // Все части розданы: взятые потоками пула завершены, когда active == 0 (в том числе после исключения)
+    std::unique_lock<std::mutex> lock( mutex );
+    finished.wait( lock, [&]() { return active == 0; } );
+    job = nullptr;
+    lock.unlock();
+    if( current.error ) {
+        std::rethrow_exception( current.error );
+    }
+}
+
+} // end namespace Batch
+
+namespace Execution /// Политика выполнения пакетных функций
+{
+//----------------------------------------------------------------------------------------------------------------------
+void SetPoolThreads( unsigned int threads, bool pin )
+{
+    Batch::CThreadPool::Instance().Configure( threads, pin );
+}
+
+void ParallelTasks( std::size_t tasks, const Policy &policy, const std::function<void( std::size_t )> &task )
+{
+    Batch::CThreadPool::Instance().Run( tasks, policy.MaxThreads(), task );
+}
+
+unsigned int PoolThreads()
+{
+    return Batch::CThreadPool::Instance().Threads();
+}
+
+bool PoolPinned()
+{
+    return Batch::CThreadPool::Instance().Pinned();
+}
+
+} // end namespace Execution
+} // end namespace SPML
+/// \}
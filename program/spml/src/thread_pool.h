@@ -0,0 +1,112 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       thread_pool.h
+/// \brief      Пул потоков библиотеки для пакетных функций (внутренний заголовок)
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_THREAD_POOL_H
+#define SPML_THREAD_POOL_H
+
+// System includes:
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Batch /// Ядра пакетных функций (внутреннее)
+{
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \brief Пул потоков: выполнение частей пакета с ожиданием завершения всех частей (fork-join)
+/// \details Части раздаются через общий счетчик: поток берет следующую часть, как только завершил предыдущую.
+/// Одновременно выполняется одно задание, вызов при занятом пуле и вызов из потока пула выполняются в вызывающем
+/// потоке. Исключение части останавливает раздачу частей и передается вызывающему после завершения начатых частей
+///
+class CThreadPool
+{
+public:
+    ///
+    /// \brief Пул библиотеки
+    /// \return Единственный экземпляр пула (создается при первом вызове по числу ядер процессора)
+    ///
+    static CThreadPool &Instance();
+
+    ~CThreadPool();
+
+    ///
+    /// \brief Пересоздание потоков пула
+    /// \param[in] threads - число потоков, включая вызывающий (0 - по числу ядер процессора)
+    /// \param[in] pin     - закрепить потоки за ядрами
+    ///
+    void Configure( unsigned int threads, bool pin );
+
+    ///
+    /// \brief Число потоков, выполняющих части, включая вызывающий
+    ///
+    unsigned int Threads() const
+    {
+        return static_cast<unsigned int>( workers.size() ) + 1;
+    }
+
+    ///
+    /// \brief Закрепление потоков за ядрами
+    ///
+    bool Pinned() const
+    {
+        return pinned;
+    }
+
+    ///
+    /// \brief Выполнение частей задания task( 0 ) ... task( parts - 1 ) с ожиданием завершения
+    /// \param[in] parts   - число частей
+    /// \param[in] threads - наибольшее число потоков, включая вызывающий
+    /// \param[in] task    - обработчик части
+    /// \throw Первое исключение обработчика (оставшиеся части не выполняются)
+    ///
+    void Run( std::size_t parts, unsigned int threads, const std::function<void( std::size_t )> &task );
+
+private:
+    // Задание: части раздаются через next, error - первое исключение обработчика
+    struct TJob
+    {
+        const std::function<void( std::size_t )> *task;
+        std::size_t parts;
+        unsigned int helpers;                   // Наибольшее число потоков пула (без вызывающего)
+        std::atomic<std::size_t> next;
+        std::mutex errorMutex;                  // Защита error
+        std::exception_ptr error;
+    };
+
+    std::vector<std::thread> workers;   // Потоки пула
+    bool pinned = false;                // Потоки закреплены за ядрами
+    std::mutex runMutex;                // Одно задание за раз
+    std::mutex mutex;                   // Защита полей ниже
+    std::condition_variable wake;       // Новое задание или завершение пула
+    std::condition_variable finished;   // Завершение задания
+    TJob *job = nullptr;                // Текущее задание
+    unsigned long generation = 0;       // Номер задания
+    unsigned int active = 0;            // Число потоков пула, выполняющих текущее задание
+    bool stop = false;                  // Завершение потоков
+
+    CThreadPool();
+
+    void Start( unsigned int threads, bool pin );
+    void Stop();
+    void Worker();
+    static void Execute( TJob &job );
+};
+
+} // end namespace Batch
+} // end namespace SPML
+#endif // SPML_THREAD_POOL_H
+/// \}
@@ -0,0 +1,155 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       vincenty_stats.cpp
+/// \brief      Статистика сходимости итераций формул Винсента (обратная и прямая геодезические задачи)
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#include <vincenty_stats.h>
+#include <vincenty_stats_impl.h>
+
+// System includes:
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+//----------------------------------------------------------------------------------------------------------------------
+// Счетчики одной задачи: гистограмма, затем выходы без сходимости и для совпадающих точек
+static const unsigned LoopCounters = VincentyHistogramBins + 2;
+static const unsigned InverseOffset = 0;
+static const unsigned DirectOffset = LoopCounters;
+static const unsigned CounterCount = 2 * LoopCounters;
+
+struct TThreadCounters;
+
+// Счетчики всех потоков: живые потоки, сумма завершившихся и суммы на момент ResetVincentyStats
+struct TRegistry
+{
+    std::mutex Mutex;
+    std::vector<const TThreadCounters *> Threads;
+    std::uint64_t Retired[CounterCount] = {};
+    std::uint64_t Baseline[CounterCount] = {};
+};
+
+// Реестр не разрушается: потоки пула библиотеки завершаются при разрушении статических объектов, в любом порядке
+static TRegistry &Registry()
+{
+    static TRegistry *registry = new TRegistry;
+    return *registry;
+}
+
+// Счетчики потока: пишет только сам поток (атомарные чтение и запись без барьеров - обычные команды), читает
+// GetVincentyStats. При завершении потока счетчики добавляются к сумме завершившихся
+struct TThreadCounters
+{
+    std::atomic<std::uint64_t> Values[CounterCount];
+
+    TThreadCounters()
+    {
+        for( std::atomic<std::uint64_t> &v : Values ) {
+            v.store( 0, std::memory_order_relaxed );
+        }
+        TRegistry &registry = Registry();
+        std::lock_guard<std::mutex> lock( registry.Mutex );
+        registry.Threads.push_back( this );
+    }
+
+    ~TThreadCounters()
+    {
+        TRegistry &registry = Registry();
+        std::lock_guard<std::mutex> lock( registry.Mutex );
+        for( unsigned i = 0; i < CounterCount; i++ ) {
+            registry.Retired[i] += Values[i].load( std::memory_order_relaxed );
+        }
+        registry.Threads.erase( std::find( registry.Threads.begin(), registry.Threads.end(), this ) );
+    }
+
+    void Increment( unsigned index )
+    {
+        Values[index].store( Values[index].load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    }
+};
+
+static void Record( unsigned offset, unsigned iterations, TVincentyOutcome outcome )
+{
+    static thread_local TThreadCounters counters;
+    counters.Increment( offset + VincentyHistogramBin( iterations ) );
+    if( outcome != VO_Converged ) {
+        counters.Increment( offset + VincentyHistogramBins + ( ( outcome == VO_NotConverged ) ? 0 : 1 ) );
+    }
+}
+
+// Текущие суммы счетчиков всех потоков (под блокировкой реестра)
+static void Totals( TRegistry &registry, std::uint64_t *totals )
+{
+    std::copy( registry.Retired, registry.Retired + CounterCount, totals );
+    for( const TThreadCounters *thread : registry.Threads ) {
+        for( unsigned i = 0; i < CounterCount; i++ ) {
+            totals[i] += thread->Values[i].load( std::memory_order_relaxed );
+        }
+    }
+}
+
+static TVincentyLoopStats LoopStats( const std::uint64_t *values )
+{
+    TVincentyLoopStats stats;
+    for( unsigned bin = 0; bin < VincentyHistogramBins; bin++ ) {
+        stats.Histogram[bin] = values[bin];
+        stats.Calls += values[bin];
+    }
+    stats.NotConverged = values[VincentyHistogramBins];
+    stats.Coincident = values[VincentyHistogramBins + 1];
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+void RecordVincentyInverse( unsigned iterations, TVincentyOutcome outcome )
+{
+    Record( InverseOffset, iterations, outcome );
+}
+
+void RecordVincentyDirect( unsigned iterations, TVincentyOutcome outcome )
+{
+    Record( DirectOffset, iterations, outcome );
+}
+
+bool VincentyStatsEnabled()
+{
+    return CollectVincentyStats;
+}
+
+TVincentyStats GetVincentyStats()
+{
+    TRegistry &registry = Registry();
+    std::uint64_t values[CounterCount];
+    {
+        std::lock_guard<std::mutex> lock( registry.Mutex );
+        Totals( registry, values );
+        for( unsigned i = 0; i < CounterCount; i++ ) {
+            values[i] -= registry.Baseline[i];
+        }
+    }
+    TVincentyStats stats;
+    stats.Inverse = LoopStats( values + InverseOffset );
+    stats.Direct = LoopStats( values + DirectOffset );
+    return stats;
+}
+
+void ResetVincentyStats()
+{
+    TRegistry &registry = Registry();
+    std::lock_guard<std::mutex> lock( registry.Mutex );
+    Totals( registry, registry.Baseline );
+}
+
+} // end namespace Geodesy
+} // end namespace SPML
+/// \}
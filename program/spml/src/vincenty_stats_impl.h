@@ -0,0 +1,57 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       vincenty_stats_impl.h
+/// \brief      Запись статистики итераций формул Винсента (внутренний заголовок, см. vincenty_stats.h)
+/// \details    Места записи проверяют CollectVincentyStats (константа времени компиляции), поэтому без опции
+///             SPML_VINCENTY_STATS подсчет итераций и вызовы записи исключаются компилятором.
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+/// \addtogroup spml
+/// \{
+///
+
+#ifndef SPML_VINCENTY_STATS_IMPL_H
+#define SPML_VINCENTY_STATS_IMPL_H
+
+// SPML includes:
+#include <vincenty_stats.h>
+
+namespace SPML /// Специальная библиотека программных модулей (СБ ПМ)
+{
+namespace Geodesy /// Геодезические функции и функции перевода координат
+{
+//----------------------------------------------------------------------------------------------------------------------
+#if defined( SPML_VINCENTY_STATS )
+static constexpr bool CollectVincentyStats = true;  ///< Сбор статистики включен при сборке
+#else
+static constexpr bool CollectVincentyStats = false; ///< Сбор статистики исключен при сборке
+#endif
+
+///
+/// \brief Исход итераций одного решения
+///
+enum TVincentyOutcome : int
+{
+    VO_Converged = 0,   ///< Сходимость
+    VO_NotConverged,    ///< Выход по пределу числа итераций
+    VO_Coincident       ///< Ранний выход для совпадающих точек
+};
+
+///
+/// \brief Запись решения обратной задачи в счетчики текущего потока
+/// \param[in] iterations - число выполненных итераций
+/// \param[in] outcome    - исход итераций
+///
+void RecordVincentyInverse( unsigned iterations, TVincentyOutcome outcome );
+
+///
+/// \brief Запись решения прямой задачи в счетчики текущего потока
+/// \param[in] iterations - число выполненных итераций
+/// \param[in] outcome    - исход итераций
+///
+void RecordVincentyDirect( unsigned iterations, TVincentyOutcome outcome );
+
+} // end namespace Geodesy
+} // end namespace SPML
+#endif // SPML_VINCENTY_STATS_IMPL_H
+/// \}
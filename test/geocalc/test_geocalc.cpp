@@ -0,0 +1,482 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       test_geocalc.cpp
+/// \brief      Тесты потокового режима geocalc: разбор строк, печать чисел, столбцовый формат, отображение файлов в
+///             память и сервер на локальном сокете
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+//#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_geocalc
+// Boost includes:
+#include <boost/test/unit_test.hpp>
+
+// System includes:
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// SPML includes:
+#include <geodesy.h>
+
+// GEOCALC includes:
+#include <columnar.h>
+#include <mapped.h>
+#include <serve.h>
+#include <stream.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+// Настройки потокового режима задачи name (километры, градусы, WGS84)
+static GeoCalc::TStreamSettings Settings( const std::string &name, int precision )
+{
+    return GeoCalc::TStreamSettings{ GeoCalc::FindStreamOperation( name ), SPML::Geodesy::Ellipsoids::WGS84(),
+        SPML::Units::RU_Kilometer, SPML::Units::AU_Degree, precision };
+}
+
+// Путь временного файла теста
+static std::string TempPath( const std::string &name )
+{
+    return "/tmp/test_geocalc_" + std::to_string( getpid() ) + "_" + name;
+}
+
+// Запись текста в файл
+static void WriteFile( const std::string &path, const std::string &text )
+{
+    std::FILE *file = std::fopen( path.c_str(), "wb" );
+    BOOST_REQUIRE( file != nullptr );
+    BOOST_REQUIRE_EQUAL( std::fwrite( text.data(), 1, text.size(), file ), text.size() );
+    std::fclose( file );
+}
+
+// Чтение всего файла с начала
+static std::string ReadAll( std::FILE *file )
+{
+    std::rewind( file );
+    std::string text;
+    char bytes[4096];
+    std::size_t size;
+    while( ( size = std::fread( bytes, 1, sizeof( bytes ), file ) ) > 0 ) {
+        text.append( bytes, size );
+    }
+    return text;
+}
+
+static std::string ReadFile( const std::string &path )
+{
+    std::FILE *file = std::fopen( path.c_str(), "rb" );
+    BOOST_REQUIRE( file != nullptr );
+    const std::string text = ReadAll( file );
+    std::fclose( file );
+    return text;
+}
+
+// Временный файл с текстом (удаляется при закрытии)
+static std::FILE *TempFile( const std::string &text )
+{
+    std::FILE *file = std::tmpfile();
+    BOOST_REQUIRE( file != nullptr );
+    BOOST_REQUIRE_EQUAL( std::fwrite( text.data(), 1, text.size(), file ), text.size() );
+    std::rewind( file );
+    return file;
+}
+
+// Потоковая обработка текста или двоичного файла input, результат - содержимое вывода
+static std::string Stream( const std::string &input, const GeoCalc::TStreamSettings &settings, int &result )
+{
+    std::FILE *in = TempFile( input );
+    std::FILE *out = std::tmpfile();
+    BOOST_REQUIRE( out != nullptr );
+    result = GeoCalc::RunStream( in, out, settings );
+    const std::string output = ReadAll( out );
+    std::fclose( in );
+    std::fclose( out );
+    return output;
+}
+
+// Записи geo2rad (широта и долгота двух точек) текстом с кратчайшей записью чисел
+static std::string Geo2RadRecords( std::size_t count )
+{
+    std::mt19937 gen( 7 );
+    std::uniform_real_distribution<double> lat( -80.0, 80.0 );
+    std::uniform_real_distribution<double> lon( -180.0, 180.0 );
+    GeoCalc::CTextBuffer text;
+    for( std::size_t i = 0; i < count; i++ ) {
+        text.Append( lat( gen ), -1 );
+        text.Append( ' ' );
+        text.Append( lon( gen ), -1 );
+        text.Append( ' ' );
+        text.Append( lat( gen ), -1 );
+        text.Append( ' ' );
+        text.Append( lon( gen ), -1 );
+        text.Append( '\n' );
+    }
+    return std::string( text.Data(), text.Size() );
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE( test_suite_StreamText )
+
+BOOST_AUTO_TEST_CASE( test_ParseNumber )
+{
+    const std::string text = "+12.5e1;-3 x";
+    double value = 0.0;
+    const char *next = GeoCalc::ParseNumber( text.data(), text.data() + text.size(), value );
+    BOOST_REQUIRE( next != nullptr );
+    BOOST_CHECK_EQUAL( value, 125.0 );
+    BOOST_CHECK_EQUAL( *next, ';' );
+    next = GeoCalc::ParseNumber( next + 1, text.data() + text.size(), value );
+    BOOST_REQUIRE( next != nullptr );
+    BOOST_CHECK_EQUAL( value, -3.0 );
+    BOOST_CHECK( GeoCalc::ParseNumber( next + 1, text.data() + text.size(), value ) == nullptr );
+
+    // Знак '+' только перед цифрой или точкой
+    for( const std::string wrong : { "+-5", "++5", "+", "+nan", "+inf", "+ 5" } ) {
+        BOOST_CHECK( GeoCalc::ParseNumber( wrong.data(), wrong.data() + wrong.size(), value ) == nullptr );
+    }
+    const std::string point = "+.5";
+    BOOST_REQUIRE( GeoCalc::ParseNumber( point.data(), point.data() + point.size(), value ) != nullptr );
+    BOOST_CHECK_EQUAL( value, 0.5 );
+}
+
+BOOST_AUTO_TEST_CASE( test_IsRecordLine )
+{
+    const auto isRecord = []( const std::string &line ) {
+        return GeoCalc::IsRecordLine( line.data(), line.data() + line.size() );
+    };
+    BOOST_CHECK( isRecord( "1 2" ) );
+    BOOST_CHECK( isRecord( " \t,;1" ) );
+    BOOST_CHECK( !isRecord( "" ) );
+    BOOST_CHECK( !isRecord( " \t,;\r" ) );
+    BOOST_CHECK( !isRecord( "# 1 2 3 4" ) );
+    BOOST_CHECK( !isRecord( "  # comment" ) );
+}
+
+BOOST_AUTO_TEST_CASE( test_Lines )
+{
+    // Перевод формата: результат - сами записи, неверные строки - nan
+    GeoCalc::TStreamSettings settings = Settings( "geo2rad", 2 );
+    settings.Convert = true;
+    GeoCalc::CStreamProcessor processor( settings );
+    const char *lines[] = { "1 2 3 4", "# comment", "", "1,2;3\t4\r", "  +5 6 7 8", "1 2 3", "1 2 x 4",
+        "1 2 3 4 5", ",;\t" };
+    for( const char *line : lines ) {
+        processor.Line( line, line + std::strlen( line ) );
+    }
+    processor.Flush();
+    BOOST_CHECK_EQUAL( processor.Records(), 6u );
+    BOOST_CHECK_EQUAL( processor.Errors(), 3u );
+    BOOST_CHECK_EQUAL( std::string( processor.Output().Data(), processor.Output().Size() ),
+        "1.00 2.00 3.00 4.00\n1.00 2.00 3.00 4.00\n5.00 6.00 7.00 8.00\n"
+        "nan nan nan nan\nnan nan nan nan\nnan nan nan nan\n" );
+}
+
+BOOST_AUTO_TEST_CASE( test_TextBuffer_Fixed )
+{
+    // Печать to_chars совпадает с прежней печатью std::fixed и setprecision
+    std::mt19937 gen( 3 );
+    std::uniform_real_distribution<double> mantissa( -10.0, 10.0 );
+    std::uniform_int_distribution<int> exponent( -12, 12 );
+    std::vector<double> values = { 0.0, -0.0, 0.125, 2.5, -2.5, 0.0005, 1.0e20, 6378137.0, 1.0 / 3.0 };
+    for( int i = 0; i < 2000; i++ ) {
+        values.push_back( mantissa( gen ) * std::pow( 10.0, exponent( gen ) ) );
+    }
+    GeoCalc::CTextBuffer buffer;
+    for( int precision = 0; precision <= 12; precision++ ) {
+        for( double value : values ) {
+            std::ostringstream expected;
+            expected << std::fixed << std::setprecision( precision ) << value;
+            buffer.Clear();
+            buffer.Append( value, precision );
+            BOOST_REQUIRE_EQUAL( std::string( buffer.Data(), buffer.Size() ), expected.str() );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_TextBuffer_Shortest )
+{
+    // Кратчайшая запись читается без потери точности
+    std::mt19937 gen( 5 );
+    std::uniform_real_distribution<double> value( -1.0e7, 1.0e7 );
+    GeoCalc::CTextBuffer buffer;
+    for( int i = 0; i < 1000; i++ ) {
+        const double x = value( gen );
+        buffer.Clear();
+        buffer.Append( x, -1 );
+        double parsed = 0.0;
+        BOOST_REQUIRE( GeoCalc::ParseNumber( buffer.Data(), buffer.Data() + buffer.Size(), parsed ) != nullptr );
+        BOOST_REQUIRE_EQUAL( parsed, x );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//----------------------------------------------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE( test_suite_Columnar )
+
+BOOST_AUTO_TEST_CASE( test_Header )
+{
+    GeoCalc::TColumnarHeader header;
+    header.BlockSize = 1000;
+    header.Operation = "geo2rad";
+    header.Kind = GeoCalc::CK_Results;
+    header.Columns = 3;
+    header.RangeUnit = SPML::Units::RU_Meter;
+    header.AngleUnit = SPML::Units::AU_Radian;
+    header.Count = 12345;
+    header.Ellipsoid = SPML::Geodesy::Ellipsoids::PZ90();
+    char bytes[GeoCalc::TColumnarHeader::Size];
+    GeoCalc::EncodeColumnarHeader( header, bytes );
+
+    GeoCalc::TColumnarHeader decoded;
+    std::string error;
+    BOOST_REQUIRE( GeoCalc::DecodeColumnarHeader( bytes, decoded, error ) );
+    BOOST_CHECK_EQUAL( decoded.BlockSize, header.BlockSize );
+    BOOST_CHECK_EQUAL( decoded.Operation, header.Operation );
+    BOOST_CHECK_EQUAL( decoded.Kind, header.Kind );
+    BOOST_CHECK_EQUAL( decoded.Columns, header.Columns );
+    BOOST_CHECK_EQUAL( decoded.RangeUnit, header.RangeUnit );
+    BOOST_CHECK_EQUAL( decoded.AngleUnit, header.AngleUnit );
+    BOOST_CHECK_EQUAL( decoded.Count, header.Count );
+    BOOST_CHECK_EQUAL( decoded.Ellipsoid.Name(), header.Ellipsoid.Name() );
+    BOOST_CHECK_EQUAL( decoded.Ellipsoid.A(), header.Ellipsoid.A() );
+    BOOST_CHECK_EQUAL( decoded.Ellipsoid.Invf(), header.Ellipsoid.Invf() );
+
+    // Эллипсоид не из реестра: сохраняются только A и Invf
+    header.Ellipsoid = SPML::Geodesy::CEllipsoid( "Custom", 6378000.0, 0.0, 299.0, true );
+    GeoCalc::EncodeColumnarHeader( header, bytes );
+    BOOST_REQUIRE( GeoCalc::DecodeColumnarHeader( bytes, decoded, error ) );
+    BOOST_CHECK_EQUAL( decoded.Ellipsoid.A(), 6378000.0 );
+    BOOST_CHECK_EQUAL( decoded.Ellipsoid.Invf(), 299.0 );
+
+    // Неверные параметры эллипсоида не из реестра
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    const double wrong[][2] = { { -1.0, 298.0 }, { 0.0, 298.0 }, { nan, 298.0 }, { inf, 298.0 },
+        { 6378137.0, -1.0 }, { 6378137.0, nan }, { 6378137.0, inf } };
+    for( const double *ellipsoid : wrong ) {
+        header.Ellipsoid = SPML::Geodesy::CEllipsoid( "", ellipsoid[0], 0.0, ellipsoid[1], true );
+        GeoCalc::EncodeColumnarHeader( header, bytes );
+        BOOST_CHECK( !GeoCalc::DecodeColumnarHeader( bytes, decoded, error ) );
+    }
+
+    // Эллипсоид реестра с другими параметрами
+    header.Ellipsoid = SPML::Geodesy::Ellipsoids::WGS84();
+    GeoCalc::EncodeColumnarHeader( header, bytes );
+    bytes[64] ^= 1;
+    BOOST_CHECK( !GeoCalc::DecodeColumnarHeader( bytes, decoded, error ) );
+}
+
+BOOST_AUTO_TEST_CASE( test_Header_BlockSize )
+{
+    GeoCalc::TColumnarHeader header;
+    header.Operation = "geo2rad";
+    header.Columns = 4;
+    header.Ellipsoid = SPML::Geodesy::Ellipsoids::WGS84();
+    char bytes[GeoCalc::TColumnarHeader::Size];
+    GeoCalc::TColumnarHeader decoded;
+    std::string error;
+    for( std::uint32_t blockSize : { 0u, GeoCalc::TColumnarHeader::MaxBlockSize + 1 } ) {
+        header.BlockSize = blockSize;
+        GeoCalc::EncodeColumnarHeader( header, bytes );
+        BOOST_CHECK( !GeoCalc::DecodeColumnarHeader( bytes, decoded, error ) );
+    }
+    header.BlockSize = GeoCalc::TColumnarHeader::MaxBlockSize;
+    GeoCalc::EncodeColumnarHeader( header, bytes );
+    BOOST_CHECK( GeoCalc::DecodeColumnarHeader( bytes, decoded, error ) );
+}
+
+BOOST_AUTO_TEST_CASE( test_Records )
+{
+    // Неполный последний блок: записи на своих местах после записи и чтения
+    GeoCalc::TColumnarHeader header;
+    header.BlockSize = 5;
+    header.Columns = 2;
+    header.Count = 13;
+    std::vector<double> a( 13 ), b( 13 ), ra( 13 ), rb( 13 );
+    for( std::size_t i = 0; i < 13; i++ ) {
+        a[i] = static_cast<double>( i );
+        b[i] = -static_cast<double>( i ) * 0.5;
+    }
+    std::vector<char> bytes( GeoCalc::TColumnarHeader::Size + 8 * 2 * 13 );
+    const double *columns[] = { a.data(), b.data() };
+    GeoCalc::EncodeRecords( columns, header, 0, 13, bytes.data() );
+    double *read[] = { ra.data(), rb.data() };
+    GeoCalc::DecodeRecords( bytes.data(), header, 0, 13, read );
+    BOOST_CHECK( ra == a );
+    BOOST_CHECK( rb == b );
+    // Запись 12 - третья в последнем блоке из 3 записей, после двух полных блоков по 10 чисел
+    BOOST_CHECK_EQUAL( GeoCalc::ColumnarOffset( 5, 2, 13, 12, 1 ),
+        GeoCalc::TColumnarHeader::Size + 8 * ( 20 + 3 + 2 ) );
+}
+
+BOOST_AUTO_TEST_CASE( test_RoundTrip )
+{
+    // Текст -> двоичный файл -> текст, последний блок неполный
+    const std::size_t count = 2 * GeoCalc::CStreamProcessor::BlockSize + 17;
+    const std::string text = Geo2RadRecords( count );
+    GeoCalc::TStreamSettings settings = Settings( "geo2rad", -1 );
+    settings.Convert = true;
+    settings.OutputFormat = GeoCalc::SF_Binary;
+    int result;
+    std::string binary = Stream( text, settings, result );
+    BOOST_REQUIRE_EQUAL( result, EXIT_SUCCESS );
+    BOOST_REQUIRE_EQUAL( binary.size(), GeoCalc::TColumnarHeader::Size + 8 * 4 * count );
+    GeoCalc::TColumnarHeader header;
+    std::string error;
+    BOOST_REQUIRE( GeoCalc::DecodeColumnarHeader( binary.data(), header, error ) );
+    BOOST_CHECK_EQUAL( header.Count, count );
+
+    settings.InputFormat = GeoCalc::SF_Binary;
+    settings.OutputFormat = GeoCalc::SF_Text;
+    BOOST_CHECK( Stream( binary, settings, result ) == text );
+    BOOST_CHECK_EQUAL( result, EXIT_SUCCESS );
+
+    // Число записей не известно (вывод в канал): блоки до конца файла
+    header.Count = GeoCalc::TColumnarHeader::UnknownCount;
+    GeoCalc::EncodeColumnarHeader( header, &binary[0] );
+    BOOST_CHECK( Stream( binary, settings, result ) == text );
+    BOOST_CHECK_EQUAL( result, EXIT_SUCCESS );
+
+    // Файл обрывается внутри блока
+    binary.resize( binary.size() - 8 );
+    Stream( binary, settings, result );
+    BOOST_CHECK_EQUAL( result, EXIT_FAILURE );
+}
+
+BOOST_AUTO_TEST_CASE( test_Results )
+{
+    // Решение с двоичным выводом и перевод результатов в текст совпадает с решением с текстовым выводом
+    const std::string text = Geo2RadRecords( GeoCalc::CStreamProcessor::BlockSize + 3 );
+    GeoCalc::TStreamSettings settings = Settings( "geo2rad", -1 );
+    int result;
+    const std::string expected = Stream( text, settings, result );
+    settings.OutputFormat = GeoCalc::SF_Binary;
+    const std::string binary = Stream( text, settings, result );
+    settings.Convert = true;
+    settings.Kind = GeoCalc::CK_Results;
+    settings.InputFormat = GeoCalc::SF_Binary;
+    settings.OutputFormat = GeoCalc::SF_Text;
+    BOOST_CHECK( Stream( binary, settings, result ) == expected );
+    BOOST_CHECK_EQUAL( result, EXIT_SUCCESS );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//----------------------------------------------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE( test_suite_Mapped )
+
+BOOST_AUTO_TEST_CASE( test_MappedEqualsStream )
+{
+    // Текст с комментариями и неверными строками, частей больше, чем потоков
+    std::string text = "# geo2rad\n" + Geo2RadRecords( 3 * GeoCalc::CStreamProcessor::BlockSize + 5 );
+    text.insert( text.find( '\n', text.size() / 2 ) + 1, "1 2 3\n\n" );
+    text += "1 2 3 4"; // Без '\n' в конце
+    const std::string input = TempPath( "mapped_in" );
+    const std::string output = TempPath( "mapped_out" );
+    WriteFile( input, text );
+    for( GeoCalc::TStreamFormat format : { GeoCalc::SF_Text, GeoCalc::SF_Binary } ) {
+        GeoCalc::TStreamSettings settings = Settings( "geo2rad", 6 );
+        settings.OutputFormat = format;
+        int streamResult;
+        const std::string expected = Stream( text, settings, streamResult );
+        BOOST_CHECK_EQUAL( GeoCalc::RunMapped( input, output, settings ), streamResult );
+        BOOST_CHECK( ReadFile( output ) == expected );
+    }
+
+    // Файл вывода совпадает с файлом ввода: ошибка, ввод не изменен
+    BOOST_CHECK_EQUAL( GeoCalc::RunMapped( input, input, Settings( "geo2rad", 6 ) ), EXIT_FAILURE );
+    BOOST_CHECK( ReadFile( input ) == text );
+    std::remove( input.c_str() );
+    std::remove( output.c_str() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//----------------------------------------------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE( test_suite_Serve )
+
+BOOST_AUTO_TEST_CASE( test_Serve )
+{
+    const std::string path = TempPath( "serve.sock" );
+    GeoCalc::CServer server( path, 200 );
+    std::string error;
+    BOOST_REQUIRE_MESSAGE( server.Start( error ), error );
+
+    // Простаивающее соединение не мешает другим и закрывается по истечении ожидания
+    sockaddr_un address;
+    std::memset( &address, 0, sizeof( address ) );
+    address.sun_family = AF_UNIX;
+    std::memcpy( address.sun_path, path.data(), path.size() );
+    const int idle = socket( AF_UNIX, SOCK_STREAM, 0 );
+    BOOST_REQUIRE( connect( idle, reinterpret_cast<const sockaddr *>( &address ), sizeof( address ) ) == 0 );
+    BOOST_REQUIRE( send( idle, "GEO", 3, 0 ) == 3 );
+
+    // Пакет из нескольких блоков совпадает с решением без сервера
+    const std::size_t count = GeoCalc::CStreamProcessor::BlockSize + 100;
+    std::mt19937 gen( 11 );
+    std::uniform_real_distribution<double> lat( -80.0, 80.0 );
+    std::uniform_real_distribution<double> lon( -180.0, 180.0 );
+    std::vector<double> columns[4], results[3], expected[3];
+    for( std::size_t i = 0; i < 4; i++ ) {
+        columns[i].resize( count );
+        for( double &value : columns[i] ) {
+            value = ( i % 2 == 0 ) ? lat( gen ) : lon( gen );
+        }
+    }
+    for( std::size_t i = 0; i < 3; i++ ) {
+        results[i].resize( count );
+        expected[i].resize( count );
+    }
+    const double *in[] = { columns[0].data(), columns[1].data(), columns[2].data(), columns[3].data() };
+    double *out[] = { results[0].data(), results[1].data(), results[2].data() };
+    double *direct[] = { expected[0].data(), expected[1].data(), expected[2].data() };
+    const GeoCalc::TStreamSettings settings = Settings( "geo2rad", -1 );
+    settings.Operation->Solve( settings, count, in, direct );
+
+    GeoCalc::TColumnarHeader task;
+    task.Operation = "geo2rad";
+    task.Ellipsoid = settings.Ellipsoid;
+    task.RangeUnit = settings.RangeUnit;
+    task.AngleUnit = settings.AngleUnit;
+    GeoCalc::CServeClient client;
+    BOOST_REQUIRE_MESSAGE( client.Connect( path, error ), error );
+    for( int request = 0; request < 3; request++ ) {
+        BOOST_REQUIRE_MESSAGE( client.Solve( task, in, count, out, error ), error );
+        for( std::size_t i = 0; i < 3; i++ ) {
+            BOOST_CHECK( results[i] == expected[i] );
+        }
+    }
+    BOOST_REQUIRE_MESSAGE( client.Solve( task, in, 0, out, error ), error );
+
+    // Ответ с ошибкой закрывает соединение
+    task.Ellipsoid = SPML::Geodesy::CEllipsoid( "", 6378137.0, 0.0, 0.5, true );
+    BOOST_CHECK( !client.Solve( task, in, 10, out, error ) );
+    BOOST_CHECK_EQUAL( error, "запрос не соответствует задаче/request does not match the task" );
+    task.Ellipsoid = settings.Ellipsoid;
+    BOOST_CHECK( !client.Solve( task, in, 10, out, error ) );
+    BOOST_REQUIRE_MESSAGE( client.Connect( path, error ), error );
+    BOOST_CHECK_MESSAGE( client.Solve( task, in, 10, out, error ), error );
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 400 ) );
+    char byte;
+    BOOST_CHECK_EQUAL( recv( idle, &byte, 1, 0 ), 0 );
+    close( idle );
+
+    server.Stop();
+    server.Wait();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,134 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       test_spml_batch_check.h
+/// \brief      Общие средства тестов пакетных функций библиотеки spml: сравнение пакетной функции со скалярной на
+///             всех доступных уровнях векторизации для набора эллипсоидов, единиц измерения и чисел потоков
+/// \details    Набор параметров (TBatchConfig) задается таблицей и проверяется одним BOOST_DATA_TEST_CASE на
+///             набор тестов; отдельные тесты остаются только для особенностей ядра (на месте, хвосты, невыровненные
+///             массивы, потоковая запись)
+/// \date       16.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+#ifndef TEST_SPML_BATCH_CHECK_H
+#define TEST_SPML_BATCH_CHECK_H
+
+// Boost includes:
+#include <boost/test/unit_test.hpp>
+
+// System includes:
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+// SPML includes:
+#include <geodesy.h>
+#include <simd.h>
+#include <units.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+// Все уровни векторизации, доступные на данном процессоре
+inline std::vector<SPML::SIMD::TSimdLevel> SupportedLevels()
+{
+    std::vector<SPML::SIMD::TSimdLevel> levels;
+    for( int l = SPML::SIMD::SL_Scalar; l <= SPML::SIMD::SL_AVX512; l++ ) {
+        if( SPML::SIMD::IsSupported( static_cast<SPML::SIMD::TSimdLevel>( l ) ) ) {
+            levels.push_back( static_cast<SPML::SIMD::TSimdLevel>( l ) );
+        }
+    }
+    return levels;
+}
+
+// Разность азимутов с учетом перехода через 0
+inline double AngleDiff( double a1, double a2, double full )
+{
+    double diff = std::abs( a1 - a2 );
+    return std::min( diff, full - diff );
+}
+
+// Параметры сравнения пакетной функции со скалярной
+struct TBatchConfig
+{
+    const SPML::Geodesy::CEllipsoid &( *Ellipsoid )();  // Эллипсоид реестра (SPML::Geodesy::Ellipsoids)
+    SPML::Units::TRangeUnit RangeUnit;                  // Единицы дальности
+    SPML::Units::TAngleUnit AngleUnit;                  // Единицы углов
+    std::size_t Count;                                  // Число точек
+    unsigned int Threads;                               // Число потоков пула
+    double Lat = 0.0;                                   // Опорная точка (где нужна), [град]
+    double Lon = 0.0;                                   // [град]
+    double Height = 0.0;                                // [м]
+
+    // Множитель перевода градусов в единицы углов
+    double ToAngle() const
+    {
+        return ( AngleUnit == SPML::Units::AU_Degree ) ? 1.0 : SPML::Convert::DgToRdD;
+    }
+
+    // Множитель перевода метров в единицы дальности
+    double ToRange() const
+    {
+        return ( RangeUnit == SPML::Units::RU_Meter ) ? 1.0 : 0.001;
+    }
+
+    // Допуск по углу в единицах углов по допуску в радианах
+    double AngleEps( double epsRad ) const
+    {
+        return epsRad * ( ( AngleUnit == SPML::Units::AU_Degree ) ? SPML::Convert::RdToDgD : 1.0 );
+    }
+};
+
+// Имя набора параметров в сообщениях Boost.Test, например "WGS84 Kilometer Degree n=1003 threads=1"
+inline std::ostream &operator<<( std::ostream &stream, const TBatchConfig &config )
+{
+    return stream << config.Ellipsoid().Name() << ( ( config.RangeUnit == SPML::Units::RU_Meter ) ? " Meter" :
+        " Kilometer" ) << ( ( config.AngleUnit == SPML::Units::AU_Degree ) ? " Degree" : " Radian" ) << " n=" <<
+        config.Count << " threads=" << config.Threads;
+}
+
+// Допуск сравнения одного результата: Eps < 0 - не сравнивается, Full > 0 - угол с периодом Full
+struct TBatchTolerance
+{
+    double Eps;
+    double Full = 0.0;
+};
+
+// Сравнение пакетной функции со скалярной на всех доступных уровнях векторизации
+// batch( level, out )           - пакетная функция: outputs массивов out по n результатов
+// scalar( i, expected )         - скалярная функция для точки i: outputs результатов double
+// tolerance( i, k, expected )   - допуск результата k точки i (TBatchTolerance)
+// offset                        - сдвиг выходных массивов относительно выровненного начала
+template<class T, class TBatch, class TScalar, class TTolerance>
+void CheckAgainstScalar( std::size_t n, std::size_t outputs, TBatch batch, TScalar scalar, TTolerance tolerance,
+    std::size_t offset = 0 )
+{
+    static const std::size_t maxOutputs = 3;
+    BOOST_REQUIRE( outputs <= maxOutputs );
+    for( SPML::SIMD::TSimdLevel level : SupportedLevels() ) {
+        SPML::SIMD::AlignedVector<T> results[maxOutputs];
+        T *out[maxOutputs] = {};
+        for( std::size_t k = 0; k < outputs; k++ ) {
+            results[k].resize( n + offset );
+            out[k] = results[k].data() + offset;
+        }
+        batch( level, out );
+        for( std::size_t i = 0; i < n; i++ ) {
+            double expected[maxOutputs];
+            scalar( i, expected );
+            for( std::size_t k = 0; k < outputs; k++ ) {
+                const TBatchTolerance eps = tolerance( i, k, expected );
+                if( eps.Eps < 0.0 ) {
+                    continue;
+                }
+                const double value = static_cast<double>( out[k][i] );
+                BOOST_TEST_CONTEXT( SPML::SIMD::Name( level ) << " i=" << i << " k=" << k ) {
+                    BOOST_CHECK_SMALL( ( eps.Full > 0.0 ) ? AngleDiff( value, expected[k], eps.Full ) :
+                        value - expected[k], eps.Eps );
+                }
+            }
+        }
+    }
+}
+
+#endif // TEST_SPML_BATCH_CHECK_H
@@ -12,13 +12,24 @@
 #include <boost/test/unit_test.hpp>
 
 // System includes:
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <chrono>
 #include <thread>
+#include <cctype>
+#include <random>
+#include <vector>
 
 // SPML includes:
+#include <geodesic.h>
+#include <geodesic_line.h>
+#include <geofence.h>
 #include <geodesy.h>
+#include <geodesy_batch.h>
+#include <local_frame.h>
+#include <spatial_index.h>
+#include <vincenty_stats.h>
 //----------------------------------------------------------------------------------------------------------------------
 
 BOOST_AUTO_TEST_SUITE( test_suite_GEOtoRAD )
@@ -532,6 +543,17 @@ BOOST_AUTO_TEST_CASE( test_MolodenskyStandard_1 )
     int abc1 = 0;
 }
 
+BOOST_AUTO_TEST_CASE( test_IsShiftECEF_7Defined )
+{
+    using SPML::Geodesy::TGeodeticDatum;
+    BOOST_CHECK( SPML::Geodesy::IsShiftECEF_7Defined( TGeodeticDatum::GD_WGS84, TGeodeticDatum::GD_PZ9011 ) );
+    BOOST_CHECK( SPML::Geodesy::IsShiftECEF_7Defined( TGeodeticDatum::GD_PZ9011, TGeodeticDatum::GD_SK42 ) );
+    BOOST_CHECK( SPML::Geodesy::IsShiftECEF_7Defined( TGeodeticDatum::GD_ITRF2008, TGeodeticDatum::GD_PZ9011 ) );
+    BOOST_CHECK( !SPML::Geodesy::IsShiftECEF_7Defined( TGeodeticDatum::GD_WGS84, TGeodeticDatum::GD_WGS84 ) );
+    BOOST_CHECK( !SPML::Geodesy::IsShiftECEF_7Defined( TGeodeticDatum::GD_WGS84, TGeodeticDatum::GD_ITRF2008 ) );
+    BOOST_CHECK( !SPML::Geodesy::IsShiftECEF_7Defined( TGeodeticDatum::GD_AGD66, TGeodeticDatum::GD_PZ9011 ) );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 //----------------------------------------------------------------------------------------------------------------------
 BOOST_AUTO_TEST_SUITE( test_suite_GaussKruger )
@@ -703,3 +725,737 @@ BOOST_AUTO_TEST_CASE( test_using_7_params_shift_BursaWolf )
 }
 
 BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_CEllipsoid )
+
+BOOST_AUTO_TEST_CASE( test_DerivedConstants )
+{
+    // Производные параметры рассчитываются при создании эллипсоида и совпадают с расчетом по определению
+    for( const SPML::Geodesy::CEllipsoid &el : SPML::Geodesy::Ellipsoids::GetPredefinedEllipsoids() ) {
+        double a = el.A();
+        double b = el.B();
+        double es = 1.0 - ( ( b * b ) / ( a * a ) );
+        BOOST_CHECK_EQUAL( el.EccentricityFirstSquared(), es );
+        BOOST_CHECK_EQUAL( el.EccentricitySecondSquared(), ( ( a * a ) / ( b * b ) ) - 1.0 );
+        BOOST_CHECK_EQUAL( el.EccentricityFirst(), std::sqrt( ( a * a ) - ( b * b ) ) / a );
+        BOOST_CHECK_EQUAL( el.EccentricitySecond(), std::sqrt( ( a * a ) - ( b * b ) ) / b );
+        BOOST_CHECK_EQUAL( el.OneMinusF(), 1.0 - el.F() );
+        BOOST_CHECK_EQUAL( el.AxisRatio(), b / a );
+        BOOST_CHECK_EQUAL( el.Olson().a1, a * es );
+        BOOST_CHECK_EQUAL( el.Olson().a2, ( a * es ) * ( a * es ) );
+        BOOST_CHECK_EQUAL( el.Olson().a6, 1.0 - es );
+    }
+    // Значения для WGS84 (ранее заданные в ECEFtoGEO константами)
+    SPML::Geodesy::CEllipsoid wgs84 = SPML::Geodesy::Ellipsoids::WGS84();
+    BOOST_CHECK_CLOSE_FRACTION( wgs84.Olson().a1, 4.2697672707157535e+4, 1.0e-10 );
+    BOOST_CHECK_CLOSE_FRACTION( wgs84.Olson().a3, 1.4291722289812413e+2, 1.0e-10 );
+    BOOST_CHECK_CLOSE_FRACTION( wgs84.Olson().a5, 4.2840589930055659e+4, 1.0e-10 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_UnitsTemplates )
+
+BOOST_AUTO_TEST_CASE( test_Templates_vs_Runtime )
+{
+    // Специализации по единицам измерения дают тот же результат, что и функции с единицами во время выполнения
+    SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    double d1, az1, azEnd1, d2, az2, azEnd2;
+    SPML::Geodesy::GEOtoRAD( el, SPML::Units::TRangeUnit::RU_Kilometer, SPML::Units::TAngleUnit::AU_Degree,
+        55.75, 37.62, 59.94, 30.31, d1, az1, azEnd1 );
+    SPML::Geodesy::GEOtoRAD<SPML::Units::TRangeUnit::RU_Kilometer, SPML::Units::TAngleUnit::AU_Degree>( el,
+        55.75, 37.62, 59.94, 30.31, d2, az2, azEnd2 );
+    BOOST_CHECK_EQUAL( d1, d2 );
+    BOOST_CHECK_EQUAL( az1, az2 );
+    BOOST_CHECK_EQUAL( azEnd1, azEnd2 );
+
+    double x1, y1, z1, x2, y2, z2;
+    SPML::Geodesy::AERtoECEF( el, SPML::Units::TRangeUnit::RU_Meter, SPML::Units::TAngleUnit::AU_Radian,
+        0.7, 0.1, 12000.0, 0.9, 0.6, 150.0, x1, y1, z1 );
+    SPML::Geodesy::AERtoECEF<SPML::Units::TRangeUnit::RU_Meter, SPML::Units::TAngleUnit::AU_Radian>( el,
+        0.7, 0.1, 12000.0, 0.9, 0.6, 150.0, x2, y2, z2 );
+    BOOST_CHECK_EQUAL( x1, x2 );
+    BOOST_CHECK_EQUAL( y1, y2 );
+    BOOST_CHECK_EQUAL( z1, z2 );
+
+    double e1, n1, u1, e2, n2, u2;
+    SPML::Geodesy::ECEFtoENUV( SPML::Units::TRangeUnit::RU_Kilometer, SPML::Units::TAngleUnit::AU_Radian,
+        1.5, -2.0, 0.5, 0.9, 0.6, e1, n1, u1 );
+    SPML::Geodesy::ECEFtoENUV<SPML::Units::TRangeUnit::RU_Kilometer, SPML::Units::TAngleUnit::AU_Radian>(
+        1.5, -2.0, 0.5, 0.9, 0.6, e2, n2, u2 );
+    BOOST_CHECK_EQUAL( e1, e2 );
+    BOOST_CHECK_EQUAL( n1, n2 );
+    BOOST_CHECK_EQUAL( u1, u2 );
+}
+
+BOOST_AUTO_TEST_CASE( test_ECEF_offset_Degree )
+{
+    // Смещение в ECEF при задании углов в градусах совпадает с разностью координат GEOtoECEF
+    SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    double dX, dY, dZ, x1, y1, z1, x2, y2, z2;
+    SPML::Geodesy::ECEF_offset( el, SPML::Units::TRangeUnit::RU_Meter, SPML::Units::TAngleUnit::AU_Degree,
+        55.75, 37.62, 150.0, 55.80, 37.70, 200.0, dX, dY, dZ );
+    SPML::Geodesy::GEOtoECEF( el, SPML::Units::TRangeUnit::RU_Meter, SPML::Units::TAngleUnit::AU_Degree,
+        55.75, 37.62, 150.0, x1, y1, z1 );
+    SPML::Geodesy::GEOtoECEF( el, SPML::Units::TRangeUnit::RU_Meter, SPML::Units::TAngleUnit::AU_Degree,
+        55.80, 37.70, 200.0, x2, y2, z2 );
+    BOOST_CHECK_SMALL( dX - ( x2 - x1 ), 1.0e-6 );
+    BOOST_CHECK_SMALL( dY - ( y2 - y1 ), 1.0e-6 );
+    BOOST_CHECK_SMALL( dZ - ( z2 - z1 ), 1.0e-6 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_Registry )
+
+// Поиск выполняется при компиляции
+static_assert( SPML::Geodesy::FindEllipsoid( "WGS84" )->id == SPML::Geodesy::TEllipsoidId::EL_WGS84, "" );
+static_assert( SPML::Geodesy::FindEllipsoid( 7024 )->id == SPML::Geodesy::TEllipsoidId::EL_Krassowsky1940, "" );
+static_assert( SPML::Geodesy::FindDatum( "sk42" )->ellipsoid == SPML::Geodesy::TEllipsoidId::EL_Krassowsky1940, "" );
+static_assert( SPML::Geodesy::FindDatum( 1158 )->datum == SPML::Geodesy::TGeodeticDatum::GD_PZ9011, "" );
+
+BOOST_AUTO_TEST_CASE( test_Lookup )
+{
+    // Каждая запись находится по короткому имени (без учета регистра) и по коду EPSG
+    for( std::size_t i = 0; i < SPML::Geodesy::TEllipsoidId::EL_Count; i++ ) {
+        const SPML::Geodesy::TEllipsoidParams &p =
+            SPML::Geodesy::EllipsoidParams( static_cast<SPML::Geodesy::TEllipsoidId>( i ) );
+        BOOST_CHECK_EQUAL( p.id, i );
+        BOOST_CHECK_EQUAL( SPML::Geodesy::FindEllipsoid( p.key ), &p );
+        std::string upper( p.key );
+        for( char &c : upper ) {
+            c = static_cast<char>( std::toupper( c ) );
+        }
+        BOOST_CHECK_EQUAL( SPML::Geodesy::FindEllipsoid( upper ), &p );
+        if( p.epsg != 0 ) {
+            BOOST_CHECK_EQUAL( SPML::Geodesy::FindEllipsoid( p.epsg ), &p );
+        }
+    }
+    for( std::size_t i = 0; i < SPML::Geodesy::TGeodeticDatum::GD_Count; i++ ) {
+        const SPML::Geodesy::TDatumParams &p =
+            SPML::Geodesy::DatumParams( static_cast<SPML::Geodesy::TGeodeticDatum>( i ) );
+        BOOST_CHECK_EQUAL( p.datum, i );
+        BOOST_CHECK_EQUAL( SPML::Geodesy::FindDatum( p.key ), &p );
+        BOOST_CHECK_EQUAL( SPML::Geodesy::FindDatum( p.epsg ), &p );
+    }
+    BOOST_CHECK( SPML::Geodesy::FindEllipsoid( "wgs8" ) == nullptr );
+    BOOST_CHECK( SPML::Geodesy::FindEllipsoid( "" ) == nullptr );
+    BOOST_CHECK( SPML::Geodesy::FindEllipsoid( 0 ) == nullptr );
+    BOOST_CHECK( SPML::Geodesy::FindDatum( "sk63" ) == nullptr );
+}
+
+BOOST_AUTO_TEST_CASE( test_Params_vs_CEllipsoid )
+{
+    // Параметры, вычисленные при компиляции, совпадают с вычисленными при создании эллипсоида
+    const std::vector<SPML::Geodesy::CEllipsoid> &ellipsoids = SPML::Geodesy::Ellipsoids::GetPredefinedEllipsoids();
+    BOOST_CHECK_EQUAL( ellipsoids.size(), SPML::Geodesy::TEllipsoidId::EL_Count );
+    for( std::size_t i = 0; i < ellipsoids.size(); i++ ) {
+        const SPML::Geodesy::CEllipsoid &el = ellipsoids[i];
+        const SPML::Geodesy::TEllipsoidParams &p =
+            SPML::Geodesy::EllipsoidParams( static_cast<SPML::Geodesy::TEllipsoidId>( i ) );
+        BOOST_CHECK_EQUAL( &SPML::Geodesy::Ellipsoids::Get( p.id ), &el );
+        BOOST_CHECK_EQUAL( el.Name(), std::string( p.name ) );
+        BOOST_CHECK_EQUAL( el.A(), p.a );
+        BOOST_CHECK_EQUAL( el.B(), p.b );
+        BOOST_CHECK_EQUAL( el.F(), p.f );
+        BOOST_CHECK_EQUAL( el.EccentricityFirstSquared(), p.es1 );
+        BOOST_CHECK_EQUAL( el.EccentricitySecondSquared(), p.es2 );
+        BOOST_CHECK_EQUAL( el.OneMinusF(), p.oneMinusF );
+        BOOST_CHECK_EQUAL( el.AxisRatio(), p.axisRatio );
+        BOOST_CHECK_EQUAL( el.Olson().a1, p.olson.a1 );
+        BOOST_CHECK_EQUAL( el.Olson().a3, p.olson.a3 );
+        BOOST_CHECK_EQUAL( el.Olson().a5, p.olson.a5 );
+        BOOST_CHECK_EQUAL( el.Olson().a6, p.olson.a6 );
+        BOOST_CHECK_EQUAL( p.isSphere, el.A() == el.B() );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_CLocalFrame )
+
+BOOST_AUTO_TEST_CASE( test_Frame_vs_Functions )
+{
+    // Методы CLocalFrame совпадают со свободными функциями для той же опорной точки
+    const SPML::Geodesy::CEllipsoid &el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Units::TRangeUnit ru[2] = { SPML::Units::TRangeUnit::RU_Kilometer, SPML::Units::TRangeUnit::RU_Meter };
+    const SPML::Units::TAngleUnit au[2] = { SPML::Units::TAngleUnit::AU_Degree, SPML::Units::TAngleUnit::AU_Radian };
+    for( int k = 0; k < 2; k++ ) {
+        const double toAngle = ( au[k] == SPML::Units::TAngleUnit::AU_Degree ) ? 1.0 : SPML::Convert::DgToRdD;
+        const double toRange = ( ru[k] == SPML::Units::TRangeUnit::RU_Kilometer ) ? 1.0 : 1000.0;
+        const double lat0 = 55.75 * toAngle, lon0 = 37.62 * toAngle, h0 = 0.15 * toRange;
+        const double lat = 56.10 * toAngle, lon = 36.90 * toAngle, h = 2.5 * toRange;
+        const double eps = 1.0e-9 * toRange;
+        const double epsAngle = 1.0e-12 * toAngle;
+        const SPML::Geodesy::CLocalFrame frame( el, ru[k], au[k], lat0, lon0, h0 );
+
+        double x, y, z;
+        SPML::Geodesy::GEOtoECEF( el, ru[k], au[k], lat, lon, h, x, y, z );
+
+        double e1, n1, u1, e2, n2, u2;
+        SPML::Geodesy::ECEFtoENU( el, ru[k], au[k], x, y, z, lat0, lon0, h0, e1, n1, u1 );
+        frame.ECEFtoENU( x, y, z, e2, n2, u2 );
+        BOOST_CHECK_SMALL( e1 - e2, eps );
+        BOOST_CHECK_SMALL( n1 - n2, eps );
+        BOOST_CHECK_SMALL( u1 - u2, eps );
+
+        SPML::Geodesy::GEOtoENU( el, ru[k], au[k], lat, lon, h, lat0, lon0, h0, e1, n1, u1 );
+        frame.GEOtoENU( lat, lon, h, e2, n2, u2 );
+        BOOST_CHECK_SMALL( e1 - e2, eps );
+        BOOST_CHECK_SMALL( n1 - n2, eps );
+        BOOST_CHECK_SMALL( u1 - u2, eps );
+
+        double x1, y1, z1, x2, y2, z2;
+        SPML::Geodesy::ENUtoECEF( el, ru[k], au[k], e1, n1, u1, lat0, lon0, h0, x1, y1, z1 );
+        frame.ENUtoECEF( e1, n1, u1, x2, y2, z2 );
+        BOOST_CHECK_SMALL( x1 - x2, eps );
+        BOOST_CHECK_SMALL( y1 - y2, eps );
+        BOOST_CHECK_SMALL( z1 - z2, eps );
+
+        double a1, el1, r1, a2, el2, r2;
+        SPML::Geodesy::ECEFtoAER( el, ru[k], au[k], x, y, z, lat0, lon0, h0, a1, el1, r1 );
+        frame.ECEFtoAER( x, y, z, a2, el2, r2 );
+        BOOST_CHECK_SMALL( a1 - a2, epsAngle );
+        BOOST_CHECK_SMALL( el1 - el2, epsAngle );
+        BOOST_CHECK_SMALL( r1 - r2, eps );
+
+        SPML::Geodesy::GEOtoAER( el, ru[k], au[k], lat, lon, h, lat0, lon0, h0, a1, el1, r1 );
+        frame.GEOtoAER( lat, lon, h, a2, el2, r2 );
+        BOOST_CHECK_SMALL( a1 - a2, epsAngle );
+        BOOST_CHECK_SMALL( el1 - el2, epsAngle );
+        BOOST_CHECK_SMALL( r1 - r2, eps );
+
+        SPML::Geodesy::AERtoECEF( el, ru[k], au[k], a1, el1, r1, lat0, lon0, h0, x1, y1, z1 );
+        frame.AERtoECEF( a1, el1, r1, x2, y2, z2 );
+        BOOST_CHECK_SMALL( x1 - x2, eps );
+        BOOST_CHECK_SMALL( y1 - y2, eps );
+        BOOST_CHECK_SMALL( z1 - z2, eps );
+
+        double lat1, lon1, h1, lat2, lon2, h2;
+        SPML::Geodesy::AERtoGEO( el, ru[k], au[k], a1, el1, r1, lat0, lon0, h0, lat1, lon1, h1 );
+        frame.AERtoGEO( a1, el1, r1, lat2, lon2, h2 );
+        BOOST_CHECK_SMALL( lat1 - lat2, epsAngle );
+        BOOST_CHECK_SMALL( lon1 - lon2, epsAngle );
+        BOOST_CHECK_SMALL( h1 - h2, eps );
+        BOOST_CHECK_SMALL( lat - lat2, 1.0e-9 * toAngle );
+        BOOST_CHECK_SMALL( h - h2, 1.0e-6 * toRange );
+
+        SPML::Geodesy::ENUtoGEO( el, ru[k], au[k], e1, n1, u1, lat0, lon0, h0, lat1, lon1, h1 );
+        frame.ENUtoGEO( e1, n1, u1, lat2, lon2, h2 );
+        BOOST_CHECK_SMALL( lat1 - lat2, epsAngle );
+        BOOST_CHECK_SMALL( lon1 - lon2, epsAngle );
+        BOOST_CHECK_SMALL( h1 - h2, eps );
+
+        BOOST_CHECK_SMALL( frame.Anchor().Lat - lat0, epsAngle );
+        BOOST_CHECK_SMALL( frame.Anchor().Height - h0, eps );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_Batch_vs_Scalar )
+{
+    // Пакетные методы дают тот же результат, что и поточечные, в т.ч. при совпадении входных и выходных массивов
+    const SPML::Geodesy::CLocalFrame frame( SPML::Geodesy::Ellipsoids::WGS84(), SPML::Units::TRangeUnit::RU_Kilometer,
+        SPML::Units::TAngleUnit::AU_Degree, 55.75, 37.62, 0.15 );
+    const std::size_t count = 37;
+    std::vector<double> lat( count ), lon( count ), h( count );
+    for( std::size_t i = 0; i < count; i++ ) {
+        lat[i] = 54.0 + 0.1 * static_cast<double>( i );
+        lon[i] = 36.0 + 0.07 * static_cast<double>( i );
+        h[i] = 0.01 * static_cast<double>( i );
+    }
+    std::vector<double> a( count ), el( count ), r( count );
+    frame.GEOtoAER( lat.data(), lon.data(), h.data(), count, a.data(), el.data(), r.data() );
+    for( std::size_t i = 0; i < count; i++ ) {
+        double a1, el1, r1;
+        frame.GEOtoAER( lat[i], lon[i], h[i], a1, el1, r1 );
+        BOOST_CHECK_EQUAL( a[i], a1 );
+        BOOST_CHECK_EQUAL( el[i], el1 );
+        BOOST_CHECK_EQUAL( r[i], r1 );
+    }
+
+    // Цепочка на месте: AER -> ENU -> ECEF -> ENU -> AER -> GEO
+    std::vector<double> p = a, q = el, s = r;
+    frame.AERtoENU( p.data(), q.data(), s.data(), count, p.data(), q.data(), s.data() );
+    frame.ENUtoECEF( p.data(), q.data(), s.data(), count, p.data(), q.data(), s.data() );
+    frame.ECEFtoENU( p.data(), q.data(), s.data(), count, p.data(), q.data(), s.data() );
+    frame.ENUtoAER( p.data(), q.data(), s.data(), count, p.data(), q.data(), s.data() );
+    frame.AERtoGEO( p.data(), q.data(), s.data(), count, p.data(), q.data(), s.data() );
+    for( std::size_t i = 0; i < count; i++ ) {
+        BOOST_CHECK_SMALL( p[i] - lat[i], 1.0e-9 );
+        BOOST_CHECK_SMALL( q[i] - lon[i], 1.0e-9 );
+        BOOST_CHECK_SMALL( s[i] - h[i], 1.0e-8 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_CGeodesic )
+
+const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+const SPML::Geodesy::CGeodesic geodesic( el, SPML::Units::TRangeUnit::RU_Meter, SPML::Units::TAngleUnit::AU_Degree );
+
+// Разность азимутов с учетом перехода через 0/360 град
+static double AzDiff( double az1, double az2 )
+{
+    return std::remainder( az1 - az2, 360.0 );
+}
+
+BOOST_AUTO_TEST_CASE( test_Reference )
+{
+    // Karney (2013), Веллингтон - Саламанка (почти антиподальные точки)
+    double d, az, azEnd;
+    geodesic.Inverse( -41.32, 174.81, 40.96, -5.50, d, az, azEnd );
+    BOOST_CHECK_SMALL( d - 19959679.26735, 1.0e-4 );
+    BOOST_CHECK_SMALL( az - 161.06766998615, 1.0e-9 );
+    BOOST_CHECK_SMALL( azEnd - 18.82519512261, 1.0e-8 );
+
+    // Антиподальные точки на экваторе и полюсы: половина меридиана
+    double dPoles, az1, az2;
+    geodesic.Inverse( 90.0, 0.0, -90.0, 0.0, dPoles, az1, az2 );
+    BOOST_CHECK_SMALL( dPoles - 20003931.4586, 1.0e-3 );
+    geodesic.Inverse( 0.0, 0.0, 0.0, 180.0, d, az1, az2 );
+    BOOST_CHECK_SMALL( d - dPoles, 1.0e-6 );
+
+    // Совпадающие точки
+    geodesic.Inverse( 55.75, 37.62, 55.75, 37.62, d, az1, az2 );
+    BOOST_CHECK_EQUAL( d, 0.0 );
+    BOOST_CHECK_EQUAL( az1, 0.0 );
+    BOOST_CHECK_EQUAL( az2, 0.0 );
+}
+
+BOOST_AUTO_TEST_CASE( test_Vincenty_Agreement )
+{
+    // Вне окрестности антиподов метод Карни и формулы Винсента совпадают с точностью формул Винсента (0.1 мм)
+    std::mt19937 gen( 2013 );
+    std::uniform_real_distribution<double> lat( -89.0, 89.0 );
+    std::uniform_real_distribution<double> lon( -180.0, 180.0 );
+    for( int i = 0; i < 2000; i++ ) {
+        const double lat1 = lat( gen ), lon1 = lon( gen ), lat2 = lat( gen ), lon2 = lon( gen );
+        double d0, az0, azEnd0, d, az, azEnd;
+        SPML::Geodesy::GEOtoRAD( el, SPML::Units::TRangeUnit::RU_Meter, SPML::Units::TAngleUnit::AU_Degree,
+            lat1, lon1, lat2, lon2, d0, az0, azEnd0 );
+        if( d0 > 19000000.0 ) {
+            continue;
+        }
+        const int iterations = geodesic.Inverse( lat1, lon1, lat2, lon2, d, az, azEnd );
+        BOOST_CHECK_LE( iterations, 10 );
+        BOOST_CHECK_SMALL( d - d0, 1.0e-3 );
+        BOOST_CHECK_SMALL( AzDiff( az, az0 ), 1.0e-7 );
+        BOOST_CHECK_SMALL( AzDiff( azEnd, azEnd0 ), 1.0e-7 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_NearAntipodal )
+{
+    // Почти антиподальные точки: число итераций ограничено, прямая задача возвращает в конечную точку
+    for( double lat1 : { 0.0, 0.1, 5.0, 30.0, 60.0 } ) {
+        for( double dLat : { 0.0, 1.0e-6, 0.01, 0.5 } ) {
+            for( double dLon : { 179.0, 179.5, 179.9, 179.99, 179.999999, 180.0 } ) {
+                const double lat2 = -lat1 + dLat;
+                double d, az, azEnd;
+                const int iterations = geodesic.Inverse( lat1, 0.0, lat2, dLon, d, az, azEnd );
+                BOOST_TEST_CONTEXT( "lat1=" << lat1 << " lat2=" << lat2 << " dLon=" << dLon ) {
+                    BOOST_CHECK_LE( iterations, SPML::Geodesy::CGeodesic::MaxNewtonIterations );
+                    BOOST_CHECK_LE( d, 20003931.4586 + 1.0e-3 ); // Не больше половины меридиана
+                    double lat, lon, azEnd2;
+                    geodesic.Direct( lat1, 0.0, d, az, lat, lon, azEnd2 );
+                    BOOST_CHECK_SMALL( lat - lat2, 1.0e-9 );
+                    BOOST_CHECK_SMALL( std::remainder( lon - dLon, 360.0 ), 1.0e-9 );
+                    BOOST_CHECK_SMALL( AzDiff( azEnd2, azEnd ), 1.0e-7 );
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_Method_Units )
+{
+    // Выбор метода в свободных функциях и единицы измерения
+    const double toRad = SPML::Convert::DgToRdD;
+    const double lat1 = 55.75, lon1 = 37.62, lat2 = -33.87, lon2 = 151.21;
+    double d, az, azEnd;
+    geodesic.Inverse( lat1, lon1, lat2, lon2, d, az, azEnd );
+
+    double d1, az1, azEnd1;
+    SPML::Geodesy::GEOtoRAD( el, SPML::Geodesy::GM_Karney, SPML::Units::TRangeUnit::RU_Kilometer,
+        SPML::Units::TAngleUnit::AU_Radian, lat1 * toRad, lon1 * toRad, lat2 * toRad, lon2 * toRad, d1, az1, azEnd1 );
+    BOOST_CHECK_SMALL( d1 - d * 0.001, 1.0e-9 );
+    BOOST_CHECK_SMALL( az1 - az * toRad, 1.0e-12 );
+    BOOST_CHECK_SMALL( azEnd1 - azEnd * toRad, 1.0e-12 );
+
+    double lat, lon, azEnd2;
+    SPML::Geodesy::RADtoGEO( el, SPML::Geodesy::GM_Karney, SPML::Units::TRangeUnit::RU_Kilometer,
+        SPML::Units::TAngleUnit::AU_Radian, lat1 * toRad, lon1 * toRad, d1, az1, lat, lon, azEnd2 );
+    BOOST_CHECK_SMALL( lat - lat2 * toRad, 1.0e-12 );
+    BOOST_CHECK_SMALL( lon - lon2 * toRad, 1.0e-12 );
+    BOOST_CHECK_SMALL( azEnd2 - azEnd1, 1.0e-12 );
+
+    // GM_Vincenty - те же формулы, что и в функции без параметра метода
+    double d0, az0, azEnd0;
+    SPML::Geodesy::GEOtoRAD( el, SPML::Units::TRangeUnit::RU_Meter, SPML::Units::TAngleUnit::AU_Degree,
+        lat1, lon1, lat2, lon2, d0, az0, azEnd0 );
+    SPML::Geodesy::GEOtoRAD( el, SPML::Geodesy::GM_Vincenty, SPML::Units::TRangeUnit::RU_Meter,
+        SPML::Units::TAngleUnit::AU_Degree, lat1, lon1, lat2, lon2, d1, az1, azEnd1 );
+    BOOST_CHECK_EQUAL( d0, d1 );
+    BOOST_CHECK_EQUAL( az0, az1 );
+    BOOST_CHECK_EQUAL( azEnd0, azEnd1 );
+
+    // На сфере - дуга большого круга
+    const SPML::Geodesy::CEllipsoid sphere = SPML::Geodesy::Ellipsoids::Sphere6371();
+    SPML::Geodesy::GEOtoRAD( sphere, SPML::Units::TRangeUnit::RU_Meter, SPML::Units::TAngleUnit::AU_Degree,
+        lat1, lon1, lat2, lon2, d0, az0, azEnd0 );
+    SPML::Geodesy::GEOtoRAD( sphere, SPML::Geodesy::GM_Karney, SPML::Units::TRangeUnit::RU_Meter,
+        SPML::Units::TAngleUnit::AU_Degree, lat1, lon1, lat2, lon2, d1, az1, azEnd1 );
+    BOOST_CHECK_SMALL( d1 - d0, 1.0e-6 );
+    BOOST_CHECK_SMALL( AzDiff( az1, az0 ), 1.0e-9 );
+    BOOST_CHECK_SMALL( AzDiff( azEnd1, azEnd0 ), 1.0e-9 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_CGeodesicLine )
+
+const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+const SPML::Units::TRangeUnit ru = SPML::Units::TRangeUnit::RU_Kilometer;
+const SPML::Units::TAngleUnit au = SPML::Units::TAngleUnit::AU_Degree;
+
+BOOST_AUTO_TEST_CASE( test_RADtoGEO_Agreement )
+{
+    // Точки линии совпадают с RADtoGEO для той же начальной точки и азимута (эллипсоид и сфера)
+    const SPML::Geodesy::CEllipsoid ellipsoids[] = { el, SPML::Geodesy::Ellipsoids::Sphere6371() };
+    std::mt19937 gen( 11 );
+    std::uniform_real_distribution<double> lat( -89.0, 89.0 );
+    std::uniform_real_distribution<double> lon( -180.0, 180.0 );
+    std::uniform_real_distribution<double> azim( 0.0, 360.0 );
+    std::uniform_real_distribution<double> dist( -20000.0, 20000.0 );
+    for( const SPML::Geodesy::CEllipsoid &e : ellipsoids ) {
+        for( int i = 0; i < 100; i++ ) {
+            const double lat1 = lat( gen ), lon1 = lon( gen ), az = azim( gen );
+            const SPML::Geodesy::CGeodesicLine line( e, ru, au, lat1, lon1, az );
+            for( int j = 0; j < 10; j++ ) {
+                const double d = dist( gen );
+                double lat0, lon0, azEnd0, lat2, lon2, azEnd2;
+                SPML::Geodesy::RADtoGEO( e, ru, au, lat1, lon1, d, az, lat0, lon0, azEnd0 );
+                line.Position( d, lat2, lon2, azEnd2 );
+                BOOST_CHECK_SMALL( lat2 - lat0, 1.0e-11 );
+                BOOST_CHECK_SMALL( lon2 - lon0, 1.0e-11 );
+                BOOST_CHECK_SMALL( std::remainder( azEnd2 - azEnd0, 360.0 ), 1.0e-11 );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_FromPoints_Waypoints )
+{
+    // Линия между двумя точками: первая и последняя точки - концы линии, азимуты - как в обратной задаче
+    const double lat1 = 55.75, lon1 = 37.62, lat2 = -33.87, lon2 = 151.21;
+    double d, az, azEnd;
+    SPML::Geodesy::GEOtoRAD( el, ru, au, lat1, lon1, lat2, lon2, d, az, azEnd );
+    const SPML::Geodesy::CGeodesicLine line = SPML::Geodesy::CGeodesicLine::FromPoints( el, ru, au,
+        lat1, lon1, lat2, lon2 );
+    BOOST_CHECK_EQUAL( line.Distance(), d );
+    BOOST_CHECK_EQUAL( line.Azimuth(), az );
+    BOOST_CHECK_EQUAL( line.Start().Lat, lat1 );
+    BOOST_CHECK_EQUAL( line.Start().Lon, lon1 );
+
+    const std::size_t n = 1001;
+    std::vector<double> lat( n ), lon( n ), azW( n );
+    line.Waypoints( n, lat.data(), lon.data(), azW.data() );
+    BOOST_CHECK_SMALL( lat[0] - lat1, 1.0e-12 );
+    BOOST_CHECK_SMALL( lon[0] - lon1, 1.0e-12 );
+    BOOST_CHECK_SMALL( lat[n - 1] - lat2, 1.0e-9 );
+    BOOST_CHECK_SMALL( lon[n - 1] - lon2, 1.0e-9 );
+    BOOST_CHECK_SMALL( std::remainder( azW[n - 1] - azEnd, 360.0 ), 1.0e-8 );
+
+    // Промежуточные точки: равные расстояния между соседними, совпадение с Position и PositionAtFraction
+    for( std::size_t i = 1; i < n; i++ ) {
+        double dStep, a1, a2;
+        SPML::Geodesy::GEOtoRAD( el, ru, au, lat[i - 1], lon[i - 1], lat[i], lon[i], dStep, a1, a2 );
+        BOOST_CHECK_SMALL( dStep - d / ( n - 1 ), 1.0e-9 );
+    }
+    double latP, lonP, azP;
+    line.PositionAtFraction( 0.25, latP, lonP, azP );
+    BOOST_CHECK_SMALL( latP - lat[250], 1.0e-12 );
+    BOOST_CHECK_SMALL( lonP - lon[250], 1.0e-12 );
+    BOOST_CHECK_SMALL( azP - azW[250], 1.0e-12 );
+
+    std::vector<double> dist = { 0.0, d * 0.25, d };
+    std::vector<double> latB( 3 ), lonB( 3 );
+    line.Positions( dist.data(), dist.size(), latB.data(), lonB.data() );
+    BOOST_CHECK_SMALL( latB[1] - lat[250], 1.0e-12 );
+    BOOST_CHECK_SMALL( lonB[2] - lon[n - 1], 1.0e-12 );
+
+    // Почти антиподальные точки: азимут по методу Карни, прямая задача Винсента приводит в конечную точку
+    const SPML::Geodesy::CGeodesicLine antipodal = SPML::Geodesy::CGeodesicLine::FromPoints( el, ru, au,
+        -41.32, 174.81, 40.96, -5.50, SPML::Geodesy::GM_Karney );
+    BOOST_CHECK_SMALL( antipodal.Distance() - 19959.67926735, 1.0e-7 );
+    antipodal.PositionAtFraction( 1.0, latP, lonP );
+    BOOST_CHECK_SMALL( latP - 40.96, 1.0e-8 );
+    BOOST_CHECK_SMALL( std::remainder( lonP + 5.50, 360.0 ), 1.0e-8 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_GEOWithinRange )
+
+const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+const SPML::Units::TRangeUnit ru = SPML::Units::TRangeUnit::RU_Kilometer;
+const SPML::Units::TAngleUnit au = SPML::Units::TAngleUnit::AU_Degree;
+
+BOOST_AUTO_TEST_CASE( test_Bounds )
+{
+    // Границы содержат расстояние по методу Карни (эллипсоид и сфера), на сфере границы совпадают
+    const SPML::Geodesy::CEllipsoid ellipsoids[] = { el, SPML::Geodesy::Ellipsoids::Sphere6371() };
+    std::mt19937 gen( 31 );
+    std::uniform_real_distribution<double> lat( -90.0, 90.0 );
+    std::uniform_real_distribution<double> lon( -180.0, 180.0 );
+    std::uniform_real_distribution<double> offset( -2.0, 2.0 );
+    for( const SPML::Geodesy::CEllipsoid &e : ellipsoids ) {
+        for( int i = 0; i < 2000; i++ ) {
+            const double lat1 = lat( gen ), lon1 = lon( gen );
+            const double lat2 = ( i % 2 == 0 ) ? lat( gen ) : std::max( -90.0, std::min( 90.0, lat1 + offset( gen ) ) );
+            const double lon2 = ( i % 2 == 0 ) ? lon( gen ) : lon1 + offset( gen );
+            double d, az, dMin, dMax;
+            SPML::Geodesy::GEOtoRAD( e, SPML::Geodesy::GM_Karney, ru, au, lat1, lon1, lat2, lon2, d, az );
+            SPML::Geodesy::GEOtoRADBounds( e, ru, au, lat1, lon1, lat2, lon2, dMin, dMax );
+            BOOST_CHECK_LE( dMin, d + 1.0e-9 );
+            BOOST_CHECK_GE( dMax, d - 1.0e-9 );
+            BOOST_CHECK_LE( dMax - dMin, 0.0034 * d + 1.0e-9 );
+        }
+    }
+    double dMin, dMax;
+    SPML::Geodesy::GEOtoRADBounds( SPML::Geodesy::Ellipsoids::Sphere6371(), ru, au, 10.0, 20.0, 30.0, 40.0, dMin, dMax );
+    BOOST_CHECK_SMALL( dMax - dMin, 1.0e-9 );
+}
+
+BOOST_AUTO_TEST_CASE( test_Predicate_Stats )
+{
+    // Результат совпадает с GEOtoRAD <= range, большая часть пар решается по границам
+    std::mt19937 gen( 32 );
+    std::uniform_real_distribution<double> lat( -80.0, 80.0 );
+    std::uniform_real_distribution<double> lon( -180.0, 180.0 );
+    std::uniform_real_distribution<double> offset( -5.0, 5.0 );
+    SPML::Geodesy::ResetWithinRangeStats();
+    std::size_t calls = 0;
+    for( int i = 0; i < 3000; i++ ) {
+        const double lat1 = lat( gen ), lon1 = lon( gen );
+        const double lat2 = lat1 + offset( gen ), lon2 = lon1 + offset( gen );
+        double d, az;
+        SPML::Geodesy::GEOtoRAD( el, ru, au, lat1, lon1, lat2, lon2, d, az );
+        for( double range : { 50.0, 300.0, d, d + 2.0e-6, d - 2.0e-6 } ) {
+            BOOST_CHECK_EQUAL( SPML::Geodesy::GEOWithinRange( el, ru, au, lat1, lon1, lat2, lon2, range ), d <= range );
+            calls++;
+        }
+    }
+    const SPML::Geodesy::WithinRangeStats stats = SPML::Geodesy::GetWithinRangeStats();
+    BOOST_CHECK_EQUAL( stats.Calls, calls );
+    // Пороги range около d (3 из 5) решаются обратной задачей, пороги 50 и 300 км - в основном по границам
+    BOOST_CHECK_GT( stats.ResolvedFraction(), 0.35 );
+    BOOST_CHECK_LE( stats.ResolvedFraction(), 0.4 );
+    SPML::Geodesy::ResetWithinRangeStats();
+    BOOST_CHECK_EQUAL( SPML::Geodesy::GetWithinRangeStats().Calls, 0u );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_CSpatialIndex )
+
+const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+const SPML::Units::TRangeUnit ru = SPML::Units::TRangeUnit::RU_Kilometer;
+const SPML::Units::TAngleUnit au = SPML::Units::TAngleUnit::AU_Degree;
+
+// Случайные точки по всему земному шару
+static void GlobalPoints( std::size_t n, unsigned int seed, std::vector<double> &lat, std::vector<double> &lon )
+{
+    std::mt19937 gen( seed );
+    std::uniform_real_distribution<double> uLat( -89.0, 89.0 );
+    std::uniform_real_distribution<double> uLon( -180.0, 180.0 );
+    lat.resize( n );
+    lon.resize( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        lat[i] = uLat( gen );
+        lon[i] = uLon( gen );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_Nearest_BruteForce )
+{
+    // Совпадение с полным перебором GEOtoRAD, в том числе при совпадающих точках (порядок - по номеру точки)
+    std::vector<double> lat, lon, latQ, lonQ;
+    GlobalPoints( 5000, 21, lat, lon );
+    for( std::size_t i = 0; i < 100; i++ ) {
+        lat.push_back( lat[i * 7] );
+        lon.push_back( lon[i * 7] );
+    }
+    GlobalPoints( 200, 22, latQ, lonQ );
+    latQ[0] = lat[14];
+    lonQ[0] = lon[14];
+    const SPML::Geodesy::CSpatialIndex index( el, ru, au, lat.data(), lon.data(), lat.size() );
+    BOOST_CHECK_EQUAL( index.Size(), lat.size() );
+
+    std::vector<std::pair<double, std::size_t>> all( lat.size() );
+    for( std::size_t q = 0; q < latQ.size(); q++ ) {
+        for( std::size_t i = 0; i < lat.size(); i++ ) {
+            double d, az;
+            SPML::Geodesy::GEOtoRAD( el, ru, au, latQ[q], lonQ[q], lat[i], lon[i], d, az );
+            all[i] = std::make_pair( d, i );
+        }
+        std::sort( all.begin(), all.end() );
+        for( std::size_t k : { 1u, 5u, 20u } ) {
+            std::vector<std::size_t> found( k );
+            std::vector<double> d( k ), az( k );
+            BOOST_CHECK_EQUAL( index.Nearest( latQ[q], lonQ[q], k, found.data(), d.data(), az.data() ), k );
+            for( std::size_t j = 0; j < k; j++ ) {
+                BOOST_CHECK_EQUAL( found[j], all[j].second );
+                BOOST_CHECK_EQUAL( d[j], all[j].first );
+                double dRef, azRef;
+                SPML::Geodesy::GEOtoRAD( el, ru, au, latQ[q], lonQ[q], lat[found[j]], lon[found[j]], dRef, azRef );
+                BOOST_CHECK_EQUAL( az[j], azRef );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_Nearest_Batch )
+{
+    // Пакетный запрос на нескольких потоках совпадает с одиночными запросами
+    std::vector<double> lat, lon, latQ, lonQ;
+    GlobalPoints( 3000, 23, lat, lon );
+    GlobalPoints( 500, 24, latQ, lonQ );
+    const SPML::Geodesy::CSpatialIndex index( el, ru, au, lat.data(), lon.data(), lat.size(),
+        SPML::Geodesy::GM_Karney );
+    const std::size_t k = 4;
+    std::vector<std::size_t> found( latQ.size() * k );
+    std::vector<double> d( latQ.size() * k );
+    index.Nearest( latQ.data(), lonQ.data(), latQ.size(), k, found.data(), d.data(), nullptr, 3 );
+    for( std::size_t q = 0; q < latQ.size(); q++ ) {
+        std::size_t found1[k];
+        double d1[k];
+        index.Nearest( latQ[q], lonQ[q], k, found1, d1 );
+        for( std::size_t j = 0; j < k; j++ ) {
+            BOOST_CHECK_EQUAL( found[q * k + j], found1[j] );
+            BOOST_CHECK_EQUAL( d[q * k + j], d1[j] );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_Within_BruteForce )
+{
+    // Поиск в радиусе совпадает с полным перебором GEOtoRAD <= range
+    std::vector<double> lat, lon, latQ, lonQ;
+    GlobalPoints( 5000, 25, lat, lon );
+    GlobalPoints( 50, 26, latQ, lonQ );
+    const SPML::Geodesy::CSpatialIndex index( el, ru, au, lat.data(), lon.data(), lat.size() );
+    std::vector<std::size_t> found, expected;
+    for( std::size_t q = 0; q < latQ.size(); q++ ) {
+        for( double range : { 100.0, 1000.0 } ) {
+            expected.clear();
+            for( std::size_t i = 0; i < lat.size(); i++ ) {
+                double d, az;
+                SPML::Geodesy::GEOtoRAD( el, ru, au, latQ[q], lonQ[q], lat[i], lon[i], d, az );
+                if( d <= range ) {
+                    expected.push_back( i );
+                }
+            }
+            BOOST_CHECK_EQUAL( index.Within( latQ[q], lonQ[q], range, found ), expected.size() );
+            BOOST_CHECK( found == expected );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_Nearest_Small )
+{
+    // k больше числа точек, пустой индекс
+    const double lat[] = { 10.0, 20.0, 30.0 };
+    const double lon[] = { 0.0, 0.0, 0.0 };
+    const SPML::Geodesy::CSpatialIndex index( el, ru, au, lat, lon, 3 );
+    std::size_t found[5];
+    double d[5];
+    BOOST_CHECK_EQUAL( index.Nearest( 24.0, 0.0, 5, found, d ), 3u );
+    BOOST_CHECK_EQUAL( found[0], 1u );
+    BOOST_CHECK_EQUAL( found[1], 2u );
+    BOOST_CHECK_EQUAL( found[2], 0u );
+    BOOST_CHECK_EQUAL( found[3], SPML::Geodesy::CSpatialIndex::NoIndex );
+    BOOST_CHECK( std::isnan( d[4] ) );
+
+    const SPML::Geodesy::CSpatialIndex empty( el, ru, au, nullptr, nullptr, 0 );
+    BOOST_CHECK_EQUAL( empty.Nearest( 24.0, 0.0, 2, found, d ), 0u );
+    BOOST_CHECK_EQUAL( found[0], SPML::Geodesy::CSpatialIndex::NoIndex );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//----------------------------------------------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE( test_suite_VincentyStats )
+
+const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+const SPML::Units::TRangeUnit ru = SPML::Units::TRangeUnit::RU_Kilometer;
+const SPML::Units::TAngleUnit au = SPML::Units::TAngleUnit::AU_Degree;
+
+BOOST_AUTO_TEST_CASE( test_HistogramBins )
+{
+    for( unsigned i = 0; i < 16; i++ ) {
+        BOOST_CHECK_EQUAL( SPML::Geodesy::VincentyHistogramBin( i ), i );
+        BOOST_CHECK_EQUAL( SPML::Geodesy::VincentyHistogramBinLow( i ), i );
+    }
+    BOOST_CHECK_EQUAL( SPML::Geodesy::VincentyHistogramBin( 16 ), 16u );
+    BOOST_CHECK_EQUAL( SPML::Geodesy::VincentyHistogramBin( 31 ), 16u );
+    BOOST_CHECK_EQUAL( SPML::Geodesy::VincentyHistogramBin( 32 ), 17u );
+    BOOST_CHECK_EQUAL( SPML::Geodesy::VincentyHistogramBin( 100 ), 18u );
+    BOOST_CHECK_EQUAL( SPML::Geodesy::VincentyHistogramBin( 1001 ), 21u );
+    BOOST_CHECK_EQUAL( SPML::Geodesy::VincentyHistogramBin( 2048 ), 23u );
+    BOOST_CHECK_EQUAL( SPML::Geodesy::VincentyHistogramBin( 1u << 30 ), SPML::Geodesy::VincentyHistogramBins - 1 );
+    BOOST_CHECK_EQUAL( SPML::Geodesy::VincentyHistogramBinLow( 16 ), 16u );
+    BOOST_CHECK_EQUAL( SPML::Geodesy::VincentyHistogramBinLow( 21 ), 512u );
+    for( unsigned bin = 0; bin < SPML::Geodesy::VincentyHistogramBins; bin++ ) {
+        BOOST_CHECK_EQUAL( SPML::Geodesy::VincentyHistogramBin( SPML::Geodesy::VincentyHistogramBinLow( bin ) ), bin );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_Counters )
+{
+    SPML::Geodesy::ResetVincentyStats();
+    double d, az, azEnd, lat, lon;
+    SPML::Geodesy::GEOtoRAD( el, ru, au, 55.0, 37.0, 59.0, 30.0, d, az, azEnd );
+    SPML::Geodesy::GEOtoRAD( el, ru, au, 55.0, 37.0, 55.0, 37.0, d, az, azEnd );  // Совпадающие точки
+    SPML::Geodesy::GEOtoRAD( el, ru, au, 0.0, 0.0, 0.5, 179.7, d, az, azEnd );    // Почти антиподы: нет сходимости
+    SPML::Geodesy::RADtoGEO( el, ru, au, 55.0, 37.0, 500.0, 45.0, lat, lon, azEnd );
+    SPML::Geodesy::GEOtoRAD( SPML::Geodesy::Ellipsoids::Sphere6371(), ru, au, 55.0, 37.0, 59.0, 30.0, d, az );
+
+    // Пакет с неполным последним блоком: дополняющие полосы не учитываются
+    const double lat1[5] = { 10.0, 20.0, 30.0, 40.0, 50.0 }, lon1[5] = { 0.0, 1.0, 2.0, 3.0, 4.0 };
+    const double lat2[5] = { 11.0, 21.0, 31.0, 41.0, 51.0 }, lon2[5] = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+    double dd[5], daz[5];
+    SPML::Geodesy::GEOtoRAD_Batch( el, ru, au, lat1, lon1, lat2, lon2, 5, dd, daz );
+
+    // Счетчики завершившегося потока сохраняются
+    std::thread thread( [&]() {
+        double td, taz;
+        SPML::Geodesy::GEOtoRAD( el, ru, au, 0.0, 0.0, 1.0, 1.0, td, taz );
+    } );
+    thread.join();
+
+    const SPML::Geodesy::TVincentyStats stats = SPML::Geodesy::GetVincentyStats();
+    if( !SPML::Geodesy::VincentyStatsEnabled() ) {
+        BOOST_CHECK_EQUAL( stats.Inverse.Calls, 0u );
+        BOOST_CHECK_EQUAL( stats.Direct.Calls, 0u );
+        return;
+    }
+    BOOST_CHECK_EQUAL( stats.Inverse.Calls, 9u );
+    BOOST_CHECK_EQUAL( stats.Inverse.Coincident, 1u );
+    BOOST_CHECK_EQUAL( stats.Inverse.NotConverged, 1u );
+    BOOST_CHECK_EQUAL( stats.Inverse.Histogram[SPML::Geodesy::VincentyHistogramBin( 100 )], 1u );
+    BOOST_CHECK_EQUAL( stats.Inverse.Histogram[1], 1u ); // Совпадающие точки - на первой итерации
+    BOOST_CHECK_EQUAL( stats.Direct.Calls, 1u );
+    BOOST_CHECK_EQUAL( stats.Direct.NotConverged, 0u );
+    BOOST_CHECK_EQUAL( stats.Direct.Coincident, 0u );
+
+    // Новый отсчет
+    SPML::Geodesy::ResetVincentyStats();
+    SPML::Geodesy::RADtoGEO( el, ru, au, 55.0, 37.0, 500.0, 45.0, lat, lon, azEnd );
+    const SPML::Geodesy::TVincentyStats next = SPML::Geodesy::GetVincentyStats();
+    BOOST_CHECK_EQUAL( next.Inverse.Calls, 0u );
+    BOOST_CHECK_EQUAL( next.Direct.Calls, 1u );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
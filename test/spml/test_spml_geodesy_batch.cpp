@@ -0,0 +1,1080 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       test_spml_geodesy_batch.cpp
+/// \brief      Тесты пакетных геодезических функций библиотеки spml
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+//#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_spml_geodesy_batch
+// Boost includes:
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/unit_test.hpp>
+
+// System includes:
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <unistd.h>
+#endif
+
+// SPML includes:
+#include <execution.h>
+#include <geodesic.h>
+#include <geodesy.h>
+#include <geodesy_batch.h>
+#include <geofence.h>
+#include <local_frame.h>
+#include <shm_ring.h>
+#include <simd.h>
+
+// Test includes:
+#include "test_spml_batch_check.h"
+//----------------------------------------------------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_SUITE( test_suite_SIMD )
+
+BOOST_AUTO_TEST_CASE( test_Resolve )
+{
+    BOOST_CHECK( SPML::SIMD::IsSupported( SPML::SIMD::SL_Scalar ) );
+    BOOST_CHECK_EQUAL( SPML::SIMD::Resolve( SPML::SIMD::SL_Scalar ), SPML::SIMD::SL_Scalar );
+    BOOST_CHECK_EQUAL( SPML::SIMD::Resolve( SPML::SIMD::SL_Auto ), SPML::SIMD::MaxSupportedLevel() );
+    BOOST_CHECK( SPML::SIMD::Resolve( SPML::SIMD::SL_AVX512 ) <= SPML::SIMD::MaxSupportedLevel() );
+    BOOST_CHECK_EQUAL( SPML::SIMD::Width( SPML::SIMD::SL_AVX2 ), 4 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_GEOtoRAD_Batch )
+
+const double epsRange = 1.0e-6;                                 // [м]
+const double epsAngleRad = 1.0e-9;                              // [рад]
+const double epsAngleDeg = epsAngleRad * SPML::Convert::RdToDgD; // [град]
+const double epsSphereSame = 0.3;                               // [м] Дальность на сфере у совпадающих точек
+
+// Случайные пары точек (в градусах), включая совпадающие точки и точки на экваторе
+struct TPairs
+{
+    std::vector<double> latStart, lonStart, latEnd, lonEnd;
+
+    explicit TPairs( std::size_t n )
+    {
+        std::mt19937 gen( 12345 );
+        std::uniform_real_distribution<double> lat( -89.0, 89.0 );
+        std::uniform_real_distribution<double> lon( -180.0, 180.0 );
+        while( latStart.size() < n ) {
+            double lat1 = lat( gen ), lon1 = lon( gen ), lat2 = lat( gen ), lon2 = lon( gen );
+            switch( latStart.size() % 50 ) {
+                case 7: lat2 = lat1; lon2 = lon1; break;    // Совпадающие точки
+                case 13: lat1 = 0.0; lat2 = 0.0; break;     // Экватор
+                default: break;
+            }
+            // Почти антиподальные пары исключаем: для них итерации Винсента не сходятся
+            double cosAngle = std::sin( lat1 * SPML::Convert::DgToRdD ) * std::sin( lat2 * SPML::Convert::DgToRdD ) +
+                std::cos( lat1 * SPML::Convert::DgToRdD ) * std::cos( lat2 * SPML::Convert::DgToRdD ) *
+                std::cos( ( lon2 - lon1 ) * SPML::Convert::DgToRdD );
+            if( cosAngle < std::cos( 179.0 * SPML::Convert::DgToRdD ) ) {
+                continue;
+            }
+            latStart.push_back( lat1 );
+            lonStart.push_back( lon1 );
+            latEnd.push_back( lat2 );
+            lonEnd.push_back( lon2 );
+        }
+    }
+};
+
+// Наборы параметров сравнения с GEOtoRAD
+static const TBatchConfig geoToRadConfigs[] = {
+    { &SPML::Geodesy::Ellipsoids::WGS84, SPML::Units::RU_Kilometer, SPML::Units::AU_Degree, 1003, 1 },
+    { &SPML::Geodesy::Ellipsoids::Krassowsky1940, SPML::Units::RU_Meter, SPML::Units::AU_Radian, 517, 3 },
+    { &SPML::Geodesy::Ellipsoids::Sphere6371, SPML::Units::RU_Meter, SPML::Units::AU_Degree, 261, 1 }
+};
+
+BOOST_DATA_TEST_CASE( test_Scalar_Agreement, boost::unit_test::data::make( geoToRadConfigs ), config )
+{
+    const SPML::Geodesy::CEllipsoid &el = config.Ellipsoid();
+    const std::size_t n = config.Count;
+    TPairs p( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        p.latStart[i] *= config.ToAngle();
+        p.lonStart[i] *= config.ToAngle();
+        p.latEnd[i] *= config.ToAngle();
+        p.lonEnd[i] *= config.ToAngle();
+    }
+    const double unit = config.ToRange();
+    const double epsD = epsRange * unit;
+    CheckAgainstScalar<double>( n, 3, [&]( SPML::SIMD::TSimdLevel level, double *const *out ) {
+        SPML::Geodesy::GEOtoRAD_Batch( el, config.RangeUnit, config.AngleUnit, p.latStart.data(), p.lonStart.data(),
+            p.latEnd.data(), p.lonEnd.data(), n, out[0], out[1], out[2],
+            SPML::Execution::Policy( level, config.Threads ) );
+    }, [&]( std::size_t i, double *expected ) {
+        SPML::Geodesy::GEOtoRAD( el, config.RangeUnit, config.AngleUnit, p.latStart[i], p.lonStart[i], p.latEnd[i],
+            p.lonEnd[i], expected[0], expected[1], expected[2] );
+    }, [&]( std::size_t, std::size_t k, const double *expected ) {
+        if( k == 0 ) {
+            // На сфере дальность - через acos, который плохо обусловлен у совпадающих точек: расхождение
+            // векторных sin/cos с libm на 1-2 ULP дает там ошибку до a * sqrt( 8 * eps ) (0.13 м для точки,
+            // совпадающей с собой)
+            const bool nearSame = ( el.F() == 0.0 ) && ( expected[0] < 1000.0 * epsSphereSame * unit );
+            return TBatchTolerance{ nearSame ? epsSphereSame * unit : epsD };
+        }
+        // Для совпадающих точек на сфере азимут не определен
+        return TBatchTolerance{ ( expected[0] > epsD ) ? config.AngleEps( epsAngleRad ) : -1.0,
+            360.0 * config.ToAngle() };
+    } );
+}
+
+BOOST_AUTO_TEST_CASE( test_Tail_Without_azEnd )
+{
+    // Размеры пакета меньше ширины вектора, azEnd не вычисляется
+    TPairs p( 7 );
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    for( SPML::SIMD::TSimdLevel level : SupportedLevels() ) {
+        for( std::size_t n = 0; n <= p.latStart.size(); n++ ) {
+            std::vector<double> d( n + 1, -1.0 ), az( n + 1, -1.0 );
+            SPML::Geodesy::GEOtoRAD_Batch( el, SPML::Units::RU_Meter, SPML::Units::AU_Degree, p.latStart.data(),
+                p.lonStart.data(), p.latEnd.data(), p.lonEnd.data(), n, d.data(), az.data(), nullptr, level );
+            for( std::size_t i = 0; i < n; i++ ) {
+                double d0, az0;
+                SPML::Geodesy::GEOtoRAD( el, SPML::Units::RU_Meter, SPML::Units::AU_Degree,
+                    p.latStart[i], p.lonStart[i], p.latEnd[i], p.lonEnd[i], d0, az0 );
+                BOOST_CHECK_SMALL( d[i] - d0, epsRange );
+                BOOST_CHECK_SMALL( AngleDiff( az[i], az0, 360.0 ), epsAngleDeg );
+            }
+            BOOST_CHECK_EQUAL( d[n], -1.0 ); // За пределы массива не пишем
+            BOOST_CHECK_EQUAL( az[n], -1.0 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_Method_Threads )
+{
+    // GM_Karney - те же значения, что и CGeodesic::Inverse; GM_Vincenty в нескольких потоках - как в одном
+    TPairs p( 1001 );
+    const std::size_t n = p.latStart.size();
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Geodesy::CGeodesic geodesic( el, SPML::Units::RU_Kilometer, SPML::Units::AU_Degree );
+    std::vector<double> d( n ), az( n ), azEnd( n );
+    SPML::Geodesy::GEOtoRAD_Batch( el, SPML::Geodesy::GM_Karney, SPML::Units::RU_Kilometer, SPML::Units::AU_Degree,
+        p.latStart.data(), p.lonStart.data(), p.latEnd.data(), p.lonEnd.data(), n, d.data(), az.data(), azEnd.data(),
+        SPML::SIMD::SL_Auto, 3 );
+    for( std::size_t i = 0; i < n; i++ ) {
+        double d0, az0, azEnd0;
+        geodesic.Inverse( p.latStart[i], p.lonStart[i], p.latEnd[i], p.lonEnd[i], d0, az0, azEnd0 );
+        BOOST_CHECK_EQUAL( d[i], d0 );
+        BOOST_CHECK_EQUAL( az[i], az0 );
+        BOOST_CHECK_EQUAL( azEnd[i], azEnd0 );
+    }
+
+    std::vector<double> d1( n ), az1( n ), d3( n ), az3( n );
+    SPML::Geodesy::GEOtoRAD_Batch( el, SPML::Units::RU_Kilometer, SPML::Units::AU_Degree, p.latStart.data(),
+        p.lonStart.data(), p.latEnd.data(), p.lonEnd.data(), n, d1.data(), az1.data() );
+    SPML::Geodesy::GEOtoRAD_Batch( el, SPML::Geodesy::GM_Vincenty, SPML::Units::RU_Kilometer, SPML::Units::AU_Degree,
+        p.latStart.data(), p.lonStart.data(), p.latEnd.data(), p.lonEnd.data(), n, d3.data(), az3.data(), nullptr,
+        SPML::SIMD::SL_Auto, 3 );
+    BOOST_CHECK( d1 == d3 );
+    BOOST_CHECK( az1 == az3 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_RADtoGEO_Fan )
+
+const double epsAngleRad = 1.0e-9;                              // [рад]
+
+// Наборы параметров сравнения с RADtoGEO: веер из опорной точки, 7 колец дальности через 1 градус азимута
+static const TBatchConfig fanConfigs[] = {
+    { &SPML::Geodesy::Ellipsoids::WGS84, SPML::Units::RU_Kilometer, SPML::Units::AU_Degree, 7 * 360, 1, 55.75, 37.62 },
+    { &SPML::Geodesy::Ellipsoids::PZ90, SPML::Units::RU_Meter, SPML::Units::AU_Radian, 7 * 360, 4, -33.9, 151.2 },
+    { &SPML::Geodesy::Ellipsoids::Sphere6378, SPML::Units::RU_Meter, SPML::Units::AU_Degree, 7 * 360, 0, 0.0, -75.0 }
+};
+
+BOOST_DATA_TEST_CASE( test_Scalar_Agreement, boost::unit_test::data::make( fanConfigs ), config )
+{
+    static const double rings[] = { 0.0, 0.5, 10.0, 150.0, 1000.0, 5000.0, 15000.0 }; // [км]
+    const SPML::Geodesy::CEllipsoid &el = config.Ellipsoid();
+    const double toAngle = config.ToAngle();
+    const std::size_t n = config.Count;
+    std::vector<double> d( n ), az( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        d[i] = rings[i / 360 % 7] * 1000.0 * config.ToRange();
+        az[i] = static_cast<double>( i % 360 ) * toAngle;
+    }
+    const double latStart = config.Lat * toAngle;
+    const double lonStart = config.Lon * toAngle;
+    const double epsA = config.AngleEps( epsAngleRad );
+    CheckAgainstScalar<double>( n, 3, [&]( SPML::SIMD::TSimdLevel level, double *const *out ) {
+        SPML::Geodesy::RADtoGEO_Fan( el, config.RangeUnit, config.AngleUnit, latStart, lonStart, d.data(), az.data(),
+            n, out[0], out[1], out[2], level, config.Threads );
+    }, [&]( std::size_t i, double *expected ) {
+        SPML::Geodesy::RADtoGEO( el, config.RangeUnit, config.AngleUnit, latStart, lonStart, d[i], az[i],
+            expected[0], expected[1], expected[2] );
+    }, [&]( std::size_t, std::size_t k, const double * ) {
+        return TBatchTolerance{ epsA, ( k == 2 ) ? 360.0 * toAngle : 0.0 };
+    } );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_GEOtoRAD_Matrix )
+
+const double epsRange = 1.0e-6;     // [м]
+const double epsAngleRad = 1.0e-9;  // [рад]
+const double epsSphereSame = 0.3;   // [м] Дальность на сфере у совпадающих точек
+
+// Случайные точки района (в градусах), каждая 97-я совпадает с предыдущей
+static void RegionPoints( std::size_t n, unsigned int seed, std::vector<double> &lat, std::vector<double> &lon )
+{
+    std::mt19937 gen( seed );
+    std::uniform_real_distribution<double> uLat( 30.0, 70.0 );
+    std::uniform_real_distribution<double> uLon( 0.0, 100.0 );
+    lat.resize( n );
+    lon.resize( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        lat[i] = ( i % 97 == 5 ) ? lat[i - 1] : uLat( gen );
+        lon[i] = ( i % 97 == 5 ) ? lon[i - 1] : uLon( gen );
+    }
+}
+
+// Сравнение элементов матрицы с GEOtoRAD
+static void CheckMatrix( const SPML::Geodesy::CEllipsoid &el, SPML::Units::TRangeUnit ru, SPML::Units::TAngleUnit au,
+    std::size_t rows, std::size_t cols, bool self, unsigned int threads )
+{
+    const double toAngle = ( au == SPML::Units::AU_Degree ) ? 1.0 : SPML::Convert::DgToRdD;
+    const double unit = ( ru == SPML::Units::RU_Meter ) ? 1.0 : 0.001;
+    const double epsA = epsAngleRad / ( ( au == SPML::Units::AU_Degree ) ? SPML::Convert::DgToRdD : 1.0 );
+    const double full = 360.0 * toAngle;
+    std::vector<double> latRow, lonRow, latCol, lonCol;
+    RegionPoints( rows, 1, latRow, lonRow );
+    RegionPoints( cols, 2, latCol, lonCol );
+    for( std::size_t i = 0; i < rows; i++ ) {
+        latRow[i] *= toAngle;
+        lonRow[i] *= toAngle;
+    }
+    for( std::size_t j = 0; j < cols; j++ ) {
+        latCol[j] *= toAngle;
+        lonCol[j] *= toAngle;
+    }
+    if( self ) {
+        cols = rows;
+        latCol = latRow;
+        lonCol = lonRow;
+    }
+    const double *latC = self ? latRow.data() : latCol.data();
+    const double *lonC = self ? lonRow.data() : lonCol.data();
+
+    for( SPML::SIMD::TSimdLevel level : SupportedLevels() ) {
+        std::vector<double> d( rows * cols ), az( rows * cols ), azEnd( rows * cols );
+        SPML::Geodesy::GEOtoRAD_Matrix( el, ru, au, latRow.data(), lonRow.data(), rows, latC, lonC, cols,
+            d.data(), az.data(), azEnd.data(), level, threads );
+        for( std::size_t i = 0; i < rows; i++ ) {
+            for( std::size_t j = 0; j < cols; j++ ) {
+                const std::size_t k = i * cols + j;
+                double d0, az0, azEnd0;
+                SPML::Geodesy::GEOtoRAD( el, ru, au, latRow[i], lonRow[i], latCol[j], lonCol[j], d0, az0, azEnd0 );
+                if( std::isnan( d0 ) ) { // Совпадающие точки на сфере: acos от аргумента больше 1
+                    continue;
+                }
+                BOOST_TEST_CONTEXT( SPML::SIMD::Name( level ) << " i=" << i << " j=" << j ) {
+                    const bool nearSame = ( el.F() == 0.0 ) && ( d0 < 1000.0 * epsSphereSame * unit );
+                    BOOST_CHECK_SMALL( d[k] - d0, nearSame ? epsSphereSame * unit : epsRange * unit );
+                    if( d0 > epsRange * unit ) {
+                        BOOST_CHECK_SMALL( AngleDiff( az[k], az0, full ), epsA );
+                        BOOST_CHECK_SMALL( AngleDiff( azEnd[k], azEnd0, full ), epsA );
+                    }
+                    if( self ) {
+                        BOOST_CHECK_EQUAL( d[k], d[j * cols + i] );
+                    }
+                }
+            }
+        }
+
+        // Без azEnd - те же дальности и азимуты
+        std::vector<double> d2( rows * cols ), az2( rows * cols );
+        SPML::Geodesy::GEOtoRAD_Matrix( el, ru, au, latRow.data(), lonRow.data(), rows, latC, lonC, cols,
+            d2.data(), az2.data(), nullptr, level, threads );
+        for( std::size_t k = 0; k < d.size(); k++ ) {
+            BOOST_CHECK( ( d2[k] == d[k] ) || ( std::isnan( d2[k] ) && std::isnan( d[k] ) ) );
+            BOOST_CHECK( ( az2[k] == az[k] ) || ( std::isnan( az2[k] ) && std::isnan( az[k] ) ) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_WGS84_Degree_Kilometer )
+{
+    // Несколько блоков по строкам и столбцам, неполные блоки
+    CheckMatrix( SPML::Geodesy::Ellipsoids::WGS84(), SPML::Units::RU_Kilometer, SPML::Units::AU_Degree, 37, 1100, false, 3 );
+}
+
+BOOST_AUTO_TEST_CASE( test_Self_Krassowsky1940_Radian_Meter )
+{
+    CheckMatrix( SPML::Geodesy::Ellipsoids::Krassowsky1940(), SPML::Units::RU_Meter, SPML::Units::AU_Radian, 600, 0, true, 2 );
+}
+
+BOOST_AUTO_TEST_CASE( test_Self_Sphere6371_Degree_Meter )
+{
+    CheckMatrix( SPML::Geodesy::Ellipsoids::Sphere6371(), SPML::Units::RU_Meter, SPML::Units::AU_Degree, 150, 0, true, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( test_Sparse )
+{
+    // Разреженная матрица - элементы плотной не дальше порога, по строкам и столбцам
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Units::TRangeUnit ru = SPML::Units::RU_Kilometer;
+    const SPML::Units::TAngleUnit au = SPML::Units::AU_Degree;
+    const double maxRange = 1500.0;
+    std::vector<double> latRow, lonRow, latCol, lonCol;
+    RegionPoints( 70, 3, latRow, lonRow );
+    RegionPoints( 900, 4, latCol, lonCol );
+
+    for( bool self : { false, true } ) {
+        const std::size_t rows = latRow.size();
+        const std::size_t cols = self ? rows : latCol.size();
+        const double *latC = self ? latRow.data() : latCol.data();
+        const double *lonC = self ? lonRow.data() : lonCol.data();
+        std::vector<double> d( rows * cols ), az( rows * cols ), azEnd( rows * cols );
+        SPML::Geodesy::GEOtoRAD_Matrix( el, ru, au, latRow.data(), lonRow.data(), rows, latC, lonC, cols,
+            d.data(), az.data(), azEnd.data() );
+        std::vector<SPML::Geodesy::RADMatrixEntry> entries( 1 );
+        SPML::Geodesy::GEOtoRAD_MatrixSparse( el, ru, au, latRow.data(), lonRow.data(), rows, latC, lonC, cols,
+            maxRange, entries, SPML::SIMD::SL_Auto, 3 );
+
+        std::size_t e = 0;
+        for( std::size_t i = 0; i < rows; i++ ) {
+            for( std::size_t j = 0; j < cols; j++ ) {
+                const std::size_t k = i * cols + j;
+                if( ( self && ( i == j ) ) || !( d[k] <= maxRange ) ) {
+                    continue;
+                }
+                BOOST_TEST_CONTEXT( "self=" << self << " i=" << i << " j=" << j ) {
+                    BOOST_REQUIRE_LT( e, entries.size() );
+                    BOOST_CHECK_EQUAL( entries[e].Row, i );
+                    BOOST_CHECK_EQUAL( entries[e].Col, j );
+                    BOOST_CHECK_EQUAL( entries[e].Rad.R, d[k] );
+                    BOOST_CHECK_EQUAL( entries[e].Rad.Az, az[k] );
+                    BOOST_CHECK_EQUAL( entries[e].Rad.AzEnd, azEnd[k] );
+                }
+                e++;
+            }
+        }
+        BOOST_CHECK_EQUAL( e, entries.size() );
+        BOOST_CHECK( e > 0 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_ECEFtoGEO_Batch )
+
+const double epsAngleRad = 1.0e-11;                             // [рад], 6e-5 м на поверхности
+const double epsHeight = 1.0e-4;                                // [м]
+
+// Наборы параметров сравнения с ECEFtoGEO: случайные точки от -100 км до 40000 км, включая полюса и экватор
+static const TBatchConfig ecefToGeoConfigs[] = {
+    { &SPML::Geodesy::Ellipsoids::WGS84, SPML::Units::RU_Kilometer, SPML::Units::AU_Degree, 2003, 1 },
+    { &SPML::Geodesy::Ellipsoids::PZ90, SPML::Units::RU_Meter, SPML::Units::AU_Radian, 1001, 3 }
+};
+
+BOOST_DATA_TEST_CASE( test_Scalar_Agreement, boost::unit_test::data::make( ecefToGeoConfigs ), config )
+{
+    const SPML::Geodesy::CEllipsoid &el = config.Ellipsoid();
+    const std::size_t n = config.Count;
+    std::mt19937 gen( 777 );
+    std::uniform_real_distribution<double> lat( -90.0, 90.0 );
+    std::uniform_real_distribution<double> lon( -180.0, 180.0 );
+    std::uniform_real_distribution<double> h( -1.0e5, 4.0e7 );
+    std::vector<double> x( n ), y( n ), z( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        double b = lat( gen );
+        switch( i % 40 ) {
+            case 3: b = 90.0; break;    // Северный полюс
+            case 5: b = -90.0; break;   // Южный полюс
+            case 11: b = 0.0; break;    // Экватор
+            default: break;
+        }
+        SPML::Geodesy::GEOtoECEF( el, config.RangeUnit, config.AngleUnit, b * config.ToAngle(),
+            lon( gen ) * config.ToAngle(), h( gen ) * config.ToRange(), x[i], y[i], z[i] );
+    }
+    const double epsA = config.AngleEps( epsAngleRad );
+    const double epsH = epsHeight * config.ToRange();
+    CheckAgainstScalar<double>( n, 3, [&]( SPML::SIMD::TSimdLevel level, double *const *out ) {
+        SPML::Geodesy::ECEFtoGEO_Batch( el, config.RangeUnit, config.AngleUnit, x.data(), y.data(), z.data(), n,
+            out[0], out[1], out[2], level, config.Threads );
+    }, [&]( std::size_t i, double *expected ) {
+        SPML::Geodesy::ECEFtoGEO( el, config.RangeUnit, config.AngleUnit, x[i], y[i], z[i], expected[0], expected[1],
+            expected[2] );
+    }, [&]( std::size_t, std::size_t k, const double * ) {
+        return TBatchTolerance{ ( k == 2 ) ? epsH : epsA };
+    } );
+}
+
+BOOST_AUTO_TEST_CASE( test_InPlace )
+{
+    // Выходные массивы совпадают с входными, размер не кратен ширине вектора
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    for( SPML::SIMD::TSimdLevel level : SupportedLevels() ) {
+        std::vector<double> x, y, z;
+        for( int i = 0; i < 13; i++ ) {
+            double xi, yi, zi;
+            SPML::Geodesy::GEOtoECEF( el, SPML::Units::RU_Meter, SPML::Units::AU_Degree, -60.0 + 10.0 * i, 7.0 * i,
+                100.0 * i, xi, yi, zi );
+            x.push_back( xi );
+            y.push_back( yi );
+            z.push_back( zi );
+        }
+        SPML::Geodesy::ECEFtoGEO_Batch( el, SPML::Units::RU_Meter, SPML::Units::AU_Degree, x.data(), y.data(), z.data(),
+            x.size(), x.data(), y.data(), z.data(), level );
+        for( int i = 0; i < 13; i++ ) {
+            BOOST_TEST_CONTEXT( SPML::SIMD::Name( level ) << " i=" << i ) {
+                BOOST_CHECK_SMALL( x[i] - ( -60.0 + 10.0 * i ), 1.0e-9 );
+                BOOST_CHECK_SMALL( y[i] - 7.0 * i, 1.0e-9 );
+                BOOST_CHECK_SMALL( z[i] - 100.0 * i, 1.0e-6 );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_GEOtoECEF_Batch )
+
+const double epsRange = 1.0e-8; // [м]
+
+// Сравнение пакетной функции с GEOtoECEF; offset - сдвиг выходных массивов относительно выровненного начала
+static void CheckGEOtoECEF( const TBatchConfig &config, std::size_t offset )
+{
+    const SPML::Geodesy::CEllipsoid &el = config.Ellipsoid();
+    const std::size_t n = config.Count;
+    std::mt19937 gen( 4321 );
+    std::uniform_real_distribution<double> lat( -90.0, 90.0 );
+    std::uniform_real_distribution<double> lon( -540.0, 540.0 ); // В т.ч. за пределами [-180, 180]
+    std::uniform_real_distribution<double> h( -1.0e4, 1.0e6 );
+    std::vector<double> b( n ), l( n ), hh( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        b[i] = lat( gen ) * config.ToAngle();
+        l[i] = lon( gen ) * config.ToAngle();
+        hh[i] = h( gen ) * config.ToRange();
+    }
+    const double eps = epsRange * config.ToRange();
+    CheckAgainstScalar<double>( n, 3, [&]( SPML::SIMD::TSimdLevel level, double *const *out ) {
+        SPML::Geodesy::GEOtoECEF_Batch( el, config.RangeUnit, config.AngleUnit, b.data(), l.data(), hh.data(), n,
+            out[0], out[1], out[2], level, config.Threads );
+    }, [&]( std::size_t i, double *expected ) {
+        SPML::Geodesy::GEOtoECEF( el, config.RangeUnit, config.AngleUnit, b[i], l[i], hh[i], expected[0],
+            expected[1], expected[2] );
+    }, [&]( std::size_t, std::size_t, const double * ) {
+        return TBatchTolerance{ eps };
+    }, offset );
+}
+
+// Наборы параметров сравнения с GEOtoECEF
+static const TBatchConfig geoToEcefConfigs[] = {
+    { &SPML::Geodesy::Ellipsoids::WGS84, SPML::Units::RU_Kilometer, SPML::Units::AU_Degree, 1003, 1 },
+    { &SPML::Geodesy::Ellipsoids::PZ90, SPML::Units::RU_Meter, SPML::Units::AU_Degree, 100003, 3 }
+};
+
+BOOST_DATA_TEST_CASE( test_Scalar_Agreement, boost::unit_test::data::make( geoToEcefConfigs ), config )
+{
+    CheckGEOtoECEF( config, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( test_Unaligned )
+{
+    CheckGEOtoECEF( { &SPML::Geodesy::Ellipsoids::WGS84, SPML::Units::RU_Kilometer, SPML::Units::AU_Degree, 1003, 1 },
+        1 );
+}
+
+BOOST_AUTO_TEST_CASE( test_Stream )
+{
+    // Выровненные массивы больше порога потоковой записи
+    CheckGEOtoECEF( { &SPML::Geodesy::Ellipsoids::Krassowsky1940, SPML::Units::RU_Meter, SPML::Units::AU_Radian,
+        40001, 1 }, 0 );
+}
+
+BOOST_AUTO_TEST_CASE( test_RoundTrip )
+{
+    // GEO -> ECEF -> GEO на месте
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    for( SPML::SIMD::TSimdLevel level : SupportedLevels() ) {
+        std::vector<double> b, l, h;
+        for( int i = 0; i < 21; i++ ) {
+            b.push_back( -89.0 + 8.9 * i );
+            l.push_back( -175.0 + 17.0 * i );
+            h.push_back( 500.0 * i );
+        }
+        SPML::Geodesy::GEOtoECEF_Batch( el, SPML::Units::RU_Meter, SPML::Units::AU_Degree, b.data(), l.data(), h.data(),
+            b.size(), b.data(), l.data(), h.data(), level );
+        SPML::Geodesy::ECEFtoGEO_Batch( el, SPML::Units::RU_Meter, SPML::Units::AU_Degree, b.data(), l.data(), h.data(),
+            b.size(), b.data(), l.data(), h.data(), level );
+        for( int i = 0; i < 21; i++ ) {
+            BOOST_TEST_CONTEXT( SPML::SIMD::Name( level ) << " i=" << i ) {
+                BOOST_CHECK_SMALL( b[i] - ( -89.0 + 8.9 * i ), 1.0e-9 );
+                BOOST_CHECK_SMALL( l[i] - ( -175.0 + 17.0 * i ), 1.0e-9 );
+                BOOST_CHECK_SMALL( h[i] - 500.0 * i, 1.0e-6 );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_GEOWithinRange_Batch )
+
+BOOST_AUTO_TEST_CASE( test_Batch_Agreement )
+{
+    // Пакетная проверка совпадает с GEOtoRAD_Batch <= range на всех уровнях векторизации и числе потоков
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Units::TRangeUnit ru = SPML::Units::TRangeUnit::RU_Meter;
+    const SPML::Units::TAngleUnit au = SPML::Units::TAngleUnit::AU_Radian;
+    const std::size_t n = 5003;
+    std::mt19937 gen( 33 );
+    std::uniform_real_distribution<double> lat( -1.4, 1.4 );
+    std::uniform_real_distribution<double> lon( -3.1, 3.1 );
+    std::uniform_real_distribution<double> offset( -0.05, 0.05 );
+    std::vector<double> lat1( n ), lon1( n ), lat2( n ), lon2( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        lat1[i] = lat( gen );
+        lon1[i] = lon( gen );
+        lat2[i] = lat1[i] + offset( gen );
+        lon2[i] = lon1[i] + offset( gen );
+    }
+    const double range = 200000.0;
+    for( SPML::SIMD::TSimdLevel level : { SPML::SIMD::SL_Scalar, SPML::SIMD::SL_Auto } ) {
+        std::vector<double> d( n ), az( n );
+        SPML::Geodesy::GEOtoRAD_Batch( el, ru, au, lat1.data(), lon1.data(), lat2.data(), lon2.data(), n, d.data(),
+            az.data(), nullptr, level );
+        for( unsigned int threads : { 1u, 3u } ) {
+            std::unique_ptr<bool[]> within( new bool[n] );
+            SPML::Geodesy::ResetWithinRangeStats();
+            SPML::Geodesy::GEOWithinRange_Batch( el, ru, au, lat1.data(), lon1.data(), lat2.data(), lon2.data(), n,
+                range, within.get(), level, threads );
+            for( std::size_t i = 0; i < n; i++ ) {
+                BOOST_CHECK_EQUAL( within[i], d[i] <= range );
+            }
+            BOOST_CHECK_EQUAL( SPML::Geodesy::GetWithinRangeStats().Calls, n );
+            BOOST_CHECK_GT( SPML::Geodesy::GetWithinRangeStats().ResolvedFraction(), 0.9 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_Execution )
+
+BOOST_AUTO_TEST_CASE( test_Policy_Agreement )
+{
+    // Результат не зависит от способа выполнения, числа потоков пула и размера части
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Units::TRangeUnit ru = SPML::Units::TRangeUnit::RU_Meter;
+    const SPML::Units::TAngleUnit au = SPML::Units::TAngleUnit::AU_Degree;
+    const std::size_t n = 1001;
+    std::mt19937 gen( 15 );
+    std::uniform_real_distribution<double> lat( -80.0, 80.0 );
+    std::uniform_real_distribution<double> lon( -180.0, 180.0 );
+    std::vector<double> lat1( n ), lon1( n ), lat2( n ), lon2( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        lat1[i] = lat( gen );
+        lon1[i] = lon( gen );
+        lat2[i] = lat( gen );
+        lon2[i] = lon( gen );
+    }
+    std::vector<double> dSeq( n ), azSeq( n ), dSimd( n ), azSimd( n );
+    SPML::Geodesy::GEOtoRAD_Batch( el, ru, au, lat1.data(), lon1.data(), lat2.data(), lon2.data(), n, dSeq.data(),
+        azSeq.data(), nullptr, SPML::Execution::Policy( SPML::Execution::EM_Sequential ) );
+    SPML::Geodesy::GEOtoRAD_Batch( el, ru, au, lat1.data(), lon1.data(), lat2.data(), lon2.data(), n, dSimd.data(),
+        azSimd.data(), nullptr, SPML::Execution::Policy( SPML::SIMD::SL_Auto, 1 ) );
+
+    SPML::Execution::SetPoolThreads( 3 );
+    BOOST_CHECK_EQUAL( SPML::Execution::PoolThreads(), 3u );
+    BOOST_CHECK( !SPML::Execution::PoolPinned() );
+    for( std::size_t chunk : { std::size_t( 0 ), std::size_t( 1 ), std::size_t( 7 ), std::size_t( 5000 ) } ) {
+        for( unsigned int threads : { 0u, 2u, 8u } ) {
+            std::vector<double> d( n ), az( n );
+            SPML::Geodesy::GEOtoRAD_Batch( el, ru, au, lat1.data(), lon1.data(), lat2.data(), lon2.data(), n,
+                d.data(), az.data(), nullptr, SPML::Execution::Policy( SPML::Execution::EM_Parallel, threads, chunk ) );
+            BOOST_TEST_CONTEXT( "parallel chunk=" << chunk << " threads=" << threads ) {
+                BOOST_CHECK( d == dSeq );
+                BOOST_CHECK( az == azSeq );
+            }
+            SPML::Geodesy::GEOtoRAD_Batch( el, ru, au, lat1.data(), lon1.data(), lat2.data(), lon2.data(), n,
+                d.data(), az.data(), nullptr,
+                SPML::Execution::Policy( SPML::Execution::EM_ParallelSimd, threads, chunk ) );
+            BOOST_TEST_CONTEXT( "parallel simd chunk=" << chunk << " threads=" << threads ) {
+                BOOST_CHECK( d == dSimd );
+                BOOST_CHECK( az == azSimd );
+            }
+        }
+    }
+    SPML::Execution::SetPoolThreads( 0 );
+    BOOST_CHECK_EQUAL( SPML::Execution::PoolThreads(), std::max( 1u, std::thread::hardware_concurrency() ) );
+}
+
+BOOST_AUTO_TEST_CASE( test_Concurrent_Callers )
+{
+    // Вызовы из нескольких потоков одновременно: пока пул занят, вызов выполняется в вызывающем потоке
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::PZ90();
+    const SPML::Units::TRangeUnit ru = SPML::Units::TRangeUnit::RU_Kilometer;
+    const SPML::Units::TAngleUnit au = SPML::Units::TAngleUnit::AU_Degree;
+    const std::size_t rows = 100;
+    const std::size_t cols = 1000;
+    std::vector<double> latRow( rows ), lonRow( rows ), latCol( cols ), lonCol( cols );
+    for( std::size_t i = 0; i < rows; i++ ) {
+        latRow[i] = 40.0 + 0.1 * i;
+        lonRow[i] = 30.0 - 0.1 * i;
+    }
+    for( std::size_t j = 0; j < cols; j++ ) {
+        latCol[j] = 50.0 + 0.01 * j;
+        lonCol[j] = 40.0 - 0.02 * j;
+    }
+    std::vector<double> dMatrix( rows * cols ), azMatrix( rows * cols );
+    SPML::Geodesy::GEOtoRAD_Matrix( el, ru, au, latRow.data(), lonRow.data(), rows, latCol.data(), lonCol.data(),
+        cols, dMatrix.data(), azMatrix.data(), nullptr, SPML::Execution::Policy( SPML::Execution::EM_Sequential ) );
+
+    SPML::Execution::SetPoolThreads( 4 );
+    std::vector<std::vector<double>> d( 4, std::vector<double>( rows * cols ) );
+    std::vector<std::vector<double>> az( 4, std::vector<double>( rows * cols ) );
+    std::vector<std::thread> callers;
+    for( std::size_t c = 0; c < d.size(); c++ ) {
+        callers.emplace_back( [&, c]() {
+            for( int repeat = 0; repeat < 5; repeat++ ) {
+                SPML::Geodesy::GEOtoRAD_Matrix( el, ru, au, latRow.data(), lonRow.data(), rows, latCol.data(),
+                    lonCol.data(), cols, d[c].data(), az[c].data(), nullptr,
+                    SPML::Execution::Policy( SPML::Execution::EM_Parallel, 0, 1 ) );
+            }
+        } );
+    }
+    for( std::thread &caller : callers ) {
+        caller.join();
+    }
+    for( std::size_t c = 0; c < d.size(); c++ ) {
+        BOOST_CHECK( d[c] == dMatrix );
+        BOOST_CHECK( az[c] == azMatrix );
+    }
+    SPML::Execution::SetPoolThreads( 0 );
+}
+
+BOOST_AUTO_TEST_CASE( test_Task_Exception )
+{
+    // Исключение задачи передается вызывающему после завершения начатых задач, пул остается рабочим
+    SPML::Execution::SetPoolThreads( 3 );
+    const std::size_t tasks = 1000;
+    std::atomic<std::size_t> started{ 0 };
+    std::atomic<std::size_t> running{ 0 };
+    std::atomic<bool> overlap{ false };
+    const SPML::Execution::Policy policy( SPML::Execution::EM_Parallel );
+    BOOST_CHECK_THROW( SPML::Execution::ParallelTasks( tasks, policy, [&]( std::size_t task ) {
+        started++;
+        running++;
+        std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+        running--;
+        if( task == 10 ) {
+            throw std::runtime_error( "task 10" );
+        }
+    } ), std::runtime_error );
+    BOOST_CHECK_EQUAL( running.load(), 0u );
+    BOOST_CHECK_LT( started.load(), tasks );
+
+    // Следующий вызов выполняет все задачи; ни одна задача прошлого вызова уже не выполняется
+    std::vector<int> visited( tasks, 0 );
+    SPML::Execution::ParallelTasks( tasks, policy, [&]( std::size_t task ) {
+        if( running != 0 ) {
+            overlap = true;
+        }
+        visited[task]++;
+    } );
+    BOOST_CHECK( !overlap );
+    BOOST_CHECK( std::all_of( visited.begin(), visited.end(), []( int v ) { return v == 1; } ) );
+
+    // Последовательное выполнение тоже передает исключение
+    BOOST_CHECK_THROW( SPML::Execution::ParallelTasks( tasks, SPML::Execution::Policy(
+        SPML::Execution::EM_Sequential ), []( std::size_t task ) {
+        if( task == 3 ) {
+            throw std::runtime_error( "task 3" );
+        }
+    } ), std::runtime_error );
+    SPML::Execution::SetPoolThreads( 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_AERtoGEO_Batch )
+
+const double epsAngleRad = 1.0e-11;                             // [рад], как у ECEFtoGEO_Batch
+const double epsHeight = 1.0e-4;                                // [м]
+
+// Наборы параметров сравнения с AERtoGEO: случайные отметки радиолокатора до 600 км, включая зенит и нулевую
+// дальность; во втором наборе больше одной части по 512 точек на поток
+static const TBatchConfig aerToGeoConfigs[] = {
+    { &SPML::Geodesy::Ellipsoids::WGS84, SPML::Units::RU_Kilometer, SPML::Units::AU_Degree, 1203, 1, 55.75, 37.62,
+        150.0 },
+    { &SPML::Geodesy::Ellipsoids::PZ90, SPML::Units::RU_Meter, SPML::Units::AU_Radian, 3001, 3, -33.9, 18.4, 1200.0 }
+};
+
+BOOST_DATA_TEST_CASE( test_Scalar_Agreement, boost::unit_test::data::make( aerToGeoConfigs ), config )
+{
+    const SPML::Geodesy::CEllipsoid &el = config.Ellipsoid();
+    const std::size_t n = config.Count;
+    const double toAngle = config.ToAngle();
+    const double toRange = config.ToRange();
+    std::mt19937 gen( 2024 );
+    std::uniform_real_distribution<double> azimuth( 0.0, 360.0 );
+    std::uniform_real_distribution<double> elevation( -5.0, 85.0 );
+    std::uniform_real_distribution<double> range( 0.0, 6.0e5 );
+    std::vector<double> az( n ), elev( n ), r( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        az[i] = azimuth( gen ) * toAngle;
+        elev[i] = elevation( gen ) * toAngle;
+        r[i] = range( gen ) * toRange;
+        switch( i % 40 ) {
+            case 3: elev[i] = 90.0 * toAngle; break;   // Зенит
+            case 7: r[i] = 0.0; break;                 // Опорная точка
+            default: break;
+        }
+    }
+    const double lat0 = config.Lat * toAngle;
+    const double lon0 = config.Lon * toAngle;
+    const double h0 = config.Height * toRange;
+    const double epsA = config.AngleEps( epsAngleRad );
+    const double epsH = epsHeight * toRange;
+    CheckAgainstScalar<double>( n, 3, [&]( SPML::SIMD::TSimdLevel level, double *const *out ) {
+        SPML::Geodesy::AERtoGEO_Batch( el, config.RangeUnit, config.AngleUnit, az.data(), elev.data(), r.data(), n,
+            lat0, lon0, h0, out[0], out[1], out[2], level, config.Threads );
+    }, [&]( std::size_t i, double *expected ) {
+        SPML::Geodesy::AERtoGEO( el, config.RangeUnit, config.AngleUnit, az[i], elev[i], r[i], lat0, lon0, h0,
+            expected[0], expected[1], expected[2] );
+    }, [&]( std::size_t, std::size_t k, const double * ) {
+        return TBatchTolerance{ ( k == 2 ) ? epsH : epsA };
+    } );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE( test_suite_LocalFrame_Batch )
+
+const double epsDoubleRel = 1.0e-15;                            // Относительно дальности (длины смещения)
+const double epsDoubleAngleRad = 2.0e-15;                       // [рад]
+const double epsFloatRel = 5.0e-7;                              // Относительно дальности, 0.25 м на 500 км
+const double epsFloatAngleRad = 1.0e-6;                         // [рад], 0.2 угл. сек
+
+// Сравнение пакетных функций double и float с функциями double для тех же входных значений (входы float переводятся
+// в double без потерь): случайные смещения до 500 км, включая нулевое и вертикальное
+template<class T>
+static void CheckLocalFrame( const TBatchConfig &config, double epsRel, double epsAngleRad )
+{
+    const SPML::Geodesy::CEllipsoid &el = config.Ellipsoid();
+    const SPML::Units::TRangeUnit ru = config.RangeUnit;
+    const SPML::Units::TAngleUnit au = config.AngleUnit;
+    const std::size_t n = config.Count;
+    const unsigned int threads = config.Threads;
+    const double toRange = config.ToRange();
+    const double epsA = config.AngleEps( epsAngleRad );
+    const double lat0 = config.Lat * config.ToAngle(), lon0 = config.Lon * config.ToAngle();
+
+    std::mt19937 gen( 4242 );
+    std::uniform_real_distribution<double> offset( -5.0e5, 5.0e5 );
+    std::vector<T> x( n ), y( n ), z( n ), az( n ), elev( n ), r( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        x[i] = static_cast<T>( offset( gen ) * toRange );
+        y[i] = static_cast<T>( offset( gen ) * toRange );
+        z[i] = static_cast<T>( offset( gen ) * toRange );
+        switch( i % 40 ) {
+            case 3: x[i] = y[i] = 0; break;             // Зенит или надир
+            case 7: x[i] = y[i] = z[i] = 0; break;      // Опорная точка
+            default: break;
+        }
+        double a0, e0, r0;
+        SPML::Geodesy::ENUtoAER( ru, au, static_cast<double>( x[i] ), static_cast<double>( y[i] ),
+            static_cast<double>( z[i] ), a0, e0, r0 );
+        az[i] = static_cast<T>( a0 );
+        elev[i] = static_cast<T>( e0 );
+        r[i] = static_cast<T>( r0 );
+    }
+    // Допуск по дальности (длине смещения) не меньше допуска для 1 м
+    const auto rangeEps = [&]( double length ) {
+        return TBatchTolerance{ epsRel * std::max( length, toRange ) };
+    };
+    const auto lengthEps = [&]( std::size_t, std::size_t, const double *expected ) {
+        return rangeEps( std::sqrt( expected[0] * expected[0] + expected[1] * expected[1] +
+            expected[2] * expected[2] ) );
+    };
+
+    CheckAgainstScalar<T>( n, 3, [&]( SPML::SIMD::TSimdLevel level, T *const *out ) {
+        SPML::Geodesy::ENUtoAER_Batch( ru, au, x.data(), y.data(), z.data(), n, out[0], out[1], out[2], level,
+            threads );
+    }, [&]( std::size_t i, double *expected ) {
+        SPML::Geodesy::ENUtoAER( ru, au, static_cast<double>( x[i] ), static_cast<double>( y[i] ),
+            static_cast<double>( z[i] ), expected[0], expected[1], expected[2] );
+    }, [&]( std::size_t i, std::size_t k, const double *expected ) {
+        switch( k ) {
+            case 0: return TBatchTolerance{ ( i % 40 != 3 ) ? epsA : -1.0, 360.0 * config.ToAngle() }; // Не в зените
+            case 1: return TBatchTolerance{ epsA };
+            default: return rangeEps( expected[2] );
+        }
+    } );
+
+    CheckAgainstScalar<T>( n, 3, [&]( SPML::SIMD::TSimdLevel level, T *const *out ) {
+        SPML::Geodesy::AERtoENU_Batch( ru, au, az.data(), elev.data(), r.data(), n, out[0], out[1], out[2], level,
+            threads );
+    }, [&]( std::size_t i, double *expected ) {
+        SPML::Geodesy::AERtoENU( ru, au, static_cast<double>( az[i] ), static_cast<double>( elev[i] ),
+            static_cast<double>( r[i] ), expected[0], expected[1], expected[2] );
+    }, [&]( std::size_t i, std::size_t, const double * ) {
+        return rangeEps( static_cast<double>( r[i] ) );
+    } );
+
+    CheckAgainstScalar<T>( n, 3, [&]( SPML::SIMD::TSimdLevel level, T *const *out ) {
+        SPML::Geodesy::ECEFtoENUV_Batch( ru, au, x.data(), y.data(), z.data(), n, lat0, lon0, out[0], out[1], out[2],
+            level, threads );
+    }, [&]( std::size_t i, double *expected ) {
+        SPML::Geodesy::ECEFtoENUV( ru, au, static_cast<double>( x[i] ), static_cast<double>( y[i] ),
+            static_cast<double>( z[i] ), lat0, lon0, expected[0], expected[1], expected[2] );
+    }, lengthEps );
+
+    CheckAgainstScalar<T>( n, 3, [&]( SPML::SIMD::TSimdLevel level, T *const *out ) {
+        SPML::Geodesy::ENUtoUVW_Batch( ru, au, x.data(), y.data(), z.data(), n, lat0, lon0, out[0], out[1], out[2],
+            level, threads );
+    }, [&]( std::size_t i, double *expected ) {
+        SPML::Geodesy::ENUtoUVW( el, ru, au, static_cast<double>( x[i] ), static_cast<double>( y[i] ),
+            static_cast<double>( z[i] ), lat0, lon0, expected[0], expected[1], expected[2] );
+    }, lengthEps );
+}
+
+// Наборы параметров сравнения: опорная точка - Москва, во втором наборе размер не кратен 16 значениям AVX-512
+static const TBatchConfig localFrameConfigs[] = {
+    { &SPML::Geodesy::Ellipsoids::WGS84, SPML::Units::RU_Kilometer, SPML::Units::AU_Degree, 1003, 1, 55.75, 37.62 },
+    { &SPML::Geodesy::Ellipsoids::WGS84, SPML::Units::RU_Meter, SPML::Units::AU_Radian, 3001, 3, 55.75, 37.62 }
+};
+
+BOOST_DATA_TEST_CASE( test_Double_Scalar_Agreement, boost::unit_test::data::make( localFrameConfigs ), config )
+{
+    CheckLocalFrame<double>( config, epsDoubleRel, epsDoubleAngleRad );
+}
+
+BOOST_DATA_TEST_CASE( test_Float_Scalar_Agreement, boost::unit_test::data::make( localFrameConfigs ), config )
+{
+    CheckLocalFrame<float>( config, epsFloatRel, epsFloatAngleRad );
+}
+
+BOOST_AUTO_TEST_CASE( test_Float_Scalar_And_Frame )
+{
+    // Скалярные функции float и пакетные методы CLocalFrame для float
+    const SPML::Geodesy::CEllipsoid &el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Geodesy::CLocalFrame frame( el, SPML::Units::RU_Meter, SPML::Units::AU_Degree, 55.75, 37.62, 150.0 );
+    const float x[5] = { 1200.5f, -35000.0f, 0.0f, 250000.0f, -7.25f };
+    const float y[5] = { 800.0f, 12000.0f, 0.0f, -410000.0f, 3.5f };
+    const float z[5] = { 150.0f, 3000.0f, 2500.0f, 9000.0f, -1.0f };
+    float az[5], elev[5], r[5], e[5], n[5], u[5];
+    frame.ENUtoAER( x, y, z, 5, az, elev, r );
+    frame.AERtoENU( az, elev, r, 5, e, n, u );
+    for( int i = 0; i < 5; i++ ) {
+        double a0, e0, r0;
+        SPML::Geodesy::ENUtoAER( SPML::Units::RU_Meter, SPML::Units::AU_Degree, x[i], y[i], z[i], a0, e0, r0 );
+        float a1, e1, r1, x1, y1, z1;
+        SPML::Geodesy::ENUtoAER( SPML::Units::RU_Meter, SPML::Units::AU_Degree, x[i], y[i], z[i], a1, e1, r1 );
+        SPML::Geodesy::AERtoENU( SPML::Units::RU_Meter, SPML::Units::AU_Degree, a1, e1, r1, x1, y1, z1 );
+        const double eps = 2.0 * epsFloatRel * r0;
+        const double epsA = epsFloatAngleRad * SPML::Convert::RdToDgD;
+        BOOST_TEST_CONTEXT( "i=" << i ) {
+            if( i != 2 ) {
+                BOOST_CHECK_SMALL( AngleDiff( az[i], a0, 360.0 ), epsA );
+                BOOST_CHECK_SMALL( AngleDiff( a1, a0, 360.0 ), epsA );
+            }
+            BOOST_CHECK_SMALL( elev[i] - e0, epsA );
+            BOOST_CHECK_SMALL( e1 - e0, epsA );
+            BOOST_CHECK_SMALL( r[i] - r0, eps );
+            BOOST_CHECK_SMALL( r1 - r0, eps );
+            // Прямое и обратное преобразования
+            BOOST_CHECK_SMALL( static_cast<double>( e[i] ) - x[i], eps );
+            BOOST_CHECK_SMALL( static_cast<double>( n[i] ) - y[i], eps );
+            BOOST_CHECK_SMALL( static_cast<double>( u[i] ) - z[i], eps );
+            BOOST_CHECK_SMALL( static_cast<double>( x1 ) - x[i], eps );
+            BOOST_CHECK_SMALL( static_cast<double>( y1 ) - y[i], eps );
+            BOOST_CHECK_SMALL( static_cast<double>( z1 ) - z[i], eps );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+BOOST_AUTO_TEST_SUITE( test_suite_CShmRing )
+
+// Имя объекта разделяемой памяти, уникальное для процесса теста
+static std::string RingName( const char *suffix )
+{
+    return "/test_spml_ring_" + std::to_string( getpid() ) + "_" + suffix;
+}
+
+BOOST_AUTO_TEST_CASE( test_CreateOpen )
+{
+    const std::string name = RingName( "open" );
+    SPML::Ring::CShmRing::Remove( name );
+    std::string error;
+    SPML::Ring::CShmRing writer, reader, other;
+    BOOST_CHECK( !writer.Create( "noslash", 2, 16, error ) );
+    BOOST_CHECK( !writer.Create( name, 0, 16, error ) );
+    BOOST_CHECK( !writer.Create( name, 2, 12, error ) );   // Не степень двойки
+    BOOST_CHECK( !reader.Open( name, error ) );            // Еще не создан
+    BOOST_REQUIRE_MESSAGE( writer.Create( name, 2, 16, error ), error );
+    BOOST_CHECK( !other.Create( name, 2, 16, error ) );    // Уже существует
+    BOOST_REQUIRE_MESSAGE( reader.Open( name, error ), error );
+    BOOST_CHECK_EQUAL( reader.Fields(), 2u );
+    BOOST_CHECK_EQUAL( reader.Capacity(), 16u );
+
+    // Записанное одним отображением видно в другом
+    const double a[3] = { 1.0, 2.0, 3.0 }, b[3] = { -1.0, -2.0, -3.0 };
+    const double *in[2] = { a, b };
+    BOOST_CHECK_EQUAL( writer.Push( in, 3 ), 3u );
+    double x[4], y[4];
+    double *out[2] = { x, y };
+    BOOST_CHECK_EQUAL( reader.Pop( out, 4 ), 3u );
+    BOOST_CHECK_EQUAL( x[2], 3.0 );
+    BOOST_CHECK_EQUAL( y[0], -1.0 );
+
+    // Создатель удаляет имя при закрытии, открывший буфер продолжает работать с ним
+    writer.Close();
+    BOOST_CHECK( !other.Open( name, error ) );
+    BOOST_CHECK( reader.IsOpen() );
+    BOOST_CHECK_EQUAL( reader.Pop( out, 4 ), 0u );
+}
+
+BOOST_AUTO_TEST_CASE( test_Wraparound )
+{
+    const std::string name = RingName( "wrap" );
+    SPML::Ring::CShmRing::Remove( name );
+    std::string error;
+    SPML::Ring::CShmRing ring;
+    BOOST_REQUIRE_MESSAGE( ring.Create( name, 2, 8, error ), error );
+
+    std::vector<double> a( 16 ), b( 16 ), x( 16 ), y( 16 );
+    for( std::size_t i = 0; i < a.size(); i++ ) {
+        a[i] = static_cast<double>( i );
+        b[i] = -static_cast<double>( i );
+    }
+    const double *in[2] = { a.data(), b.data() };
+    double *out[2] = { x.data(), y.data() };
+    BOOST_CHECK_EQUAL( ring.Push( in, 5 ), 5u );
+    BOOST_CHECK_EQUAL( ring.Pop( out, 3 ), 3u );
+    const double *rest[2] = { a.data() + 5, b.data() + 5 };
+    BOOST_CHECK_EQUAL( ring.Push( rest, 11 ), 6u );    // Заполнен: 8 записей, две части через конец столбцов
+
+    // Непрерывные участки не переходят через конец столбцов
+    const SPML::Ring::TSpan span = ring.Peek();
+    BOOST_CHECK_EQUAL( span.Offset, 3u );
+    BOOST_CHECK_EQUAL( span.Count, 5u );
+    BOOST_CHECK_EQUAL( ring.Reserve().Count, 0u );
+
+    double *tail[2] = { x.data() + 3, y.data() + 3 };
+    BOOST_CHECK_EQUAL( ring.Pop( tail, 16 ), 8u );
+    for( std::size_t i = 0; i < 11; i++ ) {
+        BOOST_CHECK_EQUAL( x[i], a[i] );
+        BOOST_CHECK_EQUAL( y[i], b[i] );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_Threads )
+{
+    // Писатель и читатель в разных потоках: все записи доходят по порядку
+    const std::string name = RingName( "threads" );
+    SPML::Ring::CShmRing::Remove( name );
+    std::string error;
+    SPML::Ring::CShmRing writer, reader;
+    BOOST_REQUIRE_MESSAGE( writer.Create( name, 2, 64, error ), error );
+    BOOST_REQUIRE_MESSAGE( reader.Open( name, error ), error );
+
+    const std::size_t total = 200000;
+    std::thread producer( [&writer, total]() {
+        std::mt19937 gen( 5 );
+        std::uniform_int_distribution<std::size_t> chunk( 1, 40 );
+        std::size_t next = 0;
+        while( next < total ) {
+            const SPML::Ring::TSpan span = writer.Reserve( std::min( chunk( gen ), total - next ) );
+            for( std::size_t i = 0; i < span.Count; i++ ) {
+                writer.Column( 0 )[span.Offset + i] = static_cast<double>( next + i );
+                writer.Column( 1 )[span.Offset + i] = 0.5 * static_cast<double>( next + i );
+            }
+            writer.Commit( span.Count );
+            next += span.Count;
+            if( span.Count == 0 ) {
+                std::this_thread::yield();
+            }
+        }
+    } );
+    std::size_t received = 0, wrong = 0;
+    while( received < total ) {
+        const SPML::Ring::TSpan span = reader.Peek( 48 );
+        for( std::size_t i = 0; i < span.Count; i++ ) {
+            if( ( reader.Column( 0 )[span.Offset + i] != static_cast<double>( received + i ) ) ||
+                ( reader.Column( 1 )[span.Offset + i] != 0.5 * static_cast<double>( received + i ) ) ) {
+                wrong++;
+            }
+        }
+        reader.Release( span.Count );
+        received += span.Count;
+        if( span.Count == 0 ) {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    BOOST_CHECK_EQUAL( wrong, 0u );
+}
+
+BOOST_AUTO_TEST_CASE( test_DrainAERtoGEO )
+{
+    // Отметки с меткой времени через два буфера: результат совпадает с AERtoGEO, метка не изменяется
+    const std::string plotsName = RingName( "plots" ), resultsName = RingName( "results" );
+    SPML::Ring::CShmRing::Remove( plotsName );
+    SPML::Ring::CShmRing::Remove( resultsName );
+    std::string error;
+    SPML::Ring::CShmRing plots, results;
+    BOOST_REQUIRE_MESSAGE( plots.Create( plotsName, 4, 256, error ), error );
+    BOOST_REQUIRE_MESSAGE( results.Create( resultsName, 4, 128, error ), error );
+
+    const SPML::Geodesy::CEllipsoid el = SPML::Geodesy::Ellipsoids::WGS84();
+    const SPML::Units::TRangeUnit ru = SPML::Units::RU_Kilometer;
+    const SPML::Units::TAngleUnit au = SPML::Units::AU_Degree;
+    const double lat0 = 59.94, lon0 = 30.31, h0 = 0.05;
+    const std::size_t n = 1000;
+    std::mt19937 gen( 99 );
+    std::uniform_real_distribution<double> azimuth( 0.0, 360.0 ), elevation( 0.0, 60.0 ), range( 1.0, 400.0 );
+    std::vector<double> az( n ), elev( n ), r( n ), t( n );
+    for( std::size_t i = 0; i < n; i++ ) {
+        az[i] = azimuth( gen );
+        elev[i] = elevation( gen );
+        r[i] = range( gen );
+        t[i] = 1.0e-3 * static_cast<double>( i );
+    }
+
+    std::vector<double> lat( n ), lon( n ), h( n ), stamp( n );
+    std::size_t pushed = 0, popped = 0;
+    while( popped < n ) {
+        const double *in[4] = { az.data() + pushed, elev.data() + pushed, r.data() + pushed, t.data() + pushed };
+        pushed += plots.Push( in, std::min<std::size_t>( 97, n - pushed ) );
+        SPML::Ring::DrainAERtoGEO( plots, results, el, ru, au, lat0, lon0, h0 );
+        double *out[4] = { lat.data() + popped, lon.data() + popped, h.data() + popped, stamp.data() + popped };
+        popped += results.Pop( out, std::min<std::size_t>( 61, n - popped ) );
+    }
+    for( std::size_t i = 0; i < n; i++ ) {
+        double b0, l0, hh0;
+        SPML::Geodesy::AERtoGEO( el, ru, au, az[i], elev[i], r[i], lat0, lon0, h0, b0, l0, hh0 );
+        BOOST_TEST_CONTEXT( "i=" << i ) {
+            BOOST_CHECK_SMALL( lat[i] - b0, 1.0e-9 );
+            BOOST_CHECK_SMALL( lon[i] - l0, 1.0e-9 );
+            BOOST_CHECK_SMALL( h[i] - hh0, 1.0e-7 );
+            BOOST_CHECK_EQUAL( stamp[i], t[i] );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+#endif
@@ -0,0 +1,226 @@
+//----------------------------------------------------------------------------------------------------------------------
+///
+/// \file       test_spml_simd_math.cpp
+/// \brief      Тесты точности пакетных элементарных функций библиотеки spml (сравнение с libm в ULP)
+/// \date       15.10.26 - создан
+/// \author     Соболев А.А.
+///
+
+//#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE test_spml_simd_math
+// Boost includes:
+#include <boost/test/unit_test.hpp>
+
+// System includes:
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+// SPML includes:
+#include <simd.h>
+#include <simd_math.h>
+//----------------------------------------------------------------------------------------------------------------------
+
+// Все уровни векторизации, доступные на данном процессоре
+static std::vector<SPML::SIMD::TSimdLevel> SupportedLevels()
+{
+    std::vector<SPML::SIMD::TSimdLevel> levels;
+    for( int l = SPML::SIMD::SL_Scalar; l <= SPML::SIMD::SL_AVX512; l++ ) {
+        if( SPML::SIMD::IsSupported( static_cast<SPML::SIMD::TSimdLevel>( l ) ) ) {
+            levels.push_back( static_cast<SPML::SIMD::TSimdLevel>( l ) );
+        }
+    }
+    return levels;
+}
+
+// Расстояние между числами double в единицах младшего разряда (ULP); NaN и NaN - совпадение
+static std::int64_t UlpDistance( double a, double b )
+{
+    if( std::isnan( a ) || std::isnan( b ) ) {
+        return ( std::isnan( a ) && std::isnan( b ) ) ? 0 : std::numeric_limits<std::int64_t>::max();
+    }
+    std::int64_t ia, ib;
+    std::memcpy( &ia, &a, sizeof( double ) );
+    std::memcpy( &ib, &b, sizeof( double ) );
+    // Отображение в монотонную шкалу ( -0 и +0 совпадают )
+    if( ia < 0 ) {
+        ia = std::numeric_limits<std::int64_t>::min() - ia;
+    }
+    if( ib < 0 ) {
+        ib = std::numeric_limits<std::int64_t>::min() - ib;
+    }
+    return ( ia > ib ) ? ( ia - ib ) : ( ib - ia );
+}
+
+// Случайные аргументы на отрезке [lo, hi] и граничные значения
+static std::vector<double> Arguments( double lo, double hi, std::size_t n, std::vector<double> special )
+{
+    std::mt19937_64 gen( 2026 );
+    std::uniform_real_distribution<double> dist( lo, hi );
+    std::vector<double> x = special;
+    while( x.size() < n ) {
+        x.push_back( dist( gen ) );
+    }
+    return x;
+}
+
+// Максимальная погрешность функции одного аргумента в ULP для уровня векторизации
+static std::int64_t MaxUlp( SPML::SIMD::TMathFunction func, double ( *ref )( double ), const std::vector<double> &x,
+    SPML::SIMD::TSimdLevel level )
+{
+    std::vector<double> out( x.size() );
+    SPML::SIMD::Evaluate( func, x.data(), x.size(), out.data(), level );
+    std::int64_t maxUlp = 0;
+    for( std::size_t i = 0; i < x.size(); i++ ) {
+        maxUlp = std::max( maxUlp, UlpDistance( out[i], ref( x[i] ) ) );
+    }
+    return maxUlp;
+}
+
+static double RefSin( double x ) { return std::sin( x ); }
+static double RefCos( double x ) { return std::cos( x ); }
+static double RefTan( double x ) { return std::tan( x ); }
+static double RefAtan( double x ) { return std::atan( x ); }
+static double RefAsin( double x ) { return std::asin( x ); }
+static double RefAcos( double x ) { return std::acos( x ); }
+
+// Допустимая погрешность относительно libm: документированная погрешность + 1 ULP на погрешность libm
+static std::int64_t Limit( SPML::SIMD::TSimdLevel level, std::int64_t ulp )
+{
+    return ( ( level == SPML::SIMD::SL_Scalar ) || SPML::SIMD::IsLibmMath() ) ? 0 : ulp + 1;
+}
+
+BOOST_AUTO_TEST_SUITE( test_suite_SimdMath )
+
+const std::size_t N = 200003;
+
+BOOST_AUTO_TEST_CASE( test_SinCos )
+{
+    for( double range : { 1.0, 10.0, 1.0e4, 1.0e8 } ) {
+        const std::vector<double> x = Arguments( -range, range, N, { 0.0, -0.0, 1.0, -1.0, 1.0e-300 } );
+        for( SPML::SIMD::TSimdLevel level : SupportedLevels() ) {
+            BOOST_TEST_CONTEXT( SPML::SIMD::Name( level ) << " |x| <= " << range ) {
+                BOOST_CHECK_LE( MaxUlp( SPML::SIMD::MF_Sin, RefSin, x, level ), Limit( level, 2 ) );
+                BOOST_CHECK_LE( MaxUlp( SPML::SIMD::MF_Cos, RefCos, x, level ), Limit( level, 2 ) );
+                BOOST_CHECK_LE( MaxUlp( SPML::SIMD::MF_Tan, RefTan, x, level ), Limit( level, 4 ) );
+
+                std::vector<double> s( x.size() ), c( x.size() );
+                SPML::SIMD::SinCos( x.data(), x.size(), s.data(), c.data(), level );
+                std::vector<double> s1( x.size() ), c1( x.size() );
+                SPML::SIMD::Evaluate( SPML::SIMD::MF_Sin, x.data(), x.size(), s1.data(), level );
+                SPML::SIMD::Evaluate( SPML::SIMD::MF_Cos, x.data(), x.size(), c1.data(), level );
+                BOOST_CHECK( s == s1 ); // SinCos совпадает с раздельными Sin и Cos
+                BOOST_CHECK( c == c1 );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_SinCos_NearZeros )
+{
+    // Вблизи x = k * PI/2 результат мал, и погрешность ограничена абсолютной величиной 1e-30 * |x|
+    const double pio2 = 2.0 * std::atan( 1.0 );
+    std::vector<double> x;
+    for( double k = 1.0; k < 1.0e7; k *= 1.7 ) {
+        x.push_back( std::nearbyint( k ) * pio2 );
+        x.push_back( -std::nearbyint( k ) * pio2 );
+    }
+    for( SPML::SIMD::TSimdLevel level : SupportedLevels() ) {
+        std::vector<double> s( x.size() ), c( x.size() );
+        SPML::SIMD::SinCos( x.data(), x.size(), s.data(), c.data(), level );
+        for( std::size_t i = 0; i < x.size(); i++ ) {
+            BOOST_TEST_CONTEXT( SPML::SIMD::Name( level ) << " x=" << x[i] ) {
+                const double absTol = 1.0e-30 * std::fabs( x[i] );
+                BOOST_CHECK_LE( std::fabs( s[i] - std::sin( x[i] ) ), 4.5e-16 * std::fabs( std::sin( x[i] ) ) + absTol );
+                BOOST_CHECK_LE( std::fabs( c[i] - std::cos( x[i] ) ), 4.5e-16 * std::fabs( std::cos( x[i] ) ) + absTol );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_SinCos_Large )
+{
+    // За пределами |x| <= 1e8 - libm
+    const std::vector<double> x = Arguments( -1.0e12, 1.0e12, 1001, { 1.0e300, -1.0e300 } );
+    for( SPML::SIMD::TSimdLevel level : SupportedLevels() ) {
+        BOOST_TEST_CONTEXT( SPML::SIMD::Name( level ) ) {
+            BOOST_CHECK_LE( MaxUlp( SPML::SIMD::MF_Sin, RefSin, x, level ), Limit( level, 2 ) );
+            BOOST_CHECK_LE( MaxUlp( SPML::SIMD::MF_Cos, RefCos, x, level ), Limit( level, 2 ) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_Atan )
+{
+    for( double range : { 1.0, 3.0, 1.0e3, 1.0e300 } ) {
+        const std::vector<double> x = Arguments( -range, range, N, { 0.0, -0.0, 0.66, 2.41421356237309504880, 1.0e-300,
+            std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity() } );
+        for( SPML::SIMD::TSimdLevel level : SupportedLevels() ) {
+            BOOST_TEST_CONTEXT( SPML::SIMD::Name( level ) << " |x| <= " << range ) {
+                BOOST_CHECK_LE( MaxUlp( SPML::SIMD::MF_Atan, RefAtan, x, level ), Limit( level, 2 ) );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_Atan2 )
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> y = Arguments( -1.0e7, 1.0e7, N, { 0.0, -0.0, 0.0, -0.0, 1.0, -1.0, 0.0, -0.0, 1.0, inf } );
+    std::vector<double> x = Arguments( -1.0e7, 1.0e7, N, { 0.0, 0.0, -0.0, -0.0, 0.0, -0.0, -1.0, -1.0, inf, 1.0 } );
+    for( std::size_t i = 10; i < N; i += 3 ) {
+        y[i] *= 1.0e-6; // Малые углы
+    }
+    for( SPML::SIMD::TSimdLevel level : SupportedLevels() ) {
+        std::vector<double> out( N );
+        SPML::SIMD::Atan2( y.data(), x.data(), N, out.data(), level );
+        std::int64_t maxUlp = 0;
+        for( std::size_t i = 0; i < N; i++ ) {
+            const double ref = std::atan2( y[i], x[i] );
+            maxUlp = std::max( maxUlp, UlpDistance( out[i], ref ) );
+            if( i < 10 ) {
+                BOOST_TEST_CONTEXT( SPML::SIMD::Name( level ) << " y=" << y[i] << " x=" << x[i] ) {
+                    BOOST_CHECK_EQUAL( std::signbit( out[i] ), std::signbit( ref ) ); // Знак нуля и PI
+                }
+            }
+        }
+        BOOST_TEST_CONTEXT( SPML::SIMD::Name( level ) ) {
+            BOOST_CHECK_LE( maxUlp, Limit( level, 2 ) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_AsinAcos )
+{
+    const std::vector<double> x = Arguments( -1.0, 1.0, N, { 0.0, -0.0, 1.0, -1.0, 0.5, -0.5, 0.625, -0.625, 1.0e-300,
+        1.0 - 1.0e-16, 1.5, -1.5 } );
+    for( SPML::SIMD::TSimdLevel level : SupportedLevels() ) {
+        BOOST_TEST_CONTEXT( SPML::SIMD::Name( level ) ) {
+            BOOST_CHECK_LE( MaxUlp( SPML::SIMD::MF_Asin, RefAsin, x, level ), Limit( level, 2 ) );
+            BOOST_CHECK_LE( MaxUlp( SPML::SIMD::MF_Acos, RefAcos, x, level ), Limit( level, 2 ) );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( test_Tail_InPlace )
+{
+    // Размер не кратен ширине вектора, результат на месте аргумента
+    for( SPML::SIMD::TSimdLevel level : SupportedLevels() ) {
+        for( std::size_t n = 0; n <= 11; n++ ) {
+            std::vector<double> x( n + 1, 7.0 );
+            for( std::size_t i = 0; i < n; i++ ) {
+                x[i] = 0.1 * static_cast<double>( i );
+            }
+            SPML::SIMD::Evaluate( SPML::SIMD::MF_Asin, x.data(), n, x.data(), level );
+            for( std::size_t i = 0; i < n; i++ ) {
+                BOOST_CHECK_SMALL( x[i] - std::asin( 0.1 * static_cast<double>( i ) ), 1.0e-15 );
+            }
+            BOOST_CHECK_EQUAL( x[n], 7.0 ); // За пределы массива не пишем
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()